@@ -40,12 +40,16 @@
 #include "MemZeroAndCopy.h"
 #include "PrintFormatToString.h"
 #include "BlackboardHashIndex.h"
+#include "AtomicAccess.h"
+#include "BlackboardObservationQueue.h"
 #include "Blackboard.h"
 #include "BlackboardAccess.h"
+#include "BlackboardConversion.h"
 #include "EquationParser.h"
 #include "ExecutionStack.h"
 #include "TextReplace.h"
 #include "BlackboardIniCache.h"
+#include "BlackboardStringPool.h"
 #ifdef REMOTE_MASTER
 #else
 #include "IniFileDontExist.h"
@@ -54,6 +58,8 @@
 #ifdef REMOTE_MASTER
 #else
 #include "EquationList.h"
+#include "BlackboardNameIndex.h"
+#include "Wildcards.h"
 #endif
 #include "ThrowError.h"
 #include "Scheduler.h"
@@ -129,7 +135,7 @@ static void (*ObserationCallbackFunction) (VID Vid, uint32_t ObservationFlags, u
 #ifdef REMOTE_MASTER
 #define CHECK_OBSERVATION(index, ObservationMask) \
 if (1) { \
-    uint32_t Help = blackboard[index].ObservationFlags & ObservationMask; \
+    uint32_t Help = BB_OBSERVATION_FLAGS(index) & ObservationMask; \
     if (Help != 0) { \
         if (ObserationCallbackFunction != NULL) { \
             rm_ObserationCallbackFunction (ObserationCallbackFunction, blackboard[index].Vid, Help, blackboard[index].pAdditionalInfos->ObservationData); \
@@ -150,7 +156,7 @@ if (1) { \
 #else
 #define CHECK_OBSERVATION(index, ObservationMask) \
 if (1) { \
-    uint32_t Help = blackboard[index].ObservationFlags & ObservationMask; \
+    uint32_t Help = BB_OBSERVATION_FLAGS(index) & ObservationMask; \
     if (Help != 0) { \
         if (ObserationCallbackFunction != NULL) { \
             ObserationCallbackFunction (blackboard[index].Vid, Help, blackboard[index].pAdditionalInfos->ObservationData); \
@@ -211,7 +217,15 @@ int SetBbvariObservation (VID Vid, uint32_t ObservationFlags, uint32_t Observati
         LeaveCriticalSection (&BlackboardCriticalSection);
         return -1;
     }
-    blackboard[vid_index].ObservationFlags = ObservationFlags;
+    if ((ObservationFlags & OBSERVE_VALUE_CHANGED) == OBSERVE_VALUE_CHANGED) {
+        // The queue must exist before the writers will see the flag
+        if (InitBlackboardObservationQueue (blackboard_infos.Size)) {
+            LeaveCriticalSection (&BlackboardCriticalSection);
+            ThrowError (1, "out of memory");
+            return -1;
+        }
+    }
+    BB_OBSERVATION_FLAGS(vid_index) = ObservationFlags;
     if (blackboard[vid_index].pAdditionalInfos != NULL) {
         if ((ObservationData & OBSERVE_RESET_FLAGS) == OBSERVE_RESET_FLAGS) {
             // Reset
@@ -253,6 +267,7 @@ int init_blackboard (int blackboard_size, char CopyBB2ProcOnlyIfWrFlagSet, char
 
     // This have to be done even if the remote master is active
     InitializeCriticalSection (&BlackboardCriticalSection);
+    InitBlackboardStringPool ();
 
 #ifdef REMOTE_MASTER
     InitBlackboardIniCache();
@@ -277,12 +292,36 @@ int init_blackboard (int blackboard_size, char CopyBB2ProcOnlyIfWrFlagSet, char
     // we alloc one element more as neccessary so we can detect write to blackboard with index -1!
     // Zeiger auf Speicherbereich ermitteln
     blackboard = (BB_VARIABLE*)my_calloc ((size_t)(blackboard_size + 1), sizeof (BB_VARIABLE));
-    if (blackboard == NULL) {
+    blackboard_values = (union BB_VARI*)my_calloc ((size_t)(blackboard_size + 1), sizeof (union BB_VARI));
+    blackboard_types = (int8_t*)my_calloc ((size_t)(blackboard_size + 1), sizeof (int8_t));
+    blackboard_wr_seqs = (volatile uint32_t*)my_calloc ((size_t)(blackboard_size + 1), sizeof (uint32_t));
+    blackboard_access_flags = (uint64_t*)my_calloc ((size_t)(blackboard_size + 1), sizeof (uint64_t));
+    blackboard_observation_flags = (uint32_t*)my_calloc ((size_t)(blackboard_size + 1), sizeof (uint32_t));
+    if ((blackboard == NULL) || (blackboard_values == NULL) || (blackboard_types == NULL) ||
+        (blackboard_wr_seqs == NULL) || (blackboard_access_flags == NULL) || (blackboard_observation_flags == NULL)) {
+        if (blackboard != NULL) my_free (blackboard);
+        if (blackboard_values != NULL) my_free (blackboard_values);
+        if (blackboard_types != NULL) my_free (blackboard_types);
+        if (blackboard_wr_seqs != NULL) my_free ((void*)blackboard_wr_seqs);
+        if (blackboard_access_flags != NULL) my_free (blackboard_access_flags);
+        if (blackboard_observation_flags != NULL) my_free (blackboard_observation_flags);
+        blackboard = NULL;
         return -1;
     }
     MEMSET (blackboard, 0xFF, sizeof (BB_VARIABLE));
-
-    blackboard++; // use not the element 0 we have allocated one more as neccessary
+    MEMSET (blackboard_values, 0xFF, sizeof (union BB_VARI));
+    MEMSET (blackboard_types, 0xFF, sizeof (int8_t));
+    MEMSET ((void*)blackboard_wr_seqs, 0xFF, sizeof (uint32_t));
+    MEMSET (blackboard_access_flags, 0xFF, sizeof (uint64_t));
+    MEMSET (blackboard_observation_flags, 0xFF, sizeof (uint32_t));
+
+    // use not the element 0 we have allocated one more as neccessary
+    blackboard++;
+    blackboard_values++;
+    blackboard_types++;
+    blackboard_wr_seqs++;
+    blackboard_access_flags++;
+    blackboard_observation_flags++;
 
     blackboard_infos.Size = blackboard_size;
     blackboard_infos.NumOfVaris = 0;
@@ -301,48 +340,37 @@ int init_blackboard (int blackboard_size, char CopyBB2ProcOnlyIfWrFlagSet, char
     if (InitMasterHashTable(blackboard_size)) {
         return -1;
     }
+#endif
+#ifndef REMOTE_MASTER
+    if (InitBlackboardNameIndex(blackboard_size)) {
+        return -1;
+    }
 #endif
     return 0;
 }
 
 #define MAX_COLOR_STRING_LEN  32
 
-int write_varinfos_to_ini (BB_VARIABLE *sp_vari_elem,
-                           uint32_t WriteReqFlags)
+#ifndef REMOTE_MASTER
+// Build the INI line with all infos of a variable. stack_buffer must have INI_MAX_LINE_LENGTH bytes,
+// if the line don't fit into it, it will be allocated and must be freed with my_free() (*ret_HeapBufferFlag is set)
+static char *build_varinfos_ini_line (BB_VARIABLE *sp_vari_elem, char *stack_buffer, int *ret_HeapBufferFlag)
 {
-#ifdef REMOTE_MASTER
-    int Ret;
-    //Ret = rm_write_varinfos_to_ini(sp_vari_elem);
-    Ret = BlackboardIniCache_AddEntry(sp_vari_elem->pAdditionalInfos->Name, sp_vari_elem->pAdditionalInfos->Unit, sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString,
-                                      sp_vari_elem->pAdditionalInfos->Min, sp_vari_elem->pAdditionalInfos->Max, sp_vari_elem->pAdditionalInfos->Step,
-                                      sp_vari_elem->pAdditionalInfos->Width, sp_vari_elem->pAdditionalInfos->Prec, sp_vari_elem->pAdditionalInfos->StepType, sp_vari_elem->pAdditionalInfos->Conversion.Type,
-                                      sp_vari_elem->pAdditionalInfos->RgbColor, WriteReqFlags);
-    return Ret;
-#else
-    // Do not write anything to the INI file
-    if (s_main_ini_val.DontWriteBlackbardVariableInfosToIni) return 0;
-
-    if (s_main_ini_val.ConnectToRemoteMaster) {
-        return rm_WriteToBlackboardIniCache(sp_vari_elem, WriteReqFlags);
-    }
-
-    char stack_buffer[INI_MAX_LINE_LENGTH];   // max. line legth inside an INI file
     char *tmp_var_str;
     size_t len_first_part;
     size_t len_convertion;
-    int HeapBufferFlag = 0;
     int Red, Green, Blue;
-    int Ret;
 
+    *ret_HeapBufferFlag = 0;
     // is a valid typ defined
     if (((sp_vari_elem->Type < BB_BYTE) || (sp_vari_elem->Type > BB_DOUBLE)) &&
          (sp_vari_elem->Type != BB_QWORD) && (sp_vari_elem->Type != BB_UQWORD)) {
-        return -1;
+        return NULL;
     }
 
     tmp_var_str = stack_buffer;
     // Build a string with all variable informations
-    len_first_part = (size_t)PrintFormatToString (stack_buffer, sizeof(stack_buffer),
+    len_first_part = (size_t)PrintFormatToString (stack_buffer, INI_MAX_LINE_LENGTH,
                               "%d,%s,%.18g,%.18g,%d,%d,%d,%lf,%d,",
                               (int)sp_vari_elem->Type, sp_vari_elem->pAdditionalInfos->Unit,
                               sp_vari_elem->pAdditionalInfos->Min,
@@ -365,14 +393,14 @@ int write_varinfos_to_ini (BB_VARIABLE *sp_vari_elem,
         }
         if ((len_first_part + len_convertion + MAX_COLOR_STRING_LEN) < INI_MAX_LINE_LENGTH) {   // +32 for color value
             // Fits into the stack buffer
-            HeapBufferFlag = 0;
+            *ret_HeapBufferFlag = 0;
             tmp_var_str = stack_buffer;
         } else {
             // Do not fit into stack buffer setup an heap buffer
-            HeapBufferFlag = 1;
+            *ret_HeapBufferFlag = 1;
             tmp_var_str = my_malloc (len_first_part + len_convertion + MAX_COLOR_STRING_LEN);
             if (tmp_var_str == NULL) {
-                return -1;
+                return NULL;
             }
             MEMCPY (tmp_var_str, stack_buffer, len_first_part);
         }
@@ -383,12 +411,12 @@ int write_varinfos_to_ini (BB_VARIABLE *sp_vari_elem,
         }
         break;
     case BB_CONV_FACTOFF:
-        len_convertion = PrintFormatToString (tmp_var_str + len_first_part, sizeof(stack_buffer) - len_first_part, "%.18g:%.18g",
+        len_convertion = PrintFormatToString (tmp_var_str + len_first_part, INI_MAX_LINE_LENGTH - len_first_part, "%.18g:%.18g",
                                   sp_vari_elem->pAdditionalInfos->Conversion.Conv.FactorOffset.Factor,
                                   sp_vari_elem->pAdditionalInfos->Conversion.Conv.FactorOffset.Offset);
         break;
     case BB_CONV_OFFFACT:
-        len_convertion = PrintFormatToString (tmp_var_str + len_first_part, sizeof(stack_buffer) - len_first_part, "%.18g:%.18g",
+        len_convertion = PrintFormatToString (tmp_var_str + len_first_part, INI_MAX_LINE_LENGTH - len_first_part, "%.18g:%.18g",
                                  sp_vari_elem->pAdditionalInfos->Conversion.Conv.FactorOffset.Offset,
                                  sp_vari_elem->pAdditionalInfos->Conversion.Conv.FactorOffset.Factor);
         break;
@@ -400,14 +428,14 @@ int write_varinfos_to_ini (BB_VARIABLE *sp_vari_elem,
         MaxSize = sp_vari_elem->pAdditionalInfos->Conversion.Conv.Table.Size * 64; // 64 chars for to double numbers
         if ((len_first_part + MaxSize + MAX_COLOR_STRING_LEN) < INI_MAX_LINE_LENGTH) {   // +32 for color value
             // Fits into the stack buffer
-            HeapBufferFlag = 0;
+            *ret_HeapBufferFlag = 0;
             tmp_var_str = stack_buffer;
         } else {
             // Do not fit into stack buffer setup an heap buffer
-            HeapBufferFlag = 1;
+            *ret_HeapBufferFlag = 1;
             tmp_var_str = my_malloc (len_first_part + MaxSize + MAX_COLOR_STRING_LEN);
             if (tmp_var_str == NULL) {
-                return -1;
+                return NULL;
             }
             MEMCPY (tmp_var_str, stack_buffer, len_first_part);
         }
@@ -420,7 +448,7 @@ int write_varinfos_to_ini (BB_VARIABLE *sp_vari_elem,
         break;
     }
     case BB_CONV_RAT_FUNC:
-        len_convertion = PrintFormatToString (tmp_var_str + len_first_part, sizeof(stack_buffer) - len_first_part, "%.18g:%.18g:%.18g:%.18g:%.18g:%.18g",
+        len_convertion = PrintFormatToString (tmp_var_str + len_first_part, INI_MAX_LINE_LENGTH - len_first_part, "%.18g:%.18g:%.18g:%.18g:%.18g:%.18g",
                                  sp_vari_elem->pAdditionalInfos->Conversion.Conv.RatFunc.a,
                                  sp_vari_elem->pAdditionalInfos->Conversion.Conv.RatFunc.b,
                                  sp_vari_elem->pAdditionalInfos->Conversion.Conv.RatFunc.c,
@@ -439,6 +467,38 @@ int write_varinfos_to_ini (BB_VARIABLE *sp_vari_elem,
     }
     PrintFormatToString (tmp_var_str + len_first_part + len_convertion, MAX_COLOR_STRING_LEN, ",(%d,%d,%d)",
              Red, Blue, Green);
+    return tmp_var_str;
+}
+#endif
+
+int write_varinfos_to_ini (BB_VARIABLE *sp_vari_elem,
+                           uint32_t WriteReqFlags)
+{
+#ifdef REMOTE_MASTER
+    int Ret;
+    //Ret = rm_write_varinfos_to_ini(sp_vari_elem);
+    Ret = BlackboardIniCache_AddEntry(sp_vari_elem->pAdditionalInfos->Name, sp_vari_elem->pAdditionalInfos->Unit, sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString,
+                                      sp_vari_elem->pAdditionalInfos->Min, sp_vari_elem->pAdditionalInfos->Max, sp_vari_elem->pAdditionalInfos->Step,
+                                      sp_vari_elem->pAdditionalInfos->Width, sp_vari_elem->pAdditionalInfos->Prec, sp_vari_elem->pAdditionalInfos->StepType, sp_vari_elem->pAdditionalInfos->Conversion.Type,
+                                      sp_vari_elem->pAdditionalInfos->RgbColor, WriteReqFlags);
+    return Ret;
+#else
+    // Do not write anything to the INI file
+    if (s_main_ini_val.DontWriteBlackbardVariableInfosToIni) return 0;
+
+    if (s_main_ini_val.ConnectToRemoteMaster) {
+        return rm_WriteToBlackboardIniCache(sp_vari_elem, WriteReqFlags);
+    }
+
+    char stack_buffer[INI_MAX_LINE_LENGTH];   // max. line legth inside an INI file
+    char *tmp_var_str;
+    int HeapBufferFlag;
+    int Ret;
+
+    tmp_var_str = build_varinfos_ini_line (sp_vari_elem, stack_buffer, &HeapBufferFlag);
+    if (tmp_var_str == NULL) {
+        return -1;
+    }
 
     // Write string to INI file
     if (!IniFileDataBaseWriteString(VARI_SECTION,
@@ -456,6 +516,138 @@ int write_varinfos_to_ini (BB_VARIABLE *sp_vari_elem,
 #endif
 }
 
+#ifndef REMOTE_MASTER
+// Variables with changed infos which are not written to the INI database till now
+static VID *IniWritePendingVids;
+static int IniWritePendingCount;
+static int IniWritePendingSize;
+#endif
+
+// Mark the infos of a variable to be written with the next flush_varinfos_to_ini(), so several changes
+// of one variable will be written only once. Must be called outside the blackboard critical section.
+static void defer_write_varinfos_to_ini (int vid_index, uint32_t WriteReqFlags)
+{
+#ifdef REMOTE_MASTER
+    // the INI cache of the remote master is already a memory only cache
+    write_varinfos_to_ini (&blackboard[vid_index], WriteReqFlags);
+#else
+    int Immediately = 0;
+
+    if (s_main_ini_val.DontWriteBlackbardVariableInfosToIni) return;
+
+    EnterCriticalSection (&BlackboardCriticalSection);
+    if ((blackboard[vid_index].Vid > 0) && !blackboard[vid_index].pAdditionalInfos->IniWritePending) {
+        if (IniWritePendingCount >= IniWritePendingSize) {
+            int NewSize = IniWritePendingSize + IniWritePendingSize / 2 + 64;
+            VID *NewVids = (VID*)my_realloc (IniWritePendingVids, (size_t)NewSize * sizeof (VID));
+            if (NewVids == NULL) {
+                Immediately = 1;
+            } else {
+                IniWritePendingVids = NewVids;
+                IniWritePendingSize = NewSize;
+            }
+        }
+        if (!Immediately) {
+            IniWritePendingVids[IniWritePendingCount++] = blackboard[vid_index].Vid;
+            blackboard[vid_index].pAdditionalInfos->IniWritePending = 1;
+        }
+    }
+    LeaveCriticalSection (&BlackboardCriticalSection);
+    if (Immediately) {
+        write_varinfos_to_ini (&blackboard[vid_index], WriteReqFlags);
+    }
+#endif
+}
+
+// Write the infos of a variable immediately if they are pending, this must be called
+// inside the blackboard critical section before a variable will be removed
+static void write_pending_varinfos_to_ini_cs (int vid_index)
+{
+#ifndef REMOTE_MASTER
+    if (blackboard[vid_index].pAdditionalInfos->IniWritePending) {
+        blackboard[vid_index].pAdditionalInfos->IniWritePending = 0;
+        write_varinfos_to_ini (&blackboard[vid_index], INI_CACHE_ENTRY_FLAG_ALL_INFOS);
+    }
+#else
+    UNUSED(vid_index);
+#endif
+}
+
+int flush_varinfos_to_ini (void)
+{
+#ifdef REMOTE_MASTER
+    return 0;
+#else
+    char stack_buffer[INI_MAX_LINE_LENGTH];
+    const char **Names;
+    const char **Texts;
+    VID *Vids;
+    int Count, Lines, x;
+    int Ret = 0;
+
+    if (blackboard == NULL) return 0;
+
+    EnterCriticalSection (&BlackboardCriticalSection);
+    Vids = IniWritePendingVids;
+    Count = IniWritePendingCount;
+    IniWritePendingVids = NULL;
+    IniWritePendingCount = IniWritePendingSize = 0;
+    LeaveCriticalSection (&BlackboardCriticalSection);
+    if (Count == 0) {
+        if (Vids != NULL) my_free (Vids);
+        return 0;
+    }
+    Names = (const char**)my_malloc ((size_t)Count * 2 * sizeof (const char*));
+    if (Names == NULL) {
+        ThrowError (1, "out of memory cannot write variable infos to INI file");
+        my_free (Vids);
+        return -1;
+    }
+    Texts = Names + Count;
+
+    // Build all lines, the variables can be removed meanwhile so copy also the names.
+    // The lock will be released in between that the blackboard is not blocked too long.
+    Lines = 0;
+    EnterCriticalSection (&BlackboardCriticalSection);
+    for (x = 0; x < Count; x++) {
+        int vid_index = get_variable_index (Vids[x]);
+        if ((vid_index >= 0) && blackboard[vid_index].pAdditionalInfos->IniWritePending) {
+            int HeapBufferFlag;
+            char *Line;
+            blackboard[vid_index].pAdditionalInfos->IniWritePending = 0;
+            Line = build_varinfos_ini_line (&blackboard[vid_index], stack_buffer, &HeapBufferFlag);
+            if (Line != NULL) {
+                Names[Lines] = StringMalloc (blackboard[vid_index].pAdditionalInfos->Name);
+                Texts[Lines] = HeapBufferFlag ? Line : StringMalloc (Line);
+                if ((Names[Lines] == NULL) || (Texts[Lines] == NULL)) {
+                    if (Names[Lines] != NULL) my_free (Names[Lines]);
+                    if (Texts[Lines] != NULL) my_free (Texts[Lines]);
+                    Ret = -1;
+                } else {
+                    Lines++;
+                }
+            }
+        }
+        if ((x & 0x3FF) == 0x3FF) {
+            LeaveCriticalSection (&BlackboardCriticalSection);
+            EnterCriticalSection (&BlackboardCriticalSection);
+        }
+    }
+    LeaveCriticalSection (&BlackboardCriticalSection);
+
+    if (IniFileDataBaseWriteStrings (VARI_SECTION, Names, Texts, Lines, GetMainFileDescriptor()) < 0) {
+        Ret = -1;
+    }
+    for (x = 0; x < Lines; x++) {
+        my_free (Names[x]);
+        my_free (Texts[x]);
+    }
+    my_free (Names);
+    my_free (Vids);
+    return Ret;
+#endif
+}
+
 #ifdef REMOTE_MASTER
 int read_varinfos_from_ini(const char *sz_varname,
                            BB_VARIABLE *sp_vari_elem,
@@ -529,31 +721,28 @@ int read_varinfos_from_ini(const char *sz_varname,
 
 #else
 
-int read_varinfos_from_ini (const char *sz_varname,
-                            BB_VARIABLE *sp_vari_elem,
-                            int type,
-                            uint32_t ReadFromIniReqMask)
+// tmp_var_str is the already read INI entry of the variable (or NULL if there is no one), it will be modified
+static int set_varinfos_from_ini_entry (BB_VARIABLE *sp_vari_elem,
+                                        int type,
+                                        char *tmp_var_str)
 {
-    UNUSED(ReadFromIniReqMask);
     int   error;
-    char *tmp_var_str;
     BB_VARIABLE s_vari_elem;
     char unit_save[BBVARI_UNIT_SIZE];
 
+    if (tmp_var_str == NULL) {
+        set_default_varinfo (sp_vari_elem, type);
+        return 0;
+    }
+
     if (strlen ((const char*)sp_vari_elem->pAdditionalInfos->Unit)) {
         StringCopyMaxCharTruncate (unit_save, (const char*)sp_vari_elem->pAdditionalInfos->Unit, BBVARI_UNIT_SIZE);
     } else unit_save[0] = 0;
 
-    if ((tmp_var_str = IniFileDataBaseReadStringBufferNoDef (VARI_SECTION, sz_varname, GetMainFileDescriptor())) == NULL) {
-        set_default_varinfo (sp_vari_elem, type);
-        return 0;
-    }
     if ((error = set_varinfo_to_inientrys (sp_vari_elem, tmp_var_str)) != 0) {
         set_default_varinfo (sp_vari_elem, type);
-        IniFileDataBaseReadStringBufferFree(tmp_var_str);
         return error;
     }
-    IniFileDataBaseReadStringBufferFree(tmp_var_str);
 
     // Make a copy of the variable
     MEMCPY (&s_vari_elem, sp_vari_elem, sizeof(BB_VARIABLE));
@@ -577,6 +766,21 @@ int read_varinfos_from_ini (const char *sz_varname,
 
     return 0;
 }
+
+int read_varinfos_from_ini (const char *sz_varname,
+                            BB_VARIABLE *sp_vari_elem,
+                            int type,
+                            uint32_t ReadFromIniReqMask)
+{
+    UNUSED(ReadFromIniReqMask);
+    int Ret;
+    char *tmp_var_str;
+
+    tmp_var_str = IniFileDataBaseReadStringBufferNoDef (VARI_SECTION, sz_varname, GetMainFileDescriptor());
+    Ret = set_varinfos_from_ini_entry (sp_vari_elem, type, tmp_var_str);
+    if (tmp_var_str != NULL) IniFileDataBaseReadStringBufferFree(tmp_var_str);
+    return Ret;
+}
 #endif
 
 int get_bb_accessmask (PID pid, uint64_t *mask, char *BBPrefix)
@@ -629,10 +833,9 @@ int free_bb_accessmask (PID pid, uint64_t mask)
     // Reset the process flag of all variables
     for (i = 0; i < get_blackboardsize(); i++) {
         if (blackboard[i].Vid >= 0) {
-            blackboard[i].AccessFlags &= (~mask);
+            BB_ACCESS_FLAGS(i) &= (~mask);
             blackboard[i].RangeControlFlag &= (~mask);
             blackboard[i].WrEnableFlags &= (~mask);
-            blackboard[i].WrFlags &= (~mask);
         }
     }
     LeaveCriticalSection (&BlackboardCriticalSection);
@@ -718,49 +921,61 @@ int IfUnknowWaitDataTypeConvert (int UnknwonDataType, int *ret_DataType)
     }
 }
 
-#ifdef USE_HASH_BB_SEARCH
-int BinarySearchIndex(const char *Name, uint64_t HashCode, int32_t *ret_p1, int32_t *ret_p2)
+// Setup a new variable at the free blackboard index, the lock must be hold
+static int init_new_bbvari_cs (int index, const char *name, enum BB_DATA_TYPES type, const char *unit, int pid_index)
 {
-    int Found = 0;
-    int index;
-    int32_t P1, P2;
+    int RealType;
+    int cc;
+    BB_VARIABLE_ADDITIONAL_INFOS *Save = blackboard[index].pAdditionalInfos;
 
-    index = BinaryHashSerchIndex(HashCode, &P1, &P2);
-    if (index >= 0) {
-        int32_t SaveP1, SaveP2;
-        if (strcmp(Name, (char*)blackboard[index].pAdditionalInfos->Name) == 0) {
-            Found = 1;
-        } else {
-            SaveP1 = P1;
-            SaveP2 = P2;
-            while ((index = GetNextIndexBeforeSameHash(HashCode, &P1, &P2)) >= 0) {
-                if (strcmp(Name, (char*)blackboard[index].pAdditionalInfos->Name) == 0) {
-                    Found = 1;
-                    break;
-                }
-            }
-            if (!Found) {
-                P1 = SaveP1;
-                P2 = SaveP2;
-                while ((index = GetNextIndexBehindSameHash(HashCode, &P1, &P2)) >= 0) {
-                    if (strcmp(Name, (char*)blackboard[index].pAdditionalInfos->Name) == 0) {
-                        Found = 1;
-                        break;
-                    }
-                }
-            }
-            if (!Found) {
-                P1 = SaveP1;
-                P2 = SaveP2;
-            }
-        }
+    // Incremet global Vid counter
+    blackboard_infos.VarCount++;
+
+    // overwrite old data
+    STRUCT_ZERO_INIT (blackboard[index], BB_VARIABLE);
+    blackboard[index].pAdditionalInfos = Save;
+
+    cc = ((blackboard_infos.VarCount & 0x7F) << 1) | 1; // Vid should be never 0. Therefor the LSB is always 1
+    // Generate Vid and add them
+    blackboard[index].Vid = ((VID)index << 8) | cc;
+
+    // Alloc memory for additionalInfos
+    if (blackboard[index].pAdditionalInfos == NULL) {
+        blackboard[index].pAdditionalInfos = (BB_VARIABLE_ADDITIONAL_INFOS*)my_calloc(1, sizeof(BB_VARIABLE_ADDITIONAL_INFOS));
+    }
+    if (blackboard[index].pAdditionalInfos == NULL) {
+        return BB_VAR_ADD_INFOS_MEM_ERROR;
     }
-    *ret_p1 = P1;
-    *ret_p2 = P2;
-    if (Found) return index;
-    else return -1;
+
+    // Insert all variable data
+    if (BBWriteName(name, &blackboard[index]) != 0) {
+        // No memory available
+        return BB_VAR_ADD_INFOS_MEM_ERROR;
+    }
+
+    if (IfUnknowDataTypeConvert (type, &RealType)) {
+        SET_BB_TYPE(index, RealType);
+    } else {
+        SET_BB_TYPE(index, type);
+    }
+    // Increment the access counters
+    if (type == BB_UNKNOWN_WAIT) {
+        blackboard[index].pAdditionalInfos->UnknownWaitAttachCount++;
+        SetAttachCount (&blackboard[index].pAdditionalInfos->ProcessUnknownWaitAttachCounts, pid_index, 1);
+    } else {
+        blackboard[index].pAdditionalInfos->AttachCount++;
+        SetAttachCount (&blackboard[index].pAdditionalInfos->ProcessAttachCounts, pid_index, 1);
+    }
+    BB_ACCESS_FLAGS(index) =
+    blackboard[index].WrEnableFlags = 1ULL << pid_index;
+    blackboard[index].RangeControlFlag = 1ULL << pid_index;
+
+    if (BBWriteUnit((unit != NULL) ? unit : "", &blackboard[index]) != 0) {
+        // No memory available
+        return BB_VAR_ADD_INFOS_MEM_ERROR;
+    }
+    return 0;
 }
-#endif
 
 VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *unit, int Pid, int Dir, int ValueValidFlag, union BB_VARI *Value, int *ret_Type,
                          uint32_t ReadFromIniReqMask, uint32_t *ret_WriteToIniFlag , uint32_t *ret_Observation, uint32_t *ret_AddRemoveObservation)
@@ -773,7 +988,6 @@ VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *
     VID Ret = -1;
 #ifdef USE_HASH_BB_SEARCH
     uint64_t HashCode;
-    int32_t P1, P2;
 #endif
 
     //BEGIN_RUNTIME_MEASSUREMENT ("add_bbvari_pid_type")
@@ -816,7 +1030,7 @@ VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *
     // lock if variable already available
 #ifdef USE_HASH_BB_SEARCH
     HashCode = BuildHashCode(name);
-    index = BinarySearchIndex(name, HashCode, &P1, &P2);
+    index = SearchHashKey(name, HashCode, NULL);
     if (index >= 0) {
         int ReadFromIniFlag = 0;
 
@@ -831,19 +1045,19 @@ VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *
                     if (blackboard[index].Type == BB_UNKNOWN_WAIT) {  // Data type is not defined
                         int RealType;
                         if (IfUnknowDataTypeConvert (type, &RealType)) {
-                            blackboard[index].Type = RealType;
+                            SET_BB_TYPE(index, RealType);
                             // If there is already a conversion formula remove it
                             if (blackboard[index].pAdditionalInfos->Conversion.Type == BB_CONV_FORMULA) {
                                 remove_exec_stack_cs ((struct EXEC_STACK_ELEM*)blackboard[index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode, 0);
                             }
                             ReadFromIniFlag = 1;
                             // If this is a new Variable that are added with add_bbvari init it with 0
-                            double_to_bbvari (blackboard[index].Type, &blackboard[index].Value, 0.0);
+                            double_to_bbvari (blackboard[index].Type, &BB_VALUE(index), 0.0);
                         } else if (type == BB_UNKNOWN) {
                             Ret = WRONG_PARAMETER;   // Error
                             goto __OUT_CRITICAL;
                         } else if (type != BB_UNKNOWN_WAIT) {
-                            blackboard[index].Type = type;
+                            SET_BB_TYPE(index, type);
                             // If there is already a conversion formula remove it
                             if (blackboard[index].pAdditionalInfos->Conversion.Type == BB_CONV_FORMULA) {
                                 remove_exec_stack_cs ((struct EXEC_STACK_ELEM*)blackboard[index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode, 0);
@@ -852,13 +1066,12 @@ VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *
 
                             // If this is a new Variable that are added with add_bbvari init it with 0
                             if (ValueValidFlag && (Value != NULL)) {
-                                blackboard[index].Value = *Value;
+                                BB_VALUE(index) = *Value;
                             } else {
-                                double_to_bbvari (blackboard[index].Type, &blackboard[index].Value, 0.0);
+                                double_to_bbvari (blackboard[index].Type, &BB_VALUE(index), 0.0);
                             }
                             ValueValidFlag = 0;  // do not overwrite it later
                         }
-                        blackboard[index].WrFlags = 0;
                         // If before was added with unknown data type and now have a valid data type than inform all which are observe this variable
                         // here will be set only a flag inside the critical section. the send of the information must be done outside the lock.
                         if (type != BB_UNKNOWN_WAIT) {
@@ -883,28 +1096,22 @@ VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *
                     // Increment the access counters
                     if (type == BB_UNKNOWN_WAIT) {
                         blackboard[index].pAdditionalInfos->UnknownWaitAttachCount++;
-                        if (blackboard[index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index] == 0) {
-                            blackboard[index].WrFlags &= ~(1ULL << pid_index);
-                        }
-                        blackboard[index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index]++;
+                        IncAttachCount (&blackboard[index].pAdditionalInfos->ProcessUnknownWaitAttachCounts, pid_index);
                     } else {
                         blackboard[index].pAdditionalInfos->AttachCount++;
-                        if (blackboard[index].pAdditionalInfos->ProcessAttachCounts[pid_index] == 0) {
-                            blackboard[index].WrFlags &= ~(1ULL << pid_index);
-                        }
-                        blackboard[index].pAdditionalInfos->ProcessAttachCounts[pid_index]++;
+                        IncAttachCount (&blackboard[index].pAdditionalInfos->ProcessAttachCounts, pid_index);
                     }
 
-                    if (!(blackboard[index].AccessFlags & (1ULL << pid_index))) {
+                    if (!(BB_ACCESS_FLAGS(index) & (1ULL << pid_index))) {
                         blackboard[index].WrEnableFlags |= (1ULL << pid_index);
                     }
-                    blackboard[index].AccessFlags |= (1ULL << pid_index);
+                    BB_ACCESS_FLAGS(index) |= (1ULL << pid_index);
                     blackboard[index].RangeControlFlag |= (1ULL << pid_index);
 
 
                     // if init value valid (reference lists)
                     if (ValueValidFlag && (Value != NULL) && ((Dir & PIPE_API_REFERENCE_VARIABLE_DIR_WRITE) == PIPE_API_REFERENCE_VARIABLE_DIR_WRITE)) {
-                        blackboard[index].Value = *Value;
+                        BB_VALUE(index) = *Value;
                     }
 
                     // Return the variable-id
@@ -916,6 +1123,8 @@ VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *
                         set_default_varinfo(&blackboard[index], blackboard[index].Type);
                         read_varinfos_from_ini (name,
                                                 &blackboard[index], type, ReadFromIniReqMask);
+                        // an unknown data type can be taken over from the INI file
+                        SET_BB_TYPE(index, blackboard[index].Type);
                     }
 
                     // If before was added with unknown data type and now have a valid data inform all outside the lock
@@ -957,7 +1166,6 @@ VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *
 #ifdef USE_HASH_BB_SEARCH
     index = GetFreeBlackboardIndex();
     if (index >= 0) {
-        AddBinaryHashKey(HashCode, index, P1, P2);
 #else
     if (index_save2 >= 0) {
         index = index_save2;
@@ -970,74 +1178,15 @@ VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *
         // freies Element suchen
 #endif
         if (blackboard[index].Vid == -1) {
-            int RealType;
-            int cc;
-            BB_VARIABLE_ADDITIONAL_INFOS *Save = blackboard[index].pAdditionalInfos;
-
-            // Incremet global Vid counter
-            blackboard_infos.VarCount++;
-
-            // overwrite old data
-            STRUCT_ZERO_INIT (blackboard[index], BB_VARIABLE);
-            blackboard[index].pAdditionalInfos = Save;
-
-            cc = ((blackboard_infos.VarCount & 0x7F) << 1) | 1; // Vid should be never 0. Therefor the LSB is always 1
-            // Generate Vid and add them
-            blackboard[index].Vid = ((VID)index << 8) | cc;
-
-            // Alloc memory for additionalInfos
-            if (blackboard[index].pAdditionalInfos == NULL) {
-                blackboard[index].pAdditionalInfos = (BB_VARIABLE_ADDITIONAL_INFOS*)my_calloc(1, sizeof(BB_VARIABLE_ADDITIONAL_INFOS));
-            }
-            if (blackboard[index].pAdditionalInfos == NULL) {
-                Ret = BB_VAR_ADD_INFOS_MEM_ERROR;
-                RemoveBinaryHashKey(P1, P2);
-                goto __OUT_CRITICAL;
-            }
-
-            // Insert all variable data
-            if (BBWriteName(name, &blackboard[index]) != 0) {
-                // No memory available
-                Ret = BB_VAR_ADD_INFOS_MEM_ERROR;
-                RemoveBinaryHashKey(P1, P2);
+            error = init_new_bbvari_cs (index, name, type, unit, pid_index);
+            if (error != 0) {
+                blackboard_infos.VarCount--;
+                blackboard[index].Vid = -1;
+                Ret = error;
+                FreeBlackboardIndex(index);
                 goto __OUT_CRITICAL;
             }
 
-            if (IfUnknowDataTypeConvert (type, &RealType)) {
-                blackboard[index].Type = RealType;
-            } else {
-                blackboard[index].Type = type;
-            }
-            // Increment the access counters
-            if (type == BB_UNKNOWN_WAIT) {
-                blackboard[index].pAdditionalInfos->UnknownWaitAttachCount++;
-                blackboard[index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index] = 1;
-            } else {
-                blackboard[index].pAdditionalInfos->AttachCount++;
-                blackboard[index].pAdditionalInfos->ProcessAttachCounts[pid_index] = 1;
-            }
-            blackboard[index].AccessFlags =
-            blackboard[index].WrEnableFlags = 1ULL << pid_index;
-            blackboard[index].RangeControlFlag = 1ULL << pid_index;
-
-            blackboard[index].WrFlags = 0;
-
-            if (unit != NULL) {
-                if (BBWriteUnit(unit, &blackboard[index]) != 0) {
-                    // No memory available
-                    Ret = BB_VAR_ADD_INFOS_MEM_ERROR;
-                    RemoveBinaryHashKey(P1, P2);
-                    goto __OUT_CRITICAL;
-                }
-            } else {
-                if (BBWriteUnit("", &blackboard[index]) != 0) {
-                    // No memory available
-                    Ret = BB_VAR_ADD_INFOS_MEM_ERROR;
-                    RemoveBinaryHashKey(P1, P2);
-                    goto __OUT_CRITICAL;
-                }
-            }
-
             // Read variable infos from INI file
             set_default_varinfo(&blackboard[index], blackboard[index].Type);
             error = read_varinfos_from_ini (name,
@@ -1046,19 +1195,44 @@ VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *
                 blackboard_infos.VarCount--;
                 blackboard[index].Vid = -1;
                 Ret = error;
-                RemoveBinaryHashKey(P1, P2);
+                FreeBlackboardIndex(index);
                 goto __OUT_CRITICAL;
             }
             if (blackboard[index].Type == BB_UNKNOWN_DOUBLE) {
-                blackboard[index].Type = BB_DOUBLE;
+                SET_BB_TYPE(index, BB_DOUBLE);
+            } else {
+                // an unknown data type can be taken over from the INI file
+                SET_BB_TYPE(index, blackboard[index].Type);
             }
 
             // If this is a new Variable that are added with add_bbvari init it with 0
             if (ValueValidFlag && (Value != NULL)) {
-                blackboard[index].Value = *Value;
+                BB_VALUE(index) = *Value;
             } else {
-                double_to_bbvari (blackboard[index].Type, &blackboard[index].Value, 0.0);
+                double_to_bbvari (blackboard[index].Type, &BB_VALUE(index), 0.0);
             }
+#ifndef REMOTE_MASTER
+            if (AddNameIndex(blackboard[index].pAdditionalInfos->Name, index) != 0) {
+                blackboard_infos.VarCount--;
+                blackboard[index].Vid = -1;
+                Ret = BB_VAR_ADD_INFOS_MEM_ERROR;
+                FreeBlackboardIndex(index);
+                goto __OUT_CRITICAL;
+            }
+#endif
+#ifdef USE_HASH_BB_SEARCH
+            // Lock-free readers should find the variable not before it is complete
+            if (AddHashKey(name, HashCode, index, blackboard[index].Vid) != 0) {
+#ifndef REMOTE_MASTER
+                RemoveNameIndex(index);
+#endif
+                blackboard_infos.VarCount--;
+                blackboard[index].Vid = -1;
+                Ret = BB_VAR_ADD_INFOS_MEM_ERROR;
+                FreeBlackboardIndex(index);
+                goto __OUT_CRITICAL;
+            }
+#endif
 
             // Adjust variable count inside blackboard
             blackboard_infos.NumOfVaris++;
@@ -1071,7 +1245,7 @@ VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *
             // Save entry immediately (if there was set default values)
             // wurden)
             if (ret_WriteToIniFlag == NULL) {
-                write_varinfos_to_ini(&blackboard[index], INI_CACHE_ENTRY_FLAG_ALL_INFOS);
+                defer_write_varinfos_to_ini(index, INI_CACHE_ENTRY_FLAG_ALL_INFOS);
             } else {
                 *ret_WriteToIniFlag |= INI_CACHE_ENTRY_FLAG_ALL_INFOS;
             }
@@ -1080,7 +1254,7 @@ VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *
 
             goto __OUT;  //not CRITICAL!
         } else {
-            RemoveBinaryHashKey(P1, P2);
+            ThrowError (1, "internal error blackboard index %i is not free", index);
         }
     }
     Ret = NO_FREE_VID;   // Error
@@ -1091,6 +1265,205 @@ __OUT:
 }
 
 
+#ifdef USE_HASH_BB_SEARCH
+typedef struct {
+    uint64_t Hash;
+    int32_t Pos;      // position inside the request list
+    int32_t Fill1;
+} ADD_BBVARI_FRAME_ELEM;
+#endif
+
+int add_bbvari_pid_type_frame (int Number, const char **Names, enum BB_DATA_TYPES *Types, const char **Units, int *Dirs, int Pid,
+                               int ValueValidFlag, union BB_VARI *Values, uint32_t ReadReqMask, VID *ret_Vids, int *ret_Types)
+{
+    int x;
+#ifdef USE_HASH_BB_SEARCH
+    ADD_BBVARI_FRAME_ELEM *Elems = NULL;
+    int32_t *Indexes = NULL;
+    int Count, NewCount;
+    int pid_index;
+#ifndef REMOTE_MASTER
+    const char **IniNames = NULL;
+    char **IniEntrys = NULL;
+#endif
+#endif
+
+    // is blackboard exists here or inside the remote master or not at all
+    if (blackboard == NULL) {
+#ifndef REMOTE_MASTER
+        if (s_main_ini_val.ConnectToRemoteMaster) {
+            return rm_add_bbvari_pid_type_frame (Number, Names, Types, Units, Dirs, Pid, ValueValidFlag, Values, ReadReqMask, ret_Vids, ret_Types);
+        }
+#endif
+        return NOT_INITIALIZED;
+    }
+    if (Number <= 0) return 0;
+    if (Pid <= 0) {
+        Pid = GET_PID();
+    }
+    if (Values == NULL) ValueValidFlag = 0;
+
+#ifdef USE_HASH_BB_SEARCH
+    Elems = (ADD_BBVARI_FRAME_ELEM*)my_malloc ((size_t)Number * sizeof (ADD_BBVARI_FRAME_ELEM));
+    Indexes = (int32_t*)my_malloc ((size_t)Number * sizeof (int32_t));
+    if ((Elems == NULL) || (Indexes == NULL)) {
+        goto __SINGLE;
+    }
+
+    // Check all names outside the lock, a 0 inside ret_Vids marks a variable that should be added
+    for (x = Count = 0; x < Number; x++) {
+        const char *Unit = (Units != NULL) ? Units[x] : NULL;
+        if (!IsValidVariableName (Names[x])) {
+            ret_Vids[x] = LABEL_NAME_NOT_VALID;
+        } else if ((strlen(Names[x]) + 1 > BBVARI_NAME_SIZE) ||
+                   ((Unit != NULL) && (strlen(Unit) + 1 > BBVARI_UNIT_SIZE))) {
+            ret_Vids[x] = WRONG_PARAMETER;
+        } else {
+            ret_Vids[x] = 0;
+            Elems[Count].Hash = BuildHashCode (Names[x]);
+            Elems[Count].Pos = x;
+            Count++;
+        }
+    }
+
+#ifndef REMOTE_MASTER
+    // Read the INI entrys of all variables with one pass through the variable section
+    IniNames = (const char**)my_malloc ((size_t)Count * sizeof (const char*));
+    IniEntrys = (char**)my_malloc ((size_t)Count * sizeof (char*));
+    if ((IniNames != NULL) && (IniEntrys != NULL)) {
+        for (x = 0; x < Count; x++) {
+            IniNames[x] = Names[Elems[x].Pos];
+        }
+        if (IniFileDataBaseReadStringBuffers (VARI_SECTION, IniNames, Count, IniEntrys, GetMainFileDescriptor()) < 0) {
+            my_free (IniEntrys);
+            IniEntrys = NULL;
+        }
+    } else if (IniEntrys != NULL) {
+        my_free (IniEntrys);
+        IniEntrys = NULL;
+    }
+#endif
+
+    EnterCriticalSection (&BlackboardCriticalSection);
+
+    // Is process-id valid
+    if ((pid_index = get_process_index(Pid)) == -1) {
+        LeaveCriticalSection (&BlackboardCriticalSection);
+        for (x = 0; x < Count; x++) {
+            ret_Vids[Elems[x].Pos] = UNKNOWN_PROCESS;
+        }
+        goto __OUT;
+    }
+
+    for (x = NewCount = 0; x < Count; x++) {
+        int p = Elems[x].Pos;
+        int index;
+        VID error;
+
+        // Variables which already exist or are more than once inside the list will be added later one by one
+        if (SearchHashKey (Names[p], Elems[x].Hash, NULL) >= 0) continue;
+
+        // A variable cannot added if variable don't exit before and type == BB_UNKNOWN
+        if (Types[p] == BB_UNKNOWN) {
+            ret_Vids[p] = WRONG_PARAMETER;
+            continue;
+        }
+        index = GetFreeBlackboardIndex();
+        if (index < 0) {
+            ret_Vids[p] = NO_FREE_VID;
+            continue;
+        }
+        error = init_new_bbvari_cs (index, Names[p], Types[p], (Units != NULL) ? Units[p] : NULL, pid_index);
+        if (error == 0) {
+            // Read variable infos from INI file
+            set_default_varinfo(&blackboard[index], blackboard[index].Type);
+#ifndef REMOTE_MASTER
+            if (IniEntrys != NULL) {
+                error = set_varinfos_from_ini_entry (&blackboard[index], Types[p], IniEntrys[x]);
+            } else
+#endif
+            error = read_varinfos_from_ini (Names[p], &blackboard[index], Types[p], ReadReqMask);
+        }
+#ifndef REMOTE_MASTER
+        if ((error == 0) && (AddNameIndex (blackboard[index].pAdditionalInfos->Name, index) != 0)) {
+            error = BB_VAR_ADD_INFOS_MEM_ERROR;
+        }
+#endif
+        if ((error == 0) && (AddHashKey (Names[p], Elems[x].Hash, index, blackboard[index].Vid) != 0)) {
+            error = BB_VAR_ADD_INFOS_MEM_ERROR;
+        }
+        if (error != 0) {
+#ifndef REMOTE_MASTER
+            RemoveNameIndex (index);
+#endif
+            blackboard_infos.VarCount--;
+            blackboard[index].Vid = -1;
+            FreeBlackboardIndex (index);
+            ret_Vids[p] = error;
+            continue;
+        }
+        if (blackboard[index].Type == BB_UNKNOWN_DOUBLE) {
+            SET_BB_TYPE(index, BB_DOUBLE);
+        } else {
+            // an unknown data type can be taken over from the INI file
+            SET_BB_TYPE(index, blackboard[index].Type);
+        }
+        if (ValueValidFlag) {
+            BB_VALUE(index) = Values[p];
+        } else {
+            double_to_bbvari (blackboard[index].Type, &BB_VALUE(index), 0.0);
+        }
+        blackboard_infos.NumOfVaris++;
+
+        ret_Vids[p] = blackboard[index].Vid;
+        if (ret_Types != NULL) ret_Types[p] = blackboard[index].Type;
+        Indexes[NewCount] = index;
+        NewCount++;
+    }
+    LeaveCriticalSection (&BlackboardCriticalSection);
+
+    for (x = 0; x < NewCount; x++) {
+        defer_write_varinfos_to_ini (Indexes[x], INI_CACHE_ENTRY_FLAG_ALL_INFOS);
+        CHECK_ADD_REMOVE_OBSERVATION(blackboard[Indexes[x]].Vid, OBSERVE_ADD_VARIABLE);
+    }
+
+    // Now the remaining ones
+    for (x = 0; x < Number; x++) {
+        if (ret_Vids[x] == 0) {
+            ret_Vids[x] = add_bbvari_pid_type (Names[x], Types[x], (Units != NULL) ? Units[x] : NULL, Pid, (Dirs != NULL) ? Dirs[x] : 0,
+                                               ValueValidFlag, (ValueValidFlag) ? &Values[x] : NULL, (ret_Types != NULL) ? &ret_Types[x] : NULL,
+                                               ReadReqMask, NULL, NULL, NULL);
+        }
+    }
+__OUT:
+#ifndef REMOTE_MASTER
+    // the infos of all new variables with one pass into the INI file
+    flush_varinfos_to_ini ();
+    if (IniEntrys != NULL) {
+        for (x = 0; x < Count; x++) {
+            if (IniEntrys[x] != NULL) IniFileDataBaseReadStringBufferFree (IniEntrys[x]);
+        }
+        my_free (IniEntrys);
+    }
+    if (IniNames != NULL) my_free (IniNames);
+#endif
+    my_free (Elems);
+    my_free (Indexes);
+    return 0;
+
+__SINGLE:
+    if (Elems != NULL) my_free (Elems);
+    if (Indexes != NULL) my_free (Indexes);
+#endif
+    for (x = 0; x < Number; x++) {
+        ret_Vids[x] = add_bbvari_pid_type (Names[x], Types[x], (Units != NULL) ? Units[x] : NULL, Pid, (Dirs != NULL) ? Dirs[x] : 0,
+                                           ValueValidFlag, (ValueValidFlag) ? &Values[x] : NULL, (ret_Types != NULL) ? &ret_Types[x] : NULL,
+                                           ReadReqMask, NULL, NULL, NULL);
+    }
+    return 0;
+}
+
+
 VID add_bbvari_pid (const char *name, enum BB_DATA_TYPES type, const char *unit, int Pid)
 {
     return add_bbvari_pid_type (name, type, unit, Pid, 0, 0, NULL, NULL, READ_ALL_INFOS_BBVARI_FROM_INI, NULL, NULL, NULL);
@@ -1456,7 +1829,7 @@ VID add_bbvari_all_infos (int Pid, const char *name, int type, const char *unit,
         CHECK_OBSERVATION(vid_index, Observation);
         CHECK_ADD_REMOVE_OBSERVATION(vid, AddRemoveObservation);
         if (WriteToIniFlag != 0) {
-            write_varinfos_to_ini(&blackboard[vid_index], WriteToIniFlag);
+            defer_write_varinfos_to_ini(vid_index, WriteToIniFlag);
         }
     }
     return vid;
@@ -1490,14 +1863,14 @@ static int __attach_bbvari (VID vid, int unknown_wait_flag, int cs, int pid)
     // Increment the access counters
     if (unknown_wait_flag) {
         blackboard[vid_index].pAdditionalInfos->UnknownWaitAttachCount++;
-        blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index]++;
+        IncAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts, pid_index);
     } else {
         blackboard[vid_index].pAdditionalInfos->AttachCount++;
-        blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts[pid_index]++;
+        IncAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts, pid_index);
     }
 
     // Set access rights
-    blackboard[vid_index].AccessFlags |= 1ULL << pid_index;
+    BB_ACCESS_FLAGS(vid_index) |= 1ULL << pid_index;
     blackboard[vid_index].RangeControlFlag |= 1ULL << pid_index;
     blackboard[vid_index].WrEnableFlags |= 1ULL << pid_index;
 
@@ -1528,6 +1901,30 @@ int attach_bbvari_unknown_wait (VID vid)
 }
 
 
+// Attach several variables with one lock of the blackboard, if the blackboard is inside
+// the remote master the requests are transmitted pipelined
+int attach_bbvari_frame (int Number, VID *Vids, int unknown_wait_flag, int pid, int *ret_Rets)
+{
+    int x, Ret = 0;
+
+    if (blackboard == NULL) {
+#ifndef REMOTE_MASTER
+        if (s_main_ini_val.ConnectToRemoteMaster) {
+            return rm_attach_bbvari_frame (Number, Vids, unknown_wait_flag, pid, ret_Rets);
+        }
+#endif
+        return NOT_INITIALIZED;
+    }
+    EnterCriticalSection (&BlackboardCriticalSection);
+    for (x = 0; x < Number; x++) {
+        int Status = __attach_bbvari (Vids[x], unknown_wait_flag, 0, pid);
+        if (Status < 0) Ret = -1;
+        if (ret_Rets != NULL) ret_Rets[x] = Status;
+    }
+    LeaveCriticalSection (&BlackboardCriticalSection);
+    return Ret;
+}
+
 int attach_bbvari_cs (VID vid, int cs)
 {
     return __attach_bbvari (vid, 0, cs, GET_PID());
@@ -1544,7 +1941,6 @@ VID attach_bbvari_by_name (const char *name, int pid)
     int vid_index;
 #ifdef USE_HASH_BB_SEARCH
     uint64_t HashCode;
-    int32_t P1, P2;
 #endif
     // Is blackboard exists here or inside the remote master or not at all
     if (blackboard == NULL) {
@@ -1561,7 +1957,7 @@ VID attach_bbvari_by_name (const char *name, int pid)
     EnterCriticalSection (&BlackboardCriticalSection);
 #ifdef USE_HASH_BB_SEARCH
     HashCode = BuildHashCode(name);
-    vid_index = BinarySearchIndex(name, HashCode, &P1, &P2);
+    vid_index = SearchHashKey(name, HashCode, NULL);
     if (vid_index >= 0) {    // Search variable
         __attach_bbvari (blackboard[vid_index].Vid, 0, 0, pid);
         LeaveCriticalSection (&BlackboardCriticalSection);
@@ -1591,19 +1987,22 @@ VID attach_bbvari_by_name (const char *name, int pid)
 
 void __free_all_additionl_info_memorys (BB_VARIABLE_ADDITIONAL_INFOS *pAdditionalInfos, int cs)
 {
-    if (pAdditionalInfos->Name != NULL) my_free (pAdditionalInfos->Name);
-    if (pAdditionalInfos->Unit != NULL) my_free (pAdditionalInfos->Unit);
+    if (pAdditionalInfos->Name != NULL) FreeNameString (pAdditionalInfos->Name);
+    if (pAdditionalInfos->Unit != NULL) ReleaseSharedString (pAdditionalInfos->Unit);
     if (pAdditionalInfos->DisplayName != NULL) my_free (pAdditionalInfos->DisplayName);
     if (pAdditionalInfos->Comment != NULL) my_free (pAdditionalInfos->Comment);
 
     if (pAdditionalInfos->Conversion.Type == BB_CONV_FORMULA) {
         remove_exec_stack_cs ((struct EXEC_STACK_ELEM *)pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode, cs);
-        my_free (pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
+        ReleaseSharedString (pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
         pAdditionalInfos->Conversion.Type = BB_CONV_NONE;
     } else if (pAdditionalInfos->Conversion.Type == BB_CONV_TEXTREP) {
-        my_free (pAdditionalInfos->Conversion.Conv.TextReplace.EnumString);
+        ReleaseSharedString (pAdditionalInfos->Conversion.Conv.TextReplace.EnumString);
         pAdditionalInfos->Conversion.Type = BB_CONV_NONE;
     }
+    TextReplaceFreeCompiled (pAdditionalInfos->Conversion.TextReplaceTable);
+    FreeAttachCounts (&pAdditionalInfos->ProcessAttachCounts);
+    FreeAttachCounts (&pAdditionalInfos->ProcessUnknownWaitAttachCounts);
     STRUCT_ZERO_INIT (*pAdditionalInfos, BB_VARIABLE_ADDITIONAL_INFOS);
 }
 
@@ -1651,24 +2050,21 @@ static int __remove_bbvari (VID vid, int unknown_wait_flag, int cs, int pid)
     // Decrement process attach counter
     ProcessMatch = 0;
     if (unknown_wait_flag) {
-        if (blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index]) {
-            blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index]--;
+        if (DecAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts, pid_index)) {
             ProcessMatch = 1;
         }
     } else {
-        if (blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts[pid_index]) {
-            blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts[pid_index]--;
+        if (DecAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts, pid_index)) {
             ProcessMatch = 1;
         }
     }
     if (ProcessMatch) {
-        if ((blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index] == 0) &&
-            (blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts[pid_index] == 0)) {
+        if ((GetAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts, pid_index) == 0) &&
+            (GetAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts, pid_index) == 0)) {
             // Reset access flag
-            blackboard[vid_index].AccessFlags &= ~(1ULL << pid_index);
+            BB_ACCESS_FLAGS(vid_index) &= ~(1ULL << pid_index);
             blackboard[vid_index].RangeControlFlag &= ~(1ULL << pid_index);
             blackboard[vid_index].WrEnableFlags &= ~(1ULL << pid_index);
-            blackboard[vid_index].WrFlags &= ~(1ULL << pid_index);
         }
         // decrement overall access counter
         if (unknown_wait_flag) {
@@ -1685,14 +2081,15 @@ static int __remove_bbvari (VID vid, int unknown_wait_flag, int cs, int pid)
             Vid_Save = blackboard[vid_index].Vid;
             if (blackboard[vid_index].pAdditionalInfos->UnknownWaitAttachCount == 0) {
     #ifdef USE_HASH_BB_SEARCH
-                int32_t P1, P2;
                 uint64_t HashCode = BuildHashCode(blackboard[vid_index].pAdditionalInfos->Name);  // Das sollte bein add_bbvari gespeichert werden!
-                int index = BinarySearchIndex(blackboard[vid_index].pAdditionalInfos->Name, HashCode, &P1, &P2);
-                if (index == vid_index) {
-                    RemoveBinaryHashKey(P1, P2);
+                if (RemoveHashKey(HashCode, vid_index) == 0) {
                     FreeBlackboardIndex(vid_index);
                 }
     #endif
+    #ifndef REMOTE_MASTER
+                RemoveNameIndex(vid_index);
+    #endif
+                write_pending_varinfos_to_ini_cs(vid_index);
                 __free_all_additionl_info_memorys(blackboard[vid_index].pAdditionalInfos, cs);
                 // Update the count of variable inside blackboard
                 blackboard_infos.NumOfVaris--;
@@ -1702,7 +2099,7 @@ static int __remove_bbvari (VID vid, int unknown_wait_flag, int cs, int pid)
                 CheckObservationFlag = 1;
             } else {
                 // Reset data type afterwards only display items can access this elements
-                blackboard[vid_index].Type = BB_UNKNOWN_WAIT;
+                SET_BB_TYPE(vid_index, BB_UNKNOWN_WAIT);
                 CheckDataTypeObservationFlag = 1;
             }
         }
@@ -1804,44 +2201,45 @@ int remove_all_bbvari (PID pid)
     for (vid_index = 0; vid_index < get_blackboardsize(); vid_index++) {
         if (blackboard[vid_index].Vid > -1) {
             // all variables was attachted by a process
-            if ((blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts[pid_index]) ||
-                (blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index])) {
+            int ProcessAttachCount = GetAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts, pid_index);
+            int ProcessUnknownWaitAttachCount = GetAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts, pid_index);
+            if (ProcessAttachCount || ProcessUnknownWaitAttachCount) {
                 // Decrement overall attach counter
-                if (blackboard[vid_index].pAdditionalInfos->AttachCount >= blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts[pid_index]) {
-                    blackboard[vid_index].pAdditionalInfos->AttachCount -= blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts[pid_index];
+                if (blackboard[vid_index].pAdditionalInfos->AttachCount >= ProcessAttachCount) {
+                    blackboard[vid_index].pAdditionalInfos->AttachCount -= ProcessAttachCount;
                 } else {
                     blackboard[vid_index].pAdditionalInfos->AttachCount = 0;
                 }
                 // Reset process attach counter
-                blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts[pid_index] = 0;
+                SetAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts, pid_index, 0);
 
                 // Decrement overall attach counter
-                if (blackboard[vid_index].pAdditionalInfos->UnknownWaitAttachCount >= blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index]) {
-                    blackboard[vid_index].pAdditionalInfos->UnknownWaitAttachCount -= blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index];
+                if (blackboard[vid_index].pAdditionalInfos->UnknownWaitAttachCount >= ProcessUnknownWaitAttachCount) {
+                    blackboard[vid_index].pAdditionalInfos->UnknownWaitAttachCount -= ProcessUnknownWaitAttachCount;
                 } else {
                     blackboard[vid_index].pAdditionalInfos->UnknownWaitAttachCount = 0;
                 }
                 // Reset process attach counter
-                blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index] = 0;
+                SetAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts, pid_index, 0);
 
                 // Reset access flags
-                blackboard[vid_index].AccessFlags &= ~(1ULL << pid_index);
+                BB_ACCESS_FLAGS(vid_index) &= ~(1ULL << pid_index);
                 blackboard[vid_index].RangeControlFlag &= ~(1ULL << pid_index);
                 blackboard[vid_index].WrEnableFlags &= ~(1ULL << pid_index);
-                blackboard[vid_index].WrFlags &= ~(1ULL << pid_index);
 
                 if (blackboard[vid_index].pAdditionalInfos->AttachCount == 0) {
                     int SaveVid = blackboard[vid_index].Vid;
                     if (blackboard[vid_index].pAdditionalInfos->UnknownWaitAttachCount == 0) {
 #ifdef USE_HASH_BB_SEARCH
-                        int32_t P1, P2;
                         uint64_t HashCode = BuildHashCode(blackboard[vid_index].pAdditionalInfos->Name);  // Das sollte bein add_bbvari gespeichert werden!
-                        int index = BinarySearchIndex(blackboard[vid_index].pAdditionalInfos->Name, HashCode, &P1, &P2);
-                        if (index == vid_index) {
-                            RemoveBinaryHashKey(P1, P2);
+                        if (RemoveHashKey(HashCode, vid_index) == 0) {
                             FreeBlackboardIndex(vid_index);
                         }
 #endif
+#ifndef REMOTE_MASTER
+                        RemoveNameIndex(vid_index);
+#endif
+                        write_pending_varinfos_to_ini_cs(vid_index);
                         __free_all_additionl_info_memorys(blackboard[vid_index].pAdditionalInfos, 0);
 
                         // Update the number ov variable inside the blackboard
@@ -1850,7 +2248,7 @@ int remove_all_bbvari (PID pid)
                         blackboard[vid_index].Vid = -1;
                     } else {
                         // Reset the data type only displays can access them
-                        blackboard[vid_index].Type = BB_UNKNOWN_WAIT;
+                        SET_BB_TYPE(vid_index, BB_UNKNOWN_WAIT);
                         // Inform all how observe this variable obout the chanfed data taype
                         CHECK_OBSERVATION (vid_index, OBSERVE_TYPE_CHANGED);
                         CHECK_ADD_REMOVE_OBSERVATION (SaveVid, OBSERVE_TYPE_CHANGED);
@@ -1886,7 +2284,7 @@ VID get_bbvarivid_by_name (const char *name)
     int vid_index;
 #ifdef USE_HASH_BB_SEARCH
     uint64_t HashCode;
-    int32_t P1, P2;
+    int32_t Vid;
 #endif
     // Is blackboard exists here or inside the remote master or not at all
     if (blackboard == NULL) {
@@ -1897,15 +2295,17 @@ VID get_bbvarivid_by_name (const char *name)
 #endif
         return 0;
     }
-    EnterCriticalSection (&BlackboardCriticalSection);
 #ifdef USE_HASH_BB_SEARCH
+    // The hash index can be searched without the BlackboardCriticalSection
     HashCode = BuildHashCode(name);
-    vid_index = BinarySearchIndex(name, HashCode, &P1, &P2);
-    if (vid_index >= 0) {    // Search variable
-        LeaveCriticalSection (&BlackboardCriticalSection);
-        return blackboard[vid_index].Vid;
+    // The index can be reused by another variable in the meantime, so take the VID from the hash index
+    vid_index = SearchHashKey(name, HashCode, &Vid);
+    if ((vid_index >= 0) && (Vid > 0)) {
+        return Vid;
     }
+    return 0;     // Error
 #else
+    EnterCriticalSection (&BlackboardCriticalSection);
     for (vid_index = 0; vid_index < get_blackboardsize(); vid_index++) {
         if (blackboard[vid_index].Vid > 0) {
             if (blackboard[vid_index].pAdditionalInfos != NULL) {
@@ -2063,7 +2463,7 @@ int get_process_bbvari_attach_count_pid(VID vid, PID pid)
         return UNKNOWN_PROCESS;
     }
 
-    return (int)blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts[pid_index];
+    return GetAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts, pid_index);
 }
 
 int get_process_bbvari_attach_count(VID vid)
@@ -2105,7 +2505,7 @@ int set_bbvari_unit (VID vid, const char *unit)
     LeaveCriticalSection(&BlackboardCriticalSection);
 
     // Now save all to the INI file
-    write_varinfos_to_ini(&blackboard[vid_index], INI_CACHE_ENTRY_FLAG_UNIT);
+    defer_write_varinfos_to_ini(vid_index, INI_CACHE_ENTRY_FLAG_UNIT);
 
     CHECK_OBSERVATION (vid_index, OBSERVE_UNIT_CHANGED);
     return 0;
@@ -2180,7 +2580,15 @@ int set_bbvari_conversion_x (VID vid, int convtype, const char *conversion, int
     // If there is already a conversion formula remove it
     if (blackboard[vid_index].pAdditionalInfos->Conversion.Type == BB_CONV_FORMULA) {
         remove_exec_stack_cs ((struct EXEC_STACK_ELEM*)blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode, 0);
+        blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode = NULL;
     }
+    // The conversion strings are shared with other variables, give the old one back
+    // before the union will be overwritten by the new conversion
+    if ((convertion_type_save == BB_CONV_FORMULA) || (convertion_type_save == BB_CONV_TEXTREP)) {
+        ReleaseSharedString (blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
+        blackboard[vid_index].pAdditionalInfos->Conversion.Type = BB_CONV_NONE;
+    }
+    blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString = NULL;
     LeaveCriticalSection (&BlackboardCriticalSection);
 
     switch (convtype) {
@@ -2216,7 +2624,7 @@ int set_bbvari_conversion_x (VID vid, int convtype, const char *conversion, int
         blackboard[vid_index].pAdditionalInfos->Conversion.Type = BB_CONV_NONE;
         if (blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode != NULL) my_free(blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode);
         blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode = NULL;
-        if (blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString != NULL) my_free(blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
+        if (blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString != NULL) ReleaseSharedString(blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
         blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString = NULL;
 #else
         // Translate formula
@@ -2224,7 +2632,7 @@ int set_bbvari_conversion_x (VID vid, int convtype, const char *conversion, int
             blackboard[vid_index].pAdditionalInfos->Conversion.Type = BB_CONV_NONE;
             if (blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode != NULL) my_free(blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode);
             blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode = NULL;
-            if (blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString != NULL) my_free(blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
+            if (blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString != NULL) ReleaseSharedString(blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
             blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString = NULL;
             ret = -1;
     } else {
@@ -2289,6 +2697,7 @@ int set_bbvari_conversion_x (VID vid, int convtype, const char *conversion, int
                 ret = -1;
             } else {
                 blackboard[vid_index].pAdditionalInfos->Conversion.Type = convtype;
+                Conv_TablePrepareLookup(&blackboard[vid_index].pAdditionalInfos->Conversion);
                 ret = 0;
             }
         }
@@ -2327,7 +2736,7 @@ int set_bbvari_conversion_x (VID vid, int convtype, const char *conversion, int
 
     // Now save all to the INI file
     if (ret_WriteToIniFlag == NULL) {
-        write_varinfos_to_ini(&blackboard[vid_index], INI_CACHE_ENTRY_FLAG_CONVERSION);
+        defer_write_varinfos_to_ini(vid_index, INI_CACHE_ENTRY_FLAG_CONVERSION);
     } else {
         *ret_WriteToIniFlag |= INI_CACHE_ENTRY_FLAG_CONVERSION;
     }
@@ -2552,6 +2961,10 @@ int get_bbvari_infos (VID par_Vid, BB_VARIABLE *ret_BaseInfos, BB_VARIABLE_ADDIT
         if (ret_AdditionalInfos != NULL) {
             char *p = ret_Buffer;
             *ret_AdditionalInfos = *(blackboard[Index].pAdditionalInfos);
+            ret_AdditionalInfos->Conversion.TextReplaceTable = NULL;  // belongs to the blackboard
+            // the spilled attach counters also belong to the blackboard
+            STRUCT_ZERO_INIT (ret_AdditionalInfos->ProcessAttachCounts, BB_ATTACH_COUNTS);
+            STRUCT_ZERO_INIT (ret_AdditionalInfos->ProcessUnknownWaitAttachCounts, BB_ATTACH_COUNTS);
             ret_AdditionalInfos->Name = MEMCPY (p, blackboard[Index].pAdditionalInfos->Name, LenName);
             p += LenName;
             if (LenDisplayName) {
@@ -2616,7 +3029,7 @@ static int set_bbvari_color_x (VID vid, int rgb_color, uint32_t *ret_WriteToIniF
 
     // Now save all to the INI file
     if (ret_WriteToIniFlag == NULL) {
-        write_varinfos_to_ini(&blackboard[vid_index], INI_CACHE_ENTRY_FLAG_COLOR);
+        defer_write_varinfos_to_ini(vid_index, INI_CACHE_ENTRY_FLAG_COLOR);
     } else {
         *ret_WriteToIniFlag |= INI_CACHE_ENTRY_FLAG_COLOR;
     }
@@ -2685,7 +3098,7 @@ static int set_bbvari_step_x (VID vid, unsigned char steptype, double step, uint
 
     // Now save all to the INI file
     if (ret_WriteToIniFlag == NULL) {
-        write_varinfos_to_ini(&blackboard[vid_index], INI_CACHE_ENTRY_FLAG_STEP);
+        defer_write_varinfos_to_ini(vid_index, INI_CACHE_ENTRY_FLAG_STEP);
     } else {
         *ret_WriteToIniFlag |= INI_CACHE_ENTRY_FLAG_STEP;
     }
@@ -2755,7 +3168,7 @@ static int set_bbvari_min_x (VID vid, double min, uint32_t *ret_WriteToIniFlag,
 
     // Now save all to the INI file
     if (ret_WriteToIniFlag == NULL) {
-        write_varinfos_to_ini(&blackboard[vid_index], INI_CACHE_ENTRY_FLAG_MIN);
+        defer_write_varinfos_to_ini(vid_index, INI_CACHE_ENTRY_FLAG_MIN);
     } else {
         *ret_WriteToIniFlag |= INI_CACHE_ENTRY_FLAG_MIN;
     }
@@ -2797,7 +3210,7 @@ static int set_bbvari_max_x (VID vid, double max, uint32_t *ret_WriteToIniFlag,
 
     // Now save all to the INI file
     if (ret_WriteToIniFlag == NULL) {
-        write_varinfos_to_ini(&blackboard[vid_index], INI_CACHE_ENTRY_FLAG_MAX);
+        defer_write_varinfos_to_ini(vid_index, INI_CACHE_ENTRY_FLAG_MAX);
     } else {
         *ret_WriteToIniFlag |= INI_CACHE_ENTRY_FLAG_MAX;
     }
@@ -2882,7 +3295,7 @@ static int set_bbvari_format_x (VID vid, int width, int prec, uint32_t *ret_Writ
 
     // Now save all to the INI file
     if (ret_WriteToIniFlag == NULL) {
-        write_varinfos_to_ini(&blackboard[vid_index], INI_CACHE_ENTRY_FLAG_WIDTH_PREC);
+        defer_write_varinfos_to_ini(vid_index, INI_CACHE_ENTRY_FLAG_WIDTH_PREC);
     } else {
         *ret_WriteToIniFlag |= INI_CACHE_ENTRY_FLAG_WIDTH_PREC;
     }
@@ -2969,66 +3382,57 @@ void free_frame (VID *frame)
     }
 }
 
-int get_free_wrflag (PID pid, uint64_t *wrflag)
+uint32_t get_bbvari_wrseq (VID vid)
 {
-    int i;
+    int vid_index;
 
     if (blackboard == NULL) {
 #ifndef REMOTE_MASTER
         if (s_main_ini_val.ConnectToRemoteMaster) {
-            return rm_get_free_wrflag (pid, wrflag);
+            return rm_get_bbvari_wrseq (vid);
         }
 #endif
-        return NOT_INITIALIZED;
+        return 0;
     }
-    // Check process-id
-    if ((i = get_process_index(pid)) == -1) {
-        return -1;
+    // Determine the variable index
+    if ((vid_index = get_variable_index(vid)) == -1) {
+        return 0;
     }
-
-    // Buid bit maske
-    *wrflag = 1ULL << i;
-
-    return 0;
-}
-
-void free_wrflag (PID pid, uint64_t wrflag)
-{
-    UNUSED(pid);
-    UNUSED(wrflag);
+    return ATOMIC_LOAD_ACQUIRE_U32(&BB_WR_SEQ(vid_index));
 }
 
-void reset_wrflag (VID vid, uint64_t w)
+void get_bbvari_wrseq_frame (int par_Number, const VID *par_Vids, uint32_t *ret_WrSeqs)
 {
-    int vid_index;
+    int x, vid_index;
 
     if (blackboard == NULL) {
 #ifndef REMOTE_MASTER
         if (s_main_ini_val.ConnectToRemoteMaster) {
-            rm_reset_wrflag (vid, w);
+            rm_get_bbvari_wrseq_frame (par_Number, par_Vids, ret_WrSeqs);
             return;
         }
 #endif
+        MEMSET (ret_WrSeqs, 0, (size_t)par_Number * sizeof (uint32_t));
         return;
     }
-
-    // Determine the variable index
-    if ((vid_index = get_variable_index(vid)) == -1) {
-        return;
+    for (x = 0; x < par_Number; x++) {
+        if ((vid_index = get_variable_index(par_Vids[x])) == -1) {
+            ret_WrSeqs[x] = 0;
+        } else {
+            ret_WrSeqs[x] = ATOMIC_LOAD_ACQUIRE_U32(&BB_WR_SEQ(vid_index));
+        }
     }
-
-    // Reset the corresponding bit
-    blackboard[vid_index].WrFlags &= ~w;
 }
 
-int test_wrflag (VID vid, uint64_t w)
+int test_bbvari_wrseq (VID vid, uint32_t *io_WrSeq)
 {
     int vid_index;
+    uint32_t WrSeq;
 
     if (blackboard == NULL) {
 #ifndef REMOTE_MASTER
         if (s_main_ini_val.ConnectToRemoteMaster) {
-            return rm_test_wrflag (vid, w);
+            return rm_test_bbvari_wrseq (vid, io_WrSeq);
         }
 #endif
         return NOT_INITIALIZED;
@@ -3037,8 +3441,13 @@ int test_wrflag (VID vid, uint64_t w)
     if ((vid_index = get_variable_index(vid)) == -1) {
         return 0;
     }
-    // Check if the bit is set
-    return (blackboard[vid_index].WrFlags & w) == w;
+    // Changed since the last call?
+    WrSeq = ATOMIC_LOAD_ACQUIRE_U32(&BB_WR_SEQ(vid_index));
+    if (WrSeq != *io_WrSeq) {
+        *io_WrSeq = WrSeq;
+        return 1;
+    }
+    return 0;
 }
 
 int read_next_blackboard_vari (int index, char *ret_NameBuffer, int max_c)
@@ -3101,8 +3510,8 @@ int ReadNextVariableProcessAccess (int index, PID pid, int access, char *name, i
     // Increment index till the variable is found or the blackboard end is reached
     for ( ; vid_index < get_blackboardsize(); vid_index++) {
         if ((blackboard[vid_index].Vid != -1) &&
-            (blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts[pid_index] ||
-             blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts[pid_index])) {
+            (GetAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessAttachCounts, pid_index) ||
+             GetAttachCount (&blackboard[vid_index].pAdditionalInfos->ProcessUnknownWaitAttachCounts, pid_index))) {
             switch (access & 0x3) {
             case 2:  // Disabled
                 if (~blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
@@ -4189,6 +4598,8 @@ int set_varinfo_to_inientrys (BB_VARIABLE *sp_vari_elem,
                     sp_vari_elem->pAdditionalInfos->Conversion.Type = BB_CONV_NONE;
                     my_free(sp_vari_elem->pAdditionalInfos->Conversion.Conv.Table.Values);
                     sp_vari_elem->pAdditionalInfos->Conversion.Type = BB_CONV_NONE;
+                } else {
+                    Conv_TablePrepareLookup(&sp_vari_elem->pAdditionalInfos->Conversion);
                 }
             }
         } else if (sp_vari_elem->pAdditionalInfos->Conversion.Type == BB_CONV_RAT_FUNC) {
@@ -4409,10 +4820,12 @@ int disable_bbvari_range_control (char *ProcessFilter, char *VariableFilter)
 
 int BBWriteName(const char* name, BB_VARIABLE *sp_vari_elem)
 {
-    sp_vari_elem->pAdditionalInfos->Name = StringRealloc(sp_vari_elem->pAdditionalInfos->Name, name);
-    if (sp_vari_elem->pAdditionalInfos->Name == NULL) {
+    char *Name = AllocNameString(name);
+    if (Name == NULL) {
         return 1;
     }
+    if (sp_vari_elem->pAdditionalInfos->Name != NULL) FreeNameString(sp_vari_elem->pAdditionalInfos->Name);
+    sp_vari_elem->pAdditionalInfos->Name = Name;
     return 0;
 }
 
@@ -4433,13 +4846,15 @@ int BBWriteDisplayName(const char* display_name, BB_VARIABLE *sp_vari_elem)
 int BBWriteUnit(const char* unit, BB_VARIABLE *sp_vari_elem)
 {
     if (unit == NULL) {
-        if (sp_vari_elem->pAdditionalInfos->Unit != NULL) my_free(sp_vari_elem->pAdditionalInfos->Unit);
+        if (sp_vari_elem->pAdditionalInfos->Unit != NULL) ReleaseSharedString(sp_vari_elem->pAdditionalInfos->Unit);
         sp_vari_elem->pAdditionalInfos->Unit = NULL;
     } else {
-        sp_vari_elem->pAdditionalInfos->Unit = StringRealloc(sp_vari_elem->pAdditionalInfos->Unit, unit);
-        if (sp_vari_elem->pAdditionalInfos->Unit == NULL) {
+        char *String = AddSharedString(unit);
+        if (String == NULL) {
             return 1;
         }
+        if (sp_vari_elem->pAdditionalInfos->Unit != NULL) ReleaseSharedString(sp_vari_elem->pAdditionalInfos->Unit);
+        sp_vari_elem->pAdditionalInfos->Unit = String;
     }
     return 0;
 }
@@ -4458,35 +4873,51 @@ int BBWriteComment(const char* comment, BB_VARIABLE *sp_vari_elem)
     return 0;
 }
 
+// Rebuild the precompiled text replace if the conversion string was changed
+static void UpdateTextReplaceTable(BB_VARIABLE *sp_vari_elem)
+{
+    TextReplaceFreeCompiled(sp_vari_elem->pAdditionalInfos->Conversion.TextReplaceTable);
+    sp_vari_elem->pAdditionalInfos->Conversion.TextReplaceTable = NULL;
+    if (sp_vari_elem->pAdditionalInfos->Conversion.Type == BB_CONV_TEXTREP) {
+        sp_vari_elem->pAdditionalInfos->Conversion.TextReplaceTable = TextReplaceCompile(sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString);
+    }
+}
+
 int BBWriteFormulaString(const char* formula_string, BB_VARIABLE *sp_vari_elem)
 {
     if (formula_string == NULL) {
-        if (sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString != NULL) my_free(sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
+        if (sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString != NULL) ReleaseSharedString(sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
         sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString = NULL;
         sp_vari_elem->pAdditionalInfos->Conversion.Type = BB_CONV_NONE;
     } else {
-        sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString = StringRealloc(sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString, formula_string);
-        if (sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString == NULL) {
+        char *String = AddSharedString(formula_string);
+        if (String == NULL) {
             sp_vari_elem->pAdditionalInfos->Conversion.Type = BB_CONV_NONE;
             return 1;
         }
+        if (sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString != NULL) ReleaseSharedString(sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
+        sp_vari_elem->pAdditionalInfos->Conversion.Conv.Formula.FormulaString = String;
     }
+    UpdateTextReplaceTable(sp_vari_elem);
     return 0;
 }
 
 int BBWriteEnumString(const char* enum_string, BB_VARIABLE *sp_vari_elem)
 {
     if (enum_string == NULL) {
-        if (sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString != NULL) my_free(sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString);
+        if (sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString != NULL) ReleaseSharedString(sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString);
         sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString = NULL;
         sp_vari_elem->pAdditionalInfos->Conversion.Type = BB_CONV_NONE;
     } else {
-        sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString = StringRealloc(sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString, enum_string);
-        if (sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString == NULL) {
+        char *String = AddSharedString(enum_string);
+        if (String == NULL) {
             sp_vari_elem->pAdditionalInfos->Conversion.Type = BB_CONV_NONE;
             return 1;
         }
+        if (sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString != NULL) ReleaseSharedString(sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString);
+        sp_vari_elem->pAdditionalInfos->Conversion.Conv.TextReplace.EnumString = String;
     }
+    UpdateTextReplaceTable(sp_vari_elem);
     return 0;
 }
 
@@ -4740,7 +5171,7 @@ int *get_all_bbvari_ids_without_lock (uint32_t flag, PID pid, int32_t *ret_ElemC
                 (((flag & GET_ALL_BBVARI_EXISTING_TYPE) == GET_ALL_BBVARI_EXISTING_TYPE) && (blackboard[index].Type != BB_UNKNOWN_WAIT))) {
                 if ((pid_index == -1) ||
                     (((flag & GET_ALL_BBVARI_ONLY_FOR_PROCESS_WITH_READ_ACCESS) == GET_ALL_BBVARI_ONLY_FOR_PROCESS_WITH_READ_ACCESS)
-                         && ((blackboard[index].AccessFlags & Mask) != 0)) ||
+                         && ((BB_ACCESS_FLAGS(index) & Mask) != 0)) ||
                     (((flag & GET_ALL_BBVARI_ONLY_FOR_PROCESS_WITH_WRITE_ACCESS) == GET_ALL_BBVARI_ONLY_FOR_PROCESS_WITH_WRITE_ACCESS)
                          && ((blackboard[index].WrEnableFlags & Mask) != 0))) {
                     if (RetElem >= RetBuffSize) {
@@ -4770,6 +5201,60 @@ int *get_all_bbvari_ids (uint32_t flag, PID pid, int32_t *ret_ElemCount)
 }
 
 
+#ifndef REMOTE_MASTER
+int *get_bbvari_ids_by_filter (const char *par_Filter, int32_t *ret_ElemCount)
+{
+    int32_t *Ret = NULL;
+    int RetElem = 0;
+    int Count, x;
+
+    if (ret_ElemCount != NULL) *ret_ElemCount = 0;
+    if (blackboard == NULL) {
+        if (s_main_ini_val.ConnectToRemoteMaster) {
+            // There is no name index on this side, check all variable names of the remote master
+            char Name[BBVARI_NAME_SIZE];
+            int index = 0;
+            int RetBuffSize = 0;
+            while ((index = rm_read_next_blackboard_vari (index, Name, sizeof(Name))) > 0) {
+                if (!Compare2StringsWithWildcards (Name, par_Filter)) {
+                    VID Vid = rm_get_bbvarivid_by_name (Name);
+                    if (Vid <= 0) continue;
+                    if (RetElem >= RetBuffSize) {
+                        int32_t *NewRet;
+                        RetBuffSize = RetBuffSize + (RetBuffSize >> 1) + 128;
+                        NewRet = (int32_t*)my_realloc (Ret, sizeof (int32_t) * (size_t)RetBuffSize);
+                        if (NewRet == NULL) {
+                            if (Ret != NULL) my_free (Ret);
+                            return NULL;   // Error
+                        }
+                        Ret = NewRet;
+                    }
+                    Ret[RetElem++] = Vid;
+                }
+            }
+            if (ret_ElemCount != NULL) *ret_ElemCount = RetElem;
+        }
+        return (int*)Ret;
+    }
+    EnterCriticalSection (&BlackboardCriticalSection);
+    Count = SearchNameIndex (par_Filter, !s_main_ini_val.NoCaseSensitiveFilters, &Ret);
+    // Replace the blackboard indexes with the variable ids, only real variables
+    for (x = 0; x < Count; x++) {
+        int index = Ret[x];
+        if ((blackboard[index].Vid > 0) && (blackboard[index].Type < BB_UNKNOWN)) {
+            Ret[RetElem++] = blackboard[index].Vid;
+        }
+    }
+    LeaveCriticalSection (&BlackboardCriticalSection);
+    if ((RetElem == 0) && (Ret != NULL)) {
+        my_free (Ret);
+        Ret = NULL;
+    }
+    if (ret_ElemCount != NULL) *ret_ElemCount = RetElem;
+    return (int*)Ret;
+}
+#endif
+
 void free_all_bbvari_ids(int32_t *ids)
 {
     my_free (ids);
@@ -5179,6 +5664,17 @@ int LimitToDataTypeRange(union BB_VARI par_In, enum BB_DATA_TYPES par_InType, en
     return ret;
 }
 
+static int IsBlackboardGuardUntouched (void *par_Guard, size_t par_Size)
+{
+    size_t x;
+    for (x = 0; x < par_Size; x++) {
+        if (((uint8_t*)par_Guard)[x] != 0xFF) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 int close_blackboard (void)
 {
 #ifndef REMOTE_MASTER
@@ -5193,11 +5689,8 @@ int close_blackboard (void)
         EnterCriticalSection (&BlackboardCriticalSection);
         for (index = 0; index < get_blackboardsize(); index++) {
             if (blackboard[index].Vid > 0) {
-                int32_t P1, P2;
                 uint64_t HashCode = BuildHashCode(blackboard[index].pAdditionalInfos->Name);
-                int index2 = BinarySearchIndex(blackboard[index].pAdditionalInfos->Name, HashCode, &P1, &P2);
-                if (index2 == index) {
-                    RemoveBinaryHashKey(P1, P2);
+                if (RemoveHashKey(HashCode, index) == 0) {
                     FreeBlackboardIndex(index);
                 }
                 __free_all_additionl_info_memorys(blackboard[index].pAdditionalInfos, 0);
@@ -5207,14 +5700,24 @@ int close_blackboard (void)
                 my_free(Infos);
             }
         }
+#ifndef REMOTE_MASTER
+        // not flushed infos are lost now (flush_varinfos_to_ini() must be called before the INI file is saved)
+        if (IniWritePendingVids != NULL) my_free (IniWritePendingVids);
+        IniWritePendingVids = NULL;
+        IniWritePendingCount = IniWritePendingSize = 0;
+        CloseBlackboardNameIndex ();
+#endif
 
-        BB_VARIABLE *blackboard_base = blackboard - 1;  // we have not used the element 0 we have alloc one more as neccessary
-        for (index = 0; index < (int)sizeof (BB_VARIABLE); index++) {
-            if (((uint8_t*)blackboard_base)[index] != 0xFF) {
-                ThrowError(1, "Internal error, somebody have written to blackboard with index -1");
-                break;
-            }
+        // we have not used the element 0 we have alloc one more as neccessary
+        if (!IsBlackboardGuardUntouched (blackboard - 1, sizeof (BB_VARIABLE)) ||
+            !IsBlackboardGuardUntouched (blackboard_values - 1, sizeof (union BB_VARI)) ||
+            !IsBlackboardGuardUntouched (blackboard_types - 1, sizeof (int8_t)) ||
+            !IsBlackboardGuardUntouched ((void*)(blackboard_wr_seqs - 1), sizeof (uint32_t)) ||
+            !IsBlackboardGuardUntouched (blackboard_access_flags - 1, sizeof (uint64_t)) ||
+            !IsBlackboardGuardUntouched (blackboard_observation_flags - 1, sizeof (uint32_t))) {
+            ThrowError(1, "Internal error, somebody have written to blackboard with index -1");
         }
+        CloseBlackboardObservationQueue ();
         LeaveCriticalSection (&BlackboardCriticalSection);
     }
     return 0;
@@ -28,8 +28,6 @@
 **    constants and macros
 *************************************************************************/
 
-#define ALL_WRFLAG_MASK         0xFFFFFFFFFFFFFFFFULL
-
 #define BBVARI_NAME_SIZE        512
 #define BBVARI_UNIT_SIZE         64
 // One INI file line can be max. 131071 char long
@@ -48,6 +46,7 @@
 
 #include "SharedDataTypes.h"
 #include "BlackboardIniCache.h"
+#include "BlackboardAttachCounts.h"
 
 typedef struct _BB_VARIABLE_CONVERSION {
     enum BB_CONV_TYPES Type;
@@ -70,6 +69,11 @@ typedef struct _BB_VARIABLE_CONVERSION {
                 double Phys;
             } *Values;
             int Size;
+            int Flags;              // CONV_TABLE_xxx set by Conv_TablePrepareLookup()
+            double RawStart;        // only valid with CONV_TABLE_RAW_UNIFORM
+            double RawInvStep;
+            double PhysStart;       // only valid with CONV_TABLE_PHYS_UNIFORM
+            double PhysInvStep;
         } Table;
         struct {
             double a;
@@ -85,8 +89,13 @@ typedef struct _BB_VARIABLE_CONVERSION {
         } Reference;
         /* TODO: ASAP conversion */
     } Conv;
+    // Only valid with BB_CONV_TEXTREP, will be build by BBWriteEnumString()/BBWriteFormulaString()
+    struct TEXT_REPLACE_TABLE *TextReplaceTable;
 } BB_VARIABLE_CONVERSION;
 
+// Name is stored with AllocNameString(), Unit and the conversion strings (FormulaString, EnumString)
+// are shared strings (AddSharedString()), see BlackboardStringPool.h. Only change them with BBWriteName(),
+// BBWriteUnit(), BBWriteFormulaString(), BBWriteEnumString() and free them with free_all_additionl_info_memorys().
 typedef struct {
 /*08*/  char *Name;
 /*08*/  char *DisplayName;
@@ -98,8 +107,8 @@ typedef struct {
 // Attcah counter:
 /*04*/  uint32_t UnknownWaitAttachCount;
 /*04*/  uint32_t AttachCount;
-/*128*/ uint16_t ProcessAttachCounts[MAX_PROCESSES];
-/*128*/ uint16_t ProcessUnknownWaitAttachCounts[MAX_PROCESSES];
+/*16*/  BB_ATTACH_COUNTS ProcessAttachCounts;              // use GetAttachCount(), IncAttachCount(), ...
+/*16*/  BB_ATTACH_COUNTS ProcessUnknownWaitAttachCounts;
 
 // Display type:
 /*08*/  double Min;
@@ -108,7 +117,7 @@ typedef struct {
 /*01*/  uint8_t Width;
 /*01*/  uint8_t Prec;
 /*01*/  uint8_t StepType;
-/*01*/  uint8_t fill1;
+/*01*/  uint8_t IniWritePending;   // infos are changed but not written to the INI database (flush_varinfos_to_ini())
 /*01*/  uint8_t fill2;
 /*01*/  uint8_t fill3;
 /*01*/  uint8_t fill4;
@@ -122,20 +131,6 @@ typedef struct {
 }  BB_VARIABLE_ADDITIONAL_INFOS;
 
 
-typedef struct {
-/*04*/  int32_t Vid;
-/*04*/  enum BB_DATA_TYPES Type;
-/*08*/  union BB_VARI Value;
-/*08*/  BB_VARIABLE_ADDITIONAL_INFOS *pAdditionalInfos;
-
-// Access flags
-/*08*/  volatile uint64_t WrFlags;   // 64Bit -> max. 64 processes
-/*08*/  uint64_t AccessFlags;
-/*08*/  uint64_t WrEnableFlags;
-
-/*08*/  uint64_t RangeControlFlag;     // For each process one bit
-
-/*04*/  uint32_t ObservationFlags;
 #define OBSERVE_CONFIG_ANYTHING_CHANGED  0x7FFFFFFEUL
 #define OBSERVE_VALUE_CHANGED            0x1UL
 #define OBSERVE_TYPE_CHANGED             0x2UL
@@ -151,8 +146,23 @@ typedef struct {
 #define OBSERVE_ADD_VARIABLE            0x40000000UL
 #define OBSERVE_RESET_FLAGS             0x80000000UL
 
-/*04*/  char Fill[4];
-}  BB_VARIABLE;  /* 64 bytes */
+// The values, the write flags, the access flags and the observation flags are not stored inside
+// BB_VARIABLE but inside parallel arrays with the same index (see BB_VALUE() ...), so copy lists
+// and recorder frames touch only the cache lines they need. The data type is stored
+// inside both: BB_VARIABLE is also used as a copy of the variable infos (get_bbvari_infos,
+// remote master messages) and blackboard_types[] is the dense copy for the access functions.
+// Always change the data type with SET_BB_TYPE().
+typedef struct {
+/*04*/  int32_t Vid;
+/*04*/  enum BB_DATA_TYPES Type;
+/*08*/  BB_VARIABLE_ADDITIONAL_INFOS *pAdditionalInfos;
+
+/*08*/  uint64_t WrEnableFlags;
+
+/*08*/  uint64_t RangeControlFlag;     // For each process one bit
+
+/*04*/  uint32_t ObservationPending;   // Variable is inside the value changed queue (BlackboardObservationQueue.c)
+}  BB_VARIABLE;  /* 40 bytes */
 
 // Blackboard global infos
 typedef struct
@@ -186,14 +196,54 @@ typedef struct
 
 #ifdef BLACKBOARD_C
 BB_VARIABLE *blackboard;
+union BB_VARI *blackboard_values;
+int8_t *blackboard_types;
+volatile uint32_t *blackboard_wr_seqs;      // incremented with each write (never reset)
+uint64_t *blackboard_access_flags;
+uint32_t *blackboard_observation_flags;
 GLOBAL_BBINFOS blackboard_infos;
 uint32_t process_bb_access_mask;
 #else
 extern BB_VARIABLE *blackboard;
+extern union BB_VARI *blackboard_values;
+extern int8_t *blackboard_types;
+extern volatile uint32_t *blackboard_wr_seqs;
+extern uint64_t *blackboard_access_flags;
+extern uint32_t *blackboard_observation_flags;
 extern GLOBAL_BBINFOS blackboard_infos;
 extern uint32_t process_bb_access_mask;
 #endif
 
+// Access to the parallel arrays with the blackboard index (get_variable_index())
+#define BB_VALUE(index)              (blackboard_values[index])
+#define BB_TYPE(index)               ((enum BB_DATA_TYPES)blackboard_types[index])
+#define BB_WR_SEQ(index)             (blackboard_wr_seqs[index])
+#define BB_ACCESS_FLAGS(index)       (blackboard_access_flags[index])
+#define BB_OBSERVATION_FLAGS(index)  (blackboard_observation_flags[index])
+
+#define SET_BB_TYPE(index, type) \
+if (1) { \
+    blackboard[index].Type = (enum BB_DATA_TYPES)(type); \
+    blackboard_types[index] = (int8_t)blackboard[index].Type; \
+}
+
+void PushValueChangedObservation (int par_VidIndex);
+
+// Each write increments the write sequence number of the variable. A reader remembers the last seen
+// sequence number by itself, so there is no per process state (and no limit of readers) inside the blackboard.
+// The caller must include AtomicAccess.h
+#define INC_BB_WR_SEQ(index) ((void)ATOMIC_FETCH_ADD_U32(&BB_WR_SEQ(index), 1))
+
+// Increment the write sequence number after a new value was written and
+// notify the value change if somebody observe it (OBSERVE_VALUE_CHANGED)
+#define SET_BB_WRITTEN(index) \
+if (1) { \
+    INC_BB_WR_SEQ(index); \
+    if ((BB_OBSERVATION_FLAGS(index) & OBSERVE_VALUE_CHANGED) == OBSERVE_VALUE_CHANGED) { \
+        PushValueChangedObservation (index); \
+    } \
+}
+
 
 /*************************************************************************
 **    function prototypes
@@ -214,6 +264,10 @@ int close_blackboard (void);
 int ext_process_close_blackboard (void);
 int write_varinfos_to_ini(BB_VARIABLE *sp_vari_elem,
                           uint32_t WriteReqFlags);
+// The infos of blackboard variables are not written immediately to the INI database if they are changed,
+// they will be collected and written with one pass. This must be called before the [Variables] section
+// of the main INI file will be read by someone else or the INI file will be saved.
+int flush_varinfos_to_ini (void);
 
 int read_varinfos_from_ini (const char *sz_varname,
                             BB_VARIABLE *sp_vari_elem,
@@ -235,6 +289,12 @@ VID add_bbvari_all_infos (int Pid, const char *name, int type, const char *unit,
 VID add_bbvari_pid (const char *name, enum BB_DATA_TYPES type, const char *unit, int Pid);
 VID add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *unit, int Pid, int Dir, int ValueValidFlag, union BB_VARI *Value, int *ret_Type,
                          uint32_t ReadFromIniReqMask, uint32_t *ret_WriteToIniFlag, uint32_t *ret_Observation, uint32_t *ret_AddRemoveObservation);
+// Add several variables with one lock of the blackboard: the new variables are merged with one pass into the
+// hash index and their INI infos are read with one pass through the INI file. Variables which already exist are
+// attached with add_bbvari_pid_type(). Units, Dirs, Values and ret_Types can be NULL. The vid (or an error code)
+// of each variable is stored inside ret_Vids.
+int add_bbvari_pid_type_frame (int Number, const char **Names, enum BB_DATA_TYPES *Types, const char **Units, int *Dirs, int Pid,
+                               int ValueValidFlag, union BB_VARI *Values, uint32_t ReadReqMask, VID *ret_Vids, int *ret_Types);
 
 int IfUnknowDataTypeConvert (int UnknwonDataType, int *ret_DataType);
 int IfUnknowWaitDataTypeConvert (int UnknwonDataType, int *ret_DataType);
@@ -245,6 +305,8 @@ int attach_bbvari_unknown_wait_pid(VID vid, int pid);
 int attach_bbvari_unknown_wait (VID vid);
 int attach_bbvari_cs (VID vid, int cs);
 int attach_bbvari_unknown_wait_cs (VID vid, int cs);
+// ret_Rets can be NULL, returns -1 if one of the variables could not be attached
+int attach_bbvari_frame (int Number, VID *Vids, int unknown_wait_flag, int pid, int *ret_Rets);
 
 VID attach_bbvari_by_name (const char *name, int pid);
 
@@ -297,10 +359,12 @@ int get_bbvari_format_width(VID vid);
 int get_bbvari_format_prec(VID vid);
 VID *attach_frame(VID *vids);
 void free_frame (VID *frame);
-int get_free_wrflag(PID pid, uint64_t *wrflag);
-void free_wrflag(PID pid, uint64_t wrflag);
-void reset_wrflag(VID vid, uint64_t w);
-int test_wrflag(VID vid, uint64_t w);
+// Current write sequence number of a variable (0 if the variable doesn't exist)
+uint32_t get_bbvari_wrseq(VID vid);
+// Same for par_Number variables, ret_WrSeqs[x] is 0 for not existing variables
+void get_bbvari_wrseq_frame(int par_Number, const VID *par_Vids, uint32_t *ret_WrSeqs);
+// Returns 1 if the variable was written since *io_WrSeq was read, and update *io_WrSeq
+int test_bbvari_wrseq(VID vid, uint32_t *io_WrSeq);
 
 int read_next_blackboard_vari(int index, char *ret_NameBuffer, int max_c);
 char *read_next_blackboard_vari_old (int flag);
@@ -378,6 +442,11 @@ int get_datatype_min_max_union (int type, union BB_VARI *ret_min, union BB_VARI
 int *get_all_bbvari_ids (uint32_t flag, PID pid, int32_t *ret_ElemCount);
 int *get_all_bbvari_ids_without_lock(uint32_t flag, PID pid, int32_t *ret_ElemCount);
 
+// Returns the ids of all variables (without BB_UNKNOWN_WAIT ones) matching the wildcard filter sorted by name.
+// Only the range of the literal prefix of the filter will be searched. Case sensitivity is the same as Compare2StringsWithWildcards().
+// Returns NULL if nothing was found, otherwise it must be freed with free_all_bbvari_ids()
+int *get_bbvari_ids_by_filter (const char *par_Filter, int32_t *ret_ElemCount);
+
 void free_all_bbvari_ids (int32_t *ids);
 
 int ConvertLabelAsapCombatibleInOut (const char *In, char *Out, int MaxChars, int op);
@@ -394,6 +463,4 @@ union BB_VARI AddOffsetTo(union BB_VARI par_In, enum BB_DATA_TYPES par_Type, dou
 int LimitToDataTypeRange(union BB_VARI par_In, enum BB_DATA_TYPES par_InType, enum BB_DATA_TYPES par_LimitToType, union BB_VARI *ret_Out);
 
 
-int BinarySearchIndex(const char *Name, uint64_t HashCode, int32_t *ret_p1, int32_t *ret_p2);
-
 #endif  // BLACKBOARD_H
@@ -37,6 +37,7 @@ static inline uint64_t _umul128(uint64_t a, uint64_t b, uint64_t *ret_HighPart)
 #include "Scheduler.h"
 #include "Blackboard.h"
 #include "BlackboardHashIndex.h"
+#include "AtomicAccess.h"
 #include "BlackboardConversion.h"
 #include "ExecutionStack.h"
 #include "TextReplace.h"
@@ -75,41 +76,9 @@ static int convert_physical_internal(int vid_index, double raw_value, double *re
                           blackboard[vid_index].pAdditionalInfos->Conversion.Conv.FactorOffset.Factor;
         return 0;
     case BB_CONV_TAB_INTP:
+        return Conv_TableInterpolRawToPhys(&blackboard[vid_index].pAdditionalInfos->Conversion, raw_value, ret_phys_value);
     case BB_CONV_TAB_NOINTP:
-    {
-        int x, Size;
-        double m, RawDelta, PhysDelta;
-        struct CONVERSION_TABLE_VALUE_PAIR *Values;
-
-        Size = blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Table.Size;
-        Values = blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Table.Values;
-        for (x = 0; x < Size; x++) {
-            if (Values[x].Raw >= raw_value) {
-                if (x == 0) {
-                    *ret_phys_value = Values[x].Phys;
-                } else {
-                    if (blackboard[vid_index].pAdditionalInfos->Conversion.Type == BB_CONV_TAB_INTP) {
-                        RawDelta = Values[x].Raw - Values[x-1].Raw;
-                        if ((RawDelta <= 0.0) && (RawDelta >= 0.0)) {  // == 0.0
-                            *ret_phys_value = Values[x-1].Phys;  // use the smallest one
-                        } else {
-                            PhysDelta = Values[x].Phys - Values[x-1].Phys;
-                            m = PhysDelta / RawDelta;
-                            *ret_phys_value = Values[x-1].Phys + m * (raw_value - Values[x-1].Raw);
-                        }
-                    } else {
-                        *ret_phys_value = Values[x].Phys;
-                    }
-                }
-                break;  // for(;;)
-            }
-        }
-        if (x == Size) {
-            *ret_phys_value = Values[Size - 1].Phys;
-        }
-        return 0;
-        break;
-    }
+        return Conv_TableNoInterpolRawToPhys(&blackboard[vid_index].pAdditionalInfos->Conversion, raw_value, ret_phys_value);
     case BB_CONV_RAT_FUNC:
         if (Conv_RationalFunctionRawToPhys(&blackboard[vid_index].pAdditionalInfos->Conversion, raw_value,ret_phys_value) == 0) {
             return 0;
@@ -140,7 +109,7 @@ void write_bbvari_byte_x (PID pid, VID vid, int8_t v)
         return;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_BYTE) {
+    if (BB_TYPE(vid_index) != BB_BYTE) {
         return;
     }
     // Determine the process  index (for access mask)
@@ -149,11 +118,11 @@ void write_bbvari_byte_x (PID pid, VID vid, int8_t v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        blackboard[vid_index].Value.b = v;
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        BB_VALUE(vid_index).b = v;
+        SET_BB_WRITTEN(vid_index);
     }
     LeaveBlackboardCriticalSection();
 }
@@ -182,7 +151,7 @@ void write_bbvari_ubyte_x (PID pid, VID vid, uint8_t v)
         return;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_UBYTE) {
+    if (BB_TYPE(vid_index) != BB_UBYTE) {
         return;
     }
     // Determine the process  index (for access mask)
@@ -191,11 +160,11 @@ void write_bbvari_ubyte_x (PID pid, VID vid, uint8_t v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        blackboard[vid_index].Value.ub = v;
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        BB_VALUE(vid_index).ub = v;
+        SET_BB_WRITTEN(vid_index);
     }
     LeaveBlackboardCriticalSection();
 }
@@ -224,7 +193,7 @@ void write_bbvari_word_x (PID pid, VID vid, int16_t v)
         return;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_WORD) {
+    if (BB_TYPE(vid_index) != BB_WORD) {
         return;
     }
     // Determine the process  index (for access mask)
@@ -233,11 +202,11 @@ void write_bbvari_word_x (PID pid, VID vid, int16_t v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        blackboard[vid_index].Value.w = v;
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        BB_VALUE(vid_index).w = v;
+        SET_BB_WRITTEN(vid_index);
     }
     LeaveBlackboardCriticalSection();
 }
@@ -266,7 +235,7 @@ void write_bbvari_uword_x (PID pid, VID vid, uint16_t v)
         return;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_UWORD) {
+    if (BB_TYPE(vid_index) != BB_UWORD) {
         return;
     }
     // Determine the process  index (for access mask)
@@ -275,11 +244,11 @@ void write_bbvari_uword_x (PID pid, VID vid, uint16_t v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        blackboard[vid_index].Value.uw = v;
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        BB_VALUE(vid_index).uw = v;
+        SET_BB_WRITTEN(vid_index);
     }
     LeaveBlackboardCriticalSection();
 }
@@ -308,7 +277,7 @@ void write_bbvari_dword_x (PID pid, VID vid, int32_t v)
         return;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_DWORD) {
+    if (BB_TYPE(vid_index) != BB_DWORD) {
         return;
     }
     // Determine the process  index (for access mask)
@@ -317,11 +286,11 @@ void write_bbvari_dword_x (PID pid, VID vid, int32_t v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        blackboard[vid_index].Value.dw = v;
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        BB_VALUE(vid_index).dw = v;
+        SET_BB_WRITTEN(vid_index);
     }
     LeaveBlackboardCriticalSection();
 }
@@ -350,7 +319,7 @@ void write_bbvari_udword_x (PID pid, VID vid, uint32_t v)
         return;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_UDWORD) {
+    if (BB_TYPE(vid_index) != BB_UDWORD) {
         return;
     }
     // Determine the process  index (for access mask)
@@ -359,11 +328,11 @@ void write_bbvari_udword_x (PID pid, VID vid, uint32_t v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        blackboard[vid_index].Value.udw = v;
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        BB_VALUE(vid_index).udw = v;
+        SET_BB_WRITTEN(vid_index);
     }
     LeaveBlackboardCriticalSection();
 }
@@ -387,11 +356,11 @@ void write_bbvari_udword_without_check(VID vid, uint32_t v)
 		return;
 	}
     // Check if data type match
-	if (blackboard[vid_index].Type != BB_UDWORD) {
+	if (BB_TYPE(vid_index) != BB_UDWORD) {
 		return;
 	}
-	blackboard[vid_index].Value.udw = v;
-	blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+	BB_VALUE(vid_index).udw = v;
+	SET_BB_WRITTEN(vid_index);
 }
 #endif
 
@@ -414,7 +383,7 @@ void write_bbvari_qword_x (PID pid, VID vid, int64_t v)
         return;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_QWORD) {
+    if (BB_TYPE(vid_index) != BB_QWORD) {
         return;
     }
     // Determine the process  index (for access mask)
@@ -423,11 +392,11 @@ void write_bbvari_qword_x (PID pid, VID vid, int64_t v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        blackboard[vid_index].Value.qw = v;
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        BB_VALUE(vid_index).qw = v;
+        SET_BB_WRITTEN(vid_index);
     }
     LeaveBlackboardCriticalSection();
 }
@@ -456,7 +425,7 @@ void write_bbvari_uqword_x (PID pid, VID vid, uint64_t v)
         return;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_UQWORD) {
+    if (BB_TYPE(vid_index) != BB_UQWORD) {
         return;
     }
     // Determine the process  index (for access mask)
@@ -465,11 +434,11 @@ void write_bbvari_uqword_x (PID pid, VID vid, uint64_t v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        blackboard[vid_index].Value.uqw = v;
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        BB_VALUE(vid_index).uqw = v;
+        SET_BB_WRITTEN(vid_index);
     }
     LeaveBlackboardCriticalSection();
 }
@@ -498,7 +467,7 @@ void write_bbvari_float_x (PID pid, VID vid, float v)
         return;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_FLOAT) {
+    if (BB_TYPE(vid_index) != BB_FLOAT) {
         return;
     }
     // Determine the process  index (for access mask)
@@ -507,11 +476,11 @@ void write_bbvari_float_x (PID pid, VID vid, float v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        blackboard[vid_index].Value.f = v;
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        BB_VALUE(vid_index).f = v;
+        SET_BB_WRITTEN(vid_index);
     }
     LeaveBlackboardCriticalSection();
 }
@@ -540,7 +509,7 @@ void write_bbvari_double_x (PID pid, VID vid, double v)
         return;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_DOUBLE) {
+    if (BB_TYPE(vid_index) != BB_DOUBLE) {
         return;
     }
     // Determine the process  index (for access mask)
@@ -549,11 +518,11 @@ void write_bbvari_double_x (PID pid, VID vid, double v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        blackboard[vid_index].Value.d = v;
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        BB_VALUE(vid_index).d = v;
+        SET_BB_WRITTEN(vid_index);
     }
     LeaveBlackboardCriticalSection();
 }
@@ -577,11 +546,11 @@ void write_bbvari_double_without_check(VID vid, double v)
 		return;
 	}
     // Check if data type match
-	if (blackboard[vid_index].Type != BB_DOUBLE) {
+	if (BB_TYPE(vid_index) != BB_DOUBLE) {
 		return;
 	}
-	blackboard[vid_index].Value.d = v;
-	blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+	BB_VALUE(vid_index).d = v;
+	SET_BB_WRITTEN(vid_index);
 }
 #endif
 
@@ -609,11 +578,11 @@ void write_bbvari_union_x (PID pid, VID vid, union BB_VARI v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        blackboard[vid_index].Value = v;
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        BB_VALUE(vid_index) = v;
+        SET_BB_WRITTEN(vid_index);
     }
     LeaveBlackboardCriticalSection();
 }
@@ -645,88 +614,88 @@ void write_bbvari_union_pid (int Pid, VID vid, int DataType, union BB_VARI v)
     if ((pid_index = get_process_index(Pid)) == -1) {
         return;
     }
-    if ((DataType != blackboard[vid_index].Type) &&
+    if ((DataType != BB_TYPE(vid_index)) &&
         (DataType != BB_CONVERT_LIMIT_MIN_MAX)) {
         return;
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
         switch (DataType) {
         case BB_BYTE:
-            blackboard[vid_index].Value.b = v.b;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).b = v.b;
+            SET_BB_WRITTEN(vid_index);
             break;
         case BB_UBYTE:
-            blackboard[vid_index].Value.ub = v.ub;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).ub = v.ub;
+            SET_BB_WRITTEN(vid_index);
             break;
         case BB_WORD:
-            blackboard[vid_index].Value.w = v.w;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).w = v.w;
+            SET_BB_WRITTEN(vid_index);
             break;
         case BB_UWORD:
-            blackboard[vid_index].Value.uw = v.uw;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).uw = v.uw;
+            SET_BB_WRITTEN(vid_index);
             break;
         case BB_DWORD:
-            blackboard[vid_index].Value.dw = v.dw;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).dw = v.dw;
+            SET_BB_WRITTEN(vid_index);
             break;
         case BB_UDWORD:
-            blackboard[vid_index].Value.udw = v.udw;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).udw = v.udw;
+            SET_BB_WRITTEN(vid_index);
             break;
         case BB_FLOAT:
-            blackboard[vid_index].Value.f = v.f;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).f = v.f;
+            SET_BB_WRITTEN(vid_index);
             break;
         case BB_DOUBLE:
-            blackboard[vid_index].Value.d = v.d;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).d = v.d;
+            SET_BB_WRITTEN(vid_index);
             break;
         case BB_CONVERT_LIMIT_MIN_MAX:
-            switch(blackboard[vid_index].Type) {
+            switch(BB_TYPE(vid_index)) {
             case BB_BYTE:
-                blackboard[vid_index].Value.b = convert_double2byte(v.d);
-                blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+                BB_VALUE(vid_index).b = convert_double2byte(v.d);
+                SET_BB_WRITTEN(vid_index);
                 break;
 
             case BB_UBYTE:
-                blackboard[vid_index].Value.ub = convert_double2ubyte(v.d);
-                blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+                BB_VALUE(vid_index).ub = convert_double2ubyte(v.d);
+                SET_BB_WRITTEN(vid_index);
                 break;
 
             case BB_WORD:
-                blackboard[vid_index].Value.w = convert_double2word(v.d);
-                blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+                BB_VALUE(vid_index).w = convert_double2word(v.d);
+                SET_BB_WRITTEN(vid_index);
                 break;
 
             case BB_UWORD:
-                blackboard[vid_index].Value.uw = convert_double2uword(v.d);
-                blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+                BB_VALUE(vid_index).uw = convert_double2uword(v.d);
+                SET_BB_WRITTEN(vid_index);
                 break;
 
             case BB_DWORD:
-                blackboard[vid_index].Value.dw = convert_double2dword(v.d);
-                blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+                BB_VALUE(vid_index).dw = convert_double2dword(v.d);
+                SET_BB_WRITTEN(vid_index);
                 break;
 
             case BB_UDWORD:
-                blackboard[vid_index].Value.udw = convert_double2udword(v.d);
-                blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+                BB_VALUE(vid_index).udw = convert_double2udword(v.d);
+                SET_BB_WRITTEN(vid_index);
                 break;
 
             case BB_FLOAT:
-                blackboard[vid_index].Value.f = convert_double2float(v.d);
-                blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+                BB_VALUE(vid_index).f = convert_double2float(v.d);
+                SET_BB_WRITTEN(vid_index);
                 break;
 
             case BB_DOUBLE:
-                blackboard[vid_index].Value.d = v.d;
-                blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+                BB_VALUE(vid_index).d = v.d;
+                SET_BB_WRITTEN(vid_index);
                 break;
             default:
                 break;
@@ -843,58 +812,58 @@ void write_bbvari_minmax_check_pid (PID pid, VID vid, double v)
     }
     EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         // Change the  wr-flags
-        switch(blackboard[vid_index].Type) {
+        switch(BB_TYPE(vid_index)) {
         case BB_BYTE:
-            blackboard[vid_index].Value.b = sc_convert_double2byte(v);
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).b = sc_convert_double2byte(v);
+            SET_BB_WRITTEN(vid_index);
             break;
 
         case BB_UBYTE:
-            blackboard[vid_index].Value.ub = sc_convert_double2ubyte(v);
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).ub = sc_convert_double2ubyte(v);
+            SET_BB_WRITTEN(vid_index);
             break;
 
         case BB_WORD:
-            blackboard[vid_index].Value.w = sc_convert_double2word(v);
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).w = sc_convert_double2word(v);
+            SET_BB_WRITTEN(vid_index);
             break;
 
         case BB_UWORD:
-            blackboard[vid_index].Value.uw = sc_convert_double2uword(v);
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).uw = sc_convert_double2uword(v);
+            SET_BB_WRITTEN(vid_index);
             break;
 
         case BB_DWORD:
-            blackboard[vid_index].Value.dw = sc_convert_double2dword(v);
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).dw = sc_convert_double2dword(v);
+            SET_BB_WRITTEN(vid_index);
             break;
 
         case BB_UDWORD:
-            blackboard[vid_index].Value.udw = sc_convert_double2udword(v);
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).udw = sc_convert_double2udword(v);
+            SET_BB_WRITTEN(vid_index);
             break;
 
         case BB_QWORD:
-            blackboard[vid_index].Value.qw = sc_convert_double2qword(v);
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).qw = sc_convert_double2qword(v);
+            SET_BB_WRITTEN(vid_index);
             break;
 
         case BB_UQWORD:
-            blackboard[vid_index].Value.uqw = sc_convert_double2uqword(v);
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).uqw = sc_convert_double2uqword(v);
+            SET_BB_WRITTEN(vid_index);
             break;
 
         case BB_FLOAT:
-            blackboard[vid_index].Value.f = sc_convert_double2float(v);
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).f = sc_convert_double2float(v);
+            SET_BB_WRITTEN(vid_index);
             break;
 
         case BB_DOUBLE:
-            blackboard[vid_index].Value.d = v;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index).d = v;
+            SET_BB_WRITTEN(vid_index);
             break;
         default:
             break;
@@ -920,12 +889,11 @@ int write_bbvari_convert_to (PID pid, VID vid, int convert_from_type, void *ret_
             // Determine the process  index (for access mask)
             if ((pid_index = get_process_index (pid)) >= 0) {
                 // Takeover value only if the process have access rights
-                if (blackboard[vid_index].AccessFlags &
+                if (BB_ACCESS_FLAGS(vid_index) &
                     blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
                     int Ret;
-                    blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
-                    Ret = sc_convert_from_to (convert_from_type, ret_Ptr, blackboard[vid_index].Type, &blackboard[vid_index].Value);
-                    blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+                    Ret = sc_convert_from_to (convert_from_type, ret_Ptr, BB_TYPE(vid_index), &BB_VALUE(vid_index));
+                    SET_BB_WRITTEN(vid_index);
                     return Ret;
                 }
             }
@@ -1130,20 +1098,20 @@ static int write_bbvari_phys_minmax_check_inner(int vid_index, double new_phys_v
     double m;
     double phys;
 
-    if (blackboard[vid_index].Type == BB_FLOAT) {
+    if (BB_TYPE(vid_index) == BB_FLOAT) {
         calc_min_max_target_value_float (new_phys_value, &range_min, &range_max);
-    } else if (blackboard[vid_index].Type == BB_DOUBLE) {
+    } else if (BB_TYPE(vid_index) == BB_DOUBLE) {
         calc_min_max_target_value_double (new_phys_value, &range_min, &range_max);
     }
 
-    get_datatype_min_max_value (blackboard[vid_index].Type, &min, &max);
+    get_datatype_min_max_value (BB_TYPE(vid_index), &min, &max);
 
-    if (bbvari_to_double (blackboard[vid_index].Type, blackboard[vid_index].Value, &old_raw_value) == -1) {
+    if (bbvari_to_double (BB_TYPE(vid_index), BB_VALUE(vid_index), &old_raw_value) == -1) {
         return -1;
     }
     // First approach
-    if ((blackboard[vid_index].Type == BB_FLOAT) ||
-        (blackboard[vid_index].Type == BB_DOUBLE)) {
+    if ((BB_TYPE(vid_index) == BB_FLOAT) ||
+        (BB_TYPE(vid_index) == BB_DOUBLE)) {
         delta = fabs(old_raw_value * 0.01) + 1.0;
     } else {
         delta = fabs(old_raw_value) + 1.0;
@@ -1156,8 +1124,8 @@ static int write_bbvari_phys_minmax_check_inner(int vid_index, double new_phys_v
     for (x = 0; x < 100; x++) {
         //double phys;
         phys = execute_stack_whith_parameter_cs ((struct EXEC_STACK_ELEM *)blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode, new_raw_value, 0);
-        if ((blackboard[vid_index].Type == BB_FLOAT) ||
-            (blackboard[vid_index].Type == BB_DOUBLE)) {
+        if ((BB_TYPE(vid_index) == BB_FLOAT) ||
+            (BB_TYPE(vid_index) == BB_DOUBLE)) {
             if ((phys < range_max) && (phys > range_min)) {
                 break;
             }
@@ -1166,8 +1134,8 @@ static int write_bbvari_phys_minmax_check_inner(int vid_index, double new_phys_v
                 break;
             }
         }
-        if ((blackboard[vid_index].Type == BB_FLOAT) ||
-            (blackboard[vid_index].Type == BB_DOUBLE)) {
+        if ((BB_TYPE(vid_index) == BB_FLOAT) ||
+            (BB_TYPE(vid_index) == BB_DOUBLE)) {
             delta = fabs(new_raw_value * 0.01) + 1.0;
         } else {
             delta = fabs(new_raw_value) + 1.0;
@@ -1185,9 +1153,9 @@ static int write_bbvari_phys_minmax_check_inner(int vid_index, double new_phys_v
         new_raw_value_help = new_raw_value;
         for (dir = 0; dir < 2; dir++) {
             for (x = 0; x < 100; x++) {
-                if (blackboard[vid_index].Type == BB_FLOAT) {
+                if (BB_TYPE(vid_index) == BB_FLOAT) {
                     new_raw_value_help = (double)mantissa_plus_or_minus_one_digit_float ((float)new_raw_value_help, dir);
-                } else if (blackboard[vid_index].Type == BB_DOUBLE) {
+                } else if (BB_TYPE(vid_index) == BB_DOUBLE) {
                     new_raw_value_help = mantissa_plus_or_minus_one_digit_double (new_raw_value_help, dir);
                 } else {
                     // Integer data type
@@ -1220,7 +1188,7 @@ static int write_bbvari_phys_minmax_check_inner(int vid_index, double new_phys_v
     if (new_raw_value < min) {
         new_raw_value = min;
     }
-    ConvertDoubleToUnion(blackboard[vid_index].Type, new_raw_value, ret_Value);
+    ConvertDoubleToUnion(BB_TYPE(vid_index), new_raw_value, ret_Value);
     return 0;
 }
 
@@ -1231,9 +1199,9 @@ static int write_bbvari_factor_offset_minmax_check_inner(int vid_index, double n
     double min;
     double max;
 
-    get_datatype_min_max_value (blackboard[vid_index].Type, &min, &max);
+    get_datatype_min_max_value (BB_TYPE(vid_index), &min, &max);
 
-    if (bbvari_to_double (blackboard[vid_index].Type, blackboard[vid_index].Value, &old_raw_value) == -1) {
+    if (bbvari_to_double (BB_TYPE(vid_index), BB_VALUE(vid_index), &old_raw_value) == -1) {
         return -1;
     }
     if (blackboard[vid_index].pAdditionalInfos->Conversion.Type == BB_CONV_FACTOFF) {
@@ -1250,7 +1218,7 @@ static int write_bbvari_factor_offset_minmax_check_inner(int vid_index, double n
     if (new_raw_value < min) {
         new_raw_value = min;
     }
-    ConvertDoubleToUnion(blackboard[vid_index].Type, new_raw_value, ret_Value);
+    ConvertDoubleToUnion(BB_TYPE(vid_index), new_raw_value, ret_Value);
     return 0;
 }
 
@@ -1260,41 +1228,16 @@ static int write_bbvari_table_minmax_check_inner(int vid_index, double new_phys_
     double new_raw_value;
     double min;
     double max;
-    int x, Size;
-    double m, PhysDelta, RawDelta;
-    struct CONVERSION_TABLE_VALUE_PAIR *Values;
 
-    get_datatype_min_max_value (blackboard[vid_index].Type, &min, &max);
+    get_datatype_min_max_value (BB_TYPE(vid_index), &min, &max);
 
-    if (bbvari_to_double (blackboard[vid_index].Type, blackboard[vid_index].Value, &old_raw_value) == -1) {
+    if (bbvari_to_double (BB_TYPE(vid_index), BB_VALUE(vid_index), &old_raw_value) == -1) {
         return -1;
     }
-    Size = blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Table.Size;
-    Values = blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Table.Values;
-
-    for (x = 0; x < Size; x++) {
-        if (Values[x].Phys >= new_phys_value) {
-            if (x == 0) {
-                new_raw_value = Values[x].Raw;
-            } else {
-                if (blackboard[vid_index].pAdditionalInfos->Conversion.Type == BB_CONV_TAB_INTP) {
-                    PhysDelta = Values[x].Phys - Values[x-1].Phys;
-                    if ((PhysDelta <= 0.0) && (PhysDelta >= 0.0)) {  // == 0.0
-                        new_raw_value = Values[x-1].Raw;  // use the smallest one
-                    } else {
-                        RawDelta = Values[x].Raw - Values[x-1].Raw;
-                        m = RawDelta / PhysDelta;
-                        new_raw_value = Values[x-1].Raw + m * (new_phys_value - Values[x-1].Phys);
-                    }
-                } else {
-                    new_raw_value = Values[x].Raw;
-                }
-            }
-            break;  // for(;;)
-        }
-    }
-    if (x == Size) {
-        new_raw_value = Values[Size - 1].Raw;
+    if (blackboard[vid_index].pAdditionalInfos->Conversion.Type == BB_CONV_TAB_INTP) {
+        Conv_TableInterpolPhysToRaw(&blackboard[vid_index].pAdditionalInfos->Conversion, new_phys_value, &new_raw_value);
+    } else {
+        Conv_TableNoInterpolPhysToRaw(&blackboard[vid_index].pAdditionalInfos->Conversion, new_phys_value, &new_raw_value);
     }
     // Not outside the data type range
     if (new_raw_value > max) {
@@ -1303,7 +1246,7 @@ static int write_bbvari_table_minmax_check_inner(int vid_index, double new_phys_
     if (new_raw_value < min) {
         new_raw_value = min;
     }
-    ConvertDoubleToUnion(blackboard[vid_index].Type, new_raw_value, ret_Value);
+    ConvertDoubleToUnion(BB_TYPE(vid_index), new_raw_value, ret_Value);
     return 0;
 }
 
@@ -1315,9 +1258,9 @@ static int write_bbvari_rational_function_minmax_check_inner(int vid_index, doub
     double max;
     double a, b;
 
-    get_datatype_min_max_value (blackboard[vid_index].Type, &min, &max);
+    get_datatype_min_max_value (BB_TYPE(vid_index), &min, &max);
 
-    if (bbvari_to_double (blackboard[vid_index].Type, blackboard[vid_index].Value, &old_raw_value) == -1) {
+    if (bbvari_to_double (BB_TYPE(vid_index), BB_VALUE(vid_index), &old_raw_value) == -1) {
         return -1;
     }
     // f(x)=(axx + bx + c)/(dxx + ex + f)
@@ -1340,7 +1283,7 @@ static int write_bbvari_rational_function_minmax_check_inner(int vid_index, doub
     if (new_raw_value < min) {
         new_raw_value = min;
     }
-    ConvertDoubleToUnion(blackboard[vid_index].Type, new_raw_value, ret_Value);
+    ConvertDoubleToUnion(BB_TYPE(vid_index), new_raw_value, ret_Value);
     return 0;
 }
 
@@ -1371,7 +1314,7 @@ int write_bbvari_phys_minmax_check_pid_cs (PID pid, VID vid, double new_phys_val
     }
     if (cs) EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
 
         // Is there a conversion defined
@@ -1385,9 +1328,8 @@ int write_bbvari_phys_minmax_check_pid_cs (PID pid, VID vid, double new_phys_val
                 return ret;
             }
             // Now write the calculated raw value
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
-            blackboard[vid_index].Value = Value;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index) = Value;
+            SET_BB_WRITTEN(vid_index);
             break;
         }
         case BB_CONV_FACTOFF:
@@ -1400,9 +1342,8 @@ int write_bbvari_phys_minmax_check_pid_cs (PID pid, VID vid, double new_phys_val
                 return ret;
             }
             // Now write the calculated raw value
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
-            blackboard[vid_index].Value = Value;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index) = Value;
+            SET_BB_WRITTEN(vid_index);
             break;
         }
         case BB_CONV_TAB_INTP:
@@ -1415,9 +1356,8 @@ int write_bbvari_phys_minmax_check_pid_cs (PID pid, VID vid, double new_phys_val
                 return ret;
             }
             // Now write the calculated raw value
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
-            blackboard[vid_index].Value = Value;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index) = Value;
+            SET_BB_WRITTEN(vid_index);
             break;
         }
         case BB_CONV_RAT_FUNC:
@@ -1429,9 +1369,8 @@ int write_bbvari_phys_minmax_check_pid_cs (PID pid, VID vid, double new_phys_val
                 return ret;
             }
             // Now write the calculated raw value
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
-            blackboard[vid_index].Value = Value;
-            blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+            BB_VALUE(vid_index) = Value;
+            SET_BB_WRITTEN(vid_index);
             break;
         }
         default:
@@ -1524,7 +1463,7 @@ int get_raw_value_for_phys_value (VID vid, double phys_value, double *ret_raw_va
         ret = -1;
     }
     if (ret == 0) {
-        if (bbvari_to_double(blackboard[vid_index].Type,
+        if (bbvari_to_double(BB_TYPE(vid_index),
                              Value,
                              ret_raw_value) == -1) {
             ret = -1;
@@ -1553,11 +1492,11 @@ int8_t read_bbvari_byte(VID vid)
         return 0;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_BYTE) {
+    if (BB_TYPE(vid_index) != BB_BYTE) {
         return 0;
     }
     // Return the value
-    return blackboard[vid_index].Value.b;
+    return BB_VALUE(vid_index).b;
 }
 
 uint8_t read_bbvari_ubyte(VID vid)
@@ -1578,11 +1517,11 @@ uint8_t read_bbvari_ubyte(VID vid)
         return 0;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_UBYTE) {
+    if (BB_TYPE(vid_index) != BB_UBYTE) {
         return 0;
     }
     // Return the value
-    return blackboard[vid_index].Value.ub;
+    return BB_VALUE(vid_index).ub;
 }
 
 int16_t read_bbvari_word(VID vid)
@@ -1603,11 +1542,11 @@ int16_t read_bbvari_word(VID vid)
         return 0;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_WORD) {
+    if (BB_TYPE(vid_index) != BB_WORD) {
         return 0;
     }
     // Return the value
-    return blackboard[vid_index].Value.w;
+    return BB_VALUE(vid_index).w;
 }
 
 uint16_t read_bbvari_uword(VID vid)
@@ -1628,11 +1567,11 @@ uint16_t read_bbvari_uword(VID vid)
         return 0;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_UWORD) {
+    if (BB_TYPE(vid_index) != BB_UWORD) {
         return 0;
     }
     // Return the value
-    return blackboard[vid_index].Value.uw;
+    return BB_VALUE(vid_index).uw;
 }
 
 int32_t read_bbvari_dword(VID vid)
@@ -1653,11 +1592,11 @@ int32_t read_bbvari_dword(VID vid)
         return 0;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_DWORD) {
+    if (BB_TYPE(vid_index) != BB_DWORD) {
         return 0L;
     }
     // Return the value
-    return blackboard[vid_index].Value.dw;
+    return BB_VALUE(vid_index).dw;
 }
 
 uint32_t read_bbvari_udword(VID vid)
@@ -1678,11 +1617,11 @@ uint32_t read_bbvari_udword(VID vid)
         return 0;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_UDWORD) {
+    if (BB_TYPE(vid_index) != BB_UDWORD) {
         return 0UL;
     }
     // Return the value
-    return blackboard[vid_index].Value.udw;
+    return BB_VALUE(vid_index).udw;
 }
 
 int64_t read_bbvari_qword (VID vid)
@@ -1703,11 +1642,11 @@ int64_t read_bbvari_qword (VID vid)
         return 0;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_QWORD) {
+    if (BB_TYPE(vid_index) != BB_QWORD) {
         return 0L;
     }
     // Return the value
-    return blackboard[vid_index].Value.qw;
+    return BB_VALUE(vid_index).qw;
 }
 
 uint64_t read_bbvari_uqword (VID vid)
@@ -1728,11 +1667,11 @@ uint64_t read_bbvari_uqword (VID vid)
         return 0;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_UQWORD) {
+    if (BB_TYPE(vid_index) != BB_UQWORD) {
         return 0UL;
     }
     // Return the value
-    return blackboard[vid_index].Value.uqw;
+    return BB_VALUE(vid_index).uqw;
 }
 
 float read_bbvari_float (VID vid)
@@ -1753,11 +1692,11 @@ float read_bbvari_float (VID vid)
         return 0.0;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_FLOAT) {
+    if (BB_TYPE(vid_index) != BB_FLOAT) {
         return 0.0;
     }
     // Return the value
-    return blackboard[vid_index].Value.f;
+    return BB_VALUE(vid_index).f;
 }
 
 double read_bbvari_double (VID vid)
@@ -1778,11 +1717,11 @@ double read_bbvari_double (VID vid)
         return 0.0;
     }
     // Check if data type match
-    if (blackboard[vid_index].Type != BB_DOUBLE) {
+    if (BB_TYPE(vid_index) != BB_DOUBLE) {
         return 0.0;
     }
     // Return the value
-    return blackboard[vid_index].Value.d;
+    return BB_VALUE(vid_index).d;
 }
 
 union BB_VARI read_bbvari_union (VID vid)
@@ -1805,7 +1744,7 @@ union BB_VARI read_bbvari_union (VID vid)
         return error_ret;
     }
     // Return the value
-    return blackboard[vid_index].Value;
+    return BB_VALUE(vid_index);
 }
 
 enum BB_DATA_TYPES read_bbvari_union_type (VID vid, union BB_VARI *ret_Value)
@@ -1824,9 +1763,9 @@ enum BB_DATA_TYPES read_bbvari_union_type (VID vid, union BB_VARI *ret_Value)
     if ((vid_index = get_variable_index(vid)) == -1) {
         return -1;
     }
-    *ret_Value = blackboard[vid_index].Value;
+    *ret_Value = BB_VALUE(vid_index);
     // Return the type
-    return blackboard[vid_index].Type;
+    return BB_TYPE(vid_index);
 }
 
 int read_bbvari_union_type_frame (int Number, VID *Vids, enum BB_DATA_TYPES *ret_Types, union BB_VARI *ret_Values)
@@ -1847,8 +1786,8 @@ int read_bbvari_union_type_frame (int Number, VID *Vids, enum BB_DATA_TYPES *ret
             ret_Types[x] = BB_INVALID;
             ret_Values[x].uqw = 0;
         } else {
-            ret_Types[x] = blackboard[vid_index].Type;
-            ret_Values[x] = blackboard[vid_index].Value;
+            ret_Types[x] = BB_TYPE(vid_index);
+            ret_Values[x] = BB_VALUE(vid_index);
         }
     // Return the number
     return x;
@@ -1877,8 +1816,8 @@ double read_bbvari_equ (VID vid)
     //if (blackboard[vid_index].pAdditionalInfos->Conversion.Type != BB_CONV_FORMULA) {
     //    return 0.0;
     //}
-    if (bbvari_to_double (blackboard[vid_index].Type,
-                          blackboard[vid_index].Value, &Value)) {
+    if (bbvari_to_double (BB_TYPE(vid_index),
+                          BB_VALUE(vid_index), &Value)) {
         return 0.0;
     } else {
         if (convert_physical_internal(vid_index, Value, &Value)) {
@@ -1909,8 +1848,8 @@ double read_bbvari_convert_double (VID vid)
     if ((vid_index = get_variable_index(vid)) == -1) {
         return 0.0;
     }
-    if (bbvari_to_double (blackboard[vid_index].Type,
-                          blackboard[vid_index].Value,
+    if (bbvari_to_double (BB_TYPE(vid_index),
+                          BB_VALUE(vid_index),
                           &ret_value) == -1) {
         return 0.0;
     }
@@ -1937,34 +1876,34 @@ int read_bbvari_convert_to (VID vid, int convert_to_type, union BB_VARI *ret_Ptr
     }
     switch (convert_to_type) {
     case BB_BYTE:
-        sc_convert_2byte (blackboard[vid_index].Type, &blackboard[vid_index].Value, ret_Ptr);
+        sc_convert_2byte (BB_TYPE(vid_index), &BB_VALUE(vid_index), ret_Ptr);
         return 1;
     case BB_UBYTE:
-        sc_convert_2ubyte (blackboard[vid_index].Type, &blackboard[vid_index].Value, ret_Ptr);
+        sc_convert_2ubyte (BB_TYPE(vid_index), &BB_VALUE(vid_index), ret_Ptr);
         return 1;
     case BB_WORD:
-        sc_convert_2word (blackboard[vid_index].Type, &blackboard[vid_index].Value, ret_Ptr);
+        sc_convert_2word (BB_TYPE(vid_index), &BB_VALUE(vid_index), ret_Ptr);
         return 2;
     case BB_UWORD:
-        sc_convert_2uword (blackboard[vid_index].Type, &blackboard[vid_index].Value, ret_Ptr);
+        sc_convert_2uword (BB_TYPE(vid_index), &BB_VALUE(vid_index), ret_Ptr);
         return 2;
     case BB_DWORD:
-        sc_convert_2dword (blackboard[vid_index].Type, &blackboard[vid_index].Value, ret_Ptr);
+        sc_convert_2dword (BB_TYPE(vid_index), &BB_VALUE(vid_index), ret_Ptr);
         return 4;
     case BB_UDWORD:
-        sc_convert_2udword (blackboard[vid_index].Type, &blackboard[vid_index].Value, ret_Ptr);
+        sc_convert_2udword (BB_TYPE(vid_index), &BB_VALUE(vid_index), ret_Ptr);
         return 4;
     case BB_QWORD:
-        sc_convert_2qword (blackboard[vid_index].Type, &blackboard[vid_index].Value, ret_Ptr);
+        sc_convert_2qword (BB_TYPE(vid_index), &BB_VALUE(vid_index), ret_Ptr);
         return 8;
     case BB_UQWORD:
-        sc_convert_2uqword (blackboard[vid_index].Type, &blackboard[vid_index].Value, ret_Ptr);
+        sc_convert_2uqword (BB_TYPE(vid_index), &BB_VALUE(vid_index), ret_Ptr);
         return 8;
     case BB_FLOAT:
-        sc_convert_2float (blackboard[vid_index].Type, &blackboard[vid_index].Value, ret_Ptr);
+        sc_convert_2float (BB_TYPE(vid_index), &BB_VALUE(vid_index), ret_Ptr);
         return 4;
     case BB_DOUBLE:
-        sc_convert_2double (blackboard[vid_index].Type, &blackboard[vid_index].Value, ret_Ptr);
+        sc_convert_2double (BB_TYPE(vid_index), &BB_VALUE(vid_index), ret_Ptr);
         return 8;
     default:
         return -1;
@@ -1994,13 +1933,13 @@ int read_bbvari_textreplace (VID vid, char *txt, int maxc, int *pcolor)
         return -1;
     }
     // Convert variable to a 64 bit integer
-    if (bbvari_to_int64( blackboard[vid_index].Type,
-        blackboard[vid_index].Value, &value) == -1) {
+    if (bbvari_to_int64( BB_TYPE(vid_index),
+        BB_VALUE(vid_index), &value) == -1) {
         return -1;
     }
     // Convert variable to a text replace
-    return convert_value2textreplace (value, (char *)blackboard[vid_index].
-                                      pAdditionalInfos->Conversion.Conv.Formula.FormulaString, txt, maxc, pcolor);
+    return convert_value2textreplace_compiled (blackboard[vid_index].pAdditionalInfos->Conversion.TextReplaceTable, value,
+                                               blackboard[vid_index].pAdditionalInfos->Conversion.Conv.TextReplace.EnumString, txt, maxc, pcolor);
 }
 
 int read_bbvari_convert_to_FloatAndInt64(VID vid, union FloatOrInt64 *ret_Value)
@@ -2023,45 +1962,45 @@ int read_bbvari_convert_to_FloatAndInt64(VID vid, union FloatOrInt64 *ret_Value)
         return -1;
     }
 
-    switch (blackboard[vid_index].Type) {
+    switch (BB_TYPE(vid_index)) {
     case BB_BYTE:
-        ret_Value->qw = blackboard[vid_index].Value.b;
+        ret_Value->qw = BB_VALUE(vid_index).b;
         Ret = FLOAT_OR_INT_64_TYPE_INT64;
         break;
     case BB_UBYTE:
-        ret_Value->uqw = blackboard[vid_index].Value.ub;
+        ret_Value->uqw = BB_VALUE(vid_index).ub;
         Ret = FLOAT_OR_INT_64_TYPE_UINT64;
         break;
     case BB_WORD:
-        ret_Value->qw = blackboard[vid_index].Value.w;
+        ret_Value->qw = BB_VALUE(vid_index).w;
         Ret = FLOAT_OR_INT_64_TYPE_INT64;
         break;
     case BB_UWORD:
-        ret_Value->uqw = blackboard[vid_index].Value.uw;
+        ret_Value->uqw = BB_VALUE(vid_index).uw;
         Ret = FLOAT_OR_INT_64_TYPE_UINT64;
         break;
     case BB_DWORD:
-        ret_Value->qw = blackboard[vid_index].Value.dw;
+        ret_Value->qw = BB_VALUE(vid_index).dw;
         Ret = FLOAT_OR_INT_64_TYPE_INT64;
         break;
     case BB_UDWORD:
-        ret_Value->uqw = blackboard[vid_index].Value.udw;
+        ret_Value->uqw = BB_VALUE(vid_index).udw;
         Ret = FLOAT_OR_INT_64_TYPE_UINT64;
         break;
     case BB_QWORD:
-        ret_Value->qw = blackboard[vid_index].Value.qw;
+        ret_Value->qw = BB_VALUE(vid_index).qw;
         Ret = FLOAT_OR_INT_64_TYPE_INT64;
         break;
     case BB_UQWORD:
-        ret_Value->uqw = blackboard[vid_index].Value.uqw;
+        ret_Value->uqw = BB_VALUE(vid_index).uqw;
         Ret = FLOAT_OR_INT_64_TYPE_UINT64;
         break;
     case BB_FLOAT:
-        ret_Value->d = (double)blackboard[vid_index].Value.f;
+        ret_Value->d = (double)BB_VALUE(vid_index).f;
         Ret = FLOAT_OR_INT_64_TYPE_F64;
         break;
     case BB_DOUBLE:
-        ret_Value->d = blackboard[vid_index].Value.d;
+        ret_Value->d = BB_VALUE(vid_index).d;
         Ret = FLOAT_OR_INT_64_TYPE_F64;
         break;
     default:
@@ -2438,45 +2377,45 @@ void write_bbvari_convert_with_FloatAndInt64_pid_cs(PID pid, VID vid, union Floa
     }
     if (cs) EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
 
-        switch (blackboard[vid_index].Type) {
+        switch (BB_TYPE(vid_index)) {
         case BB_BYTE:
-            blackboard[vid_index].Value.b  = sc_convert_qword2byte(FloatOrInt64_ToInt64(value, type));
+            BB_VALUE(vid_index).b  = sc_convert_qword2byte(FloatOrInt64_ToInt64(value, type));
             break;
         case BB_UBYTE:
-            blackboard[vid_index].Value.ub  = sc_convert_uqword2ubyte(FloatOrInt64_ToUint64(value, type));
+            BB_VALUE(vid_index).ub  = sc_convert_uqword2ubyte(FloatOrInt64_ToUint64(value, type));
             break;
         case BB_WORD:
-            blackboard[vid_index].Value.w  = sc_convert_qword2word(FloatOrInt64_ToInt64(value, type));
+            BB_VALUE(vid_index).w  = sc_convert_qword2word(FloatOrInt64_ToInt64(value, type));
             break;
         case BB_UWORD:
-            blackboard[vid_index].Value.uw  = sc_convert_uqword2uword(FloatOrInt64_ToUint64(value, type));
+            BB_VALUE(vid_index).uw  = sc_convert_uqword2uword(FloatOrInt64_ToUint64(value, type));
             break;
         case BB_DWORD:
-            blackboard[vid_index].Value.dw  = sc_convert_qword2dword(FloatOrInt64_ToInt64(value, type));
+            BB_VALUE(vid_index).dw  = sc_convert_qword2dword(FloatOrInt64_ToInt64(value, type));
             break;
         case BB_UDWORD:
-            blackboard[vid_index].Value.udw  = sc_convert_uqword2udword(FloatOrInt64_ToUint64(value, type));
+            BB_VALUE(vid_index).udw  = sc_convert_uqword2udword(FloatOrInt64_ToUint64(value, type));
             break;
         case BB_QWORD:
-            blackboard[vid_index].Value.qw  = FloatOrInt64_ToInt64(value, type);
+            BB_VALUE(vid_index).qw  = FloatOrInt64_ToInt64(value, type);
             break;
         case BB_UQWORD:
-            blackboard[vid_index].Value.uqw  = FloatOrInt64_ToUint64(value, type);
+            BB_VALUE(vid_index).uqw  = FloatOrInt64_ToUint64(value, type);
             break;
         case BB_FLOAT:
-            blackboard[vid_index].Value.f  = sc_convert_double2float(FloatOrInt64_ToDouble(value, type));
+            BB_VALUE(vid_index).f  = sc_convert_double2float(FloatOrInt64_ToDouble(value, type));
             break;
         case BB_DOUBLE:
-            blackboard[vid_index].Value.d  = FloatOrInt64_ToDouble(value, type);
+            BB_VALUE(vid_index).d  = FloatOrInt64_ToDouble(value, type);
             break;
         default:
-            blackboard[vid_index].Value.uqw = 0;
+            BB_VALUE(vid_index).uqw = 0;
             break;
         }
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        SET_BB_WRITTEN(vid_index);
     }
     if (cs) LeaveBlackboardCriticalSection();
 }
@@ -2515,45 +2454,45 @@ void write_bbvari_binary_FloatAndInt64_pid_cs(PID pid, VID vid, union FloatOrInt
     }
     if (cs) EnterBlackboardCriticalSection();
     // Takeover value only if the process have access rights
-    if (blackboard[vid_index].AccessFlags &
+    if (BB_ACCESS_FLAGS(vid_index) &
         blackboard[vid_index].WrEnableFlags & (1ULL << pid_index)) {
         uint64_t Value = FloatOrInt64_ToUint64(value, type);
-        switch (blackboard[vid_index].Type) {
+        switch (BB_TYPE(vid_index)) {
         case BB_BYTE:
-            blackboard[vid_index].Value.b  = (int8_t)Value;
+            BB_VALUE(vid_index).b  = (int8_t)Value;
             break;
         case BB_UBYTE:
-            blackboard[vid_index].Value.ub  = (uint8_t)Value;
+            BB_VALUE(vid_index).ub  = (uint8_t)Value;
             break;
         case BB_WORD:
-            blackboard[vid_index].Value.w  = (int16_t)Value;
+            BB_VALUE(vid_index).w  = (int16_t)Value;
             break;
         case BB_UWORD:
-            blackboard[vid_index].Value.uw  = (uint16_t)Value;
+            BB_VALUE(vid_index).uw  = (uint16_t)Value;
             break;
         case BB_DWORD:
-            blackboard[vid_index].Value.dw  =  (int32_t)Value;
+            BB_VALUE(vid_index).dw  =  (int32_t)Value;
             break;
         case BB_UDWORD:
-            blackboard[vid_index].Value.udw  = (uint32_t)Value;
+            BB_VALUE(vid_index).udw  = (uint32_t)Value;
             break;
         case BB_QWORD:
-            blackboard[vid_index].Value.qw  = (int64_t)Value;
+            BB_VALUE(vid_index).qw  = (int64_t)Value;
             break;
         case BB_UQWORD:
-            blackboard[vid_index].Value.uqw  = Value;
+            BB_VALUE(vid_index).uqw  = Value;
             break;
         case BB_FLOAT:
-            *(uint32_t*)&(blackboard[vid_index].Value.f) = (uint32_t)Value;
+            *(uint32_t*)&(BB_VALUE(vid_index).f) = (uint32_t)Value;
             break;
         case BB_DOUBLE:
-            *(uint64_t*)&(blackboard[vid_index].Value.d) = (uint64_t)Value;
+            *(uint64_t*)&(BB_VALUE(vid_index).d) = (uint64_t)Value;
             break;
         default:
-            blackboard[vid_index].Value.uqw = 0;
+            BB_VALUE(vid_index).uqw = 0;
             break;
         }
-        blackboard[vid_index].WrFlags = ALL_WRFLAG_MASK;
+        SET_BB_WRITTEN(vid_index);
     }
     if (cs) LeaveBlackboardCriticalSection();
 }
@@ -2573,7 +2512,6 @@ static int read_bbvari_by_name_x(const char *name, int vid, union FloatOrInt64 *
     int vid_index;
 #ifdef USE_HASH_BB_SEARCH
     uint64_t HashCode;
-    int32_t P1, P2;
 #endif
 
     // Is blackboard exists here or inside the remote master or not at all
@@ -2596,7 +2534,7 @@ static int read_bbvari_by_name_x(const char *name, int vid, union FloatOrInt64 *
     // schaue ob Variable schon vorhanden
 #ifdef USE_HASH_BB_SEARCH
     HashCode = BuildHashCode(name);
-    vid_index = BinarySearchIndex(name, HashCode, &P1, &P2);
+    vid_index = SearchHashKey(name, HashCode, NULL);
     if (vid_index >= 0) {
         if (1) {
             if (1) {
@@ -2610,52 +2548,52 @@ static int read_bbvari_by_name_x(const char *name, int vid, union FloatOrInt64 *
                 if (strcmp(name, (char*)blackboard[vid_index].pAdditionalInfos->Name) == 0) {
 #endif
 __VID:
-                    if (blackboard[vid_index].Type == BB_UNKNOWN_WAIT) {  // noch kein Datentyp angegeben
+                    if (BB_TYPE(vid_index) == BB_UNKNOWN_WAIT) {  // noch kein Datentyp angegeben
                         ret_value->uqw = 0;
                         *ret_byte_width = 8;
                         return FLOAT_OR_INT_64_TYPE_INVALID;
                     }
                     switch (read_type) {
                     case READ_TYPE_RAW_VALUE: // Wert
-                        switch (blackboard[vid_index].Type) {
+                        switch (BB_TYPE(vid_index)) {
                         case BB_BYTE:
-                            ret_value->qw = blackboard[vid_index].Value.b;
+                            ret_value->qw = BB_VALUE(vid_index).b;
                             *ret_byte_width = 1;
                             return FLOAT_OR_INT_64_TYPE_INT64;
                         case BB_UBYTE:
-                            ret_value->uqw = blackboard[vid_index].Value.ub;
+                            ret_value->uqw = BB_VALUE(vid_index).ub;
                             *ret_byte_width = 1;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_WORD:
-                            ret_value->qw = blackboard[vid_index].Value.w;
+                            ret_value->qw = BB_VALUE(vid_index).w;
                             *ret_byte_width = 2;
                             return FLOAT_OR_INT_64_TYPE_INT64;
                         case BB_UWORD:
-                            ret_value->uqw = blackboard[vid_index].Value.uw;
+                            ret_value->uqw = BB_VALUE(vid_index).uw;
                             *ret_byte_width = 2;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_DWORD:
-                            ret_value->qw = blackboard[vid_index].Value.dw;
+                            ret_value->qw = BB_VALUE(vid_index).dw;
                             *ret_byte_width = 4;
                             return FLOAT_OR_INT_64_TYPE_INT64;
                         case BB_UDWORD:
-                            ret_value->uqw = blackboard[vid_index].Value.udw;
+                            ret_value->uqw = BB_VALUE(vid_index).udw;
                             *ret_byte_width = 4;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_QWORD:
-                            ret_value->qw = blackboard[vid_index].Value.qw;
+                            ret_value->qw = BB_VALUE(vid_index).qw;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_INT64;
                         case BB_UQWORD:
-                            ret_value->uqw = blackboard[vid_index].Value.uqw;
+                            ret_value->uqw = BB_VALUE(vid_index).uqw;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_FLOAT:
-                            ret_value->d = (double)blackboard[vid_index].Value.f;
+                            ret_value->d = (double)BB_VALUE(vid_index).f;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_F64;
                         case BB_DOUBLE:
-                            ret_value->d = blackboard[vid_index].Value.d;
+                            ret_value->d = BB_VALUE(vid_index).d;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_F64;
                         default:
@@ -2673,8 +2611,8 @@ __VID:
                             //    ret_value->d = 0.0;
                             //    return FLOAT_OR_INT_64_TYPE_INVALID;
                             //}
-                            if (bbvari_to_double (blackboard[vid_index].Type,
-                                                  blackboard[vid_index].Value, &Value)) {
+                            if (bbvari_to_double (BB_TYPE(vid_index),
+                                                  BB_VALUE(vid_index), &Value)) {
                                 ret_value->d = 0.0;
                                 return FLOAT_OR_INT_64_TYPE_INVALID;
                             } else {
@@ -2691,28 +2629,28 @@ __VID:
                         //break;
                     case READ_TYPE_ONS_COMPLEMENT: // Einer Komplement
                         *ret_byte_width = 8;
-                        switch (blackboard[vid_index].Type) {
+                        switch (BB_TYPE(vid_index)) {
                         case BB_BYTE:
                         case BB_UBYTE:
-                            ret_value->uqw = (uint64_t)(~blackboard[vid_index].Value.ub & 0xFF);
+                            ret_value->uqw = (uint64_t)(~BB_VALUE(vid_index).ub & 0xFF);
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_WORD:
                         case BB_UWORD:
-                            ret_value->uqw = (uint64_t)(~blackboard[vid_index].Value.uw & 0xFFFF);
+                            ret_value->uqw = (uint64_t)(~BB_VALUE(vid_index).uw & 0xFFFF);
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_DWORD:
                         case BB_UDWORD:
-                            ret_value->uqw = (uint64_t)(~blackboard[vid_index].Value.udw);
+                            ret_value->uqw = (uint64_t)(~BB_VALUE(vid_index).udw);
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_QWORD:
                         case BB_UQWORD:
-                            ret_value->uqw = (uint64_t)(~blackboard[vid_index].Value.uqw);
+                            ret_value->uqw = (uint64_t)(~BB_VALUE(vid_index).uqw);
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_FLOAT:
-                            ret_value->uqw = (uint64_t)(~((uint64_t)blackboard[vid_index].Value.f));
+                            ret_value->uqw = (uint64_t)(~((uint64_t)BB_VALUE(vid_index).f));
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_DOUBLE:
-                            ret_value->uqw = (uint64_t)(~((uint64_t)blackboard[vid_index].Value.d));
+                            ret_value->uqw = (uint64_t)(~((uint64_t)BB_VALUE(vid_index).d));
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         default:
                             ret_value->uqw = 0;
@@ -2721,49 +2659,49 @@ __VID:
                         }
                         //break;
                     case READ_TYPE_RAW_BINARY: // Wert
-                        switch (blackboard[vid_index].Type) {
+                        switch (BB_TYPE(vid_index)) {
                         case BB_BYTE:
-                            ret_value->uqw = (uint64_t)(uint8_t)blackboard[vid_index].Value.b;
+                            ret_value->uqw = (uint64_t)(uint8_t)BB_VALUE(vid_index).b;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_UBYTE:
-                            ret_value->uqw = (uint64_t)blackboard[vid_index].Value.ub;
+                            ret_value->uqw = (uint64_t)BB_VALUE(vid_index).ub;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_WORD:
-                            ret_value->uqw = (uint64_t)(uint16_t)blackboard[vid_index].Value.w;
+                            ret_value->uqw = (uint64_t)(uint16_t)BB_VALUE(vid_index).w;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_UWORD:
-                            ret_value->uqw = (uint64_t)blackboard[vid_index].Value.uw;
+                            ret_value->uqw = (uint64_t)BB_VALUE(vid_index).uw;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_DWORD:
-                            ret_value->uqw = (uint64_t)(uint32_t)blackboard[vid_index].Value.dw;
+                            ret_value->uqw = (uint64_t)(uint32_t)BB_VALUE(vid_index).dw;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_UDWORD:
-                            ret_value->uqw = (uint64_t)blackboard[vid_index].Value.udw;
+                            ret_value->uqw = (uint64_t)BB_VALUE(vid_index).udw;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_QWORD:
-                            ret_value->uqw = (uint64_t)blackboard[vid_index].Value.qw;
+                            ret_value->uqw = (uint64_t)BB_VALUE(vid_index).qw;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_UQWORD:
-                            ret_value->uqw = blackboard[vid_index].Value.uqw;
+                            ret_value->uqw = BB_VALUE(vid_index).uqw;
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_FLOAT:
                             {
-                                uint32_t *ptr = (uint32_t*)&(blackboard[vid_index].Value.f);
+                                uint32_t *ptr = (uint32_t*)&(BB_VALUE(vid_index).f);
                                 ret_value->uqw = (uint64_t)ptr[0];
                             }
                             *ret_byte_width = 8;
                             return FLOAT_OR_INT_64_TYPE_UINT64;
                         case BB_DOUBLE:
                             {
-                                uint64_t *ptr = (uint64_t*)&(blackboard[vid_index].Value.f);
+                                uint64_t *ptr = (uint64_t*)&(BB_VALUE(vid_index).f);
                                 ret_value->uqw = ptr[0];
                             }
                             *ret_byte_width = 8;
@@ -2903,8 +2841,9 @@ int convert_value_textreplace (VID vid, int32_t value, char *txt, int maxc, int
         return  -1;
     }
     // Convert variable to a text replace
-    return convert_value2textreplace (value, (char *)blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString,
-                                      txt, maxc, pcolor);
+    return convert_value2textreplace_compiled (blackboard[vid_index].pAdditionalInfos->Conversion.TextReplaceTable, value,
+                                               blackboard[vid_index].pAdditionalInfos->Conversion.Conv.TextReplace.EnumString,
+                                               txt, maxc, pcolor);
 }
 
 int convert_textreplace_value (VID vid, char *txt, int64_t *pfrom, int64_t *pto)
@@ -2924,8 +2863,9 @@ int convert_textreplace_value (VID vid, char *txt, int64_t *pfrom, int64_t *pto)
         return -1;
     }
     // Textersatz in Wert konvertieren
-    return convert_textreplace2value ((char *)blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaString, 
-                                      txt, pfrom, pto);
+    return convert_textreplace2value_compiled (blackboard[vid_index].pAdditionalInfos->Conversion.TextReplaceTable,
+                                               blackboard[vid_index].pAdditionalInfos->Conversion.Conv.TextReplace.EnumString,
+                                               txt, pfrom, pto);
 }
 
 int read_bbvari_frame (VID *Vids, int8_t *PhysOrRaw, double *RetFrameValues, int Size)
@@ -2953,13 +2893,13 @@ int read_bbvari_frame (VID *Vids, int8_t *PhysOrRaw, double *RetFrameValues, int
         } else {
             if ((PhysOrRaw == NULL) ||  // all raw value
                 (PhysOrRaw[x] == 0)) {   // this value read as raw
-                bbvari_to_double (blackboard[VidIdx].Type,
-                                 blackboard[VidIdx].Value, &RetFrameValues[x]);
+                bbvari_to_double (BB_TYPE(VidIdx),
+                                 BB_VALUE(VidIdx), &RetFrameValues[x]);
             } else {
                 //if (blackboard[VidIdx].pAdditionalInfos->Conversion.Type == BB_CONV_FORMULA) {
                     double Value;
-                    if (bbvari_to_double (blackboard[VidIdx].Type,
-                                         blackboard[VidIdx].Value, &Value)) {
+                    if (bbvari_to_double (BB_TYPE(VidIdx),
+                                         BB_VALUE(VidIdx), &Value)) {
                         Ret--;
                     } else {
                         if (convert_physical_internal(VidIdx, Value, &Value)) {
@@ -3015,9 +2955,8 @@ int write_bbvari_frame_pid (PID pid, VID *Vids, int8_t *PhysOrRaw, double *Frame
                     if (write_bbvari_phys_minmax_check_inner(VidIdx, FrameValues[x], &Value, &DoubleValue)) {
                         Ret--;
                     }
-                    blackboard[VidIdx].WrFlags = ALL_WRFLAG_MASK;
-                    blackboard[VidIdx].Value = Value;
-                    blackboard[VidIdx].WrFlags = ALL_WRFLAG_MASK;
+                    BB_VALUE(VidIdx) = Value;
+                    SET_BB_WRITTEN(VidIdx);
                 } else {
                     Ret--;
                 }
@@ -3028,3 +2967,138 @@ int write_bbvari_frame_pid (PID pid, VID *Vids, int8_t *PhysOrRaw, double *Frame
     LeaveBlackboardCriticalSection();
     return Ret;
 }
+
+// Blackboard index of a vid or -1, same as get_variable_index() but without the function call
+#define FRAME_VID_INDEX(vid) ((((vid) >= 0) && (((vid) >> 8) < get_blackboardsize()) && (blackboard[(vid) >> 8].Vid == (vid))) ? ((vid) >> 8) : -1)
+
+int read_bbvari_frame_typed_cs (int par_Number, const VID *par_Vids, const short *par_Types, void *ret_Buffer)
+{
+    int x, vid_index, size;
+    int pos = 0;
+
+    // Is blackboard exists here or inside the remote master or not at all
+    if (blackboard == NULL) {
+#ifndef REMOTE_MASTER
+        if (s_main_ini_val.ConnectToRemoteMaster) {
+            for (x = 0; x < par_Number; x++) {
+                if ((size = rm_read_bbvari_convert_to (par_Vids[x], par_Types[x], (union BB_VARI*)(void*)((char*)ret_Buffer + pos))) <= 0) {
+                    return -(x + 1);
+                }
+                pos += size;
+            }
+            return pos;
+        }
+#endif
+        return -1;
+    }
+    for (x = 0; x < par_Number; x++) {
+        union BB_VARI *dst = (union BB_VARI*)(void*)((char*)ret_Buffer + pos);
+        if ((vid_index = FRAME_VID_INDEX(par_Vids[x])) < 0) {
+            return -(x + 1);
+        }
+        if ((size = size_of_bbvari (par_Types[x])) <= 0) {
+            return -(x + 1);
+        }
+        if (BB_TYPE(vid_index) == par_Types[x]) {
+            // same data type no conversion necessary
+            switch (size) {
+            case 1: dst->ub = BB_VALUE(vid_index).ub; break;
+            case 2: dst->uw = BB_VALUE(vid_index).uw; break;
+            case 4: dst->udw = BB_VALUE(vid_index).udw; break;
+            case 8: dst->uqw = BB_VALUE(vid_index).uqw; break;
+            }
+        } else {
+            sc_convert_from_to (BB_TYPE(vid_index), &BB_VALUE(vid_index), par_Types[x], dst);
+        }
+        pos += size;
+    }
+    return pos;
+}
+
+int read_bbvari_frame_typed (int par_Number, const VID *par_Vids, const short *par_Types, void *ret_Buffer)
+{
+    int Ret;
+
+    if (blackboard == NULL) {
+        return read_bbvari_frame_typed_cs (par_Number, par_Vids, par_Types, ret_Buffer);
+    }
+    EnterBlackboardCriticalSection();
+    Ret = read_bbvari_frame_typed_cs (par_Number, par_Vids, par_Types, ret_Buffer);
+    LeaveBlackboardCriticalSection();
+    return Ret;
+}
+
+int write_bbvari_frame_typed_cs (PID par_Pid, int par_Number, const VID *par_Vids, const short *par_Types, const void *par_Buffer,
+                                 const uint32_t *par_SkipIfWrSeqs)
+{
+    int x, vid_index, pid_index, size;
+    uint64_t pid_mask;
+    int pos = 0;
+
+    // Is blackboard exists here or inside the remote master or not at all
+    if (blackboard == NULL) {
+#ifndef REMOTE_MASTER
+        if (s_main_ini_val.ConnectToRemoteMaster) {
+            for (x = 0; x < par_Number; x++) {
+                if ((par_SkipIfWrSeqs != NULL) && (rm_get_bbvari_wrseq (par_Vids[x]) != par_SkipIfWrSeqs[x])) {
+                    size = size_of_bbvari (par_Types[x]);
+                } else {
+                    size = rm_write_bbvari_convert_to (par_Pid, par_Vids[x], par_Types[x], (uint64_t*)(void*)((const char*)par_Buffer + pos));
+                }
+                if (size <= 0) {
+                    return -(x + 1);
+                }
+                pos += size;
+            }
+            return pos;
+        }
+#endif
+        return -1;
+    }
+    // Determine the process index (for access mask) only once for the whole frame
+    if ((pid_index = get_process_index (par_Pid)) < 0) {
+        pid_mask = 0;
+    } else {
+        pid_mask = 1ULL << pid_index;
+    }
+    for (x = 0; x < par_Number; x++) {
+        union BB_VARI *src = (union BB_VARI*)(void*)((const char*)par_Buffer + pos);
+        if (((vid_index = FRAME_VID_INDEX(par_Vids[x])) >= 0) &&
+            ((par_SkipIfWrSeqs == NULL) || (BB_WR_SEQ(vid_index) == par_SkipIfWrSeqs[x])) &&
+            (BB_ACCESS_FLAGS(vid_index) & blackboard[vid_index].WrEnableFlags & pid_mask)) {
+            if (BB_TYPE(vid_index) == par_Types[x]) {
+                // same data type no conversion necessary
+                switch (size = size_of_bbvari (par_Types[x])) {
+                case 1: BB_VALUE(vid_index).ub = src->ub; break;
+                case 2: BB_VALUE(vid_index).uw = src->uw; break;
+                case 4: BB_VALUE(vid_index).udw = src->udw; break;
+                case 8: BB_VALUE(vid_index).uqw = src->uqw; break;
+                }
+            } else {
+                size = sc_convert_from_to (par_Types[x], src, BB_TYPE(vid_index), &BB_VALUE(vid_index));
+            }
+            SET_BB_WRITTEN(vid_index);
+        } else {
+            size = size_of_bbvari (par_Types[x]);
+        }
+        if (size <= 0) {
+            return -(x + 1);
+        }
+        pos += size;
+    }
+    return pos;
+}
+
+int write_bbvari_frame_typed (PID par_Pid, int par_Number, const VID *par_Vids, const short *par_Types, const void *par_Buffer,
+                              const uint32_t *par_SkipIfWrSeqs)
+{
+    int Ret;
+
+    if (blackboard == NULL) {
+        return write_bbvari_frame_typed_cs (par_Pid, par_Number, par_Vids, par_Types, par_Buffer, par_SkipIfWrSeqs);
+    }
+    EnterBlackboardCriticalSection();
+    Ret = write_bbvari_frame_typed_cs (par_Pid, par_Number, par_Vids, par_Types, par_Buffer, par_SkipIfWrSeqs);
+    LeaveBlackboardCriticalSection();
+    return Ret;
+}
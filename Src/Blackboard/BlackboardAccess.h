@@ -112,6 +112,19 @@ int convert_textreplace_value (VID vid, char *txt, int64_t *pfrom, int64_t *pto)
 int read_bbvari_frame (VID *Vids, int8_t *PhysOrRaw, double *RetFrameValues, int Size);
 int write_bbvari_frame_pid (PID pid, VID *Vids, int8_t *PhysOrRaw, double *FrameValues, int Size);
 
+// Read or write par_Number variables with one blackboard lock. The values are packed without gaps
+// inside the buffer, each one with the data type par_Types[x] (converted from/to the blackboard data type).
+// write_bbvari_frame_typed skip a variable if its write sequence number is not par_SkipIfWrSeqs[x] anymore,
+// so it was written by somebody else in the meantime (NULL never skip).
+// Return the number of bytes read/written or -(x+1) if the variable x doesn't exist (only read) or par_Types[x] is invalid.
+// The _cs variants must be called inside the blackboard critical section.
+int read_bbvari_frame_typed (int par_Number, const VID *par_Vids, const short *par_Types, void *ret_Buffer);
+int read_bbvari_frame_typed_cs (int par_Number, const VID *par_Vids, const short *par_Types, void *ret_Buffer);
+int write_bbvari_frame_typed (PID par_Pid, int par_Number, const VID *par_Vids, const short *par_Types, const void *par_Buffer,
+                              const uint32_t *par_SkipIfWrSeqs);
+int write_bbvari_frame_typed_cs (PID par_Pid, int par_Number, const VID *par_Vids, const short *par_Types, const void *par_Buffer,
+                                 const uint32_t *par_SkipIfWrSeqs);
+
 int get_phys_value_for_raw_value (VID vid, double raw_value, double *ret_phys_value);
 int get_raw_value_for_phys_value (VID vid, double phys_value, double *ret_raw_value, double *ret_phys_value);
 
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+
+#include "MyMemory.h"
+#include "ThrowError.h"
+#include "Blackboard.h"
+#include "BlackboardAttachCounts.h"
+
+static int BitCount (uint64_t x)
+{
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+}
+
+// Position of a bit inside the inline counters
+#define INLINE_POS(Mask, PidIndex)  BitCount ((Mask) & ((1ULL << (PidIndex)) - 1))
+
+int GetAttachCount (const BB_ATTACH_COUNTS *par_Counts, int par_PidIndex)
+{
+    uint64_t Bit = 1ULL << par_PidIndex;
+    if ((par_Counts->Mask & Bit) == 0) return 0;
+    if (BitCount (par_Counts->Mask) > BB_ATTACH_COUNTS_INLINE) {
+        return par_Counts->Counts.All[par_PidIndex];
+    } else {
+        return par_Counts->Counts.Inline[INLINE_POS (par_Counts->Mask, par_PidIndex)];
+    }
+}
+
+int SetAttachCount (BB_ATTACH_COUNTS *par_Counts, int par_PidIndex, int par_Value)
+{
+    uint64_t Bit = 1ULL << par_PidIndex;
+    int Count = BitCount (par_Counts->Mask);
+    int x, p;
+
+    if (par_Counts->Mask & Bit) {
+        if (par_Value != 0) {
+            // change an existing counter
+            if (Count > BB_ATTACH_COUNTS_INLINE) par_Counts->Counts.All[par_PidIndex] = (uint16_t)par_Value;
+            else par_Counts->Counts.Inline[INLINE_POS (par_Counts->Mask, par_PidIndex)] = (uint16_t)par_Value;
+        } else if (Count == (BB_ATTACH_COUNTS_INLINE + 1)) {
+            // remove a counter, the remaining ones fit inline again
+            uint16_t *All = par_Counts->Counts.All;
+            par_Counts->Mask &= ~Bit;
+            for (x = p = 0; x < MAX_PROCESSES; x++) {
+                if (par_Counts->Mask & (1ULL << x)) par_Counts->Counts.Inline[p++] = All[x];
+            }
+            my_free (All);
+        } else if (Count > BB_ATTACH_COUNTS_INLINE) {
+            par_Counts->Counts.All[par_PidIndex] = 0;
+            par_Counts->Mask &= ~Bit;
+        } else {
+            p = INLINE_POS (par_Counts->Mask, par_PidIndex);
+            for (x = p; x < (Count - 1); x++) {
+                par_Counts->Counts.Inline[x] = par_Counts->Counts.Inline[x + 1];
+            }
+            par_Counts->Counts.Inline[Count - 1] = 0;
+            par_Counts->Mask &= ~Bit;
+        }
+    } else if (par_Value != 0) {
+        if (Count == BB_ATTACH_COUNTS_INLINE) {
+            // add a counter, the inline counters are not enough
+            uint16_t *All = (uint16_t*)my_calloc (MAX_PROCESSES, sizeof (uint16_t));
+            if (All == NULL) {
+                ThrowError (1, "out of memory cannot store attach counter of process index %i", par_PidIndex);
+                return -1;
+            }
+            for (x = p = 0; x < MAX_PROCESSES; x++) {
+                if (par_Counts->Mask & (1ULL << x)) All[x] = par_Counts->Counts.Inline[p++];
+            }
+            All[par_PidIndex] = (uint16_t)par_Value;
+            par_Counts->Counts.All = All;
+        } else if (Count > BB_ATTACH_COUNTS_INLINE) {
+            par_Counts->Counts.All[par_PidIndex] = (uint16_t)par_Value;
+        } else {
+            p = INLINE_POS (par_Counts->Mask, par_PidIndex);
+            for (x = Count; x > p; x--) {
+                par_Counts->Counts.Inline[x] = par_Counts->Counts.Inline[x - 1];
+            }
+            par_Counts->Counts.Inline[p] = (uint16_t)par_Value;
+        }
+        par_Counts->Mask |= Bit;
+    }
+    return 0;
+}
+
+int IncAttachCount (BB_ATTACH_COUNTS *par_Counts, int par_PidIndex)
+{
+    return SetAttachCount (par_Counts, par_PidIndex, (uint16_t)(GetAttachCount (par_Counts, par_PidIndex) + 1));
+}
+
+int DecAttachCount (BB_ATTACH_COUNTS *par_Counts, int par_PidIndex)
+{
+    int Value = GetAttachCount (par_Counts, par_PidIndex);
+    if (Value == 0) return 0;
+    SetAttachCount (par_Counts, par_PidIndex, Value - 1);
+    return 1;
+}
+
+void FreeAttachCounts (BB_ATTACH_COUNTS *par_Counts)
+{
+    if (BitCount (par_Counts->Mask) > BB_ATTACH_COUNTS_INLINE) {
+        my_free (par_Counts->Counts.All);
+    }
+    par_Counts->Mask = 0;
+    par_Counts->Counts.All = NULL;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef BLACKBOARDATTACHCOUNTS_H
+#define BLACKBOARDATTACHCOUNTS_H
+
+#include <stdint.h>
+
+// Sparse attach counters of one variable for all processes (max. 64).
+// Most variables are only attached by a few processes, so up to 4 counters are stored inline
+// in the order of the set bits of Mask. Only if more processes attach the variable, an array
+// with a counter for each process index will be allocated.
+#define BB_ATTACH_COUNTS_INLINE  4
+
+typedef struct {
+/*08*/  uint64_t Mask;       // bit x is set if process index x has a counter != 0
+        union {
+/*08*/      uint16_t Inline[BB_ATTACH_COUNTS_INLINE];
+            uint16_t *All;   // only if more than BB_ATTACH_COUNTS_INLINE bits of Mask are set
+        } Counts;
+} BB_ATTACH_COUNTS;  /* 16 bytes */
+
+int GetAttachCount (const BB_ATTACH_COUNTS *par_Counts, int par_PidIndex);
+// Returns 0 on success or -1 if there is no memory left
+int SetAttachCount (BB_ATTACH_COUNTS *par_Counts, int par_PidIndex, int par_Value);
+int IncAttachCount (BB_ATTACH_COUNTS *par_Counts, int par_PidIndex);
+// Returns 1 if the counter was != 0 before
+int DecAttachCount (BB_ATTACH_COUNTS *par_Counts, int par_PidIndex);
+void FreeAttachCounts (BB_ATTACH_COUNTS *par_Counts);
+
+#endif // BLACKBOARDATTACHCOUNTS_H
@@ -258,34 +258,157 @@ int Conv_OffsetFactorPhysToRawFromString(const char *par_ConvString, double par_
 }
 
 // Table interpol
-int Conv_TableInterpolRawToPhys(BB_VARIABLE_CONVERSION *par_Conversion, double par_RawValue,  double *ret_PhysValue)
+
+// Binary search and uniform grid lookup are only possible if the column is ascending,
+// otherwise the first point which is >= the value must be searched linear.
+static int TableColumnFlags(const double *par_Column, int par_Size, double *ret_Start, double *ret_InvStep,
+                            int par_AscendingFlag, int par_UniformFlag)
+{
+    int x;
+    double Step, Tolerance;
+
+    for (x = 1; x < par_Size; x++) {
+        // also stop if there are NaN values inside the table
+        if (!(par_Column[2*x] >= par_Column[2*(x-1)])) return 0;
+    }
+    if (par_Size < 3) return par_AscendingFlag;
+    Step = (par_Column[2*(par_Size-1)] - par_Column[0]) / (double)(par_Size - 1);
+    if (!(Step > 0.0) || !isfinite(Step)) return par_AscendingFlag;
+    Tolerance = Step * 1.0e-6;
+    for (x = 1; x < par_Size; x++) {
+        if (fabs(par_Column[2*x] - (par_Column[0] + Step * (double)x)) > Tolerance) {
+            return par_AscendingFlag;
+        }
+    }
+    *ret_Start = par_Column[0];
+    *ret_InvStep = 1.0 / Step;
+    return par_AscendingFlag | par_UniformFlag;
+}
+
+void Conv_TablePrepareLookup(BB_VARIABLE_CONVERSION *par_Conversion)
 {
-    int x, Size;
-    double m, RawDelta, PhysDelta;
-    struct CONVERSION_TABLE_VALUE_PAIR *Values;
+    int Size = par_Conversion->Conv.Table.Size;
+    struct CONVERSION_TABLE_VALUE_PAIR *Values = par_Conversion->Conv.Table.Values;
 
-    Size = par_Conversion->Conv.Table.Size;
-    Values = par_Conversion->Conv.Table.Values;
-    for (x = 0; x < Size; x++) {
-        if (Values[x].Raw >= par_RawValue) {
-            if (x == 0) {
-                *ret_PhysValue = Values[x].Phys;
-            } else {
-                RawDelta = Values[x].Raw - Values[x-1].Raw;
-                if ((RawDelta <= 0.0) && (RawDelta >= 0.0)) {  // == 0.0
-                    *ret_PhysValue = Values[x-1].Phys;  // use the smallest one
-                } else {
-                    PhysDelta = Values[x].Phys - Values[x-1].Phys;
-                    m = PhysDelta / RawDelta;
-                    *ret_PhysValue = Values[x-1].Phys + m * (par_RawValue - Values[x-1].Raw);
-                }
-            }
-            break;  // for(;;)
+    par_Conversion->Conv.Table.Flags = 0;
+    if ((Values == NULL) || (Size <= 0)) return;
+    par_Conversion->Conv.Table.Flags |= TableColumnFlags(&Values[0].Raw, Size,
+                                                         &par_Conversion->Conv.Table.RawStart,
+                                                         &par_Conversion->Conv.Table.RawInvStep,
+                                                         CONV_TABLE_RAW_ASCENDING, CONV_TABLE_RAW_UNIFORM);
+    par_Conversion->Conv.Table.Flags |= TableColumnFlags(&Values[0].Phys, Size,
+                                                         &par_Conversion->Conv.Table.PhysStart,
+                                                         &par_Conversion->Conv.Table.PhysInvStep,
+                                                         CONV_TABLE_PHYS_ASCENDING, CONV_TABLE_PHYS_UNIFORM);
+}
+
+// Returns the index of the first point of the column which is >= par_Value or par_Size if there is no one.
+// The column is either the raw or the phys member of the value pair table (stride are 2 doubles).
+static inline int TableColumnSearch(const double *par_Column, int par_Size, double par_Value,
+                                    int par_Flags, int par_AscendingFlag, int par_UniformFlag,
+                                    double par_Start, double par_InvStep)
+{
+    int x;
+    if ((par_Flags & par_UniformFlag) == par_UniformFlag) {
+        // O(1): calculate the index and correct rounding errors with the neighbours
+        if (!(par_Value > par_Column[0])) {
+            return (par_Value <= par_Column[0]) ? 0 : par_Size;  // NaN will return par_Size
+        }
+        if (par_Value > par_Column[2*(par_Size-1)]) {
+            return par_Size;
         }
+        x = (int)ceil((par_Value - par_Start) * par_InvStep);
+        if (x < 1) x = 1;
+        if (x > par_Size - 1) x = par_Size - 1;
+        while ((x > 0) && (par_Column[2*(x-1)] >= par_Value)) x--;
+        while ((x < par_Size) && !(par_Column[2*x] >= par_Value)) x++;
+        return x;
+    } else if ((par_Flags & par_AscendingFlag) == par_AscendingFlag) {
+        // branchless binary search
+        const double *Base = par_Column;
+        int n = par_Size;
+        if (n <= 0) return 0;
+        while (n > 1) {
+            int Half = n >> 1;
+            Base = (Base[2*Half] >= par_Value) ? Base : Base + 2*Half;
+            n -= Half;
+        }
+        return (int)((Base - par_Column) >> 1) + !(Base[0] >= par_Value);
+    } else {
+        for (x = 0; x < par_Size; x++) {
+            if (par_Column[2*x] >= par_Value) break;
+        }
+        return x;
     }
-    if (x == Size) {
-        *ret_PhysValue = Values[Size - 1].Phys;
+}
+
+static inline int TableSearchRaw(BB_VARIABLE_CONVERSION *par_Conversion, double par_RawValue)
+{
+    return TableColumnSearch(&par_Conversion->Conv.Table.Values[0].Raw, par_Conversion->Conv.Table.Size, par_RawValue,
+                             par_Conversion->Conv.Table.Flags, CONV_TABLE_RAW_ASCENDING, CONV_TABLE_RAW_UNIFORM,
+                             par_Conversion->Conv.Table.RawStart, par_Conversion->Conv.Table.RawInvStep);
+}
+
+static inline int TableSearchPhys(BB_VARIABLE_CONVERSION *par_Conversion, double par_PhysValue)
+{
+    return TableColumnSearch(&par_Conversion->Conv.Table.Values[0].Phys, par_Conversion->Conv.Table.Size, par_PhysValue,
+                             par_Conversion->Conv.Table.Flags, CONV_TABLE_PHYS_ASCENDING, CONV_TABLE_PHYS_UNIFORM,
+                             par_Conversion->Conv.Table.PhysStart, par_Conversion->Conv.Table.PhysInvStep);
+}
+
+static inline double TableRawToPhys(BB_VARIABLE_CONVERSION *par_Conversion, double par_RawValue, int par_Interpol)
+{
+    double m, RawDelta, PhysDelta;
+    struct CONVERSION_TABLE_VALUE_PAIR *Values = par_Conversion->Conv.Table.Values;
+    int Size = par_Conversion->Conv.Table.Size;
+    int x = TableSearchRaw(par_Conversion, par_RawValue);
+
+    if (x == 0) {
+        return Values[0].Phys;
+    } else if (x == Size) {
+        return Values[Size - 1].Phys;
+    } else if (par_Interpol) {
+        RawDelta = Values[x].Raw - Values[x-1].Raw;
+        if ((RawDelta <= 0.0) && (RawDelta >= 0.0)) {  // == 0.0
+            return Values[x-1].Phys;  // use the smallest one
+        } else {
+            PhysDelta = Values[x].Phys - Values[x-1].Phys;
+            m = PhysDelta / RawDelta;
+            return Values[x-1].Phys + m * (par_RawValue - Values[x-1].Raw);
+        }
+    } else {
+        return Values[x].Phys;
+    }
+}
+
+static inline double TablePhysToRaw(BB_VARIABLE_CONVERSION *par_Conversion, double par_PhysValue, int par_Interpol)
+{
+    double m, RawDelta, PhysDelta;
+    struct CONVERSION_TABLE_VALUE_PAIR *Values = par_Conversion->Conv.Table.Values;
+    int Size = par_Conversion->Conv.Table.Size;
+    int x = TableSearchPhys(par_Conversion, par_PhysValue);
+
+    if (x == 0) {
+        return Values[0].Raw;
+    } else if (x == Size) {
+        return Values[Size - 1].Raw;
+    } else if (par_Interpol) {
+        PhysDelta = Values[x].Phys - Values[x-1].Phys;
+        if ((PhysDelta <= 0.0) && (PhysDelta >= 0.0)) {  // == 0.0
+            return Values[x-1].Raw;  // use the smallest one
+        } else {
+            RawDelta = Values[x].Raw - Values[x-1].Raw;
+            m = RawDelta / PhysDelta;
+            return Values[x-1].Raw + m * (par_PhysValue - Values[x-1].Phys);
+        }
+    } else {
+        return Values[x].Raw;
     }
+}
+
+int Conv_TableInterpolRawToPhys(BB_VARIABLE_CONVERSION *par_Conversion, double par_RawValue,  double *ret_PhysValue)
+{
+    *ret_PhysValue = TableRawToPhys(par_Conversion, par_RawValue, 1);
     return 0;
 }
 
@@ -314,6 +437,7 @@ int Conv_ParseTableInterpolString(const char *par_ConvString, BB_VARIABLE_CONVER
     if ((*p == 0) && (x == Size)) {
         ret_Conv->Conv.Table.Size = Size;
         ret_Conv->Type = BB_CONV_TAB_INTP;
+        Conv_TablePrepareLookup(ret_Conv);
         return 0;
     } else {
         ret_Conv->Type = BB_CONV_NONE;
@@ -336,32 +460,7 @@ int Conv_TableInterpolRawToPhysFromString(const char *par_ConvString, double par
 
 int Conv_TableInterpolPhysToRaw(BB_VARIABLE_CONVERSION *par_Conversion, double par_PhysValue,  double *ret_RawValue)
 {
-    int x, Size;
-    double m, RawDelta, PhysDelta;
-    struct CONVERSION_TABLE_VALUE_PAIR *Values;
-
-    Size = par_Conversion->Conv.Table.Size;
-    Values = par_Conversion->Conv.Table.Values;
-    for (x = 0; x < Size; x++) {
-        if (Values[x].Phys >= par_PhysValue) {
-            if (x == 0) {
-                *ret_RawValue = Values[x].Raw;
-            } else {
-                PhysDelta = Values[x].Phys - Values[x-1].Phys;
-                if ((PhysDelta <= 0.0) && (PhysDelta >= 0.0)) {  // == 0.0
-                    *ret_RawValue = Values[x-1].Raw;  // use the smallest one
-                } else {
-                    RawDelta = Values[x].Raw - Values[x-1].Raw;
-                    m = RawDelta / PhysDelta;
-                    *ret_RawValue = Values[x-1].Raw + m * (par_PhysValue - Values[x-1].Phys);
-                }
-            }
-            break;  // for(;;)
-        }
-    }
-    if (x == Size) {
-        *ret_RawValue = Values[Size - 1].Raw;
-    }
+    *ret_RawValue = TablePhysToRaw(par_Conversion, par_PhysValue, 1);
     return 0;
 }
 
@@ -380,23 +479,10 @@ int Conv_TableInterpolPhysToRawFromString(const char *par_ConvString, double par
 // Table no interpol
 int Conv_TableNoInterpolRawToPhys(BB_VARIABLE_CONVERSION *par_Conversion, double par_RawValue,  double *ret_PhysValue)
 {
-    int x, Size;
-    double m, RawDelta, PhysDelta;
-    struct CONVERSION_TABLE_VALUE_PAIR *Values;
-
-    Size = par_Conversion->Conv.Table.Size;
-    Values = par_Conversion->Conv.Table.Values;
-    for (x = 0; x < Size; x++) {
-        if (Values[x].Raw >= par_RawValue) {
-            *ret_PhysValue = Values[x].Phys;
-            break;  // for(;;)
-        }
-    }
-    if (x == Size) {
-        *ret_PhysValue = Values[Size - 1].Phys;
-    }
+    *ret_PhysValue = TableRawToPhys(par_Conversion, par_RawValue, 0);
     return 0;
 }
+
 int Conv_ParseTableNoInterpolString(const char *par_ConvString, BB_VARIABLE_CONVERSION *ret_Conv)
 {
     int Ret;
@@ -419,21 +505,7 @@ int Conv_TableNoInterpolRawToPhysFromString(const char *par_ConvString, double p
 
 int Conv_TableNoInterpolPhysToRaw(BB_VARIABLE_CONVERSION *par_Conversion, double par_PhysValue,  double *ret_RawValue)
 {
-    int x, Size;
-    double m, RawDelta, PhysDelta;
-    struct CONVERSION_TABLE_VALUE_PAIR *Values;
-
-    Size = par_Conversion->Conv.Table.Size;
-    Values = par_Conversion->Conv.Table.Values;
-    for (x = 0; x < Size; x++) {
-        if (Values[x].Phys >= par_PhysValue) {
-            *ret_RawValue = Values[x].Raw;
-            break;  // for(;;)
-        }
-    }
-    if (x == Size) {
-        *ret_RawValue = Values[Size - 1].Raw;
-    }
+    *ret_RawValue = TablePhysToRaw(par_Conversion, par_PhysValue, 0);
     return 0;
 }
 
@@ -449,6 +521,26 @@ int Conv_TableNoInterpolPhysToRawFromString(const char *par_ConvString, double p
     return Ret;
 }
 
+// Table array conversion (interpol and no interpol)
+int Conv_TableRawToPhysArray(BB_VARIABLE_CONVERSION *par_Conversion, const double *par_RawValues, double *ret_PhysValues, int par_Count)
+{
+    int x;
+    switch (par_Conversion->Type) {
+    case BB_CONV_TAB_INTP:
+        for (x = 0; x < par_Count; x++) {
+            ret_PhysValues[x] = TableRawToPhys(par_Conversion, par_RawValues[x], 1);
+        }
+        return 0;
+    case BB_CONV_TAB_NOINTP:
+        for (x = 0; x < par_Count; x++) {
+            ret_PhysValues[x] = TableRawToPhys(par_Conversion, par_RawValues[x], 0);
+        }
+        return 0;
+    default:
+        return -1;
+    }
+}
+
 // Formula
 int Conv_FormulaRawToPhys(BB_VARIABLE_CONVERSION *par_Conversion, int par_Vid, double par_RawValue,  double *ret_PhysValue)
 {
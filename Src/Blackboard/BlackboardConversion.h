@@ -45,6 +45,14 @@ int Conv_OffsetFactorPhysToRaw(BB_VARIABLE_CONVERSION *par_Conversion, double pa
 int Conv_OffsetFactorPhysToRawFromString(const char *par_ConvString, double par_PhysValue,  double *ret_RawValue);
 
 // Table interpol
+#define CONV_TABLE_RAW_ASCENDING    0x1
+#define CONV_TABLE_RAW_UNIFORM      0x2
+#define CONV_TABLE_PHYS_ASCENDING   0x4
+#define CONV_TABLE_PHYS_UNIFORM     0x8
+// Must be called after the value pairs of a table conversion are filled. If the raw (phys) column
+// is ascending the lookup will use a binary search, if it is an uniform grid the index will be calculated directly.
+void Conv_TablePrepareLookup(BB_VARIABLE_CONVERSION *par_Conversion);
+
 int Conv_TableInterpolRawToPhys(BB_VARIABLE_CONVERSION *par_Conversion, double par_RawValue,  double *ret_PhysValue);
 int Conv_ParseTableInterpolString(const char *par_ConvString, BB_VARIABLE_CONVERSION *ret_Conv);
 int Conv_TableInterpolRawToPhysFromString(const char *par_ConvString, double par_RawValue,  double *ret_PhysValue);
@@ -60,6 +68,9 @@ int Conv_TableNoInterpolRawToPhysFromString(const char *par_ConvString, double p
 int Conv_TableNoInterpolPhysToRaw(BB_VARIABLE_CONVERSION *par_Conversion, double par_PhysValue,  double *ret_RawValue);
 int Conv_TableNoInterpolPhysToRawFromString(const char *par_ConvString, double par_PhysValue,  double *ret_RawValue);
 
+// Convert an array of raw values with a table conversion (interpol or no interpol)
+int Conv_TableRawToPhysArray(BB_VARIABLE_CONVERSION *par_Conversion, const double *par_RawValues, double *ret_PhysValues, int par_Count);
+
 // Formula
 int Conv_FormulaRawToPhys(BB_VARIABLE_CONVERSION *par_Conversion, int par_Vid, double par_RawValue, double *ret_PhysValue);
 int Conv_ParseFormulaString(const char *par_ConvString, const char *par_BlackboardVariableName,
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+
+#include "MemZeroAndCopy.h"
+#include "Blackboard.h"
+#include "BlackboardDeltaCoding.h"
+
+// A gap of this number of indexes (4 empty bitmap bytes) is more expensive than a new segment
+#define MAX_GAP_INSIDE_SEGMENT  32
+
+static uint8_t *PutVarUInt (uint8_t *p, uint32_t v)
+{
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static int SizeOfVarUInt (uint32_t v)
+{
+    int Size = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        Size++;
+    }
+    return Size;
+}
+
+static const uint8_t *GetVarUInt (const uint8_t *p, const uint8_t *End, uint32_t *ret_Value)
+{
+    uint32_t Value = 0;
+    int Shift;
+
+    for (Shift = 0; (p < End) && (Shift < 32); Shift += 7) {
+        uint8_t b = *p++;
+        Value |= (uint32_t)(b & 0x7F) << Shift;
+        if ((b & 0x80) == 0) {
+            *ret_Value = Value;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+static int ValueSize (int par_Type)
+{
+    // BB_DELTA_REMOVED_TYPE and all unknown types have no value
+    return GetDataTypeByteSize (par_Type);
+}
+
+int EncodeBlackboardDelta (const int32_t *par_Indexes, const uint8_t *par_Types, const union BB_VARI *par_Values,
+                           int par_Count, void *ret_Dst, int par_MaxLen, int *ret_Len)
+{
+    uint8_t *Dst = (uint8_t*)ret_Dst;
+    uint8_t *p = Dst;
+    int32_t SegmentEnd = 0;
+    int x = 0;
+
+    while (x < par_Count) {
+        int32_t First = par_Indexes[x];
+        int32_t Gap = First - SegmentEnd;
+        int BitmapBytes, Size, ValuesSize = 0;
+        int e;
+        uint8_t *Bitmap;
+
+        // Search the end of this segment
+        for (e = x; e < par_Count; e++) {
+            if ((e > x) && ((par_Indexes[e] - par_Indexes[e - 1]) >= MAX_GAP_INSIDE_SEGMENT)) break;
+            ValuesSize += 1 + ValueSize (par_Types[e]);
+        }
+        // Make it shorter if it doesn't fit
+        while (1) {
+            BitmapBytes = (par_Indexes[e - 1] - First) / 8 + 1;
+            Size = SizeOfVarUInt ((uint32_t)Gap) + SizeOfVarUInt ((uint32_t)BitmapBytes) + BitmapBytes + ValuesSize;
+            if ((int)(p - Dst) + Size <= par_MaxLen) break;
+            e--;
+            if (e == x) goto __OUT;
+            ValuesSize -= 1 + ValueSize (par_Types[e]);
+        }
+        p = PutVarUInt (p, (uint32_t)Gap);
+        p = PutVarUInt (p, (uint32_t)BitmapBytes);
+        Bitmap = p;
+        MEMSET (Bitmap, 0, (size_t)BitmapBytes);
+        p += BitmapBytes;
+        for (; x < e; x++) {
+            int Bit = par_Indexes[x] - First;
+            int Len = ValueSize (par_Types[x]);
+            Bitmap[Bit >> 3] |= (uint8_t)(1 << (Bit & 7));
+            *p++ = par_Types[x];
+            MEMCPY (p, &(par_Values[x]), (size_t)Len);
+            p += Len;
+        }
+        SegmentEnd = First + BitmapBytes * 8;
+    }
+__OUT:
+    *ret_Len = (int)(p - Dst);
+    return x;
+}
+
+int DecodeBlackboardDelta (const void *par_Src, int par_SrcLen,
+                           int32_t *ret_Indexes, uint8_t *ret_Types, union BB_VARI *ret_Values, int par_MaxCount)
+{
+    const uint8_t *p = (const uint8_t*)par_Src;
+    const uint8_t *End = p + par_SrcLen;
+    int64_t SegmentEnd = 0;
+    int Count = 0;
+
+    while (p < End) {
+        uint32_t Gap, BitmapBytes, b;
+        const uint8_t *Bitmap;
+        int64_t First;
+
+        if ((p = GetVarUInt (p, End, &Gap)) == NULL) return -1;
+        if ((p = GetVarUInt (p, End, &BitmapBytes)) == NULL) return -1;
+        if ((BitmapBytes == 0) || (BitmapBytes > (uint32_t)(End - p))) return -1;
+        First = SegmentEnd + Gap;
+        SegmentEnd = First + (int64_t)BitmapBytes * 8;
+        if (SegmentEnd > INT32_MAX) return -1;
+        Bitmap = p;
+        p += BitmapBytes;
+        for (b = 0; b < BitmapBytes; b++) {
+            uint8_t Bits = Bitmap[b];
+            int Bit;
+            for (Bit = 0; Bits != 0; Bit++, Bits >>= 1) {
+                int Size;
+                if ((Bits & 1) == 0) continue;
+                if ((Count >= par_MaxCount) || (p >= End)) return -1;
+                Size = ValueSize (*p);
+                if (Size > (int)(End - p) - 1) return -1;
+                ret_Indexes[Count] = (int32_t)(First + b * 8 + Bit);
+                ret_Types[Count] = *p++;
+                ret_Values[Count].uqw = 0;
+                MEMCPY (&(ret_Values[Count]), p, (size_t)Size);
+                p += Size;
+                Count++;
+            }
+        }
+    }
+    return Count;
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef BLACKBOARDDELTACODING_H
+#define BLACKBOARDDELTACODING_H
+
+#include <stdint.h>
+#include "Blackboard.h"
+
+// Coding of the changed blackboard values exchanged between XilEnv and the remote master
+// once per cycle (RM_BLACKBOARD_SYNC_VALUES_CMD).
+// A delta block is a sequence of segments, each segment is:
+//     variable length integer: distance of the first bit to the end of the segment before
+//     variable length integer: number of bitmap bytes
+//     bitmap, one bit for each blackboard index (vid >> 8)
+//     for each set bit: type byte followed by the value with the size of the type
+// Large gaps between the changed indexes will start a new segment so sparse changes
+// will not produce large bitmaps.
+
+// Marks a variable that doesn't exist anymore, no value will follow
+#define BB_DELTA_REMOVED_TYPE  0xFF
+
+// Encode the entries (par_Indexes must be strictly ascending). Stop if the block would become
+// larger than par_MaxLen. Return the number of entries stored, *ret_Len is the block size.
+int EncodeBlackboardDelta (const int32_t *par_Indexes, const uint8_t *par_Types, const union BB_VARI *par_Values,
+                           int par_Count, void *ret_Dst, int par_MaxLen, int *ret_Len);
+
+// Decode a block. Return the number of entries or -1 if the block is corrupt or contains
+// more than par_MaxCount entries.
+int DecodeBlackboardDelta (const void *par_Src, int par_SrcLen,
+                           int32_t *ret_Indexes, uint8_t *ret_Types, union BB_VARI *ret_Values, int par_MaxCount);
+
+#endif // BLACKBOARDDELTACODING_H
@@ -16,264 +16,235 @@
 
 
 #include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
 
 #include "MyMemory.h"
+#include "MemZeroAndCopy.h"
+#include "AtomicAccess.h"
 #include "ThrowError.h"
 
 #include "BlackboardHashIndex.h"
 
-typedef struct {
-    uint64_t Hash[512];
-    int32_t Indexes[512];
-    int32_t Pos;
-} HASH_INDEXES;
+// Open addressing hash table with robin hood insertion and backward shift deletion (no tombstones).
+// The table will not grow because the blackboard size is fixed, so it is sized for a max. load factor of 3/4.
+// Readers are lock-free: writers (inside the BlackboardCriticalSection) make the write sequence counter odd
+// during a modification and readers repeat their lookup if the counter has changed. Removed names are not freed
+// immediately, they are freed by a later writer if no reader is inside a lookup.
 
-typedef struct {
-    uint64_t Hash;
-    HASH_INDEXES *Indexes;
-} HASH_INDEXES_ELEM;
+typedef struct HASH_KEY {
+    struct HASH_KEY *Next;   // retire list
+    int32_t Index;           // blackboard index
+    int32_t Vid;             // VID of the variable (a key is never changed, it will be retired with the name)
+    char Name[1];
+} HASH_KEY;
 
 typedef struct {
-    HASH_INDEXES_ELEM *Elems;
-    int32_t Pos;
-    uint32_t Size;
-} MASTER_HASH_INDEXES;
+    uint32_t Tag;            // upper 32 bits of the hash code
+    uint32_t Dist;           // distance to the home slot + 1, 0 -> empty slot
+    HASH_KEY *Key;
+} HASH_SLOT;
 
-static MASTER_HASH_INDEXES MasterHashIndex;
+typedef struct {
+    HASH_SLOT *Slots;
+    uint32_t Mask;
+    uint32_t Count;
+    HASH_KEY *Retired;
+    uint32_t Sequence;       // odd while a writer modifies the slots
+    uint8_t Fill1[60];       // readers should not share the cache line with the write sequence counter
+    uint32_t ActiveReaders;
+} MASTER_HASH_INDEX;
+
+static MASTER_HASH_INDEX MasterHashIndex;
+static uint64_t HashSeed = 0x9E3779B97F4A7C15ULL;
 static int *FreeIndexes;
 static int FreeIndexesSize;
 static int FreeIndexesPos;
 
+// 64 bit murmur hash with a seed per process, so names can not collide by construction
 uint64_t BuildHashCode(const char* Name)
 {
-    uint64_t Ret = 0;
-    while (*Name != 0) {
-        Ret = Ret * 31 + (uint64_t)*Name++;
+    const uint64_t m = 0xC6A4A7935BD1E995ULL;
+    const int r = 47;
+    size_t Len = strlen(Name);
+    const unsigned char *p = (const unsigned char*)Name;
+    const unsigned char *End = p + (Len & ~(size_t)7);
+    uint64_t h = HashSeed ^ ((uint64_t)Len * m);
+    uint64_t k;
+
+    while (p < End) {
+        MEMCPY(&k, p, 8);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+        p += 8;
     }
-    return Ret;
-}
-
-static int32_t BinarySearchLowestMost1(uint64_t HashCode)
-{
-    int32_t l = 0;
-    int32_t r = (int32_t)MasterHashIndex.Pos;
-    while (l < r) {
-        int32_t m = (l + r) >> 1;
-        if (MasterHashIndex.Elems[m].Hash > HashCode) {
-            r = m;
-        } else {
-            l = m + 1;
-        }
+    k = 0;
+    switch (Len & 7) {
+    case 7: k ^= (uint64_t)p[6] << 48;  // fall through
+    case 6: k ^= (uint64_t)p[5] << 40;  // fall through
+    case 5: k ^= (uint64_t)p[4] << 32;  // fall through
+    case 4: k ^= (uint64_t)p[3] << 24;  // fall through
+    case 3: k ^= (uint64_t)p[2] << 16;  // fall through
+    case 2: k ^= (uint64_t)p[1] << 8;   // fall through
+    case 1: k ^= (uint64_t)p[0];
+        h ^= k;
+        h *= m;
+        break;
+    default:
+        break;
     }
-    return l - 1;  // return -1 if Value smaller than smallest inside Array
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
 }
 
-static int32_t BinarySearchLowestMost2(HASH_INDEXES *Elems, uint64_t HashCode)
+int SearchHashKey(const char *Name, uint64_t Hash, int32_t *ret_Vid)
 {
-    int32_t l = 0;
-    int32_t r = (int32_t)Elems->Pos;
-    while (l < r) {
-        int32_t m = (l + r) >> 1;
-        if (Elems->Hash[m] > HashCode) {
-            r = m;
-        } else {
-            l = m + 1;
+    uint32_t Tag = (uint32_t)(Hash >> 32);
+    uint32_t Seq, Pos, Dist;
+    int32_t Vid;
+    int Ret;
+
+    if (MasterHashIndex.Slots == NULL) return -1;
+    ATOMIC_FETCH_ADD_U32(&MasterHashIndex.ActiveReaders, 1);
+    ATOMIC_FENCE_SEQ_CST();
+    for (;;) {
+        Seq = ATOMIC_LOAD_ACQUIRE_U32(&MasterHashIndex.Sequence);
+        if (Seq & 1) continue;  // a writer is inside
+        Ret = -1;
+        Vid = -1;
+        Pos = (uint32_t)Hash & MasterHashIndex.Mask;
+        for (Dist = 1; Dist <= MasterHashIndex.Mask + 1; Dist++) {
+            volatile HASH_SLOT *Slot = &MasterHashIndex.Slots[Pos];
+            HASH_KEY *Key = Slot->Key;
+            // Robin hood: the key cannot be behind a slot which is nearer to its home slot
+            if ((Key == NULL) || (Slot->Dist < Dist)) break;
+            if ((Slot->Tag == Tag) && (strcmp(Key->Name, Name) == 0)) {
+                Ret = Key->Index;
+                Vid = Key->Vid;
+                break;
+            }
+            Pos = (Pos + 1) & MasterHashIndex.Mask;
         }
+        ATOMIC_FENCE_SEQ_CST();
+        if (ATOMIC_LOAD_ACQUIRE_U32(&MasterHashIndex.Sequence) == Seq) break;
     }
-    return l - 1;
+    ATOMIC_FENCE_SEQ_CST();
+    ATOMIC_FETCH_ADD_U32(&MasterHashIndex.ActiveReaders, (uint32_t)-1);
+    if (ret_Vid != NULL) *ret_Vid = Vid;
+    return Ret;
 }
 
-
-int BinaryHashSerchIndex (uint64_t Hash, int32_t *ret_p1, int32_t *ret_p2)
+static void BeginWrite(void)
 {
-    HASH_INDEXES *HashIndex;
-    int32_t p1, p2;
-
-    if (MasterHashIndex.Pos < 1) {
-        *ret_p1 = 0;
-        *ret_p2 = 0;
-        return -1;
-    }
-
-    p1 = BinarySearchLowestMost1(Hash);
-    if (p1 < 0) p1 = 0;
-    HashIndex = MasterHashIndex.Elems[p1].Indexes;
-    p2 = BinarySearchLowestMost2(HashIndex, Hash);
-    if (p2 < 0) p2 = 0;
-    *ret_p1 = p1;
-    *ret_p2 = p2;
-    if (Hash == HashIndex->Hash[p2]) {
-        return (int)HashIndex->Indexes[p2];
-    } else {
-        return -1;
-    }
+    ATOMIC_STORE_RELEASE_U32(&MasterHashIndex.Sequence, MasterHashIndex.Sequence + 1);
+    ATOMIC_FENCE_SEQ_CST();
 }
 
-int GetNextIndexBeforeSameHash (uint64_t Hash, int32_t *ret_p1, int32_t *ret_p2)
+static void EndWrite(void)
 {
-    HASH_INDEXES *HashIndex;
-    if (*ret_p2 > 0) {
-        // It is in the same block
-        *ret_p2 = *ret_p2 - 1;
-        HashIndex = MasterHashIndex.Elems[*ret_p1].Indexes;
-    } else {
-        // It is not inside the same block
-        *ret_p1 = *ret_p1 - 1;
-        HashIndex = MasterHashIndex.Elems[*ret_p1].Indexes;
-        *ret_p2 = HashIndex->Pos - 1;
-    }
-    if (HashIndex->Hash[*ret_p2] == Hash) {
-        return HashIndex->Indexes[*ret_p2];   // There exist a index before with the same hash code
-    } else {
-        return -1;
+    ATOMIC_STORE_RELEASE_U32(&MasterHashIndex.Sequence, MasterHashIndex.Sequence + 1);
+    ATOMIC_FENCE_SEQ_CST();
+    // A reader that starts now cannot see a retired key anymore
+    if ((MasterHashIndex.Retired != NULL) && (ATOMIC_LOAD_ACQUIRE_U32(&MasterHashIndex.ActiveReaders) == 0)) {
+        while (MasterHashIndex.Retired != NULL) {
+            HASH_KEY *Next = MasterHashIndex.Retired->Next;
+            my_free(MasterHashIndex.Retired);
+            MasterHashIndex.Retired = Next;
+        }
     }
 }
 
-int GetNextIndexBehindSameHash (uint64_t Hash, int32_t *ret_p1, int32_t *ret_p2)
+static HASH_KEY *NewHashKey(const char *Name, int32_t Index, int32_t Vid)
 {
-    HASH_INDEXES *HashIndex;
-    HashIndex = MasterHashIndex.Elems[*ret_p1].Indexes;
-    if (*ret_p2 < (HashIndex->Pos - 1)) {
-        // It is in the same block
-        *ret_p2 = *ret_p2 + 1;
-    } else {
-        // It is not inside the same block
-        *ret_p1 = *ret_p1 + 1;
-        if (*ret_p1 >= MasterHashIndex.Pos) return -1;     // last element
-        HashIndex = MasterHashIndex.Elems[*ret_p1].Indexes;
-        *ret_p2 = 0;
-    }
-    if (HashIndex->Hash[*ret_p2] == Hash) {
-        return HashIndex->Indexes[*ret_p2];   // There exist a index before with the same hash code
-    } else {
-        return -1;
-    }
+    size_t Len = strlen(Name);
+    HASH_KEY *Key = (HASH_KEY*)my_malloc(offsetof(HASH_KEY, Name) + Len + 1);
+    if (Key == NULL) return NULL;
+    Key->Next = NULL;
+    Key->Index = Index;
+    Key->Vid = Vid;
+    MEMCPY(Key->Name, Name, Len + 1);
+    return Key;
 }
 
-#define UNUSED(x) (void)(x)
-static void InsertHashIntoBlock(HASH_INDEXES* HashIndex, uint64_t Hash, int32_t Index, int32_t p1, int32_t p2)
+static void InsertSlot(uint64_t Hash, HASH_KEY *Key)
 {
-    UNUSED(p1);
-    int32_t x;
-    if ((p2 == 0) && (Hash < HashIndex->Hash[0])) {
-        for (x = HashIndex->Pos; x > 0; x--) {
-            HashIndex->Hash[x] = HashIndex->Hash[x-1];
-            HashIndex->Indexes[x] = HashIndex->Indexes[x-1];
+    HASH_SLOT Insert, Swap;
+    uint32_t Pos = (uint32_t)Hash & MasterHashIndex.Mask;
+
+    Insert.Tag = (uint32_t)(Hash >> 32);
+    Insert.Dist = 1;
+    Insert.Key = Key;
+    for (;;) {
+        HASH_SLOT *Slot = &MasterHashIndex.Slots[Pos];
+        if (Slot->Key == NULL) {
+            *Slot = Insert;
+            break;
         }
-        HashIndex->Hash[0] = Hash;
-        HashIndex->Indexes[0] = Index;
-    } else {
-        for (x = HashIndex->Pos; x > (p2+1); x--) {
-            HashIndex->Hash[x] = HashIndex->Hash[x-1];
-            HashIndex->Indexes[x] = HashIndex->Indexes[x-1];
+        // Take the slot from a key which is nearer to its home slot
+        if (Slot->Dist < Insert.Dist) {
+            Swap = *Slot;
+            *Slot = Insert;
+            Insert = Swap;
         }
-        HashIndex->Hash[p2+1] = Hash;
-        HashIndex->Indexes[p2+1] = Index;
+        Pos = (Pos + 1) & MasterHashIndex.Mask;
+        Insert.Dist++;
     }
-    HashIndex->Pos++;
+    MasterHashIndex.Count++;
 }
 
-int AddBinaryHashKey(uint64_t Hash, int32_t Index, int32_t p1, int32_t p2)
+int AddHashKey(const char *Name, uint64_t Hash, int32_t Index, int32_t Vid)
 {
-    HASH_INDEXES *HashIndex;
-    int32_t x, y;
-
-    if (MasterHashIndex.Pos == 0) {
-        // There exist no entry
-        HASH_INDEXES* NewHashBlock = my_malloc (sizeof(HASH_INDEXES));
-        if (NewHashBlock == NULL) return -1;
-        NewHashBlock->Hash[0] = Hash;
-        NewHashBlock->Indexes[0] = Index;
-        NewHashBlock->Pos = 1;
-        MasterHashIndex.Elems[0].Hash = Hash;
-        MasterHashIndex.Elems[0].Indexes = NewHashBlock;
-        MasterHashIndex.Pos = 1;
-    } else {
-        HashIndex = MasterHashIndex.Elems[p1].Indexes;
-        if (HashIndex->Pos < 512) {
-            // Fits inside noch rein
-            InsertHashIntoBlock(HashIndex, Hash, Index, p1, p2);
-        } else {
-            // Fit not inside -> setup a new hash block and spit the previous
-            HASH_INDEXES* NewHashBlock = my_malloc (sizeof(HASH_INDEXES));
-            if (NewHashBlock == NULL) return -1;
-            for (y = 0, x = HashIndex->Pos / 2; x < HashIndex->Pos; x++, y++) {
-                NewHashBlock->Hash[y] = HashIndex->Hash[x];
-                NewHashBlock->Indexes[y] = HashIndex->Indexes[x];
-            }
-            NewHashBlock->Pos = HashIndex->Pos = HashIndex->Pos / 2;
-
-            // insert the new block behind the existing one
-            for (x = MasterHashIndex.Pos; x > (p1+1) ; x--) {
-                MasterHashIndex.Elems[x].Hash = MasterHashIndex.Elems[x-1].Hash;
-                MasterHashIndex.Elems[x].Indexes = MasterHashIndex.Elems[x-1].Indexes;
-            }
-            MasterHashIndex.Elems[p1+1].Hash = NewHashBlock->Hash[0];
-            MasterHashIndex.Elems[p1+1].Indexes = NewHashBlock;
-            MasterHashIndex.Pos++;
-
-            if (p2 >= HashIndex->Pos) {
-                // add it to the new block
-                p2 -= HashIndex->Pos;
-                InsertHashIntoBlock(NewHashBlock, Hash, Index, p1, p2);
-            } else {
-                // add it to the existing block
-                InsertHashIntoBlock(HashIndex, Hash, Index, p1, p2);
-            }
-        }
-    }
+    HASH_KEY *Key;
+
+    if (MasterHashIndex.Count >= MasterHashIndex.Mask) return -1;
+    Key = NewHashKey(Name, Index, Vid);
+    if (Key == NULL) return -1;
+    BeginWrite();
+    InsertSlot(Hash, Key);
+    EndWrite();
     return 0;
 }
 
-void RemoveBinaryHashKey(int32_t p1, int32_t p2)
+int RemoveHashKey(uint64_t Hash, int32_t Index)
 {
-    HASH_INDEXES *HashIndex;
-    int32_t x, y;
-
-    HashIndex = MasterHashIndex.Elems[p1].Indexes;
-    for (x = p2; x < (HashIndex->Pos-1); x++) {
-        HashIndex->Hash[x] = HashIndex->Hash[x+1];
-        HashIndex->Indexes[x] = HashIndex->Indexes[x+1];
+    uint32_t Tag = (uint32_t)(Hash >> 32);
+    uint32_t Pos, Next, Dist;
+    HASH_KEY *Key;
+
+    if (MasterHashIndex.Slots == NULL) return -1;
+    Pos = (uint32_t)Hash & MasterHashIndex.Mask;
+    for (Dist = 1; ; Dist++) {
+        HASH_SLOT *Slot = &MasterHashIndex.Slots[Pos];
+        if ((Slot->Key == NULL) || (Slot->Dist < Dist)) return -1;
+        if ((Slot->Tag == Tag) && (Slot->Key->Index == Index)) break;
+        Pos = (Pos + 1) & MasterHashIndex.Mask;
     }
-    HashIndex->Pos--;
-
-    // If less than 16 entrys try to merge the hash tabele.
-    if (HashIndex->Pos < 16) {
-        if (p1 > 0) {
-            HASH_INDEXES *HashIndexBefore = MasterHashIndex.Elems[p1-1].Indexes;
-            if (HashIndexBefore->Pos < 256) {
-                for (y = HashIndexBefore->Pos, x = 0; x < HashIndex->Pos; y++, x++) {
-                    HashIndexBefore->Hash[y] = HashIndex->Hash[x];
-                    HashIndexBefore->Indexes[y] = HashIndex->Indexes[x];
-                }
-                HashIndexBefore->Pos = y;
-
-                my_free(HashIndex);
-                for(x = p1; x < (MasterHashIndex.Pos - 1); x++) {
-                    MasterHashIndex.Elems[x].Hash = MasterHashIndex.Elems[x + 1].Hash;
-                    MasterHashIndex.Elems[x].Indexes = MasterHashIndex.Elems[x + 1].Indexes;
-                }
-                MasterHashIndex.Pos--;
-            }
-        }
-    } else if (HashIndex->Pos < 256) {
-        if (p1 < (MasterHashIndex.Pos - 1)) {
-            HASH_INDEXES *HashIndexBehind = MasterHashIndex.Elems[p1+1].Indexes;
-            if (HashIndexBehind->Pos < 16) {
-                for (y = HashIndex->Pos, x = 0; x < HashIndexBehind->Pos; y++, x++) {
-                    HashIndex->Hash[y] = HashIndexBehind->Hash[x];
-                    HashIndex->Indexes[y] = HashIndexBehind->Indexes[x];
-                }
-                HashIndex->Pos = y;
-                my_free(HashIndexBehind);
-                for(x = p1+1; x < (MasterHashIndex.Pos - 1); x++) {
-                    MasterHashIndex.Elems[x].Hash = MasterHashIndex.Elems[x + 1].Hash;
-                    MasterHashIndex.Elems[x].Indexes = MasterHashIndex.Elems[x + 1].Indexes;
-                }
-                MasterHashIndex.Pos--;
-            }
-        }
+    Key = MasterHashIndex.Slots[Pos].Key;
+
+    BeginWrite();
+    // Shift the following keys back to fill the gap
+    for (;;) {
+        Next = (Pos + 1) & MasterHashIndex.Mask;
+        if ((MasterHashIndex.Slots[Next].Key == NULL) || (MasterHashIndex.Slots[Next].Dist <= 1)) break;
+        MasterHashIndex.Slots[Pos] = MasterHashIndex.Slots[Next];
+        MasterHashIndex.Slots[Pos].Dist--;
+        Pos = Next;
     }
+    MasterHashIndex.Slots[Pos].Key = NULL;
+    MasterHashIndex.Slots[Pos].Dist = 0;
+    MasterHashIndex.Slots[Pos].Tag = 0;
+    MasterHashIndex.Count--;
+    // Maybe a reader is just comparing this name
+    Key->Next = MasterHashIndex.Retired;
+    MasterHashIndex.Retired = Key;
+    EndWrite();
+    return 0;
 }
 
 int GetFreeBlackboardIndex(void)
@@ -297,11 +268,23 @@ void FreeBlackboardIndex(int Index)
 int InitMasterHashTable(int BlackboardSize)
 {
     int x;
-
-    MasterHashIndex.Size = 512;
-    MasterHashIndex.Pos = 0;
-    MasterHashIndex.Elems = (HASH_INDEXES_ELEM*)my_malloc(512 * sizeof(HASH_INDEXES_ELEM));
-    if (MasterHashIndex.Elems == NULL) return -1;
+    uint64_t Seed;
+    uint32_t Size = 64;
+
+    // max. load factor 3/4
+    while (Size < (uint32_t)BlackboardSize + (uint32_t)BlackboardSize / 3 + 1) Size <<= 1;
+    MasterHashIndex.Slots = (HASH_SLOT*)my_calloc(Size, sizeof(HASH_SLOT));
+    if (MasterHashIndex.Slots == NULL) return -1;
+    MasterHashIndex.Mask = Size - 1;
+    MasterHashIndex.Count = 0;
+    MasterHashIndex.Retired = NULL;
+
+    // splitmix64 of the start time and a (randomized) address
+    Seed = (uint64_t)time(NULL) ^ ((uint64_t)(uintptr_t)MasterHashIndex.Slots << 16);
+    Seed += 0x9E3779B97F4A7C15ULL;
+    Seed = (Seed ^ (Seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    Seed = (Seed ^ (Seed >> 27)) * 0x94D049BB133111EBULL;
+    HashSeed = Seed ^ (Seed >> 31);
 
     FreeIndexesSize = BlackboardSize;
     FreeIndexesPos = BlackboardSize;
@@ -316,13 +299,20 @@ int InitMasterHashTable(int BlackboardSize)
 
 int CloseMasterHashTable(void)
 {
-    int32_t x;
-    HASH_INDEXES_ELEM *e = MasterHashIndex.Elems;
-    for (x = 0; x < MasterHashIndex.Pos; x++) {
-        if (e->Indexes != NULL) my_free(e->Indexes);
+    uint32_t x;
+    if (MasterHashIndex.Slots != NULL) {
+        for (x = 0; x <= MasterHashIndex.Mask; x++) {
+            if (MasterHashIndex.Slots[x].Key != NULL) my_free(MasterHashIndex.Slots[x].Key);
+        }
+        my_free(MasterHashIndex.Slots);
+        MasterHashIndex.Slots = NULL;
+    }
+    while (MasterHashIndex.Retired != NULL) {
+        HASH_KEY *Next = MasterHashIndex.Retired->Next;
+        my_free(MasterHashIndex.Retired);
+        MasterHashIndex.Retired = Next;
     }
-    my_free(MasterHashIndex.Elems);
-    MasterHashIndex.Elems = NULL;
+    MasterHashIndex.Count = 0;
     my_free(FreeIndexes);
     FreeIndexes = NULL;
     return 0;
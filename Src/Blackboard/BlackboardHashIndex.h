@@ -22,13 +22,17 @@
 
 uint64_t BuildHashCode(const char* Name);
 
-int BinaryHashSerchIndex(uint64_t Hash, int32_t *ret_p1, int32_t *ret_p2);
-int GetNextIndexBeforeSameHash (uint64_t Hash, int32_t *ret_p1, int32_t *ret_p2);
-int GetNextIndexBehindSameHash (uint64_t Hash, int32_t *ret_p1, int32_t *ret_p2);
-
-int AddBinaryHashKey(uint64_t Hash, int32_t Index, int32_t p1, int32_t p2);
-
-void RemoveBinaryHashKey(int32_t p1, int32_t p2);
+// Lock-free, can be called without holding the BlackboardCriticalSection.
+// Returns the blackboard index of the variable or -1 if it don't exist.
+// ret_Vid (can be NULL) gets the VID which was stored together with the name, a lock-free
+// caller should use this instead of blackboard[index].Vid because the index can be reused in the meantime.
+int SearchHashKey(const char *Name, uint64_t Hash, int32_t *ret_Vid);
+
+// All following functions must be called inside the BlackboardCriticalSection.
+// The index stores its own copy of the name.
+int AddHashKey(const char *Name, uint64_t Hash, int32_t Index, int32_t Vid);
+// Returns 0 if the key was removed, -1 if it don't exist
+int RemoveHashKey(uint64_t Hash, int32_t Index);
 
 int GetFreeBlackboardIndex(void);
 void FreeBlackboardIndex(int Index);
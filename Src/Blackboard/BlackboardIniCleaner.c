@@ -30,6 +30,8 @@ int CleanVariablesSection (void)
 
     if (s_main_ini_val.ConnectToRemoteMaster) {
         rm_WriteBackVariableSectionCache();
+    } else {
+        flush_varinfos_to_ini();
     }
 
     while ((EntryIdx = IniFileDataBaseGetNextEntryName(EntryIdx, "Variables", Entry, sizeof(Entry), GetMainFileDescriptor())) >= 0) {
@@ -0,0 +1,270 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "MyMemory.h"
+#include "MemZeroAndCopy.h"
+#include "Wildcards.h"
+
+#include "BlackboardNameIndex.h"
+
+// Each blackboard index has a generation counter that will be incremented if the variable is removed.
+// An entry is only valid if its generation is equal to the generation of its blackboard index,
+// so removing a name is O(1) and the invalid entries are dropped with the next merge.
+
+typedef struct {
+    const char *Name;        // only valid if Generation == Generations[Index]
+    int32_t Index;           // blackboard index
+    uint32_t Generation;
+} NAME_INDEX_ENTRY;
+
+typedef struct {
+    NAME_INDEX_ENTRY *Entrys;     // sorted
+    int32_t Count;
+    int32_t Size;
+    int32_t RemovedCount;         // invalid entrys inside Entrys
+    NAME_INDEX_ENTRY *Pending;    // not sorted
+    int32_t PendingCount;
+    int32_t PendingSize;
+    uint32_t *Generations;
+    int32_t BlackboardSize;
+} NAME_INDEX;
+
+static NAME_INDEX NameIndex;
+
+#define MIN_PENDING_MERGE_SIZE  4096
+
+#define IS_VALID_ENTRY(e) ((e)->Generation == NameIndex.Generations[(e)->Index])
+
+// Case-insensitive order, if equal case-sensitive
+static int CompareNames(const char *par_Name1, const char *par_Name2)
+{
+    const unsigned char *p1 = (const unsigned char*)par_Name1;
+    const unsigned char *p2 = (const unsigned char*)par_Name2;
+    int c1, c2;
+
+    do {
+        c1 = tolower(*p1++);
+        c2 = tolower(*p2++);
+        if (c1 != c2) return c1 - c2;
+    } while (c1 != 0);
+    return strcmp(par_Name1, par_Name2);
+}
+
+static int CompareEntrys(const void *par_Entry1, const void *par_Entry2)
+{
+    return CompareNames(((const NAME_INDEX_ENTRY*)par_Entry1)->Name, ((const NAME_INDEX_ENTRY*)par_Entry2)->Name);
+}
+
+// Compare only the first par_Len characters of the name with the (lower case) prefix
+static int ComparePrefix(const char *par_Name, const char *par_LowerPrefix, int par_Len)
+{
+    const unsigned char *p1 = (const unsigned char*)par_Name;
+    const unsigned char *p2 = (const unsigned char*)par_LowerPrefix;
+    int x, c1;
+
+    for (x = 0; x < par_Len; x++) {
+        c1 = tolower(p1[x]);
+        if (c1 != p2[x]) return c1 - p2[x];   // also if the name is shorter than the prefix
+    }
+    return 0;
+}
+
+static int MergePendingNames(void)
+{
+    int32_t x, i, p, d;
+
+    // Drop all invalid entrys
+    if (NameIndex.RemovedCount > 0) {
+        for (x = d = 0; x < NameIndex.Count; x++) {
+            if (IS_VALID_ENTRY(&NameIndex.Entrys[x])) {
+                NameIndex.Entrys[d++] = NameIndex.Entrys[x];
+            }
+        }
+        NameIndex.Count = d;
+        NameIndex.RemovedCount = 0;
+    }
+    for (x = d = 0; x < NameIndex.PendingCount; x++) {
+        if (IS_VALID_ENTRY(&NameIndex.Pending[x])) {
+            NameIndex.Pending[d++] = NameIndex.Pending[x];
+        }
+    }
+    NameIndex.PendingCount = d;
+    if (NameIndex.PendingCount == 0) return 0;
+
+    if (NameIndex.Count + NameIndex.PendingCount > NameIndex.Size) {
+        int32_t NewSize = NameIndex.Count + NameIndex.PendingCount;
+        NAME_INDEX_ENTRY *NewEntrys;
+        NewSize += NewSize >> 2;
+        if (NewSize > NameIndex.BlackboardSize) NewSize = NameIndex.BlackboardSize;
+        NewEntrys = (NAME_INDEX_ENTRY*)my_realloc(NameIndex.Entrys, (size_t)NewSize * sizeof(NAME_INDEX_ENTRY));
+        if (NewEntrys == NULL) return -1;
+        NameIndex.Entrys = NewEntrys;
+        NameIndex.Size = NewSize;
+    }
+    qsort(NameIndex.Pending, (size_t)NameIndex.PendingCount, sizeof(NAME_INDEX_ENTRY), CompareEntrys);
+
+    // Merge from the end so no additional buffer is needed
+    i = NameIndex.Count - 1;
+    p = NameIndex.PendingCount - 1;
+    d = NameIndex.Count + NameIndex.PendingCount - 1;
+    while (p >= 0) {
+        if ((i >= 0) && (CompareEntrys(&NameIndex.Entrys[i], &NameIndex.Pending[p]) > 0)) {
+            NameIndex.Entrys[d--] = NameIndex.Entrys[i--];
+        } else {
+            NameIndex.Entrys[d--] = NameIndex.Pending[p--];
+        }
+    }
+    NameIndex.Count += NameIndex.PendingCount;
+    NameIndex.PendingCount = 0;
+    return 0;
+}
+
+int AddNameIndex(const char *par_Name, int32_t par_Index)
+{
+    NAME_INDEX_ENTRY *Entry;
+
+    if ((par_Index < 0) || (par_Index >= NameIndex.BlackboardSize)) return -1;
+    if (NameIndex.PendingCount >= NameIndex.PendingSize) {
+        // Merge instead of growing if there are a lot of not sorted names (or removed ones)
+        if ((NameIndex.PendingCount >= MIN_PENDING_MERGE_SIZE) &&
+            (NameIndex.PendingCount >= NameIndex.Count / 4)) {
+            if (MergePendingNames() != 0) return -1;
+        }
+        if (NameIndex.PendingCount >= NameIndex.PendingSize) {
+            int32_t NewSize = NameIndex.PendingSize + (NameIndex.PendingSize >> 1) + 256;
+            NAME_INDEX_ENTRY *NewPending = (NAME_INDEX_ENTRY*)my_realloc(NameIndex.Pending, (size_t)NewSize * sizeof(NAME_INDEX_ENTRY));
+            if (NewPending == NULL) return -1;
+            NameIndex.Pending = NewPending;
+            NameIndex.PendingSize = NewSize;
+        }
+    }
+    Entry = &NameIndex.Pending[NameIndex.PendingCount++];
+    Entry->Name = par_Name;
+    Entry->Index = par_Index;
+    Entry->Generation = NameIndex.Generations[par_Index];
+    return 0;
+}
+
+void RemoveNameIndex(int32_t par_Index)
+{
+    if ((par_Index < 0) || (par_Index >= NameIndex.BlackboardSize)) return;
+    // This invalidates all entrys of this index (sorted and pending ones)
+    NameIndex.Generations[par_Index]++;
+    NameIndex.RemovedCount++;
+}
+
+int SearchNameIndex(const char *par_Filter, int par_CaseSensitive, int32_t **ret_Indexes)
+{
+    char Prefix[512];
+    char LowerName[512];
+    char *LowerFilter = NULL;
+    int PrefixLen;
+    int32_t Low, High, Mid, x;
+    int32_t *Ret = NULL;
+    int32_t RetSize = 0;
+    int32_t RetCount = 0;
+    int Match;
+
+    *ret_Indexes = NULL;
+    if ((NameIndex.PendingCount > 0) || (NameIndex.RemovedCount > 0)) {
+        if (MergePendingNames() != 0) return -1;
+    }
+
+    // Literal prefix: all characters before the first wildcard
+    for (PrefixLen = 0; (par_Filter[PrefixLen] != 0) && (par_Filter[PrefixLen] != '*') && (par_Filter[PrefixLen] != '?') &&
+                        (PrefixLen < (int)sizeof(Prefix) - 1); PrefixLen++) {
+        Prefix[PrefixLen] = (char)tolower((unsigned char)par_Filter[PrefixLen]);
+    }
+    Prefix[PrefixLen] = 0;
+
+    if (!par_CaseSensitive) {
+        size_t Len = strlen(par_Filter) + 1;
+        LowerFilter = (char*)my_malloc(Len);
+        if (LowerFilter == NULL) return -1;
+        for (x = 0; x < (int32_t)Len; x++) {
+            LowerFilter[x] = (char)tolower((unsigned char)par_Filter[x]);
+        }
+    }
+
+    // First entry with a name >= prefix
+    Low = 0;
+    High = NameIndex.Count;
+    while (Low < High) {
+        Mid = Low + ((High - Low) >> 1);
+        if (ComparePrefix(NameIndex.Entrys[Mid].Name, Prefix, PrefixLen) < 0) Low = Mid + 1;
+        else High = Mid;
+    }
+
+    for (x = Low; x < NameIndex.Count; x++) {
+        const char *Name = NameIndex.Entrys[x].Name;
+        if (ComparePrefix(Name, Prefix, PrefixLen) != 0) break;   // behind the prefix range
+        if (par_CaseSensitive) {
+            Match = !Compare2StringsWithWildcardsAlwaysCaseSensitive(Name, par_Filter);
+        } else {
+            size_t Len = strlen(Name) + 1;
+            if (Len <= sizeof(LowerName)) {
+                size_t c;
+                for (c = 0; c < Len; c++) {
+                    LowerName[c] = (char)tolower((unsigned char)Name[c]);
+                }
+                Match = !Compare2StringsWithWildcardsAlwaysCaseSensitive(LowerName, LowerFilter);
+            } else {
+                Match = !Compare2StringsWithWildcardsCaseSensitive(Name, par_Filter, 0);
+            }
+        }
+        if (Match) {
+            if (RetCount >= RetSize) {
+                int32_t *NewRet;
+                RetSize = RetSize + (RetSize >> 1) + 128;
+                NewRet = (int32_t*)my_realloc(Ret, (size_t)RetSize * sizeof(int32_t));
+                if (NewRet == NULL) {
+                    if (Ret != NULL) my_free(Ret);
+                    if (LowerFilter != NULL) my_free(LowerFilter);
+                    return -1;
+                }
+                Ret = NewRet;
+            }
+            Ret[RetCount++] = NameIndex.Entrys[x].Index;
+        }
+    }
+    if (LowerFilter != NULL) my_free(LowerFilter);
+    *ret_Indexes = Ret;
+    return RetCount;
+}
+
+int InitBlackboardNameIndex(int BlackboardSize)
+{
+    MEMSET(&NameIndex, 0, sizeof(NameIndex));
+    NameIndex.Generations = (uint32_t*)my_calloc((size_t)BlackboardSize, sizeof(uint32_t));
+    if (NameIndex.Generations == NULL) return -1;
+    NameIndex.BlackboardSize = BlackboardSize;
+    return 0;
+}
+
+void CloseBlackboardNameIndex(void)
+{
+    if (NameIndex.Entrys != NULL) my_free(NameIndex.Entrys);
+    if (NameIndex.Pending != NULL) my_free(NameIndex.Pending);
+    if (NameIndex.Generations != NULL) my_free(NameIndex.Generations);
+    MEMSET(&NameIndex, 0, sizeof(NameIndex));
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef BB_NAME_INDEX_H
+#define BB_NAME_INDEX_H
+
+#include <stdint.h>
+
+// Sorted index over all blackboard variable names for prefix and wildcard searches.
+// The names are sorted case-insensitive so the literal prefix of a filter (all characters before
+// the first '*' or '?') selects one continuous range for case-sensitive and case-insensitive filters.
+// New names are collected unsorted and merged into the sorted array with the next search.
+// All functions must be called inside the BlackboardCriticalSection.
+
+int InitBlackboardNameIndex(int BlackboardSize);
+void CloseBlackboardNameIndex(void);
+
+// par_Name must be valid until RemoveNameIndex() is called for this index
+int AddNameIndex(const char *par_Name, int32_t par_Index);
+void RemoveNameIndex(int32_t par_Index);
+
+// Returns the number of matching names or -1 if there is no memory left. *ret_Indexes contains the
+// blackboard indexes sorted by name, it must be freed with my_free() (NULL if nothing was found).
+int SearchNameIndex(const char *par_Filter, int par_CaseSensitive, int32_t **ret_Indexes);
+
+#endif // BB_NAME_INDEX_H
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+
+#include "Platform.h"
+#include "MyMemory.h"
+#include "AtomicAccess.h"
+#include "Blackboard.h"
+#include "BlackboardObservationQueue.h"
+
+
+// Each entry is the blackboard index + 1, 0 marks an empty (or not yet published) entry
+static uint32_t *QueueEntries;
+static uint32_t QueueMask;
+static uint32_t QueueWritePos;   // will be incremented by all writers
+static uint32_t QueueReadPos;    // only used by the reader
+
+int InitBlackboardObservationQueue (int par_BlackboardSize)
+{
+    uint32_t Size;
+
+    if (QueueEntries != NULL) return 0;
+    // One more entry as variables so a writer will never reach an entry that is not read
+    for (Size = 64; Size <= (uint32_t)par_BlackboardSize; Size <<= 1);
+    QueueWritePos = 0;
+    QueueReadPos = 0;
+    QueueMask = Size - 1;
+    QueueEntries = (uint32_t*)my_calloc (Size, sizeof (uint32_t));
+    if (QueueEntries == NULL) return -1;
+    return 0;
+}
+
+void CloseBlackboardObservationQueue (void)
+{
+    if (QueueEntries != NULL) {
+        my_free (QueueEntries);
+        QueueEntries = NULL;
+    }
+}
+
+void PushValueChangedObservation (int par_VidIndex)
+{
+    uint32_t Pos;
+
+    // Already inside the queue and not read till now?
+    if (ATOMIC_EXCHANGE_U32 (&(blackboard[par_VidIndex].ObservationPending), 1) != 0) return;
+    if (QueueEntries == NULL) return;
+    Pos = ATOMIC_FETCH_ADD_U32 (&QueueWritePos, 1);
+    ATOMIC_STORE_RELEASE_U32 (&(QueueEntries[Pos & QueueMask]), (uint32_t)par_VidIndex + 1);
+}
+
+int PopValueChangedObservations (VID *ret_Vids, uint32_t *ret_ObservationData, int par_MaxCount)
+{
+    int Count = 0;
+
+    if (QueueEntries == NULL) return 0;
+    while (Count < par_MaxCount) {
+        uint32_t *Entry = &(QueueEntries[QueueReadPos & QueueMask]);
+        uint32_t Value = ATOMIC_LOAD_ACQUIRE_U32 (Entry);
+        int Index;
+        if (Value == 0) break;   // empty or a writer is just inside PushValueChangedObservation, will be read next time
+        *Entry = 0;
+        QueueReadPos++;
+        Index = (int)Value - 1;
+        // From now on the next write will push this variable again
+        ATOMIC_STORE_SEQ_CST_U32 (&(blackboard[Index].ObservationPending), 0);
+        if ((blackboard[Index].Vid > 0) &&
+            ((BB_OBSERVATION_FLAGS(Index) & OBSERVE_VALUE_CHANGED) == OBSERVE_VALUE_CHANGED) &&
+            (blackboard[Index].pAdditionalInfos != NULL)) {
+            ret_Vids[Count] = blackboard[Index].Vid;
+            ret_ObservationData[Count] = blackboard[Index].pAdditionalInfos->ObservationData;
+            Count++;
+        }
+    }
+    return Count;
+}
+
+int IsValueChangedObservationAvailable (void)
+{
+    return (blackboard != NULL);
+}
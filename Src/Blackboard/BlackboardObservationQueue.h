@@ -0,0 +1,48 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef BLACKBOARDOBSERVATIONQUEUE_H
+#define BLACKBOARDOBSERVATIONQUEUE_H
+
+#include <stdint.h>
+#include "GlobalDataTypes.h"
+
+// Queue of value changed notifications (OBSERVE_VALUE_CHANGED).
+// All writers to the blackboard push the index of a written variable if it is observed,
+// only one thread (the GUI) pops the notifications cyclic.
+// A variable is only once inside the queue (BB_VARIABLE.ObservationPending), so multiple
+// writes between two pops are coalesced and the queue can never overflow because
+// it has more entries than the blackboard variables.
+// Pushing is lock-free, it will not touch the blackboard critical section.
+
+// Must be called (with the blackboard critical section) before the first variable will be
+// observed with OBSERVE_VALUE_CHANGED. Return 0 on success
+int InitBlackboardObservationQueue (int par_BlackboardSize);
+void CloseBlackboardObservationQueue (void);
+
+// Should only be called by SET_BB_WRITTEN()
+void PushValueChangedObservation (int par_VidIndex);
+
+// Return the number of notifications copied into ret_Vids/ret_ObservationData
+// (max. par_MaxCount). Notifications of variables which are not observed anymore are skipped.
+int PopValueChangedObservations (VID *ret_Vids, uint32_t *ret_ObservationData, int par_MaxCount);
+
+// Value changed notifications are only possible if the blackboard is inside this process
+// (not if connected to a remote master). Otherwise the values must be polled.
+int IsValueChangedObservationAvailable (void);
+
+#endif // BLACKBOARDOBSERVATIONQUEUE_H
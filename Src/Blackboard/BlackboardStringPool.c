@@ -0,0 +1,221 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef REMOTE_MASTER
+#include "RemoteMasterLock.h"
+#else
+#include "Platform.h"
+#endif
+#include "MyMemory.h"
+#include "MemZeroAndCopy.h"
+
+#include "BlackboardStringPool.h"
+
+#ifdef REMOTE_MASTER
+static REMOTE_MASTER_LOCK StringPoolCriticalSection;
+#define InitializeCriticalSection(x) RemoteMasterInitLock(x)
+#define EnterCriticalSection(x)  RemoteMasterLock(x, __LINE__, __FILE__)
+#define LeaveCriticalSection(x)  RemoteMasterUnlock(x)
+#else
+static CRITICAL_SECTION StringPoolCriticalSection;
+#endif
+static int IsStringPoolInitialized;
+
+// Shared strings (units, conversions) with a reference counter
+typedef struct SHARED_STRING {
+    struct SHARED_STRING *Next;
+    uint32_t Hash;
+    uint32_t RefCount;
+    char String[1];
+} SHARED_STRING;
+
+static SHARED_STRING **SharedStrings;
+static uint32_t SharedStringsMask;
+static uint32_t SharedStringsCount;
+
+// Names are stored one behind the other inside blocks, in front of each name is the offset
+// to the block start. A block will be freed if all its names are freed.
+#define NAME_BLOCK_SIZE  (16 * 1024)
+
+typedef struct NAME_BLOCK {
+    struct NAME_BLOCK *Next;
+    struct NAME_BLOCK *Prev;
+    uint32_t Pos;
+    uint32_t NameCount;       // number of not freed names inside this block
+    char Data[NAME_BLOCK_SIZE];
+} NAME_BLOCK;
+
+static NAME_BLOCK *NameBlocks;   // the first one is the actual block
+
+void InitBlackboardStringPool (void)
+{
+    if (!IsStringPoolInitialized) {
+        InitializeCriticalSection (&StringPoolCriticalSection);
+        IsStringPoolInitialized = 1;
+    }
+}
+
+static uint32_t SharedStringHash (const char *par_String)
+{
+    uint32_t Hash = 2166136261U;   // FNV-1a
+    while (*par_String != 0) {
+        Hash = (Hash ^ (uint8_t)*par_String++) * 16777619U;
+    }
+    return Hash;
+}
+
+static int ResizeSharedStrings (uint32_t par_Size)
+{
+    SHARED_STRING **New;
+    uint32_t x;
+
+    New = (SHARED_STRING**)my_calloc (par_Size, sizeof (SHARED_STRING*));
+    if (New == NULL) return -1;
+    if (SharedStrings != NULL) {
+        for (x = 0; x <= SharedStringsMask; x++) {
+            SHARED_STRING *s = SharedStrings[x];
+            while (s != NULL) {
+                SHARED_STRING *Next = s->Next;
+                s->Next = New[s->Hash & (par_Size - 1)];
+                New[s->Hash & (par_Size - 1)] = s;
+                s = Next;
+            }
+        }
+        my_free (SharedStrings);
+    }
+    SharedStrings = New;
+    SharedStringsMask = par_Size - 1;
+    return 0;
+}
+
+char *AddSharedString (const char *par_String)
+{
+    uint32_t Hash = SharedStringHash (par_String);
+    SHARED_STRING *s;
+    size_t Len;
+    char *Ret = NULL;
+
+    EnterCriticalSection (&StringPoolCriticalSection);
+    if (SharedStrings == NULL) {
+        if (ResizeSharedStrings (256)) goto __OUT;
+    }
+    for (s = SharedStrings[Hash & SharedStringsMask]; s != NULL; s = s->Next) {
+        if ((s->Hash == Hash) && (strcmp (s->String, par_String) == 0)) {
+            s->RefCount++;
+            Ret = s->String;
+            goto __OUT;
+        }
+    }
+    Len = strlen (par_String) + 1;
+    s = (SHARED_STRING*)my_malloc (offsetof (SHARED_STRING, String) + Len);
+    if (s == NULL) goto __OUT;
+    s->Hash = Hash;
+    s->RefCount = 1;
+    MEMCPY (s->String, par_String, Len);
+    s->Next = SharedStrings[Hash & SharedStringsMask];
+    SharedStrings[Hash & SharedStringsMask] = s;
+    SharedStringsCount++;
+    if (SharedStringsCount > SharedStringsMask) {
+        ResizeSharedStrings ((SharedStringsMask + 1) << 1);  // if this fails the lists are only longer
+    }
+    Ret = s->String;
+__OUT:
+    LeaveCriticalSection (&StringPoolCriticalSection);
+    return Ret;
+}
+
+void ReleaseSharedString (const char *par_String)
+{
+    SHARED_STRING *s, **pp;
+
+    if (par_String == NULL) return;
+    s = (SHARED_STRING*)(void*)(par_String - offsetof (SHARED_STRING, String));
+    EnterCriticalSection (&StringPoolCriticalSection);
+    s->RefCount--;
+    if (s->RefCount == 0) {
+        for (pp = &SharedStrings[s->Hash & SharedStringsMask]; *pp != NULL; pp = &(*pp)->Next) {
+            if (*pp == s) {
+                *pp = s->Next;
+                SharedStringsCount--;
+                break;
+            }
+        }
+        my_free (s);
+    }
+    LeaveCriticalSection (&StringPoolCriticalSection);
+}
+
+char *AllocNameString (const char *par_Name)
+{
+    size_t Len = strlen (par_Name) + 1;
+    uint32_t Pos = 0, Need;
+    NAME_BLOCK *Block;
+    char *Ret = NULL;
+
+    Need = (uint32_t)(sizeof (uint32_t) + Len);
+    if (Need > NAME_BLOCK_SIZE) return NULL;
+    EnterCriticalSection (&StringPoolCriticalSection);
+    Block = NameBlocks;
+    if (Block != NULL) {
+        Pos = (Block->Pos + 3) & ~3U;  // the offset in front of the name should be aligned
+    }
+    if ((Block == NULL) || ((Pos + Need) > NAME_BLOCK_SIZE)) {
+        Block = (NAME_BLOCK*)my_malloc (sizeof (NAME_BLOCK));
+        if (Block == NULL) goto __OUT;
+        Block->Prev = NULL;
+        Block->Next = NameBlocks;
+        if (NameBlocks != NULL) NameBlocks->Prev = Block;
+        NameBlocks = Block;
+        Block->NameCount = 0;
+        Pos = 0;
+    }
+    *(uint32_t*)(void*)(Block->Data + Pos) = (uint32_t)(offsetof (NAME_BLOCK, Data) + Pos);
+    Ret = Block->Data + Pos + sizeof (uint32_t);
+    MEMCPY (Ret, par_Name, Len);
+    Block->Pos = Pos + Need;
+    Block->NameCount++;
+__OUT:
+    LeaveCriticalSection (&StringPoolCriticalSection);
+    return Ret;
+}
+
+void FreeNameString (const char *par_Name)
+{
+    uint32_t *Offset;
+    NAME_BLOCK *Block;
+
+    if (par_Name == NULL) return;
+    Offset = (uint32_t*)(void*)(par_Name - sizeof (uint32_t));
+    Block = (NAME_BLOCK*)(void*)((char*)Offset - *Offset);
+    EnterCriticalSection (&StringPoolCriticalSection);
+    Block->NameCount--;
+    if (Block->NameCount == 0) {
+        if (Block == NameBlocks) {
+            Block->Pos = 0;   // the actual block can be reused from the beginning
+        } else {
+            // It is not the first one so there is always a block before
+            Block->Prev->Next = Block->Next;
+            if (Block->Next != NULL) Block->Next->Prev = Block->Prev;
+            my_free (Block);
+        }
+    }
+    LeaveCriticalSection (&StringPoolCriticalSection);
+}
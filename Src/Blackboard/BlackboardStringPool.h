@@ -0,0 +1,41 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef BLACKBOARDSTRINGPOOL_H
+#define BLACKBOARDSTRINGPOOL_H
+
+#include <stdint.h>
+
+// Storage of the strings of the blackboard variable infos.
+// Units and conversions are shared between all variables with the same text (reference counted),
+// they must never be changed in place. The variable names are unique and will be stored
+// inside large blocks without an own allocation for each name.
+// All functions have an own lock and can be used without the blackboard critical section.
+
+void InitBlackboardStringPool (void);
+
+// Returns NULL if there is no memory left
+char *AddSharedString (const char *par_String);
+// par_String can be NULL
+void ReleaseSharedString (const char *par_String);
+
+// Returns NULL if there is no memory left
+char *AllocNameString (const char *par_Name);
+// par_Name can be NULL
+void FreeNameString (const char *par_Name);
+
+#endif // BLACKBOARDSTRINGPOOL_H
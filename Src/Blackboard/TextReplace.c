@@ -670,3 +670,221 @@ int GetEnumListSize (char *conversion)
     }
     return ret;
 }
+
+
+// Precompiled text replace
+// The conversion string will be parsed once (if it is set to a blackboard variable) into a range table
+// sorted by the values and a hash table to find the text. The parser follows exactly the rules of
+// convert_value2textreplace() and convert_textreplace2value(), the text replace entries behind a syntax
+// error are not included but the error is remembered.
+
+typedef struct {
+    int64_t From;
+    int64_t To;
+    int64_t Low;                // smallest and largest matching value
+    int64_t High;
+    int32_t Color;
+    int DisplayText;            // offset inside Texts without a RGB() macro (convert_value2textreplace)
+    int CompareText;            // offset inside Texts used by convert_textreplace2value
+} TEXT_REPLACE_ENTRY;
+
+struct TEXT_REPLACE_TABLE {
+    int Count;
+    int HasError;               // there is a syntax error behind the last entry
+    int ColorAtEndValid;        // a color will be returned if no entry matches
+    int32_t ColorAtEnd;
+    int Text2ValueNotPossible;  // a RGB() macro which will be handled different by convert_textreplace2value()
+    int HashSize;               // power of 2
+    int *Hash;                  // entry index + 1, 0 are unused
+    TEXT_REPLACE_ENTRY *Entries;
+    char *Texts;
+};
+
+static uint32_t TextReplaceHash (const char *txt)
+{
+    uint32_t h = 2166136261u;
+    while (*txt != 0) {
+        h ^= (unsigned char)*txt++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+struct TEXT_REPLACE_TABLE *TextReplaceCompile (const char *conversion)
+{
+    int64_t from, to = 0, to_old;
+    char *endp;
+    const char *c, *txt_start, *txt_end, *display_start, *p;
+    int32_t color;
+    int x, Count, MaxCount = 1, HashSize, TextsSize, compare_skip;
+    struct TEXT_REPLACE_TABLE *Ret;
+    char *t;
+
+    if (conversion == NULL) return NULL;
+    // an upper limit of the entrys and the text size
+    for (c = conversion; *c != 0; c++) {
+        if (*c == ';') MaxCount++;
+    }
+    TextsSize = (int)(c - conversion) + 1;
+    for (HashSize = 4; HashSize < 2 * MaxCount; HashSize <<= 1);
+    Ret = (struct TEXT_REPLACE_TABLE*)my_calloc (1, sizeof (struct TEXT_REPLACE_TABLE) +
+                                                 (size_t)MaxCount * sizeof (TEXT_REPLACE_ENTRY) +
+                                                 (size_t)HashSize * sizeof (int) + (size_t)TextsSize);
+    if (Ret == NULL) return NULL;
+    Ret->Entries = (TEXT_REPLACE_ENTRY*)(Ret + 1);
+    Ret->Hash = (int*)(Ret->Entries + MaxCount);
+    Ret->Texts = (char*)(Ret->Hash + HashSize);
+    Ret->HashSize = HashSize;
+    t = Ret->Texts;
+    Count = 0;
+
+    c = conversion;
+    while (*c != '\0') {
+        to_old = to;
+        c = remove_whitespace (c);
+
+        /* From */
+        if (*c == '*') {
+            c++;
+            from = INT64_MIN;
+        } else {
+            from = strtoll (c, &endp, 0);
+            if (c == endp) goto ERROR_LABEL;
+            c = endp;
+        }
+        c = remove_whitespace (c);
+
+        /* To */
+        if (*c == '*') {
+            c++;
+            to = INT64_MAX;
+        } else {
+            to = strtoll (c, &endp, 0);
+            if (c == endp) goto ERROR_LABEL;
+            c = endp;
+        }
+
+        /* Check if the ranges overlap */
+        if ((Count && ((from == to) ? (to_old >= from) : (to_old > from))) || (from > to)) {
+            goto ERROR_LABEL;
+        }
+        c = remove_whitespace (c);
+
+        /* Text */
+        if (*c != '\"') goto ERROR_LABEL;
+        c++;
+        txt_start = c;
+        // convert_textreplace2value() will only jump to the first ')' without checking the RGB() macro
+        compare_skip = 0;
+        if (!strncmp ("RGB(", txt_start, 4)) {
+            for (p = txt_start + 4; (*p != ')') && (*p != '\"') && (*p != ';') && (*p != '\0'); p++);
+            if (*p == ')') {
+                compare_skip = (int)(p + 1 - txt_start);
+            } else {
+                Ret->Text2ValueNotPossible = 1;
+            }
+        }
+        display_start = GetRGBMacroValue (c, &color);
+        // the color of the last parsed entry will be returned by convert_value2textreplace() if nothing matches
+        Ret->ColorAtEnd = color;
+        Ret->ColorAtEndValid = 1;
+        for (txt_end = display_start; *txt_end != '\"'; txt_end++) {
+            if ((*txt_end == '\0') || (*txt_end == ';')) goto ERROR_LABEL;
+        }
+        if ((txt_end[1] != ';') && (txt_end[1] != '\0')) goto ERROR_LABEL;
+
+        Ret->Entries[Count].From = from;
+        Ret->Entries[Count].To = to;
+        Ret->Entries[Count].Low = from;
+        Ret->Entries[Count].High = (from == to) ? to : to - 1;
+        Ret->Entries[Count].Color = color;
+        MEMCPY (t, txt_start, (size_t)(txt_end - txt_start));
+        Ret->Entries[Count].DisplayText = (int)(t - Ret->Texts) + (int)(display_start - txt_start);
+        Ret->Entries[Count].CompareText = (int)(t - Ret->Texts);
+        t += txt_end - txt_start;
+        *t++ = 0;
+        if (compare_skip > 0) Ret->Entries[Count].CompareText += compare_skip;
+        Count++;
+
+        c = txt_end + 1;     /* Afterwards jump over '\"' character */
+        if (*c != '\0') c++;
+        c = remove_whitespace (c);
+    }
+    if (0) {
+    ERROR_LABEL:
+        Ret->HasError = 1;
+    }
+    Ret->Count = Count;
+    // The first entry with the same text wins
+    for (x = 0; x < Count; x++) {
+        uint32_t h = TextReplaceHash (Ret->Texts + Ret->Entries[x].CompareText) & (uint32_t)(HashSize - 1);
+        while (Ret->Hash[h]) {
+            if (!strcmp (Ret->Texts + Ret->Entries[Ret->Hash[h] - 1].CompareText, Ret->Texts + Ret->Entries[x].CompareText)) break;
+            h = (h + 1) & (uint32_t)(HashSize - 1);
+        }
+        if (!Ret->Hash[h]) Ret->Hash[h] = x + 1;
+    }
+    return Ret;
+}
+
+void TextReplaceFreeCompiled (struct TEXT_REPLACE_TABLE *par_Table)
+{
+    if (par_Table != NULL) my_free (par_Table);
+}
+
+int convert_value2textreplace_compiled (struct TEXT_REPLACE_TABLE *par_Table, int64_t wert, const char *conversion,
+                                        char *txt, int maxc, int *pcolor)
+{
+    int lo, n, Half;
+    TEXT_REPLACE_ENTRY *Entry;
+
+    if ((par_Table == NULL) || (maxc <= 0)) {
+        return convert_value2textreplace (wert, conversion, txt, maxc, pcolor);
+    }
+    // Search the first entry with High >= wert
+    lo = 0;
+    n = par_Table->Count;
+    while (n > 0) {
+        Half = n >> 1;
+        if (par_Table->Entries[lo + Half].High < wert) {
+            lo += Half + 1;
+            n -= Half + 1;
+        } else {
+            n = Half;
+        }
+    }
+    if ((lo < par_Table->Count) && (par_Table->Entries[lo].Low <= wert)) {
+        Entry = &par_Table->Entries[lo];
+        if (pcolor != NULL) *pcolor = Entry->Color;
+        StringCopyMaxCharTruncate (txt, par_Table->Texts + Entry->DisplayText, maxc);
+        return 0;
+    }
+    if ((pcolor != NULL) && par_Table->ColorAtEndValid) *pcolor = par_Table->ColorAtEnd;
+    if (par_Table->HasError) {
+        *txt = '\0';
+        return -1;
+    }
+    StringCopyMaxCharTruncate (txt, "out of range", maxc);
+    return -2;
+}
+
+int convert_textreplace2value_compiled (struct TEXT_REPLACE_TABLE *par_Table, const char *conversion,
+                                        char *txt, int64_t *pfrom, int64_t *pto)
+{
+    uint32_t h;
+    int Idx;
+
+    if ((par_Table == NULL) || par_Table->Text2ValueNotPossible) {
+        return convert_textreplace2value (conversion, txt, pfrom, pto);
+    }
+    h = TextReplaceHash (txt) & (uint32_t)(par_Table->HashSize - 1);
+    while ((Idx = par_Table->Hash[h]) != 0) {
+        if (!strcmp (par_Table->Texts + par_Table->Entries[Idx - 1].CompareText, txt)) {
+            if (pfrom != NULL) *pfrom = par_Table->Entries[Idx - 1].From;
+            if (pto != NULL) *pto = par_Table->Entries[Idx - 1].To;
+            return 0;
+        }
+        h = (h + 1) & (uint32_t)(par_Table->HashSize - 1);
+    }
+    return -1;
+}
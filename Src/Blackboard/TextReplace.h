@@ -41,4 +41,16 @@ int GetNextEnumFromEnumList_Pos (int pos, char *conversion,
 
 int GetEnumListSize (char *conversion);
 
+// Precompiled text replace: the conversion string is parsed only once, the lookups will use a
+// binary search (value -> text) or a hash table (text -> value). If par_Table is NULL or cannot be used
+// the conversion string will be parsed as with convert_value2textreplace()/convert_textreplace2value().
+struct TEXT_REPLACE_TABLE *TextReplaceCompile (const char *conversion);
+void TextReplaceFreeCompiled (struct TEXT_REPLACE_TABLE *par_Table);
+
+int convert_value2textreplace_compiled (struct TEXT_REPLACE_TABLE *par_Table, int64_t wert, const char *conversion,
+                                        char *txt, int maxc, int *pcolor);
+
+int convert_textreplace2value_compiled (struct TEXT_REPLACE_TABLE *par_Table, const char *conversion,
+                                        char *txt, int64_t *pfrom, int64_t *pto);
+
 #endif
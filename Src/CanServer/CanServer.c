@@ -725,6 +725,52 @@ static int Blackboard2Object (NEW_CAN_SERVER_CONFIG *csc, int channel, int o_pos
 }
 
 
+// The received signals of one CAN object are collected and written with one blackboard access
+#define RX_FRAME_MAX_SIGNALS  64
+
+typedef struct {
+    int Count;
+    VID Vids[RX_FRAME_MAX_SIGNALS];
+    short Types[RX_FRAME_MAX_SIGNALS];
+    union FloatOrInt64 Values[RX_FRAME_MAX_SIGNALS];
+} CAN_RX_FRAME;
+
+static void FlushRxFrame (CAN_RX_FRAME *par_Frame)
+{
+    if (par_Frame->Count > 0) {
+        write_bbvari_frame_typed (GET_PID(), par_Frame->Count, par_Frame->Vids, par_Frame->Types, par_Frame->Values, NULL);
+        par_Frame->Count = 0;
+    }
+}
+
+static __inline void AddToRxFrame (CAN_RX_FRAME *par_Frame, VID par_Vid, union FloatOrInt64 par_Value, int par_Type)
+{
+    if (par_Frame->Count >= RX_FRAME_MAX_SIGNALS) {
+        FlushRxFrame (par_Frame);
+    }
+    par_Frame->Vids[par_Frame->Count] = par_Vid;
+    par_Frame->Values[par_Frame->Count] = par_Value;
+    switch (par_Type) {
+    case FLOAT_OR_INT_64_TYPE_UINT64:
+        par_Frame->Types[par_Frame->Count] = BB_UQWORD;
+        break;
+    case FLOAT_OR_INT_64_TYPE_F64:
+        par_Frame->Types[par_Frame->Count] = BB_DOUBLE;
+        break;
+    case FLOAT_OR_INT_64_TYPE_INT64:
+        par_Frame->Types[par_Frame->Count] = BB_QWORD;
+        break;
+    default:
+        par_Frame->Types[par_Frame->Count] = BB_QWORD;
+        par_Frame->Values[par_Frame->Count].qw = 0;
+        break;
+    }
+    par_Frame->Count++;
+}
+
+// Conversions with equations can read blackboard variables, so all values before must be written
+#define CONVERSION_READ_BLACKBOARD(ps) (((ps)->ConvType == CAN_CONV_EQU) || ((ps)->ConvType == CAN_CONV_REPLACED))
+
 static void Object2Blackboard (NEW_CAN_SERVER_CONFIG *csc, int channel, int o_pos, int Size)
 {
     UNUSED(channel);
@@ -735,7 +781,9 @@ static void Object2Blackboard (NEW_CAN_SERVER_CONFIG *csc, int channel, int o_po
     int type;
     int mux_value;
     uint64_t iv;
-    
+    CAN_RX_FRAME Frame;
+
+    Frame.Count = 0;
     po = &(csc->objects[o_pos]);
     if (po->EquationBeforeIdx) CalcEquationArray (po->EquationBeforeIdx, po);
     for (s = 0; s < po->signal_count; s++) {
@@ -751,8 +799,9 @@ static void Object2Blackboard (NEW_CAN_SERVER_CONFIG *csc, int channel, int o_po
                 } else {
                     type = ConvWithSign (iv, ps->bitsize, ps->sign, &value);
                 }
+                if (CONVERSION_READ_BLACKBOARD(ps)) FlushRxFrame (&Frame);
                 ConvertSignal (csc, o_pos, po->signals_ptr[s], &value, &type);
-                write_bbvari_convert_with_FloatAndInt64 (ps->vid, value, type);
+                AddToRxFrame (&Frame, ps->vid, value, type);
             }
             break;
         case MUX_SIGNAL:
@@ -770,8 +819,9 @@ static void Object2Blackboard (NEW_CAN_SERVER_CONFIG *csc, int channel, int o_po
                                 } else {
                                     type = ConvWithSign (iv, ps->bitsize, ps->sign, &value);
                                 }
+                                if (CONVERSION_READ_BLACKBOARD(ps)) FlushRxFrame (&Frame);
                                 ConvertSignal (csc, o_pos, s_equ_v, &value, &type);
-                                write_bbvari_convert_with_FloatAndInt64 (ps->vid, value, type);
+                                AddToRxFrame (&Frame, ps->vid, value, type);
                             }
                         }
                         break;
@@ -781,7 +831,9 @@ static void Object2Blackboard (NEW_CAN_SERVER_CONFIG *csc, int channel, int o_po
             break;
         case MUX_BY_SIGNAL:
             if (ps->mux_startbit > 0) {
-                double d = read_bbvari_convert_double(ps->mux_startbit);
+                double d;
+                FlushRxFrame (&Frame);  // the multiplexer variable can be a signal of this object
+                d = read_bbvari_convert_double(ps->mux_startbit);
                 if ((int)d == ps->mux_value) {
                     if (((ps->startbit + ps->bitsize) >> 3) <= Size) {
                         iv = GetValue (po, ps);
@@ -791,14 +843,16 @@ static void Object2Blackboard (NEW_CAN_SERVER_CONFIG *csc, int channel, int o_po
                         } else {
                             type = ConvWithSign (iv, ps->bitsize, ps->sign, &value);
                         }
+                        if (CONVERSION_READ_BLACKBOARD(ps)) FlushRxFrame (&Frame);
                         ConvertSignal (csc, o_pos, po->signals_ptr[s], &value, &type);
-                        write_bbvari_convert_with_FloatAndInt64 (ps->vid, value, type);
+                        AddToRxFrame (&Frame, ps->vid, value, type);
                     }
                 }
             }
             break;
         }
     }
+    FlushRxFrame (&Frame);
     if (po->EquationBehindIdx) CalcEquationArray (po->EquationBehindIdx, po);
 }
 
@@ -49,6 +49,7 @@
 typedef struct _CcpCalParamItem {
     int vid;
     uint32_t Address;
+    uint32_t WrSeq;   // write sequence number of the last download/upload
 } CcpCalParamItem;
 
 
@@ -1092,6 +1093,7 @@ static int BuildCalibrationList (int par_ParamCount, char **par_Params, int par_
                         set_bbvari_min (pCon->CcpCalParamList[x].vid, Min);
                         set_bbvari_max (pCon->CcpCalParamList[x].vid, Max);
                     }
+                    pCon->CcpCalParamList[x].WrSeq = get_bbvari_wrseq (pCon->CcpCalParamList[x].vid);
                     found = 1;
                 } 
             } else {
@@ -2858,7 +2860,6 @@ void Upload_CmdScheduler (CCP_CONNECTTION *pCon, int Connection)
 {
     CCP_CRO_CAN_OBJECT CanObject;
     union BB_VARI help;
-    uint64_t wrflag;
 
     switch (pCon->CcpCommand)
     {
@@ -2932,8 +2933,7 @@ void Upload_CmdScheduler (CCP_CONNECTTION *pCon, int Connection)
                     break;
                 }
                 // Avoid that immediately a download would follow
-                get_free_wrflag (get_pid_by_name ("CCP_Control"), &wrflag);
-                reset_wrflag (pCon->CcpCalParamList[pCon->UploadCcpCalParamPos].vid, wrflag);
+                pCon->CcpCalParamList[pCon->UploadCcpCalParamPos].WrSeq = get_bbvari_wrseq (pCon->CcpCalParamList[pCon->UploadCcpCalParamPos].vid);
             } else {
                 pCon->CcpCommand = CCP_DATA_UPLOAD;
             }
@@ -2946,19 +2946,16 @@ void Upload_CmdScheduler (CCP_CONNECTTION *pCon, int Connection)
 
 void CCPWriteCharacteristics (CCP_CONNECTTION *pCon)
 {
-    uint64_t wrflag;
     union BB_VARI help;
     int CcpCalParamPosOld;
 
-    get_free_wrflag(get_pid_by_name ("CCP_Control"), &wrflag);
     CcpCalParamPosOld = pCon->CcpCalParamPos;
     while ((pCon->CcpCalParamList[pCon->CcpCalParamPos].vid <= 0) ||    // not a valid blackboard variable
-           !test_wrflag(pCon->CcpCalParamList[pCon->CcpCalParamPos].vid, wrflag)) {
+           !test_bbvari_wrseq(pCon->CcpCalParamList[pCon->CcpCalParamPos].vid, &pCon->CcpCalParamList[pCon->CcpCalParamPos].WrSeq)) {
         pCon->CcpCalParamPos++;
         if (pCon->CcpCalParamPos >= pCon->CcpCalParamListSize) pCon->CcpCalParamPos = 0;
-        if (pCon->CcpCalParamPos == CcpCalParamPosOld) return;  // no write flag set
+        if (pCon->CcpCalParamPos == CcpCalParamPosOld) return;  // nothing written
     }
-    reset_wrflag(pCon->CcpCalParamList[pCon->CcpCalParamPos].vid, wrflag);
     switch (get_bbvaritype(pCon->CcpCalParamList[pCon->CcpCalParamPos].vid)) {
     case BB_BYTE:
         help.b = read_bbvari_byte (pCon->CcpCalParamList[pCon->CcpCalParamPos].vid);
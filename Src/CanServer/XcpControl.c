@@ -47,6 +47,7 @@
 typedef struct _XcpCalParamItem {
     int vid;
     uint32_t Address;
+    uint32_t WrSeq;   // write sequence number of the last download/upload
 } XcpCalParamItem;
 
 
@@ -935,6 +936,7 @@ static int BuildCalibrationList (int par_ParamCount, char **par_Params, int par_
                         set_bbvari_min (pCon->XcpCalParamList[x].vid, Min);
                         set_bbvari_max (pCon->XcpCalParamList[x].vid, Max);
                     }
+                    pCon->XcpCalParamList[x].WrSeq = get_bbvari_wrseq (pCon->XcpCalParamList[x].vid);
                     found = 1;
                 } 
             } else {
@@ -2629,7 +2631,6 @@ void XCPDownload_CmdScheduler (XCP_CONNECTTION *pCon, int Connection)
 void XCPUpload_CmdScheduler (XCP_CONNECTTION *pCon, int Connection)
 {
     union BB_VARI help;
-    uint64_t wrflag;
 
     switch (pCon->XcpCommand)
     {
@@ -2703,8 +2704,7 @@ void XCPUpload_CmdScheduler (XCP_CONNECTTION *pCon, int Connection)
                     break;
                 }
                 // Avoid that immediately a download would follow
-                get_free_wrflag(get_pid_by_name ("XCP_Control"), &wrflag);
-                reset_wrflag(pCon->XcpCalParamList[pCon->UploadXcpCalParamPos].vid, wrflag);
+                pCon->XcpCalParamList[pCon->UploadXcpCalParamPos].WrSeq = get_bbvari_wrseq (pCon->XcpCalParamList[pCon->UploadXcpCalParamPos].vid);
             } else {
                 pCon->XcpCommand = XCP_UPLOAD;
             }
@@ -2717,19 +2717,16 @@ void XCPUpload_CmdScheduler (XCP_CONNECTTION *pCon, int Connection)
 
 void XCPWriteCharacteristics (XCP_CONNECTTION *pCon)
 {
-    uint64_t wrflag;
     union BB_VARI help;
     int XcpCalParamPosOld;
 
-    get_free_wrflag(get_pid_by_name ("XCP_Control"), &wrflag);
     XcpCalParamPosOld = pCon->XcpCalParamPos;
     while ((pCon->XcpCalParamList[pCon->XcpCalParamPos].vid < 0) ||  // not a valid blackboard variable
-           !test_wrflag(pCon->XcpCalParamList[pCon->XcpCalParamPos].vid, wrflag)) {
+           !test_bbvari_wrseq(pCon->XcpCalParamList[pCon->XcpCalParamPos].vid, &pCon->XcpCalParamList[pCon->XcpCalParamPos].WrSeq)) {
         pCon->XcpCalParamPos++;
         if (pCon->XcpCalParamPos >= pCon->XcpCalParamListSize) pCon->XcpCalParamPos = 0;
-        if (pCon->XcpCalParamPos == XcpCalParamPosOld) return;  // no write flag set
+        if (pCon->XcpCalParamPos == XcpCalParamPosOld) return;  // nothing written
     }
-    reset_wrflag(pCon->XcpCalParamList[pCon->XcpCalParamPos].vid, wrflag);
     switch (get_bbvaritype(pCon->XcpCalParamList[pCon->XcpCalParamPos].vid)) {
     case BB_BYTE:
         help.b = read_bbvari_byte (pCon->XcpCalParamList[pCon->XcpCalParamPos].vid);
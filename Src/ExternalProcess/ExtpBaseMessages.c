@@ -746,6 +746,97 @@ int XilEnvInternal_PipeAddBlackboardVariableAllInfos (EXTERN_PROCESS_TASK_INFOS_
     return Ack.Vid;
 }
 
+int XilEnvInternal_PipeAddBlackboardVariables (EXTERN_PROCESS_TASK_INFOS_STRUCT *TaskInfo, int Count,
+                                               const char **Names, const int *Types, const char **Units, const int *Dirs,
+                                               const unsigned long long *Addresses, const unsigned long long *UniqueIds,
+                                               int *ret_Vids, int *ret_Types)
+{
+    PIPE_API_ADD_BBVARIS_CMD_MESSAGE *pReq;
+    PIPE_API_ADD_BBVARIS_CMD_MESSAGE_ACK *pAck;
+    PIPE_API_ADD_BBVARIS_ELEM *Elems;
+    BOOL Status;
+    DWORD BytesRead;
+    int Done, x;
+
+    pReq = (PIPE_API_ADD_BBVARIS_CMD_MESSAGE*)XilEnvInternal_malloc (PIPE_MESSAGE_BUFSIZE);
+    pAck = (PIPE_API_ADD_BBVARIS_CMD_MESSAGE_ACK*)XilEnvInternal_malloc (PIPE_MESSAGE_BUFSIZE);
+    if ((pReq == NULL) || (pAck == NULL)) {
+        if (pReq != NULL) XilEnvInternal_free (pReq);
+        if (pAck != NULL) XilEnvInternal_free (pAck);
+        return -1;
+    }
+    Elems = (PIPE_API_ADD_BBVARIS_ELEM*)(void*)pReq->Data;
+
+    // Transmit as many variables as fit into one message
+    for (Done = 0; Done < Count; Done += pReq->Count) {
+        int StringPos;
+        int n = Count - Done;
+        if (n > PIPE_API_ADD_BBVARIS_MAX_COUNT) n = PIPE_API_ADD_BBVARIS_MAX_COUNT;
+        StringPos = n * (int)sizeof (PIPE_API_ADD_BBVARIS_ELEM);
+        for (x = 0; x < n; x++) {
+            const char *Name = Names[Done + x];
+            const char *Unit = ((Units != NULL) && (Units[Done + x] != NULL)) ? Units[Done + x] : "";
+            int NameLen = (int)strlen (Name) + 1;
+            int UnitLen = (int)strlen (Unit) + 1;
+            if (((int)sizeof (PIPE_API_ADD_BBVARIS_CMD_MESSAGE) + StringPos + NameLen + UnitLen) > PIPE_MESSAGE_BUFSIZE) {
+                break;
+            }
+            Elems[x].Dir = (Dirs != NULL) ? Dirs[Done + x] : 0;
+            Elems[x].DataType = Types[Done + x];
+            Elems[x].AddressValidFlag = (Addresses != NULL);
+            Elems[x].Address = (Addresses != NULL) ? Addresses[Done + x] : 0;
+            Elems[x].UniqueId = (UniqueIds != NULL) ? UniqueIds[Done + x] : 0xFFFFFFFFFFFFFFFFULL;   // should not include into the copy list
+            Elems[x].NameStructOffset = StringPos;
+            MEMCPY (pReq->Data + StringPos, Name, (size_t)NameLen);
+            StringPos += NameLen;
+            Elems[x].UnitStructOffset = StringPos;
+            MEMCPY (pReq->Data + StringPos, Unit, (size_t)UnitLen);
+            StringPos += UnitLen;
+            Elems[x].Fill1 = 0;
+        }
+        if (x == 0) {
+            XilEnvInternal_ThrowError (TaskInfo, 1, "cannot add blackboard variable \"%s\" name too long\n", Names[Done]);
+            break;
+        }
+        if (x < n) {
+            // the elements are in front of the strings so move the strings if not all elements are used
+            int Gap = (n - x) * (int)sizeof (PIPE_API_ADD_BBVARIS_ELEM);
+            memmove (pReq->Data + x * (int)sizeof (PIPE_API_ADD_BBVARIS_ELEM), pReq->Data + n * (int)sizeof (PIPE_API_ADD_BBVARIS_ELEM),
+                     (size_t)(StringPos - n * (int)sizeof (PIPE_API_ADD_BBVARIS_ELEM)));
+            StringPos -= Gap;
+            for (n = 0; n < x; n++) {
+                Elems[n].NameStructOffset -= Gap;
+                Elems[n].UnitStructOffset -= Gap;
+            }
+        }
+        pReq->Command = PIPE_API_ADD_BBVARIS_CMD;
+        pReq->StructSize = (int)sizeof (PIPE_API_ADD_BBVARIS_CMD_MESSAGE) + StringPos;
+        pReq->Pid = (int16_t)get_process_identifier ();
+        pReq->Count = x;
+
+        Status = XilEnvInternal_TransactMessage(TaskInfo,
+                                                (LPVOID)pReq,
+                                                (DWORD)pReq->StructSize,
+                                                (LPVOID)pAck,
+                                                (DWORD)PIPE_MESSAGE_BUFSIZE,
+                                                &BytesRead);
+        if (!Status || (pAck->Command != PIPE_API_ADD_BBVARIS_CMD) || (pAck->Count != x)) {
+            XilEnvInternal_ThrowError (TaskInfo, 1, "cannot add blackboard variables %i or %i != %i\n",  Status, pAck->Count, x);
+            break;
+        }
+        for (n = 0; n < x; n++) {
+            ret_Vids[Done + n] = pAck->Elems[n].Vid;
+            if (ret_Types != NULL) ret_Types[Done + n] = pAck->Elems[n].RealType;
+        }
+    }
+    for (x = Done; x < Count; x++) {
+        ret_Vids[x] = -1;
+    }
+    XilEnvInternal_free (pReq);
+    XilEnvInternal_free (pAck);
+    return (Done < Count) ? -1 : 0;
+}
+
 int XilEnvInternal_PipeAttachBlackboardVariable (EXTERN_PROCESS_TASK_INFOS_STRUCT *TaskPtr, const char *Name)
 {
     PIPE_API_ATTACH_BBVARI_CMD_MESSAGE *pReq;
@@ -45,6 +45,13 @@ int XilEnvInternal_PipeAddBlackboardVariableAllInfos (EXTERN_PROCESS_TASK_INFOS_
                                                         unsigned long long UniqueId,
                                                         int *ret_Type);
 
+// Add several variables with PIPE_API_ADD_BBVARIS_CMD messages, Units, Dirs, Addresses, UniqueIds and ret_Types can be NULL.
+// The vid (or an error code) of each variable is stored inside ret_Vids.
+int XilEnvInternal_PipeAddBlackboardVariables (EXTERN_PROCESS_TASK_INFOS_STRUCT *TaskInfo, int Count,
+                                               const char **Names, const int *Types, const char **Units, const int *Dirs,
+                                               const unsigned long long *Addresses, const unsigned long long *UniqueIds,
+                                               int *ret_Vids, int *ret_Types);
+
 int XilEnvInternal_PipeAttachBlackboardVariable (EXTERN_PROCESS_TASK_INFOS_STRUCT *TaskPtr, const char *Name);
 
 int XilEnvInternal_PipeRemoveBlackboardVariable (EXTERN_PROCESS_TASK_INFOS_STRUCT* TaskPtr, int Vid, int Dir, int DataType, unsigned long long Addr, unsigned long long UniqueId);
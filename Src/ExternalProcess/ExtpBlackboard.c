@@ -471,6 +471,68 @@ EXPORT_OR_IMPORT VID __FUNC_CALL_CONVETION__ add_bbvari (const char *name, int t
     return Ret;
 }
 
+int add_bbvari_list (int count, const char **names, const int *types, const char **units, VID *ret_vids)
+{
+    int x;
+    int Ret;
+    int *VidIndexes, *Types, *Dirs, *RealTypes;
+    unsigned long long *Addresses, *UniqueIds;
+    EXTERN_PROCESS_TASK_INFOS_STRUCT* TaskPtr;
+
+    TaskPtr = XilEnvInternal_GetTaskPtr ();
+    if (TaskPtr == NULL) {
+        return WRONG_PARAMETER;
+    }
+    if (count <= 0) {
+        XilEnvInternal_ReleaseTaskPtr(TaskPtr);
+        return 0;
+    }
+    VidIndexes = (int*)XilEnvInternal_malloc (count * (int)sizeof (int));
+    Types = (int*)XilEnvInternal_malloc (count * (int)sizeof (int));
+    Dirs = (int*)XilEnvInternal_malloc (count * (int)sizeof (int));
+    RealTypes = (int*)XilEnvInternal_malloc (count * (int)sizeof (int));
+    Addresses = (unsigned long long*)XilEnvInternal_malloc (count * (int)sizeof (unsigned long long));
+    UniqueIds = (unsigned long long*)XilEnvInternal_malloc (count * (int)sizeof (unsigned long long));
+    if ((VidIndexes == NULL) || (Types == NULL) || (Dirs == NULL) || (RealTypes == NULL) || (Addresses == NULL) || (UniqueIds == NULL)) {
+        Ret = -1;
+        goto __OUT;
+    }
+
+    for (x = 0; x < count; x++) {
+        VidIndexes[x] = XilEnvInternal_BbCacheGetOrAllocMemoryForDataAndName(TaskPtr, names[x]);
+        Dirs[x] = PIPE_API_REFERENCE_VARIABLE_DIR_READ_WRITE | PIPE_API_REFERENCE_VARIABLE_DIR_ADD_COPY_LIST;
+        Types[x] = XilEnvInternal_DataTypeConvert (Dirs[x], types[x]);
+        Addresses[x] = (uint64_t)XilEnvInternal_BbCacheGetAddress(TaskPtr, VidIndexes[x]);
+        UniqueIds[x] = XilEnvInternal_BbCacheGetUniqueId(TaskPtr, VidIndexes[x]);
+    }
+    Ret = XilEnvInternal_PipeAddBlackboardVariables (TaskPtr, count, names, Types, units, Dirs, Addresses, UniqueIds, ret_vids, RealTypes);
+
+    // The same as add_bbvari() for each variable
+    for (x = 0; x < count; x++) {
+        VID Vid = ret_vids[x];
+        if (Vid > 0) {
+            ret_vids[x] = XilEnvInternal_BbCacheSetVidAndType(TaskPtr, VidIndexes[x], Vid, (enum SC_BB_DATA_TYPES)RealTypes[x]);  // is than an index into the cache
+        }
+        if (ret_vids[x] <= 0) {
+            XilEnvInternal_BbCacheFreeMemoryForDataAndName(TaskPtr, VidIndexes[x]);
+        } else {
+            XilEnvInternal_InsertVariableToCopyLists (TaskPtr, names[x], Vid,
+                                                       (void*)XilEnvInternal_BbCacheGetAddress(TaskPtr, VidIndexes[x]),
+                                                       RealTypes[x], RealTypes[x], PIPE_API_REFERENCE_VARIABLE_DIR_READ_WRITE,
+                                                       XilEnvInternal_BbCacheGetUniqueId(TaskPtr, VidIndexes[x]));
+        }
+    }
+__OUT:
+    if (VidIndexes != NULL) XilEnvInternal_free (VidIndexes);
+    if (Types != NULL) XilEnvInternal_free (Types);
+    if (Dirs != NULL) XilEnvInternal_free (Dirs);
+    if (RealTypes != NULL) XilEnvInternal_free (RealTypes);
+    if (Addresses != NULL) XilEnvInternal_free (Addresses);
+    if (UniqueIds != NULL) XilEnvInternal_free (UniqueIds);
+    XilEnvInternal_ReleaseTaskPtr(TaskPtr);
+    return Ret;
+}
+
 VID add_bbvari_all_infos_dir (const char *name, int type, const char *unit, int dir,
                               int convtype, const char *conversion,
                               double min, double max,
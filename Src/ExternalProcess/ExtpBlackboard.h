@@ -36,6 +36,10 @@ VID add_bbvari_dir (const char *name, int type, const char *unit, int dir,
 
 EXPORT_OR_IMPORT VID __FUNC_CALL_CONVETION__ add_bbvari (const char *name, int type, const char *unit);
 
+// Add several variables with as few messages as possible, the same as add_bbvari() for each of them.
+// units can be NULL. The vid (or an error code) of each variable is stored inside ret_vids.
+int add_bbvari_list (int count, const char **names, const int *types, const char **units, VID *ret_vids);
+
 VID add_bbvari_all_infos_dir (const char *name, int type, const char *unit, int dir,
                               int convtype, const char *conversion,
                               double min, double max,
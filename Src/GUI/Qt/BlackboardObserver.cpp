@@ -16,9 +16,11 @@
 
 
 #include "BlackboardObserver.h"
+#include <QPair>
 
 extern "C" {
 #include "Blackboard.h"
+#include "BlackboardObservationQueue.h"
 }
 
 #ifdef _UNUCODE
@@ -197,6 +199,49 @@ void BlackboardObserver::VariableChanged(VID arg_Vid, uint32_t arg_observationFl
     LeaveCriticalSection(&m_CriticalSection);
 }
 
+// The writers have only queued the changed variables, notify the connections
+// which observe them with OBSERVE_VALUE_CHANGED. Each variable only once per call.
+void BlackboardObserver::DispatchValueChanges()
+{
+    VID Vids[256];
+    uint32_t ObservationDatas[256];
+    QList<QPair<BlackboardObserverConnection*, int> > Notifications;
+    int Count;
+
+    EnterCriticalSection(&m_CriticalSection);
+    do {
+        Count = PopValueChangedObservations(Vids, ObservationDatas, 256);
+        for (int x = 0; x < Count; x++) {
+            ObserverdVariableEntry *Entry = nullptr;
+            // ObservationData should be the index into m_ObservedVariables but this can be out of date
+            if ((ObservationDatas[x] < static_cast<uint32_t>(m_ObservedVariables.size())) &&
+                (m_ObservedVariables.at(static_cast<int>(ObservationDatas[x]))->m_Vid == Vids[x])) {
+                Entry = m_ObservedVariables.at(static_cast<int>(ObservationDatas[x]));
+            } else {
+                for (int y = 0; y < m_ObservedVariables.size(); y++) {
+                    if (m_ObservedVariables.at(y)->m_Vid == Vids[x]) {
+                        Entry = m_ObservedVariables.at(y);
+                        break;
+                    }
+                }
+            }
+            if (Entry != nullptr) {
+                for (int y = 0; y < Entry->m_ConnectionFlags.size(); y++) {
+                    if ((Entry->m_ConnectionFlags.at(y).m_Flags & OBSERVE_VALUE_CHANGED) == OBSERVE_VALUE_CHANGED) {
+                        Notifications.append(QPair<BlackboardObserverConnection*, int>(Entry->m_ConnectionFlags.at(y).m_Connection, Vids[x]));
+                    }
+                }
+            }
+        }
+    } while (Count == 256);
+    LeaveCriticalSection(&m_CriticalSection);
+    // emit outside the critical section because the slots are called directly (same thread)
+    // and can add or remove observations
+    for (int x = 0; x < Notifications.size(); x++) {
+        emit Notifications.at(x).first->variableChanged(Notifications.at(x).second, OBSERVE_VALUE_CHANGED);
+    }
+}
+
 BlackboardObserverConnection::BlackboardObserverConnection(QObject *par_OwnerObject)
 {
     connect(this, SIGNAL(variableChanged(int,unsigned int)), par_OwnerObject, SLOT(blackboardVariableConfigChanged(int,unsigned int)));
@@ -239,3 +284,8 @@ extern "C" void StopBlackboardObserver(void)
 {
     SetObserationCallbackFunction(nullptr);
 }
+
+void DispatchBlackboardValueChanges(void)
+{
+    blackboardObserverInst.DispatchValueChanges();
+}
@@ -80,6 +80,7 @@ public:
     void RemoveObserveBlackboard(BlackboardObserverConnection *arg_Connection);
 
     void VariableChanged(VID arg_Vid, uint32_t arg_observationFlags, uint32_t arg_observationData);
+    void DispatchValueChanges();
 
 private:
     QList<BlackboardObserverConnection*> m_GlobalConnections;
@@ -93,6 +94,9 @@ extern "C" void StartBlackboardObserver(void);
 
 extern "C" void StopBlackboardObserver(void);
 
+// Should be called once each GUI update tick before the widgets will be updated
+void DispatchBlackboardValueChanges(void);
+
 #else
 
 void StartBlackboardObserver(void);
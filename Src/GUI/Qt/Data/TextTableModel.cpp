@@ -18,6 +18,7 @@
 #include "TextTableModel.h"
 #include <QBrush>
 #include <QPen>
+#include <QVarLengthArray>
 
 extern "C" {
 #include "MyMemory.h"
@@ -74,6 +75,8 @@ TextTableModel::TextTableModel(QObject* arg_parent) : QAbstractTableModel(arg_pa
     m_Values = nullptr;
     m_Pos = nullptr;
     m_Size = 0;
+    m_OnlyChangedValues = false;
+    m_UpdateAllValues = true;
 }
 
 TextTableModel::~TextTableModel()
@@ -504,8 +507,12 @@ void TextTableModel::CyclicUpdateValues(int arg_fromRow, int arg_toRow, bool arg
     int row = 0;
 
     BEGIN_RUNTIME_MEASSUREMENT ("TextTableModel::CyclicUpdateValues")
-    if (read_bbvari_union_type_frame(m_SizeExisting, m_Vids, m_Types, m_Values) == m_SizeExisting) {
+    if (m_OnlyChangedValues && !arg_updateAlways && !m_UpdateAllValues) {
+        ColumnUpdateFlags = UpdateChangedValues();
+    } else if (read_bbvari_union_type_frame(m_SizeExisting, m_Vids, m_Types, m_Values) == m_SizeExisting) {
         int x;
+        m_UpdateAllValues = false;
+        m_ChangedVids.clear();
         for (x = 0; x < m_Size; x++) {
             row = m_Pos[x];
             Variable *loc_Variable = m_listOfElements.at(row);
@@ -518,6 +525,52 @@ void TextTableModel::CyclicUpdateValues(int arg_fromRow, int arg_toRow, bool arg
     END_RUNTIME_MEASSUREMENT
 }
 
+int TextTableModel::UpdateChangedValues()
+{
+    int ColumnUpdateFlags = 0;
+
+    if (m_ChangedVids.isEmpty()) {
+        return 0;
+    }
+    QVarLengthArray<int, 64> loc_Vids;
+    QVarLengthArray<int, 64> loc_Indexes;
+    for (int x = 0; x < m_SizeExisting; x++) {
+        if (m_ChangedVids.contains(m_Vids[x])) {
+            loc_Vids.append(m_Vids[x]);
+            loc_Indexes.append(x);
+        }
+    }
+    m_ChangedVids.clear();
+    if (loc_Vids.size() > 0) {
+        QVarLengthArray<enum BB_DATA_TYPES, 64> loc_Types(loc_Vids.size());
+        QVarLengthArray<union BB_VARI, 64> loc_Values(loc_Vids.size());
+        if (read_bbvari_union_type_frame(loc_Vids.size(), loc_Vids.data(), loc_Types.data(), loc_Values.data()) == loc_Vids.size()) {
+            for (int i = 0; i < loc_Vids.size(); i++) {
+                int x = loc_Indexes[i];
+                // keep m_Values up to date, it will be used by WriteContentToFile()
+                m_Types[x] = loc_Types[i];
+                m_Values[x] = loc_Values[i];
+                int row = m_Pos[x];
+                ColumnUpdateFlags |= UpdateOneVariable(m_listOfElements.at(row), row, false, m_Values[x], m_Types[x]);
+            }
+        } else {
+            m_UpdateAllValues = true;
+        }
+    }
+    return ColumnUpdateFlags;
+}
+
+void TextTableModel::setOnlyUpdateChangedValues(bool arg_onlyChanged)
+{
+    m_OnlyChangedValues = arg_onlyChanged;
+    m_UpdateAllValues = true;
+}
+
+void TextTableModel::blackboardVariableValueChanged(int arg_vid)
+{
+    m_ChangedVids.insert(arg_vid);
+}
+
 void TextTableModel::setFont(QFont &arg_font)
 {
     m_FontMetrics = new QFontMetrics(arg_font);
@@ -633,6 +686,7 @@ void TextTableModel::SyncCopyBuffer()
         }
     }
     m_SizeExisting = y;
+    m_UpdateAllValues = true;
 }
 
 static int CompareDoubleEqual(double a, double b)
@@ -20,6 +20,7 @@
 
 #include <QAbstractTableModel>
 #include <QPair>
+#include <QSet>
 #include <QList>
 #include <QString>
 #include <QColor>
@@ -95,6 +96,9 @@ public:
     void setColumnAlignment(int par_Column, int par_ColumnAlignments);
 
     void CyclicUpdateValues(int arg_fromRow, int arg_toRow, bool arg_updateAlways = false, bool arg_checkUnitColumnWidth = false);
+    // If set CyclicUpdateValues() will only read the variables reported by blackboardVariableValueChanged()
+    void setOnlyUpdateChangedValues(bool arg_onlyChanged);
+    void blackboardVariableValueChanged(int arg_vid);
 
     void setFont(QFont &arg_font);
     QStringList getAllVariableNames();
@@ -134,6 +138,10 @@ private:
     void SyncCopyBuffer(void);
     int UpdateOneVariable(Variable *par_Variable, int row, bool arg_updateAlways,
                           union BB_VARI loc_rawValue, enum BB_DATA_TYPES loc_dataType);
+    int UpdateChangedValues(void);
+    bool m_OnlyChangedValues;
+    bool m_UpdateAllValues;         // after the copy buffer is sorted all values must be read one time
+    QSet<int> m_ChangedVids;
     size_t m_BufferSize;
     int m_Size;
     int m_SizeExisting;
@@ -43,6 +43,7 @@ extern "C"
     #include "InterfaceToScript.h"
     #include "FileExtensions.h"
     #include "RpcSocketServer.h"
+    #include "Blackboard.h"
 }
 
 
@@ -376,6 +377,7 @@ void BasicSettingsDialog::accept()
         } else {
             s_main_ini_val.SwitchAutomaticSaveIniOff = help;
             SaveAllInfosToIniDataBase();
+            flush_varinfos_to_ini();
             char IniFileName[MAX_PATH];
             IniFileDataBaseGetFileNameByDescriptor(GetMainFileDescriptor(), IniFileName, sizeof(IniFileName));
             if (IniFileDataBaseSave(GetMainFileDescriptor(), nullptr, 0)) {
@@ -141,12 +141,13 @@ void BlackboardInternalDialog::on_VariableListWidget_currentItemChanged(QListWid
                                 // Attach counter
                                 ui->AttachCounterLineEdit->setText(QString().number(blackboard[BlackboardIndex].pAdditionalInfos->AttachCount));
                                 ui->UnknownWaitAttachCounterLineEdit->setText(QString().number(blackboard[BlackboardIndex].pAdditionalInfos->UnknownWaitAttachCount));
+                                ui->WrSeqLineEdit->setText(QString().number(BB_WR_SEQ(BlackboardIndex)));
 
                                 char ProcessName[MAX_PATH];
                                 ui->ProcessAttachCounteTableWidget->clear();
                                 QStringList Vertical;
                                 QStringList Horizontal;
-                                Horizontal << "Pid" << "Attach counter" << "Unknown wait attach counter" << "Access flags" << "WR flags" << "WR enable Flags" << "RangeControl";
+                                Horizontal << "Pid" << "Attach counter" << "Unknown wait attach counter" << "Access flags" << "WR enable Flags" << "RangeControl";
                                 ui->ProcessAttachCounteTableWidget->setHorizontalHeaderLabels (Horizontal);
                                 for (int x = 0; x < 64; x++) {
                                     if (GetProcessShortName(blackboard_infos.pid_access_masks[x], ProcessName, sizeof(ProcessName)) == 0) {
@@ -155,28 +156,23 @@ void BlackboardInternalDialog::on_VariableListWidget_currentItemChanged(QListWid
                                         Vertical.append(QString ("unused"));
                                     }
                                     ui->ProcessAttachCounteTableWidget->setItem(x, 0, new QTableWidgetItem(QString().number(blackboard_infos.pid_access_masks[x])));
-                                    ui->ProcessAttachCounteTableWidget->setItem(x, 1, new QTableWidgetItem(QString().number(blackboard[BlackboardIndex].pAdditionalInfos->ProcessAttachCounts[x])));
-                                    ui->ProcessAttachCounteTableWidget->setItem(x, 2, new QTableWidgetItem(QString().number(blackboard[BlackboardIndex].pAdditionalInfos->ProcessUnknownWaitAttachCounts[x])));
-                                    if ((blackboard[BlackboardIndex].AccessFlags & (1ULL << x)) != 0) {
+                                    ui->ProcessAttachCounteTableWidget->setItem(x, 1, new QTableWidgetItem(QString().number(GetAttachCount(&blackboard[BlackboardIndex].pAdditionalInfos->ProcessAttachCounts, x))));
+                                    ui->ProcessAttachCounteTableWidget->setItem(x, 2, new QTableWidgetItem(QString().number(GetAttachCount(&blackboard[BlackboardIndex].pAdditionalInfos->ProcessUnknownWaitAttachCounts, x))));
+                                    if ((BB_ACCESS_FLAGS(BlackboardIndex) & (1ULL << x)) != 0) {
                                         ui->ProcessAttachCounteTableWidget->setItem(x, 3, new QTableWidgetItem(QString("X")));
                                     } else {
                                         ui->ProcessAttachCounteTableWidget->setItem(x, 3, new QTableWidgetItem(QString("-")));
                                     }
-                                    if ((blackboard[BlackboardIndex].WrFlags & (1ULL << x)) != 0) {
+                                    if ((blackboard[BlackboardIndex].WrEnableFlags & (1ULL << x)) != 0) {
                                         ui->ProcessAttachCounteTableWidget->setItem(x, 4, new QTableWidgetItem(QString("X")));
                                     } else {
                                         ui->ProcessAttachCounteTableWidget->setItem(x, 4, new QTableWidgetItem(QString("-")));
                                     }
-                                    if ((blackboard[BlackboardIndex].WrEnableFlags & (1ULL << x)) != 0) {
+                                    if ((blackboard[BlackboardIndex].RangeControlFlag & (1ULL << x)) != 0) {
                                         ui->ProcessAttachCounteTableWidget->setItem(x, 5, new QTableWidgetItem(QString("X")));
                                     } else {
                                         ui->ProcessAttachCounteTableWidget->setItem(x, 5, new QTableWidgetItem(QString("-")));
                                     }
-                                    if ((blackboard[BlackboardIndex].RangeControlFlag & (1ULL << x)) != 0) {
-                                        ui->ProcessAttachCounteTableWidget->setItem(x, 6, new QTableWidgetItem(QString("X")));
-                                    } else {
-                                        ui->ProcessAttachCounteTableWidget->setItem(x, 6, new QTableWidgetItem(QString("-")));
-                                    }
                                 }
                                 ui->ProcessAttachCounteTableWidget->setVerticalHeaderLabels (Vertical);
                             }
@@ -55,6 +55,7 @@ int exportvariableproperties::FillListBox (int par_Fd, int OnlyExistingVariables
 
     ui->listWidgetAvailableVariable->clear();
 
+    flush_varinfos_to_ini();
     EntryIdx = 0;
     while ((EntryIdx = IniFileDataBaseGetNextEntryName (EntryIdx, "Variables", Variname, sizeof(Variname), par_Fd)) >= 0) {
         if (OnlyExistingVariablesFlag) {
@@ -156,6 +157,7 @@ int exportvariableproperties::CopyVariablePropertiesBetweenTwoIniFiles (int SrcI
     char VarName[BBVARI_NAME_SIZE];
     char Properties[INI_MAX_LINE_LENGTH];
 
+    flush_varinfos_to_ini();
     for (i = 0; i < ui->listWidgetExportVariable->count(); i++) {
         STRING_COPY_TO_ARRAY(VarName, QStringToConstChar(ui->listWidgetExportVariable->item(i)->text()));
         IniFileDataBaseReadString ("Variables", VarName, "", Properties, sizeof (Properties), SrcIniFile);
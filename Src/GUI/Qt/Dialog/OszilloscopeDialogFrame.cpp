@@ -191,16 +191,16 @@ void OszilloscopeDialogFrame::userAccept()
                 m_data->vids_right[m_data->sel_pos_right] = vid;
                 m_data->name_right[m_data->sel_pos_right] = ReallocCopyString(m_data->name_right[m_data->sel_pos_right],
                                                                               m_currentVariableName);
-                if (m_data->buffer_right[m_data->sel_pos_right] != nullptr) my_free (m_data->buffer_right[m_data->sel_pos_right]);
-                if ((m_data->buffer_right[m_data->sel_pos_right] = static_cast<double*>(my_calloc (static_cast<size_t>(m_data->buffer_depth), sizeof(double)))) == nullptr) {
+                OscilloscopeBufferFree (m_data->buffer_right[m_data->sel_pos_right]);
+                if ((m_data->buffer_right[m_data->sel_pos_right] = OscilloscopeBufferAlloc (m_data->buffer_depth)) == nullptr) {
                     ThrowError (1, "out of memory");
                 }
             } else {
                 m_data->vids_left[m_data->sel_pos_left] = vid;
                 m_data->name_left[m_data->sel_pos_left] = ReallocCopyString(m_data->name_left[m_data->sel_pos_left],
                                                                             m_currentVariableName);
-                if (m_data->buffer_left[m_data->sel_pos_left] != nullptr) my_free (m_data->buffer_left[m_data->sel_pos_left]);
-                if ((m_data->buffer_left[m_data->sel_pos_left] = static_cast<double*>(my_calloc (static_cast<size_t>(m_data->buffer_depth), sizeof(double)))) == nullptr) {
+                OscilloscopeBufferFree (m_data->buffer_left[m_data->sel_pos_left]);
+                if ((m_data->buffer_left[m_data->sel_pos_left] = OscilloscopeBufferAlloc (m_data->buffer_depth)) == nullptr) {
                     ThrowError (1, "out of memory");
                 }
             }
@@ -408,16 +408,16 @@ void OszilloscopeDialogFrame::ResetCurrentBuffer()
     if(m_data->sel_left_right) {
         m_data->wr_poi_right[m_data->sel_pos_right] = 0;
         m_data->depth_right[m_data->sel_pos_right] = 0;
-        double *Buffer = m_data->buffer_right[m_data->sel_pos_right];
+        OSCILLOSCOPE_BUFFER *Buffer = m_data->buffer_right[m_data->sel_pos_right];
         for (int x = 0; x < m_data->buffer_depth; x++) {
-           Buffer[x] = static_cast<double>(NAN);
+           OscilloscopeBufferWrite (Buffer, x, static_cast<double>(NAN));
         }
     } else {
         m_data->wr_poi_left[m_data->sel_pos_left] = 0;
         m_data->depth_left[m_data->sel_pos_left] = 0;
-        double *Buffer = m_data->buffer_left[m_data->sel_pos_left];
+        OSCILLOSCOPE_BUFFER *Buffer = m_data->buffer_left[m_data->sel_pos_left];
         for (int x = 0; x < m_data->buffer_depth; x++) {
-           Buffer[x] = static_cast<double>(NAN);
+           OscilloscopeBufferWrite (Buffer, x, static_cast<double>(NAN));
         }
     }
 
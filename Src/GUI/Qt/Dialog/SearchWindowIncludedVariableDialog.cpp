@@ -52,15 +52,21 @@ SearchWindowIncludedVariableDialog::~SearchWindowIncludedVariableDialog()
 
 void SearchWindowIncludedVariableDialog::FillBlackboardVariableList()
 {
-    int index = 0;
+    int32_t Count;
     char name[BBVARI_NAME_SIZE];
 
     ui->BlackboardVariableListWidget->clear();
     INCLUDE_EXCLUDE_FILTER *Filter = ui->Filter->GetFilter();
-    while ((index = read_next_blackboard_vari (index, name, sizeof(name))) >= 0) {
-        if (CheckIncludeExcludeFilter (name, Filter)) {
-            ui->BlackboardVariableListWidget->addItem(CharToQString(name));
+    // Only the variables matching the main filter will be checked with the include/exclude lists
+    int *Vids = get_bbvari_ids_by_filter ((Filter->MainFilter != nullptr) ? Filter->MainFilter : "*", &Count);
+    if (Vids != nullptr) {
+        for (int x = 0; x < Count; x++) {
+            if ((GetBlackboardVariableName (Vids[x], name, sizeof(name)) == 0) &&
+                CheckIncludeExcludeFilter (name, Filter)) {
+                ui->BlackboardVariableListWidget->addItem(CharToQString(name));
+            }
         }
+        free_all_bbvari_ids (Vids);
     }
     FreeIncludeExcludeFilter(Filter);
 }
@@ -219,6 +219,7 @@ int TraceConfiguration::StringToDialog (QString &par_CfgFileContent)
     bool DatFlag = GetCfgEntry (Stream, HDREC_TEXT_FORMAT, nullptr, 1);
     bool MdfFlag = GetCfgEntry (Stream, HDREC_MDF_FORMAT, nullptr, 1);
     bool Mdf4Flag = GetCfgEntry (Stream, HDREC_MDF4_FORMAT, nullptr, 1);
+    bool ColumnFlag = GetCfgEntry (Stream, HDREC_COLUMN_FORMAT, nullptr, 1);
 
     // If there is nothing defined use DAT
     if (!MdfFlag) {
@@ -227,6 +228,7 @@ int TraceConfiguration::StringToDialog (QString &par_CfgFileContent)
     ui->FileFormatDatCheckBox->setChecked (DatFlag);
     ui->FileFormatMdfCheckBox->setChecked (MdfFlag);
     ui->FileFormatMdf4CheckBox->setChecked (Mdf4Flag);
+    ui->FileFormatColumnCheckBox->setChecked (ColumnFlag);
 
     if (GetCfgEntry (Stream, HDREC_DESCRIPTION_FILE, &Text, 1)) {
         ui->A2LFileNameLineEdit->setText (Text);
@@ -380,6 +382,7 @@ void TraceConfiguration::SetDefaultValues()
     ui->FileFormatDatCheckBox->setChecked (true);
     ui->FileFormatMdfCheckBox->setChecked (false);
     ui->FileFormatMdf4CheckBox->setChecked (false);
+    ui->FileFormatColumnCheckBox->setChecked (false);
     ui->TriggerEventComboBox->setCurrentText (QString ("@trigger not active"));
     ui->TriggerEventComboBox->setCurrentText (QString (">"));
     ui->TriggerValueLineEdit->setText (QString ("0"));
@@ -446,6 +449,11 @@ QString TraceConfiguration::DialogToString()
         Stream << "; Generate MDF4 files\n";
         Stream << "   MDF4_FORMAT\n";
     }
+    if (ui->FileFormatColumnCheckBox->isChecked()) {
+        FormatSecCounter++;
+        Stream << "; Generate column files\n";
+        Stream << "   COLUMN_FORMAT\n";
+    }
     if (ui->FileFormatDatCheckBox->isChecked()) {
         FormatSecCounter++;
         Stream << "; Generate text files\n";
@@ -33,6 +33,7 @@
 #define HDREC_SAMPLELEN     "HDRECORDER_SAMPLELENGTH"
 #define HDREC_MDF_FORMAT    "MDF_FORMAT"
 #define HDREC_MDF4_FORMAT   "MDF4_FORMAT"
+#define HDREC_COLUMN_FORMAT "COLUMN_FORMAT"
 #define HDREC_TEXT_FORMAT   "TEXT_FORMAT"
 #define HDREC_TRIGGER       "TRIGGER"
 #define HDREC_STARTVAR      "STARTVARLIST"
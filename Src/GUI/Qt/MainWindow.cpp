@@ -1661,6 +1661,8 @@ void MainWindow::menuSaveIniAs()
             write_process_list2ini ();
             if (s_main_ini_val.ConnectToRemoteMaster) {
                 rm_WriteBackVariableSectionCache();
+            } else {
+                flush_varinfos_to_ini();
             }
 
             if (IniFileDataBaseSave(GetMainFileDescriptor(), QStringToConstChar(DstFileName), INIFILE_DATABAE_OPERATION_RENAME)) {   // 1 -> do not delete from INI-DB only rename it!
@@ -1792,6 +1794,8 @@ void MainWindow::toolbarSaveIniFile()
     write_process_list2ini ();
     if (s_main_ini_val.ConnectToRemoteMaster) {
         rm_WriteBackVariableSectionCache();
+    } else {
+        flush_varinfos_to_ini();
     }
     char IniFileName[MAX_PATH];
     IniFileDataBaseGetFileNameByDescriptor(GetMainFileDescriptor(), IniFileName, sizeof(IniFileName));
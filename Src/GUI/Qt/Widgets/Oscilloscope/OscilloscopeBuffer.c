@@ -0,0 +1,181 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <float.h>
+#include <math.h>
+
+#include "MyMemory.h"
+#include "ThrowError.h"
+#include "OscilloscopeBuffer.h"
+#include "OscilloscopeLod.h"
+
+#define OSCILLOSCOPE_BUFFER_TYPES  8
+
+static const size_t ElementSizes[OSCILLOSCOPE_BUFFER_TYPES] = {1, 1, 2, 2, 4, 4, 4, 8};
+
+// Value range of the integer types
+static const double TypeMin[OSCILLOSCOPE_BUFFER_DWORD + 1] = {0.0, -128.0, 0.0, -32768.0, 0.0, -2147483648.0};
+static const double TypeMax[OSCILLOSCOPE_BUFFER_DWORD + 1] = {255.0, 127.0, 65535.0, 32767.0, 4294967295.0, 2147483647.0};
+
+// Can all values of par_Type be stored inside par_NewType without loss
+static int TypeContains (int par_NewType, int par_Type)
+{
+    if (par_NewType == OSCILLOSCOPE_BUFFER_DOUBLE) return 1;
+    if (par_Type >= OSCILLOSCOPE_BUFFER_FLOAT) return (par_NewType == par_Type);
+    if (par_NewType == OSCILLOSCOPE_BUFFER_FLOAT) return (par_Type <= OSCILLOSCOPE_BUFFER_WORD);  // 24 bit mantissa
+    return (TypeMin[par_NewType] <= TypeMin[par_Type]) && (TypeMax[par_NewType] >= TypeMax[par_Type]);
+}
+
+static int ValueFits (int par_Type, double par_Value)
+{
+    switch (par_Type) {
+    case OSCILLOSCOPE_BUFFER_DOUBLE:
+        return 1;
+    case OSCILLOSCOPE_BUFFER_FLOAT:
+        if (isnan (par_Value) || isinf (par_Value)) return 1;
+        return (fabs (par_Value) <= FLT_MAX) && ((double)(float)par_Value == par_Value);
+    default:
+        // the range check must be done before the cast
+        return (par_Value >= TypeMin[par_Type]) && (par_Value <= TypeMax[par_Type]) &&
+               ((double)(int64_t)par_Value == par_Value);
+    }
+}
+
+static void StoreValue (void *par_Data, int par_Type, int par_Index, double par_Value)
+{
+    switch (par_Type) {
+    case OSCILLOSCOPE_BUFFER_UBYTE:
+        ((uint8_t*)par_Data)[par_Index] = (uint8_t)par_Value;
+        break;
+    case OSCILLOSCOPE_BUFFER_BYTE:
+        ((int8_t*)par_Data)[par_Index] = (int8_t)par_Value;
+        break;
+    case OSCILLOSCOPE_BUFFER_UWORD:
+        ((uint16_t*)par_Data)[par_Index] = (uint16_t)par_Value;
+        break;
+    case OSCILLOSCOPE_BUFFER_WORD:
+        ((int16_t*)par_Data)[par_Index] = (int16_t)par_Value;
+        break;
+    case OSCILLOSCOPE_BUFFER_UDWORD:
+        ((uint32_t*)par_Data)[par_Index] = (uint32_t)par_Value;
+        break;
+    case OSCILLOSCOPE_BUFFER_DWORD:
+        ((int32_t*)par_Data)[par_Index] = (int32_t)par_Value;
+        break;
+    case OSCILLOSCOPE_BUFFER_FLOAT:
+        ((float*)par_Data)[par_Index] = (float)par_Value;
+        break;
+    default:
+        ((double*)par_Data)[par_Index] = par_Value;
+        break;
+    }
+}
+
+OSCILLOSCOPE_BUFFER *OscilloscopeBufferAlloc (int par_Depth)
+{
+    OSCILLOSCOPE_BUFFER *Ret;
+
+    Ret = (OSCILLOSCOPE_BUFFER*)my_calloc (1, sizeof (OSCILLOSCOPE_BUFFER));
+    if (Ret == NULL) return NULL;
+    Ret->type = OSCILLOSCOPE_BUFFER_UBYTE;
+    Ret->depth = par_Depth;
+    Ret->data = my_calloc ((size_t)par_Depth, ElementSizes[Ret->type]);
+    if (Ret->data == NULL) {
+        my_free (Ret);
+        return NULL;
+    }
+    return Ret;
+}
+
+void OscilloscopeBufferFree (OSCILLOSCOPE_BUFFER *par_Buffer)
+{
+    if (par_Buffer != NULL) {
+        if (par_Buffer->data != NULL) my_free (par_Buffer->data);
+        if (par_Buffer->invalid != NULL) my_free (par_Buffer->invalid);
+        OscilloscopeLodFree (&(par_Buffer->lod));
+        my_free (par_Buffer);
+    }
+}
+
+int OscilloscopeBufferResize (OSCILLOSCOPE_BUFFER *par_Buffer, int par_Depth)
+{
+    void *NewData;
+
+    NewData = my_realloc (par_Buffer->data, (size_t)par_Depth * ElementSizes[par_Buffer->type]);
+    if (NewData == NULL) return -1;
+    par_Buffer->data = NewData;
+    par_Buffer->depth = par_Depth;
+    if (par_Buffer->invalid != NULL) {
+        my_free (par_Buffer->invalid);
+        par_Buffer->invalid = NULL;
+    }
+    return 0;
+}
+
+static int WidenBuffer (OSCILLOSCOPE_BUFFER *par_Buffer, int par_NewType)
+{
+    void *NewData;
+    int x;
+
+    NewData = my_malloc ((size_t)par_Buffer->depth * ElementSizes[par_NewType]);
+    if (NewData == NULL) {
+        ThrowError (1, "out of memory");
+        return -1;
+    }
+    for (x = 0; x < par_Buffer->depth; x++) {
+        double Value = OscilloscopeBufferRead (par_Buffer, x, (double)NAN);
+        if (isnan (Value) && (par_NewType < OSCILLOSCOPE_BUFFER_FLOAT)) Value = 0.0;  // stays marked inside the bit field
+        StoreValue (NewData, par_NewType, x, Value);
+    }
+    my_free (par_Buffer->data);
+    par_Buffer->data = NewData;
+    par_Buffer->type = par_NewType;
+    if ((par_NewType >= OSCILLOSCOPE_BUFFER_FLOAT) && (par_Buffer->invalid != NULL)) {
+        // now NaN can be stored directly
+        my_free (par_Buffer->invalid);
+        par_Buffer->invalid = NULL;
+    }
+    return 0;
+}
+
+void OscilloscopeBufferWrite (OSCILLOSCOPE_BUFFER *par_Buffer, int par_Index, double par_Value)
+{
+    int Type = par_Buffer->type;
+
+    if (isnan (par_Value) && (Type < OSCILLOSCOPE_BUFFER_FLOAT)) {
+        if (par_Buffer->invalid == NULL) {
+            par_Buffer->invalid = (uint8_t*)my_calloc ((size_t)((par_Buffer->depth + 7) >> 3), 1);
+            if (par_Buffer->invalid == NULL) {
+                ThrowError (1, "out of memory");
+                return;
+            }
+        }
+        par_Buffer->invalid[par_Index >> 3] |= (uint8_t)(1 << (par_Index & 7));
+        return;
+    }
+    if (!ValueFits (Type, par_Value)) {
+        for (Type = Type + 1; Type < OSCILLOSCOPE_BUFFER_DOUBLE; Type++) {
+            if (TypeContains (Type, par_Buffer->type) && ValueFits (Type, par_Value)) break;
+        }
+        if (WidenBuffer (par_Buffer, Type)) return;
+    }
+    StoreValue (par_Buffer->data, Type, par_Index, par_Value);
+    if (par_Buffer->invalid != NULL) {
+        par_Buffer->invalid[par_Index >> 3] &= (uint8_t)~(1 << (par_Index & 7));
+    }
+}
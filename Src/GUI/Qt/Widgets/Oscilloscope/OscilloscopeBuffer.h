@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef OSCILLOSCOPEBUFFER_H
+#define OSCILLOSCOPEBUFFER_H
+
+#include <stdint.h>
+
+// Ring buffer memory of one oscilloscope signal.
+// The samples are not stored as double. The buffer starts with the smallest element type (8 bit)
+// and will be widened to the next type which can store all values without loss if a sample
+// doesn't fit anymore (8 -> 16 -> 32 bit -> float -> double). So a boolean or 8 bit signal
+// needs only 1 byte per sample. The time of a sample is implicit (t_step), there are no time stamps stored.
+// Invalid samples (NaN) inside an integer buffer are marked inside a bit field which
+// is only allocated if needed.
+
+#define OSCILLOSCOPE_BUFFER_UBYTE   0
+#define OSCILLOSCOPE_BUFFER_BYTE    1
+#define OSCILLOSCOPE_BUFFER_UWORD   2
+#define OSCILLOSCOPE_BUFFER_WORD    3
+#define OSCILLOSCOPE_BUFFER_UDWORD  4
+#define OSCILLOSCOPE_BUFFER_DWORD   5
+#define OSCILLOSCOPE_BUFFER_FLOAT   6
+#define OSCILLOSCOPE_BUFFER_DOUBLE  7
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct OSCILLOSCOPE_BUFFER_STRUCT {
+    void *data;
+    uint8_t *invalid;   // one bit for each sample, only exists if there was a NaN inside an integer buffer
+    int type;           // OSCILLOSCOPE_BUFFER_xxx
+    int depth;
+    struct OSCILLOSCOPE_LOD_STRUCT *lod;   // min./max. pyramid (OscilloscopeLod.h)
+} OSCILLOSCOPE_BUFFER;
+
+OSCILLOSCOPE_BUFFER *OscilloscopeBufferAlloc (int par_Depth);
+void OscilloscopeBufferFree (OSCILLOSCOPE_BUFFER *par_Buffer);
+// The content will be lost, the element type is kept
+int OscilloscopeBufferResize (OSCILLOSCOPE_BUFFER *par_Buffer, int par_Depth);
+// Store a sample, if it doesn't fit into the current element type the buffer will be widened
+void OscilloscopeBufferWrite (OSCILLOSCOPE_BUFFER *par_Buffer, int par_Index, double par_Value);
+
+static inline double OscilloscopeBufferRead (const OSCILLOSCOPE_BUFFER *par_Buffer, int par_Index, double par_NotANumber)
+{
+    if ((par_Buffer->invalid != NULL) && (par_Buffer->invalid[par_Index >> 3] & (1 << (par_Index & 7)))) {
+        return par_NotANumber;
+    }
+    switch (par_Buffer->type) {
+    case OSCILLOSCOPE_BUFFER_UBYTE:
+        return (double)((const uint8_t*)par_Buffer->data)[par_Index];
+    case OSCILLOSCOPE_BUFFER_BYTE:
+        return (double)((const int8_t*)par_Buffer->data)[par_Index];
+    case OSCILLOSCOPE_BUFFER_UWORD:
+        return (double)((const uint16_t*)par_Buffer->data)[par_Index];
+    case OSCILLOSCOPE_BUFFER_WORD:
+        return (double)((const int16_t*)par_Buffer->data)[par_Index];
+    case OSCILLOSCOPE_BUFFER_UDWORD:
+        return (double)((const uint32_t*)par_Buffer->data)[par_Index];
+    case OSCILLOSCOPE_BUFFER_DWORD:
+        return (double)((const int32_t*)par_Buffer->data)[par_Index];
+    case OSCILLOSCOPE_BUFFER_FLOAT:
+        return (double)((const float*)par_Buffer->data)[par_Index];
+    default:
+        return ((const double*)par_Buffer->data)[par_Index];
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OSCILLOSCOPEBUFFER_H
@@ -168,7 +168,7 @@ void OscilloscopeConfigDialog::accept()
 
                     if (m_Data->buffer_left[20] == nullptr) {
                         EnterOsziCycleCS ();
-                        if ((m_Data->buffer_left[20] = static_cast<double*>(my_calloc(static_cast<size_t>(m_Data->buffer_depth), sizeof (double)))) == nullptr) {
+                        if ((m_Data->buffer_left[20] = OscilloscopeBufferAlloc (m_Data->buffer_depth)) == nullptr) {
                             remove_bbvari_unknown_wait (m_Data->vids_left[20]);
                             m_Data->vids_left[20] = 0;
                             m_Data->trigger_vid = 0;
@@ -316,22 +316,17 @@ void OscilloscopeConfigDialog::accept()
             int i;
             m_Data->buffer_depth = k;
             EnterOsziCycleCS ();
-            double *tmp;
             for (i = 0; i < 21; i++) {
                 if (m_Data->buffer_left[i] != nullptr) {
-                    if ((tmp = static_cast<double*>(my_realloc (m_Data->buffer_left[i], static_cast<size_t>(k) * sizeof (double)))) == nullptr) {
+                    if (OscilloscopeBufferResize (m_Data->buffer_left[i], k)) {
                         err_flag = 1;
                         break;
-                    } else {
-                        m_Data->buffer_left[i] = tmp;
                     }
                 }
                 if (m_Data->buffer_right[i] != nullptr) {
-                    if ((tmp = static_cast<double*>(my_realloc (m_Data->buffer_right[i], static_cast<size_t>(k) * sizeof (double)))) == nullptr) {
+                    if (OscilloscopeBufferResize (m_Data->buffer_right[i], k)) {
                         err_flag = 1;
                         break;
-                    } else {
-                        m_Data->buffer_right[i] = tmp;
                     }
                 }
             }
@@ -341,14 +336,10 @@ void OscilloscopeConfigDialog::accept()
                 EnterOsziCycleCS ();
                 for (i--; i >= 0; i--) {
                     if (m_Data->buffer_left[i] != nullptr) {
-                        if ((tmp = static_cast<double*>(my_realloc (m_Data->buffer_left[i], static_cast<size_t>(m_Data->buffer_depth) * sizeof (double)))) != nullptr) {
-                            m_Data->buffer_left[i] = tmp;
-                        }
+                        OscilloscopeBufferResize (m_Data->buffer_left[i], m_Data->buffer_depth);
                     }
                     if (m_Data->buffer_right[i] != nullptr) {
-                        if ((tmp = static_cast<double*>(my_realloc (m_Data->buffer_right[i], static_cast<size_t>(m_Data->buffer_depth) * sizeof (double)))) != nullptr) {
-                            m_Data->buffer_right[i] = tmp;
-                        }
+                        OscilloscopeBufferResize (m_Data->buffer_right[i], m_Data->buffer_depth);
                     }
                }
                LeaveOsziCycleCS ();
@@ -30,6 +30,7 @@
 #include "Config.h"
 #include "OscilloscopeData.h"
 #include "OscilloscopeCyclic.h"
+#include "OscilloscopeLod.h"
 
 
 #define UNUSED(x) (void)(x)
@@ -90,6 +91,20 @@ typedef struct VID_OSZIWIN_SRUCT {
 static VID_OSZIWIN_REFELEM *owc_ref;
 static size_t owc_ref_size = 1000;
 
+// Flat copy of the vids_connect2 lists with direct pointers to the buffer fields,
+// will be rebuild inside update_vid_owc(). So a received frame can be scattered into
+// all oscilloscope buffers without walking through the lists.
+typedef struct {
+    OSCILLOSCOPE_DATA *poszidata;
+    OSCILLOSCOPE_BUFFER **buffer;
+    int *wr_poi;
+    int *depth;
+    int *new_since_last_draw;
+} OSZI_SCATTER_TARGET;
+
+static OSZI_SCATTER_TARGET *scatter_targets;   // owc_ref_size elements
+static int *scatter_first;                       // targets of stamp[x] are scatter_first[x] ... scatter_first[x+1]-1
+
 static size_t vid_owc_size = 1000;
 static int32_t *vids;
 static char *dec_phys_flags;
@@ -170,16 +185,12 @@ void LeaveOsziCycleCS (void)
     LEAVE_CS (&OsciCycleCriticalSection);
 }
 
-static int mbuffsize;
-static struct PIPE_VARI *mbuffer;
-
 static void CheckBuffer (int par_Lock)
 {
     static int BufferFlag = 0;
     if (par_Lock) EnterOsziCycleCS();
 
     if (!BufferFlag) {
-        mbuffsize = 0;
         reconnect_rdpipe = 0;
         connection_rdpipe = 0;
 
@@ -187,7 +198,9 @@ static void CheckBuffer (int par_Lock)
             ((vids = (int32_t*)my_calloc (vid_owc_size, sizeof (int32_t))) == NULL) ||
             ((dec_phys_flags = (char*)my_calloc (vid_owc_size, sizeof (char))) == NULL) ||
             ((vids_connect2 = (VID_OSZIWIN_REFELEM**)my_calloc (vid_owc_size, sizeof (VID_OSZIWIN_REFELEM*))) == NULL) ||
-             ((stamp = (double*)my_calloc (vid_owc_size, sizeof (double))) == NULL)) {
+             ((stamp = (double*)my_calloc (vid_owc_size, sizeof (double))) == NULL) ||
+             ((scatter_targets = (OSZI_SCATTER_TARGET*)my_calloc (owc_ref_size, sizeof (OSZI_SCATTER_TARGET))) == NULL) ||
+             ((scatter_first = (int*)my_calloc (vid_owc_size + 1, sizeof (int))) == NULL)) {
               if (par_Lock) LeaveOsziCycleCS();
               ThrowError (1, "not enough memory");
               return;
@@ -258,64 +271,44 @@ void SwitchAllSyncronOffline(void)
     LEAVE_CS (&OsciCycleCriticalSection);
 }
 
+// OsciCycleCriticalSection and all widget critical sections must be locked (LockAllOscilloscopes)
 static void stamp2oszibuffers (uint64_t timestamp)
 {
     OSCILLOSCOPE_DATA *poszidata;
-    VID_OSZIWIN_REFELEM *connect2;
-    int x, pos, left_right;
-    double /*float*/ *buffer;
+    OSZI_SCATTER_TARGET *Target, *End;
+    OSCILLOSCOPE_BUFFER *buffer;
+    int x;
     int wr_poi;
-    int depth;
-    uint64_t Time;
-    int new_since_last_draw;
 
-    ENTER_CS (&OsciCycleCriticalSection);
-
-    Time = timestamp;
     // Increment all oscilloscope buffer by one time slot
     for (x = 0; x < oszidata_count; x++) {
-        EnterOsciWidgetCriticalSection (all_oszidatas[x]->CriticalSectionNumber);
         if (all_oszidatas[x]->state) {
-            all_oszidatas[x]->t_current_buffer_end = Time;
+            all_oszidatas[x]->t_current_buffer_end = timestamp;
         }
     }
 
     for (x = 0; x < oszi_vari_count; x++) {
-        for (connect2 = vids_connect2[x]; connect2 != NULL; connect2 = connect2->next) {
-            poszidata = connect2->poszidata;
+        Target = scatter_targets + scatter_first[x];
+        End = scatter_targets + scatter_first[x+1];
+        for (; Target < End; Target++) {
+            poszidata = Target->poszidata;
             if (poszidata->state) {
-                pos = connect2->pos;
-                left_right = connect2->left_right;
-                if (left_right) {  /* Right */
-                    wr_poi = poszidata->wr_poi_right[pos];
-                    depth = poszidata->depth_right[pos];
-                    buffer = poszidata->buffer_right[pos];
-                    new_since_last_draw = poszidata->new_since_last_draw_right[pos];
-                } else {           /* Left */
-                    wr_poi = poszidata->wr_poi_left[pos];
-                    depth = poszidata->depth_left[pos];
-                    buffer = poszidata->buffer_left[pos];
-                    new_since_last_draw = poszidata->new_since_last_draw_left[pos];
-                }
+                wr_poi = *Target->wr_poi;
                 /* Tranfer stamp to buffer */
-                if (buffer != NULL) buffer[wr_poi] = stamp[x];
+                buffer = *Target->buffer;
+                if (buffer != NULL) {
+                    OscilloscopeBufferWrite (buffer, wr_poi, stamp[x]);
+                    OscilloscopeLodAddSample (buffer, wr_poi, stamp[x]);
+                }
                 /* Increment write pointer */
                 wr_poi++;
                 if (wr_poi >= poszidata->buffer_depth) {
                     wr_poi -= poszidata->buffer_depth;
                 }
-                if (new_since_last_draw < poszidata->buffer_depth) new_since_last_draw++;
-                else new_since_last_draw = poszidata->buffer_depth;
-                if (depth < poszidata->buffer_depth) depth++;
-                if (left_right) {  /* Right */
-                    poszidata->wr_poi_right[pos] = wr_poi;
-                    poszidata->depth_right[pos] = depth;
-                    poszidata->new_since_last_draw_right[pos] = new_since_last_draw;
-                } else {           /* Left */
-                    poszidata->wr_poi_left[pos] = wr_poi;
-                    poszidata->depth_left[pos] = depth;
-                    poszidata->new_since_last_draw_left[pos] = new_since_last_draw;
-                }
+                *Target->wr_poi = wr_poi;
+                if (*Target->new_since_last_draw < poszidata->buffer_depth) (*Target->new_since_last_draw)++;
+                else *Target->new_since_last_draw = poszidata->buffer_depth;
+                if (*Target->depth < poszidata->buffer_depth) (*Target->depth)++;
                 if ((poszidata->state == 1) &&            /* It is online and */
                     (poszidata->trigger_flag == 2)) {     /* pre-tigger ? */
                     if (poszidata->pre_trigger_counter == 0) {
@@ -325,10 +318,23 @@ static void stamp2oszibuffers (uint64_t timestamp)
             }
         }
     }
+}
+
+static void LockAllOscilloscopes (void)
+{
+    int x;
+    ENTER_CS (&OsciCycleCriticalSection);
     for (x = 0; x < oszidata_count; x++) {
-        LeaveOsciWidgetCriticalSection (all_oszidatas[x]->CriticalSectionNumber);
+        EnterOsciWidgetCriticalSection (all_oszidatas[x]->CriticalSectionNumber);
     }
+}
 
+static void UnlockAllOscilloscopes (void)
+{
+    int x;
+    for (x = 0; x < oszidata_count; x++) {
+        LeaveOsciWidgetCriticalSection (all_oszidatas[x]->CriticalSectionNumber);
+    }
     LEAVE_CS (&OsciCycleCriticalSection);
 }
 
@@ -336,7 +342,6 @@ static void message2stamp_copy (struct PIPE_VARI *mbuffer, int varicount)
 {
     int x, y, y_save;
 
-    ENTER_CS (&OsciCycleCriticalSection);
     y = 0;
     for (x = 0; x < varicount; x++) {
           for (y_save = y; y <= oszi_vari_count; y++) {
@@ -387,10 +392,10 @@ static void message2stamp_copy (struct PIPE_VARI *mbuffer, int varicount)
             }
         }
     }
-    LEAVE_CS (&OsciCycleCriticalSection);
 }
 
-void message2stamp (struct PIPE_VARI *mbuffer, uint64_t ts, int varicount)
+// OsciCycleCriticalSection and all widget critical sections must be locked (LockAllOscilloscopes)
+static void message2stamp (struct PIPE_VARI *mbuffer, uint64_t ts, int varicount)
 {
     int i = 0;
 
@@ -496,6 +501,34 @@ int remove_connection (int32_t vid, char dec_phys_flag, int left_right, int pos,
     return -1;
 }
 
+static void BuildScatterTable (void)
+{
+    int x, n = 0;
+    VID_OSZIWIN_REFELEM *connect2;
+
+    for (x = 0; x < oszi_vari_count; x++) {
+        scatter_first[x] = n;
+        for (connect2 = vids_connect2[x]; (connect2 != NULL) && (n < (int)owc_ref_size); connect2 = connect2->next) {
+            OSCILLOSCOPE_DATA *poszidata = connect2->poszidata;
+            int pos = connect2->pos;
+            scatter_targets[n].poszidata = poszidata;
+            if (connect2->left_right) {  /* Right */
+                scatter_targets[n].buffer = &(poszidata->buffer_right[pos]);
+                scatter_targets[n].wr_poi = &(poszidata->wr_poi_right[pos]);
+                scatter_targets[n].depth = &(poszidata->depth_right[pos]);
+                scatter_targets[n].new_since_last_draw = &(poszidata->new_since_last_draw_right[pos]);
+            } else {                     /* Left */
+                scatter_targets[n].buffer = &(poszidata->buffer_left[pos]);
+                scatter_targets[n].wr_poi = &(poszidata->wr_poi_left[pos]);
+                scatter_targets[n].depth = &(poszidata->depth_left[pos]);
+                scatter_targets[n].new_since_last_draw = &(poszidata->new_since_last_draw_left[pos]);
+            }
+            n++;
+        }
+    }
+    scatter_first[oszi_vari_count] = n;
+}
+
 int update_vid_owc (OSCILLOSCOPE_DATA *poszidata)
 {
      size_t x;
@@ -595,13 +628,12 @@ int update_vid_owc (OSCILLOSCOPE_DATA *poszidata)
             }
         }
         oszi_vari_count = y;   /* Store the number of variables */
+        BuildScatterTable ();
     }
     LEAVE_CS (&OsciCycleCriticalSection);
     return 0;
 }
 
-static uint64_t wrflag;
-
 static int ErrorTimoutFlag;
 static uint64_t ErrorTimout;
 static int logon_rdpipe (void)
@@ -662,13 +694,8 @@ static int logon_rdpipe (void)
             ThrowError (1, "pipe overflow\n");
             return -1;
         }
-        /* Fetch free WR flag */
-        if (get_free_wrflag ((PID)GET_PID (), &wrflag)) {
-            ThrowError (1, "no free WR-flag");
-            return -1;
-        }
-        /* Send WR flag "TraceQueue" process */
-        if (WriteToFiFo (OscilloscopeReqFiFo, RDPIPE_SEND_WRFLAG, GET_PID(), get_timestamp_counter(), sizeof (uint64_t), (char*)&wrflag)) {
+        /* Start the "TraceQueue" process */
+        if (WriteToFiFo (OscilloscopeReqFiFo, RDPIPE_START, GET_PID(), get_timestamp_counter(), 0, NULL)) {
             ThrowError (1, "pipe overflow");
             return -1;
         }
@@ -681,7 +708,9 @@ void cyclic_oszi (void)
 {
     int varicount;
     FIFO_ENTRY_HEADER Header;
+    struct PIPE_VARI *Frame;
     int message_count = 0;
+    int Locked = 0;
 
     if (reconnect_rdpipe) {
         switch (logon_rdpipe ()) {
@@ -703,15 +732,18 @@ void cyclic_oszi (void)
                                      /* but only 20 messages in one cycle */
             switch (Header.MessageId) {      /* which one */
             case RECORD_MESSAGE:    /* Data message */
-                if (Header.Size > mbuffsize) {  /* Are the buffer large enough? */
-                    mbuffsize = Header.Size;
-                    mbuffer = (struct PIPE_VARI*)my_realloc (mbuffer, mbuffsize);
-                }
-                /* Read message content */
-                ReadFromFiFo (OscilloscopeDataFiFo, &Header, (char*)mbuffer, mbuffsize);
+                // Use the message content directly inside the fifo (no copy)
+                Frame = (struct PIPE_VARI*)PeekFiFoMessage (OscilloscopeDataFiFo, &Header);
+                if (Frame == NULL) break;
                 varicount = Header.Size / (int)sizeof (struct PIPE_VARI);
 
-                message2stamp (mbuffer, Header.Timestamp, varicount);
+                // Lock only once for all frames received inside this cycle
+                if (!Locked) {
+                    LockAllOscilloscopes ();
+                    Locked = 1;
+                }
+                message2stamp (Frame, Header.Timestamp, varicount);
+                RemoveOneMessageFromFiFo (OscilloscopeDataFiFo);
                 break;
             case RDPIPE_ACK:
                 RemoveOneMessageFromFiFo (OscilloscopeDataFiFo);
@@ -722,6 +754,7 @@ void cyclic_oszi (void)
                 break;
             }
         }
+        if (Locked) UnlockAllOscilloscopes ();
         if (CheckFiFo (OscilloscopeAckFiFo, &Header) > 0) {
             switch (Header.MessageId) {      /* If yes which one */
             case RDPIPE_ACK:
@@ -772,8 +805,10 @@ void terminate_oszi (void)
     vids_connect2 = NULL;
     if (stamp != NULL) my_free (stamp);
     stamp = NULL;
-    if (mbuffer != NULL) my_free (mbuffer);
-    mbuffer = NULL;
+    if (scatter_targets != NULL) my_free (scatter_targets);
+    scatter_targets = NULL;
+    if (scatter_first != NULL) my_free (scatter_first);
+    scatter_first = NULL;
     LEAVE_CS (&OsciCycleCriticalSection);
 
     DeleteFiFo (OscilloscopeAckFiFo, GET_PID());
@@ -33,6 +33,7 @@ extern "C" {
 #include <float.h>
 #include "Wildcards.h"  // wegen INCLUDE_EXCLUDE_FILTER
 #endif
+#include "OscilloscopeBuffer.h"
 
 
 #define MAX_OSCILLOSCOPE_WINDOWS       100
@@ -71,8 +72,8 @@ typedef struct OSCILLOSCOPE_DATA_STRUCT {
     char *name_right[21];
 
     int buffer_depth;
-    double *buffer_left[21];
-    double *buffer_right[21];
+    OSCILLOSCOPE_BUFFER *buffer_left[21];
+    OSCILLOSCOPE_BUFFER *buffer_right[21];
     int wr_poi_left[21];
     int depth_left[21];
     int wr_poi_right[21];
@@ -162,7 +163,7 @@ typedef struct OSCILLOSCOPE_DATA_STRUCT {
 } OSCILLOSCOPE_DATA;
 #pragma pack(pop)
 
-inline double FiFoPosRight (OSCILLOSCOPE_DATA *par_Data, int par_Index, uint64_t par_t)
+static inline double FiFoPosRight (OSCILLOSCOPE_DATA *par_Data, int par_Index, uint64_t par_t)
 {
     if (par_t <= par_Data->t_current_to_update_end) {
         int BufferPos = (int)(((par_Data->t_current_to_update_end - par_t) / par_Data->t_step));
@@ -172,7 +173,7 @@ inline double FiFoPosRight (OSCILLOSCOPE_DATA *par_Data, int par_Index, uint64_t
             int MemPos =  Wr - 1 - BufferPos;
             if (MemPos < 0) MemPos = Depth + MemPos;
             if (MemPos >= 0) {
-                double Value = par_Data->buffer_right[par_Index][MemPos];
+                double Value = OscilloscopeBufferRead (par_Data->buffer_right[par_Index], MemPos, par_Data->NotANumber);
                 return Value;
             }
         }
@@ -180,7 +181,7 @@ inline double FiFoPosRight (OSCILLOSCOPE_DATA *par_Data, int par_Index, uint64_t
     return par_Data->NotANumber;
 }
 
-inline double FiFoPosLeft (OSCILLOSCOPE_DATA *par_Data, int par_Index, uint64_t par_t)
+static inline double FiFoPosLeft (OSCILLOSCOPE_DATA *par_Data, int par_Index, uint64_t par_t)
 {
     if (par_t <= par_Data->t_current_to_update_end) {
         int BufferPos = (int)(((par_Data->t_current_to_update_end - par_t) / par_Data->t_step));
@@ -190,7 +191,7 @@ inline double FiFoPosLeft (OSCILLOSCOPE_DATA *par_Data, int par_Index, uint64_t
             int MemPos =  Wr - 1 - BufferPos;
             if (MemPos < 0) MemPos = Depth + MemPos;
             if (MemPos >= 0) {
-                double Value = par_Data->buffer_left[par_Index][MemPos];
+                double Value = OscilloscopeBufferRead (par_Data->buffer_left[par_Index], MemPos, par_Data->NotANumber);
                 return Value;
             }
         }
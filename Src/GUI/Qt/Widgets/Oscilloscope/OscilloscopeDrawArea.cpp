@@ -35,6 +35,7 @@ extern "C" {
     #include "FileExtensions.h"
     #include "OscilloscopeFile.h"
 }
+#include "OscilloscopeLod.h"
 
 //#define DEBUG_PRINT_TO_FILE
 
@@ -99,6 +100,56 @@ static QPen BuildPen(int par_LineWidth, int par_Color)
     return Pen;
 }
 
+// If there are many samples per pixel column paint only one vertical line from the min. to the max.
+// value of each column. The min./max. values are taken from the pyramid (OscilloscopeLod.c)
+// so the peaks are preserved without walking through all raw samples.
+void OscilloscopeDrawArea::PaintTimeLineMinMaxToPixmap(QPainter &painter, int par_LeftRight, int par_Index, int par_StartXPos, int par_EndXPos, uint64_t par_EndXTime)
+{
+    uint64_t w = static_cast<uint64_t>(width());
+    uint64_t d = m_Data->t_window_end - m_Data->t_window_start;
+    int win_height = height();
+    double win_height_d = static_cast<double>(win_height);
+    double win_height_p20_d = win_height_d + 20;
+    double Min = par_LeftRight ? m_Data->min_right[par_Index] : m_Data->min_left[par_Index];
+    double Max = par_LeftRight ? m_Data->max_right[par_Index] : m_Data->max_left[par_Index];
+    bool Points = (par_LeftRight ? m_Data->presentation_right[par_Index] : m_Data->presentation_left[par_Index]) == 1;
+    int x_m1 = -2, y1_m1 = 0, y2_m1 = 0;
+
+    for (int x = par_StartXPos; x <= par_EndXPos; x++) {
+        uint64_t tFrom = my_umuldiv64(static_cast<uint64_t>(x), d, w) + m_Data->t_window_start;
+        uint64_t tTo = my_umuldiv64(static_cast<uint64_t>(x + 1), d, w) + m_Data->t_window_start;
+        if (tFrom > par_EndXTime) break;
+        double ValueMin, ValueMax;
+        if (OscilloscopeLodMinMaxOfTimeRange (m_Data, par_LeftRight, par_Index, tFrom, tTo, &ValueMin, &ValueMax)) {
+            double y1_d = (((ValueMax - Min) / (Max - Min) - m_Data->y_off[m_Data->zoom_pos]) * m_Data->y_zoom[m_Data->zoom_pos] * win_height_d);
+            double y2_d = (((ValueMin - Min) / (Max - Min) - m_Data->y_off[m_Data->zoom_pos]) * m_Data->y_zoom[m_Data->zoom_pos] * win_height_d);
+            if (y1_d > win_height_p20_d) y1_d = win_height_p20_d;
+            if (y1_d < -20.0) y1_d = -20.0;  // Line width  max. 40 pixel
+            if (y2_d > win_height_p20_d) y2_d = win_height_p20_d;
+            if (y2_d < -20.0) y2_d = -20.0;
+            int y1 = win_height - static_cast<int>(y1_d + 0.5);   // max. value (upper pixel)
+            int y2 = win_height - static_cast<int>(y2_d + 0.5);   // min. value (lower pixel)
+            if (Points) {
+                painter.drawPoint(x, y1);
+                if (y2 != y1) painter.drawPoint(x, y2);
+            } else {
+                int yl1 = y1;
+                int yl2 = y2;
+                if (x_m1 == (x - 1)) {
+                    // connect to the column before
+                    if (yl1 > y2_m1) yl1 = y2_m1;
+                    if (yl2 < y1_m1) yl2 = y1_m1;
+                }
+                if (yl1 == yl2) painter.drawPoint(x, yl1);
+                else painter.drawLine (x, yl1, x, yl2);
+            }
+            x_m1 = x;
+            y1_m1 = y1;
+            y2_m1 = y2;
+        }
+    }
+}
+
 void OscilloscopeDrawArea::PaintTimeLineToPixmap(QPainter &painter, QRect par_Rec)
 {
     int i;
@@ -133,12 +184,18 @@ void OscilloscopeDrawArea::PaintTimeLineToPixmap(QPainter &painter, QRect par_Re
         int win_height = height();
         double win_height_d = static_cast<double>(win_height);
         double win_height_p20_d = win_height_d + 20;  // Easyer for out of window hight check, the max. line with is limited to 40 pixek
+        // Zoomed out so far that there are a lot of samples inside one pixel column?
+        bool UseMinMax = (d / m_Data->t_step) >= (static_cast<uint64_t>(OSCILLOSCOPE_LOD_MIN_SAMPLES_PER_PIXEL) * w);
 
         // First paint all lines on the right side
         for (i = 0; i < 20; i++) {
             if ((m_Data->vids_right[i] > 0) && (!m_Data->vars_disable_right[i])) {
                 // set the color
                 painter.setPen (BuildPen(m_Data->LineSize_right[i], m_Data->color_right[i]));
+                if (UseMinMax) {
+                    PaintTimeLineMinMaxToPixmap(painter, 1, i, StartXPos, EndXPos, EndXTime);
+                    continue;
+                }
                 uint64_t t = StartXTime;
                 int x_m1, y_m1, valid_m1 = 0;
                 double ymax = -DBL_MAX;
@@ -238,6 +295,10 @@ void OscilloscopeDrawArea::PaintTimeLineToPixmap(QPainter &painter, QRect par_Re
             if ((m_Data->vids_left[i] > 0) && (!m_Data->vars_disable_left[i])) {
                 // set the color
                 painter.setPen (BuildPen(m_Data->LineSize_left[i], m_Data->color_left[i]));
+                if (UseMinMax) {
+                    PaintTimeLineMinMaxToPixmap(painter, 0, i, StartXPos, EndXPos, EndXTime);
+                    continue;
+                }
                 uint64_t t = StartXTime;
                 int x_m1, y_m1, valid_m1 = 0;
                 double ymax = -DBL_MAX;
@@ -578,8 +639,8 @@ void OscilloscopeDrawArea::PaintXYToPixmap(QPainter &painter)
                 int IdxX = m_Data->wr_poi_left[i+1] - Idx;
                 if (IdxX < 0) IdxX = m_Data->buffer_depth + IdxX;
 
-                double ValueY = m_Data->buffer_left[i][IdxY];
-                double ValueX = m_Data->buffer_left[i+1][IdxX];
+                double ValueY = OscilloscopeBufferRead (m_Data->buffer_left[i], IdxY, m_Data->NotANumber);
+                double ValueX = OscilloscopeBufferRead (m_Data->buffer_left[i+1], IdxX, m_Data->NotANumber);
                 if (!_isnan (ValueX) && !_isnan (ValueY)) {
 
                     double y_d = ValueY * YFactor + YOffset;
@@ -635,8 +696,8 @@ void OscilloscopeDrawArea::PaintXYToPixmap(QPainter &painter)
                 int IdxX = m_Data->wr_poi_right[i+1] - Idx;
                 if (IdxX < 0) IdxX = m_Data->buffer_depth + IdxX;
 
-                double ValueY = m_Data->buffer_right[i][IdxY];
-                double ValueX = m_Data->buffer_right[i+1][IdxX];
+                double ValueY = OscilloscopeBufferRead (m_Data->buffer_right[i], IdxY, m_Data->NotANumber);
+                double ValueX = OscilloscopeBufferRead (m_Data->buffer_right[i+1], IdxX, m_Data->NotANumber);
                 if (!_isnan (ValueX) && !_isnan (ValueY)) {
 
                     double y_d = ValueY * YFactor + YOffset;
@@ -701,8 +762,8 @@ bool OscilloscopeDrawArea::PickingXYPoint(int x, int y, uint64_t *ret_Time)
                 int IdxX = m_Data->wr_poi_left[i+1] - Idx;
                 if (IdxX < 0) IdxX = m_Data->buffer_depth + IdxX;
 
-                double ValueY = m_Data->buffer_left[i][IdxY];
-                double ValueX = m_Data->buffer_left[i+1][IdxX];
+                double ValueY = OscilloscopeBufferRead (m_Data->buffer_left[i], IdxY, m_Data->NotANumber);
+                double ValueX = OscilloscopeBufferRead (m_Data->buffer_left[i+1], IdxX, m_Data->NotANumber);
                 if (!_isnan (ValueY) && !_isnan (ValueY)) {
 
                     double y_d = ValueY * YFactor + YOffset;
@@ -743,8 +804,8 @@ bool OscilloscopeDrawArea::PickingXYPoint(int x, int y, uint64_t *ret_Time)
                 int IdxX = m_Data->wr_poi_right[i+1] - Idx;
                 if (IdxX < 0) IdxX = m_Data->buffer_depth + IdxX;
 
-                double ValueY = m_Data->buffer_right[i][IdxY];
-                double ValueX = m_Data->buffer_right[i+1][IdxX];
+                double ValueY = OscilloscopeBufferRead (m_Data->buffer_right[i], IdxY, m_Data->NotANumber);
+                double ValueX = OscilloscopeBufferRead (m_Data->buffer_right[i+1], IdxX, m_Data->NotANumber);
                 if (!_isnan (ValueY) && !_isnan (ValueY)) {
 
                     double y_d = ValueY * YFactor + YOffset;
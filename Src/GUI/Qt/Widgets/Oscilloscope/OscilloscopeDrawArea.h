@@ -87,6 +87,7 @@ protected:
 
 private:
     void PaintTimeLineToPixmap(QPainter &painter, QRect par_Rec);
+    void PaintTimeLineMinMaxToPixmap(QPainter &painter, int par_LeftRight, int par_Index, int par_StartXPos, int par_EndXPos, uint64_t par_EndXTime);
     void PaintXYToPixmap(QPainter &painter);
     bool PickingXYPoint(int x, int y, uint64_t *ret_Time);
     QPen CursorPen;
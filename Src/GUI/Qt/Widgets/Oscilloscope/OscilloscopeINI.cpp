@@ -210,7 +210,7 @@ void read_osziwin_ini (const char *SectionName, OSCILLOSCOPE_DATA* poszidata)
             poszidata->name_trigger = StringRealloc (poszidata->name_trigger, txt2);
             poszidata->name_left[20] = StringRealloc (poszidata->name_left[20], txt2);
 
-            if ((poszidata->buffer_left[20] = (double*)my_calloc ((size_t)poszidata->buffer_depth, sizeof (double))) == NULL) {
+            if ((poszidata->buffer_left[20] = OscilloscopeBufferAlloc (poszidata->buffer_depth)) == NULL) {
                 remove_bbvari_unknown_wait (poszidata->vids_left[20]);
                 poszidata->vids_left[20] = 0;
                 poszidata->trigger_vid = 0;
@@ -233,7 +233,7 @@ void read_osziwin_ini (const char *SectionName, OSCILLOSCOPE_DATA* poszidata)
             ((vid = add_bbvari (vari_name, BB_UNKNOWN_WAIT, NULL)) > 0)) {
             poszidata->vids_left[x] = vid;
             poszidata->name_left[x] = StringRealloc (poszidata->name_left[x], vari_name);
-            if ((poszidata->buffer_left[x] = (double*)my_calloc ((size_t)poszidata->buffer_depth, sizeof(double))) == NULL) {
+            if ((poszidata->buffer_left[x] = OscilloscopeBufferAlloc (poszidata->buffer_depth)) == NULL) {
                 ThrowError (1, "no free memory");
                 poszidata->vids_left[x] = 0;
             }
@@ -314,7 +314,7 @@ void read_osziwin_ini (const char *SectionName, OSCILLOSCOPE_DATA* poszidata)
             ((vid = add_bbvari (vari_name, BB_UNKNOWN_WAIT, NULL)) > 0)) {
             poszidata->vids_right[x] = vid;
             poszidata->name_right[x] = StringRealloc (poszidata->name_right[x], vari_name);
-            if ((poszidata->buffer_right[x] = (double*)my_calloc ((size_t)poszidata->buffer_depth, sizeof(double))) == NULL) {
+            if ((poszidata->buffer_right[x] = OscilloscopeBufferAlloc (poszidata->buffer_depth)) == NULL) {
                 ThrowError (1, "no free memory");
                 poszidata->vids_right[x] = 0;
             }
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <float.h>
+#include <math.h>
+
+#include "MyMemory.h"
+#include "OscilloscopeData.h"
+#include "OscilloscopeLod.h"
+
+#define LOD_BUCKET_SIZE(k)  (1 << (OSCILLOSCOPE_LOD_SHIFT * ((k) + 1)))
+
+static void FreeLevels (OSCILLOSCOPE_LOD *par_Lod)
+{
+    int k;
+    for (k = 0; k < par_Lod->level_count; k++) {
+        if (par_Lod->min[k] != NULL) my_free (par_Lod->min[k]);
+        if (par_Lod->max[k] != NULL) my_free (par_Lod->max[k]);
+        par_Lod->min[k] = NULL;
+        par_Lod->max[k] = NULL;
+    }
+    par_Lod->level_count = 0;
+}
+
+// Build the complete pyramid from the raw buffer. Only the samples below par_WrPoi are
+// taken into account for the bucket which will be currently written.
+static int RebuildLod (OSCILLOSCOPE_LOD *par_Lod, OSCILLOSCOPE_BUFFER *par_Buffer, int par_WrPoi)
+{
+    int k, b, i;
+    int BufferDepth = par_Buffer->depth;
+
+    FreeLevels (par_Lod);
+    par_Lod->buffer_depth = BufferDepth;
+
+    for (k = 0; (k < OSCILLOSCOPE_LOD_MAX_LEVELS) && ((2 * LOD_BUCKET_SIZE(k)) <= BufferDepth); k++) {
+        int Size = LOD_BUCKET_SIZE(k);
+        int Buckets = (BufferDepth + Size - 1) / Size;
+        par_Lod->min[k] = (double*)my_malloc ((size_t)Buckets * sizeof(double));
+        par_Lod->max[k] = (double*)my_malloc ((size_t)Buckets * sizeof(double));
+        par_Lod->level_count = k + 1;
+        if ((par_Lod->min[k] == NULL) || (par_Lod->max[k] == NULL)) {
+            FreeLevels (par_Lod);
+            return -1;
+        }
+        for (b = 0; b < Buckets; b++) {
+            int Start = b * Size;
+            double Min = DBL_MAX;
+            double Max = -DBL_MAX;
+            if (k == 0) {
+                int End = Start + Size;
+                if (End > BufferDepth) End = BufferDepth;
+                if ((Start < par_WrPoi) && (End > par_WrPoi)) End = par_WrPoi;
+                for (i = Start; i < End; i++) {
+                    double Value = OscilloscopeBufferRead (par_Buffer, i, (double)NAN);
+                    // NaN values will be ignored by both compares
+                    if (Value < Min) Min = Value;
+                    if (Value > Max) Max = Value;
+                }
+            } else {
+                // merge the 8 buckets of the level below
+                int ChildSize = LOD_BUCKET_SIZE(k - 1);
+                int ChildBuckets = (BufferDepth + ChildSize - 1) / ChildSize;
+                int c = b << OSCILLOSCOPE_LOD_SHIFT;
+                int ce = c + (1 << OSCILLOSCOPE_LOD_SHIFT);
+                if (ce > ChildBuckets) ce = ChildBuckets;
+                for (; c < ce; c++) {
+                    if ((Start < par_WrPoi) && ((c * ChildSize) >= par_WrPoi)) break;
+                    if (par_Lod->min[k-1][c] < Min) Min = par_Lod->min[k-1][c];
+                    if (par_Lod->max[k-1][c] > Max) Max = par_Lod->max[k-1][c];
+                }
+            }
+            par_Lod->min[k][b] = Min;
+            par_Lod->max[k][b] = Max;
+        }
+    }
+    return 0;
+}
+
+void OscilloscopeLodAddSample (OSCILLOSCOPE_BUFFER *par_Buffer, int par_WrPoi, double par_Value)
+{
+    OSCILLOSCOPE_LOD *Lod = par_Buffer->lod;
+    int k;
+
+    if (Lod == NULL) {
+        Lod = (OSCILLOSCOPE_LOD*)my_calloc (1, sizeof (OSCILLOSCOPE_LOD));
+        if (Lod == NULL) return;
+        par_Buffer->lod = Lod;
+    }
+    if (Lod->buffer_depth != par_Buffer->depth) {
+        // the sample is already inside the raw buffer.
+        // If there is not enough memory the pyramid has no levels and the raw samples will be used
+        RebuildLod (Lod, par_Buffer, par_WrPoi + 1);
+        return;
+    }
+    for (k = 0; k < Lod->level_count; k++) {
+        int Size = LOD_BUCKET_SIZE(k);
+        int b = par_WrPoi >> (OSCILLOSCOPE_LOD_SHIFT * (k + 1));
+        if ((par_WrPoi & (Size - 1)) == 0) {
+            // first sample of this bucket, forget the overwritten ones
+            if (par_Value != par_Value) {  // NaN
+                Lod->min[k][b] = DBL_MAX;
+                Lod->max[k][b] = -DBL_MAX;
+            } else {
+                Lod->min[k][b] = par_Value;
+                Lod->max[k][b] = par_Value;
+            }
+        } else {
+            int Changed = 0;
+            if (par_Value < Lod->min[k][b]) {
+                Lod->min[k][b] = par_Value;
+                Changed = 1;
+            }
+            if (par_Value > Lod->max[k][b]) {
+                Lod->max[k][b] = par_Value;
+                Changed = 1;
+            }
+            // the levels above include this bucket, so they are not changed too
+            if (!Changed) break;
+        }
+    }
+}
+
+void OscilloscopeLodFree (OSCILLOSCOPE_LOD **par_Lod)
+{
+    if (*par_Lod != NULL) {
+        FreeLevels (*par_Lod);
+        my_free (*par_Lod);
+        *par_Lod = NULL;
+    }
+}
+
+// Min./max. of the memory positions par_From...par_To (including) without wrap around
+static void MinMaxOfMemRange (OSCILLOSCOPE_LOD *par_Lod, OSCILLOSCOPE_BUFFER *par_Buffer, int par_WrPoi,
+                              int par_From, int par_To, double *ref_Min, double *ref_Max)
+{
+    double Min = *ref_Min;
+    double Max = *ref_Max;
+    int Pos = par_From;
+
+    while (Pos <= par_To) {
+        int k;
+        for (k = par_Lod->level_count - 1; k >= 0; k--) {
+            int Size = LOD_BUCKET_SIZE(k);
+            if (((Pos & (Size - 1)) == 0) &&
+                ((Pos + Size - 1) <= par_To) &&
+                !((Pos < par_WrPoi) && ((Pos + Size) > par_WrPoi))) {  // this bucket will be currently written
+                int b = Pos >> (OSCILLOSCOPE_LOD_SHIFT * (k + 1));
+                if (par_Lod->min[k][b] < Min) Min = par_Lod->min[k][b];
+                if (par_Lod->max[k][b] > Max) Max = par_Lod->max[k][b];
+                Pos += Size;
+                break;
+            }
+        }
+        if (k < 0) {
+            double Value = OscilloscopeBufferRead (par_Buffer, Pos, (double)NAN);
+            if (Value < Min) Min = Value;
+            if (Value > Max) Max = Value;
+            Pos++;
+        }
+    }
+    *ref_Min = Min;
+    *ref_Max = Max;
+}
+
+int OscilloscopeLodMinMaxOfTimeRange (OSCILLOSCOPE_DATA *par_Data, int par_LeftRight, int par_Index,
+                                      uint64_t par_tFrom, uint64_t par_tTo,
+                                      double *ret_Min, double *ret_Max)
+{
+    OSCILLOSCOPE_LOD *Lod, Empty;
+    OSCILLOSCOPE_BUFFER *Buffer;
+    int Depth, Wr;
+    int64_t nLo, nHi;
+    int From, To;
+    double Min = DBL_MAX;
+    double Max = -DBL_MAX;
+
+    if (par_LeftRight) {
+        Buffer = par_Data->buffer_right[par_Index];
+        Depth = par_Data->depth_right[par_Index];
+        Wr = par_Data->wr_poi_right[par_Index];
+    } else {
+        Buffer = par_Data->buffer_left[par_Index];
+        Depth = par_Data->depth_left[par_Index];
+        Wr = par_Data->wr_poi_left[par_Index];
+    }
+    if ((Buffer == NULL) || (par_tFrom > par_Data->t_current_to_update_end)) return 0;
+    Lod = Buffer->lod;
+    if ((Lod == NULL) || (Lod->buffer_depth != Buffer->depth)) {
+        // no valid pyramid, use the raw samples
+        Empty.level_count = 0;
+        Lod = &Empty;
+    }
+    // sample n (0 is the newest one) belongs to the time range
+    // t_current_to_update_end - n * t_step ... t_current_to_update_end - (n + 1) * t_step
+    nHi = (int64_t)((par_Data->t_current_to_update_end - par_tFrom) / par_Data->t_step);
+    if (par_tTo >= par_Data->t_current_to_update_end) nLo = 0;
+    else nLo = (int64_t)((par_Data->t_current_to_update_end - par_tTo) / par_Data->t_step);
+    if (nHi >= Depth) nHi = Depth - 1;
+    if (nLo > nHi) return 0;
+
+    From = Wr - 1 - (int)nHi;
+    To = Wr - 1 - (int)nLo;
+    if (From >= 0) {
+        MinMaxOfMemRange (Lod, Buffer, Wr, From, To, &Min, &Max);
+    } else if (To < 0) {
+        MinMaxOfMemRange (Lod, Buffer, Wr, From + Depth, To + Depth, &Min, &Max);
+    } else {
+        MinMaxOfMemRange (Lod, Buffer, Wr, From + Depth, Depth - 1, &Min, &Max);
+        MinMaxOfMemRange (Lod, Buffer, Wr, 0, To, &Min, &Max);
+    }
+    if (Min > Max) return 0;   // only NaN values
+    *ret_Min = Min;
+    *ret_Max = Max;
+    return 1;
+}
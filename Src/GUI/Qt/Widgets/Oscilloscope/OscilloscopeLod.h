@@ -0,0 +1,62 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef OSCILLOSCOPELOD_H
+#define OSCILLOSCOPELOD_H
+
+#include "OscilloscopeData.h"
+
+// Min./max. pyramid (level of detail) for one oscilloscope ring buffer.
+// Level k combines 8^(k+1) raw samples (aligned to the ring buffer memory position).
+// The pyramid will be updated with each new sample inside stamp2oszibuffers(),
+// so the draw area can paint one vertical min./max. line per pixel column
+// without walking through all raw samples if the time axis is zoomed out.
+
+#define OSCILLOSCOPE_LOD_SHIFT        3     // each level combines 8 entries of the level below
+#define OSCILLOSCOPE_LOD_MAX_LEVELS   8
+// Below this number of samples per pixel column the raw samples will be painted
+#define OSCILLOSCOPE_LOD_MIN_SAMPLES_PER_PIXEL  16
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct OSCILLOSCOPE_LOD_STRUCT {
+    int buffer_depth;      // the pyramid was build for this depth
+    int level_count;
+    double *min[OSCILLOSCOPE_LOD_MAX_LEVELS];
+    double *max[OSCILLOSCOPE_LOD_MAX_LEVELS];
+} OSCILLOSCOPE_LOD;
+
+// Will be called for each new sample after it is stored and before the write pointer is incremented.
+// If the buffer depth has changed the pyramid will be rebuild.
+void OscilloscopeLodAddSample (OSCILLOSCOPE_BUFFER *par_Buffer, int par_WrPoi, double par_Value);
+
+void OscilloscopeLodFree (OSCILLOSCOPE_LOD **par_Lod);
+
+// Min./max. of all valid samples between the time par_tFrom and par_tTo (including the
+// sample at par_tTo so neighbouring pixel columns will be connected).
+// Return 1 if there was at least one valid sample otherwise 0.
+int OscilloscopeLodMinMaxOfTimeRange (OSCILLOSCOPE_DATA *par_Data, int par_LeftRight, int par_Index,
+                                      uint64_t par_tFrom, uint64_t par_tTo,
+                                      double *ret_Min, double *ret_Max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OSCILLOSCOPELOD_H
@@ -122,18 +122,24 @@ void OscilloscopeSelectVariableDialog::FillVarianleList()
     } else {
         SelVarName = m_Data->name_left[m_Data->sel_pos_left];
     }
-    int index = 0;
+    int32_t Count;
     char Name[BBVARI_NAME_SIZE];
     bool SelVarNaleInList = false;
-    while((index = read_next_blackboard_vari (index, Name, sizeof(Name))) >= 0)  {
-        if ((m_IncExcFilter == nullptr) || CheckIncludeExcludeFilter (Name, m_IncExcFilter)) {
-            if (SelVarName != nullptr) {
-                if (!strcmp (SelVarName, Name)) {
-                    SelVarNaleInList = true;   // ausgewaehlte Variable ist in Liste vorhanden
+    // Only the variables matching the main filter will be checked with the include/exclude lists
+    int *Vids = get_bbvari_ids_by_filter (((m_IncExcFilter != nullptr) && (m_IncExcFilter->MainFilter != nullptr)) ? m_IncExcFilter->MainFilter : "*", &Count);
+    if (Vids != nullptr) {
+        for (int x = 0; x < Count; x++) {
+            if (GetBlackboardVariableName (Vids[x], Name, sizeof(Name)) != 0) continue;   // removed in the meantime
+            if ((m_IncExcFilter == nullptr) || CheckIncludeExcludeFilter (Name, m_IncExcFilter)) {
+                if (SelVarName != nullptr) {
+                    if (!strcmp (SelVarName, Name)) {
+                        SelVarNaleInList = true;   // ausgewaehlte Variable ist in Liste vorhanden
+                    }
                 }
+                ui->VariableListWidget->addItem (QString (Name));
             }
-            ui->VariableListWidget->addItem (QString (Name));
         }
+        free_all_bbvari_ids (Vids);
     }
     if (!SelVarNaleInList && (SelVarName != nullptr)) {
         QListWidgetItem *NewItem = new  QListWidgetItem (QString (SelVarName));
@@ -182,8 +188,8 @@ void OscilloscopeSelectVariableDialog::accept()
             EnterOsciWidgetCriticalSection (m_Data->CriticalSectionNumber); // 2.
             m_Data->vids_right[m_Data->sel_pos_right] = vid;
             m_Data->name_right[m_Data->sel_pos_right] = ReallocCopyString(m_Data->name_right[m_Data->sel_pos_right], Name);
-            if (m_Data->buffer_right[m_Data->sel_pos_right] != nullptr) my_free (m_Data->buffer_right[m_Data->sel_pos_right]);
-            if ((m_Data->buffer_right[m_Data->sel_pos_right] = (double*)my_calloc (m_Data->buffer_depth, sizeof(double))) != nullptr) {
+            OscilloscopeBufferFree (m_Data->buffer_right[m_Data->sel_pos_right]);
+            if ((m_Data->buffer_right[m_Data->sel_pos_right] = OscilloscopeBufferAlloc (m_Data->buffer_depth)) != nullptr) {
                 ;//attach_bbvari (vid);
             } else error (1, "out of memory");
             LeaveOsciWidgetCriticalSection (m_Data->CriticalSectionNumber); // 2.
@@ -193,8 +199,8 @@ void OscilloscopeSelectVariableDialog::accept()
             EnterOsciWidgetCriticalSection (m_Data->CriticalSectionNumber); // 2.
             m_Data->vids_left[m_Data->sel_pos_left] = vid;
             m_Data->name_left[m_Data->sel_pos_left] = v(m_Data->name_left[m_Data->sel_pos_left], Name);
-            if (m_Data->buffer_left[m_Data->sel_pos_left] != nullptr) my_free (m_Data->buffer_left[m_Data->sel_pos_left]);
-            if ((m_Data->buffer_left[m_Data->sel_pos_left] = (double*)my_calloc (m_Data->buffer_depth, sizeof(double))) != nullptr) {
+            OscilloscopeBufferFree (m_Data->buffer_left[m_Data->sel_pos_left]);
+            if ((m_Data->buffer_left[m_Data->sel_pos_left] = OscilloscopeBufferAlloc (m_Data->buffer_depth)) != nullptr) {
                 ;//attach_bbvari (vid);
             } else error (1, "out of memory");
             LeaveOsciWidgetCriticalSection (m_Data->CriticalSectionNumber); // 2.
@@ -334,7 +340,7 @@ void OscilloscopeSelectVariableDialog::on_DeletePushButton_clicked()
             remove_bbvari_unknown_wait (m_Data->vids_right[m_Data->sel_pos_right]);
         }
         m_Data->vids_right[m_Data->sel_pos_right] = 0;
-        if (m_Data->buffer_right[m_Data->sel_pos_right] != nullptr) my_free (m_Data->buffer_right[m_Data->sel_pos_right]);
+        OscilloscopeBufferFree (m_Data->buffer_right[m_Data->sel_pos_right]);
         m_Data->buffer_right[m_Data->sel_pos_right] = nullptr;
         m_Data->LineSize_right[m_Data->sel_pos_right] = 1;
         m_Data->color_right[m_Data->sel_pos_right] = 0;
@@ -343,7 +349,7 @@ void OscilloscopeSelectVariableDialog::on_DeletePushButton_clicked()
             remove_bbvari_unknown_wait (m_Data->vids_left[m_Data->sel_pos_left]);
         }
         m_Data->vids_left[m_Data->sel_pos_left] = 0;
-        if (m_Data->buffer_left[m_Data->sel_pos_left] != nullptr) my_free (m_Data->buffer_left[m_Data->sel_pos_left]);
+        OscilloscopeBufferFree (m_Data->buffer_left[m_Data->sel_pos_left]);
         m_Data->buffer_left[m_Data->sel_pos_left] = nullptr;
         m_Data->LineSize_left[m_Data->sel_pos_left] = 1;
         m_Data->color_left[m_Data->sel_pos_left] = 0;
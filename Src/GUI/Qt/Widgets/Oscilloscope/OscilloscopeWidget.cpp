@@ -164,9 +164,9 @@ OscilloscopeWidget::~OscilloscopeWidget()
     EnterOsciWidgetCriticalSection (m_Data->CriticalSectionNumber);
 
     for (i = 0; i < 21; i++) {
-        if (m_Data->buffer_left[i] != nullptr) my_free (m_Data->buffer_left[i]);
+        OscilloscopeBufferFree (m_Data->buffer_left[i]);
         m_Data->buffer_left[i] = nullptr;
-        if (m_Data->buffer_right[i] != nullptr) my_free (m_Data->buffer_right[i]);
+        OscilloscopeBufferFree (m_Data->buffer_right[i]);
         m_Data->buffer_right[i] = nullptr;
     }
 
@@ -629,7 +629,7 @@ void OscilloscopeWidget::DeleteSignal()
             remove_bbvari_unknown_wait (m_Data->vids_right[m_Data->sel_pos_right]);
         }
         m_Data->vids_right[m_Data->sel_pos_right] = 0;
-        if (m_Data->buffer_right[m_Data->sel_pos_right] != nullptr) my_free (m_Data->buffer_right[m_Data->sel_pos_right]);
+        OscilloscopeBufferFree (m_Data->buffer_right[m_Data->sel_pos_right]);
         m_Data->buffer_right[m_Data->sel_pos_right] = nullptr;
         m_Data->LineSize_right[m_Data->sel_pos_right] = 1;
         m_Data->color_right[m_Data->sel_pos_right] = 0;
@@ -643,7 +643,7 @@ void OscilloscopeWidget::DeleteSignal()
             remove_bbvari_unknown_wait (m_Data->vids_left[m_Data->sel_pos_left]);
         }
         m_Data->vids_left[m_Data->sel_pos_left] = 0;
-        if (m_Data->buffer_left[m_Data->sel_pos_left] != nullptr) my_free (m_Data->buffer_left[m_Data->sel_pos_left]);
+        OscilloscopeBufferFree (m_Data->buffer_left[m_Data->sel_pos_left]);
         m_Data->buffer_left[m_Data->sel_pos_left] = nullptr;
         m_Data->LineSize_left[m_Data->sel_pos_left] = 1;
         m_Data->color_left[m_Data->sel_pos_left] = 0;
@@ -1265,8 +1265,8 @@ int OscilloscopeWidget::AddSignal(enum Side par_Side, int par_Pos, QString &par_
         EnterOsciWidgetCriticalSection (m_Data->CriticalSectionNumber); // 2.
         m_Data->vids_right[par_Pos] = vid;
         m_Data->name_right[par_Pos] = ReallocCopyString(m_Data->name_right[par_Pos], par_Name);
-        if (m_Data->buffer_right[par_Pos] != nullptr) my_free (m_Data->buffer_right[par_Pos]);
-        if ((m_Data->buffer_right[par_Pos] = static_cast<double*>(my_calloc (static_cast<size_t>(m_Data->buffer_depth), sizeof(double)))) == nullptr) {
+        OscilloscopeBufferFree (m_Data->buffer_right[par_Pos]);
+        if ((m_Data->buffer_right[par_Pos] = OscilloscopeBufferAlloc (m_Data->buffer_depth)) == nullptr) {
             ThrowError (1, "out of memory");
         }
         m_Data->wr_poi_right[par_Pos] = 0;
@@ -1278,8 +1278,8 @@ int OscilloscopeWidget::AddSignal(enum Side par_Side, int par_Pos, QString &par_
         EnterOsciWidgetCriticalSection (m_Data->CriticalSectionNumber); // 2.
         m_Data->vids_left[par_Pos] = vid;
         m_Data->name_left[par_Pos] = ReallocCopyString(m_Data->name_left[par_Pos], par_Name);
-        if (m_Data->buffer_left[par_Pos] != nullptr) my_free (m_Data->buffer_left[par_Pos]);
-        if ((m_Data->buffer_left[par_Pos] = static_cast<double*>(my_calloc (static_cast<size_t>(m_Data->buffer_depth), sizeof(double)))) == nullptr) {
+        OscilloscopeBufferFree (m_Data->buffer_left[par_Pos]);
+        if ((m_Data->buffer_left[par_Pos] = OscilloscopeBufferAlloc (m_Data->buffer_depth)) == nullptr) {
             ThrowError (1, "out of memory");
         }
         m_Data->wr_poi_left[par_Pos] = 0;
@@ -45,6 +45,7 @@ extern "C" {
 #include "FileExtensions.h"
 #include "MyMemory.h"
 #include "EquationParser.h"
+#include "BlackboardObservationQueue.h"
 }
 
 #define UNIFORM_DIALOGE
@@ -60,6 +61,13 @@ TextWidget::TextWidget(QString par_WindowTitle, MdiSubWindow *par_SubWindow, Mdi
     m_tableViewVariables = new TextTableView(this);
 
     m_dataModel = new TextTableModel();
+    // Only read the values which are changed if the blackboard can notify this
+    if (IsValueChangedObservationAvailable()) {
+        m_ObservationFlags = OBSERVE_CONFIG_ANYTHING_CHANGED | OBSERVE_VALUE_CHANGED;
+        m_dataModel->setOnlyUpdateChangedValues(true);
+    } else {
+        m_ObservationFlags = OBSERVE_CONFIG_ANYTHING_CHANGED;
+    }
 
     m_tableViewVariables->setModel(m_dataModel);
     // This should be happen after setModel, elsewise it will be ignored
@@ -761,7 +769,7 @@ void TextWidget::addBlackboardVariableToModel(QString arg_variableName, int arg_
 {
     char loc_unit[BBVARI_UNIT_SIZE];
     VID loc_vid = add_bbvari(QStringToConstChar(arg_variableName), BB_UNKNOWN_WAIT, nullptr);
-    m_ObserverConnection.AddObserveVariable(loc_vid, OBSERVE_CONFIG_ANYTHING_CHANGED);
+    m_ObserverConnection.AddObserveVariable(loc_vid, m_ObservationFlags);
     int loc_rowCount;
     if (arg_Row < 0) {
         loc_rowCount = m_dataModel->rowCount();
@@ -836,7 +844,12 @@ void TextWidget::CyclicUpdate()
 
 void TextWidget::blackboardVariableConfigChanged(int arg_vid, unsigned int arg_observationFlag)
 {
-    m_dataModel->blackboardVariableConfigChanged(arg_vid, arg_observationFlag);
+    if ((arg_observationFlag & OBSERVE_VALUE_CHANGED) == OBSERVE_VALUE_CHANGED) {
+        m_dataModel->blackboardVariableValueChanged(arg_vid);
+    }
+    if ((arg_observationFlag & ~OBSERVE_VALUE_CHANGED) != 0) {
+        m_dataModel->blackboardVariableConfigChanged(arg_vid, arg_observationFlag);
+    }
 }
 
 void TextWidget::openDialog()
@@ -87,6 +87,7 @@ private:
     TextTableModel *m_dataModel;
     QPoint m_startDragPosition;
     BlackboardObserverConnection m_ObserverConnection;
+    uint32_t m_ObservationFlags;
     QColor m_BackgroundColor;
 
     QAction *m_ConfigAct;
@@ -79,9 +79,9 @@ void UserDrawXYPlot::ResetToDefault()
 
     for (i = 0; i < 21; i++) {
         /* Spuren-Puffer loeschen */
-        if (m_Data.buffer_left[i] != nullptr) my_free (m_Data.buffer_left[i]);
+        OscilloscopeBufferFree (m_Data.buffer_left[i]);
         m_Data.buffer_left[i] = nullptr;
-        if (m_Data.buffer_right[i] != nullptr) my_free (m_Data.buffer_right[i]);
+        OscilloscopeBufferFree (m_Data.buffer_right[i]);
         m_Data.buffer_right[i] = nullptr;
     }
 
@@ -230,8 +230,8 @@ void UserDrawXYPlot::Paint(QPainter *par_Painter, QList<UserDrawImageItem*> *par
                         int IdxX = m_Data.wr_poi_left[i+1] - Idx;
                         if (IdxX < 0) IdxX = m_Data.buffer_depth + IdxX;
 
-                        double ValueY = m_Data.buffer_left[i][IdxY];
-                        double ValueX = m_Data.buffer_left[i+1][IdxX];
+                        double ValueY = OscilloscopeBufferRead (m_Data.buffer_left[i], IdxY, m_Data.NotANumber);
+                        double ValueX = OscilloscopeBufferRead (m_Data.buffer_left[i+1], IdxX, m_Data.NotANumber);
                         if (!_isnan (ValueX) && !_isnan (ValueY)) {
 
                             double y_d = ValueY * YFactor + YOffset;
@@ -295,8 +295,8 @@ void UserDrawXYPlot::Paint(QPainter *par_Painter, QList<UserDrawImageItem*> *par
                         int IdxX = m_Data.wr_poi_right[i+1] - Idx;
                         if (IdxX < 0) IdxX = m_Data.buffer_depth + IdxX;
 
-                        double ValueY = m_Data.buffer_right[i][IdxY];
-                        double ValueX = m_Data.buffer_right[i+1][IdxX];
+                        double ValueY = OscilloscopeBufferRead (m_Data.buffer_right[i], IdxY, m_Data.NotANumber);
+                        double ValueX = OscilloscopeBufferRead (m_Data.buffer_right[i+1], IdxX, m_Data.NotANumber);
                         if (!_isnan (ValueX) && !_isnan (ValueY)) {
 
                             double y_d = ValueY * YFactor + YOffset;
@@ -397,7 +397,7 @@ bool UserDrawXYPlot::InitDataStruct()
             if (vid > 0) {
                 m_Data.vids_left[x] = vid;
                 m_Data.name_left[x] = ReallocCopyString(m_Data.name_left[x], SignalName);
-                if ((m_Data.buffer_left[x] = (double*)my_calloc ((size_t)m_Data.buffer_depth, sizeof(double))) == NULL) {
+                if ((m_Data.buffer_left[x] = OscilloscopeBufferAlloc (m_Data.buffer_depth)) == NULL) {
                     ThrowError (1, "no free memory");
                     m_Data.vids_left[x] = 0;
                 }
@@ -427,7 +427,7 @@ bool UserDrawXYPlot::InitDataStruct()
             if (vid > 0) {
                 m_Data.vids_right[x] = vid;
                 m_Data.name_right[x] = ReallocCopyString(m_Data.name_right[x], SignalName);
-                if ((m_Data.buffer_right[x] = (double*)my_calloc ((size_t)m_Data.buffer_depth, sizeof(double))) == NULL) {
+                if ((m_Data.buffer_right[x] = OscilloscopeBufferAlloc (m_Data.buffer_depth)) == NULL) {
                     ThrowError (1, "no free memory");
                     m_Data.vids_right[x] = 0;
                 }
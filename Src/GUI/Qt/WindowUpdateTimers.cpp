@@ -16,6 +16,7 @@
 
 
 #include "WindowUpdateTimers.h"
+#include "BlackboardObserver.h"
 
 WindowUpdateTimers::WindowUpdateTimers(QObject *parent) : QObject(parent)
 {
@@ -27,6 +28,10 @@ WindowUpdateTimers::WindowUpdateTimers(QObject *parent) : QObject(parent)
     m_mediumTimer->setInterval(500);
     m_slowTimer->setInterval(1000);
 
+    // This must be the first connection so the queued value changes are distributed
+    // before the widgets are updated
+    connect(m_fastTimer, SIGNAL(timeout()), this, SLOT(DispatchValueChanges()));
+
     m_slowTimer->start();
     m_mediumTimer->start();
     m_fastTimer->start();
@@ -51,6 +56,11 @@ QTimer* WindowUpdateTimers::updateTimer(InterfaceWidgetPlugin::UpdateRate arg_up
     return m_noTimer;
 }
 
+void WindowUpdateTimers::DispatchValueChanges()
+{
+    DispatchBlackboardValueChanges();
+}
+
 void WindowUpdateTimers::stopAllTimer() {
     m_slowTimer->stop();
     m_mediumTimer->stop();
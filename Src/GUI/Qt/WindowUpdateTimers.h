@@ -34,6 +34,7 @@ public:
 signals:
 
 public slots:
+    void DispatchValueChanges();
 
 private:
     QTimer *m_fastTimer;
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ATOMICACCESS_H
+#define ATOMICACCESS_H
+
+#include <stdint.h>
+
+// Minimal set of atomic 32 bit accesses for lock-free queues
+// between threads of the same process.
+
+#ifdef _WIN32
+#include <Windows.h>
+// volatile accesses have acquire/release semantics with the MS compiler
+#define ATOMIC_EXCHANGE_U32(p, v)   ((uint32_t)InterlockedExchange((volatile LONG*)(p), (LONG)(v)))
+#define ATOMIC_FETCH_ADD_U32(p, v)  ((uint32_t)InterlockedExchangeAdd((volatile LONG*)(p), (LONG)(v)))
+#define ATOMIC_LOAD_ACQUIRE_U32(p)  (*(volatile uint32_t*)(p))
+#define ATOMIC_STORE_RELEASE_U32(p, v)  (*(volatile uint32_t*)(p) = (v))
+#define ATOMIC_STORE_SEQ_CST_U32(p, v)  InterlockedExchange((volatile LONG*)(p), (LONG)(v))
+#define ATOMIC_FENCE_SEQ_CST()      MemoryBarrier()
+#else
+#define ATOMIC_EXCHANGE_U32(p, v)   __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+#define ATOMIC_FETCH_ADD_U32(p, v)  __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define ATOMIC_LOAD_ACQUIRE_U32(p)  __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE_RELEASE_U32(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define ATOMIC_STORE_SEQ_CST_U32(p, v)  __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define ATOMIC_FENCE_SEQ_CST()      __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#endif // ATOMICACCESS_H
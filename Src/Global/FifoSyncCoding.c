@@ -0,0 +1,351 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+
+#include "MyMemory.h"
+#include "MemZeroAndCopy.h"
+#include "Fifos.h"
+#include "FifoSyncCoding.h"
+
+// Control byte of a compacted header
+#define SAME_FIFO_ID      0x1
+#define SAME_PID          0x2
+#define SAME_MESSAGE_ID   0x4
+
+#define ZIGZAG(x)    (((uint64_t)(x) << 1) ^ (uint64_t)((int64_t)(x) >> 63))
+#define UNZIGZAG(x)  ((int64_t)((x) >> 1) ^ -(int64_t)((x) & 1))
+
+#define LZ_HASH_BITS   12
+#define LZ_MIN_MATCH   4
+#define LZ_MAX_OFFSET  0xFFFF
+
+static uint8_t *PutVarUInt (uint8_t *p, uint64_t v)
+{
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static const uint8_t *GetVarUInt (const uint8_t *p, const uint8_t *End, uint64_t *ret_Value)
+{
+    uint64_t Value = 0;
+    int Shift;
+
+    for (Shift = 0; (p < End) && (Shift < 64); Shift += 7) {
+        uint8_t b = *p++;
+        Value |= (uint64_t)(b & 0x7F) << Shift;
+        if ((b & 0x80) == 0) {
+            *ret_Value = Value;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+// A compacted header is max. 1 + 5 + 5 + 5 + 10 + 5 = 31 bytes. This can be larger than the raw
+// FIFO_ENTRY_HEADER if uint64_t is only 4 byte aligned (28 bytes, 32 bit x86), for example with
+// negative fifo ids, message ids with flag bits, large timestamp steps and large records.
+// Return -1 if the result would not fit into par_DstSize bytes
+static int CompactHeaders (const uint8_t *par_Raw, int par_RawLen, uint8_t *ret_Dst, int par_DstSize)
+{
+    FIFO_ENTRY_HEADER Header, Prev;
+    const uint8_t *Src = par_Raw;
+    const uint8_t *End = par_Raw + par_RawLen;
+    uint8_t *Dst = ret_Dst;
+    uint8_t *DstEnd = ret_Dst + par_DstSize;
+    uint8_t Compact[32];
+
+    memset (&Prev, 0, sizeof (Prev));
+    while (Src < End) {
+        uint8_t *p = Compact + 1;
+        int CompactLen;
+        if ((End - Src) < (int)sizeof (FIFO_ENTRY_HEADER)) return -1;
+        MEMCPY (&Header, Src, sizeof (Header));   // the records are not aligned
+        Src += sizeof (Header);
+        if ((Header.Size < 0) || ((End - Src) < Header.Size)) return -1;
+        Compact[0] = 0;
+        if (Header.FiFoId == Prev.FiFoId) Compact[0] |= SAME_FIFO_ID;
+        else p = PutVarUInt (p, (uint32_t)Header.FiFoId);
+        if (Header.TramsmiterPid == Prev.TramsmiterPid) Compact[0] |= SAME_PID;
+        else p = PutVarUInt (p, ZIGZAG(Header.TramsmiterPid));
+        if (Header.MessageId == Prev.MessageId) Compact[0] |= SAME_MESSAGE_ID;
+        else p = PutVarUInt (p, Header.MessageId);
+        p = PutVarUInt (p, ZIGZAG((int64_t)(Header.Timestamp - Prev.Timestamp)));
+        p = PutVarUInt (p, (uint32_t)Header.Size);
+        CompactLen = (int)(p - Compact);
+        if ((DstEnd - Dst) < (CompactLen + Header.Size)) return -1;
+        MEMCPY (Dst, Compact, (size_t)CompactLen);
+        Dst += CompactLen;
+        MEMCPY (Dst, Src, (size_t)Header.Size);
+        Dst += Header.Size;
+        Src += Header.Size;
+        Prev = Header;
+    }
+    return (int)(Dst - ret_Dst);
+}
+
+static int ExpandHeaders (const uint8_t *par_Src, int par_SrcLen, uint8_t *ret_Raw, int par_RawSize)
+{
+    FIFO_ENTRY_HEADER Header;
+    const uint8_t *Src = par_Src;
+    const uint8_t *End = par_Src + par_SrcLen;
+    uint8_t *Dst = ret_Raw;
+    uint8_t *DstEnd = ret_Raw + par_RawSize;
+    uint64_t Value;
+
+    memset (&Header, 0, sizeof (Header));
+    while (Src < End) {
+        uint8_t Control = *Src++;
+        if ((Control & SAME_FIFO_ID) == 0) {
+            if ((Src = GetVarUInt (Src, End, &Value)) == NULL) return -1;
+            Header.FiFoId = (int32_t)Value;
+        }
+        if ((Control & SAME_PID) == 0) {
+            if ((Src = GetVarUInt (Src, End, &Value)) == NULL) return -1;
+            Header.TramsmiterPid = (int32_t)UNZIGZAG(Value);
+        }
+        if ((Control & SAME_MESSAGE_ID) == 0) {
+            if ((Src = GetVarUInt (Src, End, &Value)) == NULL) return -1;
+            Header.MessageId = (uint32_t)Value;
+        }
+        if ((Src = GetVarUInt (Src, End, &Value)) == NULL) return -1;
+        Header.Timestamp += (uint64_t)UNZIGZAG(Value);
+        if ((Src = GetVarUInt (Src, End, &Value)) == NULL) return -1;
+        if ((Value > (uint64_t)(End - Src)) ||
+            ((uint64_t)(DstEnd - Dst) < (sizeof (Header) + Value))) return -1;
+        Header.Size = (int32_t)Value;
+        MEMCPY (Dst, &Header, sizeof (Header));
+        Dst += sizeof (Header);
+        MEMCPY (Dst, Src, (size_t)Header.Size);
+        Dst += Header.Size;
+        Src += Header.Size;
+    }
+    return (int)(Dst - ret_Raw);
+}
+
+static uint32_t LzHash (const uint8_t *p)
+{
+    uint32_t v;
+    MEMCPY (&v, p, sizeof (v));
+    return (v * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+static uint8_t *LzPutLength (uint8_t *p, int Len)
+{
+    while (Len >= 255) {
+        *p++ = 255;
+        Len -= 255;
+    }
+    *p++ = (uint8_t)Len;
+    return p;
+}
+
+// Each sequence is: token (upper 4 bits literal length, lower 4 bits match length - 4,
+// 15 means more length bytes will follow), literals, 2 bytes offset, more match length bytes.
+// The last sequence has only literals.
+// Return the compressed size or -1 if it would not be smaller than par_DstSize.
+static int LzCompress (const uint8_t *par_Src, int par_Len, uint8_t *ret_Dst, int par_DstSize)
+{
+    int32_t Table[1 << LZ_HASH_BITS];
+    const uint8_t *ip = par_Src;
+    const uint8_t *Anchor = par_Src;
+    const uint8_t *End = par_Src + par_Len;
+    uint8_t *op = ret_Dst;
+    uint8_t *OpEnd = ret_Dst + par_DstSize;
+    int LitLen;
+
+    memset (Table, 0xFF, sizeof (Table));
+    while ((End - ip) >= LZ_MIN_MATCH) {
+        uint32_t Hash = LzHash (ip);
+        int32_t Candidate = Table[Hash];
+        int32_t Pos = (int32_t)(ip - par_Src);
+        Table[Hash] = Pos;
+        if ((Candidate >= 0) && ((Pos - Candidate) <= LZ_MAX_OFFSET) &&
+            !memcmp (par_Src + Candidate, ip, LZ_MIN_MATCH)) {
+            const uint8_t *Match = par_Src + Candidate;
+            int MatchLen = LZ_MIN_MATCH;
+            int Offset = Pos - Candidate;
+            uint8_t *Token;
+            while (((ip + MatchLen) < End) && (Match[MatchLen] == ip[MatchLen])) MatchLen++;
+            LitLen = (int)(ip - Anchor);
+            if ((OpEnd - op) < (1 + LitLen / 255 + 1 + LitLen + 2 + MatchLen / 255 + 1)) return -1;
+            Token = op++;
+            *Token = (uint8_t)(((LitLen >= 15) ? 15 : LitLen) << 4);
+            if (LitLen >= 15) op = LzPutLength (op, LitLen - 15);
+            MEMCPY (op, Anchor, (size_t)LitLen);
+            op += LitLen;
+            *op++ = (uint8_t)Offset;
+            *op++ = (uint8_t)(Offset >> 8);
+            MatchLen -= LZ_MIN_MATCH;
+            *Token |= (uint8_t)((MatchLen >= 15) ? 15 : MatchLen);
+            if (MatchLen >= 15) op = LzPutLength (op, MatchLen - 15);
+            ip += MatchLen + LZ_MIN_MATCH;
+            Anchor = ip;
+        } else {
+            ip++;
+        }
+    }
+    LitLen = (int)(End - Anchor);
+    if ((OpEnd - op) < (1 + LitLen / 255 + 1 + LitLen)) return -1;
+    *op++ = (uint8_t)(((LitLen >= 15) ? 15 : LitLen) << 4);
+    if (LitLen >= 15) op = LzPutLength (op, LitLen - 15);
+    MEMCPY (op, Anchor, (size_t)LitLen);
+    op += LitLen;
+    return (int)(op - ret_Dst);
+}
+
+static const uint8_t *LzGetLength (const uint8_t *ip, const uint8_t *End, int *ref_Len)
+{
+    uint8_t b;
+    do {
+        if (ip >= End) return NULL;
+        b = *ip++;
+        *ref_Len += b;
+    } while (b == 255);
+    return ip;
+}
+
+static int LzDecompress (const uint8_t *par_Src, int par_Len, uint8_t *ret_Dst, int par_DstSize)
+{
+    const uint8_t *ip = par_Src;
+    const uint8_t *End = par_Src + par_Len;
+    uint8_t *op = ret_Dst;
+    uint8_t *OpEnd = ret_Dst + par_DstSize;
+
+    while (ip < End) {
+        uint8_t Token = *ip++;
+        int LitLen = Token >> 4;
+        int MatchLen = Token & 0xF;
+        int Offset;
+        const uint8_t *Match;
+
+        if ((LitLen == 15) && ((ip = LzGetLength (ip, End, &LitLen)) == NULL)) return -1;
+        if (((End - ip) < LitLen) || ((OpEnd - op) < LitLen)) return -1;
+        MEMCPY (op, ip, (size_t)LitLen);
+        op += LitLen;
+        ip += LitLen;
+        if (ip == End) break;   // last sequence
+        if ((End - ip) < 2) return -1;
+        Offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if ((MatchLen == 15) && ((ip = LzGetLength (ip, End, &MatchLen)) == NULL)) return -1;
+        MatchLen += LZ_MIN_MATCH;
+        if ((Offset == 0) || (Offset > (op - ret_Dst)) || ((OpEnd - op) < MatchLen)) return -1;
+        // byte by byte because the match can overlap
+        for (Match = op - Offset; MatchLen > 0; MatchLen--) *op++ = *Match++;
+        if (ip == End) return -1;   // the last sequence (only literals) is missing
+    }
+    return (int)(op - ret_Dst);
+}
+
+static uint8_t *GetBuffer (uint8_t **ref_Buffer, int *ref_Size, int par_Size)
+{
+    if (par_Size > *ref_Size) {
+        uint8_t *New = (uint8_t*)my_realloc (*ref_Buffer, (size_t)par_Size);
+        if (New == NULL) return NULL;
+        *ref_Buffer = New;
+        *ref_Size = par_Size;
+    }
+    return *ref_Buffer;
+}
+
+int EncodeFiFoSyncBlock (FIFO_SYNC_CODER *par_Coder, const void *par_Raw, int par_RawLen, uint32_t par_Codings,
+                         void *ret_Dst, uint32_t *ret_Coding)
+{
+    const uint8_t *Src = (const uint8_t*)par_Raw;
+    int Len = par_RawLen;
+    int CompressedLen;
+    uint8_t *Compact;
+
+    *ret_Coding = 0;
+    if ((par_Codings & FIFO_SYNC_COMPACT_HEADERS) == FIFO_SYNC_COMPACT_HEADERS) {
+        if ((par_Codings & FIFO_SYNC_LZ_COMPRESSION) == FIFO_SYNC_LZ_COMPRESSION) {
+            Compact = GetBuffer (&par_Coder->Scratch, &par_Coder->ScratchSize, par_RawLen);
+        } else {
+            Compact = (uint8_t*)ret_Dst;
+        }
+        if (Compact != NULL) {
+            // if the compacted block would be larger than the raw one it will be send without coding
+            int CompactLen = CompactHeaders (Src, par_RawLen, Compact, par_RawLen);
+            if (CompactLen >= 0) {
+                Src = Compact;
+                Len = CompactLen;
+                *ret_Coding |= FIFO_SYNC_COMPACT_HEADERS;
+            }
+        }
+    }
+    if ((par_Codings & FIFO_SYNC_LZ_COMPRESSION) == FIFO_SYNC_LZ_COMPRESSION) {
+        CompressedLen = LzCompress (Src, Len, (uint8_t*)ret_Dst, Len - 1);
+        if (CompressedLen >= 0) {
+            *ret_Coding |= FIFO_SYNC_LZ_COMPRESSION;
+            return CompressedLen;
+        }
+    }
+    if (Src != ret_Dst) MEMCPY (ret_Dst, Src, (size_t)Len);
+    return Len;
+}
+
+void *DecodeFiFoSyncBlock (FIFO_SYNC_CODER *par_Coder, const void *par_Src, int par_SrcLen, uint32_t par_Coding,
+                           int par_RawLen)
+{
+    const uint8_t *Src = (const uint8_t*)par_Src;
+    int Len = par_SrcLen;
+    uint8_t *Raw;
+
+    if ((par_RawLen < 0) || ((Raw = GetBuffer (&par_Coder->Raw, &par_Coder->RawSize, par_RawLen)) == NULL)) return NULL;
+    if ((par_Coding & FIFO_SYNC_LZ_COMPRESSION) == FIFO_SYNC_LZ_COMPRESSION) {
+        uint8_t *Dst;
+        if ((par_Coding & FIFO_SYNC_COMPACT_HEADERS) == FIFO_SYNC_COMPACT_HEADERS) {
+            // the compacted block is never larger than the raw block
+            Dst = GetBuffer (&par_Coder->Scratch, &par_Coder->ScratchSize, par_RawLen);
+            if (Dst == NULL) return NULL;
+        } else {
+            Dst = Raw;
+        }
+        Len = LzDecompress (Src, Len, Dst, par_RawLen);
+        if (Len < 0) return NULL;
+        Src = Dst;
+    }
+    if ((par_Coding & FIFO_SYNC_COMPACT_HEADERS) == FIFO_SYNC_COMPACT_HEADERS) {
+        Len = ExpandHeaders (Src, Len, Raw, par_RawLen);
+    } else if (Src != Raw) {
+        if (Len > par_RawLen) return NULL;
+        MEMCPY (Raw, Src, (size_t)Len);
+    }
+    if (Len != par_RawLen) return NULL;
+    return Raw;
+}
+
+void *GetFiFoSyncCoderRawBuffer (FIFO_SYNC_CODER *par_Coder, int par_Size)
+{
+    return GetBuffer (&par_Coder->Raw, &par_Coder->RawSize, par_Size);
+}
+
+void FreeFiFoSyncCoder (FIFO_SYNC_CODER *par_Coder)
+{
+    if (par_Coder->Scratch != NULL) my_free (par_Coder->Scratch);
+    if (par_Coder->Raw != NULL) my_free (par_Coder->Raw);
+    par_Coder->Scratch = NULL;
+    par_Coder->ScratchSize = 0;
+    par_Coder->Raw = NULL;
+    par_Coder->RawSize = 0;
+}
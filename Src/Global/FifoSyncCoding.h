@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef FIFOSYNCCODING_H
+#define FIFOSYNCCODING_H
+
+#include <stdint.h>
+
+// Coding of the fifo sync blocks transfered between XilEnv and the remote master
+// (FIFO_ENTRY_HEADER + data records as filled by SyncTxFiFos()).
+// Both sides negotiate the supported codings with RM_INIT_CMD.
+
+// Each header will be stored as a control byte followed by variable length integers.
+// FiFoId, TramsmiterPid and MessageId are omitted if they are the same as inside the
+// record before, the timestamp is stored as difference to the record before.
+#define FIFO_SYNC_COMPACT_HEADERS   0x1
+// The (compacted) block will be compressed with a fast LZ77 coding (only used if it gets smaller)
+#define FIFO_SYNC_LZ_COMPRESSION    0x2
+
+#define FIFO_SYNC_SUPPORTED_CODINGS  (FIFO_SYNC_COMPACT_HEADERS | FIFO_SYNC_LZ_COMPRESSION)
+
+typedef struct {
+    uint8_t *Scratch;
+    int ScratchSize;
+    uint8_t *Raw;
+    int RawSize;
+} FIFO_SYNC_CODER;
+
+// Encode the block par_Raw with the codings allowed by par_Codings. The codings which are
+// really used will be returned inside *ret_Coding. A coding which would make the block larger
+// will be not used, so the result will be never larger than par_RawLen and ret_Dst must have
+// at least par_RawLen bytes. Return the length of the coded block.
+int EncodeFiFoSyncBlock (FIFO_SYNC_CODER *par_Coder, const void *par_Raw, int par_RawLen, uint32_t par_Codings,
+                         void *ret_Dst, uint32_t *ret_Coding);
+
+// Decode the block par_Src (par_RawLen is the length before encoding). The decoded block
+// is stored inside the coder and will be valid till the next call.
+// Return the pointer to the decoded block or NULL if the block is corrupt.
+void *DecodeFiFoSyncBlock (FIFO_SYNC_CODER *par_Coder, const void *par_Src, int par_SrcLen, uint32_t par_Coding,
+                           int par_RawLen);
+
+// Return a buffer of the coder with at least par_Size bytes (can be used to fill a raw block)
+void *GetFiFoSyncCoderRawBuffer (FIFO_SYNC_CODER *par_Coder, int par_Size);
+
+void FreeFiFoSyncCoder (FIFO_SYNC_CODER *par_Coder);
+
+#endif // FIFOSYNCCODING_H
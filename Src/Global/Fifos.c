@@ -29,9 +29,12 @@
 #include "Scheduler.h"
 #include "Message.h"
 #include "Fifos.h"
+#include "AtomicAccess.h"
 
 #define UNUSED(x) (void)(x)
 
+#define MAX_FIFOS   128
+
 /*
 #ifdef REMOTE_MASTER
 #define FIFO_LOG_TO_FILE  "/tmp/fifo.txt"
@@ -50,6 +53,7 @@
 #include "RemoteMasterLock.h"
 
 static REMOTE_MASTER_LOCK FiFosCriticalSection;
+static REMOTE_MASTER_LOCK FiFoWriteCriticalSections[MAX_FIFOS];
 #define InitializeCriticalSection(x) RemoteMasterInitLock(x)
 #define DeleteCriticalSection(x) RemoteMasterDestroyLock(x)
 #define EnterCriticalSection(x)  RemoteMasterLock(x, __LINE__, __FILE__)
@@ -58,6 +62,7 @@ static REMOTE_MASTER_LOCK FiFosCriticalSection;
 #else
 
 static CRITICAL_SECTION FiFosCriticalSection;
+static CRITICAL_SECTION FiFoWriteCriticalSections[MAX_FIFOS];
 
 #endif
 
@@ -71,30 +76,36 @@ static CRITICAL_SECTION FiFosCriticalSection;
 #endif
 
 
+// Each fifo is a ring buffer with one reader (the receiving process) and one or more writers.
+// FiFosCriticalSection is only used to create and delete fifos. The writers of one fifo
+// are serialized by its own FiFoWriteCriticalSections[] entry, the reader needs no lock at all:
+// WrPos will only be changed by the writer and RdPos only by the reader.
+// A message (header + data) is always stored in one piece and is 8 byte aligned. If it doesn't
+// fit at the end of the buffer the rest is marked with FIFO_PADDING_FLAG and the message
+// starts at the beginning. WrPos == RdPos means empty, a writer never let WrPos reach RdPos.
 typedef struct {
-    uint32_t IsOnline; 
+    // Written by the writer(s)
+    uint32_t IsOnline;
     int32_t FiFoId;
     int32_t Size;
     int32_t RxPid;
-    void *Data;
-    void *Wr;
-    void *Rd;
-	uint64_t DeleteTimeStamp;
+    uint8_t *Data;
+    uint32_t WrPos;
+    uint32_t ReservedPos;    // position of the message reserved with ReserveFiFoMessage()
+    int32_t ReservedLen;     // -1 if there is no reserved message
+    uint32_t TxCounter32;
+    uint64_t DeleteTimeStamp;
+    uint8_t Fill1[16];
+    // Written by the reader (own cache line)
+    uint32_t RdPos;
+    uint32_t RxCounter32;
+    uint8_t Fill2[56];
     char Name[64];
-	uint32_t TxCounter32;
-	uint32_t RxCounter32;
-	uint8_t TxCounter;
-	uint8_t RxCounter;
-	uint8_t Fill1;
-	uint8_t Fill2;
-	uint8_t Fill3;
-	uint8_t Fill4;
-	uint8_t Fill5;
-	uint8_t Fill6;
-} FIFO;   // 4 * 4 + 4 * 8 + 64 + 2 * 4 + 8 * 1 = 128Bytes
-
+} FIFO;   // 3 * 64 = 192 Bytes
 
-#define MAX_FIFOS   128
+#define FIFO_PADDING_FLAG   0xFF
+#define FIFO_ALIGN(x)  (((x) + 7) & ~7U)
+#define FIFO_ENTRY_SIZE(Len)  FIFO_ALIGN((uint32_t)sizeof(FIFO_ENTRY_HEADER) + (uint32_t)(Len))
 
 static int32_t FiFoCounter;
 static FIFO Fifos[MAX_FIFOS];
@@ -153,19 +164,19 @@ int CreateNewRxFifo (int RxPid, int Size, const char *Name)   // if Size == 0 it
 #ifdef FIFO_LOG_TO_FILE
     fprintf (FifoLogFh, "    FiFoId[%i] = 0x%X\n", x, Fifos[x].FiFoId);
 #endif
+    Size &= ~7;   // all messages are 8 byte aligned
     Fifos[x].Size = Size;
 
     Fifos[x].TxCounter32 = 0;
     Fifos[x].RxCounter32 = 0;
-    Fifos[x].TxCounter = 1;  // range is 1...255
-	Fifos[x].RxCounter = 1;
+    Fifos[x].WrPos = 0;
+    Fifos[x].RdPos = 0;
+    Fifos[x].ReservedLen = -1;
 
     StringCopyMaxCharTruncate(Fifos[x].Name, Name, sizeof (Fifos[x].Name) - 1);
     Fifos[x].RxPid = RxPid;
 	if (Size > 0) {
-        Fifos[x].Data = my_calloc((size_t)Size, 1);
-		Fifos[x].Wr = Fifos[x].Data;
-		Fifos[x].Rd = Fifos[x].Data;
+        Fifos[x].Data = (uint8_t*)my_calloc((size_t)Size, 1);
         if (Fifos[x].Data == NULL) {
 			Fifos[x].FiFoId = 0;
 			ThrowError(1, "cannot create FiFo \"%s\" for processes \"%i\" (out of memory)", Name, RxPid);
@@ -173,8 +184,6 @@ int CreateNewRxFifo (int RxPid, int Size, const char *Name)   // if Size == 0 it
 		}
 	} else {
 		Fifos[x].Data = NULL;
-		Fifos[x].Wr = NULL;
-		Fifos[x].Rd = NULL;
 	}
     EnterCriticalSection(&FiFosCriticalSection);
     Fifos[x].IsOnline = 1;
@@ -215,16 +224,12 @@ int TxAttachFiFo(int TxPid, const char *Name)  // Return is fifo Handle
     return FIFO_ERR_UNKNOWN_NAME;
 }
 
-int WriteToFiFo (int32_t FiFoId, uint32_t MessageId, int TramsmiterPid, uint64_t Timestamp, int Len, const void *Data)
+// Return the fifo number a message with this handle should be written to
+static int GetWriteFiFoNr (int32_t FiFoId)
 {
     int FiFoNr;
-
-#ifdef FIFO_LOG_TO_FILE
-    fprintf (FifoLogFh, "WriteToFiFo(FiFoId = %i, MessageId = %i, TramsmiterPid = %i, Timestamp = %" PRIu64 ", len = %i, Data)\n",
-             FiFoId, MessageId, TramsmiterPid, Timestamp, Len);
-#endif
-
 #ifdef REMOTE_MASTER
+    UNUSED(FiFoId);
     FiFoNr = 0;     // immer FiFo 0 zum Senden verwenden
 #else
     if (s_main_ini_val.ConnectToRemoteMaster) {
@@ -235,89 +240,93 @@ int WriteToFiFo (int32_t FiFoId, uint32_t MessageId, int TramsmiterPid, uint64_t
         if (Fifos[FiFoNr].FiFoId != FiFoId) return FIFO_ERR_UNKNOWN_HANDLE;
     }
 #endif
-    if (1) {
-        FIFO_ENTRY_HEADER Header;
-        int Space;
-        int parta, partb;
-        char *Dest;
-        char *Src;
-        unsigned char *Used;
-
-        XEnterCriticalSection(&FiFosCriticalSection);
-        if (Fifos[FiFoNr].Rd > Fifos[FiFoNr].Wr) {
-            Space = (int)((char*)(Fifos[FiFoNr].Rd) - (char*)(Fifos[FiFoNr].Wr));
-        } else {
-            Space = Fifos[FiFoNr].Size - (int)((char*)(Fifos[FiFoNr].Wr) - (char*)(Fifos[FiFoNr].Rd));
-        }
+    return FiFoNr;
+}
 
-        // 2 bytes more than the size of the message is long  (for the next used byte)!
-        if (Space < ((int)sizeof(FIFO_ENTRY_HEADER) + Len + 2)) {
-#ifdef FIFO_LOG_TO_FILE
-            fprintf (FifoLogFh, "    error FIFO_ERR_NOT_ENOUGH_SPACE\n");
-#endif
-            XLeaveCriticalSection(&FiFosCriticalSection);
-            return FIFO_ERR_NOT_ENOUGH_SPACE;
+// Search space for a message with par_Len data bytes. Must be called inside the write critical section.
+// Return the position of the message header or NULL if there is not enough space
+static FIFO_ENTRY_HEADER *ReserveSpace (FIFO *par_Fifo, int par_Len)
+{
+    uint32_t Need = FIFO_ENTRY_SIZE(par_Len);
+    uint32_t Size = (uint32_t)par_Fifo->Size;
+    uint32_t Wr = par_Fifo->WrPos;
+    uint32_t Rd = ATOMIC_LOAD_ACQUIRE_U32 (&par_Fifo->RdPos);
+
+    if (par_Fifo->Data == NULL) return NULL;
+    if (Wr >= Rd) {
+        // Wr must not wrap to 0 if the reader is there
+        if (((Wr + Need) < Size) || (((Wr + Need) == Size) && (Rd != 0))) {
+            return (FIFO_ENTRY_HEADER*)(void*)(par_Fifo->Data + Wr);
         }
-        Used = (unsigned char*)(Fifos[FiFoNr].Wr);
-
-        // Construct the header
-		Header.Used.Flags = 0;
-        Header.MessageId = MessageId;
-        Header.Timestamp = Timestamp;
-        Header.Size = Len;
-        Header.TramsmiterPid = TramsmiterPid;
-        Header.FiFoId = FiFoId;
-        // first the message head
-        Dest = (char*)Fifos[FiFoNr].Wr;
-        Src = (char*)&Header;
-        parta = (int)(Fifos[FiFoNr].Size - (int)(Dest - (char*)Fifos[FiFoNr].Data));
-        if (parta >= (int)sizeof(FIFO_ENTRY_HEADER)) {
-            MEMCPY(Dest, Src, sizeof(FIFO_ENTRY_HEADER));
-            Dest += sizeof(FIFO_ENTRY_HEADER);
-        } else {
-#ifdef FIFO_LOG_TO_FILE
-            fprintf (FifoLogFh, "    !!!!!!!!!!!SPLIT COPY!!!!!!!!\n");
-#endif
-            partb = (int)sizeof(FIFO_ENTRY_HEADER) - parta;
-            MEMCPY(Dest, Src, (size_t)parta);
-            MEMCPY(Fifos[FiFoNr].Data, &Src[parta], (size_t)partb);
-            Dest = (char*)Fifos[FiFoNr].Data + partb;
+        if (Need < Rd) {
+            // Not enough space at the end, the reader should skip the rest of the buffer
+            FIFO_ENTRY_HEADER *Padding = (FIFO_ENTRY_HEADER*)(void*)(par_Fifo->Data + Wr);
+            Padding->Used.Flags = 0;
+            Padding->Used.Used.Flag = FIFO_PADDING_FLAG;
+            return (FIFO_ENTRY_HEADER*)(void*)par_Fifo->Data;
         }
+    } else if ((Wr + Need) < Rd) {
+        return (FIFO_ENTRY_HEADER*)(void*)(par_Fifo->Data + Wr);
+    }
+    return NULL;
+}
+
+// Fill the header and make the message visible for the reader. Must be called inside the write critical section.
+static void CommitSpace (FIFO *par_Fifo, FIFO_ENTRY_HEADER *par_Header, int32_t FiFoId, uint32_t MessageId, int32_t TramsmiterPid, uint64_t Timestamp, int Len)
+{
+    uint32_t Wr;
+
+    par_Header->Used.Flags = 0;
+    par_Header->MessageId = MessageId;
+    par_Header->Timestamp = Timestamp;
+    par_Header->Size = Len;
+    par_Header->TramsmiterPid = TramsmiterPid;
+    par_Header->FiFoId = FiFoId;
+
+    Wr = (uint32_t)((uint8_t*)par_Header - par_Fifo->Data) + FIFO_ENTRY_SIZE(Len);
+    if (Wr >= (uint32_t)par_Fifo->Size) Wr = 0;
+    par_Fifo->TxCounter32++;
+    // Now the message is valid
+    ATOMIC_STORE_RELEASE_U32 (&par_Fifo->WrPos, Wr);
+}
 
-        // than the data
-        parta = (int)(Fifos[FiFoNr].Size - (Dest - (char*)Fifos[FiFoNr].Data));
-        if (parta >= Len) {
-            MEMCPY(Dest, Data, (size_t)Len);
-            Dest += Len;
-        }  else {
+static int WriteToFiFoNr (int FiFoNr, int32_t FiFoId, uint32_t MessageId, int32_t TramsmiterPid, uint64_t Timestamp, int Len, const void *Data)
+{
+    FIFO_ENTRY_HEADER *Header;
+
+    if (Len < 0) return FIFO_ERR_INVALID_PARAMETER;
+    XEnterCriticalSection(&FiFoWriteCriticalSections[FiFoNr]);
+    Header = ReserveSpace (&Fifos[FiFoNr], Len);
+    if (Header == NULL) {
 #ifdef FIFO_LOG_TO_FILE
-            fprintf (FifoLogFh, "    !!!!!!!!!!!SPLIT COPY!!!!!!!!\n");
+        fprintf (FifoLogFh, "    error FIFO_ERR_NOT_ENOUGH_SPACE\n");
 #endif
-            partb = Len - parta;
-            MEMCPY(Dest, Data, (size_t)parta);
-            MEMCPY(Fifos[FiFoNr].Data, (const char*)Data + parta, (size_t)partb);
-            Dest = (char*)Fifos[FiFoNr].Data + partb;
-        }
-        if ((Dest - (char*)Fifos[FiFoNr].Data) >= Fifos[FiFoNr].Size) {
-            Dest = (char*)Fifos[FiFoNr].Data;
-        }
-        Fifos[FiFoNr].Wr = (void*)Dest;
-        *(char*)(Fifos[FiFoNr].Wr) = 0;
-
-		Fifos[FiFoNr].TxCounter32++;
-		if (Fifos[FiFoNr].TxCounter == 255) Fifos[FiFoNr].TxCounter = 1;
-		else Fifos[FiFoNr].TxCounter++;
-        // Now set the fifo entry to valid
-		*Used = Fifos[FiFoNr].TxCounter;
-        XLeaveCriticalSection(&FiFosCriticalSection);
-        return 0;
+        XLeaveCriticalSection(&FiFoWriteCriticalSections[FiFoNr]);
+        return FIFO_ERR_NOT_ENOUGH_SPACE;
     }
+    MEMCPY (Header + 1, Data, (size_t)Len);
+    CommitSpace (&Fifos[FiFoNr], Header, FiFoId, MessageId, TramsmiterPid, Timestamp, Len);
+    XLeaveCriticalSection(&FiFoWriteCriticalSections[FiFoNr]);
+    return 0;
+}
+
+int WriteToFiFo (int32_t FiFoId, uint32_t MessageId, int TramsmiterPid, uint64_t Timestamp, int Len, const void *Data)
+{
+    int FiFoNr;
+
+#ifdef FIFO_LOG_TO_FILE
+    fprintf (FifoLogFh, "WriteToFiFo(FiFoId = %i, MessageId = %i, TramsmiterPid = %i, Timestamp = %" PRIu64 ", len = %i, Data)\n",
+             FiFoId, MessageId, TramsmiterPid, Timestamp, Len);
+#endif
+
+    FiFoNr = GetWriteFiFoNr (FiFoId);
+    if (FiFoNr < 0) return FiFoNr;
+    return WriteToFiFoNr (FiFoNr, FiFoId, MessageId, TramsmiterPid, Timestamp, Len, Data);
 }
 
 static int WriteToFiFoDistribute(int32_t FiFoId, uint32_t MessageId, int32_t TramsmiterPid, unsigned long long Timestamp, int Len, void *Data)
 {
 	int FiFoNr;
-	FIFO *FiFoDebug;
 
 #ifdef FIFO_LOG_TO_FILE
 	fprintf(FifoLogFh, "WriteToFiFoDistribute(FiFoId = %i, MessageId = %i, TramsmiterPid = %i, Timestamp = %" PRIu64 ", len = %i, Data)\n",
@@ -329,96 +338,106 @@ static int WriteToFiFoDistribute(int32_t FiFoId, uint32_t MessageId, int32_t Tra
         ThrowError (1, "Internal error: %s (%i)", __FILE__, __LINE__);
     }
 	if ((FiFoNr < 0) || (FiFoNr >= MAX_FIFOS)) return FIFO_ERR_INVALID_PARAMETER;
-	FiFoDebug = &(Fifos[FiFoNr]);
 	if (Fifos[FiFoNr].FiFoId != FiFoId) return FIFO_ERR_UNKNOWN_HANDLE;
-	if (1) {
-		FIFO_ENTRY_HEADER Header;
-		int Space;
-		int parta, partb;
-		char *Dest;
-		char *Src;
-		unsigned char *Used;
-
-        XEnterCriticalSection(&FiFosCriticalSection);
-
-		if (Fifos[FiFoNr].Rd > Fifos[FiFoNr].Wr) {
-			Space = (int)((char*)(Fifos[FiFoNr].Rd) - (char*)(Fifos[FiFoNr].Wr));
-		}
-		else {
-			Space = Fifos[FiFoNr].Size - (int)((char*)(Fifos[FiFoNr].Wr) - (char*)(Fifos[FiFoNr].Rd));
-		}
+    return WriteToFiFoNr (FiFoNr, FiFoId, MessageId, TramsmiterPid, Timestamp, Len, Data);
+}
 
-        // 2 bytes more than the size of the message is long  (for the next used byte)!
-        if (Space < ((int)sizeof(FIFO_ENTRY_HEADER) + Len + 2)) {
-#ifdef FIFO_LOG_TO_FILE
-			fprintf(FifoLogFh, "    error FIFO_ERR_NOT_ENOUGH_SPACE\n");
-#endif
-            XLeaveCriticalSection(&FiFosCriticalSection);
-			return FIFO_ERR_NOT_ENOUGH_SPACE;
-		}
-        Used = (unsigned char*)(Fifos[FiFoNr].Wr);
-
-        // Construct the header
-        Header.Used.Flags = 0;
-		Header.MessageId = MessageId;
-		Header.Timestamp = Timestamp;
-		Header.Size = Len;
-		Header.TramsmiterPid = TramsmiterPid;
-		Header.FiFoId = FiFoId;
-        // first the message head
-        Dest = (char*)Fifos[FiFoNr].Wr;
-		Src = (char*)&Header;
-		parta = (int)(Fifos[FiFoNr].Size - (Dest - (char*)Fifos[FiFoNr].Data));
-        if (parta >= (int)sizeof(FIFO_ENTRY_HEADER)) {
-			MEMCPY(Dest, Src, sizeof(FIFO_ENTRY_HEADER));
-			Dest += sizeof(FIFO_ENTRY_HEADER);
-		}
-		else {
-#ifdef FIFO_LOG_TO_FILE
-			fprintf(FifoLogFh, "    !!!!!!!!!!!SPLIT COPY!!!!!!!!\n");
-#endif
-            partb = (int)sizeof(FIFO_ENTRY_HEADER) - parta;
-            MEMCPY(Dest, Src, (size_t)parta);
-            MEMCPY(Fifos[FiFoNr].Data, &Src[parta], (size_t)partb);
-			Dest = (char*)Fifos[FiFoNr].Data + partb;
-		}
+void *ReserveFiFoMessage (int32_t FiFoId, int Len, int *ret_Error)
+{
+    int FiFoNr;
+    FIFO_ENTRY_HEADER *Header;
 
-        // than the data
-        parta = (int)(Fifos[FiFoNr].Size - (Dest - (char*)Fifos[FiFoNr].Data));
-		if (parta >= Len) {
-            MEMCPY(Dest, Data, (size_t)Len);
-			Dest += Len;
-		}
-		else {
-#ifdef FIFO_LOG_TO_FILE
-			fprintf(FifoLogFh, "    !!!!!!!!!!!SPLIT COPY!!!!!!!!\n");
-#endif
-			partb = Len - parta;
-            MEMCPY(Dest, Data, (size_t)parta);
-            MEMCPY(Fifos[FiFoNr].Data, (char*)Data + parta, (size_t)partb);
-			Dest = (char*)Fifos[FiFoNr].Data + partb;
-		}
-		if ((Dest - (char*)Fifos[FiFoNr].Data) >= Fifos[FiFoNr].Size) {
-			Dest = (char*)Fifos[FiFoNr].Data;
-		}
-		Fifos[FiFoNr].Wr = (void*)Dest;
-		*(char*)(Fifos[FiFoNr].Wr) = 0;
-		Fifos[FiFoNr].TxCounter32++;
-		if (Fifos[FiFoNr].TxCounter == 255) Fifos[FiFoNr].TxCounter = 1;
-        else Fifos[FiFoNr].TxCounter++;
-        // Now set the fifo entry to valid
-        *Used = Fifos[FiFoNr].TxCounter;
-        XLeaveCriticalSection(&FiFosCriticalSection);
-		return 0;
-	}
+    FiFoNr = GetWriteFiFoNr (FiFoId);
+    if (FiFoNr < 0) {
+        *ret_Error = FiFoNr;
+        return NULL;
+    }
+    if (Len < 0) {
+        *ret_Error = FIFO_ERR_INVALID_PARAMETER;
+        return NULL;
+    }
+    XEnterCriticalSection(&FiFoWriteCriticalSections[FiFoNr]);
+    Header = ReserveSpace (&Fifos[FiFoNr], Len);
+    if (Header == NULL) {
+        XLeaveCriticalSection(&FiFoWriteCriticalSections[FiFoNr]);
+        *ret_Error = FIFO_ERR_NOT_ENOUGH_SPACE;
+        return NULL;
+    }
+    // Stay inside the write critical section till CommitFiFoMessage()
+    Fifos[FiFoNr].ReservedPos = (uint32_t)((uint8_t*)Header - Fifos[FiFoNr].Data);
+    Fifos[FiFoNr].ReservedLen = Len;
+    *ret_Error = 0;
+    return (void*)(Header + 1);
 }
 
-int ReadFromFiFo (int FiFoId, FIFO_ENTRY_HEADER *Header, void *Data, int MaxLen)
+int CommitFiFoMessage (int32_t FiFoId, uint32_t MessageId, int TramsmiterPid, uint64_t Timestamp, int Len)
+{
+    int FiFoNr;
+    int Ret = 0;
+    FIFO *Fifo;
+
+    FiFoNr = GetWriteFiFoNr (FiFoId);
+    if (FiFoNr < 0) return FiFoNr;
+    Fifo = &(Fifos[FiFoNr]);
+    if (Fifo->ReservedLen < 0) return FIFO_ERR_INVALID_PARAMETER;  // nothing reserved
+    if ((Len >= 0) && (Len <= Fifo->ReservedLen)) {
+        CommitSpace (Fifo, (FIFO_ENTRY_HEADER*)(void*)(Fifo->Data + Fifo->ReservedPos),
+                     FiFoId, MessageId, TramsmiterPid, Timestamp, Len);
+    } else {
+        Ret = FIFO_ERR_INVALID_PARAMETER;  // the message will be dropped
+    }
+    Fifo->ReservedLen = -1;
+    XLeaveCriticalSection(&FiFoWriteCriticalSections[FiFoNr]);
+    return Ret;
+}
+
+// Return the next message header inside the ring buffer or NULL if it is empty.
+// Only the receiving process should call this.
+static FIFO_ENTRY_HEADER *NextMessage (FIFO *par_Fifo)
+{
+    uint32_t Rd = par_Fifo->RdPos;
+    uint32_t Wr = ATOMIC_LOAD_ACQUIRE_U32 (&par_Fifo->WrPos);
+    FIFO_ENTRY_HEADER *Header;
+
+    if ((Rd == Wr) || (par_Fifo->Data == NULL)) return NULL;
+    Header = (FIFO_ENTRY_HEADER*)(void*)(par_Fifo->Data + Rd);
+    if (Header->Used.Used.Flag == FIFO_PADDING_FLAG) {
+        // The rest of the buffer is not used, the message starts at the beginning
+        ATOMIC_STORE_RELEASE_U32 (&par_Fifo->RdPos, 0);
+        if (Wr == 0) return NULL;
+        Header = (FIFO_ENTRY_HEADER*)(void*)par_Fifo->Data;
+    }
+    return Header;
+}
+
+// Give the space of the message back to the writer(s)
+static void ReleaseMessage (FIFO *par_Fifo, FIFO_ENTRY_HEADER *par_Header)
+{
+    uint32_t Rd = (uint32_t)((uint8_t*)par_Header - par_Fifo->Data) + FIFO_ENTRY_SIZE(par_Header->Size);
+
+    if (Rd >= (uint32_t)par_Fifo->Size) Rd = 0;
+    par_Fifo->RxCounter32++;
+    ATOMIC_STORE_RELEASE_U32 (&par_Fifo->RdPos, Rd);
+}
+
+void *PeekFiFoMessage (int FiFoId, FIFO_ENTRY_HEADER *ret_Header)
 {
     int FiFoNr;
-    FIFO *FiFoDebug;
-	unsigned char UsedCounter;
+    FIFO_ENTRY_HEADER *Header;
 
+    FiFoNr = FiFoId & 0xFFFF;
+    if ((FiFoNr < 0) || (FiFoNr >= MAX_FIFOS)) return NULL;
+    if (Fifos[FiFoNr].FiFoId != FiFoId) return NULL;
+    Header = NextMessage (&Fifos[FiFoNr]);
+    if (Header == NULL) return NULL;
+    if (ret_Header != NULL) *ret_Header = *Header;
+    return (void*)(Header + 1);
+}
+
+int ReadFromFiFo (int FiFoId, FIFO_ENTRY_HEADER *Header, void *Data, int MaxLen)
+{
+    int FiFoNr;
+    FIFO_ENTRY_HEADER *Src;
 
 #ifdef FIFO_LOG_TO_FILE
     fprintf (FifoLogFh, "ReadFromFiFo(FiFoId = %i, Header,Data, MaxLen = %i)\n",
@@ -426,86 +445,33 @@ int ReadFromFiFo (int FiFoId, FIFO_ENTRY_HEADER *Header, void *Data, int MaxLen)
 #endif
     FiFoNr = FiFoId & 0xFFFF;
     if ((FiFoNr < 0) || (FiFoNr >= MAX_FIFOS)) return FIFO_ERR_INVALID_PARAMETER;
-    FiFoDebug = &(Fifos[FiFoNr]);
     if (Fifos[FiFoNr].FiFoId != FiFoId) return FIFO_ERR_UNKNOWN_HANDLE;
-    XEnterCriticalSection(&FiFosCriticalSection);
-    UsedCounter = *(unsigned char*)Fifos[FiFoNr].Rd;
-    if (UsedCounter) {    // Is used?
-        int parta, partb;
-        char *Dest;
-        char *Src;
-        int Len;
-
-        // Copy message head
-        Dest = (char*)Header;
-        Src = (char*)Fifos[FiFoNr].Rd;
-
-        parta = (int)(Fifos[FiFoNr].Size - (Src - (char*)Fifos[FiFoNr].Data));
-        if (parta >= (int)sizeof (FIFO_ENTRY_HEADER)) {
-            MEMCPY (Dest, Src, sizeof (FIFO_ENTRY_HEADER));
-            Src += sizeof (FIFO_ENTRY_HEADER);
-        } else {
-#ifdef FIFO_LOG_TO_FILE
-            fprintf (FifoLogFh, "    !!!!!!!!!!!SPLIT COPY!!!!!!!!\n");
-#endif
-            partb = (int)sizeof(FIFO_ENTRY_HEADER) - parta;
-            MEMCPY (Dest, Src, (size_t)parta);
-            MEMCPY (&Dest[parta], Fifos[FiFoNr].Data, (size_t)partb);
-            Src = (char*)Fifos[FiFoNr].Data + partb;
-        }
-        Len = Header->Size;
-        if ((Len >= 0) && (Len <= MaxLen)) {
-            // Than the data
-            Dest = (char*)Data;
-            parta = (int)(Fifos[FiFoNr].Size - (Src - (char*)Fifos[FiFoNr].Data));
-            if (parta >= Len) {
-                MEMCPY(Dest, Src, (size_t)Len);
-                Src += Len;
-            }  else {
-#ifdef FIFO_LOG_TO_FILE
-            fprintf (FifoLogFh, "    !!!!!!!!!!!SPLIT COPY!!!!!!!!\n");
-#endif
-                partb = Len - parta;
-                MEMCPY(Dest, Src, (size_t)parta);
-                MEMCPY(Dest + parta, Fifos[FiFoNr].Data, (size_t)partb);
-                Src = (char*)Fifos[FiFoNr].Data + partb;
-            }
-            if ((Src - (char*)Fifos[FiFoNr].Data) >= Fifos[FiFoNr].Size) {
-                Src = (char*)Fifos[FiFoNr].Data;
-            }
-            Fifos[FiFoNr].Rd = Src;
+    Src = NextMessage (&Fifos[FiFoNr]);
+    if (Src == NULL) {
 #ifdef FIFO_LOG_TO_FILE
-            DebugPrintHeader("    ", Header);
+        fprintf (FifoLogFh, "    error FIFO_ERR_NO_DATA\n");
 #endif
-            Fifos[FiFoNr].RxCounter32++;
-            if (Fifos[FiFoNr].RxCounter == 255) Fifos[FiFoNr].RxCounter = 1;
-            else Fifos[FiFoNr].RxCounter++;
-            if (UsedCounter != Fifos[FiFoNr].RxCounter) {
-                ThrowError(1, " internal error inside fifos %s(%i): UsedCounter=0x%02X != Fifos[FiFoNr].RxCounter=0x%02X", __FILE__, __LINE__, (int)UsedCounter, (int)Fifos[FiFoNr].RxCounter);
-            }
-            XLeaveCriticalSection(&FiFosCriticalSection);
-
-            return 0;
-        }
+        return FIFO_ERR_NO_DATA;
+    }
+    *Header = *Src;
+    if ((Src->Size < 0) || (Src->Size > MaxLen)) {
 #ifdef FIFO_LOG_TO_FILE
         fprintf (FifoLogFh, "    error FIFO_ERR_MESSAGE_TO_BIG\n");
 #endif
-        XLeaveCriticalSection(&FiFosCriticalSection);
         return FIFO_ERR_MESSAGE_TO_BIG;
     }
+    MEMCPY (Data, Src + 1, (size_t)Src->Size);
 #ifdef FIFO_LOG_TO_FILE
-    fprintf (FifoLogFh, "    error FIFO_ERR_NO_DATA\n");
+    DebugPrintHeader("    ", Header);
 #endif
-    XLeaveCriticalSection(&FiFosCriticalSection);
-    return FIFO_ERR_NO_DATA;
+    ReleaseMessage (&Fifos[FiFoNr], Src);
+    return 0;
 }
 
 
 int CheckFiFo (int FiFoId, FIFO_ENTRY_HEADER *Header)
 {
     int FiFoNr;
-    FIFO *FiFoDebug;
-	unsigned char UsedCounter;
 
 #ifdef FIFO_LOG_TO_FILE
     fprintf (FifoLogFh, "CheckFiFo(FiFoId = %i, Header)\n",
@@ -513,52 +479,23 @@ int CheckFiFo (int FiFoId, FIFO_ENTRY_HEADER *Header)
 #endif
     FiFoNr = FiFoId & 0xFFFF;
     if ((FiFoNr < 0) || (FiFoNr >= MAX_FIFOS)) return FIFO_ERR_INVALID_PARAMETER;
-    FiFoDebug = &(Fifos[FiFoNr]);
     if (Fifos[FiFoNr].FiFoId != FiFoId) return FIFO_ERR_UNKNOWN_HANDLE;
-    XEnterCriticalSection(&FiFosCriticalSection);
-    UsedCounter = *(unsigned char*)Fifos[FiFoNr].Rd;
-    if (UsedCounter) {    // Is Used?
-		int parta, partb;
-        char *Dest;
-        char *Src;
-
-        // Copy message head
-        Dest = (char*)Header;
-        Src = (char*)Fifos[FiFoNr].Rd;
-        if ((Src - (char*)Fifos[FiFoNr].Data) >= Fifos[FiFoNr].Size) {
-            Src = (char*)Fifos[FiFoNr].Data;
-        }
-
-        parta = (int)(Fifos[FiFoNr].Size - (Src - (char*)Fifos[FiFoNr].Data));
-        if (parta >= (int)sizeof (FIFO_ENTRY_HEADER)) {
-            MEMCPY (Dest, Src, sizeof (FIFO_ENTRY_HEADER));
-        } else {
+    if (PeekFiFoMessage (FiFoId, Header) == NULL) {
 #ifdef FIFO_LOG_TO_FILE
-            fprintf (FifoLogFh, "    !!!!!!!!!!!SPLIT COPY!!!!!!!!\n");
+        fprintf (FifoLogFh, "    error FIFO_ERR_NO_DATA\n");
 #endif
-            partb = (int)sizeof(FIFO_ENTRY_HEADER) - parta;
-            MEMCPY (Dest, Src, (size_t)parta);
-            MEMCPY (&Dest[parta], Fifos[FiFoNr].Data, (size_t)partb);
-        }
-#ifdef FIFO_LOG_TO_FILE
-        DebugPrintHeader("    ", Header);
-#endif
-        XLeaveCriticalSection(&FiFosCriticalSection);
-        return 1;
+        return FIFO_ERR_NO_DATA;
     }
 #ifdef FIFO_LOG_TO_FILE
-    fprintf (FifoLogFh, "    error FIFO_ERR_NO_DATA\n");
+    DebugPrintHeader("    ", Header);
 #endif
-    XLeaveCriticalSection(&FiFosCriticalSection);
-    return FIFO_ERR_NO_DATA;
+    return 1;
 }
 
 int RemoveOneMessageFromFiFo (int FiFoId)
 {
     int FiFoNr;
-    FIFO_ENTRY_HEADER Header;
-	unsigned char UsedCounter;
-
+    FIFO_ENTRY_HEADER *Header;
 
 #ifdef FIFO_LOG_TO_FILE
     fprintf (FifoLogFh, "RemoveOneMessageFromFiFo(FiFoId = %i)\n",
@@ -567,69 +504,18 @@ int RemoveOneMessageFromFiFo (int FiFoId)
     FiFoNr = FiFoId & 0xFFFF;
     if ((FiFoNr < 0) || (FiFoNr >= MAX_FIFOS)) return FIFO_ERR_INVALID_PARAMETER;
     if (Fifos[FiFoNr].FiFoId != FiFoId) return FIFO_ERR_UNKNOWN_HANDLE;
-    XEnterCriticalSection(&FiFosCriticalSection);
-    UsedCounter = *(unsigned char*)Fifos[FiFoNr].Rd;
-    if (UsedCounter) {    // Is used?
-		int parta, partb;
-        char *Dest;
-        char *Src;
-        int Len;
-
-        // Copy message head
-        Dest = (char*)&Header;
-        Src = (char*)Fifos[FiFoNr].Rd;
-
-        parta = (int)(Fifos[FiFoNr].Size - (Src - (char*)Fifos[FiFoNr].Data));
-        if (parta >= (int)sizeof (FIFO_ENTRY_HEADER)) {
-            MEMCPY (Dest, Src, sizeof (FIFO_ENTRY_HEADER));
-            Src += sizeof (FIFO_ENTRY_HEADER);
-        } else {
+    Header = NextMessage (&Fifos[FiFoNr]);
+    if (Header == NULL) {
 #ifdef FIFO_LOG_TO_FILE
-            fprintf (FifoLogFh, "    !!!!!!!!!!!SPLIT COPY!!!!!!!!\n");
+        fprintf (FifoLogFh, "    error FIFO_ERR_NO_DATA\n");
 #endif
-            partb = (int)sizeof(FIFO_ENTRY_HEADER) - parta;
-            MEMCPY (Dest, Src, (size_t)parta);
-            MEMCPY (&Dest[parta], Fifos[FiFoNr].Data, (size_t)partb);
-            Src = (char*)Fifos[FiFoNr].Data + partb;
-        }
-#ifdef FIFO_LOG_TO_FILE
-        DebugPrintHeader("    ", &Header);
-#endif
-        Len = Header.Size;
-        if (Len >= 0) {
-            // Then the data
-            parta = (int)(Fifos[FiFoNr].Size - (Src - (char*)Fifos[FiFoNr].Data));
-            if (parta >= Len) {
-                Src += Len;
-            }  else {
-                partb = Len - parta;
-                Src = (char*)Fifos[FiFoNr].Data + partb;
-            }
-            if ((Src - (char*)Fifos[FiFoNr].Data) >= Fifos[FiFoNr].Size) {
-                Src = (char*)Fifos[FiFoNr].Data;
-            }
-            Fifos[FiFoNr].Rd = Src;
-
-            Fifos[FiFoNr].RxCounter32++;
-            if (Fifos[FiFoNr].RxCounter == 255) Fifos[FiFoNr].RxCounter = 1;
-            else Fifos[FiFoNr].RxCounter++;
-            if (UsedCounter != Fifos[FiFoNr].RxCounter) {
-                ThrowError(1, " internal error inside fifos %s(%i): UsedCounter=0x%02X != Fifos[FiFoNr].RxCounter=0x%02X", __FILE__, __LINE__, (int)UsedCounter, (int)Fifos[FiFoNr].RxCounter);
-            }
-            XLeaveCriticalSection(&FiFosCriticalSection);
-            return 0;
-        }
-#ifdef FIFO_LOG_TO_FILE
-        fprintf (FifoLogFh, "    error FIFO_ERR_MESSAGE_TO_BIG\n");
-#endif
-        XLeaveCriticalSection(&FiFosCriticalSection);
-        return FIFO_ERR_MESSAGE_TO_BIG;
+        return FIFO_ERR_NO_DATA;
     }
 #ifdef FIFO_LOG_TO_FILE
-    fprintf (FifoLogFh, "    error FIFO_ERR_NO_DATA\n");
+    DebugPrintHeader("    ", Header);
 #endif
-    XLeaveCriticalSection(&FiFosCriticalSection);
-    return FIFO_ERR_NO_DATA;
+    ReleaseMessage (&Fifos[FiFoNr], Header);
+    return 0;
 }
 
 int DeleteFiFo(int FiFoId, int RxPid)
@@ -759,6 +645,7 @@ int SyncTxFiFos (void *Buffer, int Len, int *DataToTransmit)
 
 int InitFiFos (void)
 {
+    int x;
 #ifdef FIFO_LOG_TO_FILE
     static char Buffer[2];
     //FifoLogFh = open_file (FIFO_LOG_TO_FILE, "wt");
@@ -767,9 +654,12 @@ int InitFiFos (void)
 	setvbuf(FifoLogFh, Buffer, _IOFBF, 2);  // no buffer
 #endif
 
-	if (sizeof(FIFO) != 128) {
-		printf("sizeof(FIFO) = %i != 128\n", (int)sizeof(FIFO));
+	if (sizeof(FIFO) != 192) {
+		printf("sizeof(FIFO) = %i != 192\n", (int)sizeof(FIFO));
 	}
+    for (x = 0; x < MAX_FIFOS; x++) {
+        InitializeCriticalSection (&FiFoWriteCriticalSections[x]);
+    }
 #ifdef REMOTE_MASTER
     return CreateNewRxFifo (0, SYNC_FIFO_SIZE, "SyncFiFo");
 #else
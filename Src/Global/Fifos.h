@@ -63,6 +63,17 @@ int CheckFiFo (int FiFoId, FIFO_ENTRY_HEADER *Header);
 int RemoveOneMessageFromFiFo (int FiFoId);
 int DeleteFiFo(int FiFoId, int RxPid);
 
+// Zero copy write: reserve space for a message with Len data bytes and return a pointer
+// where the data can be written directly into the fifo (or NULL, than *ret_Error is set).
+// Other writers to the same fifo are blocked till CommitFiFoMessage() is called,
+// Len of CommitFiFoMessage() can be smaller than the reserved one.
+void *ReserveFiFoMessage (int32_t FiFoId, int Len, int *ret_Error);
+int CommitFiFoMessage (int32_t FiFoId, uint32_t MessageId, int TramsmiterPid, uint64_t Timestamp, int Len);
+// Zero copy read: return a pointer to the data of the next message inside the fifo or NULL if it is empty.
+// The message stays inside the fifo till RemoveOneMessageFromFiFo() is called.
+// All read functions should only be called by the receiving process.
+void *PeekFiFoMessage (int FiFoId, FIFO_ENTRY_HEADER *ret_Header);
+
 // This is only neccessary for remote master
 // Each time a network package is reseved from the remote master this must be called
 int SyncRxFiFos (void *Buffer, int Len);
@@ -168,5 +168,6 @@ int ScriptImportVariablesProperties (char *Filename)
         ImportOneVariablePropertiesFlags (Fd, Variname, 1, 1, 1, 1, 1, 1);
     }
     IniFileDataBaseClose (Fd);
+    flush_varinfos_to_ini ();
     return 0;
 }
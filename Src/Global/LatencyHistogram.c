@@ -0,0 +1,194 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "MemZeroAndCopy.h"
+#include "PrintFormatToString.h"
+#include "AtomicAccess.h"
+#include "LatencyHistogram.h"
+
+#define SUB_BUCKET_COUNT       (1 << LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+#define HALF_SUB_BUCKET_COUNT  (1 << (LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1))
+
+static int MostSignificantBit (uint64_t par_Value)
+{
+#ifdef _MSC_VER
+    unsigned long Index;
+    _BitScanReverse64(&Index, par_Value);
+    return (int)Index;
+#else
+    return 63 - __builtin_clzll(par_Value);
+#endif
+}
+
+int LatencyHistogramBucketIndex (uint64_t par_Value)
+{
+    int Msb, Shift, Index;
+
+    if (par_Value < SUB_BUCKET_COUNT) return (int)par_Value;
+    Msb = MostSignificantBit (par_Value);
+    if (Msb >= LATENCY_HISTOGRAM_MAX_VALUE_BITS) return LATENCY_HISTOGRAM_BUCKETS - 1;
+    Shift = Msb - LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 1;
+    // (par_Value >> Shift) is inside [HALF_SUB_BUCKET_COUNT, SUB_BUCKET_COUNT)
+    Index = SUB_BUCKET_COUNT + (Shift - 1) * HALF_SUB_BUCKET_COUNT + (int)(par_Value >> Shift) - HALF_SUB_BUCKET_COUNT;
+    return Index;
+}
+
+uint64_t LatencyHistogramBucketLowerBound (int par_Index)
+{
+    int Shift, Sub;
+
+    if (par_Index < SUB_BUCKET_COUNT) return (uint64_t)par_Index;
+    Shift = (par_Index - SUB_BUCKET_COUNT) / HALF_SUB_BUCKET_COUNT + 1;
+    Sub = (par_Index - SUB_BUCKET_COUNT) % HALF_SUB_BUCKET_COUNT + HALF_SUB_BUCKET_COUNT;
+    return (uint64_t)Sub << Shift;
+}
+
+uint64_t LatencyHistogramBucketUpperBound (int par_Index)
+{
+    if (par_Index >= (LATENCY_HISTOGRAM_BUCKETS - 1)) return UINT64_MAX;
+    return LatencyHistogramBucketLowerBound (par_Index + 1) - 1;
+}
+
+void InitLatencyHistogram (LATENCY_HISTOGRAM *par_Histogram)
+{
+    MEMSET (par_Histogram, 0, sizeof (LATENCY_HISTOGRAM));
+    par_Histogram->Min = UINT64_MAX;
+}
+
+void LatencyHistogramRecord (LATENCY_HISTOGRAM *par_Histogram, uint64_t par_Value)
+{
+    if (ATOMIC_LOAD_ACQUIRE_U32 (&par_Histogram->ResetRequest)) {
+        MEMSET (par_Histogram->Counts, 0, sizeof (par_Histogram->Counts));
+        par_Histogram->TotalCount = 0;
+        par_Histogram->Sum = 0;
+        par_Histogram->Max = 0;
+        par_Histogram->Min = UINT64_MAX;
+        ATOMIC_STORE_RELEASE_U32 (&par_Histogram->ResetRequest, 0);
+    }
+    // Only one writer, so no atomic read modify write is necessary
+    par_Histogram->Counts[LatencyHistogramBucketIndex (par_Value)]++;
+    par_Histogram->TotalCount++;
+    par_Histogram->Sum += par_Value;
+    if (par_Value > par_Histogram->Max) par_Histogram->Max = par_Value;
+    if (par_Value < par_Histogram->Min) par_Histogram->Min = par_Value;
+}
+
+void LatencyHistogramRequestReset (LATENCY_HISTOGRAM *par_Histogram)
+{
+    ATOMIC_STORE_RELEASE_U32 (&par_Histogram->ResetRequest, 1);
+}
+
+uint64_t LatencyHistogramPercentile (const LATENCY_HISTOGRAM *par_Histogram, double par_Percentile)
+{
+    uint64_t Total = 0, Limit, Sum = 0, Max;
+    int x;
+
+    // The writer can be active, so count the buckets and do not use TotalCount
+    for (x = 0; x < LATENCY_HISTOGRAM_BUCKETS; x++) {
+        Total += par_Histogram->Counts[x];
+    }
+    if (Total == 0) return 0;
+    if (par_Percentile >= 100.0) Limit = Total;
+    else if (par_Percentile <= 0.0) Limit = 1;
+    else {
+        Limit = (uint64_t)((par_Percentile / 100.0) * (double)Total + 0.999999);
+        if (Limit < 1) Limit = 1;
+        if (Limit > Total) Limit = Total;
+    }
+    Max = par_Histogram->Max;
+    for (x = 0; x < LATENCY_HISTOGRAM_BUCKETS; x++) {
+        Sum += par_Histogram->Counts[x];
+        if (Sum >= Limit) {
+            uint64_t Upper = LatencyHistogramBucketUpperBound (x);
+            return (Upper > Max) ? Max : Upper;
+        }
+    }
+    return Max;
+}
+
+int LatencyHistogramToString (const LATENCY_HISTOGRAM *par_Histogram, const char *par_Name, char *ret_Buffer, int par_MaxChars)
+{
+    int Pos, x;
+    uint64_t Count = par_Histogram->TotalCount;
+
+    Pos = PrintFormatToString (ret_Buffer, par_MaxChars,
+                               "%s: count=%llu min=%llu mean=%llu p50=%llu p90=%llu p99=%llu p99.9=%llu p99.99=%llu max=%llu [ns]\n",
+                               par_Name, (unsigned long long)Count,
+                               (unsigned long long)((Count > 0) ? par_Histogram->Min : 0),
+                               (unsigned long long)((Count > 0) ? par_Histogram->Sum / Count : 0),
+                               (unsigned long long)LatencyHistogramPercentile (par_Histogram, 50.0),
+                               (unsigned long long)LatencyHistogramPercentile (par_Histogram, 90.0),
+                               (unsigned long long)LatencyHistogramPercentile (par_Histogram, 99.0),
+                               (unsigned long long)LatencyHistogramPercentile (par_Histogram, 99.9),
+                               (unsigned long long)LatencyHistogramPercentile (par_Histogram, 99.99),
+                               (unsigned long long)par_Histogram->Max);
+    for (x = 0; (x < LATENCY_HISTOGRAM_BUCKETS) && (Pos < (par_MaxChars - 1)); x++) {
+        uint64_t BucketCount = par_Histogram->Counts[x];
+        if (BucketCount) {
+            Pos += PrintFormatToString (ret_Buffer + Pos, par_MaxChars - Pos, "  %llu...%llu: %llu\n",
+                                        (unsigned long long)LatencyHistogramBucketLowerBound (x),
+                                        (unsigned long long)LatencyHistogramBucketUpperBound (x),
+                                        (unsigned long long)BucketCount);
+        }
+    }
+    return Pos;
+}
+
+void AddOverrunEvent (OVERRUN_EVENT_RING *par_Ring, uint64_t par_Cycle, uint64_t par_TimeStamp, uint64_t par_Duration, int par_Pid)
+{
+    uint32_t WritePos = par_Ring->WritePos;
+    OVERRUN_EVENT *Event = &(par_Ring->Events[WritePos % OVERRUN_EVENT_RING_SIZE]);
+    Event->Cycle = par_Cycle;
+    Event->TimeStamp = par_TimeStamp;
+    Event->Duration = par_Duration;
+    Event->Pid = par_Pid;
+    ATOMIC_STORE_RELEASE_U32 (&par_Ring->WritePos, WritePos + 1);
+}
+
+uint32_t GetOverrunEventCount (OVERRUN_EVENT_RING *par_Ring)
+{
+    return ATOMIC_LOAD_ACQUIRE_U32 (&par_Ring->WritePos);
+}
+
+int GetOverrunEvents (OVERRUN_EVENT_RING *par_Ring, OVERRUN_EVENT *ret_Events, int par_MaxEvents)
+{
+    uint32_t WritePos, WritePosAfter, Start, x;
+    int Count = 0;
+
+    WritePos = ATOMIC_LOAD_ACQUIRE_U32 (&par_Ring->WritePos);
+    Start = (WritePos > OVERRUN_EVENT_RING_SIZE) ? WritePos - OVERRUN_EVENT_RING_SIZE : 0;
+    if ((WritePos - Start) > (uint32_t)par_MaxEvents) Start = WritePos - (uint32_t)par_MaxEvents;
+    for (x = Start; x != WritePos; x++) {
+        ret_Events[Count++] = par_Ring->Events[x % OVERRUN_EVENT_RING_SIZE];
+    }
+    // Throw away the events the writer has overwritten during the copy,
+    // the slot at WritePosAfter can be written just now so count it also as lost
+    WritePosAfter = ATOMIC_LOAD_ACQUIRE_U32 (&par_Ring->WritePos) + 1;
+    if ((WritePosAfter - Start) > OVERRUN_EVENT_RING_SIZE) {
+        uint32_t Lost = (WritePosAfter - Start) - OVERRUN_EVENT_RING_SIZE;
+        if (Lost >= (uint32_t)Count) return 0;
+        memmove (ret_Events, ret_Events + Lost, (Count - Lost) * sizeof (OVERRUN_EVENT));
+        Count -= (int)Lost;
+    }
+    return Count;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <stdint.h>
+
+// Log-linear histogram (HDR style) for runtime and latency measurements in nanoseconds.
+// Each power of two range is divided into 2^(LATENCY_HISTOGRAM_SUB_BUCKET_BITS-1) linear
+// buckets, so the relative error of a value is smaller than 1/2^(LATENCY_HISTOGRAM_SUB_BUCKET_BITS-1).
+// Values below 2^LATENCY_HISTOGRAM_SUB_BUCKET_BITS are stored exactly, values larger than
+// 2^LATENCY_HISTOGRAM_MAX_VALUE_BITS are counted inside the last bucket.
+//
+// There must be only one writer (the scheduler thread) calling LatencyHistogramRecord(),
+// the readers can access the histogram at any time without a lock. A reset is only requested
+// by the reader and will be done by the writer with the next record.
+#define LATENCY_HISTOGRAM_SUB_BUCKET_BITS  5
+#define LATENCY_HISTOGRAM_MAX_VALUE_BITS   40   // ~18 minutes
+#define LATENCY_HISTOGRAM_BUCKETS  ((1 << LATENCY_HISTOGRAM_SUB_BUCKET_BITS) + \
+                                    (LATENCY_HISTOGRAM_MAX_VALUE_BITS - LATENCY_HISTOGRAM_SUB_BUCKET_BITS) * (1 << (LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1)))
+
+typedef struct {
+    uint64_t Counts[LATENCY_HISTOGRAM_BUCKETS];
+    uint64_t TotalCount;
+    uint64_t Sum;
+    uint64_t Min;
+    uint64_t Max;
+    uint32_t ResetRequest;
+} LATENCY_HISTOGRAM;
+
+void InitLatencyHistogram (LATENCY_HISTOGRAM *par_Histogram);
+void LatencyHistogramRecord (LATENCY_HISTOGRAM *par_Histogram, uint64_t par_Value);
+void LatencyHistogramRequestReset (LATENCY_HISTOGRAM *par_Histogram);
+
+int LatencyHistogramBucketIndex (uint64_t par_Value);
+uint64_t LatencyHistogramBucketLowerBound (int par_Index);
+uint64_t LatencyHistogramBucketUpperBound (int par_Index);
+
+// par_Percentile in range 0.0 ... 100.0, returns the upper bound of the bucket (but not larger than Max)
+uint64_t LatencyHistogramPercentile (const LATENCY_HISTOGRAM *par_Histogram, double par_Percentile);
+
+// Print a summary line and all not empty buckets, returns the number of written chars
+int LatencyHistogramToString (const LATENCY_HISTOGRAM *par_Histogram, const char *par_Name, char *ret_Buffer, int par_MaxChars);
+
+
+// Ring with the last overrun events (one writer, lock-free readers)
+#define OVERRUN_EVENT_RING_SIZE   64
+
+typedef struct {
+    uint64_t Cycle;
+    uint64_t TimeStamp;     // ns
+    uint64_t Duration;      // ns
+    int32_t Pid;            // -1 if the whole scheduler cycle was too long
+    int32_t Fill1;
+} OVERRUN_EVENT;
+
+typedef struct {
+    OVERRUN_EVENT Events[OVERRUN_EVENT_RING_SIZE];
+    uint32_t WritePos;
+} OVERRUN_EVENT_RING;
+
+void AddOverrunEvent (OVERRUN_EVENT_RING *par_Ring, uint64_t par_Cycle, uint64_t par_TimeStamp, uint64_t par_Duration, int par_Pid);
+// Copy the last events (oldest first) into ret_Events, returns the number of copied events
+int GetOverrunEvents (OVERRUN_EVENT_RING *par_Ring, OVERRUN_EVENT *ret_Events, int par_MaxEvents);
+uint32_t GetOverrunEventCount (OVERRUN_EVENT_RING *par_Ring);
+
+#endif // LATENCYHISTOGRAM_H
@@ -32,6 +32,7 @@
 #include "InitProcess.h"
 #include "EnvironmentVariables.h"
 
+#include "FifoSyncCoding.h"
 #include "MainValues.h"
 
 MAIN_INI_VAL  s_main_ini_val;             // Global configuration
@@ -380,6 +381,13 @@ int ReadBasicConfigurationFromIni(MAIN_INI_VAL *sp_main_ini)
     IniFileDataBaseReadString (OPT_SECTION, "RemoteMasterExecutable", "", sp_main_ini->RemoteMasterExecutable, sizeof(sp_main_ini->RemoteMasterExecutable), Fd);
     sp_main_ini->RemoteMasterExecutableResoved = NULL;
     IniFileDataBaseReadString (OPT_SECTION, "RemoteMasterCopyTo", "/tmp/LinuxRemoteMaster.out", sp_main_ini->RemoteMasterCopyTo, sizeof(sp_main_ini->RemoteMasterCopyTo), Fd);
+    sp_main_ini->RemoteMasterSyncFiFoCodings = 0;
+    if (IniFileDataBaseReadYesNo (OPT_SECTION, "RemoteMasterCompactSyncFiFos", 1, Fd)) {
+        sp_main_ini->RemoteMasterSyncFiFoCodings |= FIFO_SYNC_COMPACT_HEADERS;
+    }
+    if (IniFileDataBaseReadYesNo (OPT_SECTION, "RemoteMasterCompressSyncFiFos", 0, Fd)) {
+        sp_main_ini->RemoteMasterSyncFiFoCodings |= FIFO_SYNC_LZ_COMPRESSION;
+    }
 
     IniFileDataBaseReadString (OPT_SECTION, "RpcOverSocketOrNamedPipe",
                                 "NamedPipe", tmp_str, sizeof (tmp_str), Fd);
@@ -739,6 +747,8 @@ int WriteBasicConfigurationToIni(MAIN_INI_VAL *sp_main_ini)
         IniFileDataBaseWriteYesNo (OPT_SECTION, "CopyAndStartRemoteMaster", s_main_ini_val.CopyAndStartRemoteMaster, Fd);
         IniFileDataBaseWriteString (OPT_SECTION, "RemoteMasterExecutable", s_main_ini_val.RemoteMasterExecutable, Fd);
         IniFileDataBaseWriteString (OPT_SECTION, "RemoteMasterCopyTo", s_main_ini_val.RemoteMasterCopyTo, Fd);
+        IniFileDataBaseWriteYesNo (OPT_SECTION, "RemoteMasterCompactSyncFiFos", (s_main_ini_val.RemoteMasterSyncFiFoCodings & FIFO_SYNC_COMPACT_HEADERS) == FIFO_SYNC_COMPACT_HEADERS, Fd);
+        IniFileDataBaseWriteYesNo (OPT_SECTION, "RemoteMasterCompressSyncFiFos", (s_main_ini_val.RemoteMasterSyncFiFoCodings & FIFO_SYNC_LZ_COMPRESSION) == FIFO_SYNC_LZ_COMPRESSION, Fd);
     } else {
         IniFileDataBaseWriteString (OPT_SECTION, "ConnectToRemoteMaster", NULL, Fd);
         IniFileDataBaseWriteString (OPT_SECTION, "RemoteMasterName", NULL, Fd);
@@ -746,6 +756,8 @@ int WriteBasicConfigurationToIni(MAIN_INI_VAL *sp_main_ini)
         IniFileDataBaseWriteString (OPT_SECTION, "CopyAndStartRemoteMaster", NULL, Fd);
         IniFileDataBaseWriteString (OPT_SECTION, "RemoteMasterExecutable", NULL, Fd);
         IniFileDataBaseWriteString (OPT_SECTION, "RemoteMasterCopyTo", NULL, Fd);
+        IniFileDataBaseWriteString (OPT_SECTION, "RemoteMasterCompactSyncFiFos", NULL, Fd);
+        IniFileDataBaseWriteString (OPT_SECTION, "RemoteMasterCompressSyncFiFos", NULL, Fd);
     }
     IniFileDataBaseWriteString (OPT_SECTION, "RpcOverSocketOrNamedPipe",
                                (sp_main_ini->RpcOverSocketOrNamedPipe != 0) ? "Socket" : "NamedPipe", Fd);
@@ -145,6 +145,7 @@ typedef struct
   char            RemoteMasterExecutable[MAX_PATH];
   char            RemoteMasterCopyTo[MAX_PATH];
   char*           RemoteMasterExecutableResoved;
+  uint32_t        RemoteMasterSyncFiFoCodings;   // FIFO_SYNC_xxx
 
   int             DontWriteBlackbardVariableInfosToIni;
   int             DontSaveBlackbardVariableInfosIniSection;
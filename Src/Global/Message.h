@@ -71,7 +71,7 @@
 #define RDPIPE_LOGON         301
 #define RDPIPE_LOGOFF        302
 #define RDPIPE_SEND_TRIGGER  303
-#define RDPIPE_SEND_WRFLAG   304
+#define RDPIPE_START         304
 #define RDPIPE_SEND_LENGTH   305
 #define RDPIPE_ACK           306
 #define RDPIPE_DEC_PHYS_MASK 307
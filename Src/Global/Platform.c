@@ -86,13 +86,18 @@ int SetEnvironmentVariable(const char *EnvVarName,
 int sc_pthread_cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *mutex, int time_ms)
 {
     struct timespec abstime;
-    double help;
 
-    clock_gettime(CLOCK_MONOTONIC, &abstime);
-    help = (double)abstime.tv_sec + (double)abstime.tv_nsec * 0.000000001;
-    help += (double)time_ms * 1000.0;
-    abstime.tv_sec = (time_t)help;
-    abstime.tv_nsec = (time_t)(help - (double)abstime.tv_sec);
+    if (time_ms < 0) {  // INFINITE
+        return pthread_cond_wait(cond, mutex);
+    }
+    // the condition variables are initialized with the default clock (CLOCK_REALTIME)
+    clock_gettime(CLOCK_REALTIME, &abstime);
+    abstime.tv_sec += time_ms / 1000;
+    abstime.tv_nsec += (long)(time_ms % 1000) * 1000000L;
+    if (abstime.tv_nsec >= 1000000000L) {
+        abstime.tv_sec++;
+        abstime.tv_nsec -= 1000000000L;
+    }
     return pthread_cond_timedwait(cond, mutex, &abstime);
 }
 
@@ -449,3 +454,59 @@ uint64_t my_get_file_size(MY_FILE_HANDLE File)
     }
 #endif
 }
+
+void *my_map_file(MY_FILE_HANDLE File, uint64_t Size, void **ret_MapHandle)
+{
+#ifdef _WIN32
+    HANDLE hMap;
+    void *Ret;
+
+    *ret_MapHandle = NULL;
+    if ((Size == 0) || (Size > (uint64_t)SIZE_MAX)) return NULL;
+    hMap = CreateFileMapping (File, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (hMap == NULL) return NULL;
+    Ret = MapViewOfFile (hMap, FILE_MAP_READ, 0, 0, (SIZE_T)Size);
+    if (Ret == NULL) {
+        CloseHandle (hMap);
+        return NULL;
+    }
+    *ret_MapHandle = (void*)hMap;
+    return Ret;
+#else
+    void *Ret;
+
+    *ret_MapHandle = NULL;
+    if ((Size == 0) || (Size > (uint64_t)SIZE_MAX)) return NULL;
+    Ret = mmap (NULL, (size_t)Size, PROT_READ, MAP_PRIVATE, File, 0);
+    if (Ret == MAP_FAILED) return NULL;
+    // the files will be read from the beginning to the end
+    madvise (Ret, (size_t)Size, MADV_SEQUENTIAL);
+    return Ret;
+#endif
+}
+
+void my_map_file_will_need(void *Address, uint64_t Offset, uint64_t Size)
+{
+#ifdef _WIN32
+    UNUSED(Address);
+    UNUSED(Offset);
+    UNUSED(Size);
+#else
+    // madvise needs a page aligned address
+    uint64_t PageSize = (uint64_t)sysconf (_SC_PAGESIZE);
+    uint64_t Start = Offset & ~(PageSize - 1);
+    madvise ((char*)Address + Start, (size_t)(Size + (Offset - Start)), MADV_WILLNEED);
+#endif
+}
+
+void my_unmap_file(void *Address, uint64_t Size, void *MapHandle)
+{
+#ifdef _WIN32
+    UNUSED(Size);
+    UnmapViewOfFile (Address);
+    if (MapHandle != NULL) CloseHandle ((HANDLE)MapHandle);
+#else
+    UNUSED(MapHandle);
+    munmap (Address, (size_t)Size);
+#endif
+}
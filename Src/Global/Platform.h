@@ -438,6 +438,11 @@ int my_read(MY_FILE_HANDLE File, void* DstBuf, unsigned int Count);
 void my_lseek(MY_FILE_HANDLE File, uint64_t Offset);
 uint64_t my_ftell(MY_FILE_HANDLE File);
 uint64_t my_get_file_size(MY_FILE_HANDLE File);
+// Map a whole file read only into memory, returns NULL if this is not possible
+void *my_map_file(MY_FILE_HANDLE File, uint64_t Size, void **ret_MapHandle);
+// Hint that a part of a mapped file will be accessed soon (read ahead)
+void my_map_file_will_need(void *Address, uint64_t Offset, uint64_t Size);
+void my_unmap_file(void *Address, uint64_t Size, void *MapHandle);
 //#endif
 #ifdef __cplusplus
 }
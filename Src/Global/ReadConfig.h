@@ -55,6 +55,7 @@
 #define TEXT_FORMAT_TOKEN                 286
 #define HDRECORDER_PHYSICAL_TOKEN         287
 #define MDF4_FORMAT_TOKEN                 288
+#define COLUMN_FORMAT_TOKEN               289
 
 #define HDRECORDER_CONFIG_FILE_TOKEN  300
 #define HDRECORDER_SAMPLERATE_TOKEN   301
@@ -65,6 +66,8 @@
 #define HDPLAYER_CONFIG_FILE_TOKEN    306
 #define MCSREC_FORMAT_TOKEN           307
 #define ALL_LABEL_OF_PROCESS_TOKEN    308
+#define HDPLAYER_START_TIME_TOKEN     309
+#define HDPLAYER_READ_AHEAD_SLOTS_TOKEN 310
 
 typedef struct {
 	char *s;
@@ -80,9 +83,12 @@ extern TOKEN_LIST tokens[]
 			   {"HDPLAYER_CONFIG_FILE",    HDPLAYER_CONFIG_FILE_TOKEN},
 			   {"TRIGGER",                 TRIGGER_TOKEN},
 			   {"HDPLAYER_FILE",           HDPLAYER_FILE_TOKEN},
+               {"HDPLAYER_START_TIME",     HDPLAYER_START_TIME_TOKEN},
+               {"HDPLAYER_READ_AHEAD_SLOTS", HDPLAYER_READ_AHEAD_SLOTS_TOKEN},
 			   {"MDF_FORMAT",              MDF_FORMAT_TOKEN},
                {"MDF3_FORMAT",             MDF_FORMAT_TOKEN},
                {"MDF4_FORMAT",             MDF4_FORMAT_TOKEN},
+               {"COLUMN_FORMAT",           COLUMN_FORMAT_TOKEN},
                {"TEXT_FORMAT",             TEXT_FORMAT_TOKEN},
                {"ALL_LABEL_OF_PROCESS",    ALL_LABEL_OF_PROCESS_TOKEN},
                {"VARCOUNT",                VARCOUNT_TOKEN},
@@ -419,6 +419,8 @@ int TerminateSelf (void)
         WriteBasicConfigurationToIni (&s_main_ini_val);
         if (s_main_ini_val.ConnectToRemoteMaster) {
             rm_WriteBackVariableSectionCache();
+        } else {
+            flush_varinfos_to_ini();
         }
         IniFileDataBaseSave(GetMainFileDescriptor(), NULL, INIFILE_DATABAE_OPERATION_REMOVE);
     }
@@ -1238,6 +1238,195 @@ char *IniFileDataBaseReadStringBufferNoDef (const char* par_Section, const char*
     return Ret;
 }
 
+typedef struct {
+    const char *Entry;
+    int Pos;
+} SORTED_ENTRY_REQUEST;
+
+static int SortEntryRequestCompareFunction (const void *a, const void *b)
+{
+    return strcmp(((const SORTED_ENTRY_REQUEST*)a)->Entry, ((const SORTED_ENTRY_REQUEST*)b)->Entry);
+}
+
+// Compare the entry name of a line (terminated by '=') with a requested entry name
+static int CompareLineWithEntry (const char *par_Line, const char *par_Entry)
+{
+    uint32_t a, b;
+    for (;;) {
+        a = (*par_Line == '=') ? 0 : (uint32_t)CHAR_UPPER((unsigned char)*par_Line);
+        b = (uint32_t)CHAR_UPPER((unsigned char)*par_Entry);
+        if ((a != b) || (a == 0)) {
+            return (int)a - (int)b;
+        }
+        par_Line++; par_Entry++;
+    }
+}
+
+int IniFileDataBaseReadStringBuffers (const char* par_Section, const char **par_Entrys, int par_Count,
+                                      char **ret_Texts, int par_FileDescriptor)
+{
+    int FileIndex;
+    int x, Found = 0;
+    INI_DB_SECTION_ELEM *Section;
+    SORTED_ENTRY_REQUEST *Sorted;
+
+    for (x = 0; x < par_Count; x++) {
+        ret_Texts[x] = NULL;
+    }
+    if (par_Count <= 0) return 0;
+    Sorted = (SORTED_ENTRY_REQUEST*)my_malloc((size_t)par_Count * sizeof(SORTED_ENTRY_REQUEST));
+    if (Sorted == NULL) return -1;
+    for (x = 0; x < par_Count; x++) {
+        Sorted[x].Entry = par_Entrys[x];
+        Sorted[x].Pos = x;
+    }
+    qsort (Sorted, (size_t)par_Count, sizeof(SORTED_ENTRY_REQUEST), SortEntryRequestCompareFunction);
+
+    INI_ENTER_CS(&IniDBCriticalSection);
+    FileIndex = GetIndexByDescriptor(par_FileDescriptor);
+    if (FileIndex >= 0) {
+        Section = GetSection(FileIndex, par_Section);
+        if (Section != NULL) {
+            int e;
+            // Only one pass through the section, each line will be searched inside the sorted request list
+            for (e = 0; (e < Section->EntryCount) && (Found < par_Count); e++) {
+                const char *EntryLine = Section->Entrys[e];
+                const char *Text = strchr(EntryLine, '=');
+                int l = 0;
+                int r = par_Count;
+                if (Text == NULL) continue;
+                while (l < r) {
+                    int m = (l + r) >> 1;
+                    if (CompareLineWithEntry(EntryLine, Sorted[m].Entry) > 0) {
+                        l = m + 1;
+                    } else {
+                        r = m;
+                    }
+                }
+                // l is now the first request equal or larger than the line, same names can be requested more than once
+                for (; (l < par_Count) && (CompareLineWithEntry(EntryLine, Sorted[l].Entry) == 0); l++) {
+                    if (ret_Texts[Sorted[l].Pos] == NULL) {   // the first line wins (same as IniFileDataBaseReadStringBufferNoDef)
+                        ret_Texts[Sorted[l].Pos] = StringMalloc(Text + 1);
+                        Found++;
+                    }
+                }
+            }
+        }
+    }
+    INI_LEAVE_CS(&IniDBCriticalSection);
+    my_free(Sorted);
+    return Found;
+}
+
+// Same name requested more than once: the last one (highest position) should be sorted to the end
+static int SortEntryWriteRequestCompareFunction (const void *a, const void *b)
+{
+    int Ret = strcmp(((const SORTED_ENTRY_REQUEST*)a)->Entry, ((const SORTED_ENTRY_REQUEST*)b)->Entry);
+    if (Ret == 0) {
+        Ret = ((const SORTED_ENTRY_REQUEST*)a)->Pos - ((const SORTED_ENTRY_REQUEST*)b)->Pos;
+    }
+    return Ret;
+}
+
+static int ReplaceEntryText(INI_DB_SECTION_ELEM *par_Section, int par_Index, const char *par_Entry, const char *par_Text)
+{
+    int EntryLen = strlen(par_Entry);
+    int TextLen = strlen(par_Text);
+    char *EntryLine = my_realloc(par_Section->Entrys[par_Index], EntryLen + TextLen + 2);   // + 2 for "=" and the terminating 0
+    if (EntryLine == NULL) {
+        // we have destroyed this entry (remove it)
+        par_Section->EntryCount--;
+        for ( ; par_Index < par_Section->EntryCount; par_Index++) {
+            par_Section->Entrys[par_Index] = par_Section->Entrys[par_Index + 1];
+        }
+        return 0;
+    }
+    MEMCPY(EntryLine, par_Entry, EntryLen);
+    EntryLine[EntryLen] = '=';
+    MEMCPY(EntryLine + EntryLen + 1, par_Text, TextLen + 1);
+    par_Section->Entrys[par_Index] = EntryLine;
+    return 1;
+}
+
+int IniFileDataBaseWriteStrings (const char* par_Section, const char **par_Entrys, const char **par_Texts, int par_Count,
+                                 int par_FileDescriptor)
+{
+    int FileIndex;
+    int x, Written = 0;
+    INI_DB_SECTION_ELEM *Section;
+    SORTED_ENTRY_REQUEST *Sorted;
+    int *AddFrom;
+    char *Done;
+
+    if (par_Count <= 0) return 0;
+    Sorted = (SORTED_ENTRY_REQUEST*)my_malloc((size_t)par_Count * (sizeof(SORTED_ENTRY_REQUEST) + sizeof(int) + 1));
+    if (Sorted == NULL) return -1;
+    AddFrom = (int*)(Sorted + par_Count);
+    Done = (char*)(AddFrom + par_Count);
+    for (x = 0; x < par_Count; x++) {
+        Sorted[x].Entry = par_Entrys[x];
+        Sorted[x].Pos = x;
+        AddFrom[x] = -1;
+        Done[x] = 0;
+    }
+    qsort (Sorted, (size_t)par_Count, sizeof(SORTED_ENTRY_REQUEST), SortEntryWriteRequestCompareFunction);
+
+    INI_ENTER_CS(&IniDBCriticalSection);
+    FileIndex = GetIndexByDescriptor(par_FileDescriptor);
+    if (FileIndex >= 0) {
+        Section = GetSection(FileIndex, par_Section);
+        if (Section == NULL) {
+            Section = AddNewSection(FileIndex, par_Section);
+        }
+        if (Section != NULL) {
+            int e;
+            // Only one pass through the section, only the first line with the same name will be replaced
+            // (same as IniFileDataBaseWriteString)
+            for (e = 0; (e < Section->EntryCount) && (Written < par_Count); e++) {
+                const char *EntryLine = Section->Entrys[e];
+                int l = 0;
+                int r = par_Count;
+                if (strchr(EntryLine, '=') == NULL) continue;
+                while (l < r) {
+                    int m = (l + r) >> 1;
+                    if (CompareLineWithEntry(EntryLine, Sorted[m].Entry) > 0) {
+                        l = m + 1;
+                    } else {
+                        r = m;
+                    }
+                }
+                if ((l < par_Count) && !Done[l] && (CompareLineWithEntry(EntryLine, Sorted[l].Entry) == 0)) {
+                    // the last request with this name wins
+                    for (r = l; ((r + 1) < par_Count) && !strcmp(Sorted[l].Entry, Sorted[r + 1].Entry); r++) Done[r] = 1;
+                    Done[r] = 1;
+                    Written += r - l + 1;
+                    if (!ReplaceEntryText(Section, e, Sorted[r].Entry, par_Texts[Sorted[r].Pos])) {
+                        e--;
+                    }
+                }
+            }
+            // All not existing entrys will be added at the end in the order of the requests
+            // (at the position of the first request with the text of the last one)
+            for (x = 0; x < par_Count; x++) {
+                if (!Done[x]) {
+                    int l = x;
+                    while (((x + 1) < par_Count) && !strcmp(Sorted[l].Entry, Sorted[x + 1].Entry)) x++;
+                    AddFrom[Sorted[l].Pos] = Sorted[x].Pos;
+                }
+            }
+            for (x = 0; x < par_Count; x++) {
+                if (AddFrom[x] >= 0) {
+                    AddNewEntry(Section, par_Entrys[AddFrom[x]], strlen(par_Entrys[AddFrom[x]]),
+                                par_Texts[AddFrom[x]], strlen(par_Texts[AddFrom[x]]));
+                }
+            }
+        }
+    }
+    INI_LEAVE_CS(&IniDBCriticalSection);
+    my_free(Sorted);
+    return (FileIndex >= 0) ? 0 : -1;
+}
+
 char *IniFileDataBaseReadStringBuffer (const char* par_Section, const char* par_Entry, const char* par_DefaulText,
                                       int par_FileDescriptor)
 {
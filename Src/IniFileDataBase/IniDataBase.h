@@ -57,6 +57,14 @@ int IniFileDataBaseWriteSection (const char* section, const char* txt, int par_F
 int IniFileDataBaseReadString (const char* section, const char* par_Entry, const char* deftxt,
                                  char* txt, int nsize, int par_FileDescriptor);
 char *IniFileDataBaseReadStringBufferNoDef (const char* par_Section, const char* par_Entry, int par_FileDescriptor);
+// Read par_Count entrys of one section with a single pass through the section. ret_Texts[x] is NULL if the entry
+// don't exist, otherwise it must be freed with IniFileDataBaseReadStringBufferFree(). Returns the number of found entrys.
+int IniFileDataBaseReadStringBuffers (const char* par_Section, const char **par_Entrys, int par_Count,
+                                      char **ret_Texts, int par_FileDescriptor);
+// Write par_Count entrys of one section with a single pass through the section. The result is the same as
+// calling IniFileDataBaseWriteString() for each entry in this order. par_Texts[x] must not be NULL.
+int IniFileDataBaseWriteStrings (const char* par_Section, const char **par_Entrys, const char **par_Texts, int par_Count,
+                                 int par_FileDescriptor);
 char *IniFileDataBaseReadStringBuffer (const char* par_Section, const char* par_Entry, const char* par_DefaulText,
                                        int par_FileDescriptor);
 void IniFileDataBaseReadStringBufferFree (char *par_Buffer);
@@ -30,12 +30,14 @@
 #include "IniDataBase.h"
 #include "Blackboard.h"
 #include "BlackboardIniCache.h"
+#include "BlackboardStringPool.h"
 #include "EquationList.h"
 #include "EquationParser.h"
 #include "ExecutionStack.h"
 #include "StructsRM_Blackboard.h"
 #include "RemoteMasterNet.h"
 #include "BlackboardIniCache.h"
+#include "RemoteMasterBlackboardMirror.h"
 
 #include "RemoteMasterBlackboard.h"
 
@@ -43,6 +45,96 @@
 
 #define UNUSED(x) (void)(x)
 
+// Collect several blackboard requests and transmit them with one RM_BLACKBOARD_BATCH_CMD round trip
+typedef struct {
+    RM_BLACKBOARD_BATCH_REQ *Req;
+    int ReqLen;
+    int ReqSize;
+    int AckLen;     // sum of the expected acks
+    RM_BLACKBOARD_BATCH_ACK *Ack;
+    int AckSize;
+    int AckPos;
+    int AckCount;
+} RM_BATCH;
+
+static void BatchFree (RM_BATCH *par_Batch)
+{
+    if (par_Batch->Req != NULL) my_free (par_Batch->Req);
+    if (par_Batch->Ack != NULL) my_free (par_Batch->Ack);
+    MEMSET (par_Batch, 0, sizeof (RM_BATCH));
+}
+
+// Return the memory for a new request with the filled package header,
+// NULL if the batch is full (BatchTransact must be called first) or out of memory.
+static void *BatchAddRequest (RM_BATCH *par_Batch, int par_Command, int par_Len, int par_MaxAckLen)
+{
+    RM_PACKAGE_HEADER *Header;
+    int AlignedLen = RM_BATCH_ALIGN(par_Len);
+    int AlignedAckLen = RM_BATCH_ALIGN(par_MaxAckLen);
+
+    if (par_Batch->Req == NULL) {
+        par_Batch->ReqLen = sizeof (RM_BLACKBOARD_BATCH_REQ);
+    } else if ((par_Batch->Req->Count > 0) && ((par_Batch->AckLen + AlignedAckLen) > RM_BATCH_MAX_ACK_SIZE)) {
+        return NULL;
+    }
+    if ((par_Batch->ReqLen + AlignedLen) > par_Batch->ReqSize) {
+        par_Batch->ReqSize = par_Batch->ReqLen + AlignedLen + 4096;
+        par_Batch->Req = (RM_BLACKBOARD_BATCH_REQ*)my_realloc (par_Batch->Req, (size_t)par_Batch->ReqSize);
+        if (par_Batch->Req == NULL) {
+            par_Batch->ReqSize = 0;
+            return NULL;
+        }
+        if (par_Batch->ReqLen == (int)sizeof (RM_BLACKBOARD_BATCH_REQ)) par_Batch->Req->Count = 0;
+    }
+    Header = (RM_PACKAGE_HEADER*)((char*)par_Batch->Req + par_Batch->ReqLen);
+    MEMSET (Header, 0, (size_t)AlignedLen);
+    Header->SizeOf = (uint32_t)par_Len;
+    Header->Command = (uint32_t)par_Command;
+    par_Batch->ReqLen += AlignedLen;
+    par_Batch->AckLen += AlignedAckLen;
+    par_Batch->Req->Count++;
+    return Header;
+}
+
+// Return the number of executed requests, the acks can be fetched with BatchNextAck
+static int BatchTransact (RM_BATCH *par_Batch)
+{
+    int AckSize;
+
+    par_Batch->AckCount = 0;
+    if ((par_Batch->Req == NULL) || (par_Batch->Req->Count == 0)) return 0;
+    AckSize = (int)sizeof (RM_BLACKBOARD_BATCH_ACK) + par_Batch->AckLen;
+    if (AckSize > par_Batch->AckSize) {
+        par_Batch->Ack = (RM_BLACKBOARD_BATCH_ACK*)my_realloc (par_Batch->Ack, (size_t)AckSize);
+        if (par_Batch->Ack == NULL) {
+            par_Batch->AckSize = 0;
+            return -1;
+        }
+        par_Batch->AckSize = AckSize;
+    }
+    par_Batch->Req->OffsetRequests = sizeof (RM_BLACKBOARD_BATCH_REQ);
+    if (TransactRemoteMaster (RM_BLACKBOARD_BATCH_CMD, par_Batch->Req, par_Batch->ReqLen, par_Batch->Ack, par_Batch->AckSize) > 0) {
+        CHECK_ANSWER(par_Batch->Req, par_Batch->Ack);
+        par_Batch->AckPos = (int)par_Batch->Ack->OffsetAcks;
+        par_Batch->AckCount = par_Batch->Ack->Ret;
+    }
+    par_Batch->ReqLen = sizeof (RM_BLACKBOARD_BATCH_REQ);
+    par_Batch->AckLen = 0;
+    par_Batch->Req->Count = 0;
+    return par_Batch->AckCount;
+}
+
+static void *BatchNextAck (RM_BATCH *par_Batch)
+{
+    RM_PACKAGE_HEADER *Header;
+
+    if (par_Batch->AckCount <= 0) return NULL;
+    Header = (RM_PACKAGE_HEADER*)((char*)par_Batch->Ack + par_Batch->AckPos);
+    par_Batch->AckPos += RM_BATCH_ALIGN((int)Header->SizeOf);
+    par_Batch->AckCount--;
+    return Header;
+}
+
 int rm_init_blackboard (int blackboard_size, char CopyBB2ProcOnlyIfWrFlagSet, char AllowBBVarsWithSameAddr, char conv_error2message)
 {
     RM_BLACKBOARD_INIT_BLACKBOARD_REQ Req;
@@ -54,6 +146,7 @@ int rm_init_blackboard (int blackboard_size, char CopyBB2ProcOnlyIfWrFlagSet, ch
     Req.conv_error2message = conv_error2message;
     TransactRemoteMaster (RM_BLACKBOARD_INIT_BLACKBOARD_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
+    rm_InitBlackboardSync (blackboard_size);
     return Ack.Ret;
 }
 
@@ -61,6 +154,7 @@ int rm_close_blackboard (void)
 {
     RM_BLACKBOARD_CLOSE_BLACKBOARD_REQ Req;
     RM_BLACKBOARD_CLOSE_BLACKBOARD_ACK Ack;
+    rm_TerminateBlackboardSync ();
     TransactRemoteMaster (RM_BLACKBOARD_CLOSE_BLACKBOARD_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
     return Ack.Ret;
@@ -116,6 +210,152 @@ VID rm_add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const cha
     return Ack.Ret;
 }
 
+int rm_add_bbvari_pid_type_frame (int Number, const char **Names, enum BB_DATA_TYPES *Types, const char **Units, int *Dirs, int Pid,
+                                  int ValueValidFlag, union BB_VARI *Values, uint32_t ReadReqMask, VID *ret_Vids, int *ret_Types)
+{
+    RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_REQ *Req;
+    RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_ACK *Ack;
+    int MaxEntriesPerFrame = RM_ADD_BBVARI_FRAME_MAX_REQ_SIZE / RM_BATCH_ALIGN((int)sizeof (RM_BLACKBOARD_ADD_BBVARI_FRAME_ENTRY) + 1);
+    int AckSize = (int)sizeof (RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_ACK) + MaxEntriesPerFrame * 2 * (int)sizeof (int32_t);
+    int AckBytesWaiting = 0;
+    int FrameSizes[MAX_PIPELINED_REQUESTS];
+    int FrameHead = 0, FrameCount = 0;
+    int Transmitted = 0, Received = 0;
+    int Ret = 0;
+    int x;
+
+    if (Pid <= 0) {
+        Pid = GET_PID();
+    }
+    Req = (RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_REQ*)my_malloc (RM_ADD_BBVARI_FRAME_MAX_REQ_SIZE);
+    Ack = (RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_ACK*)my_malloc ((size_t)AckSize);
+    if ((Req == NULL) || (Ack == NULL)) {
+        if (Req != NULL) my_free (Req);
+        if (Ack != NULL) my_free (Ack);
+        return -1;
+    }
+    // The frames are transmitted pipelined, so the round trip time is needed only once
+    while ((Received < Number) && (Ret == 0)) {
+        int NextAckSize = AckSize;
+        if ((Transmitted < Number) && (FrameCount < MAX_PIPELINED_REQUESTS) &&
+            ((AckBytesWaiting + NextAckSize) <= PIPELINED_MAX_ACK_BYTES)) {
+            // build the next frame
+            int Pos = RM_BATCH_ALIGN((int)sizeof (RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_REQ));
+            int Count = 0;
+            Req->Pid = Pid;
+            Req->OffsetEntries = (uint32_t)Pos;
+            while (Transmitted < Number) {
+                RM_BLACKBOARD_ADD_BBVARI_FRAME_ENTRY *Entry;
+                const char *Unit = (Units != NULL) ? Units[Transmitted] : NULL;
+                int LenName = (int)strlen (Names[Transmitted]) + 1;
+                int LenUnit = (Unit != NULL) ? (int)strlen (Unit) + 1 : 0;
+                int Size = (int)sizeof (RM_BLACKBOARD_ADD_BBVARI_FRAME_ENTRY) + LenName + LenUnit;
+                if ((Pos + RM_BATCH_ALIGN(Size)) > RM_ADD_BBVARI_FRAME_MAX_REQ_SIZE) {
+                    if (Count == 0) {
+                        ThrowError (1, "name of variable \"%s\" too long", Names[Transmitted]);
+                        Ret = -1;
+                    }
+                    break;
+                }
+                Entry = (RM_BLACKBOARD_ADD_BBVARI_FRAME_ENTRY*)((char*)Req + Pos);
+                Entry->SizeOf = (uint32_t)Size;
+                Entry->Type = (uint32_t)Types[Transmitted];
+                Entry->Dir = (Dirs != NULL) ? (uint32_t)Dirs[Transmitted] : 0;
+                Entry->ValueValidFlag = ValueValidFlag;
+                Entry->ValueUnion = (Values != NULL) ? Values[Transmitted].uqw : 0;
+                Entry->ReadReqMask = ReadReqMask;
+                MEMCPY (Entry + 1, Names[Transmitted], (size_t)LenName);
+                if (LenUnit) {
+                    Entry->UnitOffset = (uint32_t)sizeof (RM_BLACKBOARD_ADD_BBVARI_FRAME_ENTRY) + (uint32_t)LenName;
+                    MEMCPY ((char*)Entry + Entry->UnitOffset, Unit, (size_t)LenUnit);
+                } else {
+                    Entry->UnitOffset = 0;
+                }
+                Pos += RM_BATCH_ALIGN(Size);
+                Count++;
+                Transmitted++;
+            }
+            if (Ret) break;
+            Req->Count = Count;
+            if (TransmitPipelinedToRemoteMaster (RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_CMD, Req, Pos) != 0) {
+                Ret = -1;
+                break;
+            }
+            FrameSizes[(FrameHead + FrameCount) % MAX_PIPELINED_REQUESTS] = Count;
+            FrameCount++;
+            AckBytesWaiting += NextAckSize;
+        } else {
+            // fetch the oldest ack
+            int FrameSize = FrameSizes[FrameHead];
+            FrameHead = (FrameHead + 1) % MAX_PIPELINED_REQUESTS;
+            FrameCount--;
+            AckBytesWaiting -= AckSize;
+            if (ReceivePipelinedFromRemoteMaster (Ack, AckSize) <= 0) {
+                Ret = -1;
+                break;
+            }
+            CHECK_ANSWER(Req, Ack);
+            for (x = 0; x < FrameSize; x++) {
+                if (x < Ack->Ret) {
+                    ret_Vids[Received + x] = ((int32_t*)((char*)Ack + Ack->OffsetVids))[x];
+                    if (ret_Types != NULL) ret_Types[Received + x] = ((int32_t*)((char*)Ack + Ack->OffsetTypes))[x];
+                } else {
+                    ret_Vids[Received + x] = -1;
+                }
+            }
+            Received += FrameSize;
+        }
+    }
+    // Fetch the acks of the remaining frames if there was an error
+    while (FrameCount > 0) {
+        FrameCount--;
+        ReceivePipelinedFromRemoteMaster (Ack, AckSize);
+    }
+    for (x = Received; x < Number; x++) {
+        ret_Vids[x] = -1;
+    }
+    my_free (Req);
+    my_free (Ack);
+    return Ret;
+}
+
+int rm_attach_bbvari_frame (int Number, VID *Vids, int unknown_wait_flag, int pid, int *ret_Rets)
+{
+    RM_BLACKBOARD_ATTACH_BBVARI_REQ Req;
+    RM_BLACKBOARD_ATTACH_BBVARI_ACK Ack;
+    int Transmitted = 0, Received = 0;
+    int Ret = 0;
+
+    // The requests are transmitted pipelined, so the round trip time is needed only once
+    while (Received < Number) {
+        if ((Transmitted < Number) && (Ret == 0) &&
+            ((Transmitted - Received) < MAX_PIPELINED_REQUESTS) &&
+            ((Transmitted - Received + 1) * (int)sizeof (Ack) <= PIPELINED_MAX_ACK_BYTES)) {
+            Req.Pid = pid;
+            Req.Vid = Vids[Transmitted];
+            Req.unknown_wait_flag = unknown_wait_flag;
+            if (TransmitPipelinedToRemoteMaster (RM_BLACKBOARD_ATTACH_BBVARI_CMD, &Req, sizeof(Req)) != 0) {
+                Ret = -1;
+            } else {
+                Transmitted++;
+            }
+        } else if (Received < Transmitted) {
+            if (ReceivePipelinedFromRemoteMaster (&Ack, sizeof(Ack)) <= 0) {
+                Ack.Ret = -1;
+                Ret = -1;
+            }
+            CHECK_ANSWER(Req, Ack);
+            if (ret_Rets != NULL) ret_Rets[Received] = Ack.Ret;
+            Received++;
+        } else {
+            // transmit error
+            if (ret_Rets != NULL) ret_Rets[Received] = -1;
+            Received++;
+        }
+    }
+    return Ret;
+}
+
 int rm_attach_bbvari (VID vid, int unknown_wait_flag, int pid)
 {
     RM_BLACKBOARD_ATTACH_BBVARI_REQ Req;
@@ -157,6 +397,7 @@ int rm_remove_bbvari (VID vid, int unknown_wait_flag, int pid)
     Req.unknown_wait_flag = unknown_wait_flag;
     TransactRemoteMaster (RM_BLACKBOARD_REMOVE_BBVARI_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
+    rm_InvalidateBbvariMirror (vid);
     return Ack.Ret;
 }
 
@@ -168,6 +409,7 @@ int rm_remove_all_bbvari (PID pid)
     Req.Pid = pid;
     TransactRemoteMaster (RM_BLACKBOARD_REMOVE_ALL_BBVARI_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
+    rm_InvalidateBbvariMirror (-1);
     return Ack.Ret;
 }
 
@@ -319,27 +561,26 @@ int rm_get_bbvari_unit (VID vid, char *unit, int maxc)
     return Ack.Ack.Ret;
 }
 
-int rm_set_bbvari_conversion (VID vid, int convtype, const char *conversion)
+// Return the size of the request or -1, the exec stack of a formula will be stored inside *ret_ExecStack
+static int PrepareSetConversionReq (int convtype, const char *conversion, struct EXEC_STACK_ELEM **ret_ExecStack, int *ret_SizeOfExecStack)
 {
-    RM_BLACKBOARD_SET_BBVARI_CONVERSION_REQ *Req;
-    RM_BLACKBOARD_SET_BBVARI_CONVERSION_ACK Ack;
-    int LenConversion;
-    int SizeOfStruct;
-    struct EXEC_STACK_ELEM *ExecStack = NULL;
-    int SizeOfExecStack;
-
+    *ret_ExecStack = NULL;
     if (convtype == BB_CONV_FORMULA) {
-        if ((ExecStack = solve_equation_replace_parameter (conversion)) == NULL) {
+        if ((*ret_ExecStack = solve_equation_replace_parameter (conversion)) == NULL) {
             return -1;
         }
-        SizeOfExecStack = sizeof_exec_stack (ExecStack);
+        *ret_SizeOfExecStack = sizeof_exec_stack (*ret_ExecStack);
     } else {
-        SizeOfExecStack = 0;
+        *ret_SizeOfExecStack = 0;
     }
+    return (int)sizeof (RM_BLACKBOARD_SET_BBVARI_CONVERSION_REQ) + (int)strlen (conversion) + 1 + *ret_SizeOfExecStack;
+}
+
+static void FillSetConversionReq (RM_BLACKBOARD_SET_BBVARI_CONVERSION_REQ *Req, VID vid, int convtype, const char *conversion,
+                                  struct EXEC_STACK_ELEM *ExecStack, int SizeOfExecStack)
+{
+    int LenConversion = (int)strlen (conversion) + 1;
 
-    LenConversion = (int)strlen (conversion) + 1;
-    SizeOfStruct = (int)sizeof (RM_BLACKBOARD_SET_BBVARI_CONVERSION_REQ) + LenConversion + SizeOfExecStack;
-    Req = (RM_BLACKBOARD_SET_BBVARI_CONVERSION_REQ*)_alloca ((size_t)SizeOfStruct);
     Req->Vid = vid;
     Req->ConversionType = convtype;
     MEMCPY (Req + 1, conversion, (size_t)LenConversion);
@@ -359,11 +600,84 @@ int rm_set_bbvari_conversion (VID vid, int convtype, const char *conversion)
         Req->sizeof_bin_conversion = 0;
         Req->BinConversionOffset = 0;
     }
+}
+
+int rm_set_bbvari_conversion (VID vid, int convtype, const char *conversion)
+{
+    RM_BLACKBOARD_SET_BBVARI_CONVERSION_REQ *Req;
+    RM_BLACKBOARD_SET_BBVARI_CONVERSION_ACK Ack;
+    int SizeOfStruct;
+    struct EXEC_STACK_ELEM *ExecStack;
+    int SizeOfExecStack;
+
+    if ((SizeOfStruct = PrepareSetConversionReq (convtype, conversion, &ExecStack, &SizeOfExecStack)) < 0) {
+        return -1;
+    }
+    Req = (RM_BLACKBOARD_SET_BBVARI_CONVERSION_REQ*)_alloca ((size_t)SizeOfStruct);
+    FillSetConversionReq (Req, vid, convtype, conversion, ExecStack, SizeOfExecStack);
     TransactRemoteMaster (RM_BLACKBOARD_SET_BBVARI_CONVERSION_CMD, Req, SizeOfStruct, &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
     return Ack.Ret;
 }
 
+int rm_set_bbvari_conversion_frame (int Number, VID *Vids, int *ConvTypes, const char **Conversions, int *ret_Rets)
+{
+    RM_BATCH Batch;
+    int x, Done = 0;
+    int Ret = 0;
+
+    MEMSET (&Batch, 0, sizeof (Batch));
+    for (x = 0; x <= Number; x++) {
+        RM_BLACKBOARD_SET_BBVARI_CONVERSION_REQ *Req = NULL;
+        struct EXEC_STACK_ELEM *ExecStack = NULL;
+        int SizeOfExecStack = 0;
+        int SizeOfStruct = 0;
+
+        if (x < Number) {
+            if ((SizeOfStruct = PrepareSetConversionReq (ConvTypes[x], Conversions[x], &ExecStack, &SizeOfExecStack)) >= 0) {
+                Req = BatchAddRequest (&Batch, RM_BLACKBOARD_SET_BBVARI_CONVERSION_CMD, SizeOfStruct, sizeof (RM_BLACKBOARD_SET_BBVARI_CONVERSION_ACK));
+            }
+        }
+        if ((x == Number) || (Req == NULL)) {
+            // The batch is full or the conversion is invalid: transmit all collected requests first to keep the order of the rets
+            RM_BLACKBOARD_SET_BBVARI_CONVERSION_ACK *Ack;
+            int Sent = (Batch.Req != NULL) ? Batch.Req->Count : 0;
+            int Count = BatchTransact (&Batch);
+            while ((Ack = BatchNextAck (&Batch)) != NULL) {
+                if (ret_Rets != NULL) ret_Rets[Done] = Ack->Ret;
+                if (Ack->Ret) Ret = -1;
+                Done++;
+            }
+            if (Count < Sent) {
+                Ret = -1;
+                break;
+            }
+            if (x == Number) break;
+            if (SizeOfStruct < 0) {
+                if (ret_Rets != NULL) ret_Rets[Done] = -1;
+                Ret = -1;
+                Done++;
+                continue;
+            }
+            Req = BatchAddRequest (&Batch, RM_BLACKBOARD_SET_BBVARI_CONVERSION_CMD, SizeOfStruct, sizeof (RM_BLACKBOARD_SET_BBVARI_CONVERSION_ACK));
+            if (Req == NULL) {
+                Ret = -1;
+                break;
+            }
+        }
+        FillSetConversionReq (Req, Vids[x], ConvTypes[x], Conversions[x], ExecStack, SizeOfExecStack);
+    }
+    BatchFree (&Batch);
+    if (Done < Number) {
+        // not all requests are executed
+        if (ret_Rets != NULL) {
+            for (x = Done; x < Number; x++) ret_Rets[x] = -1;
+        }
+        Ret = -1;
+    }
+    return Ret;
+}
+
 int rm_get_bbvari_conversion (VID vid, char *conversion, int maxc)
 {
     RM_BLACKBOARD_GET_BBVARI_CONVERSION_REQ Req;
@@ -393,12 +707,52 @@ int rm_get_bbvari_conversiontype (VID vid)
     return Ack.Ret;
 }
 
+static void CopyBbvariInfosFromAck (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK *Ack, BB_VARIABLE *ret_BaseInfos, BB_VARIABLE_ADDITIONAL_INFOS *ret_AdditionalInfos, char *ret_Buffer)
+{
+    char *Conversion;
+
+    *ret_BaseInfos = Ack->BaseInfos;
+    *ret_AdditionalInfos = Ack->AdditionalInfos;
+    MEMCPY (ret_Buffer, Ack + 1, Ack->PackageHeader.SizeOf - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
+    ret_BaseInfos->pAdditionalInfos = ret_AdditionalInfos;
+    ret_AdditionalInfos->Name = ret_Buffer + (Ack->OffsetName - sizeof(RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
+    if (Ack->OffsetUnit) {
+        ret_AdditionalInfos->Unit = ret_Buffer + (Ack->OffsetUnit - sizeof(RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
+    } else {
+        ret_AdditionalInfos->Unit = NULL;
+    }
+    switch (ret_AdditionalInfos->Conversion.Type) {
+    //default:
+    case BB_CONV_NONE:
+    case BB_CONV_FACTOFF:
+        break;
+    case BB_CONV_FORMULA:
+        ret_AdditionalInfos->Conversion.Conv.Formula.FormulaString = Conversion = ret_Buffer + (Ack->OffsetConversion - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
+        break;
+    case BB_CONV_TEXTREP:
+        ret_AdditionalInfos->Conversion.Conv.TextReplace.EnumString = Conversion = ret_Buffer + (Ack->OffsetConversion - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
+        break;
+    case BB_CONV_REF:
+        ret_AdditionalInfos->Conversion.Conv.Reference.Name = Conversion = ret_Buffer + (Ack->OffsetConversion - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
+        break;
+    }
+    if (Ack->OffsetDisplayName) {
+        ret_AdditionalInfos->DisplayName = ret_Buffer + (Ack->OffsetDisplayName - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
+    } else {
+        ret_AdditionalInfos->DisplayName = NULL;
+    }
+    if (Ack->OffsetComment) {
+        ret_AdditionalInfos->Comment = ret_Buffer + (Ack->OffsetComment - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
+    } else {
+        ret_AdditionalInfos->Comment = NULL;
+    }
+}
+
 int rm_get_bbvari_infos (VID par_Vid, BB_VARIABLE *ret_BaseInfos, BB_VARIABLE_ADDITIONAL_INFOS *ret_AdditionalInfos, char *ret_Buffer, int par_SizeOfBuffer)
 {
     RM_BLACKBOARD_GET_BBVARI_INFOS_REQ Req;
     RM_BLACKBOARD_GET_BBVARI_INFOS_ACK *Ack;
     int SizeOfStruct;
-    char *Conversion;
 
     // olny for debugging
     //SizeOfStruct = sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK);
@@ -410,44 +764,57 @@ int rm_get_bbvari_infos (VID par_Vid, BB_VARIABLE *ret_BaseInfos, BB_VARIABLE_AD
     TransactRemoteMaster (RM_BLACKBOARD_GET_BBVARI_INFOS_CMD, &Req, sizeof(Req), Ack, SizeOfStruct);
     CHECK_ANSWER(Req, Ack_1);
     if (Ack->Ret == 0) {
-        *ret_BaseInfos = Ack->BaseInfos;
-        *ret_AdditionalInfos = Ack->AdditionalInfos;
-        MEMCPY (ret_Buffer, Ack + 1, Ack->PackageHeader.SizeOf - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
-        ret_BaseInfos->pAdditionalInfos = ret_AdditionalInfos;
-        ret_AdditionalInfos->Name = ret_Buffer + (Ack->OffsetName - sizeof(RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
-        if (Ack->OffsetUnit) {
-            ret_AdditionalInfos->Unit = ret_Buffer + (Ack->OffsetUnit - sizeof(RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
-        } else {
-            ret_AdditionalInfos->Unit = NULL;
-        }
-        switch (ret_AdditionalInfos->Conversion.Type) {
-        //default:
-        case BB_CONV_NONE:
-        case BB_CONV_FACTOFF:
-            break;
-        case BB_CONV_FORMULA:
-            ret_AdditionalInfos->Conversion.Conv.Formula.FormulaString = Conversion = ret_Buffer + (Ack->OffsetConversion - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
-            break;
-        case BB_CONV_TEXTREP:
-            ret_AdditionalInfos->Conversion.Conv.TextReplace.EnumString = Conversion = ret_Buffer + (Ack->OffsetConversion - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
-            break;
-        case BB_CONV_REF:
-            ret_AdditionalInfos->Conversion.Conv.Reference.Name = Conversion = ret_Buffer + (Ack->OffsetConversion - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
-            break;
+        CopyBbvariInfosFromAck (Ack, ret_BaseInfos, ret_AdditionalInfos, ret_Buffer);
+    }
+    return Ack->Ret;
+
+}
+
+int rm_get_bbvari_infos_frame (int Number, VID *Vids, BB_VARIABLE *ret_BaseInfos, BB_VARIABLE_ADDITIONAL_INFOS *ret_AdditionalInfos,
+                               char *ret_Buffers, int par_SizeOfEachBuffer, int *ret_Rets)
+{
+    RM_BATCH Batch;
+    int x, Done = 0;
+    int Ret = 0;
+    int MaxAckLen = (int)sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK) + par_SizeOfEachBuffer;
+
+    MEMSET (&Batch, 0, sizeof (Batch));
+    for (x = 0; x <= Number; x++) {
+        RM_BLACKBOARD_GET_BBVARI_INFOS_REQ *Req = NULL;
+        if (x < Number) {
+            Req = BatchAddRequest (&Batch, RM_BLACKBOARD_GET_BBVARI_INFOS_CMD, sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_REQ), MaxAckLen);
         }
-        if (Ack->OffsetDisplayName) {
-            ret_AdditionalInfos->DisplayName = ret_Buffer + (Ack->OffsetDisplayName - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
-        } else {
-            ret_AdditionalInfos->DisplayName = NULL;
+        if (Req == NULL) {
+            // The batch is full or all requests are collected
+            RM_BLACKBOARD_GET_BBVARI_INFOS_ACK *Ack;
+            int Sent = (Batch.Req != NULL) ? Batch.Req->Count : 0;
+            int Count = BatchTransact (&Batch);
+            while ((Ack = BatchNextAck (&Batch)) != NULL) {
+                if (Ack->Ret == 0) {
+                    CopyBbvariInfosFromAck (Ack, &(ret_BaseInfos[Done]), &(ret_AdditionalInfos[Done]),
+                                            ret_Buffers + (size_t)Done * (size_t)par_SizeOfEachBuffer);
+                } else {
+                    Ret = -1;
+                }
+                if (ret_Rets != NULL) ret_Rets[Done] = Ack->Ret;
+                Done++;
+            }
+            if ((Count < Sent) || (x == Number)) break;
+            Req = BatchAddRequest (&Batch, RM_BLACKBOARD_GET_BBVARI_INFOS_CMD, sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_REQ), MaxAckLen);
+            if (Req == NULL) break;
         }
-        if (Ack->OffsetComment) {
-            ret_AdditionalInfos->Comment = ret_Buffer + (Ack->OffsetComment - sizeof (RM_BLACKBOARD_GET_BBVARI_INFOS_ACK));
-        } else {
-            ret_AdditionalInfos->Comment = NULL;
+        Req->Vid = Vids[x];
+        Req->SizeOfBuffer = par_SizeOfEachBuffer;
+    }
+    BatchFree (&Batch);
+    if (Done < Number) {
+        // not all requests are executed
+        if (ret_Rets != NULL) {
+            for (x = Done; x < Number; x++) ret_Rets[x] = -1;
         }
+        Ret = -1;
     }
-    return Ack->Ret;
-
+    return Ret;
 }
 
 int rm_set_bbvari_color (VID vid, int rgb_color)
@@ -580,38 +947,46 @@ int rm_get_bbvari_format_prec (VID vid)
     return Ack.prec;
 }
 
-int rm_get_free_wrflag (PID pid, uint64_t *wrflag)
+uint32_t rm_get_bbvari_wrseq (VID vid)
 {
-    RM_BLACKBOARD_GET_FREE_WRFLAG_REQ Req;
-    RM_BLACKBOARD_GET_FREE_WRFLAG_ACK Ack;
+    RM_BLACKBOARD_GET_BBVARI_WRSEQ_REQ Req;
+    RM_BLACKBOARD_GET_BBVARI_WRSEQ_ACK Ack;
 
-    Req.Pid = pid;
-    TransactRemoteMaster (RM_BLACKBOARD_GET_FREE_WRFLAG_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
+    Req.Vid = vid;
+    TransactRemoteMaster (RM_BLACKBOARD_GET_BBVARI_WRSEQ_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
-    *wrflag = Ack.wrflag;
-    return Ack.Ret;
+    return Ack.WrSeq;
 }
 
-void rm_reset_wrflag (VID vid, uint64_t w)
+void rm_get_bbvari_wrseq_frame (int par_Number, const VID *par_Vids, uint32_t *ret_WrSeqs)
 {
-    RM_BLACKBOARD_RESET_WRFLAG_REQ Req;
-    RM_BLACKBOARD_RESET_WRFLAG_ACK Ack;
+    RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_REQ *Req;
+    RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_ACK *Ack;
+    size_t ReqStructSize;
+    size_t AckStructSize;
 
-    Req.Vid = vid;
-    Req.w = w;
-    TransactRemoteMaster (RM_BLACKBOARD_RESET_WRFLAG_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
+    ReqStructSize = sizeof(RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_REQ) + (size_t)par_Number * sizeof (VID);
+    AckStructSize = sizeof(RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_ACK) + (size_t)par_Number * sizeof (uint32_t);
+    Req = (RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_REQ*)_alloca (ReqStructSize);
+    Ack = (RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_ACK*)_alloca (AckStructSize);
+    Req->Number = par_Number;
+    Req->OffsetVids = sizeof (RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_REQ);
+    MEMCPY ((char*)Req + Req->OffsetVids, par_Vids, (size_t)par_Number * sizeof(VID));
+    TransactRemoteMaster (RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_CMD, Req, (int)ReqStructSize, Ack, (int)AckStructSize);
     CHECK_ANSWER(Req, Ack);
+    MEMCPY (ret_WrSeqs, (char*)Ack + Ack->OffsetWrSeqs, (size_t)par_Number * sizeof(uint32_t));
 }
 
-int rm_test_wrflag (VID vid, uint64_t w)
+int rm_test_bbvari_wrseq (VID vid, uint32_t *io_WrSeq)
 {
-    RM_BLACKBOARD_TEST_WRFLAG_REQ Req;
-    RM_BLACKBOARD_TEST_WRFLAG_ACK Ack;
+    RM_BLACKBOARD_TEST_BBVARI_WRSEQ_REQ Req;
+    RM_BLACKBOARD_TEST_BBVARI_WRSEQ_ACK Ack;
 
     Req.Vid = vid;
-    Req.w = w;
-    TransactRemoteMaster (RM_BLACKBOARD_TEST_WRFLAG_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
+    Req.WrSeq = *io_WrSeq;
+    TransactRemoteMaster (RM_BLACKBOARD_TEST_BBVARI_WRSEQ_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
+    *io_WrSeq = Ack.WrSeq;
     return Ack.Ret;
 }
 
@@ -863,7 +1238,7 @@ int rm_InitVariableSectionCache (void)
                 Req->UnitOffset = (uint32_t)sizeof(RM_BLACKBOARD_ADD_VARIABLE_SECTION_CACHE_ENTRY_REQ) + (uint32_t)LenVariableName;
                 LenUnit = (int)strlen(BbVariElem.pAdditionalInfos->Unit) + 1;
                 MEMCPY((char*)Req + Req->UnitOffset, BbVariElem.pAdditionalInfos->Unit, (size_t)LenUnit);
-                my_free(BbVariElem.pAdditionalInfos->Unit);
+                ReleaseSharedString(BbVariElem.pAdditionalInfos->Unit);
             }
             if (BbVariElem.pAdditionalInfos->Conversion.Conv.Formula.FormulaString == NULL) {
                 Req->ConversionOffset = 0;
@@ -872,7 +1247,12 @@ int rm_InitVariableSectionCache (void)
                 Req->ConversionOffset = (uint32_t)sizeof(RM_BLACKBOARD_ADD_VARIABLE_SECTION_CACHE_ENTRY_REQ) + (uint32_t)LenVariableName + (uint32_t)LenUnit;
                 LenConversion = (int)strlen(BbVariElem.pAdditionalInfos->Conversion.Conv.Formula.FormulaString) + 1;
                 MEMCPY((char*)Req + Req->ConversionOffset, BbVariElem.pAdditionalInfos->Conversion.Conv.Formula.FormulaString, (size_t)LenConversion);
-                my_free(BbVariElem.pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
+                if ((BbVariElem.pAdditionalInfos->Conversion.Type == BB_CONV_FORMULA) ||
+                    (BbVariElem.pAdditionalInfos->Conversion.Type == BB_CONV_TEXTREP)) {
+                    ReleaseSharedString(BbVariElem.pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
+                } else {
+                    my_free(BbVariElem.pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
+                }
             }
             Req->Min = BbVariElem.pAdditionalInfos->Min;
             Req->Max = BbVariElem.pAdditionalInfos->Max;
@@ -980,6 +1360,10 @@ int rm_WriteBackVariableSectionCache (void)
 void rm_write_bbvari_byte (PID pid, VID vid, int8_t v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_BYTE_REQ Req;
+    union BB_VARI Value;
+
+    Value.b = v;
+    if (rm_WriteBbvariToMirror (pid, vid, BB_BYTE, Value)) return;
 
     Req.Pid = pid;
     Req.Vid = vid;
@@ -991,6 +1375,10 @@ void rm_write_bbvari_byte (PID pid, VID vid, int8_t v)
 void rm_write_bbvari_ubyte (PID pid, VID vid, uint8_t v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_UBYTE_REQ Req;
+    union BB_VARI Value;
+
+    Value.ub = v;
+    if (rm_WriteBbvariToMirror (pid, vid, BB_UBYTE, Value)) return;
 
     Req.Pid = pid;
     Req.Vid = vid;
@@ -1003,6 +1391,10 @@ void rm_write_bbvari_ubyte (PID pid, VID vid, uint8_t v)
 void rm_write_bbvari_word (PID pid, VID vid, int16_t v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_WORD_REQ Req;
+    union BB_VARI Value;
+
+    Value.w = v;
+    if (rm_WriteBbvariToMirror (pid, vid, BB_WORD, Value)) return;
 
     Req.Pid = pid;
     Req.Vid = vid;
@@ -1014,6 +1406,10 @@ void rm_write_bbvari_word (PID pid, VID vid, int16_t v)
 void rm_write_bbvari_uword (PID pid, VID vid, uint16_t v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_UWORD_REQ Req;
+    union BB_VARI Value;
+
+    Value.uw = v;
+    if (rm_WriteBbvariToMirror (pid, vid, BB_UWORD, Value)) return;
 
     Req.Pid = pid;
     Req.Vid = vid;
@@ -1025,6 +1421,10 @@ void rm_write_bbvari_uword (PID pid, VID vid, uint16_t v)
 void rm_write_bbvari_dword (PID pid, VID vid, int32_t v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_DWORD_REQ Req;
+    union BB_VARI Value;
+
+    Value.dw = v;
+    if (rm_WriteBbvariToMirror (pid, vid, BB_DWORD, Value)) return;
 
     Req.Pid = pid;
     Req.Vid = vid;
@@ -1036,6 +1436,10 @@ void rm_write_bbvari_dword (PID pid, VID vid, int32_t v)
 void rm_write_bbvari_udword (PID pid, VID vid, uint32_t v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_UDWORD_REQ Req;
+    union BB_VARI Value;
+
+    Value.udw = v;
+    if (rm_WriteBbvariToMirror (pid, vid, BB_UDWORD, Value)) return;
 
     Req.Pid = pid;
     Req.Vid = vid;
@@ -1047,6 +1451,10 @@ void rm_write_bbvari_udword (PID pid, VID vid, uint32_t v)
 void rm_write_bbvari_qword (PID pid, VID vid, int64_t v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_QWORD_REQ Req;
+    union BB_VARI Value;
+
+    Value.qw = v;
+    if (rm_WriteBbvariToMirror (pid, vid, BB_QWORD, Value)) return;
 
     Req.Pid = pid;
     Req.Vid = vid;
@@ -1058,6 +1466,10 @@ void rm_write_bbvari_qword (PID pid, VID vid, int64_t v)
 void rm_write_bbvari_uqword (PID pid, VID vid, uint64_t v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_UQWORD_REQ Req;
+    union BB_VARI Value;
+
+    Value.uqw = v;
+    if (rm_WriteBbvariToMirror (pid, vid, BB_UQWORD, Value)) return;
 
     Req.Pid = pid;
     Req.Vid = vid;
@@ -1069,6 +1481,10 @@ void rm_write_bbvari_uqword (PID pid, VID vid, uint64_t v)
 void rm_write_bbvari_float (PID pid, VID vid, float v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_FLOAT_REQ Req;
+    union BB_VARI Value;
+
+    Value.f = v;
+    if (rm_WriteBbvariToMirror (pid, vid, BB_FLOAT, Value)) return;
 
     Req.Pid = pid;
     Req.Vid = vid;
@@ -1080,6 +1496,10 @@ void rm_write_bbvari_float (PID pid, VID vid, float v)
 void rm_write_bbvari_double (PID pid, VID vid, double v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_DOUBLE_REQ Req;
+    union BB_VARI Value;
+
+    Value.d = v;
+    if (rm_WriteBbvariToMirror (pid, vid, BB_DOUBLE, Value)) return;
 
     Req.Pid = pid;
     Req.Vid = vid;
@@ -1092,6 +1512,8 @@ void rm_write_bbvari_union (PID pid, VID vid, union BB_VARI v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_UNION_REQ Req;
 
+    if (rm_WriteBbvariToMirror (pid, vid, BB_UNION, v)) return;
+
     Req.Pid = pid;
     Req.Vid = vid;
     Req.Value = v;
@@ -1103,6 +1525,8 @@ void rm_write_bbvari_union_pid (PID Pid, VID vid, int DataType, union BB_VARI v)
 {
     RM_BLACKBOARD_WRITE_BBVARI_UNION_PID_REQ Req;
 
+    if (rm_WriteBbvariToMirror (Pid, vid, DataType, v)) return;
+
     Req.Pid = Pid;
     Req.Vid = vid;
     Req.DataType = DataType;
@@ -1120,6 +1544,7 @@ void rm_write_bbvari_minmax_check (PID Pid, VID vid, double v)
     Req.Value = v;
     TransmitToRemoteMaster (RM_BLACKBOARD_WRITE_BBVARI_MIN_MAX_CHECK_CMD, &Req, sizeof(Req));
     CHECK_ANSWER(Req, Ack);
+    rm_InvalidateBbvariMirror (vid);
 }
 
 int rm_write_bbvari_convert_to (PID pid, VID vid, int convert_from_type, uint64_t *ret_Ptr)
@@ -1133,6 +1558,7 @@ int rm_write_bbvari_convert_to (PID pid, VID vid, int convert_from_type, uint64_
     Req.Value = *ret_Ptr;
     TransactRemoteMaster (RM_BLACKBOARD_WRITE_BBVARI_CONVERT_TO_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
+    rm_InvalidateBbvariMirror (vid);
     return Ack.Ret;
 }
 
@@ -1146,6 +1572,7 @@ int rm_write_bbvari_phys_minmax_check (PID pid, VID vid, double new_phys_value)
     Req.Value = new_phys_value;
     TransactRemoteMaster (RM_BLACKBOARD_WRITE_BBVARI_PHYS_MINMAX_CHECK_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
+    rm_InvalidateBbvariMirror (vid);
     return Ack.Ret;
 }
 
@@ -1180,6 +1607,12 @@ int8_t rm_read_bbvari_byte(VID vid)
 {
     RM_BLACKBOARD_READ_BBVARI_BYTE_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_BYTE_ACK Ack;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, &Value)) {
+        return (Type == BB_BYTE) ? Value.b : 0;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_BYTE_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1191,6 +1624,12 @@ uint8_t rm_read_bbvari_ubyte(VID vid)
 {
     RM_BLACKBOARD_READ_BBVARI_UBYTE_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_UBYTE_ACK Ack;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, &Value)) {
+        return (Type == BB_UBYTE) ? Value.ub : 0;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_UBYTE_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1202,6 +1641,12 @@ int16_t rm_read_bbvari_word(VID vid)
 {
     RM_BLACKBOARD_READ_BBVARI_WORD_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_WORD_ACK Ack;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, &Value)) {
+        return (Type == BB_WORD) ? Value.w : 0;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_WORD_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1213,6 +1658,12 @@ uint16_t rm_read_bbvari_uword(VID vid)
 {
     RM_BLACKBOARD_READ_BBVARI_UWORD_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_UWORD_ACK Ack;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, &Value)) {
+        return (Type == BB_UWORD) ? Value.uw : 0;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_UWORD_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1224,6 +1675,12 @@ int32_t rm_read_bbvari_dword(VID vid)
 {
     RM_BLACKBOARD_READ_BBVARI_DWORD_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_DWORD_ACK Ack;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, &Value)) {
+        return (Type == BB_DWORD) ? Value.dw : 0;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_DWORD_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1235,6 +1692,12 @@ uint32_t rm_read_bbvari_udword(VID vid)
 {
     RM_BLACKBOARD_READ_BBVARI_UDWORD_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_UDWORD_ACK Ack;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, &Value)) {
+        return (Type == BB_UDWORD) ? Value.udw : 0;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_UDWORD_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1246,6 +1709,12 @@ int64_t rm_read_bbvari_qword (VID vid)
 {
     RM_BLACKBOARD_READ_BBVARI_QWORD_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_QWORD_ACK Ack;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, &Value)) {
+        return (Type == BB_QWORD) ? Value.qw : 0;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_QWORD_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1257,6 +1726,12 @@ uint64_t rm_read_bbvari_uqword (VID vid)
 {
     RM_BLACKBOARD_READ_BBVARI_UQWORD_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_UQWORD_ACK Ack;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, &Value)) {
+        return (Type == BB_UQWORD) ? Value.uqw : 0;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_UQWORD_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1269,6 +1744,12 @@ float rm_read_bbvari_float (VID vid)
 {
     RM_BLACKBOARD_READ_BBVARI_FLOAT_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_FLOAT_ACK Ack;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, &Value)) {
+        return (Type == BB_FLOAT) ? Value.f : 0;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_FLOAT_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1280,6 +1761,12 @@ double rm_read_bbvari_double (VID vid)
 {
     RM_BLACKBOARD_READ_BBVARI_DOUBLE_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_DOUBLE_ACK Ack;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, &Value)) {
+        return (Type == BB_DOUBLE) ? Value.d : 0;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_DOUBLE_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1291,6 +1778,12 @@ union BB_VARI rm_read_bbvari_union (VID vid)
 {
     RM_BLACKBOARD_READ_BBVARI_UNION_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_UNION_ACK Ack;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, &Value)) {
+        return Value;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_UNION_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1302,6 +1795,11 @@ enum BB_DATA_TYPES rm_read_bbvari_union_type (VID vid, union BB_VARI *ret_Value)
 {
     RM_BLACKBOARD_READ_BBVARI_UNION_TYPE_REQ Req;
     RM_BLACKBOARD_READ_BBVARI_UNION_TYPE_ACK Ack;
+    enum BB_DATA_TYPES Type;
+
+    if (rm_ReadBbvariFromMirror (vid, &Type, ret_Value)) {
+        return Type;
+    }
 
     Req.Vid = vid;
     TransactRemoteMaster (RM_BLACKBOARD_READ_BBVARI_UNION_TYPE_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
@@ -1316,7 +1814,16 @@ int rm_read_bbvari_union_type_frame (int Number, VID *Vids, enum BB_DATA_TYPES *
     RM_BLACKBOARD_READ_BBVARI_UNION_TYPE_FRAME_ACK *Ack;
     size_t ReqStructSize;
     size_t AckStructSize;
+    int x, Hits;
 
+    // Only if all values are inside the mirror (missing ones will be subscribed)
+    Hits = 0;
+    for (x = 0; x < Number; x++) {
+        Hits += rm_ReadBbvariFromMirror (Vids[x], &(ret_Types[x]), &(ret_Values[x]));
+    }
+    if ((Number > 0) && (Hits == Number)) {
+        return Number;
+    }
     ReqStructSize = sizeof(RM_BLACKBOARD_READ_BBVARI_UNION_TYPE_FRAME_REQ) + (size_t)Number * sizeof(int32_t);
     AckStructSize = sizeof(RM_BLACKBOARD_READ_BBVARI_UNION_TYPE_FRAME_ACK) + (size_t)Number * sizeof(int32_t) + (size_t)Number * sizeof(union BB_VARI);
     Req = (RM_BLACKBOARD_READ_BBVARI_UNION_TYPE_FRAME_REQ*)_alloca (ReqStructSize);
@@ -1445,6 +1952,7 @@ void rm_write_bbvari_convert_with_FloatAndInt64 (PID pid, VID vid, union FloatOr
     Req.type = (uint32_t)type;
     TransactRemoteMaster (RM_WRITE_BBVARI_CONVERT_WITH_FLOATANDINT64_CMD, &Req, sizeof(Req), &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
+    rm_InvalidateBbvariMirror (vid);
 }
 
 int rm_read_bbvari_by_name(const char *name, union FloatOrInt64 *ret_value, int *ret_byte_width, int read_type)
@@ -1485,6 +1993,7 @@ int rm_write_bbvari_by_name(PID pid, const char *name, union FloatOrInt64 value,
 
     TransactRemoteMaster (RM_BLACKBOARD_WRITE_BBVARI_BY_NAME_CMD, Req, (int)StructSize, &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
+    rm_InvalidateBbvariMirror (-1);
     return Ack.Ret;
 }
 
@@ -1521,6 +2030,7 @@ int rm_write_bbvari_frame (PID Pid, VID *Vids, int8_t *PhysOrRaw, double *FrameV
     RM_BLACKBOARD_WRITE_BBVARI_FRAME_REQ *Req;
     RM_BLACKBOARD_WRITE_BBVARI_FRAME_ACK Ack;
     size_t ReqStructSize;
+    int x;
 
     ReqStructSize = sizeof(RM_BLACKBOARD_WRITE_BBVARI_FRAME_REQ) + (size_t)Size * sizeof (VID) +  (size_t)Size * sizeof (int8_t) + (size_t)Size * sizeof(double);
     Req = (RM_BLACKBOARD_WRITE_BBVARI_FRAME_REQ*)_alloca (ReqStructSize);
@@ -1539,6 +2049,9 @@ int rm_write_bbvari_frame (PID Pid, VID *Vids, int8_t *PhysOrRaw, double *FrameV
     MEMCPY ((char*)Req + Req->OffsetValues, FrameValues, (size_t)Size * sizeof(double));
     TransactRemoteMaster (RM_BLACKBOARD_WRITE_BBVARI_FRAME_CMD, Req, (int)ReqStructSize, &Ack, sizeof(Ack));
     CHECK_ANSWER(Req, Ack);
+    for (x = 0; x < Size; x++) {
+        rm_InvalidateBbvariMirror (Vids[x]);
+    }
     return Ack.Ret;
 }
 
@@ -1597,6 +2110,7 @@ int rm_req_read_varinfos_from_ini (RM_BLACKBOARD_READ_BBVARI_FROM_INI_REQ *Req)
         char *tmp_var_str;
         BB_VARIABLE s_vari_elem;
         BB_VARIABLE_ADDITIONAL_INFOS AdditionalInfos;
+        RM_BATCH Batch;
 
         MEMSET (&s_vari_elem, 0, sizeof (s_vari_elem));
         MEMSET (&AdditionalInfos, 0, sizeof (AdditionalInfos));
@@ -1614,42 +2128,98 @@ int rm_req_read_varinfos_from_ini (RM_BLACKBOARD_READ_BBVARI_FROM_INI_REQ *Req)
         IniFileDataBaseReadStringBufferFree(tmp_var_str);
 
 
+        // All infos with one round trip
+        MEMSET (&Batch, 0, sizeof (Batch));
         if ((Req->ReadReqMask & READ_UNIT_BBVARI_FROM_INI) == READ_UNIT_BBVARI_FROM_INI) {
-            rm_set_bbvari_unit(Req->Vid, s_vari_elem.pAdditionalInfos->Unit);
+            const char *Unit = (s_vari_elem.pAdditionalInfos->Unit == NULL) ? "" : s_vari_elem.pAdditionalInfos->Unit;
+            int LenUnit = (int)strlen (Unit) + 1;
+            RM_BLACKBOARD_SET_BBVARI_UNIT_REQ *UnitReq = BatchAddRequest (&Batch, RM_BLACKBOARD_SET_BBVARI_UNIT_CMD,
+                                                                           (int)sizeof (RM_BLACKBOARD_SET_BBVARI_UNIT_REQ) + LenUnit,
+                                                                           sizeof (RM_BLACKBOARD_SET_BBVARI_UNIT_ACK));
+            if (UnitReq != NULL) {
+                UnitReq->Vid = Req->Vid;
+                MEMCPY (UnitReq + 1, Unit, (size_t)LenUnit);
+                UnitReq->UnitOffset = sizeof (RM_BLACKBOARD_SET_BBVARI_UNIT_REQ);
+            }
         }
         if ((Req->ReadReqMask& READ_MIN_BBVARI_FROM_INI) ==  READ_MIN_BBVARI_FROM_INI) {
-            rm_set_bbvari_min(Req->Vid, s_vari_elem.pAdditionalInfos->Min);
+            RM_BLACKBOARD_SET_BBVARI_MIN_REQ *MinReq = BatchAddRequest (&Batch, RM_BLACKBOARD_SET_BBVARI_MIN_CMD, sizeof (RM_BLACKBOARD_SET_BBVARI_MIN_REQ),
+                                                                         sizeof (RM_BLACKBOARD_SET_BBVARI_MIN_ACK));
+            if (MinReq != NULL) {
+                MinReq->Vid = Req->Vid;
+                MinReq->min = s_vari_elem.pAdditionalInfos->Min;
+            }
         }
         if ((Req->ReadReqMask& READ_MAX_BBVARI_FROM_INI) ==  READ_MAX_BBVARI_FROM_INI) {
-            rm_set_bbvari_max(Req->Vid, s_vari_elem.pAdditionalInfos->Max);
+            RM_BLACKBOARD_SET_BBVARI_MAX_REQ *MaxReq = BatchAddRequest (&Batch, RM_BLACKBOARD_SET_BBVARI_MAX_CMD, sizeof (RM_BLACKBOARD_SET_BBVARI_MAX_REQ),
+                                                                         sizeof (RM_BLACKBOARD_SET_BBVARI_MAX_ACK));
+            if (MaxReq != NULL) {
+                MaxReq->Vid = Req->Vid;
+                MaxReq->max = s_vari_elem.pAdditionalInfos->Max;
+            }
         }
         if ((Req->ReadReqMask& READ_STEP_BBVARI_FROM_INI) ==  READ_STEP_BBVARI_FROM_INI) {
-            rm_set_bbvari_step(Req->Vid, s_vari_elem.pAdditionalInfos->StepType, s_vari_elem.pAdditionalInfos->Step);
+            RM_BLACKBOARD_SET_BBVARI_STEP_REQ *StepReq = BatchAddRequest (&Batch, RM_BLACKBOARD_SET_BBVARI_STEP_CMD, sizeof (RM_BLACKBOARD_SET_BBVARI_STEP_REQ),
+                                                                           sizeof (RM_BLACKBOARD_SET_BBVARI_STEP_ACK));
+            if (StepReq != NULL) {
+                StepReq->Vid = Req->Vid;
+                StepReq->steptype = s_vari_elem.pAdditionalInfos->StepType;
+                StepReq->step = s_vari_elem.pAdditionalInfos->Step;
+            }
         }
         if ((Req->ReadReqMask& READ_WIDTH_PREC_BBVARI_FROM_INI) ==  READ_WIDTH_PREC_BBVARI_FROM_INI) {
-            rm_set_bbvari_format(Req->Vid, s_vari_elem.pAdditionalInfos->Width, s_vari_elem.pAdditionalInfos->Prec);
+            RM_BLACKBOARD_SET_BBVARI_FORMAT_REQ *FormatReq = BatchAddRequest (&Batch, RM_BLACKBOARD_SET_BBVARI_FORMAT_CMD, sizeof (RM_BLACKBOARD_SET_BBVARI_FORMAT_REQ),
+                                                                               sizeof (RM_BLACKBOARD_SET_BBVARI_FORMAT_ACK));
+            if (FormatReq != NULL) {
+                FormatReq->Vid = Req->Vid;
+                FormatReq->width = s_vari_elem.pAdditionalInfos->Width;
+                FormatReq->prec = s_vari_elem.pAdditionalInfos->Prec;
+            }
         }
         if ((Req->ReadReqMask& READ_CONVERSION_BBVARI_FROM_INI) ==  READ_CONVERSION_BBVARI_FROM_INI) {
+            int ConvType = BB_CONV_NONE;
+            const char *Conversion = NULL;
+            struct EXEC_STACK_ELEM *ExecStack;
+            int SizeOfExecStack;
+            int SizeOfStruct;
             switch (s_vari_elem.pAdditionalInfos->Conversion.Type) {
             //default:
             case BB_CONV_NONE:
             case BB_CONV_FACTOFF:
-                rm_set_bbvari_conversion(Req->Vid, BB_CONV_NONE, "");
+                Conversion = "";
                 break;
             case BB_CONV_FORMULA:
-                rm_set_bbvari_conversion(Req->Vid, BB_CONV_FORMULA, s_vari_elem.pAdditionalInfos->Conversion.Conv.Formula.FormulaString);
+                ConvType = BB_CONV_FORMULA;
+                Conversion = s_vari_elem.pAdditionalInfos->Conversion.Conv.Formula.FormulaString;
                 break;
             case BB_CONV_TEXTREP:
-                rm_set_bbvari_conversion(Req->Vid, BB_CONV_TEXTREP, s_vari_elem.pAdditionalInfos->Conversion.Conv.TextReplace.EnumString);
+                ConvType = BB_CONV_TEXTREP;
+                Conversion = s_vari_elem.pAdditionalInfos->Conversion.Conv.TextReplace.EnumString;
                 break;
             case BB_CONV_REF:
-                rm_set_bbvari_conversion(Req->Vid, BB_CONV_REF, s_vari_elem.pAdditionalInfos->Conversion.Conv.Reference.Name);
+                ConvType = BB_CONV_REF;
+                Conversion = s_vari_elem.pAdditionalInfos->Conversion.Conv.Reference.Name;
                 break;
             }
+            if ((Conversion != NULL) &&
+                ((SizeOfStruct = PrepareSetConversionReq (ConvType, Conversion, &ExecStack, &SizeOfExecStack)) > 0)) {
+                RM_BLACKBOARD_SET_BBVARI_CONVERSION_REQ *ConvReq = BatchAddRequest (&Batch, RM_BLACKBOARD_SET_BBVARI_CONVERSION_CMD, SizeOfStruct,
+                                                                                     sizeof (RM_BLACKBOARD_SET_BBVARI_CONVERSION_ACK));
+                if (ConvReq != NULL) {
+                    FillSetConversionReq (ConvReq, Req->Vid, ConvType, Conversion, ExecStack, SizeOfExecStack);
+                }
+            }
         }
         if ((Req->ReadReqMask& READ_COLOR_BBVARI_FROM_INI) ==  READ_COLOR_BBVARI_FROM_INI) {
-            rm_set_bbvari_color(Req->Vid, (int)s_vari_elem.pAdditionalInfos->RgbColor);
+            RM_BLACKBOARD_SET_BBVARI_COLOR_REQ *ColorReq = BatchAddRequest (&Batch, RM_BLACKBOARD_SET_BBVARI_COLOR_CMD, sizeof (RM_BLACKBOARD_SET_BBVARI_COLOR_REQ),
+                                                                             sizeof (RM_BLACKBOARD_SET_BBVARI_COLOR_ACK));
+            if (ColorReq != NULL) {
+                ColorReq->Vid = Req->Vid;
+                ColorReq->rgb_color = (int)s_vari_elem.pAdditionalInfos->RgbColor;
+            }
         }
+        BatchTransact (&Batch);
+        BatchFree (&Batch);
         return 1;
     } else {
         return 0;
@@ -25,8 +25,16 @@ int rm_close_blackboard (void);
 
 VID rm_add_bbvari_pid_type (const char *name, enum BB_DATA_TYPES type, const char *unit, int Pid, int Dir, int ValueValidFlag, union BB_VARI *Value, int *ret_Type, uint32_t ReadReqMask);
 
+// Register several variables with pipelined RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_CMD requests,
+// Units, Dirs, Values and ret_Types can be NULL. The vid (or an error code) of each variable is stored inside ret_Vids.
+int rm_add_bbvari_pid_type_frame (int Number, const char **Names, enum BB_DATA_TYPES *Types, const char **Units, int *Dirs, int Pid,
+                                  int ValueValidFlag, union BB_VARI *Values, uint32_t ReadReqMask, VID *ret_Vids, int *ret_Types);
+
 int rm_attach_bbvari (VID vid, int unknown_wait_flag, int pid);
 
+// Attach several variables with pipelined requests, ret_Rets can be NULL
+int rm_attach_bbvari_frame (int Number, VID *Vids, int unknown_wait_flag, int pid, int *ret_Rets);
+
 VID rm_attach_bbvari_by_name (const char *name, int pid);
 
 int rm_remove_bbvari (VID vid, int unknown_wait_flag, int pid);
@@ -55,12 +63,20 @@ int rm_get_bbvari_unit (VID vid, char *unit, int maxc);
 
 int rm_set_bbvari_conversion (VID vid, int convtype, const char *conversion);
 
+// Set the conversions of several variables with one round trip, the single results will be stored inside ret_Rets (can be NULL)
+int rm_set_bbvari_conversion_frame (int Number, VID *Vids, int *ConvTypes, const char **Conversions, int *ret_Rets);
+
 int rm_get_bbvari_conversion (VID vid, char *conversion, int maxc);
 
 int rm_get_bbvari_conversiontype (VID vid);
 
 int rm_get_bbvari_infos (VID par_Vid, BB_VARIABLE *ret_BaseInfos, BB_VARIABLE_ADDITIONAL_INFOS *ret_AdditionalInfos, char *ret_Buffer, int par_SizeOfBuffer);
 
+// Same as rm_get_bbvari_infos for several variables with one round trip,
+// ret_Buffers must have the size Number * par_SizeOfEachBuffer
+int rm_get_bbvari_infos_frame (int Number, VID *Vids, BB_VARIABLE *ret_BaseInfos, BB_VARIABLE_ADDITIONAL_INFOS *ret_AdditionalInfos,
+                               char *ret_Buffers, int par_SizeOfEachBuffer, int *ret_Rets);
+
 int rm_set_bbvari_color (VID vid, int rgb_color);
 
 int rm_get_bbvari_color(VID vid);
@@ -83,11 +99,11 @@ int rm_get_bbvari_format_width (VID vid);
 
 int rm_get_bbvari_format_prec (VID vid);
 
-int rm_get_free_wrflag (PID pid, uint64_t *wrflag);
+uint32_t rm_get_bbvari_wrseq (VID vid);
 
-void rm_reset_wrflag (VID vid, uint64_t w);
+void rm_get_bbvari_wrseq_frame (int par_Number, const VID *par_Vids, uint32_t *ret_WrSeqs);
 
-int rm_test_wrflag (VID vid, uint64_t w);
+int rm_test_bbvari_wrseq (VID vid, uint32_t *io_WrSeq);
 
 int rm_read_next_blackboard_vari (int index, char *ret_NameBuffer, int max_c);
 
@@ -0,0 +1,404 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "Platform.h"
+
+#include "ThrowError.h"
+#include "MyMemory.h"
+#include "Blackboard.h"
+#include "BlackboardDeltaCoding.h"
+#include "StructsRM_Blackboard.h"
+#include "RemoteMasterNet.h"
+
+#include "MemZeroAndCopy.h"
+#include "RemoteMasterBlackboardMirror.h"
+
+#define CHECK_ANSWER(Req,Ack)
+
+// If there was no cycle for this time the mirror will not be used
+#define SYNC_TIMEOUT_MS  100
+
+#define MAX_LEN_VALUES  (256*1024)
+
+typedef struct {
+    VID Vid;
+    int32_t PendingWrite;   // position inside PendingWrites or -1
+    union BB_VARI Value;
+    uint8_t Type;
+    uint8_t State;
+#define MIRROR_UNUSED     0
+#define MIRROR_REQUESTED  1   // subscribed but no value received till now
+#define MIRROR_VALID      2
+} MIRROR_ENTRY;
+
+typedef struct {
+    int32_t Index;
+    int32_t Type;
+    union BB_VARI Value;
+} PENDING_WRITE;
+
+static int Initialized;
+static CRITICAL_SECTION MirrorCriticalSection;
+static CRITICAL_SECTION SyncCriticalSection;   // only one sync transaction at the same time
+
+static MIRROR_ENTRY *Mirror;
+static int MirrorSize;
+static volatile uint64_t LastCycleTime;
+static int ResetSubscriptions;
+
+static VID *SubscribeVids;
+static int SubscribeCount;
+static int SubscribeSize;
+
+static PENDING_WRITE *PendingWrites;
+static volatile int PendingCount;
+static int PendingSize;
+static PID PendingPid;
+
+// Buffers of the sync transaction (protected by SyncCriticalSection)
+static RM_BLACKBOARD_SYNC_VALUES_REQ *Req;
+static int ReqSize;
+static RM_BLACKBOARD_SYNC_VALUES_ACK *Ack;
+static int32_t *DeltaIndexes;
+static uint8_t *DeltaTypes;
+static union BB_VARI *DeltaValues;
+static int DeltaSize;
+
+void rm_InitBlackboardSync (int par_BlackboardSize)
+{
+    int x;
+
+    if (!Initialized) {
+        InitializeCriticalSection (&MirrorCriticalSection);
+        InitializeCriticalSection (&SyncCriticalSection);
+        Initialized = 1;
+    }
+    EnterCriticalSection (&MirrorCriticalSection);
+    if (Mirror != NULL) my_free (Mirror);
+    Mirror = (MIRROR_ENTRY*)my_calloc ((size_t)par_BlackboardSize, sizeof (MIRROR_ENTRY));
+    if (Mirror == NULL) {
+        MirrorSize = 0;
+    } else {
+        MirrorSize = par_BlackboardSize;
+        for (x = 0; x < MirrorSize; x++) {
+            Mirror[x].PendingWrite = -1;
+        }
+    }
+    SubscribeCount = 0;
+    PendingCount = 0;
+    ResetSubscriptions = 1;
+    LeaveCriticalSection (&MirrorCriticalSection);
+}
+
+void rm_TerminateBlackboardSync (void)
+{
+    if (!Initialized) return;
+    EnterCriticalSection (&MirrorCriticalSection);
+    if (Mirror != NULL) my_free (Mirror);
+    Mirror = NULL;
+    MirrorSize = 0;
+    SubscribeCount = 0;
+    PendingCount = 0;
+    LeaveCriticalSection (&MirrorCriticalSection);
+}
+
+static int IsCycleRunning (void)
+{
+    return (GetTickCount64 () - LastCycleTime) < SYNC_TIMEOUT_MS;
+}
+
+// MirrorCriticalSection must be entered
+static void AddSubscription (MIRROR_ENTRY *par_Entry, VID par_Vid)
+{
+    if (SubscribeCount >= SubscribeSize) {
+        SubscribeSize += 1024;
+        SubscribeVids = (VID*)my_realloc (SubscribeVids, (size_t)SubscribeSize * sizeof (VID));
+        if (SubscribeVids == NULL) {
+            SubscribeSize = SubscribeCount = 0;
+            return;
+        }
+    }
+    SubscribeVids[SubscribeCount++] = par_Vid;
+    par_Entry->Vid = par_Vid;
+    par_Entry->State = MIRROR_REQUESTED;
+}
+
+// MirrorCriticalSection must be entered
+static void DropPendingWrite (MIRROR_ENTRY *par_Entry)
+{
+    if (par_Entry->PendingWrite >= 0) {
+        // will be ignored by the remote master
+        PendingWrites[par_Entry->PendingWrite].Type = BB_DELTA_REMOVED_TYPE;
+        par_Entry->PendingWrite = -1;
+    }
+}
+
+int rm_ReadBbvariFromMirror (VID par_Vid, enum BB_DATA_TYPES *ret_Type, union BB_VARI *ret_Value)
+{
+    int Index = (int)(par_Vid >> 8);
+    int Ret = 0;
+
+    if ((Mirror == NULL) || (par_Vid <= 0)) return 0;
+    EnterCriticalSection (&MirrorCriticalSection);
+    if ((Index < MirrorSize) && (Mirror != NULL)) {
+        MIRROR_ENTRY *Entry = &(Mirror[Index]);
+        if (Entry->Vid == par_Vid) {
+            if ((Entry->State == MIRROR_VALID) && IsCycleRunning ()) {
+                *ret_Type = (enum BB_DATA_TYPES)Entry->Type;
+                *ret_Value = Entry->Value;
+                Ret = 1;
+            }
+        } else {
+            // Not subscribed till now (or the index is reused by an other variable)
+            DropPendingWrite (Entry);
+            AddSubscription (Entry, par_Vid);
+        }
+    }
+    LeaveCriticalSection (&MirrorCriticalSection);
+    return Ret;
+}
+
+int rm_WriteBbvariToMirror (PID par_Pid, VID par_Vid, int par_Type, union BB_VARI par_Value)
+{
+    int Index = (int)(par_Vid >> 8);
+    int Ret = 0;
+
+    if ((Mirror == NULL) || (par_Vid <= 0) || !IsCycleRunning ()) return 0;
+    EnterCriticalSection (&MirrorCriticalSection);
+    if ((Index < MirrorSize) && (Mirror != NULL)) {
+        MIRROR_ENTRY *Entry = &(Mirror[Index]);
+        if (par_Type == BB_UNION) par_Type = Entry->Type;
+        // Only values of known variables with the right data type, all other will be checked by the remote master.
+        // The collected writes have all the same pid, a write of an other process will flush them first.
+        if ((Entry->Vid == par_Vid) && (Entry->State == MIRROR_VALID) &&
+            (par_Type == Entry->Type) && (GetDataTypeByteSize (par_Type) > 0) &&
+            ((PendingCount == 0) || (PendingPid == par_Pid))) {
+            if (Entry->PendingWrite < 0) {
+                if (PendingCount >= PendingSize) {
+                    PendingSize += 1024;
+                    PendingWrites = (PENDING_WRITE*)my_realloc (PendingWrites, (size_t)PendingSize * sizeof (PENDING_WRITE));
+                    if (PendingWrites == NULL) {
+                        PendingSize = PendingCount = 0;
+                        goto __OUT;
+                    }
+                }
+                Entry->PendingWrite = PendingCount;
+                PendingWrites[PendingCount].Index = Index;
+                PendingWrites[PendingCount].Type = par_Type;
+                PendingCount++;
+                PendingPid = par_Pid;
+            }
+            PendingWrites[Entry->PendingWrite].Value = par_Value;
+            Entry->Value = par_Value;
+            Ret = 1;
+        }
+    }
+__OUT:
+    LeaveCriticalSection (&MirrorCriticalSection);
+    return Ret;
+}
+
+void rm_InvalidateBbvariMirror (VID par_Vid)
+{
+    int x;
+
+    if (Mirror == NULL) return;
+    EnterCriticalSection (&MirrorCriticalSection);
+    for (x = 0; x < MirrorSize; x++) {
+        MIRROR_ENTRY *Entry = &(Mirror[x]);
+        if (par_Vid > 0) {
+            x = (int)(par_Vid >> 8);
+            if (x >= MirrorSize) break;
+            Entry = &(Mirror[x]);
+            if (Entry->Vid != par_Vid) break;
+        }
+        if (Entry->State == MIRROR_VALID) {
+            AddSubscription (Entry, Entry->Vid);
+        }
+        if (par_Vid > 0) break;
+    }
+    LeaveCriticalSection (&MirrorCriticalSection);
+}
+
+static int ComparePendingWrites (const void *a, const void *b)
+{
+    return ((const PENDING_WRITE*)a)->Index - ((const PENDING_WRITE*)b)->Index;
+}
+
+static int CheckBufferSizes (int par_ReqSize, int par_DeltaSize)
+{
+    if (Ack == NULL) {
+        Ack = (RM_BLACKBOARD_SYNC_VALUES_ACK*)my_malloc (sizeof (RM_BLACKBOARD_SYNC_VALUES_ACK) + MAX_LEN_VALUES);
+        if (Ack == NULL) return -1;
+    }
+    if ((par_ReqSize > ReqSize) || (Req == NULL)) {
+        ReqSize = par_ReqSize + 64 * 1024;
+        Req = (RM_BLACKBOARD_SYNC_VALUES_REQ*)my_realloc (Req, (size_t)ReqSize);
+    }
+    if ((par_DeltaSize > DeltaSize) || (DeltaIndexes == NULL)) {
+        DeltaSize = par_DeltaSize + 1024;
+        DeltaIndexes = (int32_t*)my_realloc (DeltaIndexes, (size_t)DeltaSize * sizeof (int32_t));
+        DeltaTypes = (uint8_t*)my_realloc (DeltaTypes, (size_t)DeltaSize * sizeof (uint8_t));
+        DeltaValues = (union BB_VARI*)my_realloc (DeltaValues, (size_t)DeltaSize * sizeof (union BB_VARI));
+    }
+    if ((Req == NULL) || (DeltaIndexes == NULL) || (DeltaTypes == NULL) || (DeltaValues == NULL)) {
+        ReqSize = DeltaSize = 0;
+        return -1;
+    }
+    return 0;
+}
+
+// MirrorCriticalSection must be entered
+static void ResetMirror (void)
+{
+    int x;
+    for (x = 0; x < MirrorSize; x++) {
+        Mirror[x].Vid = 0;
+        Mirror[x].State = MIRROR_UNUSED;
+        Mirror[x].PendingWrite = -1;
+    }
+    SubscribeCount = 0;
+    PendingCount = 0;
+    ResetSubscriptions = 1;
+}
+
+static int SyncBlackboardValues (void)
+{
+    int x, Len, Count, Encoded, ReqLen, Ret = -1;
+    int Corrupt = 0;
+
+    EnterCriticalSection (&SyncCriticalSection);
+    EnterCriticalSection (&MirrorCriticalSection);
+    if (Mirror == NULL) {
+        LeaveCriticalSection (&MirrorCriticalSection);
+        LeaveCriticalSection (&SyncCriticalSection);
+        return -1;
+    }
+    // A write alone inside a segment needs max. 5 + 1 bytes segment header + 1 bitmap byte + type + 8 bytes value,
+    // inside a segment max. 4 bitmap bytes + type + value. Writes which doesn't fit will be send with the next sync
+    if (CheckBufferSizes ((int)sizeof (RM_BLACKBOARD_SYNC_VALUES_REQ) + SubscribeCount * (int)sizeof (VID) + PendingCount * 16,
+                          PendingCount)) {
+        ResetMirror ();
+        LeaveCriticalSection (&MirrorCriticalSection);
+        LeaveCriticalSection (&SyncCriticalSection);
+        return -1;
+    }
+    Req->WritePid = PendingPid;
+    Req->Flags = ResetSubscriptions ? RM_SYNC_VALUES_RESET_SUBSCRIPTIONS : 0;
+    Req->OffsetSubscribeVids = sizeof (RM_BLACKBOARD_SYNC_VALUES_REQ);
+    Req->SubscribeCount = SubscribeCount;
+    if (SubscribeCount > 0) {
+        MEMCPY ((char*)Req + Req->OffsetSubscribeVids, SubscribeVids, (size_t)SubscribeCount * sizeof (VID));
+    }
+    Req->OffsetWrites = Req->OffsetSubscribeVids + (uint32_t)SubscribeCount * sizeof (VID);
+    // The delta block must be sorted by the index
+    if (PendingCount > 1) {
+        qsort (PendingWrites, (size_t)PendingCount, sizeof (PENDING_WRITE), ComparePendingWrites);
+    }
+    // Remove the dropped writes
+    Count = 0;
+    for (x = 0; x < PendingCount; x++) {
+        if (PendingWrites[x].Type != BB_DELTA_REMOVED_TYPE) {
+            PendingWrites[Count] = PendingWrites[x];
+            DeltaIndexes[Count] = PendingWrites[x].Index;
+            DeltaTypes[Count] = (uint8_t)PendingWrites[x].Type;
+            DeltaValues[Count] = PendingWrites[x].Value;
+            Count++;
+        }
+    }
+    Encoded = EncodeBlackboardDelta (DeltaIndexes, DeltaTypes, DeltaValues, Count, (char*)Req + Req->OffsetWrites,
+                                     ReqSize - (int)Req->OffsetWrites, &Len);
+    Req->LenWrites = (uint32_t)Len;
+    Req->MaxLenValues = MAX_LEN_VALUES;
+    ReqLen = (int)Req->OffsetWrites + Len;
+    for (x = 0; x < Encoded; x++) {
+        Mirror[PendingWrites[x].Index].PendingWrite = -1;
+    }
+    // The writes which doesn't fit stay pending
+    for (x = Encoded; x < Count; x++) {
+        PendingWrites[x - Encoded] = PendingWrites[x];
+        Mirror[PendingWrites[x].Index].PendingWrite = x - Encoded;
+    }
+    SubscribeCount = 0;
+    PendingCount = Count - Encoded;
+    ResetSubscriptions = 0;
+    LeaveCriticalSection (&MirrorCriticalSection);
+
+    if (TransactRemoteMaster (RM_BLACKBOARD_SYNC_VALUES_CMD, Req, ReqLen, Ack, (int)sizeof (RM_BLACKBOARD_SYNC_VALUES_ACK) + MAX_LEN_VALUES) > 0) {
+        CHECK_ANSWER(Req, Ack);
+        Ret = Ack->Ret;
+    }
+
+    EnterCriticalSection (&MirrorCriticalSection);
+    if (Mirror != NULL) {
+        if (Ret >= 0) {
+            if (CheckBufferSizes (0, Ret)) {
+                Count = -1;
+            } else {
+                Count = DecodeBlackboardDelta ((char*)Ack + Ack->OffsetValues, (int)Ack->LenValues,
+                                               DeltaIndexes, DeltaTypes, DeltaValues, DeltaSize);
+            }
+            for (x = 0; x < Count; x++) {
+                MIRROR_ENTRY *Entry;
+                if (DeltaIndexes[x] >= MirrorSize) continue;
+                Entry = &(Mirror[DeltaIndexes[x]]);
+                if (Entry->State == MIRROR_UNUSED) continue;
+                if (DeltaTypes[x] == BB_DELTA_REMOVED_TYPE) {
+                    DropPendingWrite (Entry);
+                    Entry->Vid = 0;
+                    Entry->State = MIRROR_UNUSED;
+                } else if (Entry->PendingWrite < 0) {   // otherwise there is a newer value written meanwhile
+                    Entry->Type = DeltaTypes[x];
+                    Entry->Value = DeltaValues[x];
+                    Entry->State = MIRROR_VALID;
+                }
+            }
+            if (Count < 0) Corrupt = 1;
+        }
+        if ((Ret < 0) || Corrupt) {
+            // Subscriptions may be lost, start again
+            ResetMirror ();
+            Ret = -1;
+        }
+    }
+    LeaveCriticalSection (&MirrorCriticalSection);
+    LeaveCriticalSection (&SyncCriticalSection);
+    if (Corrupt) {
+        ThrowError (1, "corrupt blackboard value block received from remote master");
+    }
+    return Ret;
+}
+
+int rm_SyncBlackboardValues (void)
+{
+    int Ret = SyncBlackboardValues ();
+    if (Ret >= 0) {
+        LastCycleTime = GetTickCount64 ();
+    }
+    return Ret;
+}
+
+void rm_FlushBlackboardWrites (void)
+{
+    int Count;
+    // more than one sync if not all writes fit into one request
+    while ((Count = PendingCount) > 0) {
+        if ((SyncBlackboardValues () < 0) || (PendingCount >= Count)) break;
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "Blackboard.h"
+
+// Mirror of the remote master blackboard values the client has read.
+// Each variable read through the remote master will be subscribed, from than on the remote master
+// transmits only the changed values once per cycle (RM_BLACKBOARD_SYNC_VALUES_CMD).
+// Values written to subscribed variables will be collected and transmitted with the same message.
+// The mirror is only used while the remote master cycles are running, otherwise all accesses
+// will be transmitted immediately as before.
+
+void rm_InitBlackboardSync (int par_BlackboardSize);
+void rm_TerminateBlackboardSync (void);
+
+// Must be called once each remote master cycle
+int rm_SyncBlackboardValues (void);
+
+// Return 1 if the value is taken from the mirror, 0 if it must be read from the remote master
+int rm_ReadBbvariFromMirror (VID par_Vid, enum BB_DATA_TYPES *ret_Type, union BB_VARI *ret_Value);
+// Return 1 if the value will be transmitted with the next cycle, 0 if it must be written immediately.
+// par_Type can be BB_UNION if the value has the type of the variable.
+int rm_WriteBbvariToMirror (PID par_Pid, VID par_Vid, int par_Type, union BB_VARI par_Value);
+// The value was changed by other requests, it will be transmitted again with the next cycle (-1 for all)
+void rm_InvalidateBbvariMirror (VID par_Vid);
+
+// Transmit the collected writes now, this is called before each other request to keep the order
+void rm_FlushBlackboardWrites (void);
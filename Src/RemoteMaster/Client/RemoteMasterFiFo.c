@@ -26,6 +26,7 @@
 #include "StringMaxChar.h"
 #include "Scheduler.h"
 #include "Fifos.h"
+#include "FifoSyncCoding.h"
 
 #include "StructsRM_FiFo.h"
 #include "RemoteMasterNet.h"
@@ -79,6 +80,61 @@ int rm_TxAttachFiFo (int RxPid, const char *Name)
     return Ack.Ret;
 }
 
+static uint32_t SyncFiFoCodings;
+
+void rm_SetSyncFiFoCodings (uint32_t par_Codings)
+{
+    SyncFiFoCodings = par_Codings;
+}
+
+static int rm_SyncFiFosCoded (void)
+{
+    static FIFO_SYNC_CODER Coder;
+    static RM_SYNC_FIFOS_CODED_REQ *Req;
+    static RM_SYNC_FIFOS_CODED_ACK *Ack;
+    static int RawSize;
+    static int SizeOfAckStruct;
+    int DataToTransmit;
+    void *Raw;
+
+    if (Req == NULL) {
+        RawSize = 1024*1024;
+        SizeOfAckStruct = 1024*1024 + sizeof(RM_SYNC_FIFOS_CODED_ACK);
+        Req = (RM_SYNC_FIFOS_CODED_REQ*)my_malloc(RawSize + sizeof(RM_SYNC_FIFOS_CODED_REQ));
+        Ack = (RM_SYNC_FIFOS_CODED_ACK*)my_malloc(SizeOfAckStruct);
+    }
+    Raw = GetFiFoSyncCoderRawBuffer (&Coder, RawSize);
+    switch(SyncTxFiFos (Raw, RawSize, &DataToTransmit)) {
+    case 0:
+    case 1:
+        break;
+    case 2:
+    case 3:
+        // the current data will be transmitted, the next call will use larger buffers
+        RawSize += 256 * 1024;
+        SizeOfAckStruct += 256 * 1024;
+        Req = (RM_SYNC_FIFOS_CODED_REQ*)my_realloc(Req, RawSize + sizeof(RM_SYNC_FIFOS_CODED_REQ));
+        Ack = (RM_SYNC_FIFOS_CODED_ACK*)my_realloc(Ack, SizeOfAckStruct);
+        break;
+    default:
+        ThrowError (1, "Internal error: %s (%i)", __FILE__, __LINE__);
+        break;
+    }
+    // The coded data are never larger than the raw data
+    Req->Len = (uint32_t)EncodeFiFoSyncBlock (&Coder, Raw, DataToTransmit, SyncFiFoCodings, Req + 1, &Req->Coding);
+    Req->RawLen = (uint32_t)DataToTransmit;
+    Req->AcceptedCodings = SyncFiFoCodings;
+    Req->Offset_Buffer = sizeof (RM_SYNC_FIFOS_CODED_REQ);
+    TransactRemoteMaster (RM_SYNC_FIFOS_CODED_CMD, Req, (int)sizeof(RM_SYNC_FIFOS_CODED_REQ) + (int)Req->Len, Ack, SizeOfAckStruct);
+    Raw = DecodeFiFoSyncBlock (&Coder, Ack + 1, Ack->Len, Ack->Coding, Ack->RawLen);
+    if (Raw == NULL) {
+        ThrowError (1, "corrupt fifo sync block received from remote master (coding = 0x%X)", Ack->Coding);
+    } else {
+        SyncRxFiFos (Raw, Ack->RawLen);
+    }
+    return Ack->Ret;
+}
+
 int rm_SyncFiFos (void)
 {
     static RM_SYNC_FIFOS_REQ *Req;
@@ -87,6 +143,9 @@ int rm_SyncFiFos (void)
     static int SizeOfAckStruct;
     int DataToTransmit;
 
+    if (SyncFiFoCodings) {
+        return rm_SyncFiFosCoded ();
+    }
     if (Req == NULL) {
         SizeOfReqStruct = 1024*1024 + sizeof(RM_SYNC_FIFOS_REQ);
         SizeOfAckStruct = 1024*1024 + sizeof(RM_SYNC_FIFOS_ACK);
@@ -26,3 +26,6 @@ int rm_TxAttachFiFo (int RxPid, const char *Name);
 
 int rm_SyncFiFos (void);
 
+// Codings (FIFO_SYNC_xxx) for rm_SyncFiFos() negotiated with rm_Init()
+void rm_SetSyncFiFoCodings (uint32_t par_Codings);
+
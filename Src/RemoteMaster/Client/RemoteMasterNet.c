@@ -42,6 +42,7 @@
 #include "PrintFormatToString.h"
 #include "MainValues.h"
 #include "RemoteMasterBlackboard.h"
+#include "RemoteMasterBlackboardMirror.h"
 #include "RemoteMasterScheduler.h"
 #include "RemoteMasterOther.h"
 #include "RemoteMasterCopyStartExecutable.h"
@@ -683,6 +684,8 @@ static inline SOCKET_THREAD_ELEMENT* GetSocketForThread(void)
             SocketThreadConnections[x].ThreadId = ThreadId;
             SocketThreadConnections[x].Number = (uint16_t)x;
             SocketThreadConnections[x].PackageCounter = 0;
+            SocketThreadConnections[x].PipelinedHead = 0;
+            SocketThreadConnections[x].PipelinedCount = 0;
             if (ConnectThreadToRemoteMaster (&SocketThreadConnections[x])) {
                 SocketThreadConnections[x].ThreadId = 0;
                 Ret = NULL;
@@ -808,6 +811,11 @@ int TransmitToRemoteMaster (int par_Command, void *par_Data, int par_len)
     int Ret;
     START_TIME_MEASUREMENT
     SOCKET_THREAD_ELEMENT *SocketForThread = GetSocketForThread();
+    // Collected blackboard writes must be transmitted before to keep the order
+    // (not possible while pipelined requests are waiting for there acks)
+    if ((SocketForThread != NULL) && (SocketForThread->PipelinedCount == 0)) {
+        rm_FlushBlackboardWrites ();
+    }
     Ret = SentToRemoteMasterLocal (SocketForThread, par_Data, par_Command, par_len);
     RemoteMasterAddCallToStatistic(par_Command, END_TIME_MEASUREMENT());
     return Ret;
@@ -859,6 +867,13 @@ int TransactRemoteMaster (int par_Command, void *par_DataToRM, int par_LenDataTo
 
     START_TIME_MEASUREMENT
     SOCKET_THREAD_ELEMENT *SocketForThread = GetSocketForThread();
+    if ((SocketForThread != NULL) && (SocketForThread->PipelinedCount > 0)) {
+        ThrowError (1, "TransactRemoteMaster(%i) called while %i pipelined requests are waiting for there ack", par_Command, SocketForThread->PipelinedCount);
+        return -1;
+    }
+    if (par_Command != RM_BLACKBOARD_SYNC_VALUES_CMD) {
+        rm_FlushBlackboardWrites ();
+    }
     if (SocketForThread != NULL) {
         if (SentToRemoteMasterLocal (SocketForThread, par_DataToRM, par_Command, par_LenDataToRM) == 0) {
             if ((Ret = ReceiveFromeRemoteMasterLocal (SocketForThread, ret_DataFromRM, par_LenDataFromRM)) <= 0) {
@@ -871,6 +886,111 @@ int TransactRemoteMaster (int par_Command, void *par_DataToRM, int par_LenDataTo
 }
 
 
+static int ReceiveExactLocal (SOCKET_THREAD_ELEMENT *par_SocketForThread, void *ret_Data, int par_len)
+{
+    int buffer_pos = 0;
+    while (buffer_pos < par_len) {
+        int ReadBytes = recv (par_SocketForThread->Socket, (char*)ret_Data + buffer_pos, par_len - buffer_pos, 0);
+        if (ReadBytes > 0) {
+            buffer_pos += ReadBytes;
+        } else if (ReadBytes == 0) {
+            ThrowError (1, "Connection closed\n");
+            return -1;
+        } else {
+#ifdef _WIN32
+            ThrowError (1, "recv failed with error: %d\n", WSAGetLastError());
+#else
+            ThrowError (1, "recv failed with error: %d\n", errno);
+#endif
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Receive exactly one message, the following acks of pipelined requests must stay inside the socket
+static int ReceiveOneMessageLocal (SOCKET_THREAD_ELEMENT *par_SocketForThread, void *ret_Data, int par_len)
+{
+    uint32_t receive_message_size;
+    int Len;
+
+    if (ReceiveExactLocal (par_SocketForThread, ret_Data, sizeof (uint32_t))) return -1;
+    receive_message_size = *(uint32_t*)ret_Data;
+    if (receive_message_size < sizeof (RM_PACKAGE_HEADER)) {
+        ThrowError (1, "received message with wrong size %u\n", receive_message_size);
+        return -1;
+    }
+    Len = ((int)receive_message_size < par_len) ? (int)receive_message_size : par_len;
+    if (ReceiveExactLocal (par_SocketForThread, (char*)ret_Data + sizeof (uint32_t), Len - (int)sizeof (uint32_t))) return -1;
+    if ((int)receive_message_size > par_len) {
+        // throw away the rest
+        char Dummy[1024];
+        int Rest = (int)receive_message_size - par_len;
+        while (Rest > 0) {
+            int Part = (Rest < (int)sizeof (Dummy)) ? Rest : (int)sizeof (Dummy);
+            if (ReceiveExactLocal (par_SocketForThread, Dummy, Part)) return -1;
+            Rest -= Part;
+        }
+        ThrowError (1, "received message larger than expected (%u > %i)\n", receive_message_size, par_len);
+    }
+    return (int)receive_message_size;
+}
+
+int TransmitPipelinedToRemoteMaster (int par_Command, void *par_DataToRM, int par_LenDataToRM)
+{
+    int Ret = -1;
+    uint16_t PackageCounter;
+
+    START_TIME_MEASUREMENT
+    SOCKET_THREAD_ELEMENT *SocketForThread = GetSocketForThread();
+    if (SocketForThread != NULL) {
+        if (SocketForThread->PipelinedCount < MAX_PIPELINED_REQUESTS) {
+            if (SocketForThread->PipelinedCount == 0) {
+                rm_FlushBlackboardWrites ();
+            }
+            PackageCounter = SocketForThread->PackageCounter;
+            if ((Ret = SentToRemoteMasterLocal (SocketForThread, par_DataToRM, par_Command, par_LenDataToRM)) == 0) {
+                SocketForThread->PipelinedPackageCounters[(SocketForThread->PipelinedHead + SocketForThread->PipelinedCount) % MAX_PIPELINED_REQUESTS] = PackageCounter;
+                SocketForThread->PipelinedCount++;
+            }
+        }
+    }
+    RemoteMasterAddCallToStatistic(par_Command, END_TIME_MEASUREMENT());
+    return Ret;
+}
+
+int ReceivePipelinedFromRemoteMaster (void *ret_DataFromRM, int par_LenDataFromRM)
+{
+    int Ret = -1;
+    uint16_t PackageCounter;
+
+    SOCKET_THREAD_ELEMENT *SocketForThread = GetSocketForThread();
+    if ((SocketForThread != NULL) && (SocketForThread->PipelinedCount > 0)) {
+        PackageCounter = SocketForThread->PipelinedPackageCounters[SocketForThread->PipelinedHead];
+        SocketForThread->PipelinedHead = (SocketForThread->PipelinedHead + 1) % MAX_PIPELINED_REQUESTS;
+        SocketForThread->PipelinedCount--;
+        if ((Ret = ReceiveOneMessageLocal (SocketForThread, ret_DataFromRM, par_LenDataFromRM)) > 0) {
+            if (((RM_PACKAGE_HEADER*)ret_DataFromRM)->PackageCounter != PackageCounter) {
+                ThrowError (1, "ack of pipelined request out of order (%u != %u)",
+                            (uint32_t)((RM_PACKAGE_HEADER*)ret_DataFromRM)->PackageCounter, (uint32_t)PackageCounter);
+                Ret = -1;
+            }
+        } else {
+            Ret = -1;
+        }
+    }
+    return Ret;
+}
+
+int GetPipelinedRequestCount (void)
+{
+    SOCKET_THREAD_ELEMENT *SocketForThread = GetSocketForThread();
+    if (SocketForThread != NULL) {
+        return SocketForThread->PipelinedCount;
+    }
+    return 0;
+}
+
 static int ReceiveFromeRemoteMasterDynBufLocal (SOCKET_THREAD_ELEMENT *par_SocketForThread, void *ret_Data, int par_len, void **ret_ptrToData, int *ret_len)
 {
     int buffer_size;
@@ -940,6 +1060,11 @@ int TransactRemoteMasterDynBuf (int par_Command, void *par_DataToRM, int par_Len
     int Ret = -1;
     SOCKET_THREAD_ELEMENT *SocketForThread = GetSocketForThread();
     START_TIME_MEASUREMENT
+    if ((SocketForThread != NULL) && (SocketForThread->PipelinedCount > 0)) {
+        ThrowError (1, "TransactRemoteMasterDynBuf(%i) called while %i pipelined requests are waiting for there ack", par_Command, SocketForThread->PipelinedCount);
+        return -1;
+    }
+    rm_FlushBlackboardWrites ();
     if (SocketForThread != NULL) {
         int Ret;
         if (SentToRemoteMasterLocal (SocketForThread, par_DataToRM, par_Command, par_LenDataToRM) == 0) {
@@ -30,12 +30,19 @@
 
 #define MAX_SOCKET_THREAD_CONNECTIONS  16
 
+// Max. number of pipelined requests waiting for there ack (per thread)
+#define MAX_PIPELINED_REQUESTS  256
+
 typedef struct {
     uint16_t Number;
     uint16_t PackageCounter;
     uint32_t ThreadId;
     MY_SOCKET Socket;
     uint32_t CreateCounter;
+    // Package counters of the pipelined requests in the order they are transmitted
+    uint16_t PipelinedPackageCounters[MAX_PIPELINED_REQUESTS];
+    int32_t PipelinedHead;
+    int32_t PipelinedCount;
 } SOCKET_THREAD_ELEMENT;
 
 int InitRemoteMaster(char *par_RemoteMasterAddr, int par_RemoteMasterPort);
@@ -45,6 +52,16 @@ int SentToRemoteMaster (void *par_Data, int par_Command, int par_len);
 int TransmitToRemoteMaster (int par_Command, void *par_Data, int par_len);
 int TransactRemoteMaster (int par_Command, void *par_DataToRM, int par_LenDataToRM, void *ret_DataFromRM, int par_LenDataFromRM);
 
+// Pipelined requests: transmit a request without waiting for its ack. The acks must be fetched
+// in the same order with ReceivePipelinedFromRemoteMaster before this thread can use TransactRemoteMaster again.
+// TransmitPipelinedToRemoteMaster returns -1 if there are already MAX_PIPELINED_REQUESTS requests waiting.
+// The acks of all waiting requests must fit into the receive buffer of the socket (PIPELINED_MAX_ACK_BYTES),
+// otherwise the remote master would block while transmitting and the client while transmitting the next request.
+#define PIPELINED_MAX_ACK_BYTES  (32*1024)
+int TransmitPipelinedToRemoteMaster (int par_Command, void *par_DataToRM, int par_LenDataToRM);
+int ReceivePipelinedFromRemoteMaster (void *ret_DataFromRM, int par_LenDataFromRM);
+int GetPipelinedRequestCount (void);
+
 //int ReceiveFromeRemoteMasterDynBuf (SOCKET_THREAD_ELEMENT *par_SocketForThread, void *ret_Data, int par_len, void **ret_ptrToData, int *ret_len);
 int TransactRemoteMasterDynBuf (int par_Command, void *par_DataToRM, int par_LenDataToRM, void *ret_DataFromRM, int par_LenDataFromRM, void **ret_ptrDataFromRM, int *ret_LenDataFromRM);
 void RemoteMasterFreeDynBuf (void *par_buffer);
@@ -23,6 +23,7 @@
 #include "RemoteMasterNet.h"
 #include "EnvironmentVariables.h"
 #include "RemoteMasterOther.h"
+#include "RemoteMasterFiFo.h"
 #include "MainValues.h"
 #include "Platform.h"
 
@@ -55,10 +56,14 @@ int rm_Init (int par_PreAllocMemorySize, int par_PidForSchedulersHelperProcess,
         }
     }
 
+    Req->SyncFiFoCodings = s_main_ini_val.RemoteMasterSyncFiFoCodings;
+    Ack.SyncFiFoCodings = 0;  // an older remote master will not answer this
+
     TransactRemoteMaster (RM_INIT_CMD, Req, SizeOfStruct, &Ack, sizeof(Ack));
     my_free(Req);
     *ret_Version = Ack.Version;
     *ret_PatchVersion = Ack.PatchVersion;
+    rm_SetSyncFiFoCodings (Ack.SyncFiFoCodings & s_main_ini_val.RemoteMasterSyncFiFoCodings);
     return Ack.Ret;
 }
 
@@ -30,6 +30,7 @@
 #include "StructsRM_Scheduler.h"
 #include "RemoteMasterNet.h"
 #include "RemoteMasterFiFo.h"
+#include "RemoteMasterBlackboardMirror.h"
 #include "RemoteMasterScheduler.h"
 
 #define CHECK_ANSWER(Req,Ack)
@@ -342,6 +343,31 @@ int rm_ResetProcessMinMaxRuntimeMeasurement (int par_Pid)
     return Ack.Ret;
 }
 
+int rm_GetLatencyHistogramsAsString (char *ret_Buffer, int par_maxc)
+{
+    RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_REQ Req;
+    RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_ACK *Ack;
+    int SizeOfStruct;
+    int Ret;
+
+    if (par_maxc <= 0) return 0;
+    SizeOfStruct = (int)sizeof(RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_ACK) + par_maxc;
+    Ack = (RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_ACK*)my_malloc((size_t)SizeOfStruct);
+    if (Ack == NULL) return -1;
+    Req.maxc = par_maxc;
+    if (TransactRemoteMaster (RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_CMD, &Req, sizeof(Req), Ack, SizeOfStruct) > 0) {
+        CHECK_ANSWER(Req, Ack);
+        Ret = Ack->Ret;
+        if ((Ret < 0) || (Ret >= par_maxc)) Ret = 0;
+        MEMCPY (ret_Buffer, Ack + 1, (size_t)Ret);
+    } else {
+        Ret = 0;
+    }
+    ret_Buffer[Ret] = 0;
+    my_free (Ack);
+    return Ret;
+}
+
 int rm_SchedulerCycleEvent (RM_SCHEDULER_CYCLIC_EVENT_REQ *Req)
 {
     if (Req->PackageHeader.Command == RM_SCHEDULER_CYCLIC_EVENT_CMD) {
@@ -351,6 +377,8 @@ int rm_SchedulerCycleEvent (RM_SCHEDULER_CYCLIC_EVENT_REQ *Req)
             Scheduler->SimulatedTimeSinceStartedInNanoSecond = Req->SimulatedTimeSinceStartedInNanoSecond;
             Scheduler->SimulatedTimeInNanoSecond = Scheduler->SimulatedTimeSinceStartedInNanoSecond;
 
+            // First the blackboard values, so the FiFo sync has not to flush the collected writes
+            rm_SyncBlackboardValues();
             rm_SyncFiFos();
         }
         return 1;
@@ -55,5 +55,7 @@ int rm_IsRealtimeProcessPid (int par_Pid);
 
 int rm_ResetProcessMinMaxRuntimeMeasurement (int par_Pid);
 
+int rm_GetLatencyHistogramsAsString (char *ret_Buffer, int par_maxc);
+
 int rm_SchedulerCycleEvent (RM_SCHEDULER_CYCLIC_EVENT_REQ *Req);
                            //RM_SCHEDULER_CYCLIC_EVENT_ACK *Ack);
@@ -47,6 +47,7 @@
 #include "RemoteMasterReqToClient.h"
 #include "RemoteMasterLock.h"
 #include "RealtimeProcessEquations.h"
+#include "LatencyHistogram.h"
 
 #include "SearchAndInitHardware.h"
 
@@ -88,6 +89,17 @@ typedef struct SCB {
     __uint64_t CycleMaxTime;
     __uint64_t CycleMinTime;
 
+    // Wakeup latency of the timer signal and overruns of the cycle period
+    LATENCY_HISTOGRAM WakeupLatency;
+    OVERRUN_EVENT_RING Overruns;
+    uint64_t ExpectedWakeupTime;
+    uint64_t NextLatencyExportCycle;
+    int WakeupLatencyP50Vid;
+    int WakeupLatencyP99Vid;
+    int WakeupLatencyP999Vid;
+    int WakeupLatencyMaxVid;
+    int OverrunCounterVid;
+
     struct SCB *next;                // Pointer to next scheduler control block
     struct SCB *prev;                // Pointer to previous scheduler control block
 
@@ -279,6 +291,33 @@ static inline __uint64_t calcdiff(struct timespec t1, struct timespec t2)
     return diff;
 }
 
+static inline __uint64_t calcdiff_ns(struct timespec t1, struct timespec t2)
+{
+    return (__uint64_t)((int64_t)(t1.tv_sec - t2.tv_sec) * 1000000000LL + (t1.tv_nsec - t2.tv_nsec));
+}
+
+static inline __uint64_t timespec_to_ns(struct timespec t)
+{
+    return (__uint64_t)t.tv_sec * 1000000000ULL + (__uint64_t)t.tv_nsec;
+}
+
+// Will be called once per second from the scheduler thread
+static void ExportLatencyHistogramsToBlackboard(SCHEDULER_CONTROL_BLOCK *Scheduler)
+{
+    TASK_CONTROL_BLOCK *Process;
+
+    write_bbvari_double_without_check(Scheduler->WakeupLatencyP50Vid, (double)LatencyHistogramPercentile(&Scheduler->WakeupLatency, 50.0) * 0.000000001);
+    write_bbvari_double_without_check(Scheduler->WakeupLatencyP99Vid, (double)LatencyHistogramPercentile(&Scheduler->WakeupLatency, 99.0) * 0.000000001);
+    write_bbvari_double_without_check(Scheduler->WakeupLatencyP999Vid, (double)LatencyHistogramPercentile(&Scheduler->WakeupLatency, 99.9) * 0.000000001);
+    write_bbvari_double_without_check(Scheduler->WakeupLatencyMaxVid, (double)Scheduler->WakeupLatency.Max * 0.000000001);
+    write_bbvari_udword_without_check(Scheduler->OverrunCounterVid, GetOverrunEventCount(&Scheduler->Overruns));
+    for (Process = Scheduler->StartSchedulingProcesses; Process != NULL;  Process = Process->next) {
+        if (Process->state == 1) {
+            write_bbvari_udword_without_check(Process->VidRuntimeP99, (uint32_t)(LatencyHistogramPercentile(&Process->RuntimeHistogram, 99.0) / 1000));
+        }
+    }
+}
+
 #define CLOCK_MONOTONIC 1
 
 #define gettid() syscall(__NR_gettid)
@@ -310,6 +349,10 @@ static void *RealtimeSchedulerTreadFunction(void* par_Data)
     Scheduler->CycleMaxTime = 0;
     Scheduler->CycleMinTime = 0x7FFFFFFFFFFFFFFFLL;
     Scheduler->CycleCounter = 0;
+    InitLatencyHistogram(&Scheduler->WakeupLatency);
+    MEMSET(&Scheduler->Overruns, 0, sizeof(Scheduler->Overruns));
+    Scheduler->ExpectedWakeupTime = 0;
+    Scheduler->NextLatencyExportCycle = 0;
     {   // This variable must be added inside the scheduler task
         char VariableName[BBVARI_NAME_SIZE];
         const char *Prefix = GetConfigurablePrefix(CONFIGURABLE_PREFIX_TYPE_LONG2_BLACKBOARD);
@@ -334,6 +377,16 @@ static void *RealtimeSchedulerTreadFunction(void* par_Data)
 		Scheduler->CycleCountMinPeriodVid = add_bbvari(VariableName, BB_UDWORD, "");
         PrintFormatToString (VariableName, sizeof(VariableName), "%s.%s.CycleCountMaxPeriod", Prefix, Scheduler->name);
 		Scheduler->CycleCountMaxPeriodVid = add_bbvari(VariableName, BB_UDWORD, "");
+        PrintFormatToString (VariableName, sizeof(VariableName), "%s.%s.WakeupLatencyP50", Prefix, Scheduler->name);
+        Scheduler->WakeupLatencyP50Vid = add_bbvari(VariableName, BB_DOUBLE, "s");
+        PrintFormatToString (VariableName, sizeof(VariableName), "%s.%s.WakeupLatencyP99", Prefix, Scheduler->name);
+        Scheduler->WakeupLatencyP99Vid = add_bbvari(VariableName, BB_DOUBLE, "s");
+        PrintFormatToString (VariableName, sizeof(VariableName), "%s.%s.WakeupLatencyP999", Prefix, Scheduler->name);
+        Scheduler->WakeupLatencyP999Vid = add_bbvari(VariableName, BB_DOUBLE, "s");
+        PrintFormatToString (VariableName, sizeof(VariableName), "%s.%s.WakeupLatencyMax", Prefix, Scheduler->name);
+        Scheduler->WakeupLatencyMaxVid = add_bbvari(VariableName, BB_DOUBLE, "s");
+        PrintFormatToString (VariableName, sizeof(VariableName), "%s.%s.OverrunCounter", Prefix, Scheduler->name);
+        Scheduler->OverrunCounterVid = add_bbvari(VariableName, BB_UDWORD, "");
         // only debug
         //PrintFormatToString (VariableName, sizeof(VariableName), "%s.%s.FreeRunningCycleCounter_Debug", Scheduler->name);
         //SignalCyclicEvent_FreeRunningCycleCounter_Debug_Vid = add_bbvari(VariableName, BB_UDWORD, "");
@@ -380,6 +433,25 @@ static void *RealtimeSchedulerTreadFunction(void* par_Data)
 
         last = now;
         clock_gettime(CLOCK_MONOTONIC, &now);
+        {
+            // The timer is periodic, so the expected wakeup time is the previous one plus one period
+            // (or more periods if the timer has expired more than once)
+            __uint64_t Now = timespec_to_ns(now);
+            int Overrun = timer_getoverrun(timer);
+            if (Scheduler->ExpectedWakeupTime == 0) {
+                Scheduler->ExpectedWakeupTime = Now;
+            } else {
+                Scheduler->ExpectedWakeupTime += Scheduler->CyclePeriodInNanoSecond * (__uint64_t)(1 + ((Overrun > 0) ? Overrun : 0));
+            }
+            if (Now > Scheduler->ExpectedWakeupTime) {
+                LatencyHistogramRecord(&Scheduler->WakeupLatency, Now - Scheduler->ExpectedWakeupTime);
+            } else {
+                LatencyHistogramRecord(&Scheduler->WakeupLatency, 0);
+            }
+            if (Overrun > 0) {
+                AddOverrunEvent(&Scheduler->Overruns, Scheduler->CycleCounter, Now, (__uint64_t)Overrun * Scheduler->CyclePeriodInNanoSecond, -1);
+            }
+        }
 
         Scheduler->CurrentRunningProcess = &schedulers_internal_tcb;
         if (Scheduler->CycleCounter) {
@@ -403,6 +475,7 @@ static void *RealtimeSchedulerTreadFunction(void* par_Data)
 			write_bbvari_udword_without_check(Scheduler->TimeResetVid, 0);
 			Scheduler->CycleMaxTime = 0;
 			Scheduler->CycleMinTime = 0x7FFFFFFFFFFFFFFFLL;
+            LatencyHistogramRequestReset(&Scheduler->WakeupLatency);
 		}
 
         Scheduler->CycleCounter++;
@@ -429,6 +502,8 @@ static void *RealtimeSchedulerTreadFunction(void* par_Data)
                     PrintFormatToString (VariableName, sizeof(VariableName), "%s.Runtime.%s", Prefix, Scheduler->CurrentRunningProcess->name);
                     Scheduler->CurrentRunningProcess->state = 1;
                     Scheduler->CurrentRunningProcess->VidRuntime = add_bbvari(VariableName, BB_UDWORD, "");
+                    PrintFormatToString (VariableName, sizeof(VariableName), "%s.RuntimeP99.%s", Prefix, Scheduler->CurrentRunningProcess->name);
+                    Scheduler->CurrentRunningProcess->VidRuntimeP99 = add_bbvari(VariableName, BB_UDWORD, "us");
                 }
                 break;
             case 1:  // Call Cyclic
@@ -446,6 +521,13 @@ static void *RealtimeSchedulerTreadFunction(void* par_Data)
                         ClacBehindProcessEquations(Scheduler->CurrentRunningProcess);
 
                         clock_gettime(CLOCK_MONOTONIC, &stop);
+                        {
+                            __uint64_t Runtime = calcdiff_ns(stop, start);
+                            LatencyHistogramRecord(&Scheduler->CurrentRunningProcess->RuntimeHistogram, Runtime);
+                            if (Runtime > Scheduler->CyclePeriodInNanoSecond) {
+                                AddOverrunEvent(&Scheduler->Overruns, Scheduler->CycleCounter, timespec_to_ns(stop), Runtime, Scheduler->CurrentRunningProcess->pid);
+                            }
+                        }
                         diff = calcdiff(stop, start);
                         Scheduler->CurrentRunningProcess->CycleTime = (__uint64_t)diff;
                         write_bbvari_udword_without_check(Scheduler->CurrentRunningProcess->VidRuntime, (uint32_t)diff);
@@ -461,6 +543,7 @@ static void *RealtimeSchedulerTreadFunction(void* par_Data)
                 break;
             case 3:  // Killed
                 remove_bbvari(Scheduler->CurrentRunningProcess->VidRuntime);
+                remove_bbvari(Scheduler->CurrentRunningProcess->VidRuntimeP99);
                 // Report to the client that the process was terminated
                 RealtimeProcessStopped(Scheduler->CurrentRunningProcess->pid, Scheduler->CurrentRunningProcess->name);
                 free_bb_accessmask(Scheduler->CurrentRunningProcess->pid, Scheduler->CurrentRunningProcess->bb_mask);
@@ -476,7 +559,21 @@ static void *RealtimeSchedulerTreadFunction(void* par_Data)
             Scheduler->CurrentRunningProcess = Scheduler->CurrentRunningProcess->next;
         }
         CheckIfProceeesShouldBeAdded(Scheduler);
+        if (Scheduler->CycleCounter >= Scheduler->NextLatencyExportCycle) {
+            ExportLatencyHistogramsToBlackboard(Scheduler);
+            Scheduler->NextLatencyExportCycle = Scheduler->CycleCounter + (uint64_t)(1.0 / Scheduler->CyclePeriod);
+        }
         LeaveCriticalSection(&SchedMessageGlobalSpinlock);
+        {
+            // Complete cycle inside the period?
+            struct timespec end;
+            __uint64_t CycleRuntime;
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            CycleRuntime = calcdiff_ns(end, now);
+            if (CycleRuntime > Scheduler->CyclePeriodInNanoSecond) {
+                AddOverrunEvent(&Scheduler->Overruns, Scheduler->CycleCounter, timespec_to_ns(end), CycleRuntime, -1);
+            }
+        }
     }
 
     // Scheduler will be terminate (Call for all running processes the terminate() function)
@@ -498,6 +595,7 @@ static void *RealtimeSchedulerTreadFunction(void* par_Data)
         switch (Scheduler->CurrentRunningProcess->state) {
         case 3:  // Killed
             remove_bbvari(Scheduler->CurrentRunningProcess->VidRuntime);
+            remove_bbvari(Scheduler->CurrentRunningProcess->VidRuntimeP99);
             // Report to the client that the process was terminated
             RealtimeProcessStopped(Scheduler->CurrentRunningProcess->pid, Scheduler->CurrentRunningProcess->name);
             free_bb_accessmask(Scheduler->CurrentRunningProcess->pid, Scheduler->CurrentRunningProcess->bb_mask);
@@ -681,6 +779,7 @@ int StartRealtimeProcess(int par_Pid, char *par_Name, char *par_Scheduler, int p
             AvailableRealtimeProcesses[x]->CycleTime = 0;
             AvailableRealtimeProcesses[x]->CycleTimeMax = 0;
             AvailableRealtimeProcesses[x]->CycleTimeMin = 0xFFFFFFFFFFFFFFFFULL;
+            InitLatencyHistogram(&(AvailableRealtimeProcesses[x]->RuntimeHistogram));
 
             AvailableRealtimeProcesses[x]->BeforeProcessEquationCounter = 0;
             AvailableRealtimeProcesses[x]->BeforeProcessEquations = NULL;
@@ -714,6 +813,7 @@ int ResetProcessMinMaxRuntimeMeasurement(int par_Pid)
         if (LocalPid == par_Pid) {
             AvailableRealtimeProcesses[x]->CycleTimeMax = 0;
             AvailableRealtimeProcesses[x]->CycleTimeMin = 0xFFFFFFFFFFFFFFFFULL;
+            LatencyHistogramRequestReset(&(AvailableRealtimeProcesses[x]->RuntimeHistogram));
             LeaveCriticalSection(&PidNameArrayCriticalSection);
             return 0;
         }
@@ -722,6 +822,40 @@ int ResetProcessMinMaxRuntimeMeasurement(int par_Pid)
     return -1;
 }
 
+int GetLatencyHistogramsAsString(char *ret_Buffer, int par_MaxChars)
+{
+    int s, Pos = 0;
+    size_t x;
+    char Name[600];
+
+    if (par_MaxChars <= 0) return 0;
+    ret_Buffer[0] = 0;
+    for (s = 0; s < MAX_SCHEDULERS; s++) {
+        if (Schedulers[s].State > 0) {
+            OVERRUN_EVENT Events[OVERRUN_EVENT_RING_SIZE];
+            int e, Count;
+            PrintFormatToString (Name, sizeof(Name), "scheduler \"%s\" wakeup latency", Schedulers[s].name);
+            Pos += LatencyHistogramToString(&Schedulers[s].WakeupLatency, Name, ret_Buffer + Pos, par_MaxChars - Pos);
+            Count = GetOverrunEvents(&Schedulers[s].Overruns, Events, OVERRUN_EVENT_RING_SIZE);
+            Pos += PrintFormatToString (ret_Buffer + Pos, par_MaxChars - Pos, "scheduler \"%s\" overruns: %u (last %i)\n",
+                                        Schedulers[s].name, GetOverrunEventCount(&Schedulers[s].Overruns), Count);
+            for (e = 0; e < Count; e++) {
+                Pos += PrintFormatToString (ret_Buffer + Pos, par_MaxChars - Pos, "  cycle=%llu time=%llu duration=%llu pid=%i\n",
+                                            (unsigned long long)Events[e].Cycle, (unsigned long long)Events[e].TimeStamp,
+                                            (unsigned long long)Events[e].Duration, Events[e].Pid);
+            }
+        }
+    }
+    // The task control blocks of the realtime processes are static, no lock is necessary
+    for (x = 0; x < AvailableRealtimeProcessCount; x++) {
+        if (AvailableRealtimeProcesses[x]->active) {
+            PrintFormatToString (Name, sizeof(Name), "process \"%s\" runtime", AvailableRealtimeProcesses[x]->name);
+            Pos += LatencyHistogramToString(&(AvailableRealtimeProcesses[x]->RuntimeHistogram), Name, ret_Buffer + Pos, par_MaxChars - Pos);
+        }
+    }
+    return Pos;
+}
+
 
 int GetNextRealtimeProcess(int par_Index, int par_Flags, char *ret_Buffer, int par_maxc)
 {
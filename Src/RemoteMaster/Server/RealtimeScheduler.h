@@ -63,6 +63,9 @@ int get_process_info_ex(int pid, char *ret_Name, int maxc_Name, int *ret_Type, i
 
 int ResetProcessMinMaxRuntimeMeasurement(int par_Pid);
 
+// Summary and buckets of the wakeup latency and runtime histograms and the last overrun events as text
+int GetLatencyHistogramsAsString(char *ret_Buffer, int par_MaxChars);
+
 int MyTimeout(int us);
 
 #define MAX_PIDS 64
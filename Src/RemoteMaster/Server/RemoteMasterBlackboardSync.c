@@ -0,0 +1,214 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+
+#include "MemZeroAndCopy.h"
+#include "MemoryAllocation.h"
+#include "RemoteMasterLock.h"
+#include "StructsRM_Blackboard.h"
+#include "Blackboard.h"
+#include "BlackboardAccess.h"
+#include "BlackboardDeltaCoding.h"
+#include "RemoteMasterBlackboardSync.h"
+
+// One entry for each variable the client is interested in, sorted by the blackboard index
+typedef struct {
+    int32_t Index;
+    VID Vid;
+    union BB_VARI Value;    // last transmitted value
+    uint8_t Type;           // last transmitted type
+    uint8_t Resend;         // transmit with the next call even if it is not changed
+} SYNC_ENTRY;
+
+static REMOTE_MASTER_LOCK SyncLock;
+
+static SYNC_ENTRY *Entries;
+static int EntryCount;
+static int EntrySize;
+
+// Working buffers for the delta blocks
+static int32_t *TmpIndexes;
+static uint8_t *TmpTypes;
+static union BB_VARI *TmpValues;
+static int *TmpEntryPos;
+static int TmpSize;
+
+void InitBlackboardValueSync (void)
+{
+    RemoteMasterInitLock (&SyncLock);
+}
+
+static int CheckTmpBufferSize (int par_Size)
+{
+    if (par_Size > TmpSize) {
+        TmpSize = par_Size + 1024;
+        TmpIndexes = (int32_t*)my_realloc (TmpIndexes, TmpSize * (long)sizeof (int32_t));
+        TmpTypes = (uint8_t*)my_realloc (TmpTypes, TmpSize * (long)sizeof (uint8_t));
+        TmpValues = (union BB_VARI*)my_realloc (TmpValues, TmpSize * (long)sizeof (union BB_VARI));
+        TmpEntryPos = (int*)my_realloc (TmpEntryPos, TmpSize * (long)sizeof (int));
+        if ((TmpIndexes == NULL) || (TmpTypes == NULL) || (TmpValues == NULL) || (TmpEntryPos == NULL)) {
+            TmpSize = 0;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Return the position of the entry or -1, *ret_InsertPos is the position where it should be inserted
+static int SearchEntry (int32_t par_Index, int *ret_InsertPos)
+{
+    int l = 0;
+    int r = EntryCount - 1;
+
+    while (l <= r) {
+        int m = (l + r) >> 1;
+        if (Entries[m].Index == par_Index) return m;
+        if (Entries[m].Index < par_Index) l = m + 1;
+        else r = m - 1;
+    }
+    if (ret_InsertPos != NULL) *ret_InsertPos = l;
+    return -1;
+}
+
+static int Subscribe (VID par_Vid)
+{
+    int32_t Index = (int32_t)(par_Vid >> 8);
+    int Pos, InsertPos;
+
+    if ((par_Vid <= 0) || (Index >= get_blackboardsize())) return -1;
+    if ((Pos = SearchEntry (Index, &InsertPos)) < 0) {
+        if (EntryCount >= EntrySize) {
+            EntrySize += 1024;
+            Entries = (SYNC_ENTRY*)my_realloc (Entries, EntrySize * (long)sizeof (SYNC_ENTRY));
+            if (Entries == NULL) {
+                EntrySize = EntryCount = 0;
+                return -1;
+            }
+        }
+        memmove (&(Entries[InsertPos + 1]), &(Entries[InsertPos]), (size_t)(EntryCount - InsertPos) * sizeof (SYNC_ENTRY));
+        EntryCount++;
+        Pos = InsertPos;
+        Entries[Pos].Index = Index;
+    }
+    // A new subscription or a request to transmit the value again
+    Entries[Pos].Vid = par_Vid;
+    Entries[Pos].Resend = 1;
+    return 0;
+}
+
+static void ApplyWrites (int par_WritePid, const void *par_Writes, int par_LenWrites)
+{
+    int Count, x;
+
+    // Each value needs at least one byte
+    if (CheckTmpBufferSize (par_LenWrites)) return;
+    Count = DecodeBlackboardDelta (par_Writes, par_LenWrites, TmpIndexes, TmpTypes, TmpValues, TmpSize);
+    for (x = 0; x < Count; x++) {
+        int32_t Index = TmpIndexes[x];
+        int Size = GetDataTypeByteSize (TmpTypes[x]);
+        int Pos;
+        SYNC_ENTRY *Entry;
+
+        // only subscribed variables can be written, so the vid is known
+        if ((Pos = SearchEntry (Index, NULL)) < 0) continue;
+        Entry = &(Entries[Pos]);
+        if ((Size == 0) || (Index >= get_blackboardsize()) || (blackboard[Index].Vid != Entry->Vid)) continue;
+        write_bbvari_union_pid (par_WritePid, Entry->Vid, TmpTypes[x], TmpValues[x]);
+        if (((int)BB_TYPE(Index) == (int)TmpTypes[x]) &&
+            (memcmp (&(BB_VALUE(Index)), &(TmpValues[x]), (size_t)Size) == 0)) {
+            // The client knows this value already
+            Entry->Type = TmpTypes[x];
+            Entry->Value = TmpValues[x];
+        } else {
+            // Not written (access rights or data type), the client must get the real value
+            Entry->Resend = 1;
+        }
+    }
+}
+
+int SyncBlackboardValues (int par_WritePid, uint32_t par_Flags,
+                          const VID *par_SubscribeVids, int par_SubscribeCount,
+                          const void *par_Writes, int par_LenWrites,
+                          void *ret_Values, int par_MaxLenValues, int *ret_LenValues)
+{
+    int x, Count, Encoded;
+
+    *ret_LenValues = 0;
+    if (blackboard == NULL) return -1;
+
+    RemoteMasterLock (&SyncLock, __LINE__, __FILE__);
+    if ((par_Flags & RM_SYNC_VALUES_RESET_SUBSCRIPTIONS) == RM_SYNC_VALUES_RESET_SUBSCRIPTIONS) {
+        EntryCount = 0;
+    }
+    for (x = 0; x < par_SubscribeCount; x++) {
+        Subscribe (par_SubscribeVids[x]);
+    }
+    if (par_LenWrites > 0) {
+        ApplyWrites (par_WritePid, par_Writes, par_LenWrites);
+    }
+    if (CheckTmpBufferSize (EntryCount)) {
+        RemoteMasterUnlock (&SyncLock);
+        return -1;
+    }
+    // Collect all changed values
+    Count = 0;
+    for (x = 0; x < EntryCount; x++) {
+        SYNC_ENTRY *Entry = &(Entries[x]);
+        int32_t Index = Entry->Index;
+        if ((Index >= get_blackboardsize()) || (blackboard[Index].Vid != Entry->Vid)) {
+            TmpTypes[Count] = BB_DELTA_REMOVED_TYPE;
+            TmpValues[Count].uqw = 0;
+        } else {
+            union BB_VARI Value = BB_VALUE(Index);
+            uint8_t Type = (uint8_t)BB_TYPE(Index);
+            if (!Entry->Resend && (Type == Entry->Type) &&
+                (memcmp (&Value, &(Entry->Value), (size_t)GetDataTypeByteSize (Type)) == 0)) {
+                continue;
+            }
+            TmpTypes[Count] = Type;
+            TmpValues[Count] = Value;
+        }
+        TmpIndexes[Count] = Index;
+        TmpEntryPos[Count] = x;
+        Count++;
+    }
+    // If not all values fit the rest will be transmitted with the next call
+    Encoded = EncodeBlackboardDelta (TmpIndexes, TmpTypes, TmpValues, Count, ret_Values, par_MaxLenValues, ret_LenValues);
+    for (x = 0; x < Encoded; x++) {
+        SYNC_ENTRY *Entry = &(Entries[TmpEntryPos[x]]);
+        if (TmpTypes[x] == BB_DELTA_REMOVED_TYPE) {
+            Entry->Vid = 0;  // will be deleted below
+        } else {
+            Entry->Type = TmpTypes[x];
+            Entry->Value = TmpValues[x];
+            Entry->Resend = 0;
+        }
+    }
+    // Remove the entries of deleted variables
+    Count = 0;
+    for (x = 0; x < EntryCount; x++) {
+        if (Entries[x].Vid != 0) {
+            if (Count != x) Entries[Count] = Entries[x];
+            Count++;
+        }
+    }
+    EntryCount = Count;
+    RemoteMasterUnlock (&SyncLock);
+    return Encoded;
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+#include "Blackboard.h"
+
+void InitBlackboardValueSync (void);
+
+// Server side of RM_BLACKBOARD_SYNC_VALUES_CMD:
+// 1. (re)subscribe par_SubscribeVids, their values will be transmitted with this call
+// 2. write the values of the delta block par_Writes with par_WritePid
+// 3. store all subscribed values which are changed since the last call into the delta block ret_Values
+// Return the number of values stored inside ret_Values or -1.
+int SyncBlackboardValues (int par_WritePid, uint32_t par_Flags,
+                          const VID *par_SubscribeVids, int par_SubscribeCount,
+                          const void *par_Writes, int par_LenWrites,
+                          void *ret_Values, int par_MaxLenValues, int *ret_LenValues);
@@ -29,6 +29,7 @@
 #include "StructsRM_Blackboard.h"
 #include "StructsRM_Message.h"
 #include "StructsRM_FiFo.h"
+#include "FifoSyncCoding.h"
 #include "StructsRM_Scheduler.h"
 #include "StructsRM_CanFifo.h"
 
@@ -47,6 +48,7 @@
 #include "RemoteMasterReadWriteMemory.h"
 #include "RemoteMasterMessage.h"
 #include "RemoteMasterModelInterface.h"
+#include "RemoteMasterBlackboardSync.h"
 #include "RemoteMasterDecoder.h"
 
 #define MIN_MEMORY_SIZE  (256*1024*1024)
@@ -92,6 +94,7 @@ static uint32_t Func_Init(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack
     }
     Ack->Version = XILENV_VERSION;
     Ack->PatchVersion = XILENV_MINOR_VERSION;
+    Ack->SyncFiFoCodings = Req->SyncFiFoCodings & FIFO_SYNC_SUPPORTED_CODINGS;
     return sizeof(RM_INIT_ACK);
 }
 
@@ -607,29 +610,33 @@ static uint32_t Func_get_bbvari_format_prec(RM_PACKAGE_HEADER *par_Req, RM_PACKA
     return sizeof(RM_BLACKBOARD_GET_BBVARI_FORMAT_PREC_ACK);
 }
 
-static uint32_t Func_get_free_wrflag(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
+static uint32_t Func_get_bbvari_wrseq(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
 {
-    RM_BLACKBOARD_GET_FREE_WRFLAG_REQ *Req = (RM_BLACKBOARD_GET_FREE_WRFLAG_REQ*)par_Req;
-    RM_BLACKBOARD_GET_FREE_WRFLAG_ACK *Ack = (RM_BLACKBOARD_GET_FREE_WRFLAG_ACK*)par_Ack;
-    Ack->Ret = get_free_wrflag((PID)Req->Pid, &(Ack->wrflag));
-    return sizeof(RM_BLACKBOARD_GET_FREE_WRFLAG_ACK);
+    RM_BLACKBOARD_GET_BBVARI_WRSEQ_REQ *Req = (RM_BLACKBOARD_GET_BBVARI_WRSEQ_REQ*)par_Req;
+    RM_BLACKBOARD_GET_BBVARI_WRSEQ_ACK *Ack = (RM_BLACKBOARD_GET_BBVARI_WRSEQ_ACK*)par_Ack;
+    Ack->WrSeq = get_bbvari_wrseq(Req->Vid);
+    return sizeof(RM_BLACKBOARD_GET_BBVARI_WRSEQ_ACK);
 }
 
-static uint32_t Func_reset_wrflag(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
+static uint32_t Func_get_bbvari_wrseq_frame(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
 {
-    RM_BLACKBOARD_RESET_WRFLAG_REQ *Req = (RM_BLACKBOARD_RESET_WRFLAG_REQ*)par_Req;
-    RM_BLACKBOARD_RESET_WRFLAG_ACK *Ack = (RM_BLACKBOARD_RESET_WRFLAG_ACK*)par_Ack;
-    reset_wrflag(Req->Vid, Req->w); 
+    RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_REQ *Req = (RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_REQ*)par_Req;
+    RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_ACK *Ack = (RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_ACK*)par_Ack;
+    VID *Vids = (VID*)((char*)Req + Req->OffsetVids);
+    uint32_t *WrSeqs = (uint32_t*)(Ack + 1);
+    get_bbvari_wrseq_frame(Req->Number, Vids, WrSeqs);
+    Ack->OffsetWrSeqs = sizeof(RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_ACK);
     Ack->Ret = 0;
-    return sizeof(RM_BLACKBOARD_RESET_WRFLAG_ACK);
+    return sizeof(RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_ACK) + Req->Number * sizeof(uint32_t);
 }
 
-static uint32_t Func_test_wrflag(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
+static uint32_t Func_test_bbvari_wrseq(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
 {
-    RM_BLACKBOARD_TEST_WRFLAG_REQ *Req = (RM_BLACKBOARD_TEST_WRFLAG_REQ*)par_Req;
-    RM_BLACKBOARD_TEST_WRFLAG_ACK *Ack = (RM_BLACKBOARD_TEST_WRFLAG_ACK*)par_Ack;
-    Ack->Ret = test_wrflag(Req->Vid, Req->w);
-    return sizeof(RM_BLACKBOARD_TEST_WRFLAG_ACK);
+    RM_BLACKBOARD_TEST_BBVARI_WRSEQ_REQ *Req = (RM_BLACKBOARD_TEST_BBVARI_WRSEQ_REQ*)par_Req;
+    RM_BLACKBOARD_TEST_BBVARI_WRSEQ_ACK *Ack = (RM_BLACKBOARD_TEST_BBVARI_WRSEQ_ACK*)par_Ack;
+    Ack->WrSeq = Req->WrSeq;
+    Ack->Ret = test_bbvari_wrseq(Req->Vid, &(Ack->WrSeq));
+    return sizeof(RM_BLACKBOARD_TEST_BBVARI_WRSEQ_ACK);
 }
 
 static uint32_t Func_read_next_blackboard_vari(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
@@ -1155,6 +1162,98 @@ static uint32_t Func_write_bbvari_by_name(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE
     return sizeof(RM_BLACKBOARD_WRITE_BBVARI_BY_NAME_ACK);
 }
 
+static uint32_t Func_add_bbvari_pid_type_frame(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
+{
+    RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_REQ *Req = (RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_REQ*)par_Req;
+    RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_ACK *Ack = (RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_ACK*)par_Ack;
+    char *Pos = (char*)Req + Req->OffsetEntries;
+    char *End = (char*)Req + Req->PackageHeader.SizeOf;
+    int32_t *Vids, *Types;
+    int Count = Req->Count;
+    int x;
+
+    if (Count < 0) Count = 0;
+    if (Count > (int)((BUFFER_SIZE - sizeof(RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_ACK)) / (2 * sizeof(int32_t)))) {
+        Count = (int)((BUFFER_SIZE - sizeof(RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_ACK)) / (2 * sizeof(int32_t)));
+    }
+    Ack->OffsetVids = sizeof(RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_ACK);
+    Ack->OffsetTypes = Ack->OffsetVids + (uint32_t)Count * sizeof(int32_t);
+    Vids = (int32_t*)((char*)Ack + Ack->OffsetVids);
+    Types = (int32_t*)((char*)Ack + Ack->OffsetTypes);
+    for (x = 0; x < Count; x++) {
+        RM_BLACKBOARD_ADD_BBVARI_FRAME_ENTRY *Entry = (RM_BLACKBOARD_ADD_BBVARI_FRAME_ENTRY*)Pos;
+        char *Unit;
+        if (((Pos + sizeof(RM_BLACKBOARD_ADD_BBVARI_FRAME_ENTRY)) > End) ||
+            (Entry->SizeOf <= sizeof(RM_BLACKBOARD_ADD_BBVARI_FRAME_ENTRY)) ||
+            ((Pos + Entry->SizeOf) > End) ||
+            (Entry->UnitOffset >= Entry->SizeOf) ||
+            ((Entry->UnitOffset != 0) && (Entry->UnitOffset <= sizeof(RM_BLACKBOARD_ADD_BBVARI_FRAME_ENTRY)))) {
+            break;
+        }
+        Pos[Entry->SizeOf - 1] = 0;   // the strings must be terminated
+        Unit = (Entry->UnitOffset) ? Pos + Entry->UnitOffset : NULL;
+        Vids[x] = (int32_t)add_bbvari_pid_type((char*)(Entry + 1), Entry->Type, Unit, Req->Pid, (int)Entry->Dir, Entry->ValueValidFlag,
+                                               (union BB_VARI *)&(Entry->ValueUnion), &(Types[x]), Entry->ReadReqMask, NULL, NULL, NULL);
+        Pos += RM_BATCH_ALIGN(Entry->SizeOf);
+    }
+    Ack->Ret = x;
+    return Ack->OffsetTypes + (uint32_t)Count * sizeof(int32_t);
+}
+
+static uint32_t Func_SyncBlackboardValues(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
+{
+    RM_BLACKBOARD_SYNC_VALUES_REQ *Req = (RM_BLACKBOARD_SYNC_VALUES_REQ*)par_Req;
+    RM_BLACKBOARD_SYNC_VALUES_ACK *Ack = (RM_BLACKBOARD_SYNC_VALUES_ACK*)par_Ack;
+    int MaxLenValues = (int)Req->MaxLenValues;
+    int LenValues;
+
+    if (MaxLenValues > BUFFER_SIZE - (int)sizeof(RM_BLACKBOARD_SYNC_VALUES_ACK)) {
+        MaxLenValues = BUFFER_SIZE - (int)sizeof(RM_BLACKBOARD_SYNC_VALUES_ACK);
+    }
+    Ack->OffsetValues = sizeof(RM_BLACKBOARD_SYNC_VALUES_ACK);
+    Ack->Ret = SyncBlackboardValues(Req->WritePid, Req->Flags,
+                                    (VID*)((char*)Req + Req->OffsetSubscribeVids), Req->SubscribeCount,
+                                    (char*)Req + Req->OffsetWrites, (int)Req->LenWrites,
+                                    (char*)Ack + Ack->OffsetValues, MaxLenValues, &LenValues);
+    Ack->LenValues = (uint32_t)LenValues;
+    return sizeof(RM_BLACKBOARD_SYNC_VALUES_ACK) + (uint32_t)LenValues;
+}
+
+static uint32_t Func_BlackboardBatch(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
+{
+    RM_BLACKBOARD_BATCH_REQ *Req = (RM_BLACKBOARD_BATCH_REQ*)par_Req;
+    RM_BLACKBOARD_BATCH_ACK *Ack = (RM_BLACKBOARD_BATCH_ACK*)par_Ack;
+    char *SubReq = (char*)Req + Req->OffsetRequests;
+    char *End = (char*)Req + Req->PackageHeader.SizeOf;
+    uint32_t AckPos = sizeof(RM_BLACKBOARD_BATCH_ACK);
+    int x;
+
+    Ack->OffsetAcks = AckPos;
+    for (x = 0; x < Req->Count; x++) {
+        RM_PACKAGE_HEADER *SubReqHeader = (RM_PACKAGE_HEADER*)SubReq;
+        RM_PACKAGE_HEADER *SubAck = (RM_PACKAGE_HEADER*)((char*)Ack + AckPos);
+        uint32_t Size;
+        if (((SubReq + sizeof(RM_PACKAGE_HEADER)) > End) ||
+            (SubReqHeader->SizeOf < sizeof(RM_PACKAGE_HEADER)) ||
+            ((SubReq + SubReqHeader->SizeOf) > End)) {
+            break;
+        }
+        // Only blackboard requests (no nested batches) and the client must not exceed the ack size
+        if ((SubReqHeader->Command < RM_BLACKBOARD_OFFSET) ||
+            (SubReqHeader->Command >= RM_BLACKBOARD_SYNC_VALUES_CMD) ||
+            (AckPos > RM_BATCH_MAX_ACK_SIZE)) {
+            break;
+        }
+        Size = DecodeCommand(SubReqHeader, SubAck);
+        if (Size < sizeof(RM_PACKAGE_HEADER)) Size = sizeof(RM_PACKAGE_HEADER);   // requests without ack
+        SubAck->SizeOf = Size;
+        AckPos += RM_BATCH_ALIGN(Size);
+        SubReq += RM_BATCH_ALIGN(SubReqHeader->SizeOf);
+    }
+    Ack->Ret = x;
+    return AckPos;
+}
+
 // Messages
 
 static uint32_t Func_write_message_ts_as(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
@@ -1402,6 +1501,24 @@ static uint32_t Func_ResetProcessMinMaxRuntimeMeasurement(RM_PACKAGE_HEADER *par
     return sizeof(RM_RESET_PROCESS_MIN_MAX_RUNTIME_MEASUREMENT_ACK);
 }
 
+static uint32_t Func_GetLatencyHistograms(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
+{
+    RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_REQ *Req = (RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_REQ*)par_Req;
+    RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_ACK *Ack = (RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_ACK*)par_Ack;
+    int maxc = Req->maxc;
+
+    if (maxc > (BUFFER_SIZE - (int)sizeof(RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_ACK))) {
+        maxc = BUFFER_SIZE - (int)sizeof(RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_ACK);
+    }
+    Ack->Offset_Text = sizeof(RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_ACK);
+    if (maxc <= 0) {
+        Ack->Ret = 0;
+        return sizeof(RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_ACK);
+    }
+    Ack->Ret = GetLatencyHistogramsAsString((char*)(Ack + 1), maxc);
+    return sizeof(RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_ACK) + Ack->Ret + 1;
+}
+
 // CAN Fifos
 
 static uint32_t Func_CreateCanFifos(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
@@ -1569,6 +1686,35 @@ static uint32_t Func_SyncFiFos(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *pa
 	return sizeof(RM_SYNC_FIFOS_ACK) + Ack->Len;
 }
 
+static uint32_t Func_SyncFiFosCoded(RM_PACKAGE_HEADER *par_Req, RM_PACKAGE_HEADER *par_Ack)
+{
+	static FIFO_SYNC_CODER Coder;
+	RM_SYNC_FIFOS_CODED_REQ *Req = (RM_SYNC_FIFOS_CODED_REQ*)par_Req;
+	RM_SYNC_FIFOS_CODED_ACK *Ack = (RM_SYNC_FIFOS_CODED_ACK*)par_Ack;
+	int RawSize = BUFFER_SIZE - (int)sizeof(RM_SYNC_FIFOS_CODED_ACK);
+	void *Raw;
+
+	Raw = DecodeFiFoSyncBlock(&Coder, Req + 1, (int)Req->Len, Req->Coding, (int)Req->RawLen);
+	if (Raw != NULL) {
+		SyncRxFiFos(Raw, (int)Req->RawLen);
+	} else {
+		ThrowError(1, "corrupt fifo sync block received (coding = 0x%X)", Req->Coding);
+	}
+	Ack->Len = 0;
+	Ack->RawLen = 0;
+	Ack->Coding = 0;
+	Ack->Ret = 0;
+	Raw = GetFiFoSyncCoderRawBuffer(&Coder, RawSize);
+	if (Raw != NULL) {
+		// The coded data are never larger than the raw data, so they will fit into the ack
+		Ack->Ret = SyncTxFiFos(Raw, RawSize, &(Ack->RawLen));
+		Ack->Len = EncodeFiFoSyncBlock(&Coder, Raw, Ack->RawLen, Req->AcceptedCodings & FIFO_SYNC_SUPPORTED_CODINGS,
+		                               Ack + 1, &(Ack->Coding));
+	}
+	Ack->Offset_Buffer = sizeof(RM_SYNC_FIFOS_CODED_ACK);
+	return sizeof(RM_SYNC_FIFOS_CODED_ACK) + Ack->Len;
+}
+
 
 typedef uint32_t (*FUNC_PTR)(RM_PACKAGE_HEADER *Req, RM_PACKAGE_HEADER *Ack);
 
@@ -1628,9 +1774,9 @@ struct ENTRY_FUNC_PTR FuntionPointerTable[] = {
     /* 045 */{ Func_set_bbvari_format, RM_BLACKBOARD_SET_BBVARI_FORMAT_CMD, 0 },
     /* 046 */{ Func_get_bbvari_format_width, RM_BLACKBOARD_GET_BBVARI_FORMAT_WIDTH_CMD, 0 },
     /* 047 */{ Func_get_bbvari_format_prec, RM_BLACKBOARD_GET_BBVARI_FORMAT_PREC_CMD, 0 },
-    /* 048 */{ Func_get_free_wrflag, RM_BLACKBOARD_GET_FREE_WRFLAG_CMD, 0 },
-    /* 049 */{ Func_reset_wrflag, RM_BLACKBOARD_RESET_WRFLAG_CMD, 0 },
-    /* 050 */{ Func_test_wrflag, RM_BLACKBOARD_TEST_WRFLAG_CMD, 0 },
+    /* 048 */{ Func_get_bbvari_wrseq, RM_BLACKBOARD_GET_BBVARI_WRSEQ_CMD, 0 },
+    /* 049 */{ Func_get_bbvari_wrseq_frame, RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_CMD, 0 },
+    /* 050 */{ Func_test_bbvari_wrseq, RM_BLACKBOARD_TEST_BBVARI_WRSEQ_CMD, 0 },
     /* 051 */{ Func_read_next_blackboard_vari, RM_BLACKBOARD_READ_NEXT_BLACKBOARD_VARI_CMD, 0 },
     /* 052 */{ Func_ReadNextVariableProcessAccess, RM_BLACKBOARD_READ_NEXT_VARI_PROCESS_ACCESS_CMD, 0 },
     /* 053 */{ Func_enable_bbvari_access, RM_BLACKBOARD_ENABLE_BBVARI_ACCESS_CMD, 0 },
@@ -1726,9 +1872,9 @@ struct ENTRY_FUNC_PTR FuntionPointerTable[] = {
     /* 139 */{ Func_write_bbvari_convert_with_FloatAndInt64, RM_WRITE_BBVARI_CONVERT_WITH_FLOATANDINT64_CMD, 0 },
     /* 140 */{ Func_read_bbvari_by_name, RM_BLACKBOARD_READ_BBVARI_BY_NAME_CMD, 0 },
     /* 141 */{ Func_write_bbvari_by_name, RM_BLACKBOARD_WRITE_BBVARI_BY_NAME_CMD, 0 },
-    /* 142 */{ Func_undefined, 0, 0 },
-    /* 143 */{ Func_undefined, 0, 0 },
-    /* 144 */{ Func_undefined, 0, 0 },
+    /* 142 */{ Func_SyncBlackboardValues, RM_BLACKBOARD_SYNC_VALUES_CMD, 0 },
+    /* 143 */{ Func_BlackboardBatch, RM_BLACKBOARD_BATCH_CMD, 0 },
+    /* 144 */{ Func_add_bbvari_pid_type_frame, RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_CMD, 0 },
     /* 145 */{ Func_undefined, 0, 0 },
     /* 146 */{ Func_undefined, 0, 0 },
     /* 147 */{ Func_undefined, 0, 0 },
@@ -1762,7 +1908,7 @@ struct ENTRY_FUNC_PTR FuntionPointerTable[] = {
     /* 175 */{ Func_DelBehindProcessEquations, RM_SCHEDULER_DEL_BEHIND_PROCESS_EQUATIONS_CMD, 0 },
     /* 176 */{ Func_IsRealtimeProcessPid, RM_SCHEDULER_IS_REALTIME_PROCESS_PID_CMD, 0 },
     /* 177 */{ Func_ResetProcessMinMaxRuntimeMeasurement, RM_RESET_PROCESS_MIN_MAX_RUNTIME_MEASUREMENT_CMD, 0 },
-    /* 178 */{ Func_undefined, 0, 0 },
+    /* 178 */{ Func_GetLatencyHistograms, RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_CMD, 0 },
     /* 179 */{ Func_undefined, 0, 0 },
     /* 180 */{ Func_undefined, 0, 0 },
     /* 181 */{ Func_undefined, 0, 0 },
@@ -1838,7 +1984,7 @@ struct ENTRY_FUNC_PTR FuntionPointerTable[] = {
     /* 251 */{ Func_UnRegisterRxFiFo, RM_UNREGISTER_RX_FIFO_CMD, 0 },
 	/* 252 */{ Func_RxAttachFiFo, RM_RX_ATTACH_FIFO_CMD, 0 },
 	/* 253 */{ Func_SyncFiFos, RM_SYNC_FIFOS_CMD, 0 },
-	/* 254 */{ Func_undefined, 0, 0 },
+	/* 254 */{ Func_SyncFiFosCoded, RM_SYNC_FIFOS_CODED_CMD, 0 },
 	/* 255 */{ Func_undefined, 0, 0 },
 	/* 256 */{ Func_undefined, 0, 0 },
 	/* 257 */{ Func_undefined, 0, 0 },
@@ -27,6 +27,7 @@
 #include "StringMaxChar.h"
 #include "Blackboard.h"
 #include "BlackboardAccess.h"
+#include "AtomicAccess.h"
 #include "RealtimeScheduler.h"
 #include "ThrowError.h"
 #include "StructsRM_Blackboard.h"  // ony for READ_ALL_INFOS_BBVARI_FROM_INI
@@ -176,7 +177,7 @@ void add_vari_ref_list(void *ptr, int vid, unsigned int Flags)
                 egs_bbvari_refarray[x].vid = vid;
                 egs_bbvari_refarray[x].ptr = ptr;
                 egs_bbvari_refarray[x].flags = Flags;
-                egs_bbvari_refarray[x].overwrite_flag = 0;
+                egs_bbvari_refarray[x].wrseq = 0;
                 egs_bbvari_refarray[x].overwrite_value.uqw = 0;
                 type = get_bbvaritype(vid);
                 switch (type) {
@@ -215,7 +216,7 @@ void add_vari_ref_list(void *ptr, int vid, unsigned int Flags)
             egs_bbvari_refarray[x].vid = 0;
             egs_bbvari_refarray[x].ptr = NULL;
             egs_bbvari_refarray[x].flags = 0;
-            egs_bbvari_refarray[x].overwrite_flag = 0;
+            egs_bbvari_refarray[x].wrseq = 0;
             egs_bbvari_refarray[x].overwrite_value.uqw = 0;
             egs_bbvari_refarray[x].size = 0;
         }
@@ -234,7 +235,7 @@ int dereference_var(void *ptr, int vid)
                 egs_bbvari_refarray[x].ptr = NULL;
                 egs_bbvari_refarray[x].vid = -1;
                 egs_bbvari_refarray[x].flags = 0;
-                egs_bbvari_refarray[x].overwrite_flag = 0;
+                egs_bbvari_refarray[x].wrseq = 0;
                 egs_bbvari_refarray[x].overwrite_value.uqw = 0;
                 egs_bbvari_refarray[x].size = 0;
                 return 0;  // OK
@@ -968,16 +969,16 @@ void copy_vari_egs_bb(void)
     int x;
     int vid_index;
     BB_VARIABLE *pvari;
-    uint64_t wrflag;
+    int pid_index;
+    uint64_t pid_mask;
 #ifdef RUNTIME_MEASUREMENT
     uint64_t Start;
     Runtime_copy_vari_egs_bb = Runtime_copy_vari_egs_bb_x;
     Start = MyTimeStamp();
 #endif
-    //if (wrflag == 0) get_free_wrflag (extp_pid, &wrflag);
     if (egs_bbvari_refarray != NULL) {   // es wurden keine Variablen referenziert
-        get_free_wrflag(GET_PID(), &wrflag);
-        if (1) { // (pid_index = get_process_index(process_identifier)) != -1) {
+        if ((pid_index = get_process_index(GET_PID())) != -1) {
+            pid_mask = 1ULL << pid_index;
             EnterBlackboardCriticalSection();
             for (x = 0; x < egs_bbvari_size; x++) {
 #ifdef PREFETCH_BLACKBOARD_TO_CACHE
@@ -995,41 +996,41 @@ void copy_vari_egs_bb(void)
                     vid_index = (int)(egs_bbvari_refarray[x].vid >> 8);
                     pvari = &blackboard[vid_index];
                     if (pvari->Vid == egs_bbvari_refarray[x].vid) {
-                        if (pvari->AccessFlags &
-                            pvari->WrEnableFlags & wrflag) {
-                            // Only copy if an oter process has written
-                            if ((pvari->WrFlags & wrflag) == 0) {
+                        if (BB_ACCESS_FLAGS(vid_index) &
+                            pvari->WrEnableFlags & pid_mask) {
+                            // Only copy if no other process has written meanwhile
+                            if (BB_WR_SEQ(vid_index) == egs_bbvari_refarray[x].wrseq) {
                                 if ((egs_bbvari_refarray[x].flags & REF_ONLY_WRITE_FLAG) == REF_ONLY_WRITE_FLAG) {
-                                    switch (pvari->Type) {
+                                    switch (BB_TYPE(vid_index)) {
                                     case BB_BYTE:
-                                        pvari->Value.b = *(int8_t*)egs_bbvari_refarray[x].ptr;
+                                        BB_VALUE(vid_index).b = *(int8_t*)egs_bbvari_refarray[x].ptr;
                                         break;
                                     case BB_UBYTE:
-                                        pvari->Value.ub = *(uint8_t*)egs_bbvari_refarray[x].ptr;
+                                        BB_VALUE(vid_index).ub = *(uint8_t*)egs_bbvari_refarray[x].ptr;
                                         break;
                                     case BB_WORD:
-                                        pvari->Value.w = *(int16_t*)egs_bbvari_refarray[x].ptr;
+                                        BB_VALUE(vid_index).w = *(int16_t*)egs_bbvari_refarray[x].ptr;
                                         break;
                                     case BB_UWORD:
-                                        pvari->Value.uw = *(uint16_t*)egs_bbvari_refarray[x].ptr;
+                                        BB_VALUE(vid_index).uw = *(uint16_t*)egs_bbvari_refarray[x].ptr;
                                         break;
                                     case BB_DWORD:
-                                        pvari->Value.dw = *(int32_t*)egs_bbvari_refarray[x].ptr;
+                                        BB_VALUE(vid_index).dw = *(int32_t*)egs_bbvari_refarray[x].ptr;
                                         break;
                                     case BB_UDWORD:
-                                        pvari->Value.udw = *(uint32_t*)egs_bbvari_refarray[x].ptr;
+                                        BB_VALUE(vid_index).udw = *(uint32_t*)egs_bbvari_refarray[x].ptr;
                                         break;
                                     case BB_FLOAT:
-                                        pvari->Value.f = *(float*)egs_bbvari_refarray[x].ptr;
+                                        BB_VALUE(vid_index).f = *(float*)egs_bbvari_refarray[x].ptr;
                                         break;
                                     case BB_DOUBLE:
-                                        pvari->Value.d = *(double*)egs_bbvari_refarray[x].ptr;
+                                        BB_VALUE(vid_index).d = *(double*)egs_bbvari_refarray[x].ptr;
                                         break;
                                     }
-                                    pvari->WrFlags = ALL_WRFLAG_MASK;
+                                    INC_BB_WR_SEQ(vid_index);
                                 }
                                 else {
-                                    pvari->WrFlags = ALL_WRFLAG_MASK;
+                                    INC_BB_WR_SEQ(vid_index);
                                 }
                             }
                         }
@@ -1048,18 +1049,14 @@ void copy_vari_egs_bb(void)
 void copy_vari_bb_egs(void)
 {
     int x;
-    int vid_index, pid_index;
+    int vid_index;
     BB_VARIABLE *pvari;
-    uint64_t wrflag, wrflag_neg;
 #ifdef RUNTIME_MEASUREMENT
     uint64_t Start;
     Start = MyTimeStamp();
 #endif
     if (egs_bbvari_refarray != NULL) {   // There are no referenced variables
-        get_free_wrflag(GET_PID(), &wrflag);
-
         if (1) {
-            wrflag_neg = ~wrflag;
             EnterBlackboardCriticalSection();
             for (x = 0; x < egs_bbvari_size; x++) {
 #ifdef PREFETCH_BLACKBOARD_TO_CACHE
@@ -1079,37 +1076,37 @@ void copy_vari_bb_egs(void)
                     // Vid match
                     if (pvari->Vid == egs_bbvari_refarray[x].vid) {
                         if ((egs_bbvari_refarray[x].flags & REF_ONLY_READ_FLAG) == REF_ONLY_READ_FLAG) {
-                            // Reset own WR flag to check if an other process has write to the variable meanwhile
-                            pvari->WrFlags &= wrflag_neg;
-                            switch (pvari->Type) {
+                            // Remember the write sequence number to check if an other process has write to the variable meanwhile
+                            egs_bbvari_refarray[x].wrseq = BB_WR_SEQ(vid_index);
+                            switch (BB_TYPE(vid_index)) {
                             case BB_BYTE:
-                                *(int8_t*)egs_bbvari_refarray[x].ptr = pvari->Value.b;
+                                *(int8_t*)egs_bbvari_refarray[x].ptr = BB_VALUE(vid_index).b;
                                 break;
                             case BB_UBYTE:
-                                *(uint8_t*)egs_bbvari_refarray[x].ptr = pvari->Value.ub;
+                                *(uint8_t*)egs_bbvari_refarray[x].ptr = BB_VALUE(vid_index).ub;
                                 break;
                             case BB_WORD:
-                                *(int16_t*)egs_bbvari_refarray[x].ptr = pvari->Value.w;
+                                *(int16_t*)egs_bbvari_refarray[x].ptr = BB_VALUE(vid_index).w;
                                 break;
                             case BB_UWORD:
-                                *(uint16_t*)egs_bbvari_refarray[x].ptr = pvari->Value.uw;
+                                *(uint16_t*)egs_bbvari_refarray[x].ptr = BB_VALUE(vid_index).uw;
                                 break;
                             case BB_DWORD:
-                                *(int32_t*)egs_bbvari_refarray[x].ptr = pvari->Value.dw;
+                                *(int32_t*)egs_bbvari_refarray[x].ptr = BB_VALUE(vid_index).dw;
                                 break;
                             case BB_UDWORD:
-                                *(uint32_t*)egs_bbvari_refarray[x].ptr = pvari->Value.udw;
+                                *(uint32_t*)egs_bbvari_refarray[x].ptr = BB_VALUE(vid_index).udw;
                                 break;
                             case BB_FLOAT:
-                                *(float*)egs_bbvari_refarray[x].ptr = pvari->Value.f;
+                                *(float*)egs_bbvari_refarray[x].ptr = BB_VALUE(vid_index).f;
                                 break;
                             case BB_DOUBLE:
-                                *(double*)egs_bbvari_refarray[x].ptr = pvari->Value.d;
+                                *(double*)egs_bbvari_refarray[x].ptr = BB_VALUE(vid_index).d;
                                 break;
                             }
                         }
                         else {
-                            pvari->WrFlags &= wrflag_neg;
+                            egs_bbvari_refarray[x].wrseq = BB_WR_SEQ(vid_index);
                         }
                     }
                 }
@@ -27,7 +27,7 @@ typedef struct {
 #define REF_ONLY_WRITE_FLAG  2
 #define REF_READ_WRITE_FLAG  3
 /*08*/  union BB_VARI overwrite_value;
-/*04*/  unsigned int overwrite_flag;
+/*04*/  uint32_t wrseq;    // write sequence number of the variable at copy_vari_bb_egs()
 /*04*/  unsigned int size;   // damit Strukturgrsse 2^n
 } EGS_BBVARI_REFLIST;
 
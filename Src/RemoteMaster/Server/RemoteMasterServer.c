@@ -42,6 +42,7 @@
 #include "RemoteMasterReqToClient.h"
 #include "CanFifo.h"
 #include "RemoteMasterDecoder.h"
+#include "RemoteMasterBlackboardSync.h"
 
 #include "RemoteMasterServer.h"
 
@@ -105,20 +106,21 @@ void *connection_handler(void *socket_desc)
     }
 
 	printf("connection_handler() running on cpu %i\n", sched_getcpu());
+	buffer_pos = 0;
 	while (1) {
-		buffer_pos = 0;
+		// Receive till at least one complete message is inside the buffer
 		receive_message_size = 0;
-		do {
+		while ((buffer_pos < (int)sizeof(receive_message_size)) ||
+		       (buffer_pos < (int)(receive_message_size = *(uint32_t*)receive_buffer))) {
             len = recv(sock, receive_buffer + buffer_pos, BUFFER_SIZE - buffer_pos, MSG_NOSIGNAL); // 0);
 			if (len > 0) {
 				buffer_pos += len;
-				if (receive_message_size == 0) {
-					receive_message_size = *(uint32_t*)receive_buffer;
-				}
 			} else {
-                ThrowError(1, "Failed receiving\n");
+                if (len < 0) ThrowError(1, "Failed receiving\n");
+                receive_message_size = 0;
+                break;
 			}
-        } while (buffer_pos < (int)receive_message_size);
+        }
 
         if (receive_message_size == 0) {
             printf("connection closed\n");
@@ -163,12 +165,14 @@ void *connection_handler(void *socket_desc)
                 goto __OUT;  // terminate thread
 			}
             buffer_pos2 += receive_message_size;   // Switch to the next message
-            if (buffer_pos2 + (int)sizeof(receive_message_size) >= (buffer_pos)) break;
+            if (buffer_pos2 + (int)sizeof(receive_message_size) > (buffer_pos)) break;
 			receive_message_size = *(uint32_t*)(receive_buffer + buffer_pos2); 
-        } while ((buffer_pos2 + (int)receive_message_size) <= buffer_pos);
+        } while ((receive_message_size > 0) && ((buffer_pos2 + (int)receive_message_size) <= buffer_pos));
+		// The beginning of the next message (pipelined requests) will be completed with the next recv()
 		if (buffer_pos2 != buffer_pos) {
-			printf("there is something left in the buffer\n");
+			memmove(receive_buffer, receive_buffer + buffer_pos2, (size_t)(buffer_pos - buffer_pos2));
 		}
+		buffer_pos -= buffer_pos2;
     }
  __OUT:
     free(receive_buffer);
@@ -192,6 +196,7 @@ int inner_main(int argc , char *argv[])
     signal(SIGPIPE, SIG_IGN);
 
 	InitCANFifoCriticalSection();
+    InitBlackboardValueSync();
 
     //Create socket
     socket_desc = socket(AF_INET , SOCK_STREAM , 0);
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "RemoteMasterLock.h"
+#include "LatencyHistogram.h"
 
 typedef struct {
     int size;              /* Size of the message buffer */
@@ -73,6 +74,9 @@ typedef struct TCB {                 // Task control block
     int BehindProcessEquationCounter;
     PROC_EXEC_STACK *BehindProcessEquations;
 
+    // Distribution of the runtime (will be initialized if the process is started)
+    int VidRuntimeP99;
+    LATENCY_HISTOGRAM RuntimeHistogram;
 } TASK_CONTROL_BLOCK;
 
 #define INIT_TASK_COTROL_BLOCK(name, type, priority, cyclic_function, init_function, terminate_function, message_queue_size) \
@@ -104,6 +108,8 @@ typedef struct TCB {                 // Task control block
         0,                        /* BeforeProcessEquationCounter */ \
         NULL,                     /* BeforeProcessEquations */ \
         0,                        /* BehindProcessEquationCounter */ \
-        NULL                      /* BehindProcessEquations */ \
+        NULL,                     /* BehindProcessEquations */ \
+        0,                        /* VidRuntimeP99 */ \
+        {{0}, 0, 0, 0, 0, 0}      /* RuntimeHistogram */ \
     }
 
@@ -34,6 +34,7 @@ typedef struct {
     int64_t PreAllocMemorySize;
     int32_t PidForSchedulersHelperProcess;
     uint32_t OffsetConfigurablePrefix[32];
+    uint32_t SyncFiFoCodings;    // FIFO_SYNC_xxx codings the client would use
     // now the data folowing
 }  RM_INIT_REQ;
 
@@ -42,6 +43,7 @@ typedef struct {
     uint32_t Version;
     int32_t PatchVersion;  // negative are pre releases
     int32_t Ret;
+    uint32_t SyncFiFoCodings;    // FIFO_SYNC_xxx codings supported by both sides
 }  RM_INIT_ACK;
 
 #define RM_TERMINATE_CMD  (2)
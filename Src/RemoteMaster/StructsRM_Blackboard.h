@@ -445,41 +445,44 @@ typedef struct {
     int32_t prec;
 }  RM_BLACKBOARD_GET_BBVARI_FORMAT_PREC_ACK;
 
-#define RM_BLACKBOARD_GET_FREE_WRFLAG_CMD  (RM_BLACKBOARD_OFFSET+32)
+#define RM_BLACKBOARD_GET_BBVARI_WRSEQ_CMD  (RM_BLACKBOARD_OFFSET+32)
 typedef struct {
     RM_PACKAGE_HEADER PackageHeader;
-    int32_t Pid;
-}  RM_BLACKBOARD_GET_FREE_WRFLAG_REQ;
+    int32_t Vid;
+}  RM_BLACKBOARD_GET_BBVARI_WRSEQ_REQ;
 
 typedef struct {
     RM_PACKAGE_HEADER PackageHeader;
-    uint64_t wrflag;
-    int32_t Ret;
-}  RM_BLACKBOARD_GET_FREE_WRFLAG_ACK;
+    uint32_t WrSeq;
+}  RM_BLACKBOARD_GET_BBVARI_WRSEQ_ACK;
 
-#define RM_BLACKBOARD_RESET_WRFLAG_CMD  (RM_BLACKBOARD_OFFSET+33)
+#define RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_CMD  (RM_BLACKBOARD_OFFSET+33)
 typedef struct {
     RM_PACKAGE_HEADER PackageHeader;
-    int32_t Vid;
-    uint64_t w;
-}  RM_BLACKBOARD_RESET_WRFLAG_REQ;
+    uint32_t OffsetVids;
+    int32_t Number;
+    // ... followed by the Vids
+}  RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_REQ;
 
 typedef struct {
     RM_PACKAGE_HEADER PackageHeader;
+    uint32_t OffsetWrSeqs;
     int32_t Ret;
-}  RM_BLACKBOARD_RESET_WRFLAG_ACK;
+    // ... followed by the write sequence numbers
+}  RM_BLACKBOARD_GET_BBVARI_WRSEQ_FRAME_ACK;
 
-#define RM_BLACKBOARD_TEST_WRFLAG_CMD  (RM_BLACKBOARD_OFFSET+34)
+#define RM_BLACKBOARD_TEST_BBVARI_WRSEQ_CMD  (RM_BLACKBOARD_OFFSET+34)
 typedef struct {
     RM_PACKAGE_HEADER PackageHeader;
     int32_t Vid;
-    uint64_t w;
-}  RM_BLACKBOARD_TEST_WRFLAG_REQ;
+    uint32_t WrSeq;
+}  RM_BLACKBOARD_TEST_BBVARI_WRSEQ_REQ;
 
 typedef struct {
     RM_PACKAGE_HEADER PackageHeader;
+    uint32_t WrSeq;
     int32_t Ret;
-}  RM_BLACKBOARD_TEST_WRFLAG_ACK;
+}  RM_BLACKBOARD_TEST_BBVARI_WRSEQ_ACK;
 
 #define RM_BLACKBOARD_READ_NEXT_BLACKBOARD_VARI_CMD  (RM_BLACKBOARD_OFFSET+35)
 typedef struct {
@@ -1178,6 +1181,86 @@ typedef struct {
 
 // End new  XXXXXXXXXXXXXXXX
 
+// Cycle aligned exchange of the changed values (delta blocks, see BlackboardDeltaCoding.h)
+#define RM_BLACKBOARD_SYNC_VALUES_CMD  (RM_RD_WR_BLACKBOARD_OFFSET+42)
+typedef struct {
+    RM_PACKAGE_HEADER PackageHeader;
+    int32_t WritePid;
+    uint32_t Flags;
+#define RM_SYNC_VALUES_RESET_SUBSCRIPTIONS  0x1
+    uint32_t OffsetSubscribeVids;
+    int32_t SubscribeCount;
+    uint32_t OffsetWrites;
+    uint32_t LenWrites;
+    uint32_t MaxLenValues;
+    uint32_t Fill1;
+    // ... followed by the vids which should be (re)transmitted complete
+    // ... than the delta block with the values written by the client
+} RM_BLACKBOARD_SYNC_VALUES_REQ;
+
+typedef struct {
+    RM_PACKAGE_HEADER PackageHeader;
+    uint32_t OffsetValues;
+    uint32_t LenValues;
+    int32_t Ret;
+    int32_t Fill1;
+    // ... followed by the delta block with the changed values
+} RM_BLACKBOARD_SYNC_VALUES_ACK;
+
+// Execute several blackboard requests with one round trip
+#define RM_BLACKBOARD_BATCH_CMD  (RM_RD_WR_BLACKBOARD_OFFSET+43)
+typedef struct {
+    RM_PACKAGE_HEADER PackageHeader;
+    uint32_t OffsetRequests;
+    int32_t Count;
+    // ... followed by the complete requests (each 8 byte aligned)
+} RM_BLACKBOARD_BATCH_REQ;
+
+typedef struct {
+    RM_PACKAGE_HEADER PackageHeader;
+    uint32_t OffsetAcks;
+    int32_t Ret;   // number of executed requests
+    // ... followed by the complete acks (each 8 byte aligned)
+} RM_BLACKBOARD_BATCH_ACK;
+
+#define RM_BATCH_ALIGN(x)  (((x) + 7) & ~7)
+// The client must split larger batches (sum of all acks), the server will stop executing behind it
+#define RM_BATCH_MAX_ACK_SIZE  (512*1024)
+
+// Register several variables with one request
+#define RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_CMD  (RM_RD_WR_BLACKBOARD_OFFSET+44)
+typedef struct {
+    RM_PACKAGE_HEADER PackageHeader;
+    int32_t Pid;
+    int32_t Count;
+    uint32_t OffsetEntries;
+    uint32_t Fill1;
+    // ... followed by the entries (each 8 byte aligned)
+} RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_REQ;
+
+typedef struct {
+    uint32_t SizeOf;        // size of the entry including the strings
+    uint32_t Type;
+    uint32_t Dir;
+    int32_t ValueValidFlag;
+    uint64_t ValueUnion;
+    uint32_t ReadReqMask;
+    uint32_t UnitOffset;    // relative to the entry, 0 if there is no unit
+    // ... followed by the name string and than the unit string
+} RM_BLACKBOARD_ADD_BBVARI_FRAME_ENTRY;
+
+typedef struct {
+    RM_PACKAGE_HEADER PackageHeader;
+    int32_t Ret;            // number of processed entries
+    uint32_t OffsetVids;
+    uint32_t OffsetTypes;
+    uint32_t Fill1;
+    // ... followed by the vids (or error codes) and the types of all entries
+} RM_BLACKBOARD_ADD_BBVARI_PID_TYPE_FRAME_ACK;
+
+// The client must split larger frames
+#define RM_ADD_BBVARI_FRAME_MAX_REQ_SIZE  (32*1024)
+
 // vom Remote Master zum Client
 #define RM_BLACKBOARD_WRITE_BBVARI_INFOS_CMD  (RM_RD_WR_BLACKBOARD_OFFSET+200)
 typedef struct {
@@ -77,3 +77,25 @@ typedef struct {
     // ... danach kommen die Daten
 }  RM_SYNC_FIFOS_ACK;
 
+// Same as RM_SYNC_FIFOS_CMD but the data are coded (see FifoSyncCoding.h),
+// will be only used if both sides support it (negotiated with RM_INIT_CMD)
+#define RM_SYNC_FIFOS_CODED_CMD  (RM_FIFO_OFFSET+4)
+typedef struct {
+    RM_PACKAGE_HEADER PackageHeader;
+    uint32_t Len;
+    uint32_t Offset_Buffer;
+    uint32_t Coding;            // FIFO_SYNC_xxx codings used for the data
+    uint32_t RawLen;            // length of the data before coding
+    uint32_t AcceptedCodings;   // FIFO_SYNC_xxx codings that can be used for the answer
+    // ... danach kommen die Daten
+}  RM_SYNC_FIFOS_CODED_REQ;
+
+typedef struct {
+    RM_PACKAGE_HEADER PackageHeader;
+    int32_t Len;
+    uint32_t Offset_Buffer;
+    int32_t Ret;
+    uint32_t Coding;
+    int32_t RawLen;
+    // ... danach kommen die Daten
+}  RM_SYNC_FIFOS_CODED_ACK;
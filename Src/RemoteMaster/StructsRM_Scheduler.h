@@ -273,6 +273,19 @@ typedef struct {
     int32_t Ret;
 }  RM_RESET_PROCESS_MIN_MAX_RUNTIME_MEASUREMENT_ACK;
 
+#define RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_CMD  (RM_SCHEDULER_OFFSET+18)
+typedef struct {
+    RM_PACKAGE_HEADER PackageHeader;
+    int32_t maxc;
+}  RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_REQ;
+
+typedef struct {
+    RM_PACKAGE_HEADER PackageHeader;
+    int32_t Ret;
+    uint32_t Offset_Text;
+    // ... followed by the text
+}  RM_SCHEDULER_GET_LATENCY_HISTOGRAMS_ACK;
+
 
 // From remote master to client
 #define RM_SCHEDULER_CYCLIC_EVENT_CMD  (RM_SCHEDULER_OFFSET+200)
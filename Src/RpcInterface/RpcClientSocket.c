@@ -46,6 +46,7 @@
 #include "PrintFormatToString.h"
 #include "RpcFuncBase.h"
 #include "RpcFuncLogin.h"
+#include "RpcSharedMemory.h"
 #include "RpcClientSocket.h"
 
 #ifdef __linux__ 
@@ -62,6 +63,8 @@
     #error "no target defined"
 #endif
 
+#define UNUSED(x) (void)(x)
+
 #define MAX_RPC_THREAD_BUFFERS  64
 static struct {
     unsigned int ThreadId;
@@ -86,6 +89,11 @@ static pthread_mutex_t RpcMutex = PTHREAD_MUTEX_INITIALIZER;
 #endif
 static int RpcMutexInitFlag;
 
+#ifndef _WIN32
+// If not NULL all messages will be transfered through this shared memory instead of the socket
+static RPC_SHM_CHANNEL *SharedMemoryChannel;
+#endif
+
 static void InitMutex()
 {
     if (!RpcMutexInitFlag) {
@@ -355,6 +363,12 @@ HANDLE UnixDomainSocketConnectToRemoteProcedureCallServer(const char *par_Server
 
 void DisconnectFromRemoteProcedureCallServer(int par_SocketOrNamedPipe, HANDLE Socket)
 {
+#ifndef _WIN32
+    if (SharedMemoryChannel != NULL) {
+        RpcShmClose(SharedMemoryChannel);
+        SharedMemoryChannel = NULL;
+    }
+#endif
     if (par_SocketOrNamedPipe) {
         closesocket((SOCKET)Socket);
 #ifdef _WIN32
@@ -372,6 +386,13 @@ int SentToRemoteProcedureCallServer (int par_SocketOrNamedPipe, HANDLE par_Socke
 
     par_Req->StructSize = par_PackageSize;
     par_Req->Command = par_Command;
+#ifndef _WIN32
+    if (SharedMemoryChannel != NULL) {
+        UNUSED(par_SocketOrNamedPipe);
+        UNUSED(par_Socket);
+        return (RpcShmWrite(SharedMemoryChannel, RPC_SHM_CLIENT_TO_SERVER, par_Req, par_PackageSize) == par_PackageSize) ? 0 : -1;
+    }
+#endif
     do {
         int SendBytes;
 #ifdef _WIN32
@@ -396,11 +417,48 @@ int SentToRemoteProcedureCallServer (int par_SocketOrNamedPipe, HANDLE par_Socke
     return 0;
 }
 
+#ifndef _WIN32
+static int ReceiveFromSharedMemory (RPC_API_BASE_MESSAGE_ACK *ret_Data, int par_len)
+{
+    int receive_message_size;
+    int Len;
+    if (RpcShmRead(SharedMemoryChannel, RPC_SHM_SERVER_TO_CLIENT, ret_Data, sizeof(RPC_API_BASE_MESSAGE_ACK)) < 0) {
+        return -1;
+    }
+    receive_message_size = ret_Data->StructSize;
+    if (receive_message_size < (int)sizeof(RPC_API_BASE_MESSAGE_ACK)) {
+        return -1;
+    }
+    Len = receive_message_size;
+    if (Len > par_len) Len = par_len;
+    if (RpcShmRead(SharedMemoryChannel, RPC_SHM_SERVER_TO_CLIENT, (char*)ret_Data + sizeof(RPC_API_BASE_MESSAGE_ACK),
+                   Len - (int)sizeof(RPC_API_BASE_MESSAGE_ACK)) < 0) {
+        return -1;
+    }
+    // if the buffer is to small throw away the rest of the message to stay in sync
+    while (Len < receive_message_size) {
+        char Discard[256];
+        int Part = receive_message_size - Len;
+        if (Part > (int)sizeof(Discard)) Part = (int)sizeof(Discard);
+        if (RpcShmRead(SharedMemoryChannel, RPC_SHM_SERVER_TO_CLIENT, Discard, Part) < 0) {
+            return -1;
+        }
+        Len += Part;
+    }
+    return receive_message_size;
+}
+#endif
+
 static int ReceiveFromRemoteProcedureCallServer (int par_SocketOrNamedPipe, HANDLE par_Socket, RPC_API_BASE_MESSAGE_ACK *ret_Data, int par_len)
 {
     int receive_message_size = 0;
     int buffer_pos = 0;
     receive_message_size = 0;
+#ifndef _WIN32
+    if (SharedMemoryChannel != NULL) {
+        return ReceiveFromSharedMemory(ret_Data, par_len);
+    }
+#endif
     do {
         int ReadBytes;
 __RETRAY:
@@ -497,6 +555,26 @@ int ReceiveFromRemoteProcedureCallServerDynBuf (int par_SocketOrNamedPipe, HANDL
     dyn_buffer = (char*)RemoteProcedureGetReceiveBuffer(sizeof(RPC_API_BASE_MESSAGE_ACK));
     if (dyn_buffer == NULL) return -1;
 
+#ifndef _WIN32
+    if (SharedMemoryChannel != NULL) {
+        if (RpcShmRead(SharedMemoryChannel, RPC_SHM_SERVER_TO_CLIENT, dyn_buffer, sizeof(RPC_API_BASE_MESSAGE_ACK)) < 0) {
+            return -1;
+        }
+        receive_message_size = *(uint32_t*)dyn_buffer;
+        if (receive_message_size < (int)sizeof(RPC_API_BASE_MESSAGE_ACK)) {
+            return -1;
+        }
+        dyn_buffer = (char*)RemoteProcedureGetReceiveBuffer(receive_message_size);
+        if (dyn_buffer == NULL) return -1;
+        if (RpcShmRead(SharedMemoryChannel, RPC_SHM_SERVER_TO_CLIENT, dyn_buffer + sizeof(RPC_API_BASE_MESSAGE_ACK),
+                       receive_message_size - (int)sizeof(RPC_API_BASE_MESSAGE_ACK)) < 0) {
+            return -1;
+        }
+        *ret_ptrToData = (RPC_API_BASE_MESSAGE_ACK*)dyn_buffer;
+        return receive_message_size;
+    }
+#endif
+
     // First read only the header
     do {
         int ReadBytes;
@@ -588,7 +666,51 @@ int RemoteProcedureCallTransactDynBuf (int par_SocketOrNamedPipe, HANDLE par_Soc
     return -1;
 }
 
-#define UNUSED(x) (void)(x)
+int SwitchRemoteProcedureCallToSharedMemory (int par_SocketOrNamedPipe, HANDLE par_Socket)
+{
+#ifdef _WIN32
+    UNUSED(par_SocketOrNamedPipe);
+    UNUSED(par_Socket);
+    return -1;  // not supported
+#else
+    RPC_API_OPEN_SHARED_MEMORY_MESSAGE *Req;
+    RPC_API_OPEN_SHARED_MEMORY_MESSAGE_ACK Ack;
+    RPC_SHM_CHANNEL *Channel;
+    size_t Len;
+    size_t Size;
+    int Ret;
+
+    if (SharedMemoryChannel != NULL) return 0;   // already switched
+    Channel = RpcShmCreate((uint64_t)par_Socket);
+    if (Channel == NULL) return -1;
+
+    Len = strlen(Channel->Name) + 1;
+    Size = sizeof(*Req) + Len;
+    Req = (RPC_API_OPEN_SHARED_MEMORY_MESSAGE*)RemoteProcedureGetTransmitBuffer((int)Size);
+    if (Req == NULL) {
+        RpcShmUnlink(Channel);
+        RpcShmClose(Channel);
+        return -1;
+    }
+    MEMSET(Req, 0, Size);
+    Req->Version = RPC_SHM_VERSION;
+    Req->RingSize = RPC_SHM_RING_SIZE;
+    Req->OffsetName = (int32_t)sizeof(*Req) - 1;
+    MEMCPY (Req->Data, Channel->Name, Len);
+    // the ack will be received through the socket
+    Ret = RemoteProcedureCallTransact(par_SocketOrNamedPipe, par_Socket, RPC_API_OPEN_SHARED_MEMORY_CMD, &(Req->Header), (int)Size, &(Ack.Header), sizeof(Ack));
+    // the server has mapped it (or not), the name is not needed anymore
+    RpcShmUnlink(Channel);
+    if ((Ret != sizeof(Ack)) || (Ack.Header.ReturnValue != 0)) {
+        RpcShmClose(Channel);
+        return -1;
+    }
+    LockMutex();
+    SharedMemoryChannel = Channel;
+    UnlockMutex();
+    return 0;
+#endif
+}
 
 void *__my_malloc (const char * const file, int line, size_t size)
 {
@@ -40,6 +40,10 @@ int RemoteProcedureCallTransact (int par_SocketOrNamedPipe, HANDLE par_Socket, u
 void *RemoteProcedureGetReceiveBuffer(int par_NeededSize);
 void *RemoteProcedureGetTransmitBuffer(int par_NeededSize);
 
+// Try to switch an already logged in connection to a shared memory transport (only local connections).
+// Return 0 if switched, otherwise the connection will stay on the socket.
+int SwitchRemoteProcedureCallToSharedMemory (int par_SocketOrNamedPipe, HANDLE par_Socket);
+
 int RemoteProcedureCallTransactDynBuf (int par_SocketOrNamedPipe, HANDLE par_Socket, int par_Command, RPC_API_BASE_MESSAGE *par_TransmitData, int par_BytesToTransmit, RPC_API_BASE_MESSAGE_ACK **ret_ReceiveData);
 
 #endif
@@ -175,6 +175,7 @@ SCRPCDLL_API int __STDCALL__ XilEnv_ConnectToInstance(const char* NetAddr, const
 {
     int Ret;
     char *p;
+    int UseSharedMemory = 0;
     RPC_API_LOGIN_MESSAGE Req = {0};
     RPC_API_LOGIN_MESSAGE_ACK Ack;
 
@@ -190,6 +191,10 @@ SCRPCDLL_API int __STDCALL__ XilEnv_ConnectToInstance(const char* NetAddr, const
     } else if ((NetAddr[0] == 'S') && (NetAddr[1] == ':')) {
         SocketOrNamedPipe = 1;   // Sockets
         NetAddr += 2;
+    } else if ((NetAddr[0] == 'M') && (NetAddr[1] == ':')) {
+        SocketOrNamedPipe = 0;   // Login through named pipes or unix domain sockets than switch to shared memory
+        UseSharedMemory = 1;
+        NetAddr += 2;
     } else {
         SocketOrNamedPipe = 0;   // Named pipes or unix domain sockets
     }
@@ -224,6 +229,10 @@ SCRPCDLL_API int __STDCALL__ XilEnv_ConnectToInstance(const char* NetAddr, const
         XilEnv_DisconnectFrom();
         return -2; // Wrong version
     }
+    if (UseSharedMemory) {
+        // if this is not possible stay on the unix domain socket
+        SwitchRemoteProcedureCallToSharedMemory(SocketOrNamedPipe, Socket);
+    }
     return 0;
 }
 
@@ -126,6 +126,25 @@ typedef struct {
     RPC_API_PING_TO_CLINT_MESSAGE_ACK_MEMBERS
 } RPC_API_PING_TO_CLINT_MESSAGE_ACK;
 
+// Switch the connection to a shared memory transport (only for clients on the same machine).
+// The ack will be transmitted through the socket, all following messages through the shared memory.
+#define RPC_API_OPEN_SHARED_MEMORY_CMD               7
+typedef struct {
+#define RPC_API_OPEN_SHARED_MEMORY_MESSAGE_MEMBERS \
+    RPC_API_BASE_MESSAGE Header;\
+    int32_t Version;\
+    int32_t RingSize;\
+    int32_t OffsetName;\
+    char Data[1];  // > 1Byte!
+    RPC_API_OPEN_SHARED_MEMORY_MESSAGE_MEMBERS
+} RPC_API_OPEN_SHARED_MEMORY_MESSAGE;
+
+typedef struct {
+#define RPC_API_OPEN_SHARED_MEMORY_MESSAGE_ACK_MEMBERS \
+    RPC_API_BASE_MESSAGE_ACK Header;
+    RPC_API_OPEN_SHARED_MEMORY_MESSAGE_ACK_MEMBERS
+} RPC_API_OPEN_SHARED_MEMORY_MESSAGE_ACK;
+
 #pragma pack(pop)
 #ifdef _WIN32
 #ifdef __GNUC__
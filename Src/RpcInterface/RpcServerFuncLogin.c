@@ -21,6 +21,7 @@
 #include "StringMaxChar.h"
 #include "RpcSocketServer.h"
 #include "RpcFuncLogin.h"
+#include "RpcSharedMemory.h"
 
 #include "EquationParser.h"
 #include "ThrowError.h"
@@ -95,6 +96,32 @@ static int RPCFunc_ClientPingAck(RPC_CONNECTION *par_Connection, RPC_API_BASE_ME
     return 0;  // no response!
 }
 
+static int RPCFunc_OpenSharedMemory(RPC_CONNECTION *par_Connection, RPC_API_BASE_MESSAGE *par_DataIn, RPC_API_BASE_MESSAGE_ACK *par_DataOut)
+{
+    RPC_API_OPEN_SHARED_MEMORY_MESSAGE *In = (RPC_API_OPEN_SHARED_MEMORY_MESSAGE*)par_DataIn;
+    RPC_API_OPEN_SHARED_MEMORY_MESSAGE_ACK *Out = (RPC_API_OPEN_SHARED_MEMORY_MESSAGE_ACK*)par_DataOut;
+    MEMSET (Out, 0, sizeof (RPC_API_OPEN_SHARED_MEMORY_MESSAGE_ACK));
+    Out->Header.StructSize = sizeof(RPC_API_OPEN_SHARED_MEMORY_MESSAGE_ACK);
+#ifdef _WIN32
+    UNUSED(par_Connection);
+    UNUSED(In);
+    Out->Header.ReturnValue = -1;   // not supported, the client will stay on the named pipe
+#else
+    if ((par_Connection->SharedMemory != NULL) ||
+        (In->Version != RPC_SHM_VERSION) || (In->RingSize != RPC_SHM_RING_SIZE)) {
+        Out->Header.ReturnValue = -1;
+    } else {
+        par_Connection->SharedMemory = RpcShmOpen((char*)In + In->OffsetName, par_Connection->Socket);
+        if (par_Connection->SharedMemory == NULL) {
+            Out->Header.ReturnValue = -1;
+        } else {
+            Out->Header.ReturnValue = 0;
+        }
+    }
+#endif
+    return sizeof(RPC_API_OPEN_SHARED_MEMORY_MESSAGE_ACK);
+}
+
 int AddLoginFunctionToTable(void)
 {
     AddFunctionToRemoteAPIFunctionTable2(RPC_API_LOGIN_CMD, 0, RPCFunc_Login, sizeof(RPC_API_LOGIN_MESSAGE), sizeof(RPC_API_LOGIN_MESSAGE), STRINGIZE(RPC_API_LOGIN_MESSAGE_MEMBERS), STRINGIZE(RPC_API_LOGIN_MESSAGE_ACK_MEMBERS));
@@ -103,5 +130,6 @@ int AddLoginFunctionToTable(void)
     AddFunctionToRemoteAPIFunctionTable2(RPC_API_PING_CMD, 0, RPCFunc_Ping, sizeof(RPC_API_PING_MESSAGE), sizeof(RPC_API_PING_MESSAGE), STRINGIZE(RPC_API_PING_MESSAGE_MEMBERS), STRINGIZE(RPC_API_PING_MESSAGE_ACK_MEMBERS));
     AddFunctionToRemoteAPIFunctionTable2(RPC_API_SHOULD_BE_TERMINATED_CMD, 0, RPCFunc_ShouldBeTerminated, sizeof(RPC_API_SHOULD_BE_TERMINATED_MESSAGE), sizeof(RPC_API_SHOULD_BE_TERMINATED_MESSAGE), STRINGIZE(RPC_API_SHOULD_BE_TERMINATED_MESSAGE_MEMBERS), STRINGIZE(RPC_API_SHOULD_BE_TERMINATED_MESSAGE_ACK_MEMBERS));
     AddFunctionToRemoteAPIFunctionTable2(RPC_API_PING_TO_CLINT_CMD, 0, RPCFunc_ClientPingAck, sizeof(RPC_API_PING_TO_CLINT_MESSAGE), sizeof(RPC_API_PING_TO_CLINT_MESSAGE), STRINGIZE(RPC_API_PING_TO_CLINT_MESSAGE_MEMBERS), STRINGIZE(RPC_API_PING_TO_CLINT_MESSAGE_ACK_MEMBERS));
+    AddFunctionToRemoteAPIFunctionTable2(RPC_API_OPEN_SHARED_MEMORY_CMD, 0, RPCFunc_OpenSharedMemory, sizeof(RPC_API_OPEN_SHARED_MEMORY_MESSAGE), RPC_API_MAX_MESSAGE_SIZE, STRINGIZE(RPC_API_OPEN_SHARED_MEMORY_MESSAGE_MEMBERS), STRINGIZE(RPC_API_OPEN_SHARED_MEMORY_MESSAGE_ACK_MEMBERS));
     return 0;
 }
@@ -0,0 +1,271 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _WIN32
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "MemZeroAndCopy.h"
+#include "PrintFormatToString.h"
+#include "StringMaxChar.h"
+#include "RpcSharedMemory.h"
+
+// How often should be polled before going to sleep inside the kernel.
+// Most of the small commands are answered inside this time.
+#define RPC_SHM_SPIN_LOOPS   20000
+// Timeout of one futex wait, after that it will be checked if the other side is alive
+#define RPC_SHM_ALIVE_CHECK_TIMEOUT_MS  1000
+
+static uint32_t ShmUniqueCounter;
+static int SpinLoops = -1;
+
+static int FutexWait(volatile uint32_t *par_Address, uint32_t par_Value, int par_Timeout_ms)
+{
+    struct timespec Timeout;
+    Timeout.tv_sec = par_Timeout_ms / 1000;
+    Timeout.tv_nsec = (par_Timeout_ms % 1000) * 1000000;
+    // no FUTEX_PRIVATE_FLAG because the futex word is shared between two processes
+    return (int)syscall(SYS_futex, par_Address, FUTEX_WAIT, par_Value, &Timeout, NULL, 0);
+}
+
+static void FutexWake(volatile uint32_t *par_Address)
+{
+    syscall(SYS_futex, par_Address, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+static int IsOtherSideAlive(RPC_SHM_CHANNEL *par_Channel)
+{
+    char Byte;
+    int Ret = (int)recv((int)par_Channel->Socket, &Byte, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (Ret == 0) {
+        return 0;  // connection closed
+    }
+    if ((Ret < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+        return 0;  // connection broken
+    }
+    return 1;
+}
+
+// Wait until *par_Pos is not par_Value anymore.
+// Return 0 if changed or -1 if the other side is not alive anymore
+static int WaitForChange(RPC_SHM_CHANNEL *par_Channel, volatile uint32_t *par_Pos, volatile uint32_t *par_WaitingFlag, uint32_t par_Value)
+{
+    int x;
+    if (SpinLoops < 0) {
+        // spinning makes only sense if the other side can run at the same time
+        SpinLoops = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? RPC_SHM_SPIN_LOOPS : 0;
+    }
+    for (x = 0; x < SpinLoops; x++) {
+        if (__atomic_load_n(par_Pos, __ATOMIC_ACQUIRE) != par_Value) return 0;
+    }
+    for (;;) {
+        // The other side will check this flag after it has changed the position
+        __atomic_store_n(par_WaitingFlag, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(par_Pos, __ATOMIC_SEQ_CST) != par_Value) return 0;
+        if (FutexWait(par_Pos, par_Value, RPC_SHM_ALIVE_CHECK_TIMEOUT_MS) != 0) {
+            if ((errno == ETIMEDOUT) && !IsOtherSideAlive(par_Channel)) {
+                return -1;
+            }
+        }
+        if (__atomic_load_n(par_Pos, __ATOMIC_ACQUIRE) != par_Value) return 0;
+    }
+}
+
+static void WakeUpOtherSide(volatile uint32_t *par_Pos, volatile uint32_t *par_WaitingFlag)
+{
+    if (__atomic_load_n(par_WaitingFlag, __ATOMIC_SEQ_CST)) {
+        __atomic_store_n(par_WaitingFlag, 0, __ATOMIC_SEQ_CST);
+        FutexWake(par_Pos);
+    }
+}
+
+static RPC_SHM_CHANNEL *MapSharedMemory(int par_Fd, const char *par_Name, uint64_t par_Socket)
+{
+    RPC_SHM_CHANNEL *Ret;
+    void *Address;
+    size_t Size = sizeof(RPC_SHM_HEADER) + 2 * RPC_SHM_RING_SIZE;
+
+    Address = mmap(NULL, Size, PROT_READ | PROT_WRITE, MAP_SHARED, par_Fd, 0);
+    if (Address == MAP_FAILED) {
+        return NULL;
+    }
+    Ret = (RPC_SHM_CHANNEL*)calloc(1, sizeof(RPC_SHM_CHANNEL));
+    if (Ret == NULL) {
+        munmap(Address, Size);
+        return NULL;
+    }
+    Ret->Header = (RPC_SHM_HEADER*)Address;
+    Ret->Data[RPC_SHM_CLIENT_TO_SERVER] = (uint8_t*)Address + sizeof(RPC_SHM_HEADER);
+    Ret->Data[RPC_SHM_SERVER_TO_CLIENT] = (uint8_t*)Address + sizeof(RPC_SHM_HEADER) + RPC_SHM_RING_SIZE;
+    Ret->Socket = par_Socket;
+    Ret->MappedSize = Size;
+    STRING_COPY_TO_ARRAY(Ret->Name, par_Name);
+    return Ret;
+}
+
+RPC_SHM_CHANNEL *RpcShmCreate(uint64_t par_Socket)
+{
+    RPC_SHM_CHANNEL *Ret;
+    char Name[RPC_SHM_MAX_NAME_LENGTH];
+    int Fd;
+
+    PrintFormatToString (Name, sizeof(Name), "/XilEnvRpc_%i_%u", (int)getpid(), __atomic_fetch_add(&ShmUniqueCounter, 1, __ATOMIC_RELAXED));
+    Fd = shm_open(Name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (Fd < 0) {
+        return NULL;
+    }
+    if (ftruncate(Fd, (off_t)(sizeof(RPC_SHM_HEADER) + 2 * RPC_SHM_RING_SIZE)) != 0) {
+        close(Fd);
+        shm_unlink(Name);
+        return NULL;
+    }
+    Ret = MapSharedMemory(Fd, Name, par_Socket);
+    close(Fd);
+    if (Ret == NULL) {
+        shm_unlink(Name);
+        return NULL;
+    }
+    MEMSET(Ret->Header, 0, sizeof(RPC_SHM_HEADER));
+    Ret->Header->RingSize = RPC_SHM_RING_SIZE;
+    Ret->Header->Version = RPC_SHM_VERSION;
+    __atomic_store_n(&Ret->Header->Magic, RPC_SHM_MAGIC, __ATOMIC_RELEASE);
+    return Ret;
+}
+
+RPC_SHM_CHANNEL *RpcShmOpen(const char *par_Name, uint64_t par_Socket)
+{
+    RPC_SHM_CHANNEL *Ret;
+    struct stat Stat;
+    int Fd;
+
+    if ((par_Name[0] != '/') || (strlen(par_Name) >= RPC_SHM_MAX_NAME_LENGTH)) {
+        return NULL;
+    }
+    Fd = shm_open(par_Name, O_RDWR, 0);
+    if (Fd < 0) {
+        return NULL;
+    }
+    // Only accept a shared memory that belongs to the same user
+    if ((fstat(Fd, &Stat) != 0) || (Stat.st_uid != geteuid()) ||
+        (Stat.st_size < (off_t)(sizeof(RPC_SHM_HEADER) + 2 * RPC_SHM_RING_SIZE))) {
+        close(Fd);
+        return NULL;
+    }
+    Ret = MapSharedMemory(Fd, par_Name, par_Socket);
+    close(Fd);
+    if (Ret == NULL) {
+        return NULL;
+    }
+    if ((__atomic_load_n(&Ret->Header->Magic, __ATOMIC_ACQUIRE) != RPC_SHM_MAGIC) ||
+        (Ret->Header->Version != RPC_SHM_VERSION) ||
+        (Ret->Header->RingSize != RPC_SHM_RING_SIZE)) {
+        RpcShmClose(Ret);
+        return NULL;
+    }
+    return Ret;
+}
+
+void RpcShmUnlink(RPC_SHM_CHANNEL *par_Channel)
+{
+    if ((par_Channel != NULL) && (par_Channel->Name[0] != 0)) {
+        shm_unlink(par_Channel->Name);
+        par_Channel->Name[0] = 0;
+    }
+}
+
+void RpcShmClose(RPC_SHM_CHANNEL *par_Channel)
+{
+    if (par_Channel != NULL) {
+        munmap(par_Channel->Header, par_Channel->MappedSize);
+        free(par_Channel);
+    }
+}
+
+int RpcShmWrite(RPC_SHM_CHANNEL *par_Channel, int par_Direction, const void *par_Data, int par_Size)
+{
+    RPC_SHM_RING_CONTROL *Ring = &(par_Channel->Header->Rings[par_Direction]);
+    uint8_t *Buffer = par_Channel->Data[par_Direction];
+    const uint8_t *Src = (const uint8_t*)par_Data;
+    int Pos = 0;
+
+    while (Pos < par_Size) {
+        uint32_t WritePos = Ring->WritePos;   // only this side will change it
+        uint32_t ReadPos = __atomic_load_n(&(Ring->ReadPos), __ATOMIC_ACQUIRE);
+        uint32_t Free = RPC_SHM_RING_SIZE - (WritePos - ReadPos);
+        uint32_t Offset, Len;
+        if (Free == 0) {
+            // ring is full, wait till the other side has read something
+            if (WaitForChange(par_Channel, &(Ring->ReadPos), &(Ring->WriterWaiting), ReadPos)) {
+                return -1;
+            }
+            continue;
+        }
+        Offset = WritePos & (RPC_SHM_RING_SIZE - 1);
+        Len = (uint32_t)(par_Size - Pos);
+        if (Len > Free) Len = Free;
+        if (Len > (RPC_SHM_RING_SIZE - Offset)) Len = RPC_SHM_RING_SIZE - Offset;   // wrap around
+        MEMCPY(Buffer + Offset, Src + Pos, Len);
+        __atomic_store_n(&(Ring->WritePos), WritePos + Len, __ATOMIC_SEQ_CST);
+        WakeUpOtherSide(&(Ring->WritePos), &(Ring->ReaderWaiting));
+        Pos += (int)Len;
+    }
+    return par_Size;
+}
+
+int RpcShmRead(RPC_SHM_CHANNEL *par_Channel, int par_Direction, void *ret_Data, int par_Size)
+{
+    RPC_SHM_RING_CONTROL *Ring = &(par_Channel->Header->Rings[par_Direction]);
+    uint8_t *Buffer = par_Channel->Data[par_Direction];
+    uint8_t *Dst = (uint8_t*)ret_Data;
+    int Pos = 0;
+
+    while (Pos < par_Size) {
+        uint32_t ReadPos = Ring->ReadPos;   // only this side will change it
+        uint32_t WritePos = __atomic_load_n(&(Ring->WritePos), __ATOMIC_ACQUIRE);
+        uint32_t Available = WritePos - ReadPos;
+        uint32_t Offset, Len;
+        if (Available == 0) {
+            // ring is empty, wait till the other side has written something
+            if (WaitForChange(par_Channel, &(Ring->WritePos), &(Ring->ReaderWaiting), WritePos)) {
+                return -1;
+            }
+            continue;
+        }
+        Offset = ReadPos & (RPC_SHM_RING_SIZE - 1);
+        Len = (uint32_t)(par_Size - Pos);
+        if (Len > Available) Len = Available;
+        if (Len > (RPC_SHM_RING_SIZE - Offset)) Len = RPC_SHM_RING_SIZE - Offset;   // wrap around
+        MEMCPY(Dst + Pos, Buffer + Offset, Len);
+        __atomic_store_n(&(Ring->ReadPos), ReadPos + Len, __ATOMIC_SEQ_CST);
+        WakeUpOtherSide(&(Ring->ReadPos), &(Ring->WriterWaiting));
+        Pos += (int)Len;
+    }
+    return par_Size;
+}
+
+#endif
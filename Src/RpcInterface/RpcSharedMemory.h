@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef RPCSHAREDMEMORY_H
+#define RPCSHAREDMEMORY_H
+
+#include <stdint.h>
+
+// Shared memory transport for RPC clients running on the same machine.
+// The connection will be established with the normal login over a (unix domain) socket.
+// After that the client can request to switch to a shared memory with two byte rings
+// (client->server and server->client). The rings are carrying exactly the same byte stream
+// as the socket (RPC_API_BASE_MESSAGE framing), so nothing changes for the command handlers.
+// The socket will be kept open to detect if the other side has died.
+
+#define RPC_SHM_MAGIC             0x4D485352   // "RSHM"
+#define RPC_SHM_VERSION           1
+#define RPC_SHM_RING_SIZE         (1024*1024)  // must be a power of 2
+#define RPC_SHM_MAX_NAME_LENGTH   64
+
+#define RPC_SHM_CLIENT_TO_SERVER  0
+#define RPC_SHM_SERVER_TO_CLIENT  1
+
+typedef struct {
+    // written only by the producer
+    volatile uint32_t WritePos;       // futex word, free running byte counter
+    volatile uint32_t ReaderWaiting;  // consumer sleeps on WritePos
+    uint8_t Filler1[64 - 2 * sizeof(uint32_t)];
+    // written only by the consumer
+    volatile uint32_t ReadPos;        // futex word, free running byte counter
+    volatile uint32_t WriterWaiting;  // producer sleeps on ReadPos
+    uint8_t Filler2[64 - 2 * sizeof(uint32_t)];
+} RPC_SHM_RING_CONTROL;
+
+typedef struct {
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t RingSize;
+    uint32_t Filler[13];
+    RPC_SHM_RING_CONTROL Rings[2];
+    // behind this follows the data of the 2 rings, each RingSize bytes
+} RPC_SHM_HEADER;
+
+typedef struct {
+    RPC_SHM_HEADER *Header;
+    uint8_t *Data[2];
+    uint64_t Socket;    // only used to check if the other side is alive
+    size_t MappedSize;
+    char Name[RPC_SHM_MAX_NAME_LENGTH];
+} RPC_SHM_CHANNEL;
+
+#ifndef _WIN32
+// Client side: create a new shared memory and initialize it
+RPC_SHM_CHANNEL *RpcShmCreate(uint64_t par_Socket);
+// Server side: open the shared memory the client has created
+RPC_SHM_CHANNEL *RpcShmOpen(const char *par_Name, uint64_t par_Socket);
+// After the server has opened the shared memory the name is not needed anymore
+void RpcShmUnlink(RPC_SHM_CHANNEL *par_Channel);
+void RpcShmClose(RPC_SHM_CHANNEL *par_Channel);
+
+// Both functions block until all bytes are transfered.
+// Return value is par_Size or -1 if the other side has closed the connection.
+int RpcShmWrite(RPC_SHM_CHANNEL *par_Channel, int par_Direction, const void *par_Data, int par_Size);
+int RpcShmRead(RPC_SHM_CHANNEL *par_Channel, int par_Direction, void *ret_Data, int par_Size);
+#endif
+
+#endif // RPCSHAREDMEMORY_H
@@ -72,6 +72,7 @@
 #include "RemoteMasterNet.h"
 
 #include "RpcControlProcess.h"
+#include "RpcSharedMemory.h"
 
 #include "RpcSocketServer.h"
 
@@ -583,6 +584,29 @@ static int ReceiveFromRemoteProcedureCallDynBuf (RPC_CONNECTION *par_Connection,
     dyn_buffer = (char*)RemoteProcedureGetReceiveBuffer(par_Connection, sizeof(RPC_API_BASE_MESSAGE));
     if (dyn_buffer == NULL) return -1;
 
+#ifndef _WIN32
+    if (par_Connection->SharedMemoryActive) {
+        RPC_SHM_CHANNEL *Shm = (RPC_SHM_CHANNEL*)par_Connection->SharedMemory;
+        if (RpcShmRead(Shm, RPC_SHM_CLIENT_TO_SERVER, dyn_buffer, sizeof(RPC_API_BASE_MESSAGE)) <= 0) {
+            fprintf(stderr, "Connection closed\n");
+            return 0;
+        }
+        receive_message_size = (int)*(int32_t*)(void*)dyn_buffer;
+        if (receive_message_size < (int)sizeof(RPC_API_BASE_MESSAGE)) {
+            return 0;
+        }
+        dyn_buffer = (char*)RemoteProcedureGetReceiveBuffer(par_Connection, receive_message_size);
+        if (dyn_buffer == NULL) return -1;
+        if (RpcShmRead(Shm, RPC_SHM_CLIENT_TO_SERVER, dyn_buffer + sizeof(RPC_API_BASE_MESSAGE),
+                       receive_message_size - (int)sizeof(RPC_API_BASE_MESSAGE)) < 0) {
+            fprintf(stderr, "Connection closed\n");
+            return 0;
+        }
+        *ret_ptrToData = (RPC_API_BASE_MESSAGE*)(void*)dyn_buffer;
+        return receive_message_size;
+    }
+#endif
+
     // ersmal nur Header lesen
     do {
         int ReadBytes = recv (par_Connection->Socket, dyn_buffer + buffer_pos, (int)sizeof(RPC_API_BASE_MESSAGE) - buffer_pos, 0);
@@ -662,14 +686,31 @@ static void* RemoteProcedureCallSocketServerThreadFunction (void* lpParam)
             ToTransmitDataLen = -ToTransmitDataLen;
         }
         if (ToTransmitDataLen >= (int)sizeof(RPC_API_BASE_MESSAGE_ACK)) {
+#ifndef _WIN32
+            if (Connection->SharedMemoryActive) {
+                if (RpcShmWrite((RPC_SHM_CHANNEL*)Connection->SharedMemory, RPC_SHM_SERVER_TO_CLIENT, Transmit, ToTransmitDataLen) < 0) {
+                    break;
+                }
+            } else
+#endif
             send((SOCKET)Connection->Socket, (char*)Transmit, ToTransmitDataLen, 0);
         }
+        // The ack of RPC_API_OPEN_SHARED_MEMORY_CMD was transmitted through the socket,
+        // all following messages will use the shared memory
+        if ((Connection->SharedMemory != NULL) && !Connection->SharedMemoryActive) {
+            Connection->SharedMemoryActive = 1;
+        }
         if (ShouldStop) break;
     }
 #ifdef _WIN32
     closesocket((SOCKET)Connection->Socket);
 #else
     close((SOCKET)Connection->Socket);
+    if (Connection->SharedMemory != NULL) {
+        RpcShmClose((RPC_SHM_CHANNEL*)Connection->SharedMemory);
+        Connection->SharedMemory = NULL;
+        Connection->SharedMemoryActive = 0;
+    }
 #endif
     RemoveAllPendingStartStopSchedulerRequestsOfThisThread(Connection->SchedulerDisableCounter);
     CleanUpWaitFuncForConnection(Connection);
@@ -1266,6 +1307,17 @@ void RemoteProcedureWaitForConnection(RPC_CONNECTION *par_Connection)
     while (par_Connection->WaitFlag) {
         SleepConditionVariableCS(&(par_Connection->ConditionVariable), &(par_Connection->CriticalSection), 1000);
         if (par_Connection->WaitFlag) {
+#ifndef _WIN32
+            if (par_Connection->SharedMemoryActive) {
+                // no alive ping through the shared memory, only check if the socket was closed by the client
+                char Byte;
+                int ReadBytes = (int)recv((SOCKET)par_Connection->Socket, &Byte, 1, MSG_PEEK | MSG_DONTWAIT);
+                if ((ReadBytes == 0) || ((ReadBytes < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))) {
+                    par_Connection->WaitFlag = 0;  // the connection are closed or broken
+                }
+                continue;
+            }
+#endif
             if (par_Connection->WaitToReceiveAlivePingAck) {
                par_Connection->WaitToReceiveAlivePingAck = 0;
                RPC_API_PING_TO_CLINT_MESSAGE_ACK Ack;
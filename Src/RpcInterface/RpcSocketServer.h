@@ -83,6 +83,9 @@ typedef struct {
 
            void *CanRecorderHandle;
 
+           void *SharedMemory;             // RPC_SHM_CHANNEL if the client has requested a shared memory transport
+           int SharedMemoryActive;         // will be set after the ack of RPC_API_OPEN_SHARED_MEMORY_CMD was transmitted
+
           // int8_t Filler[128-80 + sizeof(CRITICAL_SECTION) + sizeof(CONDITION_VARIABLE)];    // Cacheline 128Byte
 } RPC_CONNECTION;
 
@@ -42,6 +42,7 @@
 #include "UnixDomainSocketMessages.h"
 #include "BaseMessages.h"
 #include "RemoteMasterOther.h"
+#include "StructsRM_Blackboard.h"
 
 #define UNUSED(x) (void)(x)
 
@@ -162,6 +163,43 @@ void TerminateExternProcessMessages (void)
     Socket_TerminateMessages();
 }
 
+// Translate the name of a variable that should be added by an external process into a blackboard label.
+// The name can be an address ("0x...") or the data type should be taken from the debug infos.
+// Returns 0 or LABEL_NAME_TOO_LONG / ADDRESS_NO_VALID_LABEL
+static int TranslateAddBbvariName (const char *par_Name, int par_AddressValidFlag, uint64_t par_Address, int par_Pid,
+                                   int *io_DataType, char *ret_Label, int par_MaxLen)
+{
+    int AddrNotName;
+    uint64_t Ptr;
+
+    AddrNotName = ((par_Name[0] == '0') && (par_Name[1] == 'x'));
+
+    /* Name is not a label but an address. The label should be find by the address inside the debug information */
+    if (AddrNotName ||
+        (par_AddressValidFlag && (*io_DataType == BB_GET_DATA_TYPE_FOM_DEBUGINFO))){
+        int TypeFromDebugInfos;
+        int Ret;
+        if (AddrNotName) Ptr = strtoull (par_Name, NULL, 16);  // Addresse are included as string inside the name
+        else Ptr = par_Address;
+        if ((Ret = DbgInfoTranslatePointerToLabel (Ptr, ret_Label, par_MaxLen, &TypeFromDebugInfos, par_Pid)) != 0) {
+            return Ret;  // LABEL_NAME_TOO_LONG or ADDRESS_NO_VALID_LABEL
+        } else {
+            if (!AddrNotName) {
+                StringCopyMaxCharTruncate (ret_Label, par_Name, par_MaxLen);
+            }
+
+        }
+        if  (*io_DataType == BB_GET_DATA_TYPE_FOM_DEBUGINFO) {
+            *io_DataType = TypeFromDebugInfos;
+        }
+    } else {
+        if (ConvertLabelAsapCombatibleInOut (par_Name, ret_Label, par_MaxLen, 0)) {   // replace :: by ._. if necessary
+            StringCopyMaxCharTruncate (ret_Label, par_Name, par_MaxLen);
+        }
+    }
+    return 0;
+}
+
 int PipeAddBbvariCmdMessage (TASK_CONTROL_BLOCK *pTcb,
                              PIPE_API_ADD_BBVARI_CMD_MESSAGE *pAddBbvariCmdMessage,
                              PIPE_API_ADD_BBVARI_CMD_MESSAGE_ACK *pAddBbvariCmdMessageAck)
@@ -170,45 +208,21 @@ int PipeAddBbvariCmdMessage (TASK_CONTROL_BLOCK *pTcb,
     VID Vid;
     int PipeDataType;
     int DataType;
-    int AddrNotName;
     char *Name;
-    uint64_t Ptr;
     int AllInfosFlag;
     char Label[BBVARI_NAME_SIZE];
 
     Name = pAddBbvariCmdMessage->Data + pAddBbvariCmdMessage->NameStructOffset;
 
-    AddrNotName = ((Name[0] == '0') && (Name[1] == 'x'));
-
     AllInfosFlag = pAddBbvariCmdMessage->DataType & 0x1000;
     DataType = pAddBbvariCmdMessage->DataType & 0xFF;
     if (IfUnknowWaitDataTypeConvert (DataType, &PipeDataType)) {
         DataType = BB_UNKNOWN_WAIT;
     }
 
-    /* Name is not a label but an address. The label should be find by the address inside the debug information */
-    if (AddrNotName ||
-        (pAddBbvariCmdMessage->AddressValidFlag && (DataType == BB_GET_DATA_TYPE_FOM_DEBUGINFO))){
-        int TypeFromDebugInfos;
-        int Ret;
-        if (AddrNotName) Ptr = strtoull (Name, NULL, 16);  // Addresse are included as string inside the name
-        else Ptr = pAddBbvariCmdMessage->Address;
-        if ((Ret = DbgInfoTranslatePointerToLabel (Ptr, Label, sizeof (Label), &TypeFromDebugInfos, pAddBbvariCmdMessage->Pid)) != 0) {
-            Vid = Ret;  // LABEL_NAME_TOO_LONG or ADDRESS_NO_VALID_LABEL
-            goto __OUT;
-        } else {
-            if (!AddrNotName) {
-                STRING_COPY_TO_ARRAY (Label, Name);
-            }
-
-        }
-        if  (DataType == BB_GET_DATA_TYPE_FOM_DEBUGINFO) {
-            DataType = TypeFromDebugInfos;
-        }
-    } else {
-        if (ConvertLabelAsapCombatibleInOut (Name, Label, sizeof (Label), 0)) {   // replace :: by ._. if necessary
-            STRING_COPY_TO_ARRAY (Label, Name);
-        }
+    if ((Vid = TranslateAddBbvariName (Name, pAddBbvariCmdMessage->AddressValidFlag, pAddBbvariCmdMessage->Address,
+                                       pAddBbvariCmdMessage->Pid, &DataType, Label, sizeof (Label))) != 0) {
+        goto __OUT;
     }
 
     if (((pAddBbvariCmdMessage->Dir & PIPE_API_REFERENCE_VARIABLE_DIR_IGNORE_REF_FILTER) != PIPE_API_REFERENCE_VARIABLE_DIR_IGNORE_REF_FILTER) &&
@@ -270,6 +284,156 @@ __OUT:
     return sizeof (PIPE_API_ADD_BBVARI_CMD_MESSAGE_ACK); 
 }
 
+int PipeAddBbvarisCmdMessage (TASK_CONTROL_BLOCK *pTcb,
+                              PIPE_API_ADD_BBVARIS_CMD_MESSAGE *pAddBbvarisCmdMessage,
+                              PIPE_API_ADD_BBVARIS_CMD_MESSAGE_ACK *pAddBbvarisCmdMessageAck)
+{
+    UNUSED(pTcb);
+    PIPE_API_ADD_BBVARIS_ELEM *Elems = (PIPE_API_ADD_BBVARIS_ELEM*)(void*)pAddBbvarisCmdMessage->Data;
+    int Count = pAddBbvarisCmdMessage->Count;
+    int Pid = pAddBbvarisCmdMessage->Pid;
+    char Prefix[BBVARI_NAME_SIZE];
+    char Label[BBVARI_NAME_SIZE];
+    char *Labels = NULL;
+    int LabelsSize = 0, LabelsPos = 0;
+    int *Offsets = NULL, *Positions = NULL, *Dirs = NULL, *PipeDataTypes = NULL, *RealTypes = NULL;
+    const char **Names = NULL, **Units = NULL;
+    enum BB_DATA_TYPES *DataTypes = NULL;
+    VID *Vids = NULL;
+    int x, n;
+
+    if (Count < 0) Count = 0;
+    if (Count > PIPE_API_ADD_BBVARIS_MAX_COUNT) Count = PIPE_API_ADD_BBVARIS_MAX_COUNT;
+    pAddBbvarisCmdMessageAck->ReturnValue = 0;
+    if (Count == 0) goto __OUT;
+
+    Offsets = (int*)my_malloc ((size_t)Count * sizeof (int));
+    Positions = (int*)my_malloc ((size_t)Count * sizeof (int));
+    Dirs = (int*)my_malloc ((size_t)Count * sizeof (int));
+    PipeDataTypes = (int*)my_malloc ((size_t)Count * sizeof (int));
+    RealTypes = (int*)my_malloc ((size_t)Count * sizeof (int));
+    Names = (const char**)my_malloc ((size_t)Count * sizeof (const char*));
+    Units = (const char**)my_malloc ((size_t)Count * sizeof (const char*));
+    DataTypes = (enum BB_DATA_TYPES*)my_malloc ((size_t)Count * sizeof (enum BB_DATA_TYPES));
+    Vids = (VID*)my_malloc ((size_t)Count * sizeof (VID));
+    if ((Offsets == NULL) || (Positions == NULL) || (Dirs == NULL) || (PipeDataTypes == NULL) || (RealTypes == NULL) ||
+        (Names == NULL) || (Units == NULL) || (DataTypes == NULL) || (Vids == NULL)) {
+        pAddBbvarisCmdMessageAck->ReturnValue = -1;
+        for (x = 0; x < Count; x++) {
+            pAddBbvarisCmdMessageAck->Elems[x].Vid = BB_VAR_ADD_INFOS_MEM_ERROR;
+            pAddBbvarisCmdMessageAck->Elems[x].RealType = 0;
+        }
+        goto __OUT;
+    }
+    if (GetBlackboarPrefixForProcess (Pid, Prefix, sizeof (Prefix))) {
+        for (x = 0; x < Count; x++) {
+            pAddBbvarisCmdMessageAck->Elems[x].Vid = UNKNOWN_PROCESS;
+            pAddBbvarisCmdMessageAck->Elems[x].RealType = 0;
+        }
+        goto __OUT;
+    }
+
+    // Translate all names into labels, the labels are stored (with the process prefix) one after the other
+    for (x = n = 0; x < Count; x++) {
+        const char *Name = pAddBbvarisCmdMessage->Data + Elems[x].NameStructOffset;
+        const char *Unit = pAddBbvarisCmdMessage->Data + Elems[x].UnitStructOffset;
+        int DataType = Elems[x].DataType & 0xFF;
+        int PipeDataType;
+        int Ret, Len;
+
+        pAddBbvarisCmdMessageAck->Elems[x].RealType = 0;
+        if (IfUnknowWaitDataTypeConvert (DataType, &PipeDataType)) {
+            DataType = BB_UNKNOWN_WAIT;
+        }
+        if ((Ret = TranslateAddBbvariName (Name, Elems[x].AddressValidFlag, Elems[x].Address, Pid, &DataType, Label, sizeof (Label))) != 0) {
+            pAddBbvarisCmdMessageAck->Elems[x].Vid = Ret;
+            continue;
+        }
+        if (((Elems[x].Dir & PIPE_API_REFERENCE_VARIABLE_DIR_IGNORE_REF_FILTER) != PIPE_API_REFERENCE_VARIABLE_DIR_IGNORE_REF_FILTER) &&
+            !ExternProcessReferenceMatchFilter(Pid, Label)) {
+            pAddBbvarisCmdMessageAck->Elems[x].Vid = VARIABLE_REF_LIST_FILTERED;
+            continue;
+        }
+        Len = (int)strlen (Prefix) + (int)strlen (Label) + 1;
+        if ((LabelsPos + Len) > LabelsSize) {
+            char *NewLabels;
+            LabelsSize += Len + 64 * 1024;
+            NewLabels = (char*)my_realloc (Labels, (size_t)LabelsSize);
+            if (NewLabels == NULL) {
+                pAddBbvarisCmdMessageAck->Elems[x].Vid = BB_VAR_ADD_INFOS_MEM_ERROR;
+                continue;
+            }
+            Labels = NewLabels;
+        }
+        StringCopyMaxCharTruncate (Labels + LabelsPos, Prefix, Len);
+        StringAppendMaxCharTruncate (Labels + LabelsPos, Label, Len);
+        Offsets[n] = LabelsPos;
+        LabelsPos += Len;
+        Positions[n] = x;
+        DataTypes[n] = (enum BB_DATA_TYPES)DataType;
+        PipeDataTypes[n] = PipeDataType;
+        Units[n] = (strlen (Unit)) ? Unit : NULL;
+        Dirs[n] = Elems[x].Dir;
+        n++;
+    }
+    // The label buffer can be moved by realloc so set the pointers at the end
+    for (x = 0; x < n; x++) {
+        Names[x] = Labels + Offsets[x];
+    }
+
+    add_bbvari_pid_type_frame (n, Names, DataTypes, Units, Dirs, Pid, 0, NULL, READ_ALL_INFOS_BBVARI_FROM_INI, Vids, RealTypes);
+
+    for (x = 0; x < n; x++) {
+        PIPE_API_ADD_BBVARIS_ELEM *Elem = &Elems[Positions[x]];
+        VID Vid = Vids[x];
+        if (Vid > 0) {  // Only if variable are successful added to blackboard add it to copy list
+            // The copy list must be always consistent to that inside the external Process
+            int TypePipe;
+            if (!IfUnknowDataTypeConvert (PipeDataTypes[x], &TypePipe)) {
+                // If no type conversion than  blackboard type equal to pipe type
+                if ((TypePipe == BB_GET_DATA_TYPE_FOM_DEBUGINFO) ||
+                    (TypePipe == BB_UNKNOWN)) {   // add_bbvai (..., BB_UNKNOWN, ...)
+                    TypePipe = RealTypes[x];
+                }
+            }
+            if (Elem->AddressValidFlag &&
+                (Elem->Address != 0) &&
+                (Elem->UniqueId != 0) &&
+                (Elem->UniqueId != 0xFFFFFFFFFFFFFFFFULL)) {  // Only add the reference to the copy list
+                int Ret = InsertVariableToCopyLists (Pid, Vid,
+                                                    Elem->Address,
+                                                    RealTypes[x],
+                                                    TypePipe,
+                                                    Elem->Dir & 0xFFFF,
+                                                    Elem->UniqueId);
+                if (Ret < 0) {
+                    remove_bbvari_pid(Vid, Pid);
+                    Vid = Ret;
+                }
+            }
+            pAddBbvarisCmdMessageAck->Elems[Positions[x]].RealType = RealTypes[x];
+        }
+        pAddBbvarisCmdMessageAck->Elems[Positions[x]].Vid = Vid;
+    }
+__OUT:
+    if (Labels != NULL) my_free (Labels);
+    if (Offsets != NULL) my_free (Offsets);
+    if (Positions != NULL) my_free (Positions);
+    if (Dirs != NULL) my_free (Dirs);
+    if (PipeDataTypes != NULL) my_free (PipeDataTypes);
+    if (RealTypes != NULL) my_free (RealTypes);
+    if (Names != NULL) my_free ((void*)Names);
+    if (Units != NULL) my_free ((void*)Units);
+    if (DataTypes != NULL) my_free (DataTypes);
+    if (Vids != NULL) my_free (Vids);
+
+    pAddBbvarisCmdMessageAck->Command = PIPE_API_ADD_BBVARIS_CMD;
+    pAddBbvarisCmdMessageAck->Count = Count;
+    pAddBbvarisCmdMessageAck->StructSize = (int32_t)(sizeof (PIPE_API_ADD_BBVARIS_CMD_MESSAGE_ACK) +
+                                                     ((Count > 0) ? (Count - 1) : 0) * sizeof (PIPE_API_ADD_BBVARIS_ACK_ELEM));
+    return pAddBbvarisCmdMessageAck->StructSize;
+}
+
 int PipeAttachBbvariCmdMessage (TASK_CONTROL_BLOCK *pTcb,
                                 PIPE_API_ATTACH_BBVARI_CMD_MESSAGE *pAttachBbvariCmdMessage,
                                 PIPE_API_ATTACH_BBVARI_CMD_MESSAGE_ACK *pAttachBbvariCmdMessageAck)
@@ -498,6 +662,11 @@ int DecodePipeCmdMessage (TASK_CONTROL_BLOCK *pTcb,
                                                (PIPE_API_ADD_BBVARI_CMD_MESSAGE *)pReceiveMessageBuffer,
                                                (PIPE_API_ADD_BBVARI_CMD_MESSAGE_ACK *)pTransmitMessageBuffer);
         break;
+    case PIPE_API_ADD_BBVARIS_CMD:
+        ResponseLen = PipeAddBbvarisCmdMessage (pTcb,
+                                                (PIPE_API_ADD_BBVARIS_CMD_MESSAGE *)pReceiveMessageBuffer,
+                                                (PIPE_API_ADD_BBVARIS_CMD_MESSAGE_ACK *)pTransmitMessageBuffer);
+        break;
     case PIPE_API_ATTACH_BBVARI_CMD:
         ResponseLen = PipeAttachBbvariCmdMessage (pTcb,
                                                   (PIPE_API_ATTACH_BBVARI_CMD_MESSAGE *)pReceiveMessageBuffer,
@@ -1319,6 +1488,8 @@ int CheckExternProcessComunicationProtocolVersion (PIPE_API_LOGIN_MESSAGE *Login
 {
     if (LoginMessage->Version == EXTERN_PROCESS_COMUNICATION_PROTOCOL_VERSION) {   // the current one
         return 1;
+    } else if (LoginMessage->Version == EXTERN_PROCESS_COMUNICATION_PROTOCOL_VERSION_WITHOUT_ADD_BBVARIS) {  // this one will never send PIPE_API_ADD_BBVARIS_CMD
+        return 1;
     } else {
         ThrowError (1, "process \"%s\" have wrong version of communication library (%i) XilEnv (%i) login ignored",
                LoginMessage->ProcessName, LoginMessage->Version, EXTERN_PROCESS_COMUNICATION_PROTOCOL_VERSION);
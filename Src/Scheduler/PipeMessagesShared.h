@@ -25,7 +25,9 @@
 
 #define PIPE_MESSAGE_BUFSIZE (1024*1024)
 
-#define EXTERN_PROCESS_COMUNICATION_PROTOCOL_VERSION    1012
+#define EXTERN_PROCESS_COMUNICATION_PROTOCOL_VERSION    1013
+// older versions which are still accepted (they only not use PIPE_API_ADD_BBVARIS_CMD)
+#define EXTERN_PROCESS_COMUNICATION_PROTOCOL_VERSION_WITHOUT_ADD_BBVARIS  1012
 
 #if defined _M_X64 || defined __linux__
 #define ALIVE_PING_HANDLE_ULONG  uint32_t
@@ -279,6 +281,42 @@ typedef struct {
     int32_t ReturnValue;
 } PIPE_API_ADD_BBVARI_CMD_MESSAGE_ACK;
 
+/* Add several blackboard variables with one message */
+typedef struct {
+    int32_t Dir;
+    int32_t DataType;
+    uint64_t Address;
+    uint64_t UniqueId;
+    int32_t AddressValidFlag;
+    int32_t NameStructOffset;    // offsets are relative to Data of the message
+    int32_t UnitStructOffset;
+    int32_t Fill1;
+} PIPE_API_ADD_BBVARIS_ELEM;
+
+typedef struct {
+    int32_t Command;
+#define  PIPE_API_ADD_BBVARIS_CMD  212
+    int32_t StructSize;
+    int32_t Pid;
+    int32_t Count;
+    char Data[1]; // more than 1 Byte! first the PIPE_API_ADD_BBVARIS_ELEM[Count] followed by the names and units
+} PIPE_API_ADD_BBVARIS_CMD_MESSAGE;
+
+typedef struct {
+    int32_t Vid;
+    int32_t RealType;
+} PIPE_API_ADD_BBVARIS_ACK_ELEM;
+
+typedef struct {
+    int32_t Command;
+    int32_t StructSize;
+    int32_t Count;
+    int32_t ReturnValue;
+    PIPE_API_ADD_BBVARIS_ACK_ELEM Elems[1]; // more than 1 element!
+} PIPE_API_ADD_BBVARIS_CMD_MESSAGE_ACK;
+
+#define PIPE_API_ADD_BBVARIS_MAX_COUNT  ((int)((PIPE_MESSAGE_BUFSIZE - sizeof(PIPE_API_ADD_BBVARIS_CMD_MESSAGE_ACK)) / sizeof(PIPE_API_ADD_BBVARIS_ACK_ELEM)))
+
 /* Attach blackboard variable function */
 typedef struct {
     int32_t Command;
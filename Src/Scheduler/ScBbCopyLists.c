@@ -60,11 +60,16 @@ static int InsertVariableToCopyListsRdOrWr (PIPE_MESSAGE_REF_COPY_LIST *pList, i
     if (pList->ElemCount >= pList->ElemCountMax) {
         pList->ElemCountMax += 128;
         pList->pElems = (PIPE_MESSAGE_REF_COPY_LIST_ELEM*)my_realloc (pList->pElems, (size_t)pList->ElemCountMax * sizeof (PIPE_MESSAGE_REF_COPY_LIST_ELEM));
-        if (pList->pElems == NULL) {
+        pList->pVids = (int*)my_realloc (pList->pVids, (size_t)pList->ElemCountMax * sizeof (int));
+        pList->pTypesPipe = (short*)my_realloc (pList->pTypesPipe, (size_t)pList->ElemCountMax * sizeof (short));
+        pList->pWrSeqs = (uint32_t*)my_realloc (pList->pWrSeqs, (size_t)pList->ElemCountMax * sizeof (uint32_t));
+        if ((pList->pElems == NULL) || (pList->pVids == NULL) || (pList->pTypesPipe == NULL) || (pList->pWrSeqs == NULL)) {
             ThrowError (1, "out of memory cannot build copy lists BB <-> reference");
             return -1;
         }
     }
+    pList->pVids[pList->ElemCount] = Vid;
+    pList->pTypesPipe[pList->ElemCount] = (short)TypePipe;
     pList->pElems[pList->ElemCount].UniqueIdOrNamneAndUniqueId.UniqueId = UniqueId;
     pList->pElems[pList->ElemCount].Vid = Vid;
     pList->pElems[pList->ElemCount].Addr = Addr;
@@ -185,6 +190,9 @@ static int RemoveVariableFromCopyListsRdOrWr (PIPE_MESSAGE_REF_COPY_LIST *pList,
             pList->SizeInBytes -= GetBbVarTypeSize (pList->pElems[x].TypePipe);
             pList->ElemCount--;
             pList->pElems[x] = pList->pElems[pList->ElemCount];  // move the last one to the deleted
+            pList->pVids[x] = pList->pVids[pList->ElemCount];
+            pList->pTypesPipe[x] = pList->pTypesPipe[pList->ElemCount];
+            pList->pWrSeqs[x] = pList->pWrSeqs[pList->ElemCount];
             return 0;
         }
     }
@@ -357,8 +365,8 @@ static int RangeControlCheck (TASK_CONTROL_BLOCK *Tcb, PIPE_MESSAGE_REF_COPY_LIS
     if (Phys && (blackboard[vid_index].pAdditionalInfos->Conversion.Type != BB_CONV_FORMULA)) {
         Value = execute_stack ((struct EXEC_STACK_ELEM *)blackboard[vid_index].pAdditionalInfos->Conversion.Conv.Formula.FormulaByteCode);
     } else {
-        bbvari_to_double (blackboard[vid_index].Type,
-                          blackboard[vid_index].Value,
+        bbvari_to_double (BB_TYPE(vid_index),
+                          BB_VALUE(vid_index),
                           &Value);
     }
 
@@ -450,6 +458,13 @@ static inline void UnlockBBErrorMessage(PIPE_MESSAGE_REF_COPY_LIST_ELEM *par_Ele
 }
 
 
+// Remember the write sequence numbers of all variables the process will write. If one of them
+// is written by somebody else during the process runs, it will not be overwritten afterwards.
+static void SnapshotWriteListWrSeqs (PIPE_MESSAGE_REF_COPY_LIST *par_WrList)
+{
+    get_bbvari_wrseq_frame (par_WrList->ElemCount, par_WrList->pVids, par_WrList->pWrSeqs);
+}
+
 static int CopyFromBlackbardToPipeRC (TASK_CONTROL_BLOCK *Tcb, char *SnapShotData)
 {
     int x, pos = 0;
@@ -466,18 +481,10 @@ static int CopyFromBlackbardToPipeRC (TASK_CONTROL_BLOCK *Tcb, char *SnapShotDat
     Limit = (Tcb->RangeControlFlags & RANGE_CONTROL_LIMIT_VALUES_FLAG) == RANGE_CONTROL_LIMIT_VALUES_FLAG;
     Output = Tcb->RangeControlFlags & RANGE_CONTROL_OUTPUT_MASK;
     EnterBlackboardCriticalSection();
-    for (x = 0; x < Tcb->CopyLists.WrList8.ElemCount; x++) {
-        reset_wrflag (Tcb->CopyLists.WrList8.pElems[x].Vid, Tcb->wr_flag_mask);
-    }
-    for (x = 0; x < Tcb->CopyLists.WrList4.ElemCount; x++) {
-        reset_wrflag (Tcb->CopyLists.WrList4.pElems[x].Vid, Tcb->wr_flag_mask);
-    }
-    for (x = 0; x < Tcb->CopyLists.WrList2.ElemCount; x++) {
-        reset_wrflag (Tcb->CopyLists.WrList2.pElems[x].Vid, Tcb->wr_flag_mask);
-    }
-    for (x = 0; x < Tcb->CopyLists.WrList1.ElemCount; x++) {
-        reset_wrflag (Tcb->CopyLists.WrList1.pElems[x].Vid, Tcb->wr_flag_mask);
-    }
+    SnapshotWriteListWrSeqs (&(Tcb->CopyLists.WrList8));
+    SnapshotWriteListWrSeqs (&(Tcb->CopyLists.WrList4));
+    SnapshotWriteListWrSeqs (&(Tcb->CopyLists.WrList2));
+    SnapshotWriteListWrSeqs (&(Tcb->CopyLists.WrList1));
     for (x = 0; x < Tcb->CopyLists.RdList8.ElemCount; x++) {
         int size;
         // Range Control
@@ -537,10 +544,21 @@ static int CopyFromBlackbardToPipeRC (TASK_CONTROL_BLOCK *Tcb, char *SnapShotDat
     return pos;
 }
 
+// Copy all variables of one read list with one call, if one fails the remaining
+// bytes of this list will be skipped so the following lists keep their position
+static int CopyOneReadList(int pos, char *SnapShotData, PIPE_MESSAGE_REF_COPY_LIST *par_RdList)
+{
+    int Ret = read_bbvari_frame_typed_cs (par_RdList->ElemCount, par_RdList->pVids, par_RdList->pTypesPipe, SnapShotData + pos);
+    if (Ret < 0) {
+        UnlockBBErrorMessage(&par_RdList->pElems[-Ret - 1], __LINE__);
+        return pos + par_RdList->SizeInBytes;
+    }
+    return pos + Ret;
+}
 
 int CopyFromBlackbardToPipe (TASK_CONTROL_BLOCK *Tcb, char *SnapShotData)
 {
-    int x, pos = 0;
+    int pos = 0;
 
     if ((Tcb->RangeControlFlags & RANGE_CONTROL_BEFORE_ACTIVE_FLAG) == RANGE_CONTROL_BEFORE_ACTIVE_FLAG) {
         switch (read_bbvari_udword(Tcb->RangeControlVid)) {
@@ -551,50 +569,14 @@ int CopyFromBlackbardToPipe (TASK_CONTROL_BLOCK *Tcb, char *SnapShotData)
     }
 
     EnterBlackboardCriticalSection();
-    for (x = 0; x < Tcb->CopyLists.WrList8.ElemCount; x++) {
-        reset_wrflag (Tcb->CopyLists.WrList8.pElems[x].Vid, Tcb->wr_flag_mask);
-    }
-    for (x = 0; x < Tcb->CopyLists.WrList4.ElemCount; x++) {
-        reset_wrflag (Tcb->CopyLists.WrList4.pElems[x].Vid, Tcb->wr_flag_mask);
-    }
-    for (x = 0; x < Tcb->CopyLists.WrList2.ElemCount; x++) {
-        reset_wrflag (Tcb->CopyLists.WrList2.pElems[x].Vid, Tcb->wr_flag_mask);
-    }
-    for (x = 0; x < Tcb->CopyLists.WrList1.ElemCount; x++) {
-        reset_wrflag (Tcb->CopyLists.WrList1.pElems[x].Vid, Tcb->wr_flag_mask);
-    }
-    for (x = 0; x < Tcb->CopyLists.RdList8.ElemCount; x++) {
-        int size = read_bbvari_convert_to (Tcb->CopyLists.RdList8.pElems[x].Vid, Tcb->CopyLists.RdList8.pElems[x].TypePipe, (union BB_VARI*)(void*)(SnapShotData + pos));
-        if (size <= 0) {
-            UnlockBBErrorMessage(&Tcb->CopyLists.RdList8.pElems[x], __LINE__);
-            break;
-        }
-        pos += size;
-    }
-    for (x = 0; x < Tcb->CopyLists.RdList4.ElemCount; x++) {
-        int size = read_bbvari_convert_to (Tcb->CopyLists.RdList4.pElems[x].Vid, Tcb->CopyLists.RdList4.pElems[x].TypePipe, (union BB_VARI*)(void*)(SnapShotData + pos));
-        if (size <= 0) {
-            UnlockBBErrorMessage(&Tcb->CopyLists.RdList4.pElems[x], __LINE__);
-            break;
-        }
-        pos += size;
-    }
-    for (x = 0; x < Tcb->CopyLists.RdList2.ElemCount; x++) {
-        int size = read_bbvari_convert_to (Tcb->CopyLists.RdList2.pElems[x].Vid, Tcb->CopyLists.RdList2.pElems[x].TypePipe, (union BB_VARI*)(void*)(SnapShotData + pos));
-        if (size <= 0) {
-            UnlockBBErrorMessage(&Tcb->CopyLists.RdList2.pElems[x], __LINE__);
-            break;
-        }
-        pos += size;
-    }
-    for (x = 0; x < Tcb->CopyLists.RdList1.ElemCount; x++) {
-        int size = read_bbvari_convert_to (Tcb->CopyLists.RdList1.pElems[x].Vid, Tcb->CopyLists.RdList1.pElems[x].TypePipe, (union BB_VARI*)(void*)(SnapShotData + pos));
-        if (size <= 0) {
-            UnlockBBErrorMessage(&Tcb->CopyLists.RdList1.pElems[x], __LINE__);
-            break;
-        }
-        pos += size;
-    }
+    SnapshotWriteListWrSeqs (&(Tcb->CopyLists.WrList8));
+    SnapshotWriteListWrSeqs (&(Tcb->CopyLists.WrList4));
+    SnapshotWriteListWrSeqs (&(Tcb->CopyLists.WrList2));
+    SnapshotWriteListWrSeqs (&(Tcb->CopyLists.WrList1));
+    pos = CopyOneReadList(pos, SnapShotData, &(Tcb->CopyLists.RdList8));
+    pos = CopyOneReadList(pos, SnapShotData, &(Tcb->CopyLists.RdList4));
+    pos = CopyOneReadList(pos, SnapShotData, &(Tcb->CopyLists.RdList2));
+    pos = CopyOneReadList(pos, SnapShotData, &(Tcb->CopyLists.RdList1));
     LeaveBlackboardCriticalSection();
     return pos;
 }
@@ -611,7 +593,7 @@ static int CopyOneWriteListRC(int *pos, char *SnapShotData, PIPE_MESSAGE_REF_COP
     Limit = (Tcb->RangeControlFlags & RANGE_CONTROL_LIMIT_VALUES_FLAG) == RANGE_CONTROL_LIMIT_VALUES_FLAG;
     Output = Tcb->RangeControlFlags & RANGE_CONTROL_OUTPUT_MASK;
     for (x = 0; x < par_WrList->ElemCount; x++) {
-        if (!test_wrflag (par_WrList->pElems[x].Vid, Tcb->wr_flag_mask)) {
+        if (get_bbvari_wrseq (par_WrList->pElems[x].Vid) == par_WrList->pWrSeqs[x]) {
             int size = write_bbvari_convert_to (Tcb->pid, par_WrList->pElems[x].Vid,
                                                 par_WrList->pElems[x].TypePipe, SnapShotData + *pos);
             if (size <= 0) {
@@ -669,26 +651,14 @@ static int CopyFromPipeToBlackboardRC (TASK_CONTROL_BLOCK *Tcb, char *SnapShotDa
 
 static int CopyOneWriteList(int pos, char *SnapShotData, PIPE_MESSAGE_REF_COPY_LIST *par_WrList, TASK_CONTROL_BLOCK *Tcb)
 {
-    int x;
-    for (x = 0; x < par_WrList->ElemCount; x++) {
-        if (!test_wrflag (par_WrList->pElems[x].Vid, Tcb->wr_flag_mask)) {
-            int size = write_bbvari_convert_to (Tcb->pid, par_WrList->pElems[x].Vid,
-                                                par_WrList->pElems[x].TypePipe, SnapShotData + pos);
-            if (size <= 0) {
-                UnlockBBErrorMessage(&par_WrList->pElems[x], __LINE__);
-            } else {
-                pos += size;
-            }
-        } else {
-            int size = size_of_bbvari (par_WrList->pElems[x].TypePipe);
-            if (size <= 0) {
-                UnlockBBErrorMessage(&par_WrList->pElems[x], __LINE__);
-            } else {
-                pos += size;
-            }
-        }
-    }
-    return pos;
+    // Variables which are written by an other process meanwhile (write sequence number changed) will be skipped
+    int Ret = write_bbvari_frame_typed_cs (Tcb->pid, par_WrList->ElemCount, par_WrList->pVids, par_WrList->pTypesPipe, SnapShotData + pos,
+                                           par_WrList->pWrSeqs);
+    if (Ret < 0) {
+        UnlockBBErrorMessage(&par_WrList->pElems[-Ret - 1], __LINE__);
+        return pos + par_WrList->SizeInBytes;
+    }
+    return pos + Ret;
 }
 
 int CopyFromPipeToBlackboard (TASK_CONTROL_BLOCK *Tcb, char *SnapShotData, int SnapShotSize) 
@@ -853,6 +823,15 @@ static void FreeOneCopyList(PIPE_MESSAGE_REF_COPY_LIST *par_CopyList)
     if (par_CopyList->pElems != NULL) {
         my_free (par_CopyList->pElems);
     }
+    if (par_CopyList->pVids != NULL) {
+        my_free (par_CopyList->pVids);
+    }
+    if (par_CopyList->pTypesPipe != NULL) {
+        my_free (par_CopyList->pTypesPipe);
+    }
+    if (par_CopyList->pWrSeqs != NULL) {
+        my_free (par_CopyList->pWrSeqs);
+    }
     STRUCT_ZERO_INIT(*par_CopyList, PIPE_MESSAGE_REF_COPY_LIST);
 }
 
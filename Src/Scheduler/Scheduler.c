@@ -373,6 +373,7 @@ static TASK_CONTROL_BLOCK *AllocAndInitTaskControlBlock (const char *ProcessName
         ThrowError (1, "out of memory!");
     } else {
         int Pid;
+        InitLatencyHistogram (&RetTcb->RuntimeHistogram);
         FreeTcb(NULL, FREE_TCB_CMD_DELETE_OLDER_AS_1S);  // cleanup all stored old TCBs
         Pid = GetOrFreeUniquePid (GENERATE_UNIQUE_PID_COMMAND, 0, ProcessName);
         if (Pid <= 0) {
@@ -477,6 +478,7 @@ PID start_process_timeout (const char *par_ProcessName, int par_Timeout, char **
 
     MEMCPY (pTcb, all_known_tasks[i], sizeof(TASK_CONTROL_BLOCK));
     pTcb->pid = PidSave;
+    InitLatencyHistogram (&pTcb->RuntimeHistogram);
 
 #ifndef REMOTE_MASTER
     if (s_main_ini_val.ConnectToRemoteMaster) {
@@ -527,7 +529,6 @@ PID start_process_timeout (const char *par_ProcessName, int par_Timeout, char **
         FreeTcb (pTcb, FREE_TCB_CMD_MARK_FOR_DELETION);
         return NO_FREE_ACCESS_MASK;
     }
-    get_free_wrflag (pTcb->pid, &pTcb->wr_flag_mask);
 
     ConnectProcessToAllAssociatedBarriers (pTcb,
                                            BarriersBeforeOnlySignal,
@@ -904,10 +905,46 @@ WAIT_LOOP:
         }
     }
     pSchedulerData->not_faster_than_real_time_old = s_main_ini_val.NotFasterThanRealTime;
+    pSchedulerData->CycleStartTimeInNanoSecond = GetTimeOfSystemIsRunning64 ();
+    if (s_main_ini_val.NotFasterThanRealTime) {
+        // The cycle should start if the system time reach the simulated time minus one period
+        uint64_t StartTime = pSchedulerData->SimulatedTimeInNanoSecond - pSchedulerData->TimeOffsetBetweenSimualtedAndRealTimeInNanoSecond - (uint64_t)pSchedulerData->SchedPeriodInNanoSecond;
+        if (pSchedulerData->CycleStartTimeInNanoSecond > StartTime) {
+            LatencyHistogramRecord (&pSchedulerData->WakeupLatency, pSchedulerData->CycleStartTimeInNanoSecond - StartTime);
+        } else {
+            LatencyHistogramRecord (&pSchedulerData->WakeupLatency, 0);
+        }
+    }
     CalculateRealtimeFactor (pSchedulerData);
     return 1;
 }
 
+static int AddSchedulerLatencyVariable (SCHEDULER_DATA *pSchedulerData, const char *par_Name, enum BB_DATA_TYPES par_Type, const char *par_Unit)
+{
+    char Help[MAX_SCHEDULER_NAME_LENGTH + 64];
+    int Vid;
+
+    if (pSchedulerData->SchedulerNr == 0) {
+        PrintFormatToString (Help, sizeof(Help), "%s%s", GetConfigurablePrefix(CONFIGURABLE_PREFIX_TYPE_LONG2_BLACKBOARD), par_Name);
+    } else {
+        PrintFormatToString (Help, sizeof(Help), "%s%s%s", GetConfigurablePrefix(CONFIGURABLE_PREFIX_TYPE_LONG2_BLACKBOARD), par_Name, pSchedulerData->SchedulerName);
+    }
+    Vid = add_bbvari (Help, par_Type, par_Unit);
+    if (Vid < 0) {
+        ThrowError (1, "cannot add blackboard variable %s %i", Help, Vid);
+    }
+    return Vid;
+}
+
+// Will be called once per simulated second from the scheduler thread
+static void ExportLatencyHistogramsToBlackboard (SCHEDULER_DATA *pSchedulerData)
+{
+    write_bbvari_double (pSchedulerData->WakeupLatencyP50Vid, (double)LatencyHistogramPercentile (&pSchedulerData->WakeupLatency, 50.0) / TIMERCLKFRQ);
+    write_bbvari_double (pSchedulerData->WakeupLatencyP99Vid, (double)LatencyHistogramPercentile (&pSchedulerData->WakeupLatency, 99.0) / TIMERCLKFRQ);
+    write_bbvari_double (pSchedulerData->WakeupLatencyMaxVid, (double)pSchedulerData->WakeupLatency.Max / TIMERCLKFRQ);
+    write_bbvari_udword (pSchedulerData->OverrunCounterVid, GetOverrunEventCount (&pSchedulerData->Overruns));
+}
+
 // This are arrays for each scheduler. Here will be stored all to start process till the scheduler are able to start them
 // Schedulers should only start process at the beginning or the end of a cycle.
 static TASK_CONTROL_BLOCK *AddProcessesToSchedPtrs[MAX_SCHEDULERS][MAX_PIDS];
@@ -1383,7 +1420,6 @@ int AddExternPorcessToScheduler (char *ProcessName, char *ExecutableName, int Pr
             FreeTcb (Tcb, FREE_TCB_CMD_MARK_FOR_DELETION);
             return -1;
         }
-        get_free_wrflag (Tcb->pid, &Tcb->wr_flag_mask);
         Tcb->ProcessId = ProcessId;
 
         InitWaitUntilProcessIsNotActive (Tcb);
@@ -1755,6 +1791,35 @@ static int CheckIfAllSchedulerHaveRecogizedTerminationRequest(SCHEDULER_DATA *pS
 }
 
 
+static void RecordProcessRuntime (SCHEDULER_DATA *pSchedulerData, TASK_CONTROL_BLOCK *pTcb, uint64_t par_StartTime)
+{
+    uint64_t EndTime = GetTimeOfSystemIsRunning64 ();
+    uint64_t Runtime = EndTime - par_StartTime;
+
+    pTcb->last_time = Runtime;
+    LatencyHistogramRecord (&pTcb->RuntimeHistogram, Runtime);
+    if (s_main_ini_val.NotFasterThanRealTime && (Runtime > (uint64_t)pSchedulerData->SchedPeriodInNanoSecond)) {
+        AddOverrunEvent (&pSchedulerData->Overruns, pSchedulerData->Cycle, EndTime, Runtime, pTcb->pid);
+    }
+}
+
+static void CheckCycleOverrun (SCHEDULER_DATA *pSchedulerData)
+{
+    if (pSchedulerData->IsMainScheduler) {
+        if (s_main_ini_val.NotFasterThanRealTime) {
+            uint64_t EndTime = GetTimeOfSystemIsRunning64 ();
+            uint64_t CycleRuntime = EndTime - pSchedulerData->CycleStartTimeInNanoSecond;
+            if (CycleRuntime > (uint64_t)pSchedulerData->SchedPeriodInNanoSecond) {
+                AddOverrunEvent (&pSchedulerData->Overruns, pSchedulerData->Cycle, EndTime, CycleRuntime, -1);
+            }
+        }
+        if (pSchedulerData->Cycle >= pSchedulerData->NextLatencyExportCycle) {
+            ExportLatencyHistogramsToBlackboard (pSchedulerData);
+            pSchedulerData->NextLatencyExportCycle = pSchedulerData->Cycle + (uint64_t)(1.0 / pSchedulerData->SchedPeriod);
+        }
+    }
+}
+
 #ifdef _WIN32
 static DWORD WINAPI SchedulerThreadProc (LPVOID lpParam);
 static DWORD WINAPI SchedulerThreadProcTryCatch (LPVOID lpParam)
@@ -1829,6 +1894,16 @@ static void *SchedulerThreadProc(void* lpParam)
     }
     write_bbvari_double (pSchedulerData->CycleDiffTimeVid, 0.0);
 
+    InitLatencyHistogram (&pSchedulerData->WakeupLatency);
+    MEMSET (&pSchedulerData->Overruns, 0, sizeof (pSchedulerData->Overruns));
+    pSchedulerData->NextLatencyExportCycle = 0;
+    if (pSchedulerData->IsMainScheduler) {
+        pSchedulerData->WakeupLatencyP50Vid = AddSchedulerLatencyVariable (pSchedulerData, "WakeupLatencyP50", BB_DOUBLE, "s");
+        pSchedulerData->WakeupLatencyP99Vid = AddSchedulerLatencyVariable (pSchedulerData, "WakeupLatencyP99", BB_DOUBLE, "s");
+        pSchedulerData->WakeupLatencyMaxVid = AddSchedulerLatencyVariable (pSchedulerData, "WakeupLatencyMax", BB_DOUBLE, "s");
+        pSchedulerData->OverrunCounterVid = AddSchedulerLatencyVariable (pSchedulerData, "OverrunCounter", BB_UDWORD, "");
+    }
+
     pSchedulerData->CurrentTcb = NULL;
     if (pSchedulerData->SchedulerNr == 0) {
         CycleCounterVid = pSchedulerData->CycleCounterVid; // The control panel will use this blackboard variable
@@ -1895,6 +1970,7 @@ static void *SchedulerThreadProc(void* lpParam)
                             case PROCESS_AKTIV:
                                 CurrentTcb->time_counter++;
                                 if (CurrentTcb->time_counter >= CurrentTcb->time_steps) {
+                                    uint64_t ProcessStartTime = GetTimeOfSystemIsRunning64 ();
                                     CurrentTcb->time_counter = 0;
                                     CurrentTcb->call_count++;
                                     if (CurrentTcb->Type == INTERN_ASYNC) {
@@ -1905,6 +1981,7 @@ static void *SchedulerThreadProc(void* lpParam)
                                         WalkThroughBarrierBehindProcess (CurrentTcb, 0, 0);
                                         ClacBehindProcessEquations (CurrentTcb);
                                         WalkThroughBarrierBehindProcess (CurrentTcb, 1, 0);
+                                        RecordProcessRuntime (pSchedulerData, CurrentTcb, ProcessStartTime);
                                     } else if (CurrentTcb->Type == EXTERN_ASYNC) {
                                         int Ret;
                                         int SnapShotSize;
@@ -1946,6 +2023,7 @@ static void *SchedulerThreadProc(void* lpParam)
                                         EndOfProcessCycle (CurrentTcb);
                                         WalkThroughBarrierBehindProcess (CurrentTcb, 1, (Ret != 0));
                                         CheckFetchDataAfterProcess(CurrentTcb->pid);
+                                        RecordProcessRuntime (pSchedulerData, CurrentTcb, ProcessStartTime);
                                         if (Ret) {
                                             RemoveExternProcessTerminateOrResetBBVariable (CurrentTcb->pid);
                                             // Ret == -2 if disconnect without terminate signal
@@ -2033,6 +2111,7 @@ static void *SchedulerThreadProc(void* lpParam)
                          pSchedulerData->CurrentTcb = CurrentTcb = NextTcb;
                     }
                 }
+                CheckCycleOverrun (pSchedulerData);
                 WalkThroughBarrierBehindEndOfSchedulerCycle (pSchedulerData, 0, 0, CheckProcessLoginToScheduler);
 
                 if (pSchedulerData->BarrierBeforeCount == 0) { // if the scheduler are not walked trow the barriers "before"
@@ -3319,6 +3398,44 @@ TASK_CONTROL_BLOCK *get_process_info (PID pid)
 }
 
 
+int GetSchedulerLatencyHistogramsAsString (char *ret_Buffer, int par_MaxChars)
+{
+    int x, Pos = 0;
+    char Name[MAX_SCHEDULER_NAME_LENGTH + sizeof(NAME_STRING) + 64];
+
+    if (par_MaxChars <= 0) return 0;
+    ret_Buffer[0] = 0;
+    EnterCriticalSection (&PipeSchedCriticalSection);
+    for (x = 0; x < SchedulerCount; x++) {
+        TASK_CONTROL_BLOCK *pTcb;
+        if (SchedulerData[x].IsMainScheduler) {
+            OVERRUN_EVENT Events[OVERRUN_EVENT_RING_SIZE];
+            int e, Count;
+            PrintFormatToString (Name, sizeof(Name), "scheduler \"%s\" wakeup latency", SchedulerData[x].SchedulerName);
+            Pos += LatencyHistogramToString (&SchedulerData[x].WakeupLatency, Name, ret_Buffer + Pos, par_MaxChars - Pos);
+            Count = GetOverrunEvents (&SchedulerData[x].Overruns, Events, OVERRUN_EVENT_RING_SIZE);
+            Pos += PrintFormatToString (ret_Buffer + Pos, par_MaxChars - Pos, "scheduler \"%s\" overruns: %u (last %i)\n",
+                                        SchedulerData[x].SchedulerName, GetOverrunEventCount (&SchedulerData[x].Overruns), Count);
+            for (e = 0; e < Count; e++) {
+                Pos += PrintFormatToString (ret_Buffer + Pos, par_MaxChars - Pos, "  cycle=%llu time=%llu duration=%llu pid=%i\n",
+                                            (unsigned long long)Events[e].Cycle, (unsigned long long)Events[e].TimeStamp,
+                                            (unsigned long long)Events[e].Duration, Events[e].Pid);
+            }
+        }
+        // Walk through all processes of this scheduler
+        for (pTcb = SchedulerData[x].FirstTcb; pTcb != NULL; pTcb = pTcb->next) {
+            PrintFormatToString (Name, sizeof(Name), "process \"%s\" (scheduler \"%s\") runtime", pTcb->name, SchedulerData[x].SchedulerName);
+            Pos += LatencyHistogramToString (&pTcb->RuntimeHistogram, Name, ret_Buffer + Pos, par_MaxChars - Pos);
+        }
+    }
+    LeaveCriticalSection (&PipeSchedCriticalSection);
+    if (s_main_ini_val.ConnectToRemoteMaster && (Pos < (par_MaxChars - 1))) {
+        int Len = rm_GetLatencyHistogramsAsString (ret_Buffer + Pos, par_MaxChars - Pos);
+        if (Len > 0) Pos += Len;
+    }
+    return Pos;
+}
+
 int get_process_info_ex (PID pid, char *ret_Name, int maxc_Name, int *ret_Type, int *ret_Prio, int *ret_Cycles, int *ret_Delay, int *ret_MessageSize,
                          char *ret_AssignedScheduler, int maxc_AssignedScheduler, uint64_t *ret_bb_access_mask,
                          int *ret_State, uint64_t *ret_CyclesCounter, uint64_t *ret_CyclesTime, uint64_t *ret_CyclesTimeMax, uint64_t *ret_CyclesTimeMin)
@@ -3352,9 +3469,10 @@ int get_process_info_ex (PID pid, char *ret_Name, int maxc_Name, int *ret_Type,
                 if (ret_bb_access_mask != NULL) *ret_bb_access_mask = pTcb->bb_access_mask;
                 if (ret_State != NULL) *ret_State = pTcb->state;
                 if (ret_CyclesCounter != NULL) *ret_CyclesCounter = pTcb->call_count;
-                if (ret_CyclesTime != NULL) *ret_CyclesTime = 0;
-                if (ret_CyclesTimeMax != NULL) *ret_CyclesTimeMax = 0;
-                if (ret_CyclesTimeMin != NULL) *ret_CyclesTimeMin = 0;
+                // same unit as the remote master (us)
+                if (ret_CyclesTime != NULL) *ret_CyclesTime = pTcb->last_time / 1000;
+                if (ret_CyclesTimeMax != NULL) *ret_CyclesTimeMax = pTcb->RuntimeHistogram.Max / 1000;
+                if (ret_CyclesTimeMin != NULL) *ret_CyclesTimeMin = (pTcb->RuntimeHistogram.TotalCount > 0) ? pTcb->RuntimeHistogram.Min / 1000 : 0;
 
                 LeaveCriticalSection (&PipeSchedCriticalSection);
                 return 0;
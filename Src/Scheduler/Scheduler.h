@@ -109,6 +109,16 @@ typedef struct SCHEDULER_DATA_STRUCT {
     int SchedulerHaveRecogizedTerminationRequeFlag;
 
     int CycleDiffTimeVid;
+
+    // Only the main scheduler measures the wakeup latency (if not faster than realtime is active)
+    LATENCY_HISTOGRAM WakeupLatency;
+    OVERRUN_EVENT_RING Overruns;
+    uint64_t CycleStartTimeInNanoSecond;
+    uint64_t NextLatencyExportCycle;
+    int WakeupLatencyP50Vid;
+    int WakeupLatencyP99Vid;
+    int WakeupLatencyMaxVid;
+    int OverrunCounterVid;
 } SCHEDULER_DATA;
 
 int GetSchedulerCount (void);
@@ -306,6 +316,10 @@ int IsExternProcess64BitExecutable (int Pid);
 int IsExternProcessLinuxExecutable (int Pid);
 int GetExternProcessMachineType (int Pid);
 
+// Summary and buckets of the wakeup latency and runtime histograms and the last overrun events as text
+// (inclusive the realtime schedulers and processes of the remote master if connected)
+int GetSchedulerLatencyHistogramsAsString (char *ret_Buffer, int par_MaxChars);
+
 char *GetSchedulerName (int par_Index);
 int GetSchedulerIndex (SCHEDULER_DATA *par_Scheduler);
 
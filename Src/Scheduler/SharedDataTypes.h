@@ -50,6 +50,12 @@ typedef struct {
     int SizeInBytes;
     unsigned long long RefUniqueIdCounter;  // This will be incremented by each reference by one. Size is 64 bit, this should be never overflow
     PIPE_MESSAGE_REF_COPY_LIST_ELEM *pElems;
+    // Dense copies of pElems[x].Vid and pElems[x].TypePipe for the batched blackboard
+    // access (only maintained by the scheduler copy lists ScBbCopyLists.c)
+    int *pVids;
+    short *pTypesPipe;
+    // Write sequence numbers of the write lists before the process was called (see SnapshotWriteListWrSeqs)
+    uint32_t *pWrSeqs;
 } PIPE_MESSAGE_REF_COPY_LIST;
 
 typedef struct {
@@ -25,6 +25,7 @@
 
 #include "SharedDataTypes.h"
 #include "PipeMessagesShared.h"
+#include "LatencyHistogram.h"
 
 /*************************************************************************
 *                          constants and macros
@@ -90,7 +91,6 @@ typedef struct TCB {                 // Task control block
     int32_t vid_time;
     uint64_t call_count;        // Number of cyclic calles
     uint64_t bb_access_mask;    // Maske for blackboard access
-    uint64_t wr_flag_mask;      // Maske for blackboard write flags
     short BeforeProcessEquationCounter;
     PROC_EXEC_STACK *BeforeProcessEquations;
     short BehindProcessEquationCounter;
@@ -190,6 +190,9 @@ typedef struct TCB {                 // Task control block
     int A2LLinkNr;
 
     CRITICAL_SECTION CriticalSection;
+
+    // Distribution of the runtime of the cyclic function (inclusive the communication to external processes)
+    LATENCY_HISTOGRAM RuntimeHistogram;
 } TASK_CONTROL_BLOCK;
 
 #ifdef _WIN32
@@ -227,7 +230,6 @@ typedef struct TCB {                 // Task control block
         -1,                       /* Time variabele ID */ \
         0,                        /* Number of cyclic calles */ \
         0,                        /* Maske for blackboard access */ \
-        0,                        /* Maske for blackboard write flags */ \
         0,                        /* BeforeProcessEquationCounter */ \
         NULL,                     /* BeforeProcessEquations */ \
         0,                        /* BehindProcessEquationCounter */ \
@@ -249,11 +251,11 @@ typedef struct TCB {                 // Task control block
         0,                        /* UseDebugInterfaceForRead */ \
 \
         0,                        /* wait_on */ \
-        {{0,0,0,0,NULL}, \
-         {0,0,0,0,NULL},{0,0,0,0,NULL}, \
-         {0,0,0,0,NULL},{0,0,0,0,NULL}, \
-         {0,0,0,0,NULL},{0,0,0,0,NULL}, \
-         {0,0,0,0,NULL},{0,0,0,0,NULL}}, /* CopyLists */ \
+        {{0,0,0,0,NULL,NULL,NULL,NULL}, \
+         {0,0,0,0,NULL,NULL,NULL,NULL},{0,0,0,0,NULL,NULL,NULL,NULL}, \
+         {0,0,0,0,NULL,NULL,NULL,NULL},{0,0,0,0,NULL,NULL,NULL,NULL}, \
+         {0,0,0,0,NULL,NULL,NULL,NULL},{0,0,0,0,NULL,NULL,NULL,NULL}, \
+         {0,0,0,0,NULL,NULL,NULL,NULL},{0,0,0,0,NULL,NULL,NULL,NULL}}, /* CopyLists */ \
 \
         0,                        /* BarrierBehindCount */ \
         {0,0,0,0,0,0,0,0},        /* BarrierBehindNr[8] */ \
@@ -306,7 +308,8 @@ typedef struct TCB {                 // Task control block
         {0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0},  /* VirtualNetworkHandles[16] */ \
         0,                         /* VirtualNetworkHandleCount */ \
         0,                         /* A2LLinkNr */ \
-        CRITICAL_SECTION_INITIALIZER \
+        CRITICAL_SECTION_INITIALIZER, \
+        {{0}, 0, 0, 0, 0, 0}      /* RuntimeHistogram */ \
     }
 
 #endif
@@ -79,6 +79,7 @@ int cAddBbvariCmd::Execute (cParser *par_Parser, cExecutor *par_Executor)
     } else {
         // Check if there is a INI file entry for this variable
         char tmp[INI_MAX_LINE_LENGTH]; 
+        flush_varinfos_to_ini();
         if (IniFileDataBaseReadString (VARI_SECTION, par_Parser->GetParameter (0),
                                        "", tmp, sizeof (tmp), GetMainFileDescriptor()) == 0) {
             unit = s_main_ini_val.Script_ADD_BBVARI_DefaultUnit; // "USER";
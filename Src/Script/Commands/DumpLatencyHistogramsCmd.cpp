@@ -0,0 +1,85 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "Platform.h"
+#include <stdio.h>
+
+extern "C" {
+#include "MyMemory.h"
+#include "Files.h"
+#include "Scheduler.h"
+#include "InterfaceToScript.h"
+}
+#include "Parser.h"
+#include "BaseCmd.h"
+
+#define DUMP_BUFFER_SIZE  (1024*1024)
+
+DEFINE_CMD_CLASS(cDumpLatencyHistogramsCmd)
+
+
+int cDumpLatencyHistogramsCmd::SyntaxCheck (cParser *par_Parser)
+{
+    UNUSED(par_Parser);
+    return 0;
+}
+
+int cDumpLatencyHistogramsCmd::Execute (cParser *par_Parser, cExecutor *par_Executor)
+{
+    UNUSED(par_Executor);
+    char Path[MAX_PATH];
+    char *Buffer;
+    FILE *fh;
+
+    strncpy (Path, par_Parser->GetParameter (0), MAX_PATH);
+    Path[MAX_PATH-1] = 0;
+    ScriptIdentifyPath (Path);
+    Buffer = static_cast<char*>(my_malloc (DUMP_BUFFER_SIZE));
+    if (Buffer == nullptr) {
+        par_Parser->Error (SCRIPT_PARSER_FATAL_ERROR, "out of memory");
+        return -1;
+    }
+    GetSchedulerLatencyHistogramsAsString (Buffer, DUMP_BUFFER_SIZE);
+    fh = open_file (Path, "wt");
+    if (fh == nullptr) {
+        par_Parser->Error (SCRIPT_PARSER_FATAL_ERROR, "cannot open file \"%s\"", Path);
+        my_free (Buffer);
+        return -1;
+    }
+    fputs (Buffer, fh);
+    close_file (fh);
+    my_free (Buffer);
+    return 0;
+}
+
+int cDumpLatencyHistogramsCmd::Wait (cParser *par_Parser, cExecutor *par_Executor, int Cycles)
+{
+    UNUSED(par_Parser);
+    UNUSED(par_Executor);
+    UNUSED(Cycles);
+    return 0;
+}
+
+static cDumpLatencyHistogramsCmd DumpLatencyHistogramsCmd ("DUMP_LATENCY_HISTOGRAMS",
+                                                           1,
+                                                           1,
+                                                           nullptr,
+                                                           FALSE,
+                                                           FALSE,
+                                                           0,
+                                                           0,
+                                                           CMD_INSIDE_ATOMIC_ALLOWED);
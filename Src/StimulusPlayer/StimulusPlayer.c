@@ -21,6 +21,7 @@
 #include "Config.h"
 #include "ConfigurablePrefix.h"
 #include "StimulusReadFile.h"
+#include "StimulusReadAhead.h"
 #include "StimulusPlayer.h"
 #include "WriteToBlackboardPipe.h"
 #include "ReadFromBlackboardPipe.h"
@@ -36,6 +37,8 @@
 #include "BlackboardAccess.h"
 
 #define PING_LIMIT  100000
+// Wait max. this time for the first time slots before the playing starts
+#define READ_AHEAD_PREFILL_TIMEOUT_MS  1000
 
 typedef struct {
     int *vids;
@@ -45,8 +48,12 @@ typedef struct {
     uint64_t sample_number;
     int varicount;
     int wrpipe_pid;
-    VARI_IN_PIPE *pipevari_list;
+    VARI_IN_PIPE *pipevari_list;   // points into the read ahead ring
     uint64_t current_sample_time;
+    uint64_t start_time;   // playback starts at this time offset inside the file
+    STIMULI_READ_AHEAD *read_ahead;
+    int read_ahead_slots;
+    int read_ahead_starved;   // the read ahead thread was behind, retry inside the next cycle
     int file_status;
     int pipe_status;
     int use_a_config_file;
@@ -62,6 +69,7 @@ typedef struct {
     int should_send_ping_message;
 
     int vid_hdplay_state;
+    int vid_read_ahead_underruns;   // how often the read ahead thread was behind during the actual playback
 } STIMULUS_PLAYER_DATA;
 
 
@@ -131,23 +139,51 @@ static int WriteOnSamplesToFiFo(STIMULUS_PLAYER_DATA *StimulusData)
 
 static void ReadNSamplesFromFileAndWriteItToFiFo(STIMULUS_PLAYER_DATA *StimulusData, int par_MaxSampleCount)
 {
-    int x = 0;
-
-    if (StimulusData->file == NULL) return;
+    int x;
 
-    if (StimulusData->pipe_status) {  // There was before a pipe overflow
-        WriteOnSamplesToFiFo(StimulusData);
-        x = 1;
-    }
+    if ((StimulusData->file == NULL) || (StimulusData->read_ahead == NULL)) return;
 
-    for (; (x < par_MaxSampleCount) && (StimulusData->pipe_status == 0); x++) {  /* Write max. N data messages  */
-        StimulusData->file_status = ReadOneStimuliTimeSlot (StimulusData->file, StimulusData->pipevari_list, &StimulusData->current_sample_time);
+    StimulusData->read_ahead_starved = 0;
+    // The file will be read and decoded by the read ahead thread, here only the ready time slots will be taken.
+    // A slot stays inside the ring till it is written into the FIFO, so after a pipe overflow it will be send again
+    for (x = 0; x < par_MaxSampleCount; x++) {  /* Write max. N data messages  */
+        StimulusData->file_status = PeekStimuliReadAhead (StimulusData->read_ahead, &StimulusData->pipevari_list, &StimulusData->current_sample_time);
+        if (StimulusData->file_status == STIMULI_READ_AHEAD_EMPTY) {
+            StimulusData->read_ahead_starved = 1;
+            break;
+        }
+        // the first played sample should have the time 0 (the read ahead thread gives the end of file the time of the last sample)
+        if (StimulusData->current_sample_time >= StimulusData->start_time) {
+            StimulusData->current_sample_time -= StimulusData->start_time;
+        }
         if (WriteOnSamplesToFiFo(StimulusData)) {
             /* File end */
             break;
         }
+        if (StimulusData->pipe_status) {
+            break;
+        }
+        ReleaseStimuliReadAhead (StimulusData->read_ahead);
         StimulusData->sample_number++;
     }
+    if (StimulusData->read_ahead_starved) {
+        write_bbvari_udword (StimulusData->vid_read_ahead_underruns, (uint32_t)StimulusData->read_ahead->Underruns);
+    }
+}
+
+static void CloseStimulusPlayerFile(STIMULUS_PLAYER_DATA *StimulusData)
+{
+    // first stop the read ahead thread, it accesses the file
+    if (StimulusData->read_ahead != NULL) {
+        StopStimuliReadAhead (StimulusData->read_ahead);
+        StimulusData->read_ahead = NULL;
+    }
+    if (StimulusData->file != NULL) {
+        CloseStimuliFile (StimulusData->file);
+        StimulusData->file = NULL;
+    }
+    StimulusData->pipevari_list = NULL;
+    StimulusData->read_ahead_starved = 0;
 }
 
 void cyclic_hdplay (void)
@@ -173,6 +209,8 @@ void cyclic_hdplay (void)
                     int config_file_line_counter;
 
                     StimulusData.vari_list = NULL;
+                    StimulusData.start_time = 0;
+                    StimulusData.read_ahead_slots = 0;
                     if (StimulusData.player_status != HDPLAY_SLEEP) {
                         ThrowError (1, "HD-Player not in sleep mode");
                         remove_message ();
@@ -230,6 +268,38 @@ void cyclic_hdplay (void)
                                 }
                                 SSCANF_ERR_NRV (word, "%lf", &(trigger_info.trigger_value));
                                 break;
+                            case HDPLAYER_START_TIME_TOKEN:
+                                // the = is optional
+                                token = read_token (fh, word, sizeof(word)-1, &config_file_line_counter);
+                                if (token == EQUAL_TOKEN) {
+                                    token = read_token (fh, word, sizeof(word)-1, &config_file_line_counter);
+                                }
+                                if (token != 0) {
+                                    ThrowError (1, "inside file %s(%i):\n"
+                                              "   expecting a number in HDPLAYER_START_TIME statement",
+                                           filename, config_file_line_counter);
+                                    goto ERROR_IN_CONFIGFILE;
+                                }
+                                {
+                                    double StartTime;
+                                    SSCANF_ERR_NRV (word, "%lf", &StartTime);
+                                    StimulusData.start_time = (StartTime > 0.0) ? (uint64_t)(StartTime * TIMERCLKFRQ) : 0;
+                                }
+                                break;
+                            case HDPLAYER_READ_AHEAD_SLOTS_TOKEN:
+                                // the = is optional
+                                token = read_token (fh, word, sizeof(word)-1, &config_file_line_counter);
+                                if (token == EQUAL_TOKEN) {
+                                    token = read_token (fh, word, sizeof(word)-1, &config_file_line_counter);
+                                }
+                                if (token != 0) {
+                                    ThrowError (1, "inside file %s(%i):\n"
+                                              "   expecting a number in HDPLAYER_READ_AHEAD_SLOTS statement",
+                                           filename, config_file_line_counter);
+                                    goto ERROR_IN_CONFIGFILE;
+                                }
+                                SSCANF_ERR_NRV (word, "%i", &StimulusData.read_ahead_slots);
+                                break;
                             case STARTVARLIST_TOKEN:
                                 vlpc = 1024;  // Start with 1024 bytes
                                 pos = 0;
@@ -292,6 +362,8 @@ void cyclic_hdplay (void)
                 break;
             case HDPLAY_FILENAME_MESSAGE:   /* Message contains file name */
                 StimulusData.use_a_config_file = 0;
+                StimulusData.start_time = 0;
+                StimulusData.read_ahead_slots = 0;
                 if (StimulusData.player_status != HDPLAY_SLEEP) {
                     ThrowError (1, "Stimulus player not in sleep mode");
                     remove_message ();
@@ -312,21 +384,25 @@ void cyclic_hdplay (void)
                 StimulusData.vids = GetStimuliVariableIds(StimulusData.file);
                 StimulusData.varicount = GetNumberOfStimuliVariables(StimulusData.file);
 
-                StimulusData.pipevari_list = (VARI_IN_PIPE*)my_malloc(sizeof(VARI_IN_PIPE) * StimulusData.varicount);
-                if (StimulusData.pipevari_list == NULL) {
-                    ThrowError (1, "out of memory", PN_STIMULI_QUEUE);
-                    CloseStimuliFile (StimulusData.file);
-                    StimulusData.file = NULL;
-                    break;
+                /* Jump over the part of the file before the start time */
+                if (StimulusData.start_time > 0) {
+                    if (SeekStimuliFile (StimulusData.file, StimulusData.start_time)) {
+                        ThrowError (1, "cannot start playing \"%s\" at %g s", StimulusData.play_file_name, (double)StimulusData.start_time / TIMERCLKFRQ);
+                        CloseStimulusPlayerFile (&StimulusData);
+                        break;
+                    }
                 }
                 if ((StimulusData.wrpipe_pid = get_pid_by_name (PN_STIMULI_QUEUE)) <= 0) {
                     ThrowError (1, "\"%s\" process not running", PN_STIMULI_QUEUE);
-                    CloseStimuliFile (StimulusData.file);
-                    StimulusData.file = NULL;
-                    if (StimulusData.pipevari_list == NULL) my_free (StimulusData.pipevari_list);
-                    StimulusData.pipevari_list = NULL;
+                    CloseStimulusPlayerFile (&StimulusData);
+                    break;
+                }
+                /* From now on the file will be read by the read ahead thread */
+                if ((StimulusData.read_ahead = StartStimuliReadAhead (StimulusData.file, StimulusData.varicount, StimulusData.read_ahead_slots)) == NULL) {
+                    CloseStimulusPlayerFile (&StimulusData);
                     break;
                 }
+                write_bbvari_udword (StimulusData.vid_read_ahead_underruns, 0);
                 /* transmit the VID's to the WRPIPE process */
                 WriteToFiFoOrMessageQueue (&StimulusData, SEND_VIDS_MESSAGE,
                                (int)sizeof (int) * StimulusData.varicount, (char*)(StimulusData.vids));
@@ -342,7 +418,8 @@ void cyclic_hdplay (void)
 
                 StimulusData.player_status = HDPLAY_FILE_NAME;
 
-                /* Write some data messages immediately */
+                /* Write some data messages immediately, but give the read ahead thread a chance to fill the half of the ring before */
+                WaitForStimuliReadAhead (StimulusData.read_ahead, (int)(StimulusData.read_ahead->SlotCount >> 1), READ_AHEAD_PREFILL_TIMEOUT_MS);
                 ReadNSamplesFromFileAndWriteItToFiFo(&StimulusData, PING_LIMIT);
                 break;
             case HDPLAY_STOP_MESSAGE:  /* Terminate HD-Player without waiting
@@ -391,14 +468,7 @@ void cyclic_hdplay (void)
             for (x = 0; StimulusData.vids[x] != 0; x++) {
                 if (StimulusData.vids[x] > 0) remove_bbvari (StimulusData.vids[x]);
             }
-            if (StimulusData.file != NULL) {
-                CloseStimuliFile (StimulusData.file);
-                StimulusData.file = NULL;
-            }
-            if (StimulusData.pipevari_list == NULL) {
-                my_free (StimulusData.pipevari_list);
-                StimulusData.pipevari_list = NULL;
-            }
+            CloseStimulusPlayerFile (&StimulusData);
             write_bbvari_ubyte (StimulusData.vid_hdplay_state, 0);
             StimulusData.player_status = HDPLAY_SLEEP;
             break;
@@ -407,11 +477,16 @@ void cyclic_hdplay (void)
                    Header.MessageId, Header.TramsmiterPid);
             RemoveOneMessageFromFiFo (StimulusData.ControlReqFiFo);
         }
+    } else if (StimulusData.read_ahead_starved) {
+        // The read ahead thread had no ready slot during the last ping, the WRPIPE will not send a new ping
+        ReadNSamplesFromFileAndWriteItToFiFo(&StimulusData, PING_LIMIT);
     }
 }
 
 int init_hdplay (void)
 {
+    char Name[BBVARI_NAME_SIZE];
+
     StimulusData.ControlAckFiFo = CreateNewRxFifo (GET_PID(), 1024, WRITE_PIPE_ACK_FIFO_NAME);
 
     StimulusData.my_pid = GET_PID();
@@ -423,6 +498,8 @@ int init_hdplay (void)
     }
     set_bbvari_conversion (StimulusData.vid_hdplay_state, 2, "0 0 \"Sleep\"; 1 1 \"Trigger\"; 2 2 \"Play\";");
     write_bbvari_ubyte (StimulusData.vid_hdplay_state, 0);
+    StimulusData.vid_read_ahead_underruns = add_bbvari (ExtendsWithConfigurablePrefix(CONFIGURABLE_PREFIX_TYPE_STIMULUS_PLAYER, ".ReadAheadUnderruns", Name, sizeof(Name)),
+                                                        BB_UDWORD, "[]");
 
     StimulusData.player_status = HDPLAY_SLEEP;
     return 0;
@@ -432,6 +509,7 @@ void terminate_hdplay (void)
 {
     DeleteFiFo (StimulusData.ControlAckFiFo, GET_PID());
     remove_bbvari (StimulusData.vid_hdplay_state);
+    remove_bbvari (StimulusData.vid_read_ahead_underruns);
 }
 
 TASK_CONTROL_BLOCK hdplay_tcb
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include "Platform.h"
+#include "ThrowError.h"
+#include "MyMemory.h"
+#include "AtomicAccess.h"
+#include "StimulusReadFile.h"
+#include "StimulusReadAhead.h"
+
+// The worker waits with this timeout, so a lost wakeup costs not more than this
+#define READ_AHEAD_WAIT_TIMEOUT_MS  10
+
+static uint32_t FilledSlots (STIMULI_READ_AHEAD *par_ReadAhead, uint32_t par_WritePos)
+{
+    return par_WritePos - ATOMIC_LOAD_ACQUIRE_U32 (&par_ReadAhead->ReadPos);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI StimuliReadAheadThreadFunc (LPVOID lpParam)
+#else
+static void* StimuliReadAheadThreadFunc (void* lpParam)
+#endif
+{
+    STIMULI_READ_AHEAD *ReadAhead = (STIMULI_READ_AHEAD*)lpParam;
+    uint32_t Mask = ReadAhead->SlotCount - 1;
+    uint32_t WritePos = ReadAhead->WritePos;
+    uint64_t LastTime = 0;
+
+    while (!ATOMIC_LOAD_ACQUIRE_U32 (&ReadAhead->StopRequest)) {
+        STIMULI_READ_AHEAD_SLOT *Slot;
+        if (FilledSlots (ReadAhead, WritePos) >= ReadAhead->SlotCount) {
+            // All slots are filled, sleep till the half is consumed so the file will be read in larger pieces
+            EnterCriticalSection (&ReadAhead->CriticalSection);
+            ATOMIC_STORE_SEQ_CST_U32 (&ReadAhead->WorkerWaits, 1);
+            while ((FilledSlots (ReadAhead, WritePos) > (ReadAhead->SlotCount >> 1)) &&
+                   !ATOMIC_LOAD_ACQUIRE_U32 (&ReadAhead->StopRequest)) {
+                SleepConditionVariableCS (&ReadAhead->ConditionVariable, &ReadAhead->CriticalSection, READ_AHEAD_WAIT_TIMEOUT_MS);
+            }
+            ATOMIC_STORE_RELEASE_U32 (&ReadAhead->WorkerWaits, 0);
+            LeaveCriticalSection (&ReadAhead->CriticalSection);
+            continue;
+        }
+        Slot = &(ReadAhead->Slots[WritePos & Mask]);
+        // the MDF readers will not set the time at the file end
+        Slot->Time = LastTime;
+        Slot->ValueCount = ReadOneStimuliTimeSlot (ReadAhead->File,
+                                                   ReadAhead->Values + (size_t)(WritePos & Mask) * (size_t)ReadAhead->VariCount,
+                                                   &(Slot->Time));
+        LastTime = Slot->Time;
+        WritePos++;
+        ATOMIC_STORE_RELEASE_U32 (&ReadAhead->WritePos, WritePos);
+        if (Slot->ValueCount == STIMULI_END_OF_FILE) {
+            break;   // nothing more to read
+        }
+    }
+    ATOMIC_STORE_RELEASE_U32 (&ReadAhead->WorkerStopped, 1);
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+STIMULI_READ_AHEAD *StartStimuliReadAhead (STIMULI_FILE *par_File, int par_VariCount, int par_SlotCount)
+{
+    STIMULI_READ_AHEAD *Ret;
+    uint32_t SlotCount, MaxSlots;
+    size_t SizeOfOneSlot;
+#ifdef _WIN32
+    DWORD ThreadId;
+#else
+    pthread_attr_t Attr;
+#endif
+
+    if (par_SlotCount <= 0) par_SlotCount = STIMULI_READ_AHEAD_DEFAULT_SLOTS;
+    SizeOfOneSlot = sizeof (VARI_IN_PIPE) * (size_t)((par_VariCount > 0) ? par_VariCount : 1);
+    MaxSlots = (uint32_t)(STIMULI_READ_AHEAD_MAX_MEMORY / SizeOfOneSlot);
+    if ((uint32_t)par_SlotCount < MaxSlots) MaxSlots = (uint32_t)par_SlotCount;
+    // 2^n slots, at least 2 (the worker refills the ring if the half is consumed).
+    // Large files get less slots, the memory limit will be never exceeded
+    if (MaxSlots < 2) {
+        ThrowError (1, "stimulus file with %i variables needs more than %i bytes for the read ahead ring",
+                    par_VariCount, STIMULI_READ_AHEAD_MAX_MEMORY);
+        return NULL;
+    }
+    for (SlotCount = 2; (SlotCount << 1) <= MaxSlots; SlotCount <<= 1);
+
+    Ret = (STIMULI_READ_AHEAD*)my_calloc (1, sizeof (STIMULI_READ_AHEAD));
+    if (Ret == NULL) {
+        ThrowError (1, "out of memory");
+        return NULL;
+    }
+    Ret->File = par_File;
+    Ret->VariCount = par_VariCount;
+    Ret->SlotCount = SlotCount;
+    Ret->Slots = (STIMULI_READ_AHEAD_SLOT*)my_calloc (SlotCount, sizeof (STIMULI_READ_AHEAD_SLOT));
+    Ret->Values = (VARI_IN_PIPE*)my_malloc (SlotCount * SizeOfOneSlot);
+    if ((Ret->Slots == NULL) || (Ret->Values == NULL)) {
+        ThrowError (1, "out of memory");
+        goto __ERROR;
+    }
+    InitializeCriticalSection (&Ret->CriticalSection);
+    InitializeConditionVariable (&Ret->ConditionVariable);
+
+#ifdef _WIN32
+    Ret->Thread = CreateThread (NULL,              // no security attribute
+                                0,                 // default stack size
+                                StimuliReadAheadThreadFunc,    // thread proc
+                                (void*)Ret,        // thread parameter
+                                0,                 // not suspended
+                                &ThreadId);        // returns thread ID
+    if (Ret->Thread == NULL) {
+        ThrowError (1, "cannot create stimulus read ahead thread");
+        DeleteCriticalSection (&Ret->CriticalSection);
+        goto __ERROR;
+    }
+#else
+    pthread_attr_init (&Attr);
+    if (pthread_create (&Ret->Thread, &Attr, StimuliReadAheadThreadFunc, (void*)Ret) != 0) {
+        pthread_attr_destroy (&Attr);
+        ThrowError (1, "cannot create stimulus read ahead thread");
+        DeleteCriticalSection (&Ret->CriticalSection);
+        goto __ERROR;
+    }
+    pthread_attr_destroy (&Attr);
+#endif
+    return Ret;
+__ERROR:
+    if (Ret->Slots != NULL) my_free (Ret->Slots);
+    if (Ret->Values != NULL) my_free (Ret->Values);
+    my_free (Ret);
+    return NULL;
+}
+
+int WaitForStimuliReadAhead (STIMULI_READ_AHEAD *par_ReadAhead, int par_MinSlots, int par_TimeoutMs)
+{
+    int x;
+
+    if ((uint32_t)par_MinSlots > par_ReadAhead->SlotCount) par_MinSlots = (int)par_ReadAhead->SlotCount;
+    for (x = 0; x < par_TimeoutMs; x++) {
+        if (FilledSlots (par_ReadAhead, ATOMIC_LOAD_ACQUIRE_U32 (&par_ReadAhead->WritePos)) >= (uint32_t)par_MinSlots) return 0;
+        if (ATOMIC_LOAD_ACQUIRE_U32 (&par_ReadAhead->WorkerStopped)) return 0;
+        Sleep (1);
+    }
+    return -1;
+}
+
+int PeekStimuliReadAhead (STIMULI_READ_AHEAD *par_ReadAhead, VARI_IN_PIPE **ret_Values, uint64_t *ret_Time)
+{
+    uint32_t ReadPos = par_ReadAhead->ReadPos;   // only this thread will change it
+    uint32_t Index;
+
+    if (ReadPos == ATOMIC_LOAD_ACQUIRE_U32 (&par_ReadAhead->WritePos)) {
+        if (!ATOMIC_LOAD_ACQUIRE_U32 (&par_ReadAhead->WorkerStopped)) par_ReadAhead->Underruns++;
+        return STIMULI_READ_AHEAD_EMPTY;
+    }
+    Index = ReadPos & (par_ReadAhead->SlotCount - 1);
+    *ret_Values = par_ReadAhead->Values + (size_t)Index * (size_t)par_ReadAhead->VariCount;
+    *ret_Time = par_ReadAhead->Slots[Index].Time;
+    return par_ReadAhead->Slots[Index].ValueCount;
+}
+
+void ReleaseStimuliReadAhead (STIMULI_READ_AHEAD *par_ReadAhead)
+{
+    uint32_t ReadPos = par_ReadAhead->ReadPos + 1;
+
+    ATOMIC_STORE_SEQ_CST_U32 (&par_ReadAhead->ReadPos, ReadPos);
+    // Wake up the worker only if it sleeps and the half of the ring is free, this will not block
+    if (ATOMIC_LOAD_ACQUIRE_U32 (&par_ReadAhead->WorkerWaits) &&
+        ((ATOMIC_LOAD_ACQUIRE_U32 (&par_ReadAhead->WritePos) - ReadPos) <= (par_ReadAhead->SlotCount >> 1))) {
+        WakeAllConditionVariable (&par_ReadAhead->ConditionVariable);
+    }
+}
+
+void StopStimuliReadAhead (STIMULI_READ_AHEAD *par_ReadAhead)
+{
+    if (par_ReadAhead == NULL) return;
+    ATOMIC_STORE_SEQ_CST_U32 (&par_ReadAhead->StopRequest, 1);
+    EnterCriticalSection (&par_ReadAhead->CriticalSection);
+    WakeAllConditionVariable (&par_ReadAhead->ConditionVariable);
+    LeaveCriticalSection (&par_ReadAhead->CriticalSection);
+    // the worker can be inside a file read, wait till it is finished before the file will be closed
+#ifdef _WIN32
+    WaitForSingleObject (par_ReadAhead->Thread, INFINITE);
+    CloseHandle (par_ReadAhead->Thread);
+#else
+    pthread_join (par_ReadAhead->Thread, NULL);
+#endif
+    DeleteCriticalSection (&par_ReadAhead->CriticalSection);
+    my_free (par_ReadAhead->Slots);
+    my_free (par_ReadAhead->Values);
+    my_free (par_ReadAhead);
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef STIMULUSREADAHEAD_H
+#define STIMULUSREADAHEAD_H
+
+#include <stdint.h>
+#include "Platform.h"
+#include "ReadFromBlackboardPipe.h"
+#include "StimulusReadFile.h"
+
+// A worker thread reads and decodes the time slots of a stimulus file into a ring,
+// the scheduler thread only takes the ready slots out of it (one reader, one writer, lock-free).
+
+#define STIMULI_READ_AHEAD_DEFAULT_SLOTS  4096
+#define STIMULI_READ_AHEAD_MAX_MEMORY     (64*1024*1024)
+
+// Returned by PeekStimuliReadAhead() if the worker thread is behind
+#define STIMULI_READ_AHEAD_EMPTY  (-2)
+
+typedef struct {
+    uint64_t Time;
+    int ValueCount;     // or STIMULI_END_OF_FILE
+    int Fill1;
+} STIMULI_READ_AHEAD_SLOT;
+
+typedef struct {
+    STIMULI_FILE *File;
+    int VariCount;
+    uint32_t SlotCount;    // 2^n
+    STIMULI_READ_AHEAD_SLOT *Slots;
+    VARI_IN_PIPE *Values;  // SlotCount * VariCount
+
+    uint32_t WritePos;     // only written by the worker thread
+    uint32_t ReadPos;      // only written by the scheduler thread
+    uint32_t StopRequest;
+    uint32_t WorkerWaits;
+    uint32_t WorkerStopped;
+
+    uint64_t Underruns;    // the scheduler thread found no ready slot before the file end
+
+    CRITICAL_SECTION CriticalSection;
+    CONDITION_VARIABLE ConditionVariable;
+#ifdef _WIN32
+    HANDLE Thread;
+#else
+    pthread_t Thread;
+#endif
+} STIMULI_READ_AHEAD;
+
+// par_SlotCount <= 0 use STIMULI_READ_AHEAD_DEFAULT_SLOTS, it will be limited to STIMULI_READ_AHEAD_MAX_MEMORY
+// (rounded down to 2^n, at least 2 slots).
+// The file belongs to the worker thread till StopStimuliReadAhead() is called.
+STIMULI_READ_AHEAD *StartStimuliReadAhead (STIMULI_FILE *par_File, int par_VariCount, int par_SlotCount);
+
+// Wait till par_MinSlots are ready, the file end is reached or par_TimeoutMs is elapsed (only used before the playing starts)
+int WaitForStimuliReadAhead (STIMULI_READ_AHEAD *par_ReadAhead, int par_MinSlots, int par_TimeoutMs);
+
+// Returns the value count of the oldest ready slot (STIMULI_END_OF_FILE at the file end) or STIMULI_READ_AHEAD_EMPTY.
+// The slot stays inside the ring till ReleaseStimuliReadAhead() is called
+int PeekStimuliReadAhead (STIMULI_READ_AHEAD *par_ReadAhead, VARI_IN_PIPE **ret_Values, uint64_t *ret_Time);
+void ReleaseStimuliReadAhead (STIMULI_READ_AHEAD *par_ReadAhead);
+
+// Stops the worker thread and free the ring, the file will not be closed
+void StopStimuliReadAhead (STIMULI_READ_AHEAD *par_ReadAhead);
+
+#endif // STIMULUSREADAHEAD_H
@@ -0,0 +1,630 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "Config.h"
+#include "Platform.h"
+#include "Files.h"
+#include "ReadFromBlackboardPipe.h"
+#include "TraceRecorder.h"
+#include "Blackboard.h"
+#include "MyMemory.h"
+#include "StringMaxChar.h"
+#include "EnvironmentVariables.h"
+#include "ThrowError.h"
+#include "StimulusReadFile.h"
+#include "ColumnFileStructs.h"
+#include "BlackboardConvertFromTo.h"
+#include "StimulusReadColumnFile.h"
+
+
+static int ReadFromColumnFile(COLUMN_FILE_INDEX *par_Index, uint64_t par_Offset, void *ret_Data, uint64_t par_Size)
+{
+    if ((par_Offset + par_Size) > par_Index->SizeOfFile) return -1;
+    my_lseek(par_Index->fh, par_Offset);
+    while (par_Size > 0) {
+        unsigned int Size = (par_Size > 0x40000000) ? 0x40000000 : (unsigned int)par_Size;
+        if (my_read(par_Index->fh, ret_Data, Size) != (int)Size) return -1;
+        ret_Data = (char*)ret_Data + Size;
+        par_Size -= Size;
+    }
+    return 0;
+}
+
+static void CloseColumnFileIndex(COLUMN_FILE_INDEX *par_Index)
+{
+    if (par_Index->fh != MY_INVALID_HANDLE_VALUE) my_close(par_Index->fh);
+    par_Index->fh = MY_INVALID_HANDLE_VALUE;
+    if (par_Index->Strings != NULL) my_free(par_Index->Strings);
+    par_Index->Strings = NULL;
+    if (par_Index->Signals != NULL) my_free(par_Index->Signals);
+    par_Index->Signals = NULL;
+    if (par_Index->Chunks != NULL) {
+        uint32_t x;
+        for (x = 0; x <= par_Index->Trailer.SignalCount; x++) {
+            if (par_Index->Chunks[x] != NULL) my_free(par_Index->Chunks[x]);
+        }
+        my_free(par_Index->Chunks);
+    }
+    par_Index->Chunks = NULL;
+}
+
+// Load the index entries of one signal (-1 is the time) for all groups
+static int LoadColumnChunkIndex(COLUMN_FILE_INDEX *par_Index, int par_Signal)
+{
+    COLUMN_FILE_CHUNK *Chunks;
+    uint64_t g;
+
+    if (par_Index->Chunks[par_Signal + 1] != NULL) return 0;
+    Chunks = (COLUMN_FILE_CHUNK*)my_malloc((size_t)(par_Index->NumberOfGroups + 1) * sizeof(COLUMN_FILE_CHUNK));
+    if (Chunks == NULL) {
+        ThrowError (1, "out of memory");
+        return -1;
+    }
+    if (ReadFromColumnFile(par_Index, par_Index->Trailer.ChunkIndexOffset + (uint64_t)(par_Signal + 1) * par_Index->NumberOfGroups * sizeof(COLUMN_FILE_CHUNK),
+                           Chunks, par_Index->NumberOfGroups * sizeof(COLUMN_FILE_CHUNK))) {
+        ThrowError (1, "cannot read the chunk index of a column file");
+        my_free(Chunks);
+        return -1;
+    }
+    for (g = 0; g < par_Index->NumberOfGroups; g++) {
+        if ((Chunks[g].Signal != ((par_Signal < 0) ? COLUMN_FILE_TIME_SIGNAL : (uint32_t)par_Signal)) ||
+            (Chunks[g].SampleCount == 0) || (Chunks[g].SampleCount > par_Index->Header.ChunkSamples) ||
+            ((par_Signal >= 0) && (Chunks[g].SampleCount != par_Index->Chunks[0][g].SampleCount))) {
+            ThrowError (1, "chunk index of a column file is corrupt");
+            my_free(Chunks);
+            return -1;
+        }
+    }
+    par_Index->Chunks[par_Signal + 1] = Chunks;
+    return 0;
+}
+
+// Read the header and the index at the end of the file, no signal data will be touched
+static int OpenColumnFileIndex(const char *par_Filename, COLUMN_FILE_INDEX *ret_Index, int par_ErrMsgFlag)
+{
+    uint64_t x, ChunksPerGroup;
+    char Filename[MAX_PATH];
+
+    MEMSET(ret_Index, 0, sizeof(COLUMN_FILE_INDEX));
+    SearchAndReplaceEnvironmentStrings(par_Filename, Filename, sizeof(Filename));
+    ret_Index->fh = my_open(Filename);
+    if (ret_Index->fh == MY_INVALID_HANDLE_VALUE) {
+        if (par_ErrMsgFlag) ThrowError (1, "Unable to open %s file\n", Filename);
+        return -1;
+    }
+    LogFileAccess (Filename);
+    ret_Index->SizeOfFile = my_get_file_size(ret_Index->fh);
+    if ((ret_Index->SizeOfFile < (sizeof(COLUMN_FILE_HEADER) + sizeof(COLUMN_FILE_TRAILER))) ||
+        ReadFromColumnFile(ret_Index, 0, &ret_Index->Header, sizeof(COLUMN_FILE_HEADER)) ||
+        strncmp(COLUMN_FILE_IDENTIFIER, ret_Index->Header.FileIdentifier, 8) ||
+        ReadFromColumnFile(ret_Index, ret_Index->SizeOfFile - sizeof(COLUMN_FILE_TRAILER), &ret_Index->Trailer, sizeof(COLUMN_FILE_TRAILER)) ||
+        strncmp(COLUMN_FILE_TRAILER_IDENTIFIER, ret_Index->Trailer.TrailerIdentifier, 8)) {
+        // a file without trailer was not closed correctly by the recorder
+        if (par_ErrMsgFlag) ThrowError (1, "%s is not a complete column file\n", Filename);
+        goto __ERROR;
+    }
+    if (ret_Index->Header.Version != COLUMN_FILE_VERSION) {
+        if (par_ErrMsgFlag) ThrowError (1, "%s has column file version %u only version %u is supported\n",
+                                        Filename, ret_Index->Header.Version, COLUMN_FILE_VERSION);
+        goto __ERROR;
+    }
+    ret_Index->Strings = (char*)my_malloc(ret_Index->Trailer.StringTableSize + 1);
+    ret_Index->Signals = (COLUMN_FILE_SIGNAL*)my_malloc(((size_t)ret_Index->Trailer.SignalCount + 1) * sizeof(COLUMN_FILE_SIGNAL));
+    ret_Index->Chunks = (COLUMN_FILE_CHUNK**)my_calloc((size_t)ret_Index->Trailer.SignalCount + 1, sizeof(COLUMN_FILE_CHUNK*));
+    if ((ret_Index->Strings == NULL) || (ret_Index->Signals == NULL) || (ret_Index->Chunks == NULL)) {
+        if (par_ErrMsgFlag) ThrowError (1, "out of memory");
+        goto __ERROR;
+    }
+    if (ReadFromColumnFile(ret_Index, ret_Index->Trailer.StringTableOffset, ret_Index->Strings, ret_Index->Trailer.StringTableSize) ||
+        ReadFromColumnFile(ret_Index, ret_Index->Trailer.SignalTableOffset, ret_Index->Signals, (uint64_t)ret_Index->Trailer.SignalCount * sizeof(COLUMN_FILE_SIGNAL))) {
+        if (par_ErrMsgFlag) ThrowError (1, "cannot read the index of %s\n", Filename);
+        goto __ERROR;
+    }
+    ret_Index->Strings[ret_Index->Trailer.StringTableSize] = 0;
+    for (x = 0; x < ret_Index->Trailer.SignalCount; x++) {
+        if ((ret_Index->Signals[x].NameOffset >= ret_Index->Trailer.StringTableSize) ||
+            (ret_Index->Signals[x].UnitOffset >= ret_Index->Trailer.StringTableSize) ||
+            (size_of_bbvari(ret_Index->Signals[x].DataType) != (int)ret_Index->Signals[x].ByteSize)) {
+            if (par_ErrMsgFlag) ThrowError (1, "signal table of %s is corrupt\n", Filename);
+            goto __ERROR;
+        }
+    }
+    // each group has the time chunk and one chunk for each signal
+    ChunksPerGroup = (uint64_t)ret_Index->Trailer.SignalCount + 1;
+    if ((ret_Index->Trailer.ChunkCount % ChunksPerGroup) != 0) {
+        if (par_ErrMsgFlag) ThrowError (1, "chunk index of %s is corrupt\n", Filename);
+        goto __ERROR;
+    }
+    ret_Index->NumberOfGroups = ret_Index->Trailer.ChunkCount / ChunksPerGroup;
+    // the time index is always needed
+    if (LoadColumnChunkIndex(ret_Index, -1)) {
+        goto __ERROR;
+    }
+    return 0;
+__ERROR:
+    CloseColumnFileIndex(ret_Index);
+    return -1;
+}
+
+static COLUMN_FILE_CHUNK *GetColumnChunk(COLUMN_FILE_INDEX *par_Index, uint64_t par_Group, int par_Signal)
+{
+    // par_Signal == -1 is the time chunk, the index of the signal must be loaded before
+    return &(par_Index->Chunks[par_Signal + 1][par_Group]);
+}
+
+static int ReadColumnChunk(COLUMN_FILE_INDEX *par_Index, COLUMN_FILE_CHUNK *par_Chunk, int par_ByteSize, void *ret_Data)
+{
+    return ReadFromColumnFile(par_Index, par_Chunk->FileOffset, ret_Data, (uint64_t)par_Chunk->SampleCount * (uint64_t)par_ByteSize);
+}
+
+static int SearchColumnSignal(COLUMN_FILE_INDEX *par_Index, const char *par_SignalName)
+{
+    uint32_t x;
+    for (x = 0; x < par_Index->Trailer.SignalCount; x++) {
+        if (!strcmp(par_Index->Strings + par_Index->Signals[x].NameOffset, par_SignalName)) {
+            return (int)x;
+        }
+    }
+    return -1;
+}
+
+// First group with a last time >= par_Time, NumberOfGroups if there is no one
+static uint64_t FindColumnGroupOfTime(COLUMN_FILE_INDEX *par_Index, uint64_t par_Time)
+{
+    uint64_t Lo = 0;
+    uint64_t Hi = par_Index->NumberOfGroups;
+    while (Lo < Hi) {
+        uint64_t Mid = Lo + (Hi - Lo) / 2;
+        if (GetColumnChunk(par_Index, Mid, -1)->LastTime < par_Time) {
+            Lo = Mid + 1;
+        } else {
+            Hi = Mid;
+        }
+    }
+    return Lo;
+}
+
+// First sample inside par_Times with a time >= par_Time
+static uint32_t FindColumnSampleOfTime(uint64_t *par_Times, uint32_t par_Count, uint64_t par_Time)
+{
+    uint32_t Lo = 0;
+    uint32_t Hi = par_Count;
+    while (Lo < Hi) {
+        uint32_t Mid = Lo + (Hi - Lo) / 2;
+        if (par_Times[Mid] < par_Time) {
+            Lo = Mid + 1;
+        } else {
+            Hi = Mid;
+        }
+    }
+    return Lo;
+}
+
+static uint64_t FirstTimeOfColumnFile(COLUMN_FILE_INDEX *par_Index)
+{
+    if (par_Index->NumberOfGroups == 0) return 0;
+    return GetColumnChunk(par_Index, 0, -1)->FirstTime;
+}
+
+int IsColumnFormat(const char *par_Filename)
+{
+    MY_FILE_HANDLE fh;
+    COLUMN_FILE_HEADER Header;
+    int ReadResult;
+    char Filename[MAX_PATH];
+
+    SearchAndReplaceEnvironmentStrings(par_Filename, Filename, sizeof(Filename));
+    fh = my_open(Filename);
+    if (fh == MY_INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    LogFileAccess (Filename);
+    ReadResult = my_read (fh, &Header, sizeof (Header));
+    my_close (fh);
+    if (ReadResult != sizeof (Header)) {
+        return 0;
+    }
+    if (strncmp(COLUMN_FILE_IDENTIFIER, Header.FileIdentifier, 8)) {
+        return 0;
+    }
+    return 1;
+}
+
+char *ColumnReadStimulHeaderVariabeles (const char *par_Filename)
+{
+    COLUMN_FILE_INDEX Index;
+    char *Ret;
+    size_t LenOfRet = 0;
+    size_t Pos = 0;
+    uint32_t x;
+
+    if (OpenColumnFileIndex(par_Filename, &Index, 0)) {
+        return NULL;
+    }
+    for (x = 0; x < Index.Trailer.SignalCount; x++) {
+        LenOfRet += strlen(Index.Strings + Index.Signals[x].NameOffset) + 1;
+    }
+    Ret = (char*)my_malloc(LenOfRet + 1);
+    if (Ret == NULL) {
+        ThrowError (1, "out of memory");
+    } else {
+        Ret[0] = 0;
+        for (x = 0; x < Index.Trailer.SignalCount; x++) {
+            const char *Name = Index.Strings + Index.Signals[x].NameOffset;
+            size_t Len = strlen(Name);
+            if (x) Ret[Pos++] = ';';
+            MEMCPY(Ret + Pos, Name, Len + 1);
+            Pos += Len;
+        }
+    }
+    CloseColumnFileIndex(&Index);
+    return Ret;
+}
+
+static void FreeColumnStimuliFile(COLUMN_STIMULI_FILE *par_Column)
+{
+    if (par_Column != NULL) {
+        int x;
+        if (par_Column->ReadSignals != NULL) {
+            for (x = 0; x < par_Column->variable_count; x++) {
+                if (par_Column->ReadSignals[x].Data != NULL) my_free(par_Column->ReadSignals[x].Data);
+            }
+            my_free(par_Column->ReadSignals);
+        }
+        if (par_Column->Times != NULL) my_free(par_Column->Times);
+        if (par_Column->vids != NULL) my_free(par_Column->vids);
+        if (par_Column->dtypes != NULL) my_free(par_Column->dtypes);
+        CloseColumnFileIndex(&par_Column->Index);
+        my_free(par_Column);
+    }
+}
+
+static int IsInsideVariableList(const char *par_Variables, const char *par_Name)
+{
+    const char *vlp;
+    if (par_Variables == NULL) return 1;  // all variables
+    for (vlp = par_Variables; *vlp != '\0'; vlp += strlen(vlp) + 1) {
+        if (!strcmp (vlp, par_Name)) return 1;
+    }
+    return 0;
+}
+
+STIMULI_FILE *ColumnOpenAndReadStimuliHeader (const char *par_Filename, const char *par_Variables)
+{
+    STIMULI_FILE *Ret = NULL;
+    COLUMN_STIMULI_FILE *Column = NULL;
+    uint32_t x;
+    int VariableCount = 0;
+
+    Ret = (STIMULI_FILE*)my_calloc(1, sizeof(STIMULI_FILE));
+    Column = (COLUMN_STIMULI_FILE*)my_calloc(1, sizeof(COLUMN_STIMULI_FILE));
+    if ((Ret == NULL) || (Column == NULL)) {
+        ThrowError(1, "out of memory");
+        goto __ERROR;
+    }
+    Column->Index.fh = MY_INVALID_HANDLE_VALUE;
+    Ret->File = (void*)Column;
+    Ret->FileType = COLUMN_FILE;
+    if (OpenColumnFileIndex(par_Filename, &Column->Index, 1)) {
+        goto __ERROR;
+    }
+    Column->vids = (int*)my_calloc((size_t)Column->Index.Trailer.SignalCount + 1, sizeof(int));
+    Column->dtypes = (int*)my_calloc((size_t)Column->Index.Trailer.SignalCount + 1, sizeof(int));
+    Column->ReadSignals = (COLUMN_READ_SIGNAL*)my_calloc((size_t)Column->Index.Trailer.SignalCount + 1, sizeof(COLUMN_READ_SIGNAL));
+    Column->Times = (uint64_t*)my_malloc((size_t)Column->Index.Header.ChunkSamples * sizeof(uint64_t));
+    if ((Column->vids == NULL) || (Column->dtypes == NULL) || (Column->ReadSignals == NULL) || (Column->Times == NULL)) {
+        ThrowError(1, "out of memory");
+        goto __ERROR;
+    }
+    for (x = 0; x < Column->Index.Trailer.SignalCount; x++) {
+        COLUMN_FILE_SIGNAL *Signal = &(Column->Index.Signals[x]);
+        const char *SignalName = Column->Index.Strings + Signal->NameOffset;
+        if (IsInsideVariableList(par_Variables, SignalName)) {
+            COLUMN_READ_SIGNAL *ReadSignal = &(Column->ReadSignals[VariableCount]);
+            if (LoadColumnChunkIndex(&Column->Index, (int)x)) {
+                goto __ERROR;
+            }
+            Column->vids[VariableCount] = add_bbvari (SignalName, Signal->DataType, Column->Index.Strings + Signal->UnitOffset);
+            if (Column->vids[VariableCount] <= 0) {
+                ThrowError(1, "cannot add variable \"%s\" to the blackboard", SignalName);
+                continue;
+            }
+            Column->dtypes[VariableCount] = get_bbvaritype (Column->vids[VariableCount]);
+            ReadSignal->Signal = (int)x;
+            ReadSignal->FileDataType = Signal->DataType;
+            ReadSignal->BbDataType = Column->dtypes[VariableCount];
+            ReadSignal->ByteSize = (int)Signal->ByteSize;
+            // only the selected signals need a buffer
+            ReadSignal->Data = (unsigned char*)my_malloc((size_t)Column->Index.Header.ChunkSamples * Signal->ByteSize);
+            VariableCount++;   // so the buffer will be freed also on error
+            if (ReadSignal->Data == NULL) {
+                ThrowError(1, "out of memory");
+                goto __ERROR;
+            }
+        }
+    }
+    Column->vids[VariableCount] = 0;
+    Column->variable_count = VariableCount;
+    Column->FirstTimeStamp = FirstTimeOfColumnFile(&Column->Index);
+    return Ret;
+__ERROR:
+    if (Column != NULL) {
+        Column->variable_count = VariableCount;
+        FreeColumnStimuliFile(Column);
+    }
+    if (Ret != NULL) my_free(Ret);
+    return NULL;
+}
+
+int ColumnGetNumberOfStimuliVariables (STIMULI_FILE *par_File)
+{
+    COLUMN_STIMULI_FILE *Column = (COLUMN_STIMULI_FILE*)par_File->File;
+    return Column->variable_count;
+}
+
+int *ColumnGetStimuliVariableIds(STIMULI_FILE *par_File)
+{
+    COLUMN_STIMULI_FILE *Column = (COLUMN_STIMULI_FILE*)par_File->File;
+    return Column->vids;
+}
+
+// Read the time chunk and the chunks of the selected signals of one group, the other chunks will be skipped
+static int LoadColumnGroup(COLUMN_STIMULI_FILE *par_Column, uint64_t par_Group)
+{
+    COLUMN_FILE_CHUNK *Chunk;
+    int x;
+
+    par_Column->CurrentSample = par_Column->SamplesInGroup = 0;
+    if (par_Group >= par_Column->Index.NumberOfGroups) {
+        par_Column->EndOfFile = 1;
+        return STIMULI_END_OF_FILE;
+    }
+    Chunk = GetColumnChunk(&par_Column->Index, par_Group, -1);
+    if (ReadColumnChunk(&par_Column->Index, Chunk, sizeof(uint64_t), par_Column->Times)) {
+        goto __ERROR;
+    }
+    for (x = 0; x < par_Column->variable_count; x++) {
+        COLUMN_READ_SIGNAL *ReadSignal = &(par_Column->ReadSignals[x]);
+        if (ReadColumnChunk(&par_Column->Index, GetColumnChunk(&par_Column->Index, par_Group, ReadSignal->Signal),
+                            ReadSignal->ByteSize, ReadSignal->Data)) {
+            goto __ERROR;
+        }
+    }
+    par_Column->NextGroup = par_Group + 1;
+    par_Column->SamplesInGroup = Chunk->SampleCount;
+    par_Column->EndOfFile = 0;
+    return 0;
+__ERROR:
+    ThrowError(1, "cannot read from column file");
+    par_Column->EndOfFile = 1;
+    return STIMULI_END_OF_FILE;
+}
+
+int ColumnReadOneStimuliTimeSlot (STIMULI_FILE *par_File, VARI_IN_PIPE *pipevari_list, uint64_t *ret_t)
+{
+    COLUMN_STIMULI_FILE *Column = (COLUMN_STIMULI_FILE*)par_File->File;
+    uint32_t Sample;
+    int x;
+
+    if (Column->CurrentSample >= Column->SamplesInGroup) {
+        if (Column->EndOfFile || LoadColumnGroup(Column, Column->NextGroup)) {
+            return STIMULI_END_OF_FILE;
+        }
+    }
+    Sample = Column->CurrentSample++;
+    for (x = 0; x < Column->variable_count; x++) {
+        COLUMN_READ_SIGNAL *ReadSignal = &(Column->ReadSignals[x]);
+        unsigned char *Data = ReadSignal->Data + (size_t)Sample * (size_t)ReadSignal->ByteSize;
+        if (ReadSignal->FileDataType == ReadSignal->BbDataType) {
+            pipevari_list[x].value.uqw = 0;
+            MEMCPY(&(pipevari_list[x].value), Data, ReadSignal->ByteSize);
+        } else {
+            sc_convert_from_to(ReadSignal->FileDataType, (union BB_VARI*)Data, ReadSignal->BbDataType, &(pipevari_list[x].value));
+        }
+        pipevari_list[x].vid = Column->vids[x];
+        pipevari_list[x].type = ReadSignal->BbDataType;
+    }
+    *ret_t = Column->Times[Sample] - Column->FirstTimeStamp;
+    return Column->variable_count;
+}
+
+int ColumnSeekStimuliFile (STIMULI_FILE *par_File, uint64_t par_Time)
+{
+    COLUMN_STIMULI_FILE *Column = (COLUMN_STIMULI_FILE*)par_File->File;
+    uint64_t Time = Column->FirstTimeStamp + par_Time;
+    uint64_t Group;
+
+    // the time chunk of each group has its time range inside the index
+    Group = FindColumnGroupOfTime(&Column->Index, Time);
+    if (LoadColumnGroup(Column, Group)) {
+        return 0;  // behind the file end
+    }
+    Column->CurrentSample = FindColumnSampleOfTime(Column->Times, Column->SamplesInGroup, Time);
+    return 0;
+}
+
+void ColumnCloseStimuliFile(STIMULI_FILE *par_File)
+{
+    if (par_File != NULL) {
+        FreeColumnStimuliFile((COLUMN_STIMULI_FILE*)par_File->File);
+    }
+}
+
+static double ColumnValueToDouble(int par_DataType, unsigned char *par_Data)
+{
+    double Ret;
+    sc_convert_from_to(par_DataType, (union BB_VARI*)par_Data, BB_DOUBLE, (union BB_VARI*)&Ret);
+    return Ret;
+}
+
+int ColumnReadOneSignal (const char *par_Filename, const char *par_SignalName,
+                         uint64_t par_FromTime, uint64_t par_ToTime,
+                         uint64_t **ret_Times, double **ret_Values)
+{
+    COLUMN_FILE_INDEX Index;
+    int Signal;
+    int DataType, ByteSize;
+    uint64_t FirstTime, g;
+    uint64_t *Times = NULL;
+    unsigned char *Data = NULL;
+    uint64_t *RetTimes = NULL;
+    double *RetValues = NULL;
+    size_t Count = 0, Size = 0;
+
+    *ret_Times = NULL;
+    *ret_Values = NULL;
+    if (OpenColumnFileIndex(par_Filename, &Index, 1)) {
+        return -1;
+    }
+    Signal = SearchColumnSignal(&Index, par_SignalName);
+    if (Signal < 0) {
+        ThrowError(1, "signal \"%s\" not found inside \"%s\"", par_SignalName, par_Filename);
+        goto __ERROR;
+    }
+    if (LoadColumnChunkIndex(&Index, Signal)) {
+        goto __ERROR;
+    }
+    DataType = Index.Signals[Signal].DataType;
+    ByteSize = (int)Index.Signals[Signal].ByteSize;
+    Times = (uint64_t*)my_malloc((size_t)Index.Header.ChunkSamples * sizeof(uint64_t));
+    Data = (unsigned char*)my_malloc((size_t)Index.Header.ChunkSamples * (size_t)ByteSize);
+    if ((Times == NULL) || (Data == NULL)) {
+        ThrowError(1, "out of memory");
+        goto __ERROR;
+    }
+    FirstTime = FirstTimeOfColumnFile(&Index);
+    if (par_ToTime > (UINT64_MAX - FirstTime)) par_ToTime = UINT64_MAX - FirstTime;
+    for (g = FindColumnGroupOfTime(&Index, FirstTime + par_FromTime); g < Index.NumberOfGroups; g++) {
+        COLUMN_FILE_CHUNK *TimeChunk = GetColumnChunk(&Index, g, -1);
+        uint32_t s;
+        if (TimeChunk->FirstTime > (FirstTime + par_ToTime)) break;
+        if (ReadColumnChunk(&Index, TimeChunk, sizeof(uint64_t), Times) ||
+            ReadColumnChunk(&Index, GetColumnChunk(&Index, g, Signal), ByteSize, Data)) {
+            ThrowError(1, "cannot read from \"%s\"", par_Filename);
+            goto __ERROR;
+        }
+        if ((Count + TimeChunk->SampleCount) > Size) {
+            Size += Size / 2 + TimeChunk->SampleCount;
+            RetTimes = (uint64_t*)my_realloc(RetTimes, Size * sizeof(uint64_t));
+            RetValues = (double*)my_realloc(RetValues, Size * sizeof(double));
+            if ((RetTimes == NULL) || (RetValues == NULL)) {
+                ThrowError(1, "out of memory");
+                goto __ERROR;
+            }
+        }
+        for (s = FindColumnSampleOfTime(Times, TimeChunk->SampleCount, FirstTime + par_FromTime);
+             (s < TimeChunk->SampleCount) && (Times[s] <= (FirstTime + par_ToTime)); s++) {
+            RetTimes[Count] = Times[s] - FirstTime;
+            RetValues[Count] = ColumnValueToDouble(DataType, Data + (size_t)s * (size_t)ByteSize);
+            Count++;
+        }
+    }
+    my_free(Times);
+    my_free(Data);
+    CloseColumnFileIndex(&Index);
+    *ret_Times = RetTimes;
+    *ret_Values = RetValues;
+    return (int)Count;
+__ERROR:
+    if (Times != NULL) my_free(Times);
+    if (Data != NULL) my_free(Data);
+    if (RetTimes != NULL) my_free(RetTimes);
+    if (RetValues != NULL) my_free(RetValues);
+    CloseColumnFileIndex(&Index);
+    return -1;
+}
+
+int64_t ColumnGetSignalMinMax (const char *par_Filename, const char *par_SignalName,
+                               uint64_t par_FromTime, uint64_t par_ToTime,
+                               double *ret_Min, double *ret_Max)
+{
+    COLUMN_FILE_INDEX Index;
+    int Signal;
+    int DataType, ByteSize;
+    uint64_t FirstTime, From, To, g;
+    uint64_t *Times = NULL;
+    unsigned char *Data = NULL;
+    double Min = INFINITY, Max = -INFINITY;
+    int64_t Count = 0;
+
+    if (OpenColumnFileIndex(par_Filename, &Index, 1)) {
+        return -1;
+    }
+    Signal = SearchColumnSignal(&Index, par_SignalName);
+    if (Signal < 0) {
+        ThrowError(1, "signal \"%s\" not found inside \"%s\"", par_SignalName, par_Filename);
+        goto __ERROR;
+    }
+    if (LoadColumnChunkIndex(&Index, Signal)) {
+        goto __ERROR;
+    }
+    DataType = Index.Signals[Signal].DataType;
+    ByteSize = (int)Index.Signals[Signal].ByteSize;
+    FirstTime = FirstTimeOfColumnFile(&Index);
+    From = FirstTime + par_FromTime;
+    To = (par_ToTime > (UINT64_MAX - FirstTime)) ? UINT64_MAX : (FirstTime + par_ToTime);
+    for (g = FindColumnGroupOfTime(&Index, From); g < Index.NumberOfGroups; g++) {
+        COLUMN_FILE_CHUNK *TimeChunk = GetColumnChunk(&Index, g, -1);
+        COLUMN_FILE_CHUNK *Chunk = GetColumnChunk(&Index, g, Signal);
+        if (TimeChunk->FirstTime > To) break;
+        if ((TimeChunk->FirstTime >= From) && (TimeChunk->LastTime <= To)) {
+            // the whole chunk is inside the time range, the statistics of the index are enough
+            if (!isnan(Chunk->Min)) {
+                if (Chunk->Min < Min) Min = Chunk->Min;
+                if (Chunk->Max > Max) Max = Chunk->Max;
+            }
+            Count += Chunk->SampleCount;
+        } else {
+            uint32_t s;
+            if (Times == NULL) {
+                Times = (uint64_t*)my_malloc((size_t)Index.Header.ChunkSamples * sizeof(uint64_t));
+                Data = (unsigned char*)my_malloc((size_t)Index.Header.ChunkSamples * (size_t)ByteSize);
+                if ((Times == NULL) || (Data == NULL)) {
+                    ThrowError(1, "out of memory");
+                    goto __ERROR;
+                }
+            }
+            if (ReadColumnChunk(&Index, TimeChunk, sizeof(uint64_t), Times) ||
+                ReadColumnChunk(&Index, Chunk, ByteSize, Data)) {
+                ThrowError(1, "cannot read from \"%s\"", par_Filename);
+                goto __ERROR;
+            }
+            for (s = FindColumnSampleOfTime(Times, TimeChunk->SampleCount, From);
+                 (s < TimeChunk->SampleCount) && (Times[s] <= To); s++) {
+                double Value = ColumnValueToDouble(DataType, Data + (size_t)s * (size_t)ByteSize);
+                if (Value < Min) Min = Value;
+                if (Value > Max) Max = Value;
+                Count++;
+            }
+        }
+    }
+    if (Min > Max) Min = Max = NAN;
+    *ret_Min = Min;
+    *ret_Max = Max;
+    if (Times != NULL) my_free(Times);
+    if (Data != NULL) my_free(Data);
+    CloseColumnFileIndex(&Index);
+    return Count;
+__ERROR:
+    if (Times != NULL) my_free(Times);
+    if (Data != NULL) my_free(Data);
+    CloseColumnFileIndex(&Index);
+    return -1;
+}
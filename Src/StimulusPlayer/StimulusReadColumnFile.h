@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STIMULUSREADCOLUMNFILE_H
+#define STIMULUSREADCOLUMNFILE_H
+
+#include "Platform.h"
+#include "TraceRecorder.h"
+#include "Blackboard.h"
+#include "StimulusReadFile.h"
+#include "ColumnFileStructs.h"
+
+typedef struct {
+    MY_FILE_HANDLE fh;
+    uint64_t SizeOfFile;
+    COLUMN_FILE_HEADER Header;
+    COLUMN_FILE_TRAILER Trailer;
+    char *Strings;
+    COLUMN_FILE_SIGNAL *Signals;
+    COLUMN_FILE_CHUNK **Chunks;     // [SignalCount + 1] index entries of the time (0) and each signal for all groups,
+                                    // only the time and the used signals are loaded
+    uint64_t NumberOfGroups;
+} COLUMN_FILE_INDEX;
+
+typedef struct {
+    int Signal;               // index inside the signal table
+    int FileDataType;
+    int BbDataType;
+    int ByteSize;
+    unsigned char *Data;      // values of the current group
+} COLUMN_READ_SIGNAL;
+
+typedef struct {
+    COLUMN_FILE_INDEX Index;
+    int *vids;                // 0 terminated
+    int *dtypes;
+    int variable_count;
+    COLUMN_READ_SIGNAL *ReadSignals;
+    uint64_t *Times;          // time chunk of the current group
+    uint64_t NextGroup;       // group which will be loaded if all samples of the current group are read
+    uint32_t CurrentSample;
+    uint32_t SamplesInGroup;
+    int EndOfFile;
+    uint64_t FirstTimeStamp;
+} COLUMN_STIMULI_FILE;
+
+int IsColumnFormat(const char *par_Filename);
+
+char *ColumnReadStimulHeaderVariabeles (const char *par_Filename);
+
+STIMULI_FILE *ColumnOpenAndReadStimuliHeader (const char *par_Filename, const char *par_Variables);
+
+int ColumnGetNumberOfStimuliVariables (STIMULI_FILE *par_File);
+
+int *ColumnGetStimuliVariableIds(STIMULI_FILE *par_File);
+
+int ColumnReadOneStimuliTimeSlot (STIMULI_FILE *par_File, VARI_IN_PIPE *pipevari_list, uint64_t *ret_t);
+
+int ColumnSeekStimuliFile (STIMULI_FILE *par_File, uint64_t par_Time);
+
+void ColumnCloseStimuliFile(STIMULI_FILE *par_File);
+
+// Read all values of one signal between par_FromTime and par_ToTime (ns relative to the first sample, both inclusive)
+// without touching the data of the other signals. The returned buffers must be freed with my_free().
+// Returns the number of values or -1 on error.
+int ColumnReadOneSignal (const char *par_Filename, const char *par_SignalName,
+                         uint64_t par_FromTime, uint64_t par_ToTime,
+                         uint64_t **ret_Times, double **ret_Values);
+
+// Smallest and largest value of one signal between par_FromTime and par_ToTime, only the chunks
+// at the border of the time range must be read, all others are taken from the index.
+// Returns the number of samples inside the range or -1 on error.
+int64_t ColumnGetSignalMinMax (const char *par_Filename, const char *par_SignalName,
+                               uint64_t par_FromTime, uint64_t par_ToTime,
+                               double *ret_Min, double *ret_Max);
+
+#endif
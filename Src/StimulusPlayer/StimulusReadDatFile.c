@@ -270,6 +270,8 @@ STIMULI_FILE* DatOpenAndReadStimuliHeader (const char *par_Filename, const char
     Dat->line_counter++;
     Dat->column_count = columncount;
     Dat->variable_count = varicount;
+    Dat->data_start_pos = _ftelli64 (Dat->fh);
+    Dat->data_start_line = Dat->line_counter;
 
     return Ret;     /* all OK */
 __ERROR:
@@ -284,6 +286,44 @@ __ERROR:
     return NULL;
 }
 
+/* All lines have the same time distance so the line of par_Time can be calculated,
+   the lines before will be skipped without converting the values */
+int DatSeekStimuliFile (STIMULI_FILE* par_File, uint64_t par_Time)
+{
+    DAT_STIMULI_FILE *Dat = (DAT_STIMULI_FILE*)par_File->File;
+    uint64_t Lines, l;
+    int HaveChars = 0;
+    int PhysicalLines = 0;
+    char Buffer[4096];
+
+    if (_fseeki64 (Dat->fh, Dat->data_start_pos, SEEK_SET)) {
+        ThrowError (1, "cannot seek inside stimuli file");
+        return -1;
+    }
+    Dat->line_counter = Dat->data_start_line;
+    Dat->current_sample_time = 0;
+    if (Dat->sample_rate_uint64 == 0) return 0;
+    // first line which is not before par_Time
+    Lines = (par_Time + Dat->sample_rate_uint64 - 1) / Dat->sample_rate_uint64;
+    // empty lines will be ignored by read_next_word() so they are not counted
+    for (l = 0; l < Lines; ) {
+        char *p;
+        if (fgets (Buffer, sizeof (Buffer), Dat->fh) == NULL) break;   // file end
+        for (p = Buffer; *p != 0; p++) {
+            if (*p == '\n') {
+                if (HaveChars) l++;
+                HaveChars = 0;
+                PhysicalLines++;
+            } else if (!isspace ((unsigned char)*p)) {
+                HaveChars = 1;
+            }
+        }
+    }
+    Dat->line_counter += PhysicalLines;
+    Dat->current_sample_time = l * Dat->sample_rate_uint64;
+    return 0;
+}
+
 /* This will read one line from the simulus file and build a message */
 int DatReadOneStimuliTimeSlot (STIMULI_FILE* par_File, VARI_IN_PIPE *pipevari_list, uint64_t *ret_t)
 {
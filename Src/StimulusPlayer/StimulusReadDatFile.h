@@ -33,6 +33,8 @@ typedef struct {
     uint64_t sample_rate_uint64;
     uint64_t current_sample_time;
     int line_counter;
+    int64_t data_start_pos;     // file position of the first sample line
+    int data_start_line;
 } DAT_STIMULI_FILE;
 
 char* DatReadStimulHeaderVariabeles  (const char *par_Filename);
@@ -45,6 +47,8 @@ int *DatGetStimuliVariableIds (STIMULI_FILE*par_File);
 
 int DatReadOneStimuliTimeSlot (STIMULI_FILE* par_File, VARI_IN_PIPE *pipevari_list, uint64_t *ret_t);
 
+int DatSeekStimuliFile (STIMULI_FILE* par_File, uint64_t par_Time);
+
 void DatCloseStimuliFile(STIMULI_FILE* par_File);
 
 #endif // STIMULUSREADDATFILE_H
@@ -32,13 +32,16 @@
 #include "StimulusReadDatFile.h"
 #include "StimulusReadMdfFile.h"
 #include "StimulusReadMdf4File.h"
+#include "StimulusReadColumnFile.h"
 #include "StimulusReadFile.h"
 
 
 /* This will read all variable names from a stimulus files  (with ; separation) */
 char *ReadStimulHeaderVariabeles (const char *par_Filename)
 {
-    if (IsMdf4Format(par_Filename, NULL)) {
+    if (IsColumnFormat(par_Filename)) {
+        return ColumnReadStimulHeaderVariabeles (par_Filename);
+    } else if (IsMdf4Format(par_Filename, NULL)) {
         return Mdf4ReadStimulHeaderVariabeles (par_Filename);
     } else if (IsMdfFormat(par_Filename, NULL)) {
         return MdfReadStimulHeaderVariabeles (par_Filename);
@@ -51,7 +54,9 @@ char *ReadStimulHeaderVariabeles (const char *par_Filename)
 /* or NULL on error */
 STIMULI_FILE* OpenAndReadStimuliHeader (const char *par_Filename, const char *vari_list)
 {
-    if (IsMdf4Format(par_Filename, NULL)) {
+    if (IsColumnFormat(par_Filename)) {
+        return ColumnOpenAndReadStimuliHeader (par_Filename, vari_list);
+    } else if (IsMdf4Format(par_Filename, NULL)) {
         return Mdf4OpenAndReadStimuliHeader (par_Filename, vari_list);
     } else if (IsMdfFormat(par_Filename, NULL)) {
         return MdfOpenAndReadStimuliHeader (par_Filename, vari_list);
@@ -62,7 +67,9 @@ STIMULI_FILE* OpenAndReadStimuliHeader (const char *par_Filename, const char *va
 
 int GetNumberOfStimuliVariables (STIMULI_FILE*par_File)
 {
-    if (par_File->FileType == MDF4_FILE) {
+    if (par_File->FileType == COLUMN_FILE) {
+        return ColumnGetNumberOfStimuliVariables (par_File);
+    } else if (par_File->FileType == MDF4_FILE) {
         return Mdf4GetNumberOfStimuliVariables (par_File);
     } else if (par_File->FileType == MDF_FILE) {
         return MdfGetNumberOfStimuliVariables (par_File);
@@ -73,7 +80,9 @@ int GetNumberOfStimuliVariables (STIMULI_FILE*par_File)
 
 int *GetStimuliVariableIds (STIMULI_FILE*par_File)
 {
-    if (par_File->FileType == MDF4_FILE) {
+    if (par_File->FileType == COLUMN_FILE) {
+        return ColumnGetStimuliVariableIds (par_File);
+    } else if (par_File->FileType == MDF4_FILE) {
         return Mdf4GetStimuliVariableIds (par_File);
     } else if (par_File->FileType == MDF_FILE) {
         return MdfGetStimuliVariableIds (par_File);
@@ -85,7 +94,9 @@ int *GetStimuliVariableIds (STIMULI_FILE*par_File)
 /* This will read one line from the simulus file and build a message */
 int ReadOneStimuliTimeSlot (STIMULI_FILE* par_File, VARI_IN_PIPE *pipevari_list, uint64_t *ret_t)
 {
-    if (par_File->FileType == MDF4_FILE) {
+    if (par_File->FileType == COLUMN_FILE) {
+        return ColumnReadOneStimuliTimeSlot (par_File, pipevari_list, ret_t);
+    } else if (par_File->FileType == MDF4_FILE) {
         return Mdf4ReadOneStimuliTimeSlot (par_File, pipevari_list, ret_t);
     } else if (par_File->FileType == MDF_FILE) {
         return MdfReadOneStimuliTimeSlot (par_File, pipevari_list, ret_t);
@@ -94,9 +105,24 @@ int ReadOneStimuliTimeSlot (STIMULI_FILE* par_File, VARI_IN_PIPE *pipevari_list,
     }
 }
 
+int SeekStimuliFile (STIMULI_FILE* par_File, uint64_t par_Time)
+{
+    if (par_File->FileType == COLUMN_FILE) {
+        return ColumnSeekStimuliFile (par_File, par_Time);
+    } else if (par_File->FileType == MDF4_FILE) {
+        return Mdf4SeekStimuliFile (par_File, par_Time);
+    } else if (par_File->FileType == MDF_FILE) {
+        return MdfSeekStimuliFile (par_File, par_Time);
+    } else {
+        return DatSeekStimuliFile (par_File, par_Time);
+    }
+}
+
 void CloseStimuliFile(STIMULI_FILE *par_File)
 {
-    if (par_File->FileType == MDF4_FILE) {
+    if (par_File->FileType == COLUMN_FILE) {
+        ColumnCloseStimuliFile (par_File);
+    } else if (par_File->FileType == MDF4_FILE) {
         Mdf4CloseStimuliFile (par_File);
     } else if (par_File->FileType == MDF_FILE) {
         MdfCloseStimuliFile (par_File);
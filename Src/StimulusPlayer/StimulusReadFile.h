@@ -24,7 +24,7 @@
 #define STIMULI_END_OF_FILE (-1)
 
 typedef struct{
-    enum {NO_FILE, DAT_FILE, MDF_FILE, MDF4_FILE} FileType;
+    enum {NO_FILE, DAT_FILE, MDF_FILE, MDF4_FILE, COLUMN_FILE} FileType;
     void *File;
 } STIMULI_FILE;
 
@@ -38,6 +38,10 @@ int *GetStimuliVariableIds (STIMULI_FILE*par_File);
 
 int ReadOneStimuliTimeSlot (STIMULI_FILE* par_File, VARI_IN_PIPE *pipevari_list, uint64_t *ret_t);
 
+// Position the file to the first time slot which is not before par_Time (relative to the first time slot of the file).
+// Afterwards ReadOneStimuliTimeSlot() will continue from there, the returned times are still relative to the file start
+int SeekStimuliFile (STIMULI_FILE* par_File, uint64_t par_Time);
+
 void CloseStimuliFile(STIMULI_FILE* par_File);
 
 #endif
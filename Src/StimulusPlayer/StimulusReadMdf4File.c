@@ -41,6 +41,17 @@
 
 #include "zlib.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define MDF4_USE_SSE2
+#endif
+
+// Extractor for a signal inside a record, selected once if the signal is added to the cache
+#define MDF4_EXTRACT_BIT_FIELD   0   // not byte aligned or not 8/16/32/64 bits: shift and mask
+#define MDF4_EXTRACT_COPY        1   // byte aligned little endian with the same data type as the blackboard variable
+#define MDF4_EXTRACT_COPY_SWAP   2   // byte aligned big endian with the same data type as the blackboard variable
+#define MDF4_EXTRACT_ALIGNED     3   // byte aligned but must be converted to the data type of the blackboard variable
+
 // If DebugOut exists write some debug infos to c:\\temp\\debug_mdf4.txt
 //static FILE *DebugOut;
 #define DebugOut NULL
@@ -319,8 +330,8 @@ static void CleanCache(MDF4_STIMULI_FILE *par_Mdf)
     if (par_Mdf->Cache.DataGroups != NULL) {
         int x;
         for (x = 0; x < par_Mdf->Cache.NumberOfDataGroups; x++) {
-            if (par_Mdf->Cache.DataGroups[x].BlockData != NULL) {
-                my_free (par_Mdf->Cache.DataGroups[x].BlockData);
+            if (par_Mdf->Cache.DataGroups[x].BlockBuffer != NULL) {
+                my_free (par_Mdf->Cache.DataGroups[x].BlockBuffer);
             }
             if (par_Mdf->Cache.DataGroups[x].Records != NULL) {
                 int y;
@@ -351,7 +362,7 @@ static int AddDataGroupToCache(MDF4_STIMULI_FILE *par_Mdf, uint8_t par_SizeOfRec
     }
     MEMSET(&(par_Mdf->Cache.DataGroups[par_Mdf->Cache.NumberOfDataGroups - 1]), 0, sizeof (MDF4_DATA_GROUP_CACHE));
     par_Mdf->Cache.DataGroups[par_Mdf->Cache.NumberOfDataGroups - 1].SizeOfRecordID = par_SizeOfRecordID;
-    par_Mdf->Cache.DataGroups[par_Mdf->Cache.NumberOfDataGroups - 1].CurrentBlock = -1;
+    par_Mdf->Cache.DataGroups[par_Mdf->Cache.NumberOfDataGroups - 1].IndexBlock = -1;
 
     if (DebugOut != NULL) { fprintf (DebugOut, "Add data group to cache: %i, %i\n", par_Mdf->Cache.NumberOfDataGroups - 1,  (int)par_SizeOfRecordID); FFLUSH_DEBUGOUT; }
 
@@ -377,6 +388,8 @@ static int AddDataBlockToDataGroupCache(MDF4_STIMULI_FILE *par_Mdf, int par_Inde
         DataGroup->Blocks[DataGroup->NoOfBlocks - 1].SizeOfDeflatedBlock = par_SizeOfDeflatedBlock;
         DataGroup->Blocks[DataGroup->NoOfBlocks - 1].InflateType = par_InflateType;
         DataGroup->Blocks[DataGroup->NoOfBlocks - 1].Parameter = par_Parameter;
+        DataGroup->Blocks[DataGroup->NoOfBlocks - 1].OffsetInsideRecordStream = DataGroup->SizeOfRecordStream;
+        DataGroup->SizeOfRecordStream += par_SizeOfBlock;
         if (par_SizeOfBlock > DataGroup->LargestBlockSize) {
             DataGroup->LargestBlockSize = par_SizeOfBlock;
         }
@@ -431,6 +444,57 @@ static int TranslateChannelIdToIndex(MDF4_DATA_GROUP_CACHE *par_DataBlock, uint6
     return -1;
 }
 
+// Returns the blackboard data type which has exactly the same memory layout as the MDF data type or BB_INVALID
+static int MdfNativeBlackboardType (int par_DataType, int par_BitSize)
+{
+    switch(par_DataType) {
+    case 0: //    0 = unsigned integer little endian
+    case 1: //    1 = unsigned integer big endian
+        switch (par_BitSize) {
+        case 8: return BB_UBYTE;
+        case 16: return BB_UWORD;
+        case 32: return BB_UDWORD;
+        case 64: return BB_UQWORD;
+        }
+        break;
+    case 2: //    2 = signed integer little endian
+    case 3: //    3 = signed integer big endian
+        switch (par_BitSize) {
+        case 8: return BB_BYTE;
+        case 16: return BB_WORD;
+        case 32: return BB_DWORD;
+        case 64: return BB_QWORD;
+        }
+        break;
+    case 4: //    4 = IEEE 754 floating-point format little endian
+    case 5: //    5 = IEEE 754 floating-point format big endian
+        switch (par_BitSize) {
+        case 32: return BB_FLOAT;
+        case 64: return BB_DOUBLE;
+        }
+        break;
+    default:
+        break;
+    }
+    return BB_INVALID;
+}
+
+static void SelectExtractor (MDF4_RECORD_ENTRY *par_Entry)
+{
+    int NativeType = MdfNativeBlackboardType (par_Entry->DataType, par_Entry->NumberOfBits);
+    par_Entry->ByteOffset = par_Entry->StartBitOffset >> 3;
+    par_Entry->ByteSize = par_Entry->NumberOfBits >> 3;
+    if ((NativeType == BB_INVALID) || ((par_Entry->StartBitOffset & 0x7) != 0)) {
+        par_Entry->Extractor = MDF4_EXTRACT_BIT_FIELD;
+    } else if (NativeType != par_Entry->BbDataType) {
+        par_Entry->Extractor = MDF4_EXTRACT_ALIGNED;
+    } else if ((par_Entry->DataType & 0x1) == 0) {  // 0, 2, 4 are little endian
+        par_Entry->Extractor = MDF4_EXTRACT_COPY;
+    } else {
+        par_Entry->Extractor = MDF4_EXTRACT_COPY_SWAP;
+    }
+}
+
 static int AddVariableToCache(MDF4_STIMULI_FILE *par_Mdf, int par_BlockNumber, uint64_t par_ChannelId, int par_Vid,
                               int par_DataType, int par_BbDataType, int par_NumberOfBits, int par_StartBitOffset,
                               int par_TimeVarFlag, double par_TimeFac, double par_TimeOff, const char *par_Name)
@@ -477,6 +541,7 @@ static int AddVariableToCache(MDF4_STIMULI_FILE *par_Mdf, int par_BlockNumber, u
         Record->Entrys[Record->NumberOfEntrys - 1].BbDataType = par_BbDataType;
         Record->Entrys[Record->NumberOfEntrys - 1].NumberOfBits = par_NumberOfBits;
         Record->Entrys[Record->NumberOfEntrys - 1].StartBitOffset = par_StartBitOffset;
+        SelectExtractor (&(Record->Entrys[Record->NumberOfEntrys - 1]));
         if (DebugOut != NULL) { fprintf (DebugOut, "    Add signal \"%s\" to block group %i: Id=%" PRIu64 "\n",
                                          par_Name, par_BlockNumber, par_ChannelId); FFLUSH_DEBUGOUT; }
     }
@@ -745,7 +810,7 @@ static int MdfTranslateDatatypeToBlackboardType (int par_DataType, int par_BitSi
         } else if (par_BitSize <= 16) {
             return BB_UNKNOWN_WORD;
         } else if (par_BitSize <= 32) {
-            return BB_UNKNOWN_WORD;
+            return BB_UNKNOWN_DWORD;
         } else if (par_BitSize <= 64) {
             return BB_UNKNOWN_QWORD;
         }
@@ -861,7 +926,7 @@ STIMULI_FILE *Mdf4OpenAndReadStimuliHeader (const char *par_Filename, const char
 #endif
 
     Mdf->FirstTimeStamp = 0xFFFFFFFFFFFFFFFFULL;
-    Mdf->SizeOfFile = (uint32_t)my_get_file_size(Mdf->fh);
+    Mdf->SizeOfFile = my_get_file_size(Mdf->fh);
 
 
     ReadResult = my_read (Mdf->fh, &MdfIdBlock, sizeof (MdfIdBlock));
@@ -1080,6 +1145,8 @@ STIMULI_FILE *Mdf4OpenAndReadStimuliHeader (const char *par_Filename, const char
         }
     }
     Mdf->variable_count = VariableCount;
+    // Map the whole file, if this is not possible the data blocks will be read with my_read()
+    Mdf->MappedFile = (unsigned char*)my_map_file(Mdf->fh, Mdf->SizeOfFile, &(Mdf->MapHandle));
     return Ret;
 __ERROR:
     ThrowError(1, "cannot read from file \"%s\"", Filename);
@@ -1101,139 +1168,244 @@ int Mdf4GetNumberOfStimuliVariables(STIMULI_FILE *par_File)
 
 }
 
+#ifdef MDF4_USE_SSE2
+// Transpose 16x16 bytes, 4 rounds of the perfect shuffle
+static void Transpose16x16 (__m128i *par_Rows)
+{
+    __m128i Tmp[16];
+    int Round, x;
+
+    for (Round = 0; Round < 4; Round++) {
+        for (x = 0; x < 8; x++) {
+            Tmp[2*x] = _mm_unpacklo_epi8 (par_Rows[x], par_Rows[x + 8]);
+            Tmp[2*x + 1] = _mm_unpackhi_epi8 (par_Rows[x], par_Rows[x + 8]);
+        }
+        for (x = 0; x < 16; x++) {
+            par_Rows[x] = Tmp[x];
+        }
+    }
+}
+#endif
+
+// The transposed data block stores byte 0 of all records, than byte 1 of all records, ...
+// Bytes behind the last complete record are not transposed.
 static void InverseTranspose(unsigned char *par_In, unsigned char *ret_Out, int par_Size, int par_RecordSize)
 {
     int RowCount = par_Size / par_RecordSize;
-    for (int Row = 0; Row < RowCount; Row++) {
-        for (int Column = 0; Column < par_RecordSize; Column++) {
-            int Dst = Row * par_RecordSize + Column;
-            int Src = Column * RowCount + Row;
-            ret_Out[Dst] = par_In[Src];
+    int Row = 0;
+    int Column;
+#ifdef MDF4_USE_SSE2
+    __m128i Block[16];
+    int x;
+#endif
+    if (par_RecordSize <= 1) {
+        MEMCPY (ret_Out, par_In, par_Size);
+        return;
+    }
+#ifdef MDF4_USE_SSE2
+    if (par_RecordSize >= 16) {
+        // 16 records with 16 bytes each at once
+        for (; (Row + 16) <= RowCount; Row += 16) {
+            for (Column = 0; Column < par_RecordSize; Column += 16) {
+                // the last 16 columns can overlap the columns before
+                if ((Column + 16) > par_RecordSize) Column = par_RecordSize - 16;
+                for (x = 0; x < 16; x++) {
+                    Block[x] = _mm_loadu_si128 ((const __m128i*)(void*)(par_In + (Column + x) * RowCount + Row));
+                }
+                Transpose16x16 (Block);
+                for (x = 0; x < 16; x++) {
+                    _mm_storeu_si128 ((__m128i*)(void*)(ret_Out + (Row + x) * par_RecordSize + Column), Block[x]);
+                }
+            }
+        }
+    } else {
+        // Records smaller than 16 bytes: each store writes behind the record,
+        // this will be overwritten by the following record
+        for (x = par_RecordSize; x < 16; x++) {
+            Block[x] = _mm_setzero_si128 ();
+        }
+        for (; ((Row + 16) <= RowCount) && (((Row + 15) * par_RecordSize + 16) <= par_Size); Row += 16) {
+            for (x = 0; x < par_RecordSize; x++) {
+                Block[x] = _mm_loadu_si128 ((const __m128i*)(void*)(par_In + x * RowCount + Row));
+            }
+            Transpose16x16 (Block);
+            for (x = 0; x < 16; x++) {
+                _mm_storeu_si128 ((__m128i*)(void*)(ret_Out + (Row + x) * par_RecordSize), Block[x]);
+            }
+            for (x = par_RecordSize; x < 16; x++) {
+                Block[x] = _mm_setzero_si128 ();
+            }
         }
     }
+#endif
+    // the rest (or all if there are no SSE2)
+    for (; Row < RowCount; Row++) {
+        for (Column = 0; Column < par_RecordSize; Column++) {
+            ret_Out[Row * par_RecordSize + Column] = par_In[Column * RowCount + Row];
+        }
+    }
+    if ((RowCount * par_RecordSize) < par_Size) {
+        MEMCPY (ret_Out + RowCount * par_RecordSize, par_In + RowCount * par_RecordSize, par_Size - RowCount * par_RecordSize);
+    }
 }
 
-static int UpdateCache(MDF4_STIMULI_FILE *par_Mdf, MDF4_DATA_GROUP_CACHE *DataBlock)
+// Returns a pointer to the data inside the mapped file or read the data into par_Buffer
+static unsigned char *ReadFromFile(MDF4_STIMULI_FILE *par_Mdf, uint64_t par_Offset, uint64_t par_Size, unsigned char *par_Buffer)
+{
+    if (par_Mdf->MappedFile != NULL) {
+        if ((par_Offset + par_Size) > par_Mdf->SizeOfFile) return NULL;
+        return par_Mdf->MappedFile + par_Offset;
+    }
+    my_lseek(par_Mdf->fh, par_Offset);
+    if (my_read(par_Mdf->fh, par_Buffer, (uint32_t)par_Size) != (int)par_Size) return NULL;
+    return par_Buffer;
+}
+
+static int Inflate(unsigned char *par_In, uint64_t par_InSize, unsigned char *ret_Out, uint64_t par_OutSize)
+{
+    z_stream s;
+    int Ret;
+    MEMSET(&s, 0, sizeof(s));
+    Ret = inflateInit(&s);
+    if (Ret != Z_OK) {
+        ThrowError(1, "cannot inflate");
+        return -1;
+    }
+    s.avail_in = (uInt)par_InSize;
+    s.next_in = par_In;
+    s.avail_out = (uInt)par_OutSize;
+    s.next_out = ret_Out;
+    Ret = inflate(&s, Z_NO_FLUSH);
+    inflateEnd(&s);
+    if (Ret != Z_STREAM_END) {
+        ThrowError(1, "cannot inflate");
+        return -1;
+    }
+    return 0;
+}
+
+// Check if the current record is complete inside the cache
+static int CurrentRecordIsInsideCache(MDF4_DATA_GROUP_CACHE *par_DataBlock)
+{
+    uint64_t Pos = par_DataBlock->CurrentFilePos;
+    uint64_t SizeOfRecord;
+
+    if (par_DataBlock->BlockData == NULL) return 0;
+    if ((Pos + (uint64_t)par_DataBlock->SizeOfRecordID + par_DataBlock->LargesRecord) <= par_DataBlock->EndCacheFilePos) return 1;
+    if ((Pos + (uint64_t)par_DataBlock->SizeOfRecordID) > par_DataBlock->EndCacheFilePos) return 0;
+    if (par_DataBlock->SizeOfRecordID == 0) {
+        SizeOfRecord = par_DataBlock->Records[0].SizeOfOneRecord;
+    } else {
+        int Idx = TranslateChannelIdToIndex(par_DataBlock, *(par_DataBlock->BlockData + (Pos - par_DataBlock->StartCacheFilePos)));
+        if (Idx < 0) return 0;
+        SizeOfRecord = par_DataBlock->Records[Idx].SizeOfOneRecord + sizeof(uint8_t) * par_DataBlock->SizeOfRecordID;
+    }
+    return ((Pos + SizeOfRecord) <= par_DataBlock->EndCacheFilePos);
+}
+
+static int CheckBlockBuffer(MDF4_DATA_GROUP_CACHE *DataBlock)
 {
-    int Readed;
-    unsigned char *Data = NULL;
+    if (DataBlock->BlockBuffer == NULL) {
+        // a not complete record from the block before and some spare bytes because GetValue() reads 64 bits
+        DataBlock->SizeOfBlockBuffer = DataBlock->LargestBlockSize + DataBlock->LargesRecord + DataBlock->SizeOfRecordID + 16;
+        DataBlock->BlockBuffer = my_malloc (DataBlock->SizeOfBlockBuffer);
+        if (DataBlock->BlockBuffer == NULL) {
+            ThrowError(1, "cannot alloc memory");
+            return -1;
+        }
+    }
+    return 0;
+}
 
-    if (DataBlock->BlockData == NULL) {
-        DataBlock->BlockData = my_malloc (DataBlock->LargestBlockSize + DataBlock->LargesRecord);
-        if (DataBlock->BlockData == NULL) {
+// Inflate (and inverse transpose) a compressed data block into ret_Data
+static int InflateBlock(MDF4_STIMULI_FILE *par_Mdf, MDF4_DATA_GROUP_CACHE *DataBlock, MDF4_DATA_BLOCK_CACHE *Block, unsigned char *ret_Data)
+{
+    unsigned char *Deflated;
+    if ((DataBlock->BlockDeflatedData == NULL) && (par_Mdf->MappedFile == NULL)) {
+        DataBlock->BlockDeflatedData = my_malloc (DataBlock->LargestDeflatedBlockSize);
+        if (DataBlock->BlockDeflatedData == NULL) {
             ThrowError(1, "cannot alloc memory");
             return -1;
         }
-        Data = DataBlock->BlockData;
-        DataBlock->CurrentBlock = 0;
-        DataBlock->StartCacheFilePos = DataBlock->Blocks[DataBlock->CurrentBlock].OffsetInsideFile;
-        DataBlock->CurrentFilePos = DataBlock->StartCacheFilePos;
-        DataBlock->SizeOfBlock = DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfBlock;
-        DataBlock->EndCacheFilePos = DataBlock->StartCacheFilePos + DataBlock->SizeOfBlock;
-        // if we have compressed parts also setup a buffer for the copressed data
-        if (DataBlock->LargestDeflatedBlockSize > 0) {
-            DataBlock->BlockDeflatedData = my_malloc (DataBlock->LargestDeflatedBlockSize);
-            if (DataBlock->BlockDeflatedData == NULL) {
+    }
+    // it is a compressed data block
+    Deflated = ReadFromFile(par_Mdf, Block->OffsetInsideFile, Block->SizeOfDeflatedBlock, DataBlock->BlockDeflatedData);
+    if (Deflated == NULL) return -1;
+    if (Block->InflateType == 0) {
+        if (Inflate(Deflated, Block->SizeOfDeflatedBlock, ret_Data, Block->SizeOfBlock)) return -1;
+    } else if (Block->InflateType == 1) {
+        // transposed and compressed
+        if (DataBlock->BlockDeflatedAndTransposedData == NULL) {
+            DataBlock->BlockDeflatedAndTransposedData = my_malloc (DataBlock->LargestBlockSize);
+            if (DataBlock->BlockDeflatedAndTransposedData == NULL) {
                 ThrowError(1, "cannot alloc memory");
                 return -1;
             }
-            if (DataBlock->HaveTransposedData) {
-                DataBlock->BlockDeflatedAndTransposedData = my_malloc (DataBlock->LargestBlockSize);
-                if (DataBlock->BlockDeflatedAndTransposedData == NULL) {
-                    ThrowError(1, "cannot alloc memory");
-                    return -1;
-                }
-            }
         }
+        if (Inflate(Deflated, Block->SizeOfDeflatedBlock, DataBlock->BlockDeflatedAndTransposedData, Block->SizeOfBlock)) return -1;
+        InverseTranspose(DataBlock->BlockDeflatedAndTransposedData, ret_Data, (int)Block->SizeOfBlock, (int)Block->Parameter);
     } else {
-        // copy the left bytes to the beginning of the cache
-        if (DataBlock->CurrentBlock < DataBlock->NoOfBlocks) {
-            uint64_t Left = DataBlock->EndCacheFilePos - DataBlock->CurrentFilePos;
-            if (Left > 0) {
-                MEMCPY (DataBlock->BlockData,
-                        DataBlock->BlockData + (DataBlock->CurrentFilePos - DataBlock->StartCacheFilePos),
-                        Left);
-            }
-            Data = DataBlock->BlockData + Left;
-            DataBlock->StartCacheFilePos = DataBlock->Blocks[DataBlock->CurrentBlock].OffsetInsideFile - Left;
-            DataBlock->CurrentFilePos = DataBlock->StartCacheFilePos;
-            DataBlock->SizeOfBlock = DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfBlock + Left;
-            DataBlock->EndCacheFilePos = DataBlock->StartCacheFilePos + DataBlock->SizeOfBlock;
-        }
+        ThrowError(1, "unknown compression type %i", Block->InflateType);
+        return -1;
     }
-    // Switch to next block if there are one
-    if ((Data != NULL) && (DataBlock->CurrentBlock < DataBlock->NoOfBlocks)) {
-        if (DebugOut != NULL) { fprintf (DebugOut, "Update cache %i: offset=%" PRIx64 ", size=%" PRIx64 "\n",
-                                         (int)(DataBlock - par_Mdf->Cache.DataGroups),
-                                         DataBlock->Blocks[DataBlock->CurrentBlock].OffsetInsideFile, DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfBlock); FFLUSH_DEBUGOUT; }
-
-        my_lseek(par_Mdf->fh, DataBlock->Blocks[DataBlock->CurrentBlock].OffsetInsideFile);
-        if (DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfDeflatedBlock > 0) {
-            if (DataBlock->Blocks[DataBlock->CurrentBlock].InflateType == 0) {
-                z_stream s;
-                int Ret;
-                MEMSET(&s, 0, sizeof(s));
-                Ret = inflateInit(&s);
-                if (Ret != Z_OK) {
-                    ThrowError(1, "cannot inflate");
-                    return -1;
-                }
-                // it is a compressed data block
-                Readed = my_read(par_Mdf->fh, DataBlock->BlockDeflatedData, (uint32_t)DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfDeflatedBlock);
-                // now we should decompress the data
-                s.avail_in = DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfDeflatedBlock;
-                s.next_in = DataBlock->BlockDeflatedData;
-                s.avail_out = DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfBlock;
-                s.next_out = Data;
-                Ret = inflate(&s, Z_NO_FLUSH);
-                if (Ret != Z_STREAM_END) {
-                    inflateEnd(&s);
-                    ThrowError(1, "cannot inflate");
-                    return -1;
-                }
-                inflateEnd(&s);
-            } else if (DataBlock->Blocks[DataBlock->CurrentBlock].InflateType == 1) {
-                z_stream s;
-                int Ret;
-                MEMSET(&s, 0, sizeof(s));
-                Ret = inflateInit(&s);
-                if (Ret != Z_OK) {
-                    ThrowError(1, "cannot inflate");
-                    return -1;
-                }
-                // it is a compressed data block
-                Readed = my_read(par_Mdf->fh, DataBlock->BlockDeflatedData, (uint32_t)DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfDeflatedBlock);
-                // now we should decompress the data
-                s.avail_in = DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfDeflatedBlock;
-                s.next_in = DataBlock->BlockDeflatedData;
-                s.avail_out = DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfBlock;
-                s.next_out = DataBlock->BlockDeflatedAndTransposedData;
-                Ret = inflate(&s, Z_NO_FLUSH);
-                if (Ret != Z_STREAM_END) {
-                    inflateEnd(&s);
-                    ThrowError(1, "cannot inflate");
-                    return -1;
-                }
-                inflateEnd(&s);
-                InverseTranspose(DataBlock->BlockDeflatedAndTransposedData, Data, DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfBlock,
-                                 DataBlock->Blocks[DataBlock->CurrentBlock].Parameter);
-            } else {
-                ThrowError(1, "unknown compression type %i", DataBlock->Blocks[DataBlock->CurrentBlock].InflateType);
-                return -1;
-            }
-        } else {
-            Readed = my_read(par_Mdf->fh, Data, (uint32_t)DataBlock->Blocks[DataBlock->CurrentBlock].SizeOfBlock);
+    return 0;
+}
+
+// Switch to the next data block, a not complete record at the end of the current block will be
+// moved in front of the new block. Not compressed blocks are used directly inside the mapped file if possible.
+static int UpdateCache(MDF4_STIMULI_FILE *par_Mdf, MDF4_DATA_GROUP_CACHE *DataBlock)
+{
+    MDF4_DATA_BLOCK_CACHE *Block;
+    uint64_t Left = 0;
+    unsigned char *Data;
+
+    // BlockData is NULL at the beginning or after a seek, CurrentBlock is already set
+    if ((DataBlock->BlockData != NULL) && (DataBlock->CurrentFilePos < DataBlock->EndCacheFilePos)) {
+        Left = DataBlock->EndCacheFilePos - DataBlock->CurrentFilePos;
+    }
+    if (DataBlock->CurrentBlock >= DataBlock->NoOfBlocks) {
+        DataBlock->CurrentBlock = DataBlock->NoOfBlocks + 1;
+        return -1;
+    }
+    Block = &(DataBlock->Blocks[DataBlock->CurrentBlock]);
+
+    if (DebugOut != NULL) { fprintf (DebugOut, "Update cache %i: offset=%" PRIx64 ", size=%" PRIx64 "\n",
+                                     (int)(DataBlock - par_Mdf->Cache.DataGroups),
+                                     Block->OffsetInsideFile, Block->SizeOfBlock); FFLUSH_DEBUGOUT; }
+
+    if ((Left == 0) && (Block->SizeOfDeflatedBlock == 0) && (par_Mdf->MappedFile != NULL) &&
+        ((Block->OffsetInsideFile + Block->SizeOfBlock + 16) <= par_Mdf->SizeOfFile)) {
+        // zero copy
+        DataBlock->BlockData = par_Mdf->MappedFile + Block->OffsetInsideFile;
+    } else {
+        if (CheckBlockBuffer(DataBlock)) return -1;
+        if (Left > 0) {
+            // copy the left bytes to the beginning of the cache
+            unsigned char *Src = DataBlock->BlockData + (DataBlock->CurrentFilePos - DataBlock->StartCacheFilePos);
+            if (Src != DataBlock->BlockBuffer) memmove (DataBlock->BlockBuffer, Src, Left);
         }
-        DataBlock->CurrentBlock++;
-        if (Readed == (int)DataBlock->SizeOfBlock) {
-            return 0;
+        Data = DataBlock->BlockBuffer + Left;
+        if (Block->SizeOfDeflatedBlock > 0) {
+            if (InflateBlock(par_Mdf, DataBlock, Block, Data)) return -1;
         } else {
-            return -1;
+            unsigned char *Src = ReadFromFile(par_Mdf, Block->OffsetInsideFile, Block->SizeOfBlock, Data);
+            if (Src == NULL) return -1;
+            if (Src != Data) MEMCPY (Data, Src, Block->SizeOfBlock);
         }
-    } else {
-        DataBlock->CurrentBlock++;
-        return -1;
+        DataBlock->BlockData = DataBlock->BlockBuffer;
     }
+    DataBlock->StartCacheFilePos = Block->OffsetInsideFile - Left;
+    DataBlock->CurrentFilePos = DataBlock->StartCacheFilePos;
+    DataBlock->SizeOfBlock = Block->SizeOfBlock + Left;
+    DataBlock->EndCacheFilePos = DataBlock->StartCacheFilePos + DataBlock->SizeOfBlock;
+    DataBlock->CurrentBlock++;
+    // read ahead of the following block
+    if ((par_Mdf->MappedFile != NULL) && (DataBlock->CurrentBlock < DataBlock->NoOfBlocks)) {
+        MDF4_DATA_BLOCK_CACHE *Next = &(DataBlock->Blocks[DataBlock->CurrentBlock]);
+        my_map_file_will_need(par_Mdf->MappedFile, Next->OffsetInsideFile,
+                              (Next->SizeOfDeflatedBlock > 0) ? Next->SizeOfDeflatedBlock : Next->SizeOfBlock);
+    }
+    return 0;
 }
 
 __inline static int ConvWithSign (uint64_t value, int size, int sign, union FloatOrInt64 *ret_value)
@@ -1254,10 +1426,55 @@ __inline static int ConvWithSign (uint64_t value, int size, int sign, union Floa
 }
 
 #ifdef __GNUC__
+#define _byteswap_ushort __builtin_bswap16
 #define _byteswap_ulong __builtin_bswap32
 #define _byteswap_uint64 __builtin_bswap64
 #endif
 
+// Load a byte aligned value with 1, 2, 4 or 8 bytes
+__inline static uint64_t LoadAligned (const unsigned char *par_Data, int par_ByteSize, int par_Swap)
+{
+    uint16_t U16;
+    uint32_t U32;
+    uint64_t U64;
+
+    switch (par_ByteSize) {
+    case 1:
+        return *par_Data;
+    case 2:
+        MEMCPY (&U16, par_Data, sizeof (U16));
+        return par_Swap ? _byteswap_ushort (U16) : U16;
+    case 4:
+        MEMCPY (&U32, par_Data, sizeof (U32));
+        return par_Swap ? _byteswap_ulong (U32) : U32;
+    default:
+    case 8:
+        MEMCPY (&U64, par_Data, sizeof (U64));
+        return par_Swap ? _byteswap_uint64 (U64) : U64;
+    }
+}
+
+// The MDF data type is the same as the blackboard data type
+__inline static void CopyAligned (const unsigned char *par_Data, int par_ByteSize, int par_Swap, union BB_VARI *ret_Value)
+{
+    uint64_t Value = LoadAligned (par_Data, par_ByteSize, par_Swap);
+    switch (par_ByteSize) {
+    case 1:
+        ret_Value->ub = (uint8_t)Value;
+        break;
+    case 2:
+        ret_Value->uw = (uint16_t)Value;
+        break;
+    case 4:
+        ret_Value->udw = (uint32_t)Value;
+        break;
+    default:
+    case 8:
+        ret_Value->uqw = Value;
+        break;
+    }
+}
+
 __inline static uint64_t GetValue (unsigned char *par_Data, int par_ByteOrder, int par_StartBit, int par_BitSize, int par_RecordSize)
 {
     uint32_t PosByte;
@@ -1336,6 +1553,33 @@ static int ConvertValue(unsigned char* par_Data, int par_DataType, int par_Start
     }
 }
 
+// Same as ConvertValue() but for byte aligned 8, 16, 32 or 64 bit values
+static int ConvertAlignedValue(unsigned char* par_Data, int par_DataType, int par_ByteSize, union FloatOrInt64 *ret_Value)
+{
+    uint64_t HelpU64 = LoadAligned(par_Data, par_ByteSize, par_DataType & 0x1);
+    switch(par_DataType) {
+    case 0: //    0 = unsigned integer little endian
+    case 1: //    1 = unsigned integer big endian
+        return ConvWithSign(HelpU64, par_ByteSize << 3, 0, ret_Value);
+    case 2: //    2 = signed integer (twos complement) little endian
+    case 3: //    3 = signed integer (twos complement) big endian
+        return ConvWithSign(HelpU64, par_ByteSize << 3, 1, ret_Value);
+    case 4: //    4 = IEEE 754 floating-point format little endian
+    case 5: //    5 = IEEE 754 floating-point format big endian
+        if (par_ByteSize == 4) {
+            uint32_t HelpU32 = (uint32_t)HelpU64;
+            float HelpFloat;
+            MEMCPY (&HelpFloat, &HelpU32, sizeof (HelpFloat));
+            ret_Value->d = HelpFloat;
+        } else {
+            MEMCPY (&(ret_Value->d), &HelpU64, sizeof (double));
+        }
+        return FLOAT_OR_INT_64_TYPE_F64;
+    default:
+        return FLOAT_OR_INT_64_TYPE_INVALID;
+    }
+}
+
 static uint64_t ConvertTimeVariableToUInt64(MDF4_RECORD_CACHE *par_Record, unsigned char *par_Cache, uint64_t CachePos)
 {
     union FloatOrInt64 Value;
@@ -1378,8 +1622,20 @@ static int GetTimeOfCurrentRecord(MDF4_STIMULI_FILE *par_Mdf, MDF4_DATA_GROUP_CA
     if (par_DataBlock->CurrentBlock > par_DataBlock->NoOfBlocks) {
         return STIMULI_END_OF_FILE;
     }
-    if ((par_DataBlock->CurrentFilePos + par_DataBlock->LargesRecord) >= par_DataBlock->EndCacheFilePos) {
-        UpdateCache(par_Mdf, par_DataBlock);
+    // the time of a data group will be requested again and again till its record was played
+    if (par_DataBlock->CurrentTimeValid) {
+        *ret_t = par_DataBlock->CurrentTime;
+        return 0;
+    }
+    if (!CurrentRecordIsInsideCache(par_DataBlock)) {
+        if (UpdateCache(par_Mdf, par_DataBlock)) {
+            par_DataBlock->CurrentBlock = par_DataBlock->NoOfBlocks + 1;
+            return STIMULI_END_OF_FILE;
+        }
+        if (!CurrentRecordIsInsideCache(par_DataBlock)) {
+            par_DataBlock->CurrentBlock = par_DataBlock->NoOfBlocks + 1;
+            return STIMULI_END_OF_FILE;
+        }
     }
     CachePos = par_DataBlock->CurrentFilePos - par_DataBlock->StartCacheFilePos;
     if (par_DataBlock->SizeOfRecordID == 0) {
@@ -1393,6 +1649,8 @@ static int GetTimeOfCurrentRecord(MDF4_STIMULI_FILE *par_Mdf, MDF4_DATA_GROUP_CA
     Record = &(par_DataBlock->Records[Idx]);
 
     *ret_t = ConvertTimeVariableToUInt64(Record, par_DataBlock->BlockData, CachePos);
+    par_DataBlock->CurrentTime = *ret_t;
+    par_DataBlock->CurrentTimeValid = 1;
 
     /*if (DebugOut != NULL) { fprintf (DebugOut, "Time %i: cache pos=%llu ret=%llu\n",
                                      (int)(par_DataBlock - par_Mdf->Cache.DataGroups), CachePos, *ret_t);
@@ -1411,6 +1669,7 @@ static int AddCurrentRecordToSampleSlot(MDF4_DATA_GROUP_CACHE *par_DataBlock,
     union FloatOrInt64 Value;
     int Type;
     uint64_t CachePos;
+    unsigned char *Data;
     int Pos = par_PipePos;
 
     CachePos = par_DataBlock->CurrentFilePos - par_DataBlock->StartCacheFilePos;
@@ -1421,16 +1680,33 @@ static int AddCurrentRecordToSampleSlot(MDF4_DATA_GROUP_CACHE *par_DataBlock,
         CachePos += sizeof(uint8_t);
     }
     Record = &(par_DataBlock->Records[Idx]);
+    Data = par_DataBlock->BlockData + CachePos;
     for (v = 0; v < Record->NumberOfEntrys; v++) {
         Entry = &(Record->Entrys[v]);
-        Type = ConvertValue(par_DataBlock->BlockData + CachePos, Entry->DataType, Entry->StartBitOffset,
-                            Entry->NumberOfBits, Record->SizeOfOneRecord, &Value);
-        sc_convert_from_FloatOrInt64_to_BB_VARI(Type, Value, Entry->BbDataType, &(pipevari_list[Pos].value));
+        switch (Entry->Extractor) {
+        case MDF4_EXTRACT_COPY:
+            CopyAligned(Data + Entry->ByteOffset, Entry->ByteSize, 0, &(pipevari_list[Pos].value));
+            break;
+        case MDF4_EXTRACT_COPY_SWAP:
+            CopyAligned(Data + Entry->ByteOffset, Entry->ByteSize, 1, &(pipevari_list[Pos].value));
+            break;
+        case MDF4_EXTRACT_ALIGNED:
+            Type = ConvertAlignedValue(Data + Entry->ByteOffset, Entry->DataType, Entry->ByteSize, &Value);
+            sc_convert_from_FloatOrInt64_to_BB_VARI(Type, Value, Entry->BbDataType, &(pipevari_list[Pos].value));
+            break;
+        default:
+        case MDF4_EXTRACT_BIT_FIELD:
+            Type = ConvertValue(Data, Entry->DataType, Entry->StartBitOffset,
+                                Entry->NumberOfBits, Record->SizeOfOneRecord, &Value);
+            sc_convert_from_FloatOrInt64_to_BB_VARI(Type, Value, Entry->BbDataType, &(pipevari_list[Pos].value));
+            break;
+        }
         pipevari_list[Pos].vid = Entry->Vid;
         pipevari_list[Pos].type = Entry->BbDataType;
         Pos++;
     }
     par_DataBlock->CurrentFilePos += Record->SizeOfOneRecord + (sizeof (uint8_t) * par_DataBlock->SizeOfRecordID);
+    par_DataBlock->CurrentTimeValid = 0;
     return Pos;
 }
 
@@ -1477,10 +1753,225 @@ int Mdf4ReadOneStimuliTimeSlot(STIMULI_FILE *par_File, VARI_IN_PIPE *pipevari_li
     }
 }
 
+// Find the data block which contains the position par_Pos of the record stream
+static int FindBlockOfStreamPos(MDF4_DATA_GROUP_CACHE *par_DataBlock, uint64_t par_Pos)
+{
+    int Lo = 0;
+    int Hi = par_DataBlock->NoOfBlocks - 1;
+
+    if ((Hi < 0) || (par_Pos >= par_DataBlock->SizeOfRecordStream)) return -1;
+    while (Lo < Hi) {
+        int Mid = (Lo + Hi + 1) >> 1;
+        if (par_DataBlock->Blocks[Mid].OffsetInsideRecordStream <= par_Pos) Lo = Mid;
+        else Hi = Mid - 1;
+    }
+    return Lo;
+}
+
+// Copy par_Size bytes from the position par_Pos of the record stream into ret_Data,
+// the bytes can be split over more than one data block
+static int ReadRecordStream(MDF4_STIMULI_FILE *par_Mdf, MDF4_DATA_GROUP_CACHE *par_DataBlock,
+                            uint64_t par_Pos, uint64_t par_Size, unsigned char *ret_Data)
+{
+    while (par_Size > 0) {
+        MDF4_DATA_BLOCK_CACHE *Block;
+        uint64_t InsideBlock, Size;
+        int b = FindBlockOfStreamPos(par_DataBlock, par_Pos);
+        if (b < 0) return -1;
+        Block = &(par_DataBlock->Blocks[b]);
+        InsideBlock = par_Pos - Block->OffsetInsideRecordStream;
+        Size = Block->SizeOfBlock - InsideBlock;
+        if (Size > par_Size) Size = par_Size;
+        if (Block->SizeOfDeflatedBlock > 0) {
+            // the last inflated block will be kept, a binary search will touch it more than once
+            if (par_DataBlock->IndexBlock != b) {
+                if (par_DataBlock->IndexBlockData == NULL) {
+                    par_DataBlock->IndexBlockData = my_malloc (par_DataBlock->LargestBlockSize);
+                    if (par_DataBlock->IndexBlockData == NULL) {
+                        ThrowError(1, "cannot alloc memory");
+                        return -1;
+                    }
+                }
+                par_DataBlock->IndexBlock = -1;
+                if (InflateBlock(par_Mdf, par_DataBlock, Block, par_DataBlock->IndexBlockData)) return -1;
+                par_DataBlock->IndexBlock = b;
+            }
+            MEMCPY (ret_Data, par_DataBlock->IndexBlockData + InsideBlock, Size);
+        } else {
+            unsigned char *Src = ReadFromFile(par_Mdf, Block->OffsetInsideFile + InsideBlock, Size, ret_Data);
+            if (Src == NULL) return -1;
+            if (Src != ret_Data) MEMCPY (ret_Data, Src, Size);
+        }
+        ret_Data += Size;
+        par_Pos += Size;
+        par_Size -= Size;
+    }
+    return 0;
+}
+
+// Time of the record with the number par_RecordNumber (only data groups without record IDs)
+static int GetTimeOfRecord(MDF4_STIMULI_FILE *par_Mdf, MDF4_DATA_GROUP_CACHE *par_DataBlock, uint64_t par_RecordNumber, uint64_t *ret_t)
+{
+    MDF4_RECORD_CACHE *Record = &(par_DataBlock->Records[0]);
+
+    if (par_DataBlock->IndexRecord == NULL) {
+        // some spare bytes in front and behind because GetValue() reads 64 bits
+        par_DataBlock->IndexRecord = my_calloc (1, Record->SizeOfOneRecord + 32);
+        if (par_DataBlock->IndexRecord == NULL) {
+            ThrowError(1, "cannot alloc memory");
+            return -1;
+        }
+    }
+    if (ReadRecordStream(par_Mdf, par_DataBlock, par_RecordNumber * (uint64_t)Record->SizeOfOneRecord,
+                         Record->SizeOfOneRecord, par_DataBlock->IndexRecord + 8)) {
+        return -1;
+    }
+    *ret_t = ConvertTimeVariableToUInt64(Record, par_DataBlock->IndexRecord, 8);
+    return 0;
+}
+
+static uint64_t FirstRecordOfBlock(MDF4_DATA_GROUP_CACHE *par_DataBlock, int par_Block)
+{
+    uint64_t SizeOfRecord = (uint64_t)par_DataBlock->Records[0].SizeOfOneRecord;
+    return (par_DataBlock->Blocks[par_Block].OffsetInsideRecordStream + SizeOfRecord - 1) / SizeOfRecord;
+}
+
+// Time of the first record starting inside a data block, this is the time index of the data group.
+// It will be only filled for the blocks touched by a binary search
+static int GetFirstTimeOfBlock(MDF4_STIMULI_FILE *par_Mdf, MDF4_DATA_GROUP_CACHE *par_DataBlock, int par_Block, uint64_t *ret_t)
+{
+    MDF4_DATA_BLOCK_CACHE *Block = &(par_DataBlock->Blocks[par_Block]);
+
+    if (!Block->FirstTimeValid) {
+        uint64_t RecordNumber = FirstRecordOfBlock(par_DataBlock, par_Block);
+        if (((RecordNumber + 1) * (uint64_t)par_DataBlock->Records[0].SizeOfOneRecord) > par_DataBlock->SizeOfRecordStream) {
+            Block->FirstTime = 0xFFFFFFFFFFFFFFFFULL;   // no complete record starts inside or behind this block
+        } else if (GetTimeOfRecord(par_Mdf, par_DataBlock, RecordNumber, &(Block->FirstTime))) {
+            return -1;
+        }
+        Block->FirstTimeValid = 1;
+    }
+    *ret_t = Block->FirstTime;
+    return 0;
+}
+
+// Load the data block containing par_Pos and let the current record start at par_Pos
+static int PositionDataGroup(MDF4_STIMULI_FILE *par_Mdf, MDF4_DATA_GROUP_CACHE *par_DataBlock, uint64_t par_Pos)
+{
+    int b = FindBlockOfStreamPos(par_DataBlock, par_Pos);
+
+    par_DataBlock->BlockData = NULL;
+    par_DataBlock->CurrentTimeValid = 0;
+    if (b < 0) {
+        par_DataBlock->CurrentBlock = par_DataBlock->NoOfBlocks + 1;   // behind the last record
+        return 0;
+    }
+    par_DataBlock->CurrentBlock = b;
+    if (UpdateCache(par_Mdf, par_DataBlock)) {
+        par_DataBlock->CurrentBlock = par_DataBlock->NoOfBlocks + 1;
+        return -1;
+    }
+    par_DataBlock->CurrentFilePos = par_DataBlock->StartCacheFilePos + (par_Pos - par_DataBlock->Blocks[b].OffsetInsideRecordStream);
+    return 0;
+}
+
+// Data groups without record IDs have a fixed record size, so the records can be addressed directly.
+// First a binary search over the time index of the blocks, than over the records between
+static int SeekDataGroupWithoutRecordIds(MDF4_STIMULI_FILE *par_Mdf, MDF4_DATA_GROUP_CACHE *par_DataBlock, uint64_t par_Time)
+{
+    uint64_t SizeOfRecord = (uint64_t)par_DataBlock->Records[0].SizeOfOneRecord;
+    uint64_t NumberOfRecords = par_DataBlock->SizeOfRecordStream / SizeOfRecord;
+    uint64_t LoRecord, HiRecord, Time;
+    int Lo = 0;
+    int Hi = par_DataBlock->NoOfBlocks;
+
+    // first block which first record is not before par_Time
+    while (Lo < Hi) {
+        int Mid = (Lo + Hi) >> 1;
+        if (GetFirstTimeOfBlock(par_Mdf, par_DataBlock, Mid, &Time)) return -1;
+        if (Time < par_Time) Lo = Mid + 1;
+        else Hi = Mid;
+    }
+    LoRecord = (Lo > 0) ? FirstRecordOfBlock(par_DataBlock, Lo - 1) : 0;
+    HiRecord = (Lo < par_DataBlock->NoOfBlocks) ? FirstRecordOfBlock(par_DataBlock, Lo) : NumberOfRecords;
+    if (HiRecord > NumberOfRecords) HiRecord = NumberOfRecords;
+    // first record which is not before par_Time
+    while (LoRecord < HiRecord) {
+        uint64_t Mid = LoRecord + ((HiRecord - LoRecord) >> 1);
+        if (GetTimeOfRecord(par_Mdf, par_DataBlock, Mid, &Time)) return -1;
+        if (Time < par_Time) LoRecord = Mid + 1;
+        else HiRecord = Mid;
+    }
+    return PositionDataGroup(par_Mdf, par_DataBlock, LoRecord * SizeOfRecord);
+}
+
+// Records with IDs have different sizes, they must be skipped one by one (without converting the values)
+static int SeekDataGroupWithRecordIds(MDF4_STIMULI_FILE *par_Mdf, MDF4_DATA_GROUP_CACHE *par_DataBlock, uint64_t par_Time)
+{
+    uint64_t Time;
+
+    if (PositionDataGroup(par_Mdf, par_DataBlock, 0)) return -1;
+    while (GetTimeOfCurrentRecord(par_Mdf, par_DataBlock, &Time) == 0) {
+        int Idx;
+        if (Time >= par_Time) break;
+        Idx = TranslateChannelIdToIndex(par_DataBlock, *(par_DataBlock->BlockData + (par_DataBlock->CurrentFilePos - par_DataBlock->StartCacheFilePos)));
+        if (Idx < 0) return -1;
+        par_DataBlock->CurrentFilePos += par_DataBlock->Records[Idx].SizeOfOneRecord + (sizeof (uint8_t) * par_DataBlock->SizeOfRecordID);
+        par_DataBlock->CurrentTimeValid = 0;
+    }
+    return 0;
+}
+
+// Position all data groups to the first record with a time stamp >= par_Time,
+// par_Time is relative to the first time stamp of the file (same as the times returned by Mdf4ReadOneStimuliTimeSlot)
+int Mdf4SeekStimuliFile(STIMULI_FILE *par_File, uint64_t par_Time)
+{
+    MDF4_STIMULI_FILE *Mdf = (MDF4_STIMULI_FILE*)par_File->File;
+    MDF4_DATA_GROUP_CACHE *DataBlock;
+    uint64_t Time;
+    uint64_t FirstTimeStamp = 0xFFFFFFFFFFFFFFFFULL;
+    int b, Ret = 0;
+
+    // the first time stamp is the earliest first record of all data groups
+    for (b = 0; b < Mdf->Cache.NumberOfDataGroups; b++) {
+        DataBlock = &(Mdf->Cache.DataGroups[b]);
+        if (DataBlock->NoOfAllSignals == 0) continue;
+        if (PositionDataGroup(Mdf, DataBlock, 0)) return -1;
+        if (GetTimeOfCurrentRecord(Mdf, DataBlock, &Time) == 0) {
+            if (Time < FirstTimeStamp) FirstTimeStamp = Time;
+        }
+    }
+    Mdf->FirstTimeStamp = FirstTimeStamp;
+    if ((FirstTimeStamp == 0xFFFFFFFFFFFFFFFFULL) || (par_Time == 0)) {
+        return 0;  // empty file or start from the beginning
+    }
+
+    for (b = 0; (b < Mdf->Cache.NumberOfDataGroups) && (Ret == 0); b++) {
+        DataBlock = &(Mdf->Cache.DataGroups[b]);
+        if (DataBlock->NoOfAllSignals == 0) continue;
+        if ((DataBlock->SizeOfRecordID == 0) && (DataBlock->Records[0].SizeOfOneRecord > 0)) {
+            Ret = SeekDataGroupWithoutRecordIds(Mdf, DataBlock, FirstTimeStamp + par_Time);
+        } else {
+            Ret = SeekDataGroupWithRecordIds(Mdf, DataBlock, FirstTimeStamp + par_Time);
+        }
+        if (Ret) {
+            ThrowError(1, "cannot seek inside data group %i", b);
+        }
+        // the inflated block is only needed while seeking
+        if (DataBlock->IndexBlockData != NULL) {
+            my_free(DataBlock->IndexBlockData);
+            DataBlock->IndexBlockData = NULL;
+            DataBlock->IndexBlock = -1;
+        }
+    }
+    return Ret;
+}
+
 static void FreeDataStruct(MDF4_STIMULI_FILE *par_Mdf)
 {
     if (par_Mdf != NULL) {
         int x;
+        if (par_Mdf->MappedFile != NULL) my_unmap_file(par_Mdf->MappedFile, par_Mdf->SizeOfFile, par_Mdf->MapHandle);
         if (par_Mdf->fh != MY_INVALID_HANDLE_VALUE) my_close(par_Mdf->fh);
         if (par_Mdf->vids != NULL) my_free(par_Mdf->vids);
         if (par_Mdf->dtypes != NULL) my_free(par_Mdf->dtypes);
@@ -1494,9 +1985,11 @@ static void FreeDataStruct(MDF4_STIMULI_FILE *par_Mdf)
                 }
                 my_free(par_Mdf->Cache.DataGroups[x].Records);
             }
-            if (par_Mdf->Cache.DataGroups[x].BlockData != NULL) my_free(par_Mdf->Cache.DataGroups[x].BlockData);
+            if (par_Mdf->Cache.DataGroups[x].BlockBuffer != NULL) my_free(par_Mdf->Cache.DataGroups[x].BlockBuffer);
             if (par_Mdf->Cache.DataGroups[x].BlockDeflatedData != NULL) my_free(par_Mdf->Cache.DataGroups[x].BlockDeflatedData);
             if (par_Mdf->Cache.DataGroups[x].BlockDeflatedAndTransposedData != NULL) my_free(par_Mdf->Cache.DataGroups[x].BlockDeflatedAndTransposedData);
+            if (par_Mdf->Cache.DataGroups[x].IndexBlockData != NULL) my_free(par_Mdf->Cache.DataGroups[x].IndexBlockData);
+            if (par_Mdf->Cache.DataGroups[x].IndexRecord != NULL) my_free(par_Mdf->Cache.DataGroups[x].IndexRecord);
             if (par_Mdf->Cache.DataGroups[x].Blocks) my_free(par_Mdf->Cache.DataGroups[x].Blocks);
         }
         my_free(par_Mdf->Cache.DataGroups);
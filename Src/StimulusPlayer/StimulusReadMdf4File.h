@@ -28,6 +28,10 @@ typedef  struct {
     int BbDataType;
     int NumberOfBits;
     int StartBitOffset;
+    // precomputed extractor (MDF4_EXTRACT_...)
+    int Extractor;
+    int ByteOffset;
+    int ByteSize;
 } MDF4_RECORD_ENTRY;
 
 typedef struct {
@@ -54,11 +58,17 @@ typedef struct {
     uint64_t SizeOfDeflatedBlock;  // if 0 no copression
     uint32_t InflateType;
     uint32_t Parameter;
+    // time index, filled on demand by Mdf4SeekStimuliFile()
+    uint64_t OffsetInsideRecordStream;  // sum of the sizes of all blocks before
+    uint64_t FirstTime;                 // time of the first record starting inside this block
+    int FirstTimeValid;
 } MDF4_DATA_BLOCK_CACHE;
 
 
 typedef struct {
-    unsigned char *BlockData;
+    unsigned char *BlockData;     // points to BlockBuffer or directly into the mapped file
+    unsigned char *BlockBuffer;
+    uint64_t SizeOfBlockBuffer;
     unsigned char *BlockDeflatedData;
     unsigned char *BlockDeflatedAndTransposedData;
     MDF4_RECORD_CACHE *Records;
@@ -79,6 +89,15 @@ typedef struct {
     int HaveTransposedData;
 
     int SizeOfRecordID;
+
+    int CurrentTimeValid;
+    uint64_t CurrentTime;
+
+    // random access to the record stream (only used for seeking)
+    uint64_t SizeOfRecordStream;
+    unsigned char *IndexBlockData;
+    int IndexBlock;
+    unsigned char *IndexRecord;
 } MDF4_DATA_GROUP_CACHE;
 
 typedef struct {
@@ -89,6 +108,8 @@ typedef struct {
 typedef struct {
     MY_FILE_HANDLE fh;
     uint64_t SizeOfFile;
+    unsigned char *MappedFile;   // NULL if the file cannot be mapped
+    void *MapHandle;
     int *vids;
     int *dtypes;
     int size_of_vids;
@@ -111,6 +132,8 @@ int *Mdf4GetStimuliVariableIds(STIMULI_FILE *par_File);
 
 int Mdf4ReadOneStimuliTimeSlot (STIMULI_FILE* par_File, VARI_IN_PIPE *pipevari_list, uint64_t *ret_t);
 
+int Mdf4SeekStimuliFile (STIMULI_FILE* par_File, uint64_t par_Time);
+
 void Mdf4CloseStimuliFile(STIMULI_FILE* par_File);
 
 #endif
@@ -1235,6 +1235,112 @@ int MdfReadOneStimuliTimeSlot(STIMULI_FILE *par_File, VARI_IN_PIPE *pipevari_lis
     }
 }
 
+// Let the current record of a data group start at par_FilePos, the cache will be filled with the next access
+static void PositionDataBlock(MDF_DATA_BLOCK_CACHE *par_DataBlock, uint32_t par_FilePos)
+{
+    par_DataBlock->CurrentFilePos = par_FilePos;
+    par_DataBlock->StartCacheFilePos = par_FilePos;
+    par_DataBlock->EndCacheFilePos = par_FilePos;
+}
+
+// Time of the record with the number par_RecordNumber (only data groups without record IDs)
+static int GetTimeOfRecord(MDF_STIMULI_FILE *par_Mdf, MDF_DATA_BLOCK_CACHE *par_DataBlock, uint32_t par_RecordNumber,
+                           unsigned char *par_Buffer, uint64_t *ret_t)
+{
+    MDF_RECORD_CACHE *Record = &(par_DataBlock->Records[0]);
+
+    my_lseek(par_Mdf->fh, par_DataBlock->OffsetInsideFile + par_RecordNumber * (uint32_t)Record->SizeOfOneRecord);
+    // par_Buffer have some spare bytes in front and behind because GetValue() reads 64 bits
+    if (my_read(par_Mdf->fh, par_Buffer + 8, Record->SizeOfOneRecord) != Record->SizeOfOneRecord) {
+        return -1;
+    }
+    *ret_t = ConvertTimeVariableToUInt64(Record, par_Buffer, 8);
+    return 0;
+}
+
+// Data groups without record IDs have a fixed record size, so a binary search over the records is possible
+static int SeekDataBlockWithoutRecordIds(MDF_STIMULI_FILE *par_Mdf, MDF_DATA_BLOCK_CACHE *par_DataBlock, uint64_t par_Time)
+{
+    MDF_RECORD_CACHE *Record = &(par_DataBlock->Records[0]);
+    uint32_t Lo = 0;
+    uint32_t Hi = Record->NumberOfRecords;
+    uint64_t Time;
+    unsigned char *Buffer;
+
+    Buffer = (unsigned char*)my_calloc (1, Record->SizeOfOneRecord + 32);
+    if (Buffer == NULL) {
+        ThrowError(1, "out of memory");
+        return -1;
+    }
+    // first record which is not before par_Time
+    while (Lo < Hi) {
+        uint32_t Mid = Lo + ((Hi - Lo) >> 1);
+        if (GetTimeOfRecord(par_Mdf, par_DataBlock, Mid, Buffer, &Time)) {
+            my_free(Buffer);
+            return -1;
+        }
+        if (Time < par_Time) Lo = Mid + 1;
+        else Hi = Mid;
+    }
+    my_free(Buffer);
+    PositionDataBlock(par_DataBlock, par_DataBlock->OffsetInsideFile + Lo * (uint32_t)Record->SizeOfOneRecord);
+    return 0;
+}
+
+// Records with IDs have different sizes, they must be skipped one by one (without converting the values)
+static int SeekDataBlockWithRecordIds(MDF_STIMULI_FILE *par_Mdf, MDF_DATA_BLOCK_CACHE *par_DataBlock, uint64_t par_Time)
+{
+    uint64_t Time;
+
+    PositionDataBlock(par_DataBlock, par_DataBlock->OffsetInsideFile);
+    while (GetTimeOfCurrentRecord(par_Mdf, par_DataBlock, &Time) == 0) {
+        int Idx;
+        if (Time >= par_Time) break;
+        Idx = TranslateChannelIdToIndex(par_DataBlock, *(uint8_t*)(par_DataBlock->BlockData + (par_DataBlock->CurrentFilePos - par_DataBlock->StartCacheFilePos)));
+        if (Idx < 0) return -1;
+        par_DataBlock->CurrentFilePos += par_DataBlock->Records[Idx].SizeOfOneRecord + (sizeof (uint8_t) * par_DataBlock->NumberOfRecordIDs);
+    }
+    return 0;
+}
+
+// Position all data groups to the first record with a time stamp >= par_Time,
+// par_Time is relative to the first time stamp of the file (same as the times returned by MdfReadOneStimuliTimeSlot)
+int MdfSeekStimuliFile(STIMULI_FILE *par_File, uint64_t par_Time)
+{
+    MDF_STIMULI_FILE *Mdf = (MDF_STIMULI_FILE*)par_File->File;
+    MDF_DATA_BLOCK_CACHE *DataBlock;
+    uint64_t Time;
+    uint64_t FirstTimeStamp = 0xFFFFFFFFFFFFFFFFULL;
+    int b, Ret = 0;
+
+    // the first time stamp is the earliest first record of all data groups
+    for (b = 0; b < Mdf->Cache.NumberOfDataBlocks; b++) {
+        DataBlock = &(Mdf->Cache.DataBlocks[b]);
+        PositionDataBlock(DataBlock, DataBlock->OffsetInsideFile);
+        if (GetTimeOfCurrentRecord(Mdf, DataBlock, &Time) == 0) {
+            if (Time < FirstTimeStamp) FirstTimeStamp = Time;
+        }
+    }
+    Mdf->FirstTimeStamp = FirstTimeStamp;
+    if ((FirstTimeStamp == 0xFFFFFFFFFFFFFFFFULL) || (par_Time == 0)) {
+        return 0;  // empty file or start from the beginning
+    }
+
+    for (b = 0; (b < Mdf->Cache.NumberOfDataBlocks) && (Ret == 0); b++) {
+        DataBlock = &(Mdf->Cache.DataBlocks[b]);
+        if ((DataBlock->NumberOfRecordIDs == 0) && (DataBlock->NumberOfChannelGroups == 1) &&
+            (DataBlock->Records[0].SizeOfOneRecord > 0)) {
+            Ret = SeekDataBlockWithoutRecordIds(Mdf, DataBlock, FirstTimeStamp + par_Time);
+        } else {
+            Ret = SeekDataBlockWithRecordIds(Mdf, DataBlock, FirstTimeStamp + par_Time);
+        }
+        if (Ret) {
+            ThrowError(1, "cannot seek inside data group %i", b);
+        }
+    }
+    return Ret;
+}
+
 void MdfCloseStimuliFile(STIMULI_FILE *par_File)
 {
     if (par_File != NULL) {
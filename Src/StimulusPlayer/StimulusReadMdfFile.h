@@ -93,6 +93,8 @@ int *MdfGetStimuliVariableIds(STIMULI_FILE *par_File);
 
 int MdfReadOneStimuliTimeSlot (STIMULI_FILE* par_File, VARI_IN_PIPE *pipevari_list, uint64_t *ret_t);
 
+int MdfSeekStimuliFile (STIMULI_FILE* par_File, uint64_t par_Time);
+
 void MdfCloseStimuliFile(STIMULI_FILE* par_File);
 
 #endif
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COLUMN_FILE_STRUCTS_H
+#define COLUMN_FILE_STRUCTS_H
+
+#include <stdint.h>
+
+// Column recording file (*.xcol), all values are little endian
+//
+//   COLUMN_FILE_HEADER
+//   chunk group 0: time chunk, chunk of signal 0, chunk of signal 1, ...
+//   chunk group 1: ...
+//   string table (names and units, 0 terminated)
+//   COLUMN_FILE_SIGNAL[SignalCount]
+//   COLUMN_FILE_CHUNK[ChunkCount]    (index of all chunks: the time chunks of all groups, then the chunks
+//                                     of signal 0 of all groups, ...)
+//   COLUMN_FILE_TRAILER              (last bytes of the file)
+//
+// A chunk contains SampleCount values of one signal without any gap (the time chunk uint64_t
+// nanoseconds since the recording start). All chunks of one group have the same SampleCount.
+// So a single signal can be read without touching the data or the index entries of the other
+// signals, and the statistics inside the index allow to skip whole chunks.
+
+#define COLUMN_FILE_IDENTIFIER          "XILCOL  "
+#define COLUMN_FILE_TRAILER_IDENTIFIER  "XILCOLIX"
+#define COLUMN_FILE_VERSION             1
+
+#pragma pack(push,1)
+
+typedef struct {
+    char FileIdentifier[8];    // always contains COLUMN_FILE_IDENTIFIER
+    uint32_t Version;          // COLUMN_FILE_VERSION
+    uint32_t HeaderSize;       // sizeof(COLUMN_FILE_HEADER)
+    uint64_t StartTime;        // time in nanoseconds since 1970 of the recording start
+    uint32_t ChunkSamples;     // max. number of samples inside one chunk
+    uint32_t Reserved1;
+    uint64_t Reserved2[4];
+} COLUMN_FILE_HEADER;
+
+typedef struct {
+    uint32_t NameOffset;       // offset inside the string table
+    uint32_t UnitOffset;       // offset inside the string table
+    int32_t DataType;          // BB_BYTE ... BB_DOUBLE
+    uint32_t ByteSize;
+} COLUMN_FILE_SIGNAL;
+
+#define COLUMN_FILE_TIME_SIGNAL  0xFFFFFFFFu
+
+typedef struct {
+    uint64_t FileOffset;       // start of the values
+    uint64_t FirstSample;      // sample number of the first value
+    uint64_t FirstTime;        // time of the first and the last value inside the chunk (ns since recording start)
+    uint64_t LastTime;
+    double Min;                // smallest and largest value inside the chunk (NaN are ignored)
+    double Max;
+    uint32_t Signal;           // index inside the signal table or COLUMN_FILE_TIME_SIGNAL
+    uint32_t SampleCount;
+} COLUMN_FILE_CHUNK;
+
+typedef struct {
+    uint64_t StringTableOffset;
+    uint64_t SignalTableOffset;
+    uint64_t ChunkIndexOffset;
+    uint64_t SampleCount;
+    uint64_t ChunkCount;
+    uint32_t StringTableSize;
+    uint32_t SignalCount;
+    char TrailerIdentifier[8]; // always contains COLUMN_FILE_TRAILER_IDENTIFIER
+} COLUMN_FILE_TRAILER;
+
+#pragma pack(pop)
+
+#endif
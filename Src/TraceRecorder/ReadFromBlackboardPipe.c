@@ -38,7 +38,7 @@ int buffcount;
 
 void analyze_message (void)
 {
-    int x, f, i;
+    int f, i;
     FIFO_ENTRY_HEADER Header;
     int mvaricount;
     TRIGGER_INFO_MESS trigg_info;
@@ -59,12 +59,11 @@ void analyze_message (void)
                 }
                 rdpipe_frames[f].pipe_overflow_message = 0;
                 rdpipe_frames[f].pid = Header.TramsmiterPid;
-                rdpipe_frames[f].wrflag = 0;
+                rdpipe_frames[f].wrseqs = NULL;
                 rdpipe_frames[f].vids = (int32_t*)my_malloc (Header.Size);
                 rdpipe_frames[f].dec_phys_mask = (int8_t*)my_calloc ((size_t)(Header.Size/4), 1);
                 ReadFromFiFo (rdpipe_frames[f].ReqFiFo, &Header, (char*)rdpipe_frames[f].vids, Header.Size);
-                for (x = 0; x < (int)Header.Size / (int)sizeof (int32_t); x++)
-                    attach_bbvari_unknown_wait (rdpipe_frames[f].vids[x]);
+                attach_bbvari_frame ((int)Header.Size / (int)sizeof (int32_t), rdpipe_frames[f].vids, 1, GET_PID(), NULL);
                 rdpipe_frames[f].trigg_flag = 1;  /* If the trigger variable would not be trnsmited */
                 rdpipe_frames[f].trigg_status = 0;
                 rdpipe_frames[f].trigg_vid = 0L;
@@ -93,12 +92,21 @@ void analyze_message (void)
             case RDPIPE_SEND_LENGTH:
                 ReadFromFiFo (rdpipe_frames[f].ReqFiFo, &Header, (char*)&(rdpipe_frames[f].max_cycle), sizeof (uint32_t));
                 break;
-            case RDPIPE_SEND_WRFLAG:
-                if (Header.Size == sizeof (int64_t)) {
-                    ReadFromFiFo (rdpipe_frames[f].ReqFiFo, &Header, (char*)&rdpipe_frames[f].wrflag, sizeof (int64_t));
+            case RDPIPE_START:
+                RemoveOneMessageFromFiFo (rdpipe_frames[f].ReqFiFo);
+                if ((rdpipe_frames[f].vids == NULL) || (rdpipe_frames[f].wrseqs != NULL)) {
+                    WriteToFiFo (rdpipe_frames[f].AckFiFo, RDPIPE_ACK, GET_PID(), get_timestamp_counter(), 0, NULL);
+                    break;
+                }
+                for (i = 0; rdpipe_frames[f].vids[i] != 0; i++);
+                rdpipe_frames[f].wrseqs = (uint32_t*)my_calloc ((size_t)(i + 1), sizeof (uint32_t));
+                if (rdpipe_frames[f].wrseqs == NULL) {
+                    ThrowError (1, "out of memory");
+                    WriteToFiFo (rdpipe_frames[f].AckFiFo, RDPIPE_ACK, GET_PID(), get_timestamp_counter(), 0, NULL);
+                    break;
                 }
                 /* Read all variables which are include inside the frame from the blackboard */
-                /* without checking the write flag (first line inside the recording file */
+                /* without checking the write sequence numbers (first line inside the recording file */
                 /* and write this into the message queue (if trigger is not active) */
                 if (rdpipe_frames[f].trigg_flag) {
                     mvaricount = read_frame (&rdpipe_frames[f]);
@@ -125,7 +133,10 @@ void analyze_message (void)
                         remove_bbvari_unknown_wait (rdpipe_frames[f].trigg_vid);
                         rdpipe_frames[f].trigg_vid = 0L;
                     }
-                    rdpipe_frames[f].wrflag = 0;
+                    if (rdpipe_frames[f].wrseqs != NULL) {
+                        my_free (rdpipe_frames[f].wrseqs);
+                        rdpipe_frames[f].wrseqs = NULL;
+                    }
                     RemoveOneMessageFromFiFo (rdpipe_frames[f].ReqFiFo);
                 }
                 break;
@@ -157,8 +168,7 @@ int test_read_frame (PIPE_FRAME *pframe)
     int fnr;
 
     for (fnr = 0; pframe->vids[fnr] > 0; fnr++) {
-        if (test_wrflag (pframe->vids[fnr], pframe->wrflag)) {
-            reset_wrflag (pframe->vids[fnr], pframe->wrflag);
+        if (test_bbvari_wrseq (pframe->vids[fnr], &pframe->wrseqs[fnr]) == 1) {
             if (pframe->dec_phys_mask[fnr] &&
                 (HasConverion (pframe->vids[fnr]) == 1)) {
                 msgbuffer[i].value.d = read_bbvari_equ (pframe->vids[fnr]);
@@ -180,7 +190,7 @@ int read_frame (PIPE_FRAME *pframe)
     int type, fnr;
 
     for (fnr = 0; pframe->vids[fnr] > 0; fnr++) {
-        reset_wrflag (pframe->vids[fnr], pframe->wrflag);
+        pframe->wrseqs[fnr] = get_bbvari_wrseq (pframe->vids[fnr]);
         type = get_bbvaritype (pframe->vids[fnr]);
         if ((type != BB_UNKNOWN_WAIT) &&
             pframe->dec_phys_mask[fnr] &&
@@ -221,7 +231,7 @@ void cyclic_rdpipe (void)
     /* Blackboard control for each frame one fifo */
     for (f = 0; f < MAX_FIFOS; f++) {
         pframe = &rdpipe_frames[f];
-        if (pframe->wrflag != 0) {  /* was write flag transmitted ? */
+        if (pframe->wrseqs != NULL) {  /* was the frame started ? */
             if (pframe->trigg_flag) {
                 if (pframe->cycle_count++ > pframe->max_cycle) {
                     WriteToFiFo (pframe->DataFiFo, STOP_REC_MESSAGE, GET_PID(), get_timestamp_counter(), 0, NULL);
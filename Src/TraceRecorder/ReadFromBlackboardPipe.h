@@ -39,7 +39,7 @@ typedef struct {
     int32_t Fill2;
     int32_t *vids;              /*  List of the variable IDs */
     int8_t *dec_phys_mask;      /*  List of the physical flags */
-    uint64_t wrflag;            /*  The write flag to check if someboady has written to the blackboard variables */
+    uint32_t *wrseqs;           /*  Last seen write sequence numbers of the variables (NULL if not started) */
     int32_t trigg_vid;          /*  Trigger variable ID */
     double trigger_value;       /*  Trigger level */
     int32_t trigg_flag;         /*  Trigger flag */
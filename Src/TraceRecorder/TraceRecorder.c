@@ -37,6 +37,7 @@
 #include "ReadConfig.h"
 #include "TraceWriteMdfFile.h"
 #include "TraceWriteMdf4File.h"
+#include "TraceWriteColumnFile.h"
 #include "TimeStamp.h"
 #include "ExportA2L.h"
 
@@ -93,7 +94,6 @@ int init_recorder_message (MESSAGE_HEAD *mhead)
 
 int start_recorder (MESSAGE_HEAD *mhead, RECORDER_STRUCT *Recorder)
 {
-    uint64_t wrflag;
     int32_t *vids;
     char *dec_phys_flags;
     int x, y;
@@ -203,10 +203,8 @@ int start_recorder (MESSAGE_HEAD *mhead, RECORDER_STRUCT *Recorder)
 
         }
 
-        /* Fetch free write flag */
-        if ((status = get_free_wrflag (get_pid_by_name (PN_TRACE_RECORDER), &wrflag)) != 0) return status;
-        /* Transmit write flag to RDPIPE process */
-        if (WriteToFiFo (Recorder->ReqFiFo, RDPIPE_SEND_WRFLAG, GET_PID(), get_timestamp_counter(), sizeof (uint64_t), (char*)&wrflag)) {
+        /* Start the RDPIPE process */
+        if (WriteToFiFo (Recorder->ReqFiFo, RDPIPE_START, GET_PID(), get_timestamp_counter(), 0, NULL)) {
             ThrowError (1, "pipe overflow");
             Recorder->RecorderStatus = HDREC_SLEEP;
             return RDPIPE_NOT_RUNNING;
@@ -273,6 +271,7 @@ static int BuildRecorderFileNames (RECORDER_STRUCT *Recorder)
     STRING_COPY_TO_ARRAY (Recorder->TextFileName, Recorder->StartMessage.Filename);
     STRING_COPY_TO_ARRAY (Recorder->MdfFileName, Recorder->StartMessage.Filename);
     STRING_COPY_TO_ARRAY (Recorder->Mdf4FileName, Recorder->StartMessage.Filename);
+    STRING_COPY_TO_ARRAY (Recorder->ColumnFileName, Recorder->StartMessage.Filename);
 
     // If there would be writen more than oe file format the file extension will be ignored
     // and the default file extension would be used
@@ -292,6 +291,7 @@ static int BuildRecorderFileNames (RECORDER_STRUCT *Recorder)
         STRING_COPY_TO_ARRAY_OFSET (Recorder->TextFileName, StartExt, ".dat");
         STRING_COPY_TO_ARRAY_OFSET (Recorder->MdfFileName, StartExt, ".mdf");
         STRING_COPY_TO_ARRAY_OFSET (Recorder->Mdf4FileName, StartExt, ".mf4");
+        STRING_COPY_TO_ARRAY_OFSET (Recorder->ColumnFileName, StartExt, ".xcol");
     }
     return 0;
 }
@@ -500,6 +500,10 @@ int read_recorder_configfile (MESSAGE_HEAD *mhead, RECORDER_STRUCT *Recorder)
                 Recorder->StartMessage.FormatFlags |= REC_FORMAT_FLAG_MDF4;
                 Recorder->StartMessage.FormatCounter++;
                 break;
+            case COLUMN_FORMAT_TOKEN:
+                Recorder->StartMessage.FormatFlags |= REC_FORMAT_FLAG_COLUMN;
+                Recorder->StartMessage.FormatCounter++;
+                break;
             case TEXT_FORMAT_TOKEN:
                 Recorder->StartMessage.FormatFlags |= REC_FORMAT_FLAG_TEXT_STIMULI;
                 Recorder->StartMessage.FormatCounter++;
@@ -790,6 +794,7 @@ int InitFileWriter (RECORDER_STRUCT *Recorder, uint32_t time_stamp, int elem_cou
     Recorder->TextFileStatus = 1;
     Recorder->MdfFileStatus = 1;
     Recorder->Mdf4FileStatus = 1;
+    Recorder->ColumnFileStatus = 1;
     Recorder->AllFileStatus = 0;
 
     Recorder->LineNumberCounter = 0;
@@ -810,6 +815,14 @@ int InitFileWriter (RECORDER_STRUCT *Recorder, uint32_t time_stamp, int elem_cou
             return Recorder->Mdf4FileStatus;
         }
     }
+    if ((Recorder->StartMessage.FormatFlags & REC_FORMAT_FLAG_COLUMN) == REC_FORMAT_FLAG_COLUMN) {
+        STRING_COPY_TO_ARRAY (Recorder->StartMessage.Filename, Recorder->ColumnFileName);
+        if ((Recorder->ColumnFileStatus = OpenWriteColumnHead (Recorder->StartMessage, Recorder->Vids, Recorder->PhysicalFlags, &Recorder->ColumnFile)) != 0) {
+            Recorder->AllFileStatus = Recorder->ColumnFileStatus;
+            Recorder->RecorderStatus = HDREC_SLEEP;
+            return Recorder->ColumnFileStatus;
+        }
+    }
     if ((Recorder->StartMessage.FormatFlags & REC_FORMAT_FLAG_TEXT_STIMULI) == REC_FORMAT_FLAG_TEXT_STIMULI) {
         STRING_COPY_TO_ARRAY (Recorder->StartMessage.Filename, Recorder->TextFileName);
         if ((Recorder->TextFileStatus = open_write_stimuli_head (Recorder->StartMessage, Recorder->Vids, &Recorder->StimuliFile)) != 0) {
@@ -876,6 +889,13 @@ int TerminateFileWriter (RECORDER_STRUCT *Recorder)
                         break;   /* for loop */
                     }
                 }
+                if (!Recorder->ColumnFileStatus &&
+                    ((Recorder->StartMessage.FormatFlags & REC_FORMAT_FLAG_COLUMN) == REC_FORMAT_FLAG_COLUMN)) {
+                    if (WriteRingbuffColumn (Recorder->ColumnFile, &Recorder->Stamp, Recorder->RingBufferVariableCount) == EOF) {
+                        Recorder->AllFileStatus = Recorder->ColumnFileStatus = WRITE_FILE_ERROR;
+                        break;   /* for loop */
+                    }
+                }
 
                 if (!Recorder->TextFileStatus &&
                     ((Recorder->StartMessage.FormatFlags & REC_FORMAT_FLAG_TEXT_STIMULI) == REC_FORMAT_FLAG_TEXT_STIMULI)) {
@@ -897,6 +917,11 @@ int TerminateFileWriter (RECORDER_STRUCT *Recorder)
         Recorder->Mdf4FileStatus = 1;
         TailMdf4File (Recorder->Mdf4File, Recorder->LineNumberCounter - 3, Recorder->RecordStartTime);
     }
+    if (!Recorder->ColumnFileStatus &&
+        ((Recorder->StartMessage.FormatFlags & REC_FORMAT_FLAG_COLUMN) == REC_FORMAT_FLAG_COLUMN)) {
+        Recorder->ColumnFileStatus = 1;
+        TailColumnFile (Recorder->ColumnFile, Recorder->LineNumberCounter - 3, Recorder->RecordStartTime);
+    }
     if (!Recorder->TextFileStatus &&
         ((Recorder->StartMessage.FormatFlags & REC_FORMAT_FLAG_TEXT_STIMULI) == REC_FORMAT_FLAG_TEXT_STIMULI)) {
         Recorder->TextFileStatus = 1;
@@ -971,6 +996,14 @@ int WriteWriter (RECORDER_STRUCT *Recorder, uint64_t time_stamp, int elem_count,
                         }
                     }
                 }
+                if (!Recorder->ColumnFileStatus) {
+                    if ((Recorder->StartMessage.FormatFlags & REC_FORMAT_FLAG_COLUMN) == REC_FORMAT_FLAG_COLUMN) {
+                        if (WriteRingbuffColumn (Recorder->ColumnFile, &Recorder->Stamp, Recorder->RingBufferVariableCount) == EOF) {
+                            Recorder->AllFileStatus = Recorder->ColumnFileStatus = WRITE_FILE_ERROR;
+                            break;  /* while loop */
+                        }
+                    }
+                }
 
                 if (!Recorder->TextFileStatus) {
                     if ((Recorder->StartMessage.FormatFlags & REC_FORMAT_FLAG_TEXT_STIMULI) == REC_FORMAT_FLAG_TEXT_STIMULI) {
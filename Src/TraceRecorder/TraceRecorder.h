@@ -42,6 +42,7 @@ typedef struct {           /* Message for starting the recorder */
 #define REC_FORMAT_FLAG_TEXT_STIMULI     0x00000001
 #define REC_FORMAT_FLAG_MDF              0x00000008
 #define REC_FORMAT_FLAG_MDF4             0x00000010
+#define REC_FORMAT_FLAG_COLUMN           0x00000020
     int FormatCounter;
     char Filename[MAX_PATH];   /* File name */
     char Comment[MAX_PATH];    /* Comment */
@@ -79,6 +80,7 @@ typedef struct {
     FILE *StimuliFile;          /* Handle for recorder file */
     FILE *MdfFile;              /* Handle for recorder file */
     FILE *Mdf4File;              /* Handle for recorder file */
+    FILE *ColumnFile;            /* Handle for recorder file */
     struct PIPE_VARI *MessageBuffer;  /* Pointer to the message buffer */
     int MessageBufferSize;              /* Size of the message buffer */
 
@@ -98,6 +100,7 @@ typedef struct {
     int TextFileStatus;       /* Status of the file */
     int MdfFileStatus;           /* Status of the file */
     int Mdf4FileStatus;           /* Status of the file */
+    int ColumnFileStatus;         /* Status of the file */
     int AllFileStatus;
 
     uint32_t LineNumberCounter;
@@ -118,6 +121,7 @@ typedef struct {
     char TextFileName[MAX_PATH];      /* Name of the recording file */
     char MdfFileName[MAX_PATH];       /* Name of the recording file */
     char Mdf4FileName[MAX_PATH];      /* Name of the recording file */
+    char ColumnFileName[MAX_PATH];    /* Name of the recording file */
 
     int ReqFiFo;
     int AckFiFo;
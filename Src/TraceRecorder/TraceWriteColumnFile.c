@@ -0,0 +1,349 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Platform.h"
+#include <stdio.h>
+#include <math.h>
+
+#include "Config.h"
+#include "MyMemory.h"
+#include "MemZeroAndCopy.h"
+#include "Files.h"
+#include "Scheduler.h"
+#include "Blackboard.h"
+#include "BlackboardConvertFromTo.h"
+#include "TraceRecorder.h"
+#include "ThrowError.h"
+#include "ColumnFileStructs.h"
+#include "TraceWriteColumnFile.h"
+
+#define UNUSED(x) (void)(x)
+
+// All chunks of one group together should be around this size
+#define COLUMN_GROUP_BUFFER_SIZE  (32 * 1024 * 1024)
+#define COLUMN_MIN_CHUNK_SAMPLES  256
+#define COLUMN_MAX_CHUNK_SAMPLES  65536
+
+typedef struct {
+    int Entry;          // index inside RING_BUFFER_COLOMN.EntryList
+    int DataType;
+    int ByteSize;
+    unsigned char *Data;  // ChunkSamples * ByteSize
+} COLUMN_WRITE_SIGNAL;
+
+static COLUMN_WRITE_SIGNAL *ColumnSignals;   // the last one is the time
+static int ColumnSignalCount;               // without the time
+static unsigned char *ColumnBuffer;
+static uint32_t ColumnChunkSamples;
+static uint32_t ColumnSamplesInChunk;
+static uint64_t ColumnSampleCount;
+
+static COLUMN_FILE_SIGNAL *ColumnFileSignals;
+
+static COLUMN_FILE_CHUNK *ColumnChunks;
+static uint64_t ColumnChunkCount;
+static uint64_t ColumnChunkListSize;
+
+static char *ColumnStrings;
+static uint32_t ColumnStringsSize;
+static uint32_t ColumnStringsPos;
+
+static uint32_t AddColumnString(const char *par_String)
+{
+    uint32_t Ret = ColumnStringsPos;
+    uint32_t Len = (uint32_t)strlen(par_String) + 1;
+    if ((ColumnStringsPos + Len) > ColumnStringsSize) {
+        ColumnStringsSize += ColumnStringsSize / 4 + Len + 1024;
+        ColumnStrings = (char*)my_realloc(ColumnStrings, ColumnStringsSize);
+        if (ColumnStrings == NULL) {
+            ColumnStringsSize = ColumnStringsPos = 0;
+            ThrowError(1, "out of memory");
+            return 0;
+        }
+    }
+    MEMCPY(ColumnStrings + ColumnStringsPos, par_String, Len);
+    ColumnStringsPos += Len;
+    return Ret;
+}
+
+static void FreeColumnBuffers(void)
+{
+    if (ColumnSignals != NULL) my_free(ColumnSignals);
+    ColumnSignals = NULL;
+    if (ColumnBuffer != NULL) my_free(ColumnBuffer);
+    ColumnBuffer = NULL;
+    if (ColumnFileSignals != NULL) my_free(ColumnFileSignals);
+    ColumnFileSignals = NULL;
+    if (ColumnChunks != NULL) my_free(ColumnChunks);
+    ColumnChunks = NULL;
+    ColumnChunkCount = ColumnChunkListSize = 0;
+    if (ColumnStrings != NULL) my_free(ColumnStrings);
+    ColumnStrings = NULL;
+    ColumnStringsSize = ColumnStringsPos = 0;
+}
+
+static int WriteColumnFiller(FILE *fh)
+{
+    char Filler[8] = {0};
+    int64_t Offset = (8 - (_ftelli64(fh) & 0x7)) & 0x7;  // must be multiple of 8
+    if (Offset > 0) {
+        if (fwrite (Filler, (size_t)Offset, 1, fh) != 1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static double ColumnValueToDouble(int par_DataType, unsigned char *par_Data)
+{
+    double Ret;
+    sc_convert_from_to(par_DataType, (union BB_VARI*)par_Data, BB_DOUBLE, (union BB_VARI*)&Ret);
+    return Ret;
+}
+
+static int WriteOneColumnChunk(FILE *fh, int par_Signal)
+{
+    COLUMN_WRITE_SIGNAL *Signal = &ColumnSignals[par_Signal];
+    COLUMN_FILE_CHUNK *Chunk = &ColumnChunks[ColumnChunkCount];
+    uint64_t *Times = (uint64_t*)ColumnSignals[ColumnSignalCount].Data;
+    double Min = INFINITY, Max = -INFINITY;
+    uint32_t x;
+
+    if (WriteColumnFiller(fh)) return -1;
+    Chunk->FileOffset = (uint64_t)_ftelli64(fh);
+    Chunk->FirstSample = ColumnSampleCount - ColumnSamplesInChunk;
+    Chunk->FirstTime = Times[0];
+    Chunk->LastTime = Times[ColumnSamplesInChunk - 1];
+    Chunk->Signal = (par_Signal == ColumnSignalCount) ? COLUMN_FILE_TIME_SIGNAL : (uint32_t)par_Signal;
+    Chunk->SampleCount = ColumnSamplesInChunk;
+    for (x = 0; x < ColumnSamplesInChunk; x++) {
+        double Value = ColumnValueToDouble(Signal->DataType, Signal->Data + (size_t)x * (size_t)Signal->ByteSize);
+        if (Value < Min) Min = Value;
+        if (Value > Max) Max = Value;
+    }
+    if (Min > Max) Min = Max = NAN;  // only NaN values
+    Chunk->Min = Min;
+    Chunk->Max = Max;
+    if (fwrite (Signal->Data, (size_t)Signal->ByteSize * ColumnSamplesInChunk, 1, fh) != 1) {
+        return -1;
+    }
+    ColumnChunkCount++;
+    return 0;
+}
+
+// Write the chunks of all signals (the time first) and add them to the index
+static int FlushColumnChunks(FILE *fh)
+{
+    int s;
+
+    if (ColumnSamplesInChunk == 0) return 0;
+    if ((ColumnChunkCount + (uint64_t)ColumnSignalCount + 1) > ColumnChunkListSize) {
+        ColumnChunkListSize += ColumnChunkListSize / 4 + (uint64_t)ColumnSignalCount * 16 + 16;
+        ColumnChunks = (COLUMN_FILE_CHUNK*)my_realloc(ColumnChunks, ColumnChunkListSize * sizeof(COLUMN_FILE_CHUNK));
+        if (ColumnChunks == NULL) {
+            ThrowError(1, "out of memory");
+            return -1;
+        }
+    }
+    if (WriteOneColumnChunk(fh, ColumnSignalCount)) return -1;
+    for (s = 0; s < ColumnSignalCount; s++) {
+        if (WriteOneColumnChunk(fh, s)) return -1;
+    }
+    ColumnSamplesInChunk = 0;
+    return 0;
+}
+
+int OpenWriteColumnHead (START_MESSAGE_DATA hdrec_data,
+                         int32_t *vids, char *dec_phys_flags, FILE **pfile)
+{
+    COLUMN_FILE_HEADER Header;
+    char SignalName[512];
+    char Unit[BBVARI_UNIT_SIZE];
+    enum BB_DATA_TYPES DataType;
+    enum BB_CONV_TYPES ConversionType;
+    int Channel, RecordSize;
+    size_t Offset;
+
+    FreeColumnBuffers();
+    for (ColumnSignalCount = 0; vids[ColumnSignalCount] > 0; ColumnSignalCount++);
+
+    ColumnSignals = (COLUMN_WRITE_SIGNAL*)my_calloc((size_t)ColumnSignalCount + 1, sizeof(COLUMN_WRITE_SIGNAL));
+    ColumnFileSignals = (COLUMN_FILE_SIGNAL*)my_calloc((size_t)ColumnSignalCount + 1, sizeof(COLUMN_FILE_SIGNAL));
+    if ((ColumnSignals == NULL) || (ColumnFileSignals == NULL)) {
+        ThrowError(1, "out of memory");
+        goto __ERROUT;
+    }
+    RecordSize = 8;  // time
+    for (Channel = 0; Channel < ColumnSignalCount; Channel++) {
+        GetBlackboardVariableNameAndTypes(vids[Channel], SignalName, sizeof(SignalName), &DataType, &ConversionType);
+        if ((dec_phys_flags != NULL) && dec_phys_flags[Channel]) {
+            DataType = BB_DOUBLE;
+        }
+        if (size_of_bbvari(DataType) <= 0) {
+            ThrowError(1, "cannot record variable \"%s\" with unknown data type", SignalName);
+            goto __ERROUT;
+        }
+        ColumnSignals[Channel].Entry = Channel + 2;  // first is the counter second is the timestamp
+        ColumnSignals[Channel].DataType = DataType;
+        ColumnSignals[Channel].ByteSize = size_of_bbvari(DataType);
+        RecordSize += ColumnSignals[Channel].ByteSize;
+
+        if (get_bbvari_unit(vids[Channel], Unit, sizeof(Unit)) < 0) Unit[0] = 0;
+        ColumnFileSignals[Channel].NameOffset = AddColumnString(SignalName);
+        ColumnFileSignals[Channel].UnitOffset = AddColumnString(Unit);
+        ColumnFileSignals[Channel].DataType = DataType;
+        ColumnFileSignals[Channel].ByteSize = (uint32_t)ColumnSignals[Channel].ByteSize;
+        if (ColumnStrings == NULL) goto __ERROUT;
+    }
+    // the time column is the last one
+    ColumnSignals[ColumnSignalCount].Entry = 1;
+    ColumnSignals[ColumnSignalCount].DataType = BB_UQWORD;
+    ColumnSignals[ColumnSignalCount].ByteSize = 8;
+
+    ColumnChunkSamples = (uint32_t)(COLUMN_GROUP_BUFFER_SIZE / RecordSize);
+    if (ColumnChunkSamples < COLUMN_MIN_CHUNK_SAMPLES) ColumnChunkSamples = COLUMN_MIN_CHUNK_SAMPLES;
+    if (ColumnChunkSamples > COLUMN_MAX_CHUNK_SAMPLES) ColumnChunkSamples = COLUMN_MAX_CHUNK_SAMPLES;
+    ColumnBuffer = (unsigned char*)my_malloc((size_t)ColumnChunkSamples * (size_t)RecordSize);
+    if (ColumnBuffer == NULL) {
+        ThrowError(1, "out of memory");
+        goto __ERROUT;
+    }
+    Offset = 0;
+    for (Channel = 0; Channel <= ColumnSignalCount; Channel++) {
+        ColumnSignals[Channel].Data = ColumnBuffer + Offset;
+        Offset += (size_t)ColumnChunkSamples * (size_t)ColumnSignals[Channel].ByteSize;
+    }
+    ColumnSamplesInChunk = 0;
+    ColumnSampleCount = 0;
+
+    if ((*pfile = OpenFile4WriteWithPrefix (hdrec_data.Filename, "wb")) == NULL) {
+        ThrowError (1, "cannot open \"%s\"", hdrec_data.Filename);
+        FreeColumnBuffers();
+        return CANNOT_OPEN_RECFILE;
+    }
+    MEMSET(&Header, 0, sizeof(Header));
+    MEMCPY(Header.FileIdentifier, COLUMN_FILE_IDENTIFIER, sizeof(Header.FileIdentifier));
+    Header.Version = COLUMN_FILE_VERSION;
+    Header.HeaderSize = sizeof(Header);
+    Header.StartTime = GetSimulatedStartTimeInNanoSecond() + GetSimulatedTimeInNanoSecond();
+    Header.ChunkSamples = ColumnChunkSamples;
+    if (fwrite (&Header, sizeof (Header), 1, *pfile) != 1) {
+        close_file (*pfile);
+        FreeColumnBuffers();
+        return -1;
+    }
+    return 0;
+__ERROUT:
+    FreeColumnBuffers();
+    return -1;
+}
+
+int WriteRingbuffColumn (FILE *file, RING_BUFFER_COLOMN *stamp, int rpvari_count)
+{
+    int s;
+    uint32_t Pos = ColumnSamplesInChunk;
+
+    if (rpvari_count < 2) return 0;  // first is the counter second is the timestamp
+    for (s = 0; s < ColumnSignalCount; s++) {
+        COLUMN_WRITE_SIGNAL *Signal = &ColumnSignals[s];
+        // a variable which has not received a value till now has a 0 inside the stamp
+        switch (Signal->ByteSize) {
+        case 1:
+            Signal->Data[Pos] = stamp->EntryList[Signal->Entry].value.ub;
+            break;
+        case 2:
+            ((uint16_t*)Signal->Data)[Pos] = stamp->EntryList[Signal->Entry].value.uw;
+            break;
+        case 4:
+            ((uint32_t*)Signal->Data)[Pos] = stamp->EntryList[Signal->Entry].value.udw;
+            break;
+        default:
+            ((uint64_t*)Signal->Data)[Pos] = stamp->EntryList[Signal->Entry].value.uqw;
+            break;
+        }
+    }
+    ((uint64_t*)ColumnSignals[ColumnSignalCount].Data)[Pos] = (uint64_t)(stamp->EntryList[1].value.d * TIMERCLKFRQ + 0.5);
+    ColumnSamplesInChunk++;
+    ColumnSampleCount++;
+    if (ColumnSamplesInChunk >= ColumnChunkSamples) {
+        if (FlushColumnChunks(file)) {
+            return EOF;
+        }
+    }
+    return 0;
+}
+
+int TailColumnFile (FILE *fh, uint32_t Samples, uint64_t RecorderStartTime)
+{
+    COLUMN_FILE_TRAILER Trailer;
+    int Ret = 0;
+    UNUSED(Samples);
+    UNUSED(RecorderStartTime);
+
+    MEMSET(&Trailer, 0, sizeof(Trailer));
+    if (FlushColumnChunks(fh)) {
+        Ret = -1;
+        goto __ERROUT;
+    }
+    if (WriteColumnFiller(fh)) {
+        Ret = -1;
+        goto __ERROUT;
+    }
+    Trailer.StringTableOffset = (uint64_t)_ftelli64(fh);
+    Trailer.StringTableSize = ColumnStringsPos;
+    if ((ColumnStringsPos > 0) && (fwrite (ColumnStrings, ColumnStringsPos, 1, fh) != 1)) {
+        Ret = -1;
+        goto __ERROUT;
+    }
+    if (WriteColumnFiller(fh)) {
+        Ret = -1;
+        goto __ERROUT;
+    }
+    Trailer.SignalTableOffset = (uint64_t)_ftelli64(fh);
+    Trailer.SignalCount = (uint32_t)ColumnSignalCount;
+    if ((ColumnSignalCount > 0) && (fwrite (ColumnFileSignals, sizeof(COLUMN_FILE_SIGNAL), (size_t)ColumnSignalCount, fh) != (size_t)ColumnSignalCount)) {
+        Ret = -1;
+        goto __ERROUT;
+    }
+    Trailer.ChunkIndexOffset = (uint64_t)_ftelli64(fh);
+    Trailer.ChunkCount = ColumnChunkCount;
+    // The chunks are stored group by group inside ColumnChunks, the index will be sorted by the signal (time first)
+    if (ColumnChunkCount > 0) {
+        uint64_t ChunksPerGroup = (uint64_t)ColumnSignalCount + 1;
+        uint64_t Group, Groups = ColumnChunkCount / ChunksPerGroup;
+        uint64_t Pos;
+        for (Pos = 0; Pos < ChunksPerGroup; Pos++) {
+            for (Group = 0; Group < Groups; Group++) {
+                if (fwrite (&ColumnChunks[Group * ChunksPerGroup + Pos], sizeof(COLUMN_FILE_CHUNK), 1, fh) != 1) {
+                    Ret = -1;
+                    goto __ERROUT;
+                }
+            }
+        }
+    }
+    Trailer.SampleCount = ColumnSampleCount;
+    MEMCPY(Trailer.TrailerIdentifier, COLUMN_FILE_TRAILER_IDENTIFIER, sizeof(Trailer.TrailerIdentifier));
+    if (fwrite (&Trailer, sizeof(Trailer), 1, fh) != 1) {
+        Ret = -1;
+    }
+__ERROUT:
+    if (Ret) {
+        ThrowError(1, "cannot write the index of the column file");
+    }
+    close_file (fh);
+    FreeColumnBuffers();
+    return Ret;
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __TRACEWRITECOLUMNFILE_H
+#define __TRACEWRITECOLUMNFILE_H
+
+#include "TraceWriteFile.h"
+
+// Column oriented recording (*.xcol), see ColumnFileStructs.h
+int OpenWriteColumnHead (START_MESSAGE_DATA hdrec_data,
+                         int32_t *vids, char *dec_phys_flags, FILE **pfile);
+
+int WriteRingbuffColumn (FILE *file, RING_BUFFER_COLOMN *stamp, int rpvari_count);
+
+int TailColumnFile (FILE *fh, uint32_t Samples, uint64_t RecorderStartTime);
+
+#endif
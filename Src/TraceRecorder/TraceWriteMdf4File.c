@@ -412,6 +412,60 @@ __ERROUT:
     return Ret;
 }
 
+static int GetMdf4ChannelDataType(enum BB_DATA_TYPES par_DataType, int par_RawPhysFlag, uint32_t *ret_BitCount, uint8_t *ret_DataType)
+{
+    if (par_RawPhysFlag) {
+        *ret_BitCount = 64;
+        *ret_DataType = 4;  // IEEE 754 floating-point format DOUBLE
+    } else {
+        switch (par_DataType) {
+        case BB_BYTE:
+            *ret_BitCount = 8;
+            *ret_DataType = 2; // signed integer
+            break;
+        case BB_UBYTE:
+            *ret_BitCount = 8;
+            *ret_DataType = 0; // unsigned integer
+            break;
+        case BB_WORD:
+            *ret_BitCount = 16;
+            *ret_DataType = 2; // signed integer
+            break;
+        case BB_UWORD:
+            *ret_BitCount = 16;
+            *ret_DataType = 0;  // unsigned integer
+            break;
+        case BB_DWORD:
+            *ret_BitCount = 32;
+            *ret_DataType = 2; // signed integer
+            break;
+        case BB_UDWORD:
+            *ret_BitCount = 32;
+            *ret_DataType = 0; // unsigned integer
+            break;
+        case BB_QWORD:
+            *ret_BitCount = 64;
+            *ret_DataType = 2; // signed integer
+            break;
+        case BB_UQWORD:
+            *ret_BitCount = 64;
+            *ret_DataType = 0; // unsigned integer
+            break;
+        case BB_FLOAT:
+            *ret_BitCount = 32;
+            *ret_DataType = 4;  // IEEE 754 floating-point format FLOAT (4 bytes)
+            break;
+        case BB_DOUBLE:
+            *ret_BitCount = 64;
+            *ret_DataType = 4;  // IEEE 754 floating-point format DOUBLE (8 / 10 bytes)
+            break;
+        default:
+            return -1;
+        }
+    }
+    return 0;
+}
+
 uint64_t WriteOneChannel(FILE *fh, int par_SignalType, int par_Vid, int par_RawPhysFlag, char *ConversionBuffer,
                          uint64_t par_PosNextChannel, int *RecordSize)
 {
@@ -447,55 +501,9 @@ uint64_t WriteOneChannel(FILE *fh, int par_SignalType, int par_Vid, int par_RawP
     MdfCnBlock.Flags = 0;
     Ret = GetFilePosMultipleOf8(fh);  // file position where to write the link to the next channel
 
-    if (par_RawPhysFlag) {
-        MdfCnBlock.BitCount = 64;
-        MdfCnBlock.DataType = 4;  // IEEE 754 floating-point format DOUBLE
-    } else {
-        switch (DataType) {
-        case BB_BYTE:
-            MdfCnBlock.BitCount = 8;
-            MdfCnBlock.DataType = 2; // signed integer
-            break;
-        case BB_UBYTE:
-            MdfCnBlock.BitCount = 8;
-            MdfCnBlock.DataType = 0; // unsigned integer
-            break;
-        case BB_WORD:
-            MdfCnBlock.BitCount = 16;
-            MdfCnBlock.DataType = 2; // signed integer
-            break;
-        case BB_UWORD:
-            MdfCnBlock.BitCount = 16;
-            MdfCnBlock.DataType = 0;  // unsigned integer
-            break;
-        case BB_DWORD:
-            MdfCnBlock.BitCount = 32;
-            MdfCnBlock.DataType = 2; // signed integer
-            break;
-        case BB_UDWORD:
-            MdfCnBlock.BitCount = 32;
-            MdfCnBlock.DataType = 0; // unsigned integer
-            break;
-        case BB_QWORD:
-            MdfCnBlock.BitCount = 64;
-            MdfCnBlock.DataType = 2; // signed integer
-            break;
-        case BB_UQWORD:
-            MdfCnBlock.BitCount = 64;
-            MdfCnBlock.DataType = 0; // unsigned integer
-            break;
-        case BB_FLOAT:
-            MdfCnBlock.BitCount = 32;
-            MdfCnBlock.DataType = 4;  // IEEE 754 floating-point format FLOAT (4 bytes)
-            break;
-        case BB_DOUBLE:
-            MdfCnBlock.BitCount = 64;
-            MdfCnBlock.DataType = 4;  // IEEE 754 floating-point format DOUBLE (8 / 10 bytes)
-            break;
-        default:
-            Ret = 0;
-            goto __ERROUT;
-        }
+    if (GetMdf4ChannelDataType (DataType, par_RawPhysFlag, &MdfCnBlock.BitCount, &MdfCnBlock.DataType)) {
+        Ret = 0;
+        goto __ERROUT;
     }
 
     MdfCnBlock.ByteOffset = *RecordSize;
@@ -536,6 +544,101 @@ static uint64_t *DataBufferLinkList;
 static int DataBufferLinkListSize;
 static int DataBufferLinkListPos;
 
+// Packing plan of one record, build at recording start. The channels are grouped by their size
+// (first all 8 byte channels and the time, than 4, 2 and 1 byte channels), so a record is packed
+// with 4 loops without any switch on the data type.
+static int *PackEntries;      // index inside RING_BUFFER_COLOMN.EntryList in the order of the record
+static int *PackByteOffsets;  // byte offset of each recorded variable inside the record (only during the header is written)
+static int PackCount[4];      // number of 8, 4, 2 and 1 byte entries
+static int PackTimeByteOffset;
+
+static void FreePackingPlan(void)
+{
+    if (PackEntries != NULL) my_free(PackEntries);
+    PackEntries = NULL;
+    if (PackByteOffsets != NULL) my_free(PackByteOffsets);
+    PackByteOffsets = NULL;
+}
+
+// Returns the record size or -1
+static int BuildPackingPlan(int32_t *vids, char *dec_phys_flags, int par_ChannelCount)
+{
+    static const int Sizes[4] = {8, 4, 2, 1};
+    int *ChannelSizes;
+    int Channel, Group, Pos, Offset;
+    char SignalName[512];
+    enum BB_DATA_TYPES DataType;
+    enum BB_CONV_TYPES ConversionType;
+    uint32_t BitCount;
+    uint8_t Mdf4DataType;
+
+    FreePackingPlan();
+    PackEntries = (int*)my_malloc((par_ChannelCount + 1) * sizeof(int));
+    PackByteOffsets = (int*)my_malloc((par_ChannelCount + 1) * sizeof(int));
+    ChannelSizes = (int*)my_malloc((par_ChannelCount + 1) * sizeof(int));
+    if ((PackEntries == NULL) || (PackByteOffsets == NULL) || (ChannelSizes == NULL)) {
+        ThrowError(1, "out of memory");
+        if (ChannelSizes != NULL) my_free(ChannelSizes);
+        FreePackingPlan();
+        return -1;
+    }
+    for (Channel = 0; Channel < par_ChannelCount; Channel++) {
+        GetBlackboardVariableNameAndTypes(vids[Channel], SignalName, sizeof(SignalName), &DataType, &ConversionType);
+        if (GetMdf4ChannelDataType(DataType, (dec_phys_flags != NULL) && dec_phys_flags[Channel], &BitCount, &Mdf4DataType)) {
+            ChannelSizes[Channel] = 0;  // WriteOneChannel() will fail
+        } else {
+            ChannelSizes[Channel] = (int)(BitCount / 8);
+        }
+    }
+    Pos = 0;
+    Offset = 0;
+    for (Group = 0; Group < 4; Group++) {
+        PackCount[Group] = 0;
+        for (Channel = 0; Channel < par_ChannelCount; Channel++) {
+            if (ChannelSizes[Channel] == Sizes[Group]) {
+                PackEntries[Pos++] = Channel + 2;  // first is the counter second is the timestamp
+                PackByteOffsets[Channel] = Offset;
+                Offset += Sizes[Group];
+                PackCount[Group]++;
+            }
+        }
+        if (Group == 0) {
+            // the time stamp is the last 8 byte entry
+            PackEntries[Pos++] = 1;
+            PackTimeByteOffset = Offset;
+            Offset += 8;
+            PackCount[Group]++;
+        }
+    }
+    my_free(ChannelSizes);
+    return Offset;
+}
+
+static void PackRecord(char *ret_Record, VARI_IN_PIPE *par_EntryList)
+{
+    const int *Entries = PackEntries;
+    int x;
+
+    for (x = 0; x < PackCount[0]; x++) {
+        ((uint64_t*)ret_Record)[x] = par_EntryList[Entries[x]].value.uqw;
+    }
+    ret_Record += PackCount[0] * 8;
+    Entries += PackCount[0];
+    for (x = 0; x < PackCount[1]; x++) {
+        ((uint32_t*)ret_Record)[x] = par_EntryList[Entries[x]].value.udw;
+    }
+    ret_Record += PackCount[1] * 4;
+    Entries += PackCount[1];
+    for (x = 0; x < PackCount[2]; x++) {
+        ((uint16_t*)ret_Record)[x] = par_EntryList[Entries[x]].value.uw;
+    }
+    ret_Record += PackCount[2] * 2;
+    Entries += PackCount[2];
+    for (x = 0; x < PackCount[3]; x++) {
+        ret_Record[x] = par_EntryList[Entries[x]].value.ub;
+    }
+}
+
 static int AllocDataBuffer(void)
 {
     int Modulo;
@@ -629,6 +732,7 @@ static void FreeDataBuffer(void)
     DataBufferLinkListPos = 0;
     my_free(DataBufferLinkList);
     DataBuffer = NULL;
+    FreePackingPlan();
 }
 
 #define CLOSE_FILE_FREE_BUFFERS  \
@@ -681,7 +785,7 @@ __ERROUT:
 int OpenWriteMdf4Head (START_MESSAGE_DATA hdrec_data,
                        int32_t *vids, char *dec_phys_flags, FILE **pfile)
 {
-    int Channel, x;
+    int Channel, ChannelCount, ByteOffset, x;
     MDF4_IDBLOCK MdfIdBlock;
     MDF4_HDBLOCK MdfHdBlock;
     MDF4_DGBLOCK MdfDgBlock;
@@ -773,25 +877,35 @@ int OpenWriteMdf4Head (START_MESSAGE_DATA hdrec_data,
         goto __ERROUT;
     }
 
+    for (ChannelCount = 0; vids[ChannelCount] > 0; ChannelCount++);
+    RecordSize = BuildPackingPlan(vids, dec_phys_flags, ChannelCount);
+    if (RecordSize < 0) {
+        Ret = -1;
+        goto __ERROUT;
+    }
+
     PosNextChannel = 0;
-    RecordSize = 0;
     // now the measurement channels
-    for (Channel = 0; Channel < vids[Channel] > 0; Channel++) {
+    for (Channel = 0; Channel < ChannelCount; Channel++) {
+        ByteOffset = PackByteOffsets[Channel];
         PosNextChannel = WriteOneChannel(*pfile, 0, vids[Channel],
                                          (dec_phys_flags != NULL) && dec_phys_flags[Channel],
                                          ConversionBuffer,
                                          PosNextChannel,
-                                         &RecordSize);
+                                         &ByteOffset);
         if (PosNextChannel == 0) {
             goto __ERROUT;
         }
     }
 
     // now write the time channel
-    PosNextChannel = WriteOneChannel(*pfile, 1, -1, 0, ConversionBuffer, PosNextChannel, &RecordSize);
+    ByteOffset = PackTimeByteOffset;
+    PosNextChannel = WriteOneChannel(*pfile, 1, -1, 0, ConversionBuffer, PosNextChannel, &ByteOffset);
     if (PosNextChannel == 0) {
         goto __ERROUT;
     }
+    my_free(PackByteOffsets);
+    PackByteOffsets = NULL;
 
     // we use only one channel group block
     MdfCgBlock.Reserved = 0;
@@ -831,41 +945,13 @@ __ERROUT:
 
 int WriteRingbuffMdf4 (FILE *file, RING_BUFFER_COLOMN *stamp, int rpvari_count)
 {
-    int i;
-
     if (CheckFitIntoBuffer(file)) {
         return EOF;
     }
     if (rpvari_count >= 2) {  // first is the counter second is the timestamp
-        for (i = 2; (i < rpvari_count); i++) {
-            switch (stamp->EntryList[i].type) {
-            case BB_BYTE:
-            case BB_UBYTE:
-                DataBuffer[DataBufferPos] = stamp->EntryList[i].value.ub;
-                DataBufferPos++;
-                break;
-            case BB_WORD:
-            case BB_UWORD:
-                *(uint16_t*)(DataBuffer + DataBufferPos) = stamp->EntryList[i].value.uw;
-                DataBufferPos += 2;
-                break;
-            case BB_DWORD:
-            case BB_UDWORD:
-            case BB_FLOAT:
-                *(uint32_t*)(DataBuffer + DataBufferPos) = stamp->EntryList[i].value.udw;
-                DataBufferPos += 4;
-                break;
-            case BB_QWORD:
-            case BB_UQWORD:
-            case BB_DOUBLE:
-                *(uint64_t*)(DataBuffer + DataBufferPos) = stamp->EntryList[i].value.uqw;
-                DataBufferPos += 8;
-                break;
-            }
-        }
-        // the time stamp is the last entry inside the record
-        *(uint64_t*)(DataBuffer + DataBufferPos) = stamp->EntryList[1].value.uqw;
-        DataBufferPos += 8;
+        // The record has always the size of the channel layout, also if a variable has not received a value till now
+        PackRecord(DataBuffer + DataBufferPos, stamp->EntryList);
+        DataBufferPos += RecordSize;
     }
     return 0;
 }
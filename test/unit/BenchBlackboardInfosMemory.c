@@ -0,0 +1,185 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <malloc.h>
+
+#include "MyMemory.h"
+#include "Blackboard.h"
+#include "BlackboardStringPool.h"
+#include "BlackboardAttachCounts.h"
+
+// Benchmark of the heap memory used by the additional infos of many blackboard variables:
+// shared units and conversions, names inside the name arena and sparse attach counters
+// (BlackboardStringPool.c, BlackboardAttachCounts.c) against the former layout with an own
+// allocation for each string and two arrays with 64 attach counters inside the structure.
+// The heap is measured with mallinfo2(), so this is only available with glibc. The my_malloc
+// block header of the product is not included (the unit tests use plain malloc).
+// Usage: BenchBlackboardInfosMemory [<variables>]
+
+static const char *Units[] = { "", "V", "A", "rpm", "Nm", "degC", "km/h", "bar", "%", "s", "ms", "m/s^2" };
+
+// The former layout: the attach counters were 2 x 64 x 16 bit instead of 2 x BB_ATTACH_COUNTS
+typedef struct {
+    char Infos[sizeof (BB_VARIABLE_ADDITIONAL_INFOS) - 2 * sizeof (BB_ATTACH_COUNTS) + 2 * 64 * sizeof (uint16_t)];
+} OLD_ADDITIONAL_INFOS;
+
+typedef struct {
+    void *Infos;
+    char *Name;
+    char *Unit;
+    char *Conversion;
+} OLD_VARIABLE;
+
+static uint32_t RandomState;
+
+static uint32_t Random (void)
+{
+    RandomState = RandomState * 1103515245U + 12345U;
+    return RandomState >> 8;
+}
+
+static size_t HeapInUse (void)
+{
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+    struct mallinfo2 Info = mallinfo2 ();
+    return Info.uordblks + Info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+static char *Duplicate (const char *par_String)
+{
+    size_t Len = strlen (par_String) + 1;
+    char *Ret = (char*)my_malloc (Len);
+    if (Ret != NULL) memcpy (Ret, par_String, Len);
+    return Ret;
+}
+
+// Synthetic variables: names with about 45 characters, 12 different units, 20% formulas,
+// 5% enums and 1...3 attached processes
+static int BuildVariable (int par_Index, char *ret_Name, const char **ret_Unit, char *ret_Conversion)
+{
+    int Kind;
+    sprintf (ret_Name, "Model.Subsystem%03i.Component%02i.Signal_%06i", par_Index % 400, par_Index % 37, par_Index);
+    *ret_Unit = Units[Random () % 12];
+    Kind = (int)(Random () % 100);
+    ret_Conversion[0] = 0;
+    if (Kind < 20) sprintf (ret_Conversion, "#*%g+%i", 0.1 * (1 + Random () % 10), (int)(Random () % 5));
+    else if (Kind < 25) sprintf (ret_Conversion, "0 0 \"Off\"; 1 1 \"On\"; 2 2 \"Error%i\";", (int)(Random () % 20));
+    return 1 + (int)(Random () % 3);
+}
+
+static size_t OldLayout (int par_Variables)
+{
+    OLD_VARIABLE *Variables = (OLD_VARIABLE*)calloc ((size_t)par_Variables, sizeof (OLD_VARIABLE));
+    char Name[128], Conversion[128];
+    const char *Unit;
+    size_t Before, Used;
+    int x;
+
+    RandomState = 1;
+    Before = HeapInUse ();
+    for (x = 0; x < par_Variables; x++) {
+        BuildVariable (x, Name, &Unit, Conversion);
+        Variables[x].Infos = my_calloc (1, sizeof (OLD_ADDITIONAL_INFOS));
+        Variables[x].Name = Duplicate (Name);
+        Variables[x].Unit = Duplicate (Unit);
+        if (Conversion[0]) Variables[x].Conversion = Duplicate (Conversion);
+    }
+    Used = HeapInUse () - Before;
+    for (x = 0; x < par_Variables; x++) {
+        my_free (Variables[x].Infos);
+        my_free (Variables[x].Name);
+        my_free (Variables[x].Unit);
+        if (Variables[x].Conversion != NULL) my_free (Variables[x].Conversion);
+    }
+    free (Variables);
+    return Used;
+}
+
+static size_t NewLayout (int par_Variables, int *ret_Errors)
+{
+    BB_VARIABLE_ADDITIONAL_INFOS **Infos = (BB_VARIABLE_ADDITIONAL_INFOS**)calloc ((size_t)par_Variables, sizeof (void*));
+    char Name[128], Conversion[128];
+    const char *Unit;
+    size_t Before, Used;
+    int x, p;
+
+    RandomState = 1;
+    Before = HeapInUse ();
+    for (x = 0; x < par_Variables; x++) {
+        int Processes = BuildVariable (x, Name, &Unit, Conversion);
+        BB_VARIABLE_ADDITIONAL_INFOS *Info = (BB_VARIABLE_ADDITIONAL_INFOS*)my_calloc (1, sizeof (BB_VARIABLE_ADDITIONAL_INFOS));
+        Info->Name = AllocNameString (Name);
+        Info->Unit = AddSharedString (Unit);
+        if (Conversion[0]) Info->Conversion.Conv.Formula.FormulaString = AddSharedString (Conversion);
+        for (p = 0; p < Processes; p++) {
+            SetAttachCount (&Info->ProcessAttachCounts, (x + p * 7) % 64, 1);
+        }
+        Infos[x] = Info;
+    }
+    Used = HeapInUse () - Before;
+    // the pool must give back the same strings
+    RandomState = 1;
+    for (x = 0; x < par_Variables; x++) {
+        int Processes = BuildVariable (x, Name, &Unit, Conversion);
+        BB_VARIABLE_ADDITIONAL_INFOS *Info = Infos[x];
+        if (strcmp (Info->Name, Name) || strcmp (Info->Unit, Unit) ||
+            (Conversion[0] && strcmp (Info->Conversion.Conv.Formula.FormulaString, Conversion))) {
+            (*ret_Errors)++;
+        }
+        for (p = 0; p < Processes; p++) {
+            if (GetAttachCount (&Info->ProcessAttachCounts, (x + p * 7) % 64) != 1) (*ret_Errors)++;
+        }
+        FreeNameString (Info->Name);
+        ReleaseSharedString (Info->Unit);
+        if (Conversion[0]) ReleaseSharedString (Info->Conversion.Conv.Formula.FormulaString);
+        FreeAttachCounts (&Info->ProcessAttachCounts);
+        my_free (Info);
+    }
+    free (Infos);
+    return Used;
+}
+
+int main (int argc, char *argv[])
+{
+    int Variables = 200000;
+    size_t Old, New;
+    int Errors = 0;
+
+    if (argc >= 2) Variables = atoi (argv[1]);
+    if (Variables < 1) Variables = 1;
+
+    InitBlackboardStringPool ();
+    Old = OldLayout (Variables);
+    New = NewLayout (Variables, &Errors);
+    printf ("%i variables, sizeof (BB_VARIABLE_ADDITIONAL_INFOS) %i (before %i)\n", Variables,
+            (int)sizeof (BB_VARIABLE_ADDITIONAL_INFOS), (int)sizeof (OLD_ADDITIONAL_INFOS));
+    if (HeapInUse () == 0) {
+        printf ("heap usage not available (needs mallinfo2())\n");
+    } else {
+        printf ("heap before: %8.0f kB (%.0f bytes/variable)\n", Old / 1024.0, (double)Old / Variables);
+        printf ("heap now:    %8.0f kB (%.0f bytes/variable)\n", New / 1024.0, (double)New / Variables);
+    }
+    if (Errors) printf ("%i errors\n", Errors);
+    return (Errors > 0) ? 1 : 0;
+}
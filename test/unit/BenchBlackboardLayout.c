@@ -0,0 +1,227 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "Blackboard.h"
+
+// Benchmark of the blackboard layout: values and data types inside the parallel arrays
+// blackboard_values[] and blackboard_types[] (BB_VALUE(), BB_TYPE()) against the former 64 byte
+// BB_VARIABLE with the value and all flags inside the structure. Each read fetches the data type
+// and the value and converts it to double (as a copy list or the recorder does). "cold" means that
+// 64 MByte of other data are touched before each cycle.
+// Usage: BenchBlackboardLayout [<variables> [<cycles> [<reads per cycle>]]]
+
+// The former layout
+typedef struct {
+    int32_t Vid;
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+    BB_VARIABLE_ADDITIONAL_INFOS *pAdditionalInfos;
+    volatile uint64_t WrFlags;
+    uint64_t AccessFlags;
+    uint64_t WrEnableFlags;
+    uint64_t RangeControlFlag;
+    uint32_t ObservationFlags;
+    uint32_t Fill;
+} OLD_BB_VARIABLE;  // 64 bytes
+
+union BB_VARI *blackboard_values;
+int8_t *blackboard_types;
+
+static OLD_BB_VARIABLE *OldBlackboard;
+static BB_VARIABLE *NewBlackboard;
+
+#define COLD_SIZE  (64 * 1024 * 1024)
+static uint8_t *ColdData;
+
+static double GetTime (void)
+{
+    struct timespec Time;
+    clock_gettime (CLOCK_MONOTONIC, &Time);
+    return (double)Time.tv_sec + (double)Time.tv_nsec * 1e-9;
+}
+
+static double ToDouble (enum BB_DATA_TYPES par_Type, union BB_VARI par_Value)
+{
+    switch (par_Type) {
+    case BB_BYTE: return par_Value.b;
+    case BB_UBYTE: return par_Value.ub;
+    case BB_WORD: return par_Value.w;
+    case BB_UWORD: return par_Value.uw;
+    case BB_DWORD: return par_Value.dw;
+    case BB_UDWORD: return par_Value.udw;
+    case BB_QWORD: return (double)par_Value.qw;
+    case BB_UQWORD: return (double)par_Value.uqw;
+    case BB_FLOAT: return par_Value.f;
+    default: return par_Value.d;
+    }
+}
+
+static void TouchColdData (void)
+{
+    static uint8_t Counter;
+    int x;
+    Counter++;
+    for (x = 0; x < COLD_SIZE; x += 64) {
+        ColdData[x] += Counter;
+    }
+}
+
+// Touched cache lines of one cycle (a line is counted again if it was not touched by the read before)
+static long CacheLines (const int *par_Indexes, int par_Count, int par_ElementSize, int par_ElementSize2)
+{
+    long Lines = 0;
+    long Last = -1, Last2 = -1;
+    int x;
+
+    for (x = 0; x < par_Count; x++) {
+        long Line = (long)par_Indexes[x] * par_ElementSize / 64;
+        if (Line != Last) Lines++;
+        Last = Line;
+        if (par_ElementSize2 > 0) {
+            Line = (long)par_Indexes[x] * par_ElementSize2 / 64;
+            if (Line != Last2) Lines++;
+            Last2 = Line;
+        }
+    }
+    return Lines;
+}
+
+static double RunOld (const int *par_Indexes, int par_Reads, int par_Cycles, int par_Cold, double *ret_Sum)
+{
+    double Time = 0.0, Sum = 0.0;
+    int c, x;
+
+    for (c = 0; c < par_Cycles; c++) {
+        double t;
+        if (par_Cold) TouchColdData ();
+        t = GetTime ();
+        for (x = 0; x < par_Reads; x++) {
+            OLD_BB_VARIABLE *Variable = &OldBlackboard[par_Indexes[x]];
+            Sum += ToDouble (Variable->Type, Variable->Value);
+        }
+        Time += GetTime () - t;
+    }
+    *ret_Sum = Sum;
+    return Time / par_Cycles;
+}
+
+static double RunNew (const int *par_Indexes, int par_Reads, int par_Cycles, int par_Cold, double *ret_Sum)
+{
+    double Time = 0.0, Sum = 0.0;
+    int c, x;
+
+    for (c = 0; c < par_Cycles; c++) {
+        double t;
+        if (par_Cold) TouchColdData ();
+        t = GetTime ();
+        for (x = 0; x < par_Reads; x++) {
+            int Index = par_Indexes[x];
+            Sum += ToDouble (BB_TYPE(Index), BB_VALUE(Index));
+        }
+        Time += GetTime () - t;
+    }
+    *ret_Sum = Sum;
+    return Time / par_Cycles;
+}
+
+int main (int argc, char *argv[])
+{
+    static const enum BB_DATA_TYPES Types[] = { BB_BYTE, BB_UBYTE, BB_WORD, BB_UWORD, BB_DWORD, BB_UDWORD,
+                                                BB_FLOAT, BB_DOUBLE };
+    int Variables = 131072;
+    int Cycles = 2000;
+    int Reads = 10000;
+    int *Sequential, *Random;
+    uint32_t RandomState = 4711;
+    int Cold, x, Errors = 0;
+
+    if (argc >= 2) Variables = atoi (argv[1]);
+    if (argc >= 3) Cycles = atoi (argv[2]);
+    if (argc >= 4) Reads = atoi (argv[3]);
+    if (Variables < 1) Variables = 1;
+    if (Cycles < 1) Cycles = 1;
+    if (Reads < 1) Reads = 1;
+
+    OldBlackboard = (OLD_BB_VARIABLE*)calloc ((size_t)Variables, sizeof (OLD_BB_VARIABLE));
+    NewBlackboard = (BB_VARIABLE*)calloc ((size_t)Variables, sizeof (BB_VARIABLE));
+    blackboard_values = (union BB_VARI*)calloc ((size_t)Variables, sizeof (union BB_VARI));
+    blackboard_types = (int8_t*)calloc ((size_t)Variables, sizeof (int8_t));
+    ColdData = (uint8_t*)calloc (COLD_SIZE, 1);
+    Sequential = (int*)malloc ((size_t)Reads * sizeof (int));
+    Random = (int*)malloc ((size_t)Reads * sizeof (int));
+    for (x = 0; x < Variables; x++) {
+        enum BB_DATA_TYPES Type = Types[x % (int)(sizeof (Types) / sizeof (Types[0]))];
+        union BB_VARI Value;
+        Value.uqw = 0;
+        switch (Type) {
+        case BB_FLOAT:
+            Value.f = (float)(x % 1000);
+            break;
+        case BB_DOUBLE:
+            Value.d = x % 1000;
+            break;
+        default:
+            Value.ub = (uint8_t)(x % 100);
+            break;
+        }
+        OldBlackboard[x].Vid = NewBlackboard[x].Vid = x + 1;
+        OldBlackboard[x].Type = NewBlackboard[x].Type = Type;
+        OldBlackboard[x].Value = Value;
+        blackboard_types[x] = (int8_t)Type;
+        blackboard_values[x] = Value;
+    }
+    for (x = 0; x < Reads; x++) {
+        RandomState = RandomState * 1103515245U + 12345U;
+        Sequential[x] = x % Variables;
+        Random[x] = (int)((RandomState >> 8) % (uint32_t)Variables);
+    }
+
+    printf ("%i variables, %i cycles, %i reads per cycle, sizeof (BB_VARIABLE) %i (before %i)\n",
+            Variables, Cycles, Reads, (int)sizeof (BB_VARIABLE), (int)sizeof (OLD_BB_VARIABLE));
+    printf ("touched cache lines per cycle: sequential %li before, %li now; random %li before, %li now\n",
+            CacheLines (Sequential, Reads, (int)sizeof (OLD_BB_VARIABLE), 0),
+            CacheLines (Sequential, Reads, (int)sizeof (union BB_VARI), (int)sizeof (int8_t)),
+            CacheLines (Random, Reads, (int)sizeof (OLD_BB_VARIABLE), 0),
+            CacheLines (Random, Reads, (int)sizeof (union BB_VARI), (int)sizeof (int8_t)));
+    for (Cold = 0; Cold < 2; Cold++) {
+        double OldSum, NewSum, OldTime, NewTime;
+        OldTime = RunOld (Sequential, Reads, Cycles, Cold, &OldSum);
+        NewTime = RunNew (Sequential, Reads, Cycles, Cold, &NewSum);
+        if (OldSum != NewSum) Errors++;
+        printf ("sequential %-4s: before %8.2f us, now %8.2f us per cycle\n", Cold ? "cold" : "warm", OldTime * 1e6, NewTime * 1e6);
+        OldTime = RunOld (Random, Reads, Cycles, Cold, &OldSum);
+        NewTime = RunNew (Random, Reads, Cycles, Cold, &NewSum);
+        if (OldSum != NewSum) Errors++;
+        printf ("random     %-4s: before %8.2f us, now %8.2f us per cycle\n", Cold ? "cold" : "warm", OldTime * 1e6, NewTime * 1e6);
+    }
+    if (Errors) printf ("the sums of the old and the new layout are different\n");
+
+    free (OldBlackboard);
+    free (NewBlackboard);
+    free (blackboard_values);
+    free (blackboard_types);
+    free (ColdData);
+    free (Sequential);
+    free (Random);
+    return (Errors > 0) ? 1 : 0;
+}
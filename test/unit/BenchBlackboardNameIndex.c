@@ -0,0 +1,175 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "MyMemory.h"
+#include "MainValues.h"
+#include "IniDataBase.h"
+#include "StringMaxChar.h"
+#include "Wildcards.h"
+#include "BlackboardNameIndex.h"
+
+// Benchmark of the sorted blackboard name index (BlackboardNameIndex.c) against a linear
+// Compare2StringsWithWildcards scan over all names, as the variable selection lists did before.
+// Both must return the same variables.
+// Usage: BenchBlackboardNameIndex [<names>] [<repeats>]
+
+// The include/exclude filters inside Wildcards.c reference the INI database, they are not used here
+
+MAIN_INI_VAL s_main_ini_val;
+
+int IniFileDataBaseReadString (const char* section, const char* par_Entry, const char* deftxt,
+                               char* txt, int nsize, int par_FileDescriptor)
+{
+    (void)section; (void)par_Entry; (void)par_FileDescriptor;
+    StringCopyMaxCharTruncate (txt, deftxt, nsize);
+    return (int)strlen (txt);
+}
+
+int IniFileDataBaseWriteString (const char* section, const char* par_Entry, const char* txt, int par_FileDescriptor)
+{
+    (void)section; (void)par_Entry; (void)txt; (void)par_FileDescriptor;
+    return 0;
+}
+
+static double GetTime (void)
+{
+    struct timespec Time;
+    clock_gettime (CLOCK_MONOTONIC, &Time);
+    return (double)Time.tv_sec + (double)Time.tv_nsec * 1.0e-9;
+}
+
+static const char *Signals[] = { "Speed", "Torque", "Current", "Voltage", "Temperature", "Pressure", "State", "Counter" };
+
+static char **Names;
+static int NameCount;
+
+static int CompareInt (const void *par_A, const void *par_B)
+{
+    return *(const int32_t*)par_A - *(const int32_t*)par_B;
+}
+
+static int LinearScan (const char *par_Filter, int par_CaseSensitive, int32_t *ret_Indexes)
+{
+    int x, Count = 0;
+    for (x = 0; x < NameCount; x++) {
+        if (Names[x] == NULL) continue;
+        if (!Compare2StringsWithWildcardsCaseSensitive (Names[x], par_Filter, par_CaseSensitive)) {
+            ret_Indexes[Count++] = x;
+        }
+    }
+    return Count;
+}
+
+// Returns the number of differences between both results (the index result is sorted by name)
+static int CompareResults (int32_t *par_Index, int par_IndexCount, int32_t *par_Linear, int par_LinearCount)
+{
+    int x, Errors = 0;
+    if (par_IndexCount != par_LinearCount) return 1 + abs (par_IndexCount - par_LinearCount);
+    if (par_IndexCount > 0) qsort (par_Index, (size_t)par_IndexCount, sizeof (int32_t), CompareInt);
+    for (x = 0; x < par_IndexCount; x++) {
+        if (par_Index[x] != par_Linear[x]) Errors++;
+    }
+    return Errors;
+}
+
+static int RunQuery (const char *par_Filter, int par_CaseSensitive, int par_Repeats, int32_t *par_Linear)
+{
+    double Start, LinearTime, IndexTime;
+    int32_t *Indexes = NULL;
+    int LinearCount = 0, IndexCount = 0, r, Errors;
+
+    Start = GetTime ();
+    for (r = 0; r < par_Repeats; r++) {
+        LinearCount = LinearScan (par_Filter, par_CaseSensitive, par_Linear);
+    }
+    LinearTime = (GetTime () - Start) / par_Repeats;
+    Start = GetTime ();
+    for (r = 0; r < par_Repeats; r++) {
+        if (Indexes != NULL) my_free (Indexes);
+        IndexCount = SearchNameIndex (par_Filter, par_CaseSensitive, &Indexes);
+    }
+    IndexTime = (GetTime () - Start) / par_Repeats;
+    Errors = CompareResults (Indexes, IndexCount, par_Linear, LinearCount);
+    if (Indexes != NULL) my_free (Indexes);
+    printf ("  %-32s %-6s %7i hits  %8.3f -> %8.3f ms%s\n", par_Filter, par_CaseSensitive ? "case" : "nocase",
+            LinearCount, LinearTime * 1000.0, IndexTime * 1000.0, Errors ? "  MISMATCH" : "");
+    return Errors;
+}
+
+int main (int argc, char *argv[])
+{
+    int Repeats = 5;
+    int32_t *Linear;
+    char Name[128], Filter[128];
+    double Start;
+    int x, Errors = 0;
+    int32_t *Indexes;
+
+    NameCount = 200000;
+    if (argc >= 2) NameCount = atoi (argv[1]);
+    if (argc >= 3) Repeats = atoi (argv[2]);
+    if (NameCount < 1000) NameCount = 1000;
+    if (Repeats < 1) Repeats = 1;
+
+    Names = (char**)calloc ((size_t)NameCount, sizeof (char*));
+    Linear = (int32_t*)malloc ((size_t)NameCount * sizeof (int32_t));
+    if ((Names == NULL) || (Linear == NULL) || InitBlackboardNameIndex (NameCount)) {
+        printf ("out of memory\n");
+        return 1;
+    }
+    Start = GetTime ();
+    for (x = 0; x < NameCount; x++) {
+        sprintf (Name, "%s.Sub%03i.%s_%i", (x & 1) ? "Plant" : "Model", (x >> 1) % 200, Signals[(x >> 3) % 8], x);
+        Names[x] = strdup (Name);
+        AddNameIndex (Names[x], x);
+    }
+    // 10% of the names are replaced, so the first search must drop stale entries and merge the new ones
+    for (x = 0; x < NameCount; x += 10) {
+        RemoveNameIndex (x);
+        free (Names[x]);
+        sprintf (Name, "%s.Sub%03i.%s_%i_New", (x & 1) ? "Plant" : "Model", (x >> 1) % 200, Signals[(x >> 3) % 8], x);
+        Names[x] = strdup (Name);
+        AddNameIndex (Names[x], x);
+    }
+    x = SearchNameIndex ("Model.Sub000.Speed_0", 1, &Indexes);
+    if (x > 0) my_free (Indexes);
+    printf ("%i names, adding and first search (with merge) %.1f ms\n", NameCount, (GetTime () - Start) * 1000.0);
+
+    printf ("linear scan -> name index, ms per query:\n");
+    Errors += RunQuery ("Model.*.Speed*", 1, Repeats, Linear);
+    Errors += RunQuery ("model.*.speed*", 0, Repeats, Linear);
+    Errors += RunQuery ("Model.Sub042.*", 1, Repeats, Linear);
+    Errors += RunQuery ("MODEL.SUB042.*", 0, Repeats, Linear);
+    Errors += RunQuery ("Plant.Sub1??.Torque_*", 1, Repeats, Linear);
+    Errors += RunQuery ("plant.sub1??.torque_*", 0, Repeats, Linear);
+    sprintf (Filter, "%s", Names[NameCount / 2 + 1]);
+    Errors += RunQuery (Filter, 1, Repeats, Linear);
+    Errors += RunQuery ("*Speed*", 1, Repeats, Linear);
+
+    for (x = 0; x < NameCount; x++) free (Names[x]);
+    free (Names);
+    free (Linear);
+    CloseBlackboardNameIndex ();
+    if (Errors) printf ("%i errors\n", Errors);
+    return (Errors > 0) ? 1 : 0;
+}
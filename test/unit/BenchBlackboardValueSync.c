@@ -0,0 +1,227 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "Blackboard.h"
+#include "StructsRM_Blackboard.h"
+#include "RemoteMasterLock.h"
+#include "RemoteMasterNet.h"
+#include "RemoteMasterBlackboardSync.h"
+#include "RemoteMasterBlackboardMirror.h"
+
+// Benchmark of the cycle aligned blackboard value sync between the mirror of the client and the
+// remote master (connected through a loopback TransactRemoteMaster()). Each cycle the client reads
+// the watched variables and writes some of them, the remote master changes about 5% of all variables.
+// The bytes per cycle will be compared with one read or write request per variable access.
+// Usage: BenchBlackboardValueSync [<variables> [<watched variables> [<writes per cycle> [<cycles>]]]]
+
+#define WRITE_PID  5
+
+static uint32_t RandomState = 4711;
+
+static uint32_t Random (void)
+{
+    RandomState = RandomState * 1103515245U + 12345U;
+    return RandomState >> 8;
+}
+
+static double GetTime (void)
+{
+    struct timespec Time;
+    clock_gettime (CLOCK_MONOTONIC, &Time);
+    return (double)Time.tv_sec + (double)Time.tv_nsec * 1e-9;
+}
+
+// Blackboard of the remote master
+
+BB_VARIABLE *blackboard;
+union BB_VARI *blackboard_values;
+int8_t *blackboard_types;
+GLOBAL_BBINFOS blackboard_infos;
+
+int GetDataTypeByteSize (int par_DataType)
+{
+    switch (par_DataType) {
+    case BB_BYTE:
+    case BB_UBYTE:
+        return 1;
+    case BB_WORD:
+    case BB_UWORD:
+        return 2;
+    case BB_DWORD:
+    case BB_UDWORD:
+    case BB_FLOAT:
+        return 4;
+    case BB_QWORD:
+    case BB_UQWORD:
+    case BB_DOUBLE:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+void write_bbvari_union_pid (int Pid, VID vid, int DataType, union BB_VARI v)
+{
+    int Index = (int)(vid >> 8);
+    (void)Pid;
+    if ((blackboard[Index].Vid == vid) && (DataType == BB_TYPE(Index))) {
+        BB_VALUE(Index) = v;
+    }
+}
+
+void RemoteMasterLock (REMOTE_MASTER_LOCK *Lock, int LineNr, const char *File)
+{
+    (void)Lock; (void)LineNr; (void)File;
+}
+
+void RemoteMasterUnlock (REMOTE_MASTER_LOCK *Lock)
+{
+    (void)Lock;
+}
+
+void RemoteMasterInitLock (REMOTE_MASTER_LOCK *Lock)
+{
+    (void)Lock;
+}
+
+// Loopback to the remote master (same as Func_SyncBlackboardValues())
+static uint64_t Transactions;
+static uint64_t BytesToRM;
+static uint64_t BytesFromRM;
+
+int TransactRemoteMaster (int par_Command, void *par_DataToRM, int par_LenDataToRM, void *ret_DataFromRM, int par_LenDataFromRM)
+{
+    RM_BLACKBOARD_SYNC_VALUES_REQ *Req = (RM_BLACKBOARD_SYNC_VALUES_REQ*)par_DataToRM;
+    RM_BLACKBOARD_SYNC_VALUES_ACK *Ack = (RM_BLACKBOARD_SYNC_VALUES_ACK*)ret_DataFromRM;
+    int MaxLenValues = par_LenDataFromRM - (int)sizeof (RM_BLACKBOARD_SYNC_VALUES_ACK);
+    int LenValues;
+
+    if (par_Command != RM_BLACKBOARD_SYNC_VALUES_CMD) return -1;
+    if ((int)Req->MaxLenValues < MaxLenValues) MaxLenValues = (int)Req->MaxLenValues;
+    Ack->OffsetValues = sizeof (RM_BLACKBOARD_SYNC_VALUES_ACK);
+    Ack->Ret = SyncBlackboardValues (Req->WritePid, Req->Flags,
+                                     (VID*)((char*)Req + Req->OffsetSubscribeVids), Req->SubscribeCount,
+                                     (char*)Req + Req->OffsetWrites, (int)Req->LenWrites,
+                                     (char*)Ack + Ack->OffsetValues, MaxLenValues, &LenValues);
+    Ack->LenValues = (uint32_t)LenValues;
+    Transactions++;
+    BytesToRM += (uint64_t)par_LenDataToRM;
+    BytesFromRM += sizeof (RM_BLACKBOARD_SYNC_VALUES_ACK) + (uint64_t)LenValues;
+    return (int)sizeof (RM_BLACKBOARD_SYNC_VALUES_ACK) + LenValues;
+}
+
+static union BB_VARI RandomValue (void)
+{
+    union BB_VARI Value;
+    Value.uqw = ((uint64_t)Random () << 40) ^ ((uint64_t)Random () << 20) ^ Random ();
+    return Value;
+}
+
+int main (int argc, char *argv[])
+{
+    static const int Types[] = { BB_BYTE, BB_UBYTE, BB_WORD, BB_UWORD, BB_DWORD, BB_UDWORD,
+                                 BB_FLOAT, BB_DOUBLE, BB_QWORD, BB_UQWORD };
+    int Variables = 20000;
+    int Watched = 2000;
+    int WritesPerCycle = 20;
+    int Cycles = 1000;
+    int *WatchedIndexes;
+    uint64_t OldBytesToRM, OldBytesFromRM;
+    int Index, Cycle, x, Errors = 0;
+    double t;
+
+    if (argc >= 2) Variables = atoi (argv[1]);
+    if (argc >= 3) Watched = atoi (argv[2]);
+    if (argc >= 4) WritesPerCycle = atoi (argv[3]);
+    if (argc >= 5) Cycles = atoi (argv[4]);
+    if (Variables < 1) Variables = 1;
+    if ((Watched < 1) || (Watched > Variables)) Watched = Variables;
+    if (WritesPerCycle > Watched) WritesPerCycle = Watched;
+
+    blackboard = (BB_VARIABLE*)calloc ((size_t)Variables, sizeof (BB_VARIABLE));
+    blackboard_values = (union BB_VARI*)calloc ((size_t)Variables, sizeof (union BB_VARI));
+    blackboard_types = (int8_t*)calloc ((size_t)Variables, sizeof (int8_t));
+    WatchedIndexes = (int*)malloc ((size_t)Watched * sizeof (int));
+    blackboard_infos.Size = Variables;
+    for (Index = 0; Index < Variables; Index++) {
+        blackboard[Index].Vid = (Index << 8) | 1;
+        blackboard[Index].Type = Types[Index % (int)(sizeof (Types) / sizeof (Types[0]))];
+        blackboard_types[Index] = (int8_t)blackboard[Index].Type;
+        BB_VALUE(Index) = RandomValue ();
+    }
+    // watched variables are spread over the whole blackboard
+    for (x = 0; x < Watched; x++) {
+        WatchedIndexes[x] = (int)((int64_t)x * Variables / Watched);
+    }
+    InitBlackboardValueSync ();
+    rm_InitBlackboardSync (Variables);
+
+    t = GetTime ();
+    for (Cycle = 0; Cycle < Cycles; Cycle++) {
+        // remote master: about 5% of all variables are changing each cycle
+        for (x = 0; x < Variables / 20; x++) {
+            BB_VALUE(Random () % (uint32_t)Variables) = RandomValue ();
+        }
+        // client: read all watched variables (the first read subscribes them) and write some of them
+        for (x = 0; x < Watched; x++) {
+            enum BB_DATA_TYPES Type;
+            union BB_VARI Value;
+            rm_ReadBbvariFromMirror (blackboard[WatchedIndexes[x]].Vid, &Type, &Value);
+        }
+        for (x = 0; x < WritesPerCycle; x++) {
+            rm_WriteBbvariToMirror (WRITE_PID, blackboard[WatchedIndexes[Random () % (uint32_t)Watched]].Vid,
+                                    BB_UNION, RandomValue ());
+        }
+        if (rm_SyncBlackboardValues () < 0) Errors++;
+    }
+    t = GetTime () - t;
+
+    // now the mirror must have the same values as the remote master
+    for (x = 0; x < Watched; x++) {
+        enum BB_DATA_TYPES Type;
+        union BB_VARI Value;
+        Index = WatchedIndexes[x];
+        if (!rm_ReadBbvariFromMirror (blackboard[Index].Vid, &Type, &Value) || (Type != BB_TYPE(Index)) ||
+            memcmp (&Value, &BB_VALUE(Index), (size_t)GetDataTypeByteSize (Type))) {
+            Errors++;
+        }
+    }
+
+    OldBytesToRM = (uint64_t)Watched * sizeof (RM_BLACKBOARD_READ_BBVARI_UNION_TYPE_REQ) +
+                   (uint64_t)WritesPerCycle * sizeof (RM_BLACKBOARD_WRITE_BBVARI_UNION_PID_REQ);
+    OldBytesFromRM = (uint64_t)Watched * sizeof (RM_BLACKBOARD_READ_BBVARI_UNION_TYPE_ACK) +
+                     (uint64_t)WritesPerCycle * sizeof (RM_BLACKBOARD_WRITE_BBVARI_UNION_PID_ACK);
+    printf ("%i variables, %i watched, %i writes per cycle, %i cycles\n", Variables, Watched, WritesPerCycle, Cycles);
+    printf ("one request per access: %i round trips, %.0f bytes to and %.0f bytes from the remote master per cycle\n",
+            Watched + WritesPerCycle, (double)OldBytesToRM, (double)OldBytesFromRM);
+    printf ("value sync: %.2f round trips, %.0f bytes to and %.0f bytes from the remote master per cycle\n",
+            (double)Transactions / Cycles, (double)BytesToRM / Cycles, (double)BytesFromRM / Cycles);
+    printf ("client + server: %.2f us per cycle, %i mismatches\n", t / Cycles * 1e6, Errors);
+
+    rm_TerminateBlackboardSync ();
+    free (WatchedIndexes);
+    free (blackboard);
+    free (blackboard_values);
+    free (blackboard_types);
+    return (Errors > 0) ? 1 : 0;
+}
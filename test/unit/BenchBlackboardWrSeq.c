@@ -0,0 +1,216 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "AtomicAccess.h"
+#include "Blackboard.h"
+
+// Benchmark of the per variable write sequence numbers against the former 64 bit write flag
+// mask (one bit for each process, set by the writer, tested and reset by the reader).
+// Usage: BenchBlackboardWrSeq [<operations> [<poll time in ms>]]
+
+#define VARIABLES   4096
+#define MAX_READERS 32
+
+volatile uint32_t *blackboard_wr_seqs;
+uint32_t *blackboard_observation_flags;
+
+static volatile uint64_t WrFlags[VARIABLES];
+static volatile int StopThreads;
+static int UseWrSeqs;
+
+typedef struct {
+    uint64_t Polls;
+    uint64_t Detected;
+    int Id;
+    char Fill[64];
+} BENCH_READER;
+
+static BENCH_READER Readers[MAX_READERS];
+static uint64_t WriteCounter;
+
+void PushValueChangedObservation (int par_VidIndex)
+{
+    (void)par_VidIndex;
+}
+
+static double GetTime (void)
+{
+    struct timespec Time;
+    clock_gettime (CLOCK_MONOTONIC, &Time);
+    return (double)Time.tv_sec + (double)Time.tv_nsec * 1e-9;
+}
+
+static void SingleThread (int par_Operations)
+{
+    uint32_t *LastWrSeqs = (uint32_t*)calloc (VARIABLES, sizeof (uint32_t));
+    uint64_t Mask = 1ULL << 5;
+    volatile uint64_t Sink = 0;
+    double t, WriterMask, WriterWrSeq, ReaderMask, ReaderWrSeq;
+    int x;
+
+    t = GetTime ();
+    for (x = 0; x < par_Operations; x++) {
+        WrFlags[x & (VARIABLES - 1)] = 0xFFFFFFFFFFFFFFFFULL;
+    }
+    WriterMask = (GetTime () - t) / par_Operations * 1e9;
+
+    t = GetTime ();
+    for (x = 0; x < par_Operations; x++) {
+        SET_BB_WRITTEN (x & (VARIABLES - 1));
+    }
+    WriterWrSeq = (GetTime () - t) / par_Operations * 1e9;
+
+    // Old reader: test and reset the own bit (read modify write on the shared cache line)
+    t = GetTime ();
+    for (x = 0; x < par_Operations; x++) {
+        int Index = x & (VARIABLES - 1);
+        if (WrFlags[Index] & Mask) {
+            WrFlags[Index] &= ~Mask;
+            Sink++;
+        }
+        WrFlags[Index] |= Mask;
+    }
+    ReaderMask = (GetTime () - t) / par_Operations * 1e9;
+
+    // New reader: load and compare with the own last seen array
+    t = GetTime ();
+    for (x = 0; x < par_Operations; x++) {
+        int Index = x & (VARIABLES - 1);
+        uint32_t WrSeq = ATOMIC_LOAD_ACQUIRE_U32(&BB_WR_SEQ(Index));
+        if (WrSeq != LastWrSeqs[Index]) {
+            LastWrSeqs[Index] = WrSeq;
+            Sink++;
+        }
+        BB_WR_SEQ(Index)++;
+    }
+    ReaderWrSeq = (GetTime () - t) / par_Operations * 1e9;
+
+    printf ("single thread ns/operation: writer mask %.2f, writer sequence number %.2f\n", WriterMask, WriterWrSeq);
+    printf ("single thread ns/operation: reader test + reset mask %.2f, reader sequence number compare %.2f\n", ReaderMask, ReaderWrSeq);
+    free (LastWrSeqs);
+}
+
+static void *ReaderThread (void *par_Arg)
+{
+    BENCH_READER *Reader = (BENCH_READER*)par_Arg;
+    uint32_t *LastWrSeqs = (uint32_t*)calloc (VARIABLES, sizeof (uint32_t));
+    uint64_t Bit = 1ULL << Reader->Id;
+    int Index;
+
+    while (!StopThreads) {
+        for (Index = 0; Index < VARIABLES; Index++) {
+            if (UseWrSeqs) {
+                uint32_t WrSeq = ATOMIC_LOAD_ACQUIRE_U32(&BB_WR_SEQ(Index));
+                if (WrSeq != LastWrSeqs[Index]) {
+                    LastWrSeqs[Index] = WrSeq;
+                    Reader->Detected++;
+                }
+            } else {
+                if (WrFlags[Index] & Bit) {
+                    __atomic_fetch_and (&WrFlags[Index], ~Bit, __ATOMIC_RELAXED);
+                    Reader->Detected++;
+                }
+            }
+        }
+        Reader->Polls += VARIABLES;
+    }
+    free (LastWrSeqs);
+    return NULL;
+}
+
+static void *WriterThread (void *par_Arg)
+{
+    uint32_t Random = 1;
+    (void)par_Arg;
+    while (!StopThreads) {
+        volatile int Delay;
+        int Index;
+        Random = Random * 1103515245u + 12345u;
+        Index = (int)((Random >> 8) % VARIABLES);
+        if (UseWrSeqs) {
+            SET_BB_WRITTEN (Index);
+        } else {
+            WrFlags[Index] = 0xFFFFFFFFFFFFFFFFULL;
+        }
+        WriteCounter++;
+        for (Delay = 0; Delay < 50; Delay++);   // moderate write rate
+    }
+    return NULL;
+}
+
+static void MultipleReaders (int par_PollTimeMs)
+{
+    int ReaderCount;
+
+    for (ReaderCount = 1; ReaderCount <= MAX_READERS; ReaderCount *= 2) {
+        for (UseWrSeqs = 0; UseWrSeqs < 2; UseWrSeqs++) {
+            pthread_t Threads[MAX_READERS], Writer;
+            struct timespec Sleep;
+            uint64_t Polls = 0;
+            double t, Duration;
+            int x;
+
+            StopThreads = 0;
+            WriteCounter = 0;
+            for (x = 0; x < ReaderCount; x++) {
+                Readers[x].Polls = Readers[x].Detected = 0;
+                Readers[x].Id = x;
+                pthread_create (&Threads[x], NULL, ReaderThread, &Readers[x]);
+            }
+            pthread_create (&Writer, NULL, WriterThread, NULL);
+            t = GetTime ();
+            Sleep.tv_sec = par_PollTimeMs / 1000;
+            Sleep.tv_nsec = (par_PollTimeMs % 1000) * 1000000L;
+            nanosleep (&Sleep, NULL);
+            StopThreads = 1;
+            Duration = GetTime () - t;
+            pthread_join (Writer, NULL);
+            for (x = 0; x < ReaderCount; x++) {
+                pthread_join (Threads[x], NULL);
+                Polls += Readers[x].Polls;
+            }
+            printf ("%-15s readers=%2d: %.2f ns per variable check per reader, writer %.1f Mwrites/s\n",
+                    UseWrSeqs ? "sequence number" : "mask", ReaderCount,
+                    (Polls > 0) ? Duration * 1e9 * ReaderCount / (double)Polls : 0.0,
+                    (double)WriteCounter / Duration / 1e6);
+        }
+    }
+}
+
+int main (int argc, char *argv[])
+{
+    int Operations = 200000000;
+    int PollTimeMs = 500;
+
+    if (argc >= 2) Operations = atoi (argv[1]);
+    if (argc >= 3) PollTimeMs = atoi (argv[2]);
+
+    blackboard_wr_seqs = (volatile uint32_t*)calloc (VARIABLES, sizeof (uint32_t));
+    blackboard_observation_flags = (uint32_t*)calloc (VARIABLES, sizeof (uint32_t));
+
+    SingleThread (Operations);
+    MultipleReaders (PollTimeMs);
+
+    free ((void*)blackboard_wr_seqs);
+    free (blackboard_observation_flags);
+    return 0;
+}
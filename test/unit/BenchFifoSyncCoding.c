@@ -0,0 +1,223 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "Fifos.h"
+#include "CanFifo.h"
+#include "FifoSyncCoding.h"
+
+// Benchmark of the fifo sync block coding (EncodeFiFoSyncBlock() and DecodeFiFoSyncBlock()):
+// bytes on wire and speed of each coding for typical fifo 0 traffic and for random data.
+// Usage: BenchFifoSyncCoding [<block size in KByte> [<repeats>]]
+
+static uint32_t RandomState = 4711;
+
+static uint32_t Random (void)
+{
+    RandomState = RandomState * 1103515245U + 12345U;
+    return RandomState >> 8;
+}
+
+static double GetTime (void)
+{
+    struct timespec Time;
+    clock_gettime (CLOCK_MONOTONIC, &Time);
+    return (double)Time.tv_sec + (double)Time.tv_nsec * 1e-9;
+}
+
+static uint8_t *AddHeader (uint8_t *Raw, int *Pos, int32_t FiFoId, int32_t Pid, uint32_t MessageId,
+                           uint64_t Timestamp, int Size)
+{
+    FIFO_ENTRY_HEADER Header;
+
+    memset (&Header, 0, sizeof (Header));
+    Header.FiFoId = FiFoId;
+    Header.TramsmiterPid = Pid;
+    Header.MessageId = MessageId;
+    Header.Timestamp = Timestamp;
+    Header.Size = Size;
+    memcpy (Raw + *Pos, &Header, sizeof (Header));
+    *Pos += (int)sizeof (Header) + Size;
+    return Raw + *Pos - Size;
+}
+
+// Stimulus frames: 50 variables per frame (vid + double value), slowly changing values
+static int AddStimulusFrame (uint8_t *Raw, int Pos, uint64_t Timestamp, int Cycle)
+{
+    uint8_t *Data = AddHeader (Raw, &Pos, 3, 12, 0x200, Timestamp, 50 * (int)(sizeof (int32_t) + sizeof (double)));
+    int x;
+
+    for (x = 0; x < 50; x++) {
+        int32_t Vid = 1000 + x;
+        double Value = (double)((Cycle + x) % 100) * 0.5;
+        memcpy (Data, &Vid, sizeof (Vid));
+        memcpy (Data + sizeof (Vid), &Value, sizeof (Value));
+        Data += sizeof (Vid) + sizeof (Value);
+    }
+    return Pos;
+}
+
+// CAN stream: 1...4 CAN objects per message, some ids with counters and changing signals
+static int AddCanMessage (uint8_t *Raw, int Pos, uint64_t Timestamp, int Cycle)
+{
+    int Count = 1 + (int)(Random () % 4);
+    CAN_FIFO_ELEM *Elems = (CAN_FIFO_ELEM*)AddHeader (Raw, &Pos, 5, 14, 0x301, Timestamp, Count * (int)sizeof (CAN_FIFO_ELEM));
+    int x;
+
+    for (x = 0; x < Count; x++) {
+        CAN_FIFO_ELEM Elem;
+        memset (&Elem, 0, sizeof (Elem));
+        Elem.id = 0x100 + (uint32_t)((Cycle + x) % 24);
+        Elem.size = 8;
+        Elem.channel = (uint8_t)(Elem.id & 1);
+        Elem.timestamp = Timestamp + (uint64_t)x * 120;
+        Elem.data[0] = (uint8_t)Cycle;
+        Elem.data[1] = (uint8_t)(Elem.id >> 2);
+        Elem.data[2] = (uint8_t)(Random () & 0x3);
+        Elem.data[7] = (uint8_t)(Elem.data[0] ^ Elem.data[1] ^ Elem.data[2]);
+        memcpy (&Elems[x], &Elem, sizeof (Elem));
+    }
+    return Pos;
+}
+
+// Text messages (for example error messages or script output)
+static int AddText (uint8_t *Raw, int Pos, uint64_t Timestamp, int Cycle)
+{
+    char Text[128];
+    int Len = sprintf (Text, "process \"Model%i\" cycle %i: variable \"Signal_%i\" out of range", Cycle % 4,
+                       Cycle, Cycle % 50) + 1;
+    memcpy (AddHeader (Raw, &Pos, 1, 2 + Cycle % 4, 0x10, Timestamp, Len), Text, (size_t)Len);
+    return Pos;
+}
+
+#define TRAFFIC_STIMULUS  0
+#define TRAFFIC_CAN       1
+#define TRAFFIC_MIXED     2
+#define TRAFFIC_RANDOM    3
+
+static int BuildBlock (uint8_t *Raw, int MaxLen, int Traffic)
+{
+    uint64_t Timestamp = 1000000000ULL;
+    int Pos = 0;
+    int Cycle;
+
+    // the largest record is a stimulus frame (32 bytes header + 600 bytes)
+    for (Cycle = 0; Pos + 1024 < MaxLen; Cycle++) {
+        Timestamp += 1000000 + (Random () % 5);
+        switch (Traffic) {
+        case TRAFFIC_STIMULUS:
+            Pos = AddStimulusFrame (Raw, Pos, Timestamp, Cycle);
+            break;
+        case TRAFFIC_CAN:
+            Pos = AddCanMessage (Raw, Pos, Timestamp, Cycle);
+            break;
+        case TRAFFIC_MIXED:
+            switch (Random () % 3) {
+            case 0:
+                Pos = AddStimulusFrame (Raw, Pos, Timestamp, Cycle);
+                break;
+            case 1:
+                Pos = AddCanMessage (Raw, Pos, Timestamp, Cycle);
+                break;
+            default:
+                Pos = AddText (Raw, Pos, Timestamp, Cycle);
+                break;
+            }
+            break;
+        default:
+        {
+            int Size = (int)(Random () % 200);
+            uint8_t *Data = AddHeader (Raw, &Pos, (int32_t)Random (), (int32_t)Random (), Random (),
+                                       (uint64_t)Random () << 32, Size);
+            int x;
+            for (x = 0; x < Size; x++) {
+                Data[x] = (uint8_t)Random ();
+            }
+            break;
+        }
+        }
+    }
+    return Pos;
+}
+
+static int Measure (const char *Name, const uint8_t *Raw, int RawLen, uint8_t *Coded, int Repeats)
+{
+    static const uint32_t Codings[3] = { FIFO_SYNC_COMPACT_HEADERS, FIFO_SYNC_LZ_COMPRESSION,
+                                         FIFO_SYNC_COMPACT_HEADERS | FIFO_SYNC_LZ_COMPRESSION };
+    static const char *CodingNames[3] = { "compact", "LZ", "compact+LZ" };
+    FIFO_SYNC_CODER Encoder, Decoder;
+    int Errors = 0;
+    int c, r;
+
+    memset (&Encoder, 0, sizeof (Encoder));
+    memset (&Decoder, 0, sizeof (Decoder));
+    for (c = 0; c < 3; c++) {
+        double t, EncodeTime, DecodeTime;
+        uint32_t Coding = 0;
+        int CodedLen = 0;
+        int Ok = 1;
+
+        t = GetTime ();
+        for (r = 0; r < Repeats; r++) {
+            CodedLen = EncodeFiFoSyncBlock (&Encoder, Raw, RawLen, Codings[c], Coded, &Coding);
+        }
+        EncodeTime = (GetTime () - t) / Repeats;
+        t = GetTime ();
+        for (r = 0; r < Repeats; r++) {
+            uint8_t *Decoded = (uint8_t*)DecodeFiFoSyncBlock (&Decoder, Coded, CodedLen, Coding, RawLen);
+            if ((Decoded == NULL) || memcmp (Decoded, Raw, (size_t)RawLen)) Ok = 0;
+        }
+        DecodeTime = (GetTime () - t) / Repeats;
+        printf ("%-9s %-10s: %6.1f%% of raw (used coding %u), encode %8.1f MB/s, decode %8.1f MB/s%s\n",
+                Name, CodingNames[c], 100.0 * CodedLen / RawLen, Coding,
+                RawLen / EncodeTime / 1e6, RawLen / DecodeTime / 1e6, Ok ? "" : "  DECODE ERROR");
+        if (!Ok) Errors++;
+    }
+    FreeFiFoSyncCoder (&Encoder);
+    FreeFiFoSyncCoder (&Decoder);
+    return Errors;
+}
+
+int main (int argc, char *argv[])
+{
+    static const char *TrafficNames[4] = { "stimulus", "CAN", "mixed", "random" };
+    int BlockSize = 1024 * 1024;
+    int Repeats = 20;
+    uint8_t *Raw, *Coded;
+    int Errors = 0;
+    int Traffic;
+
+    if (argc >= 2) BlockSize = atoi (argv[1]) * 1024;
+    if (argc >= 3) Repeats = atoi (argv[2]);
+    if (BlockSize < 2048) BlockSize = 2048;
+    if (Repeats < 1) Repeats = 1;
+
+    Raw = (uint8_t*)malloc ((size_t)BlockSize);
+    Coded = (uint8_t*)malloc ((size_t)BlockSize);
+    for (Traffic = 0; Traffic < 4; Traffic++) {
+        int RawLen = BuildBlock (Raw, BlockSize, Traffic);
+        Errors += Measure (TrafficNames[Traffic], Raw, RawLen, Coded, Repeats);
+    }
+    free (Raw);
+    free (Coded);
+    return (Errors > 0) ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "IniDataBase.h"
+
+// Benchmark of reading and writing the INI infos of many blackboard variables (section [Variables])
+// with one call for each variable against IniFileDataBaseReadStringBuffers() and
+// IniFileDataBaseWriteStrings() (one pass through the section). Every second variable has an entry.
+// Usage: BenchIniDataBaseVariables [<variables>]
+
+#define INI_FILE_NAME  "bench_variables.ini"
+#define VARIABLE_INFO  "9,V,0,1,10,3,0,1.0,0,"
+
+static double GetTime (void)
+{
+    struct timespec Time;
+    clock_gettime (CLOCK_MONOTONIC, &Time);
+    return (double)Time.tv_sec + (double)Time.tv_nsec * 1e-9;
+}
+
+int main (int argc, char *argv[])
+{
+    int Variables = 50000;
+    char **Names;
+    const char **Entrys, **Texts;
+    char **SingleResults, **BatchResults;
+    int Fd, Found, x, Errors = 0;
+    FILE *fh;
+    double t;
+
+    if (argc >= 2) Variables = atoi (argv[1]);
+    if (Variables < 1) Variables = 1;
+
+    Names = (char**)malloc (sizeof (char*) * (size_t)Variables);
+    Entrys = (const char**)malloc (sizeof (char*) * (size_t)Variables);
+    Texts = (const char**)malloc (sizeof (char*) * (size_t)Variables);
+    SingleResults = (char**)malloc (sizeof (char*) * (size_t)Variables);
+    BatchResults = (char**)malloc (sizeof (char*) * (size_t)Variables);
+    for (x = 0; x < Variables; x++) {
+        Names[x] = (char*)malloc (64);
+        sprintf (Names[x], "Model.Sub%03i.Signal_%05i", x % 97, x);
+        Entrys[x] = Names[x];
+        Texts[x] = VARIABLE_INFO;
+    }
+    fh = fopen (INI_FILE_NAME, "wt");
+    fprintf (fh, "[Variables]\n");
+    for (x = 0; x < Variables; x += 2) {
+        fprintf (fh, "%s=%s\n", Names[x], VARIABLE_INFO);
+    }
+    fprintf (fh, "[Other]\na=b\n");
+    fclose (fh);
+
+    IniFileDataBaseInit ();
+    Fd = IniFileDataBaseOpen (INI_FILE_NAME);
+    if (Fd <= 0) {
+        printf ("cannot open \"%s\"\n", INI_FILE_NAME);
+        return 1;
+    }
+
+    t = GetTime ();
+    for (Found = 0, x = 0; x < Variables; x++) {
+        SingleResults[x] = IniFileDataBaseReadStringBufferNoDef ("Variables", Entrys[x], Fd);
+        if (SingleResults[x] != NULL) Found++;
+    }
+    t = GetTime () - t;
+    printf ("%i variables, read single:  %10.2f ms, %i found\n", Variables, t * 1e3, Found);
+    t = GetTime ();
+    Found = IniFileDataBaseReadStringBuffers ("Variables", Entrys, Variables, BatchResults, Fd);
+    t = GetTime () - t;
+    printf ("%i variables, read batched: %10.2f ms, %i found\n", Variables, t * 1e3, Found);
+    for (x = 0; x < Variables; x++) {
+        if (((SingleResults[x] == NULL) != (BatchResults[x] == NULL)) ||
+            ((SingleResults[x] != NULL) && strcmp (SingleResults[x], BatchResults[x]))) {
+            Errors++;
+        }
+        if (SingleResults[x] != NULL) IniFileDataBaseReadStringBufferFree (SingleResults[x]);
+        if (BatchResults[x] != NULL) IniFileDataBaseReadStringBufferFree (BatchResults[x]);
+    }
+
+    // write back the infos (the missing half will be added)
+    t = GetTime ();
+    for (x = 0; x < Variables; x++) {
+        IniFileDataBaseWriteString ("Variables", Entrys[x], Texts[x], Fd);
+    }
+    t = GetTime () - t;
+    printf ("%i variables, write single:  %10.2f ms\n", Variables, t * 1e3);
+    if (IniFileDataBaseGetSectionNumberOfEntrys ("Variables", Fd) != Variables) Errors++;
+    // again from the not changed file
+    IniFileDataBaseClose (Fd);
+    Fd = IniFileDataBaseOpen (INI_FILE_NAME);
+    t = GetTime ();
+    if (IniFileDataBaseWriteStrings ("Variables", Entrys, Texts, Variables, Fd) != 0) Errors++;
+    t = GetTime () - t;
+    printf ("%i variables, write batched: %10.2f ms\n", Variables, t * 1e3);
+    if (IniFileDataBaseGetSectionNumberOfEntrys ("Variables", Fd) != Variables) Errors++;
+
+    if (Errors) printf ("%i differences between single and batched access\n", Errors);
+    IniFileDataBaseClose (Fd);
+    IniFileDataBaseTerminate ();
+    remove (INI_FILE_NAME);
+    for (x = 0; x < Variables; x++) {
+        free (Names[x]);
+    }
+    free (Names);
+    free (Entrys);
+    free (Texts);
+    free (SingleResults);
+    free (BatchResults);
+    return (Errors > 0) ? 1 : 0;
+}
@@ -0,0 +1,462 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <zlib.h>
+
+#include "Files.h"
+#include "MainValues.h"
+#include "Scheduler.h"
+#include "EnvironmentVariables.h"
+#include "ReadFromBlackboardPipe.h"
+#include "StimulusReadFile.h"
+#include "StimulusReadMdf4File.h"
+#include "Mdf4Structs.h"
+
+// Benchmark of the MDF4 stimulus reader (Mdf4ReadOneStimuliTimeSlot()). A file with one data group
+// and many channels of different data types (double, float, 32 bit integer, big endian 16 bit integer,
+// 8 bit integer and a 12 bit field) will be generated, once with DT blocks (records are crossing the
+// block borders) and once with transposed DZ blocks. Both are read with all channels, than all values
+// are compared with the generator. With <data types> = 1 all channels are doubles.
+// Usage: BenchStimulusReadMdf4 [<channels> [<records> [<data types>]]]
+
+#define DT_BLOCK_SIZE   (4 * 1024 * 1024)
+#define DZ_RECORDS      1024
+#define KINDS           6
+
+// Blackboard and file functions used by the stimulus file reader
+
+MAIN_INI_VAL s_main_ini_val;
+
+static enum BB_DATA_TYPES *VariableTypes;
+static int *ChannelOfVid;
+static int VariableCount;
+static int MaxVariables;
+
+VID add_bbvari (const char *name, enum BB_DATA_TYPES type, const char *unit)
+{
+    (void)unit;
+    if (VariableCount >= MaxVariables) return -1;
+    VariableCount++;
+    VariableTypes[VariableCount] = (type >= BB_UNKNOWN) ? BB_DOUBLE : type;
+    if (sscanf (name, "Signal%i", &ChannelOfVid[VariableCount]) != 1) ChannelOfVid[VariableCount] = -1;
+    return VariableCount;
+}
+
+int get_bbvaritype (VID vid)
+{
+    return VariableTypes[vid];
+}
+
+int set_bbvari_unit (VID vid, const char *unit) { (void)vid; (void)unit; return 0; }
+int set_bbvari_conversion (VID vid, int convtype, const char *conversion) { (void)vid; (void)convtype; (void)conversion; return 0; }
+int set_bbvari_min (VID vid, double min) { (void)vid; (void)min; return 0; }
+int set_bbvari_max (VID vid, double max) { (void)vid; (void)max; return 0; }
+int set_bbvari_format (VID vid, int width, int prec) { (void)vid; (void)width; (void)prec; return 0; }
+
+int GetCurrentPid (void)
+{
+    return 1;
+}
+
+int SearchAndReplaceEnvironmentStrings (const char *src, char *dest, int maxc)
+{
+    strncpy (dest, src, (size_t)maxc);
+    dest[maxc - 1] = 0;
+    return (int)strlen (dest) + 1;
+}
+
+static double GetTime (void)
+{
+    struct timespec Time;
+    clock_gettime (CLOCK_MONOTONIC, &Time);
+    return (double)Time.tv_sec + (double)Time.tv_nsec * 1e-9;
+}
+
+// Channels (the time channel is not counted)
+
+static int Channels = 2000;
+static int Records = 20000;
+static int Kinds = KINDS;
+static int RecordSize;
+static int *ByteOffsets;
+
+static int KindSize (int par_Kind)
+{
+    static const int Sizes[KINDS] = { 8, 4, 4, 2, 1, 2 };
+    return Sizes[par_Kind];
+}
+
+static double ChannelValue (int par_Record, int par_Channel)
+{
+    switch (par_Channel % Kinds) {
+    case 0:
+        return par_Record + par_Channel * 0.5;
+    case 1:
+        return ((par_Record + par_Channel) % 1000) * 0.25;
+    case 2:
+        return (double)(par_Record * 7 + par_Channel) - 100000.0;
+    case 3:
+        return (par_Record + par_Channel) & 0xFFFF;
+    case 4:
+        return (par_Record + par_Channel) & 0xFF;
+    default:
+        return (par_Record * 3 + par_Channel) & 0xFFF;
+    }
+}
+
+static void BuildRecord (unsigned char *ret_Record, int par_Record)
+{
+    double Time = par_Record * 0.001;
+    int c;
+
+    memcpy (ret_Record, &Time, sizeof (Time));
+    for (c = 0; c < Channels; c++) {
+        unsigned char *p = ret_Record + ByteOffsets[c];
+        double Value = ChannelValue (par_Record, c);
+        switch (c % Kinds) {
+        case 0:
+            memcpy (p, &Value, sizeof (Value));
+            break;
+        case 1:
+        {
+            float f = (float)Value;
+            memcpy (p, &f, sizeof (f));
+            break;
+        }
+        case 2:
+        {
+            int32_t i = (int32_t)Value;
+            memcpy (p, &i, sizeof (i));
+            break;
+        }
+        case 3:
+            p[0] = (unsigned char)((int)Value >> 8);   // big endian
+            p[1] = (unsigned char)Value;
+            break;
+        case 4:
+            p[0] = (unsigned char)Value;
+            break;
+        default:
+        {
+            uint16_t Field = (uint16_t)(((int)Value << 3) | 0x8007);  // 12 bits at bit offset 3, other bits set
+            memcpy (p, &Field, sizeof (Field));
+            break;
+        }
+        }
+    }
+}
+
+// Generate the file
+
+static FILE *fh;
+static uint64_t FilePos;
+
+static uint64_t Write (const void *par_Data, uint64_t par_Size)
+{
+    uint64_t Ret = FilePos;
+    fwrite (par_Data, 1, (size_t)par_Size, fh);
+    FilePos += par_Size;
+    return Ret;
+}
+
+static uint64_t WriteMdf4BlockHeader (const char *par_Id, uint64_t par_Size, uint64_t par_LinkCount)
+{
+    static const char Zeros[8];
+    MDF4_BLOCK_HEADER Header;
+
+    if (FilePos & 7) Write (Zeros, 8 - (FilePos & 7));
+    memset (&Header, 0, sizeof (Header));
+    memcpy (Header.BlockTypeIdentifier, par_Id, 4);
+    Header.BlockLength = par_Size;
+    Header.LinkCount = par_LinkCount;
+    return Write (&Header, sizeof (Header));
+}
+
+static uint64_t WriteMdf4Text (const char *par_Text)
+{
+    uint64_t Len = strlen (par_Text) + 1;
+    uint64_t Ret = WriteMdf4BlockHeader ("##TX", sizeof (MDF4_BLOCK_HEADER) + Len, 0);
+    Write (par_Text, Len);
+    return Ret;
+}
+
+static uint64_t WriteDtBlock (const unsigned char *par_Data, uint64_t par_Len)
+{
+    uint64_t Ret = WriteMdf4BlockHeader ("##DT", sizeof (MDF4_BLOCK_HEADER) + par_Len, 0);
+    Write (par_Data, par_Len);
+    return Ret;
+}
+
+static uint64_t WriteDzBlock (const unsigned char *par_Data, int par_Records)
+{
+    uint64_t Len = (uint64_t)par_Records * (uint64_t)RecordSize;
+    unsigned char *Transposed = (unsigned char*)malloc (Len);
+    unsigned char *Deflated = (unsigned char*)malloc (compressBound (Len));
+    uLongf DeflatedLen = compressBound (Len);
+    MDF4_DZBLOCK DzBlock;
+    uint64_t Ret;
+    int r, c;
+
+    for (r = 0; r < par_Records; r++) {
+        for (c = 0; c < RecordSize; c++) {
+            Transposed[(uint64_t)c * par_Records + r] = par_Data[(uint64_t)r * RecordSize + c];
+        }
+    }
+    compress2 (Deflated, &DeflatedLen, Transposed, Len, 1);
+    memset (&DzBlock, 0, sizeof (DzBlock));
+    memcpy (DzBlock.OrigBlockTypeIdentifier, "DT", 2);
+    DzBlock.Type = 1;
+    DzBlock.Parameter = (uint32_t)RecordSize;
+    DzBlock.OrigDataLength = Len;
+    DzBlock.DataLength = DeflatedLen;
+    Ret = WriteMdf4BlockHeader ("##DZ", sizeof (MDF4_BLOCK_HEADER) + sizeof (DzBlock) + DeflatedLen, 0);
+    Write (&DzBlock, sizeof (DzBlock));
+    Write (Deflated, DeflatedLen);
+    free (Transposed);
+    free (Deflated);
+    return Ret;
+}
+
+static void GenerateMdf4File (const char *par_Name, int par_Compressed)
+{
+    int BufferSize = par_Compressed ? DZ_RECORDS * RecordSize : DT_BLOCK_SIZE + RecordSize;
+    unsigned char *Buffer = (unsigned char*)malloc ((size_t)BufferSize);
+    int MaxBlocks = Records / (par_Compressed ? DZ_RECORDS : 1) + 2;
+    uint64_t *Blocks = (uint64_t*)malloc (sizeof (uint64_t) * (size_t)MaxBlocks);
+    uint64_t HeaderLinks[6] = {0};
+    uint64_t HeaderLinksPos, DataListPos, ChannelGroupPos, DataGroupPos, Next = 0;
+    MDF4_IDBLOCK IdBlock;
+    MDF4_HDBLOCK HdBlock;
+    MDF4_DLBLOCK DlBlock;
+    MDF4_CGBLOCK CgBlock;
+    MDF4_DGBLOCK DgBlock;
+    uint64_t Zero = 0;
+    int r, c, Fill = 0, NoOfBlocks = 0;
+
+    fh = fopen (par_Name, "wb");
+    FilePos = 0;
+    memset (&IdBlock, 0, sizeof (IdBlock));
+    memcpy (IdBlock.FileIdentifier, "MDF     ", 8);
+    memcpy (IdBlock.FormatTdentifier, "4.10    ", 8);
+    IdBlock.VersionNumber = 410;
+    Write (&IdBlock, sizeof (IdBlock));
+    WriteMdf4BlockHeader ("##HD", sizeof (MDF4_BLOCK_HEADER) + sizeof (HeaderLinks) + sizeof (HdBlock), 6);
+    HeaderLinksPos = Write (HeaderLinks, sizeof (HeaderLinks));
+    memset (&HdBlock, 0, sizeof (HdBlock));
+    Write (&HdBlock, sizeof (HdBlock));
+
+    for (r = 0; r < Records; r++) {
+        BuildRecord (Buffer + Fill, r);
+        Fill += RecordSize;
+        if (par_Compressed) {
+            if ((Fill == BufferSize) || (r == (Records - 1))) {
+                Blocks[NoOfBlocks++] = WriteDzBlock (Buffer, Fill / RecordSize);
+                Fill = 0;
+            }
+        } else if (Fill >= DT_BLOCK_SIZE) {
+            // the last record is continued inside the next block
+            Blocks[NoOfBlocks++] = WriteDtBlock (Buffer, DT_BLOCK_SIZE);
+            Fill -= DT_BLOCK_SIZE;
+            memmove (Buffer, Buffer + DT_BLOCK_SIZE, (size_t)Fill);
+        }
+    }
+    if (Fill > 0) Blocks[NoOfBlocks++] = WriteDtBlock (Buffer, (uint64_t)Fill);
+
+    DataListPos = WriteMdf4BlockHeader ("##DL", sizeof (MDF4_BLOCK_HEADER) + sizeof (uint64_t) * (1 + (uint64_t)NoOfBlocks) + sizeof (DlBlock),
+                                        1 + (uint64_t)NoOfBlocks);
+    Write (&Zero, sizeof (Zero));
+    Write (Blocks, sizeof (uint64_t) * (uint64_t)NoOfBlocks);
+    memset (&DlBlock, 0, sizeof (DlBlock));
+    DlBlock.NoOfBlocks = (uint32_t)NoOfBlocks;
+    Write (&DlBlock, sizeof (DlBlock));
+
+    // channels are linked backwards, the time channel is the first one
+    for (c = Channels - 1; c >= -1; c--) {
+        static const uint8_t DataTypes[KINDS] = { 4, 4, 2, 1, 0, 0 };
+        char Name[32];
+        uint64_t NamePos, ChannelPos;
+        uint64_t Links[8] = {0};
+        MDF4_CNBLOCK CnBlock;
+
+        if (c < 0) strcpy (Name, "time");
+        else sprintf (Name, "Signal%i", c);
+        NamePos = WriteMdf4Text (Name);
+        ChannelPos = WriteMdf4BlockHeader ("##CN", sizeof (MDF4_BLOCK_HEADER) + sizeof (Links) + sizeof (MDF4_CNBLOCK), 8);
+        Links[0] = Next;
+        Links[2] = NamePos;
+        Write (Links, sizeof (Links));
+        memset (&CnBlock, 0, sizeof (CnBlock));
+        if (c < 0) {
+            CnBlock.Type = 2;      // master
+            CnBlock.SyncType = 1;  // time
+            CnBlock.DataType = 4;
+            CnBlock.BitCount = 64;
+        } else {
+            CnBlock.DataType = DataTypes[c % Kinds];
+            CnBlock.ByteOffset = (uint32_t)ByteOffsets[c];
+            if ((c % Kinds) == (KINDS - 1)) {
+                CnBlock.BitOffset = 3;
+                CnBlock.BitCount = 12;
+            } else {
+                CnBlock.BitCount = (uint32_t)KindSize (c % Kinds) * 8;
+            }
+        }
+        Write (&CnBlock, sizeof (CnBlock));
+        Next = ChannelPos;
+    }
+    {
+        uint64_t Links[6] = {0};
+        Links[1] = Next;
+        ChannelGroupPos = WriteMdf4BlockHeader ("##CG", sizeof (MDF4_BLOCK_HEADER) + sizeof (Links) + sizeof (CgBlock), 6);
+        Write (Links, sizeof (Links));
+        memset (&CgBlock, 0, sizeof (CgBlock));
+        CgBlock.NoOfSamples = (uint64_t)Records;
+        CgBlock.NoOfDataBytes = (uint32_t)RecordSize;
+        Write (&CgBlock, sizeof (CgBlock));
+    }
+    {
+        uint64_t Links[4] = {0};
+        Links[1] = ChannelGroupPos;
+        Links[2] = DataListPos;
+        DataGroupPos = WriteMdf4BlockHeader ("##DG", sizeof (MDF4_BLOCK_HEADER) + sizeof (Links) + sizeof (DgBlock), 4);
+        Write (Links, sizeof (Links));
+        memset (&DgBlock, 0, sizeof (DgBlock));
+        Write (&DgBlock, sizeof (DgBlock));
+    }
+    fseek (fh, (long)HeaderLinksPos, SEEK_SET);
+    HeaderLinks[0] = DataGroupPos;
+    fwrite (HeaderLinks, sizeof (uint64_t), 1, fh);
+    fclose (fh);
+    free (Buffer);
+    free (Blocks);
+}
+
+// Read the file
+
+static double ValueToDouble (int par_Type, union BB_VARI par_Value)
+{
+    switch (par_Type) {
+    case BB_BYTE: return par_Value.b;
+    case BB_UBYTE: return par_Value.ub;
+    case BB_WORD: return par_Value.w;
+    case BB_UWORD: return par_Value.uw;
+    case BB_DWORD: return par_Value.dw;
+    case BB_UDWORD: return par_Value.udw;
+    case BB_QWORD: return (double)par_Value.qw;
+    case BB_UQWORD: return (double)par_Value.uqw;
+    case BB_FLOAT: return par_Value.f;
+    default: return par_Value.d;
+    }
+}
+
+static int ReadMdf4File (const char *par_Name, const char *par_Variables, VARI_IN_PIPE *par_Varis, int par_Check)
+{
+    STIMULI_FILE *File;
+    uint64_t Time;
+    int Record, Count, x, Errors = 0;
+    double t;
+
+    VariableCount = 0;
+    File = Mdf4OpenAndReadStimuliHeader (par_Name, par_Variables);
+    if (File == NULL) {
+        printf ("%s: cannot open\n", par_Name);
+        return 1;
+    }
+    t = GetTime ();
+    for (Record = 0; (Count = Mdf4ReadOneStimuliTimeSlot (File, par_Varis, &Time)) > 0; Record++) {
+        if (!par_Check) continue;
+        if ((Count != Channels) || (Record >= Records)) {
+            Errors++;
+            continue;
+        }
+        for (x = 0; x < Count; x++) {
+            int Vid = par_Varis[x].vid;
+            int c = ((Vid > 0) && (Vid <= VariableCount)) ? ChannelOfVid[Vid] : -1;
+            double Value = ValueToDouble (par_Varis[x].type, par_Varis[x].value);
+            if ((c < 0) || (Value != ChannelValue (Record, c))) {
+                if (Errors < 10) printf ("%s: record %i channel %i: %g expected %g\n", par_Name, Record, c,
+                                         Value, (c < 0) ? 0.0 : ChannelValue (Record, c));
+                Errors++;
+            }
+        }
+    }
+    t = GetTime () - t;
+    if (Record != Records) {
+        printf ("%s: %i records expected %i\n", par_Name, Record, Records);
+        Errors++;
+    }
+    if (!par_Check) {
+        printf ("%-20s %8.3f s, %6.2f ns/value, %8.1f MB/s\n", par_Name, t, t / ((double)Records * Channels) * 1e9,
+                (double)Records * RecordSize / t / 1e6);
+    }
+    Mdf4CloseStimuliFile (File);
+    return Errors;
+}
+
+int main (int argc, char *argv[])
+{
+    static const char *Names[2] = { "bench_dt.mf4", "bench_dz.mf4" };
+    VARI_IN_PIPE *Varis;
+    char *Variables, *p;
+    int c, f, Errors = 0;
+
+    if (argc >= 2) Channels = atoi (argv[1]);
+    if (argc >= 3) Records = atoi (argv[2]);
+    if (Channels < 1) Channels = 1;
+    if (argc >= 4) Kinds = atoi (argv[3]);
+    if (Records < 1) Records = 1;
+    if ((Kinds < 1) || (Kinds > KINDS)) Kinds = KINDS;
+
+    ByteOffsets = (int*)malloc (sizeof (int) * (size_t)Channels);
+    RecordSize = (int)sizeof (double);
+    for (c = 0; c < Channels; c++) {
+        ByteOffsets[c] = RecordSize;
+        RecordSize += KindSize (c % Kinds);
+    }
+    MaxVariables = Channels + 1;
+    VariableTypes = (enum BB_DATA_TYPES*)calloc ((size_t)MaxVariables + 1, sizeof (enum BB_DATA_TYPES));
+    ChannelOfVid = (int*)calloc ((size_t)MaxVariables + 1, sizeof (int));
+    Varis = (VARI_IN_PIPE*)malloc (sizeof (VARI_IN_PIPE) * (size_t)MaxVariables);
+    Variables = p = (char*)malloc ((size_t)Channels * 16 + 1);
+    for (c = 0; c < Channels; c++) {
+        p += sprintf (p, "Signal%i", c) + 1;
+    }
+    *p = 0;
+
+    init_files ();
+    printf ("%i channels (%i data types), %i records with %i bytes\n", Channels, Kinds, Records, RecordSize);
+    // the file names are lower case because my_open() handles names starting with an upper case letter as windows paths
+    for (f = 0; f < 2; f++) {
+        GenerateMdf4File (Names[f], f);
+        Errors += ReadMdf4File (Names[f], Variables, Varis, 0);
+        Errors += ReadMdf4File (Names[f], Variables, Varis, 1);
+        remove (Names[f]);
+    }
+    if (Errors) printf ("%i errors\n", Errors);
+
+    free (ByteOffsets);
+    free (VariableTypes);
+    free (ChannelOfVid);
+    free (Varis);
+    free (Variables);
+    return (Errors > 0) ? 1 : 0;
+}
@@ -0,0 +1,319 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "Config.h"
+#include "Files.h"
+#include "MainValues.h"
+#include "Scheduler.h"
+#include "EnvironmentVariables.h"
+#include "ReadFromBlackboardPipe.h"
+#include "TraceRecorder.h"
+#include "TraceWriteMdf4File.h"
+#include "StimulusReadFile.h"
+#include "StimulusReadMdf4File.h"
+
+// Benchmark of the MDF4 recorder (WriteRingbuffMdf4()). Many signals with mixed data types (40% double,
+// 20% float, 15% 32 bit, 10% 16 bit and 15% 8 bit integer) are recorded, than the file is read back
+// with the MDF4 stimulus reader and all values are compared with the recorded ones.
+// Usage: BenchTraceWriteMdf4 [<signals> [<samples>]]
+
+#define FILE_NAME     "bench_record.mf4"
+#define TIME_STEP_NS  1000000
+
+static int Signals = 5000;
+static int Samples = 20000;
+
+static enum BB_DATA_TYPES SignalType (int par_Signal)
+{
+    int Kind = par_Signal % 20;
+    if (Kind < 8) return BB_DOUBLE;
+    if (Kind < 12) return BB_FLOAT;
+    if (Kind < 15) return BB_DWORD;
+    if (Kind < 17) return BB_WORD;
+    return BB_UBYTE;
+}
+
+static int SignalSize (int par_Signal)
+{
+    switch (SignalType (par_Signal)) {
+    case BB_DOUBLE:
+        return 8;
+    case BB_FLOAT:
+    case BB_DWORD:
+        return 4;
+    case BB_WORD:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+static double SignalValue (int par_Signal, int par_Sample)
+{
+    switch (SignalType (par_Signal)) {
+    case BB_DOUBLE:
+        return par_Sample * 0.001 + par_Signal;
+    case BB_FLOAT:
+        return ((par_Sample + par_Signal) % 4096) * 0.5;
+    case BB_DWORD:
+        return (double)par_Sample * 3 - par_Signal;
+    case BB_WORD:
+        return (double)(int16_t)(uint16_t)(par_Sample * 7 + par_Signal);
+    default:
+        return (par_Sample + par_Signal) & 0xFF;
+    }
+}
+
+static void SetValue (VARI_IN_PIPE *ret_Entry, int par_Signal, int par_Sample)
+{
+    double Value = SignalValue (par_Signal, par_Sample);
+    switch (SignalType (par_Signal)) {
+    case BB_DOUBLE:
+        ret_Entry->value.d = Value;
+        break;
+    case BB_FLOAT:
+        ret_Entry->value.f = (float)Value;
+        break;
+    case BB_DWORD:
+        ret_Entry->value.dw = (int32_t)Value;
+        break;
+    case BB_WORD:
+        ret_Entry->value.w = (int16_t)Value;
+        break;
+    default:
+        ret_Entry->value.ub = (uint8_t)Value;
+        break;
+    }
+}
+
+// Blackboard and scheduler functions used by the recorder and the stimulus reader
+// (the vid of the recorder is the signal number + 1)
+
+MAIN_INI_VAL s_main_ini_val;
+int conv_rec_time_steps;
+
+static enum BB_DATA_TYPES *ReadTypes;
+static int *SignalOfReadVid;
+static int ReadVariableCount;
+
+int GetBlackboardVariableNameAndTypes (VID vid, char *txt, int maxc, enum BB_DATA_TYPES *ret_data_type, enum BB_CONV_TYPES *ret_conversion_type)
+{
+    snprintf (txt, (size_t)maxc, "Signal%i", vid - 1);
+    *ret_data_type = SignalType (vid - 1);
+    *ret_conversion_type = BB_CONV_NONE;
+    return 0;
+}
+
+int get_bbvari_unit (VID vid, char *unit, int maxc)
+{
+    (void)vid;
+    strncpy (unit, "-", (size_t)maxc);
+    return 0;
+}
+
+int get_bbvari_conversion (VID vid, char *conversion, int maxc)
+{
+    (void)vid;
+    if (maxc > 0) conversion[0] = 0;
+    return 0;
+}
+
+double get_bbvari_min (VID vid) { (void)vid; return 0.0; }
+double get_bbvari_max (VID vid) { (void)vid; return 1.0; }
+int get_bbvari_format_prec (VID vid) { (void)vid; return 3; }
+
+uint64_t GetSimulatedStartTimeInNanoSecond (void) { return 0; }
+uint64_t GetSimulatedTimeInNanoSecond (void) { return 0; }
+
+VID add_bbvari (const char *name, enum BB_DATA_TYPES type, const char *unit)
+{
+    (void)unit;
+    if (ReadVariableCount >= Signals) return -1;
+    ReadVariableCount++;
+    ReadTypes[ReadVariableCount] = (type >= BB_UNKNOWN) ? BB_DOUBLE : type;
+    if (sscanf (name, "Signal%i", &SignalOfReadVid[ReadVariableCount]) != 1) SignalOfReadVid[ReadVariableCount] = -1;
+    return ReadVariableCount;
+}
+
+int get_bbvaritype (VID vid)
+{
+    return ReadTypes[vid];
+}
+
+int set_bbvari_unit (VID vid, const char *unit) { (void)vid; (void)unit; return 0; }
+int set_bbvari_conversion (VID vid, int convtype, const char *conversion) { (void)vid; (void)convtype; (void)conversion; return 0; }
+int set_bbvari_min (VID vid, double min) { (void)vid; (void)min; return 0; }
+int set_bbvari_max (VID vid, double max) { (void)vid; (void)max; return 0; }
+int set_bbvari_format (VID vid, int width, int prec) { (void)vid; (void)width; (void)prec; return 0; }
+
+int GetCurrentPid (void)
+{
+    return 1;
+}
+
+int SearchAndReplaceEnvironmentStrings (const char *src, char *dest, int maxc)
+{
+    strncpy (dest, src, (size_t)maxc);
+    dest[maxc - 1] = 0;
+    return (int)strlen (dest) + 1;
+}
+
+static double GetTime (void)
+{
+    struct timespec Time;
+    clock_gettime (CLOCK_MONOTONIC, &Time);
+    return (double)Time.tv_sec + (double)Time.tv_nsec * 1e-9;
+}
+
+static double ValueToDouble (int par_Type, union BB_VARI par_Value)
+{
+    switch (par_Type) {
+    case BB_BYTE: return par_Value.b;
+    case BB_UBYTE: return par_Value.ub;
+    case BB_WORD: return par_Value.w;
+    case BB_UWORD: return par_Value.uw;
+    case BB_DWORD: return par_Value.dw;
+    case BB_UDWORD: return par_Value.udw;
+    case BB_QWORD: return (double)par_Value.qw;
+    case BB_UQWORD: return (double)par_Value.uqw;
+    case BB_FLOAT: return par_Value.f;
+    default: return par_Value.d;
+    }
+}
+
+// Record all samples, the values of each sample are prepared before (as inside the recorder ring buffer)
+static int RecordFile (VARI_IN_PIPE *par_Entries)
+{
+    START_MESSAGE_DATA Start;
+    int32_t *Vids = (int32_t*)malloc (sizeof (int32_t) * (size_t)(Signals + 1));
+    RING_BUFFER_COLOMN Stamp;
+    uint64_t RecordSize = 8;
+    double t, WriteTime = 0.0;
+    FILE *fh;
+    int Sample, s, Ret = 0;
+
+    for (s = 0; s < Signals; s++) {
+        Vids[s] = s + 1;
+        RecordSize += (uint64_t)SignalSize (s);
+    }
+    Vids[Signals] = 0;
+    memset (&Start, 0, sizeof (Start));
+    strcpy (Start.Filename, FILE_NAME);
+    if (OpenWriteMdf4Head (Start, Vids, NULL, &fh) != 0) {
+        free (Vids);
+        return -1;
+    }
+    Stamp.EntryList = par_Entries;
+    for (Sample = 0; (Sample < Samples) && (Ret == 0); Sample++) {
+        // first is the counter second is the timestamp
+        par_Entries[1].value.d = (double)Sample * TIME_STEP_NS / TIMERCLKFRQ;
+        for (s = 0; s < Signals; s++) {
+            SetValue (&par_Entries[s + 2], s, Sample);
+        }
+        t = GetTime ();
+        Ret = WriteRingbuffMdf4 (fh, &Stamp, Signals + 2);
+        WriteTime += GetTime () - t;
+    }
+    t = GetTime ();
+    if (Ret == 0) Ret = TailMdf4File (fh, (uint32_t)Samples, 0);
+    WriteTime += GetTime () - t;
+    printf ("%i signals, %i samples, %i byte records: write %.3f s, %.1f MB/s, %.2f ns/value\n",
+            Signals, Samples, (int)RecordSize, WriteTime, (double)RecordSize * Samples / WriteTime / 1e6,
+            WriteTime / ((double)Signals * Samples) * 1e9);
+    free (Vids);
+    return Ret;
+}
+
+static int ReadBackFile (VARI_IN_PIPE *par_Varis)
+{
+    STIMULI_FILE *File;
+    char *Variables, *p;
+    uint64_t Time;
+    int Sample, Count, s, x, Errors = 0;
+
+    Variables = p = (char*)malloc ((size_t)Signals * 16 + 1);
+    for (s = 0; s < Signals; s++) {
+        p += sprintf (p, "Signal%i", s) + 1;
+    }
+    *p = 0;
+    ReadVariableCount = 0;
+    File = Mdf4OpenAndReadStimuliHeader (FILE_NAME, Variables);
+    free (Variables);
+    if (File == NULL) {
+        printf ("cannot read back \"%s\"\n", FILE_NAME);
+        return 1;
+    }
+    for (Sample = 0; (Count = Mdf4ReadOneStimuliTimeSlot (File, par_Varis, &Time)) > 0; Sample++) {
+        if (Count != Signals) {
+            Errors++;
+            continue;
+        }
+        for (x = 0; x < Count; x++) {
+            int Vid = par_Varis[x].vid;
+            int Signal = ((Vid > 0) && (Vid <= ReadVariableCount)) ? SignalOfReadVid[Vid] : -1;
+            double Value = ValueToDouble (par_Varis[x].type, par_Varis[x].value);
+            if ((Signal < 0) || (Value != SignalValue (Signal, Sample))) {
+                if (Errors < 10) printf ("sample %i signal %i: %g expected %g\n", Sample, Signal, Value,
+                                         (Signal < 0) ? 0.0 : SignalValue (Signal, Sample));
+                Errors++;
+            }
+        }
+    }
+    if (Sample != Samples) {
+        printf ("%i samples read back, expected %i\n", Sample, Samples);
+        Errors++;
+    }
+    Mdf4CloseStimuliFile (File);
+    printf ("read back: %i errors\n", Errors);
+    return Errors;
+}
+
+int main (int argc, char *argv[])
+{
+    VARI_IN_PIPE *Entries;
+    int Errors = 0;
+
+    if (argc >= 2) Signals = atoi (argv[1]);
+    if (argc >= 3) Samples = atoi (argv[2]);
+    if (Signals < 1) Signals = 1;
+    if (Samples < 1) Samples = 1;
+
+    Entries = (VARI_IN_PIPE*)calloc ((size_t)Signals + 2, sizeof (VARI_IN_PIPE));
+    ReadTypes = (enum BB_DATA_TYPES*)calloc ((size_t)Signals + 1, sizeof (enum BB_DATA_TYPES));
+    SignalOfReadVid = (int*)calloc ((size_t)Signals + 1, sizeof (int));
+
+    init_files ();
+    // the file name is lower case because my_open() handles names starting with an upper case letter as windows paths
+    if (RecordFile (Entries) != 0) {
+        printf ("cannot write \"%s\"\n", FILE_NAME);
+        Errors++;
+    } else {
+        Errors += ReadBackFile (Entries);
+    }
+    remove (FILE_NAME);
+
+    free (Entries);
+    free (ReadTypes);
+    free (SignalOfReadVid);
+    return (Errors > 0) ? 1 : 0;
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "Blackboard.h"
+#include "BlackboardConversion.h"
+#include "UnitTest.h"
+
+// The table conversions search with a uniform grid or a binary search (Conv_TablePrepareLookup()).
+// They must give bit exact the same results as the former linear search, which is used here as reference.
+
+#define TABLES     2000
+#define MAX_SIZE   1000
+
+static long Checks;
+
+static int LinearSearch (BB_VARIABLE_CONVERSION *par_Conversion, double par_Value, int par_Phys)
+{
+    struct CONVERSION_TABLE_VALUE_PAIR *Values = par_Conversion->Conv.Table.Values;
+    int x;
+
+    for (x = 0; x < par_Conversion->Conv.Table.Size; x++) {
+        if ((par_Phys ? Values[x].Phys : Values[x].Raw) >= par_Value) break;
+    }
+    return x;
+}
+
+static double RefInterpol (BB_VARIABLE_CONVERSION *par_Conversion, double par_Value, int par_PhysToRaw)
+{
+    struct CONVERSION_TABLE_VALUE_PAIR *Values = par_Conversion->Conv.Table.Values;
+    int Size = par_Conversion->Conv.Table.Size;
+    int x = LinearSearch (par_Conversion, par_Value, par_PhysToRaw);
+    double InDelta, OutDelta;
+
+    if (x == Size) return par_PhysToRaw ? Values[Size - 1].Raw : Values[Size - 1].Phys;
+    if (x == 0) return par_PhysToRaw ? Values[0].Raw : Values[0].Phys;
+    if (par_PhysToRaw) {
+        InDelta = Values[x].Phys - Values[x-1].Phys;
+        if ((InDelta <= 0.0) && (InDelta >= 0.0)) return Values[x-1].Raw;  // == 0.0
+        OutDelta = Values[x].Raw - Values[x-1].Raw;
+        return Values[x-1].Raw + OutDelta / InDelta * (par_Value - Values[x-1].Phys);
+    } else {
+        InDelta = Values[x].Raw - Values[x-1].Raw;
+        if ((InDelta <= 0.0) && (InDelta >= 0.0)) return Values[x-1].Phys;  // == 0.0
+        OutDelta = Values[x].Phys - Values[x-1].Phys;
+        return Values[x-1].Phys + OutDelta / InDelta * (par_Value - Values[x-1].Raw);
+    }
+}
+
+static double RefNoInterpol (BB_VARIABLE_CONVERSION *par_Conversion, double par_Value, int par_PhysToRaw)
+{
+    struct CONVERSION_TABLE_VALUE_PAIR *Values = par_Conversion->Conv.Table.Values;
+    int Size = par_Conversion->Conv.Table.Size;
+    int x = LinearSearch (par_Conversion, par_Value, par_PhysToRaw);
+
+    if (x == Size) x = Size - 1;
+    return par_PhysToRaw ? Values[x].Raw : Values[x].Phys;
+}
+
+static int Same (double a, double b)
+{
+    return (isnan (a) && isnan (b)) || (memcmp (&a, &b, sizeof (double)) == 0);
+}
+
+static double Random (void)
+{
+    return (double)rand () / RAND_MAX;
+}
+
+static void CheckValue (BB_VARIABLE_CONVERSION *par_Conversion, double par_Value)
+{
+    double Ret;
+
+    Conv_TableInterpolRawToPhys (par_Conversion, par_Value, &Ret);
+    UNIT_TEST_CHECK_MSG (Same (Ret, RefInterpol (par_Conversion, par_Value, 0)), "raw to phys %.17g (flags 0x%x)", par_Value, par_Conversion->Conv.Table.Flags);
+    Conv_TableInterpolPhysToRaw (par_Conversion, par_Value, &Ret);
+    UNIT_TEST_CHECK_MSG (Same (Ret, RefInterpol (par_Conversion, par_Value, 1)), "phys to raw %.17g (flags 0x%x)", par_Value, par_Conversion->Conv.Table.Flags);
+    Conv_TableNoInterpolRawToPhys (par_Conversion, par_Value, &Ret);
+    UNIT_TEST_CHECK_MSG (Same (Ret, RefNoInterpol (par_Conversion, par_Value, 0)), "no interpolation raw to phys %.17g", par_Value);
+    Conv_TableNoInterpolPhysToRaw (par_Conversion, par_Value, &Ret);
+    UNIT_TEST_CHECK_MSG (Same (Ret, RefNoInterpol (par_Conversion, par_Value, 1)), "no interpolation phys to raw %.17g", par_Value);
+    Checks += 4;
+}
+
+static void CheckTable (struct CONVERSION_TABLE_VALUE_PAIR *par_Values, int par_Size, int *ret_FlagCounts)
+{
+    BB_VARIABLE_CONVERSION Conversion;
+    double Low = 1e300, High = -1e300;
+    static double In[256], Out[256];
+    int x, k;
+
+    memset (&Conversion, 0, sizeof (Conversion));
+    Conversion.Type = BB_CONV_TAB_INTP;
+    Conversion.Conv.Table.Values = par_Values;
+    Conversion.Conv.Table.Size = par_Size;
+    Conv_TablePrepareLookup (&Conversion);
+    ret_FlagCounts[Conversion.Conv.Table.Flags & 0xF]++;
+
+    // all table points and their direct neighbours
+    for (x = 0; x < par_Size; x++) {
+        double Points[2];
+        Points[0] = par_Values[x].Raw;
+        Points[1] = par_Values[x].Phys;
+        for (k = 0; k < 2; k++) {
+            if (Points[k] < Low) Low = Points[k];
+            if (Points[k] > High) High = Points[k];
+            CheckValue (&Conversion, Points[k]);
+            CheckValue (&Conversion, nextafter (Points[k], -INFINITY));
+            CheckValue (&Conversion, nextafter (Points[k], INFINITY));
+        }
+    }
+    CheckValue (&Conversion, NAN);
+    CheckValue (&Conversion, INFINITY);
+    CheckValue (&Conversion, -INFINITY);
+    for (x = 0; x < 100; x++) {
+        CheckValue (&Conversion, Low - 1.0 + (High - Low + 2.0) * Random ());
+    }
+
+    // array conversion
+    for (x = 0; x < 256; x++) In[x] = Low - 1.0 + (High - Low + 2.0) * Random ();
+    Conv_TableRawToPhysArray (&Conversion, In, Out, 256);
+    for (x = 0; x < 256; x++) {
+        UNIT_TEST_CHECK (Same (Out[x], RefInterpol (&Conversion, In[x], 0)));
+    }
+    Conversion.Type = BB_CONV_TAB_NOINTP;
+    Conv_TableRawToPhysArray (&Conversion, In, Out, 256);
+    for (x = 0; x < 256; x++) {
+        UNIT_TEST_CHECK (Same (Out[x], RefNoInterpol (&Conversion, In[x], 0)));
+    }
+    Checks += 512;
+}
+
+int main (void)
+{
+    static struct CONVERSION_TABLE_VALUE_PAIR Values[MAX_SIZE];
+    int FlagCounts[16] = {0};
+    int t, x;
+
+    srand (1);
+    for (t = 0; t < TABLES; t++) {
+        int Size = 1 + rand () % ((t % 20 == 0) ? MAX_SIZE : 40);
+        double Step = (rand () % 3 == 0) ? 0.1 : (double)(1 + rand () % 10);
+        double Start = (rand () % 200) - 100.0 + ((rand () & 1) ? 0.3 : 0.0);
+        for (x = 0; x < Size; x++) {
+            switch (t % 7) {
+            case 0:  // uniform raw
+                Values[x].Raw = Start + x * Step;
+                Values[x].Phys = 3.0 * x * x - 7.0;
+                break;
+            case 1:  // uniform raw, descending phys
+                Values[x].Raw = Start + x * Step;
+                Values[x].Phys = 100.0 - x * 0.5;
+                break;
+            case 2:  // ascending
+                Values[x].Raw = (x ? Values[x-1].Raw : Start) + Random () * 5.0;
+                Values[x].Phys = (x ? Values[x-1].Phys : 0.0) + Random ();
+                break;
+            case 3:  // with duplicates
+                Values[x].Raw = (x ? Values[x-1].Raw : Start) + (rand () % 3);
+                Values[x].Phys = (x ? Values[x-1].Phys : 0.0) + (rand () % 2);
+                break;
+            case 4:  // not sorted
+                Values[x].Raw = Random () * 100.0;
+                Values[x].Phys = Random () * 100.0;
+                break;
+            case 5:  // almost uniform
+                Values[x].Raw = Start + x * Step * (1.0 + ((x == Size / 2) ? 1e-7 : 0.0));
+                Values[x].Phys = Start + x * Step;
+                break;
+            default:  // NaN inside
+                Values[x].Raw = Start + x * Step;
+                Values[x].Phys = (x == Size / 2) ? NAN : (double)x;
+                break;
+            }
+        }
+        CheckTable (Values, Size, FlagCounts);
+    }
+    // each search method must be used
+    UNIT_TEST_CHECK (FlagCounts[CONV_TABLE_RAW_ASCENDING | CONV_TABLE_RAW_UNIFORM] > 0);
+    UNIT_TEST_CHECK (FlagCounts[CONV_TABLE_RAW_ASCENDING | CONV_TABLE_PHYS_ASCENDING] > 0);
+    UNIT_TEST_CHECK (FlagCounts[0] > 0);
+    printf ("%li checks, %i failed\n", Checks, UnitTestFailedChecks);
+    return UNIT_TEST_RESULT();
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "BlackboardHashIndex.h"
+#include "UnitTest.h"
+
+// Test of the blackboard hash index: lookups against a reference, lock-free lookups
+// while the same blackboard index is reused by different variables and long collision chains.
+
+#define BLACKBOARD_SIZE    4096
+#define CHANGES            200000
+#define COLLISION_NAMES    200
+#define COLLISION_CHANGES  20000
+
+static volatile int StopReader;
+static uint64_t WrongVids;
+static uint64_t Found;
+
+// A writer alternately adds "Alpha" (odd VIDs) and "Beta" (even VIDs) with the same blackboard index
+static void *ReaderThread (void *par_Arg)
+{
+    uint64_t HashAlpha = BuildHashCode ("Alpha");
+    (void)par_Arg;
+
+    while (!StopReader) {
+        int32_t Vid;
+        int Index = SearchHashKey ("Alpha", HashAlpha, &Vid);
+        if (Index >= 0) {
+            Found++;
+            if ((Index != 0) || ((Vid & 1) == 0)) WrongVids++;
+        } else if (Vid != -1) {
+            WrongVids++;
+        }
+    }
+    return NULL;
+}
+
+static void ReuseIndex (void)
+{
+    pthread_t Reader;
+    uint64_t HashAlpha = BuildHashCode ("Alpha");
+    uint64_t HashBeta = BuildHashCode ("Beta");
+    int x;
+
+    StopReader = 0;
+    pthread_create (&Reader, NULL, ReaderThread, NULL);
+    for (x = 0; x < CHANGES; x++) {
+        UNIT_TEST_CHECK (AddHashKey ("Alpha", HashAlpha, 0, 2 * x + 1) == 0);
+        UNIT_TEST_CHECK (RemoveHashKey (HashAlpha, 0) == 0);
+        UNIT_TEST_CHECK (AddHashKey ("Beta", HashBeta, 0, 2 * x + 2) == 0);
+        UNIT_TEST_CHECK (RemoveHashKey (HashBeta, 0) == 0);
+    }
+    StopReader = 1;
+    pthread_join (Reader, NULL);
+    UNIT_TEST_CHECK_MSG (WrongVids == 0, "%llu wrong VIDs (%llu found)", (unsigned long long)WrongVids, (unsigned long long)Found);
+}
+
+static void AddSearchRemove (void)
+{
+    static char Names[BLACKBOARD_SIZE][32];
+    static uint64_t Hashes[BLACKBOARD_SIZE];
+    int x, Index;
+    int32_t Vid;
+
+    for (x = 0; x < BLACKBOARD_SIZE - 1; x++) {
+        snprintf (Names[x], sizeof (Names[x]), "Model.Signal%i", x);
+        Hashes[x] = BuildHashCode (Names[x]);
+        Index = GetFreeBlackboardIndex ();
+        UNIT_TEST_CHECK (Index >= 0);
+        UNIT_TEST_CHECK (AddHashKey (Names[x], Hashes[x], Index, 0x10000 + Index) == 0);
+    }
+    for (x = 0; x < BLACKBOARD_SIZE - 1; x++) {
+        Index = SearchHashKey (Names[x], Hashes[x], &Vid);
+        UNIT_TEST_CHECK ((Index >= 0) && (Vid == 0x10000 + Index));
+    }
+    UNIT_TEST_CHECK (SearchHashKey ("Model.Signal", BuildHashCode ("Model.Signal"), &Vid) == -1);
+    // remove every second one
+    for (x = 0; x < BLACKBOARD_SIZE - 1; x += 2) {
+        Index = SearchHashKey (Names[x], Hashes[x], NULL);
+        UNIT_TEST_CHECK (RemoveHashKey (Hashes[x], Index) == 0);
+        FreeBlackboardIndex (Index);
+    }
+    for (x = 0; x < BLACKBOARD_SIZE - 1; x++) {
+        Index = SearchHashKey (Names[x], Hashes[x], &Vid);
+        if (x & 1) {
+            UNIT_TEST_CHECK ((Index >= 0) && (Vid == 0x10000 + Index));
+            UNIT_TEST_CHECK (RemoveHashKey (Hashes[x], Index) == 0);
+            FreeBlackboardIndex (Index);
+        } else {
+            UNIT_TEST_CHECK ((Index == -1) && (Vid == -1));
+        }
+    }
+}
+
+// Forced hash codes: all names of a group have the same home slot (the lowest bits), some of them
+// also the same tag (the upper 32 bits). The first group starts near the end of the table so its
+// cluster wraps around to the beginning where the home slots of the second group are.
+static uint64_t CollisionHash (int par_Name)
+{
+    uint32_t Home = (par_Name < COLLISION_NAMES / 2) ? 0xFFFFFFFFU - 40 : (uint32_t)(par_Name % 4);
+    uint32_t Tag = (uint32_t)(par_Name % 3);
+    return ((uint64_t)Tag << 32) | Home;
+}
+
+static void Collisions (void)
+{
+    static char Names[COLLISION_NAMES][32];
+    static int Indexes[COLLISION_NAMES];   // -1 if not inside the table
+    uint32_t Random = 1;
+    int x, n, Index;
+    int32_t Vid;
+
+    for (n = 0; n < COLLISION_NAMES; n++) {
+        snprintf (Names[n], sizeof (Names[n]), "Collision%i", n);
+        Indexes[n] = GetFreeBlackboardIndex ();
+        UNIT_TEST_CHECK (AddHashKey (Names[n], CollisionHash (n), Indexes[n], 0x10000 + Indexes[n]) == 0);
+    }
+    for (x = 0; x < COLLISION_CHANGES; x++) {
+        // remove (backward shift) or re-insert a random name
+        Random = Random * 1103515245U + 12345U;
+        n = (int)((Random >> 8) % COLLISION_NAMES);
+        if (Indexes[n] >= 0) {
+            UNIT_TEST_CHECK (RemoveHashKey (CollisionHash (n), Indexes[n]) == 0);
+            UNIT_TEST_CHECK (RemoveHashKey (CollisionHash (n), Indexes[n]) == -1);
+            FreeBlackboardIndex (Indexes[n]);
+            Indexes[n] = -1;
+        } else {
+            Indexes[n] = GetFreeBlackboardIndex ();
+            UNIT_TEST_CHECK (AddHashKey (Names[n], CollisionHash (n), Indexes[n], 0x10000 + Indexes[n]) == 0);
+        }
+        // all other names must be found at there new slots
+        for (n = 0; n < COLLISION_NAMES; n++) {
+            Index = SearchHashKey (Names[n], CollisionHash (n), &Vid);
+            UNIT_TEST_CHECK_MSG ((Index == Indexes[n]) && (Vid == ((Index >= 0) ? 0x10000 + Index : -1)),
+                                 "change %i: %s has index %i (expected %i)", x, Names[n], Index, Indexes[n]);
+        }
+    }
+    UNIT_TEST_CHECK (SearchHashKey ("Collision", CollisionHash (0), &Vid) == -1);
+    for (n = 0; n < COLLISION_NAMES; n++) {
+        if (Indexes[n] >= 0) {
+            UNIT_TEST_CHECK (RemoveHashKey (CollisionHash (n), Indexes[n]) == 0);
+            FreeBlackboardIndex (Indexes[n]);
+        }
+    }
+    for (n = 0; n < COLLISION_NAMES; n++) {
+        UNIT_TEST_CHECK (SearchHashKey (Names[n], CollisionHash (n), NULL) == -1);
+    }
+}
+
+int main (void)
+{
+    UNIT_TEST_CHECK (InitMasterHashTable (BLACKBOARD_SIZE) == 0);
+    AddSearchRemove ();
+    ReuseIndex ();
+    Collisions ();
+    CloseMasterHashTable ();
+    return UNIT_TEST_RESULT();
+}
@@ -0,0 +1,312 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "Blackboard.h"
+#include "BlackboardDeltaCoding.h"
+#include "StructsRM_Blackboard.h"
+#include "RemoteMasterLock.h"
+#include "RemoteMasterNet.h"
+#include "RemoteMasterBlackboardSync.h"
+#include "RemoteMasterBlackboardMirror.h"
+#include "UnitTest.h"
+
+// Blackboard value sync between the mirror of the client (RemoteMasterBlackboardMirror.c) and the
+// remote master (RemoteMasterBlackboardSync.c). First the delta blocks will be encoded and decoded
+// with all data types and index distances, than the client is connected with the server through
+// a loopback TransactRemoteMaster().
+
+#define BLACKBOARD_SIZE  4096
+#define MAX_ENTRIES      4096
+#define WRITE_PID        5
+
+static const uint8_t Types[] = { BB_BYTE, BB_UBYTE, BB_WORD, BB_UWORD, BB_DWORD, BB_UDWORD,
+                                 BB_FLOAT, BB_DOUBLE, BB_QWORD, BB_UQWORD, BB_DELTA_REMOVED_TYPE };
+#define TYPE_COUNT  (int)(sizeof (Types) / sizeof (Types[0]))
+
+static uint32_t RandomState = 4711;
+
+static uint32_t Random (void)
+{
+    RandomState = RandomState * 1103515245U + 12345U;
+    return RandomState >> 8;
+}
+
+static union BB_VARI RandomValue (void)
+{
+    union BB_VARI Value;
+    Value.uqw = ((uint64_t)Random () << 40) ^ ((uint64_t)Random () << 20) ^ Random ();
+    return Value;
+}
+
+// The decoded values have only the bytes of the type, the rest is 0
+static int SameValue (int par_Type, union BB_VARI par_Value, union BB_VARI par_Decoded)
+{
+    union BB_VARI Expected;
+    Expected.uqw = 0;
+    memcpy (&Expected, &par_Value, (size_t)GetDataTypeByteSize (par_Type));
+    return Expected.uqw == par_Decoded.uqw;
+}
+
+// Blackboard of the remote master
+
+BB_VARIABLE *blackboard;
+union BB_VARI *blackboard_values;
+int8_t *blackboard_types;
+GLOBAL_BBINFOS blackboard_infos;
+
+static int ReadOnly[BLACKBOARD_SIZE];
+static int LastWritePid;
+
+int GetDataTypeByteSize (int par_DataType)
+{
+    switch (par_DataType) {
+    case BB_BYTE:
+    case BB_UBYTE:
+        return 1;
+    case BB_WORD:
+    case BB_UWORD:
+        return 2;
+    case BB_DWORD:
+    case BB_UDWORD:
+    case BB_FLOAT:
+        return 4;
+    case BB_QWORD:
+    case BB_UQWORD:
+    case BB_DOUBLE:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+void write_bbvari_union_pid (int Pid, VID vid, int DataType, union BB_VARI v)
+{
+    int Index = (int)(vid >> 8);
+    LastWritePid = Pid;
+    if ((blackboard[Index].Vid == vid) && !ReadOnly[Index] && (DataType == BB_TYPE(Index))) {
+        BB_VALUE(Index) = v;
+    }
+}
+
+void RemoteMasterLock (REMOTE_MASTER_LOCK *Lock, int LineNr, const char *File)
+{
+    (void)Lock; (void)LineNr; (void)File;
+}
+
+void RemoteMasterUnlock (REMOTE_MASTER_LOCK *Lock)
+{
+    (void)Lock;
+}
+
+void RemoteMasterInitLock (REMOTE_MASTER_LOCK *Lock)
+{
+    (void)Lock;
+}
+
+// Loopback to the remote master (same as Func_SyncBlackboardValues())
+static int Transactions;
+
+int TransactRemoteMaster (int par_Command, void *par_DataToRM, int par_LenDataToRM, void *ret_DataFromRM, int par_LenDataFromRM)
+{
+    RM_BLACKBOARD_SYNC_VALUES_REQ *Req = (RM_BLACKBOARD_SYNC_VALUES_REQ*)par_DataToRM;
+    RM_BLACKBOARD_SYNC_VALUES_ACK *Ack = (RM_BLACKBOARD_SYNC_VALUES_ACK*)ret_DataFromRM;
+    int MaxLenValues = par_LenDataFromRM - (int)sizeof (RM_BLACKBOARD_SYNC_VALUES_ACK);
+    int LenValues;
+
+    UNIT_TEST_CHECK (par_Command == RM_BLACKBOARD_SYNC_VALUES_CMD);
+    UNIT_TEST_CHECK ((int)(Req->OffsetWrites + Req->LenWrites) == par_LenDataToRM);
+    if ((int)Req->MaxLenValues < MaxLenValues) MaxLenValues = (int)Req->MaxLenValues;
+    Transactions++;
+    Ack->OffsetValues = sizeof (RM_BLACKBOARD_SYNC_VALUES_ACK);
+    Ack->Ret = SyncBlackboardValues (Req->WritePid, Req->Flags,
+                                     (VID*)((char*)Req + Req->OffsetSubscribeVids), Req->SubscribeCount,
+                                     (char*)Req + Req->OffsetWrites, (int)Req->LenWrites,
+                                     (char*)Ack + Ack->OffsetValues, MaxLenValues, &LenValues);
+    Ack->LenValues = (uint32_t)LenValues;
+    return (int)sizeof (RM_BLACKBOARD_SYNC_VALUES_ACK) + LenValues;
+}
+
+// Encode and decode delta blocks with random types and index distances inside and between the segments
+static void TestDeltaCoding (void)
+{
+    static const int32_t Distances[] = { 1, 2, 7, 8, 9, 31, 32, 33, 1000, 1 << 20, 1 << 27 };
+    static int32_t Indexes[MAX_ENTRIES], DecodedIndexes[MAX_ENTRIES];
+    static uint8_t EntryTypes[MAX_ENTRIES], DecodedTypes[MAX_ENTRIES];
+    static union BB_VARI Values[MAX_ENTRIES], DecodedValues[MAX_ENTRIES];
+    static uint8_t Block[MAX_ENTRIES * 16];
+    int Loop;
+
+    for (Loop = 0; Loop < 200; Loop++) {
+        int Count = 1 + (int)(Random () % ((Loop < 100) ? 20 : MAX_ENTRIES));
+        int DistanceCount = 1 + Loop % (int)(sizeof (Distances) / sizeof (Distances[0]));
+        int32_t Index = (int32_t)(Random () % 64);
+        int Len, Encoded, Decoded, MaxLen, LastEncoded, x;
+
+        for (x = 0; x < Count; x++) {
+            Indexes[x] = Index;
+            EntryTypes[x] = Types[(Loop < TYPE_COUNT) ? Loop : (int)(Random () % TYPE_COUNT)];
+            Values[x] = RandomValue ();
+            if ((INT32_MAX - Index) <= (1 << 27)) break;   // stop before the largest possible index
+            Index += Distances[Random () % (uint32_t)DistanceCount];
+        }
+        Count = x;
+        // all entries must fit into 16 bytes each (see SyncBlackboardValues() of the mirror)
+        Encoded = EncodeBlackboardDelta (Indexes, EntryTypes, Values, Count, Block, Count * 16, &Len);
+        UNIT_TEST_CHECK_MSG ((Encoded == Count) && (Len <= Count * 16), "%i of %i entries encoded, %i bytes", Encoded, Count, Len);
+        Decoded = DecodeBlackboardDelta (Block, Len, DecodedIndexes, DecodedTypes, DecodedValues, MAX_ENTRIES);
+        UNIT_TEST_CHECK_MSG (Decoded == Count, "%i of %i entries decoded", Decoded, Count);
+        for (x = 0; (x < Decoded) && (x < Count); x++) {
+            UNIT_TEST_CHECK_MSG ((DecodedIndexes[x] == Indexes[x]) && (DecodedTypes[x] == EntryTypes[x]) &&
+                                 SameValue (EntryTypes[x], Values[x], DecodedValues[x]),
+                                 "entry %i index %i type %i", x, Indexes[x], EntryTypes[x]);
+        }
+        // A smaller block must contain the first entries (the rest will be transmitted with the next call)
+        if (Count > 100) continue;
+        LastEncoded = 0;
+        for (MaxLen = 0; MaxLen <= Len; MaxLen++) {
+            int PartLen;
+            Encoded = EncodeBlackboardDelta (Indexes, EntryTypes, Values, Count, Block, MaxLen, &PartLen);
+            UNIT_TEST_CHECK_MSG ((PartLen <= MaxLen) && (Encoded >= LastEncoded), "max. len %i: %i entries %i bytes",
+                                 MaxLen, Encoded, PartLen);
+            Decoded = DecodeBlackboardDelta (Block, PartLen, DecodedIndexes, DecodedTypes, DecodedValues, MAX_ENTRIES);
+            UNIT_TEST_CHECK_MSG (Decoded == Encoded, "max. len %i: %i entries encoded, %i decoded", MaxLen, Encoded, Decoded);
+            for (x = 0; (x < Decoded) && (x < Encoded); x++) {
+                UNIT_TEST_CHECK ((DecodedIndexes[x] == Indexes[x]) && (DecodedTypes[x] == EntryTypes[x]));
+            }
+            LastEncoded = Encoded;
+        }
+        UNIT_TEST_CHECK (LastEncoded == Count);
+    }
+}
+
+static VID VidOfIndex (int par_Index, int par_Generation)
+{
+    return (par_Index << 8) | par_Generation;
+}
+
+static void AddVariable (int par_Index, int par_Generation, int par_Type)
+{
+    blackboard[par_Index].Vid = VidOfIndex (par_Index, par_Generation);
+    blackboard[par_Index].Type = par_Type;
+    blackboard_types[par_Index] = (int8_t)par_Type;
+    BB_VALUE(par_Index) = RandomValue ();
+}
+
+// Variables on each third index with all data types, check that the mirror has the same values as the remote master
+static int CheckMirror (const char *par_Step)
+{
+    int Index, Errors = 0;
+
+    for (Index = 0; Index < BLACKBOARD_SIZE; Index += 3) {
+        enum BB_DATA_TYPES Type;
+        union BB_VARI Value;
+        if (blackboard[Index].Vid <= 0) continue;
+        if (!rm_ReadBbvariFromMirror (blackboard[Index].Vid, &Type, &Value)) {
+            UNIT_TEST_CHECK_MSG (0, "%s: index %i not inside the mirror", par_Step, Index);
+            Errors++;
+        } else if ((Type != BB_TYPE(Index)) || memcmp (&Value, &BB_VALUE(Index), (size_t)GetDataTypeByteSize (Type))) {
+            UNIT_TEST_CHECK_MSG (0, "%s: index %i has a different value", par_Step, Index);
+            Errors++;
+        }
+    }
+    return Errors;
+}
+
+static void TestMirrorSync (void)
+{
+    enum BB_DATA_TYPES Type;
+    union BB_VARI Value;
+    int Index, Written;
+
+    blackboard = (BB_VARIABLE*)calloc (BLACKBOARD_SIZE, sizeof (BB_VARIABLE));
+    blackboard_values = (union BB_VARI*)calloc (BLACKBOARD_SIZE, sizeof (union BB_VARI));
+    blackboard_types = (int8_t*)calloc (BLACKBOARD_SIZE, sizeof (int8_t));
+    blackboard_infos.Size = BLACKBOARD_SIZE;
+    for (Index = 0; Index < BLACKBOARD_SIZE; Index += 3) {
+        AddVariable (Index, 1, Types[(Index / 3) % (TYPE_COUNT - 1)]);
+    }
+    InitBlackboardValueSync ();
+    rm_InitBlackboardSync (BLACKBOARD_SIZE);
+
+    // The first read of each variable subscribes it
+    for (Index = 0; Index < BLACKBOARD_SIZE; Index += 3) {
+        UNIT_TEST_CHECK (!rm_ReadBbvariFromMirror (blackboard[Index].Vid, &Type, &Value));
+    }
+    UNIT_TEST_CHECK (rm_SyncBlackboardValues () >= 0);
+    UNIT_TEST_CHECK (CheckMirror ("subscribe") == 0);
+
+    // Changes of the remote master
+    for (Index = 0; Index < BLACKBOARD_SIZE; Index += 3 * 7) {
+        BB_VALUE(Index) = RandomValue ();
+    }
+    UNIT_TEST_CHECK (rm_SyncBlackboardValues () >= 0);
+    UNIT_TEST_CHECK (CheckMirror ("remote master changes") == 0);
+
+    // Writes of the client (some twice, the last one wins), also to a read only variable and one with the wrong data type
+    ReadOnly[3] = 1;
+    Written = 0;
+    for (Index = 0; Index < BLACKBOARD_SIZE; Index += 3) {
+        Written += rm_WriteBbvariToMirror (WRITE_PID, blackboard[Index].Vid, BB_UNION, RandomValue ());
+    }
+    for (Index = 0; Index < BLACKBOARD_SIZE; Index += 3 * 5) {
+        Written += rm_WriteBbvariToMirror (WRITE_PID, blackboard[Index].Vid, BB_UNION, RandomValue ());
+    }
+    UNIT_TEST_CHECK (Written == (BLACKBOARD_SIZE + 2) / 3 + (BLACKBOARD_SIZE + 14) / 15);
+    UNIT_TEST_CHECK (!rm_WriteBbvariToMirror (WRITE_PID, blackboard[6].Vid, (BB_TYPE(6) == BB_DOUBLE) ? BB_FLOAT : BB_DOUBLE, RandomValue ()));
+    UNIT_TEST_CHECK (rm_SyncBlackboardValues () >= 0);
+    UNIT_TEST_CHECK (LastWritePid == WRITE_PID);
+    // now the read only variable has the value of the remote master again
+    UNIT_TEST_CHECK (CheckMirror ("client writes") == 0);
+
+    // A write of an other process flush the pending writes first
+    UNIT_TEST_CHECK (rm_WriteBbvariToMirror (WRITE_PID, blackboard[9].Vid, BB_UNION, RandomValue ()));
+    UNIT_TEST_CHECK (!rm_WriteBbvariToMirror (WRITE_PID + 1, blackboard[12].Vid, BB_UNION, RandomValue ()));
+    Written = Transactions;
+    rm_FlushBlackboardWrites ();
+    UNIT_TEST_CHECK (Transactions == Written + 1);
+    UNIT_TEST_CHECK (CheckMirror ("flush") == 0);
+
+    // Removed and reused blackboard index
+    blackboard[15].Vid = 0;
+    UNIT_TEST_CHECK (rm_SyncBlackboardValues () >= 0);
+    UNIT_TEST_CHECK (!rm_ReadBbvariFromMirror (VidOfIndex (15, 1), &Type, &Value));
+    AddVariable (15, 2, BB_QWORD);
+    UNIT_TEST_CHECK (!rm_ReadBbvariFromMirror (VidOfIndex (15, 2), &Type, &Value));
+    UNIT_TEST_CHECK (rm_SyncBlackboardValues () >= 0);
+    UNIT_TEST_CHECK (CheckMirror ("reused index") == 0);
+
+    rm_TerminateBlackboardSync ();
+    free (blackboard);
+    free (blackboard_values);
+    free (blackboard_types);
+}
+
+int main (int argc, char *argv[])
+{
+    (void)argc; (void)argv;
+
+    TestDeltaCoding ();
+    TestMirrorSync ();
+
+    printf ("%i transactions, %i failed\n", Transactions, UnitTestFailedChecks);
+    return UNIT_TEST_RESULT ();
+}
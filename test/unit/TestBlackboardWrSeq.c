@@ -0,0 +1,161 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "AtomicAccess.h"
+#include "Blackboard.h"
+#include "UnitTest.h"
+
+// Concurrency test of the per variable write sequence numbers (SET_BB_WRITTEN):
+// several writers increment the sequence numbers while more readers than the old
+// 64 bit write flag mask could handle poll them. No increment may be lost and
+// each reader must see each variable which was written since its last poll.
+
+#define VARIABLES         4096
+#define WRITERS           4
+#define READERS           96
+#define WRITES_PER_WRITER 200000
+
+volatile uint32_t *blackboard_wr_seqs;
+uint32_t *blackboard_observation_flags;
+
+static volatile uint64_t Values[VARIABLES];
+static volatile uint32_t ObservationCounter;
+static volatile int StopReaders;
+
+typedef struct {
+    uint32_t LastWrSeqs[VARIABLES];
+    uint64_t LastValues[VARIABLES];
+    uint64_t DetectedChanges;
+    uint64_t MissedChanges;
+} READER;
+
+static READER Readers[READERS];
+
+void PushValueChangedObservation (int par_VidIndex)
+{
+    (void)par_VidIndex;
+    ATOMIC_FETCH_ADD_U32(&ObservationCounter, 1);
+}
+
+static void *WriterThread (void *par_Arg)
+{
+    uint32_t Random = (uint32_t)(intptr_t)par_Arg * 7919u + 1u;
+    int x;
+
+    for (x = 0; x < WRITES_PER_WRITER; x++) {
+        int Index;
+        Random = Random * 1103515245u + 12345u;
+        Index = (int)((Random >> 8) % VARIABLES);
+        __atomic_fetch_add (&Values[Index], 1, __ATOMIC_RELAXED);
+        SET_BB_WRITTEN (Index);
+    }
+    return NULL;
+}
+
+static void PollAll (READER *par_Reader, int par_CheckMissed)
+{
+    int Index;
+
+    for (Index = 0; Index < VARIABLES; Index++) {
+        uint32_t WrSeq = ATOMIC_LOAD_ACQUIRE_U32(&BB_WR_SEQ(Index));
+        uint64_t Value = __atomic_load_n (&Values[Index], __ATOMIC_ACQUIRE);
+        if (WrSeq != par_Reader->LastWrSeqs[Index]) {
+            par_Reader->DetectedChanges++;
+            par_Reader->LastWrSeqs[Index] = WrSeq;
+            par_Reader->LastValues[Index] = Value;
+        } else if (par_CheckMissed && (Value != par_Reader->LastValues[Index])) {
+            // value was changed but the sequence number not
+            par_Reader->MissedChanges++;
+        }
+    }
+}
+
+static void *ReaderThread (void *par_Arg)
+{
+    READER *Reader = &Readers[(intptr_t)par_Arg];
+
+    while (!StopReaders) {
+        PollAll (Reader, 0);
+    }
+    return NULL;
+}
+
+int main (void)
+{
+    pthread_t Writers[WRITERS];
+    pthread_t ReaderThreads[READERS];
+    uint64_t SumOfWrSeqs = 0;
+    uint64_t ExpectedObservations = 0;
+    int x;
+
+    blackboard_wr_seqs = (volatile uint32_t*)calloc (VARIABLES, sizeof (uint32_t));
+    blackboard_observation_flags = (uint32_t*)calloc (VARIABLES, sizeof (uint32_t));
+    // every 16th variable is observed
+    for (x = 0; x < VARIABLES; x += 16) {
+        blackboard_observation_flags[x] = OBSERVE_VALUE_CHANGED;
+    }
+
+    for (x = 0; x < READERS; x++) {
+        pthread_create (&ReaderThreads[x], NULL, ReaderThread, (void*)(intptr_t)x);
+    }
+    for (x = 0; x < WRITERS; x++) {
+        pthread_create (&Writers[x], NULL, WriterThread, (void*)(intptr_t)x);
+    }
+    for (x = 0; x < WRITERS; x++) {
+        pthread_join (Writers[x], NULL);
+    }
+    StopReaders = 1;
+    for (x = 0; x < READERS; x++) {
+        pthread_join (ReaderThreads[x], NULL);
+    }
+
+    for (x = 0; x < VARIABLES; x++) {
+        SumOfWrSeqs += BB_WR_SEQ(x);
+        if ((blackboard_observation_flags[x] & OBSERVE_VALUE_CHANGED) == OBSERVE_VALUE_CHANGED) {
+            ExpectedObservations += BB_WR_SEQ(x);
+        }
+        // a sequence number is incremented exactly as often as the value was written
+        UNIT_TEST_CHECK_MSG (BB_WR_SEQ(x) == (uint32_t)Values[x], "variable %i: %u != %u",
+                             x, BB_WR_SEQ(x), (uint32_t)Values[x]);
+    }
+    UNIT_TEST_CHECK_MSG (SumOfWrSeqs == (uint64_t)WRITERS * WRITES_PER_WRITER, "lost increments: %lli",
+                         (long long)((uint64_t)WRITERS * WRITES_PER_WRITER - SumOfWrSeqs));
+    UNIT_TEST_CHECK (ObservationCounter == ExpectedObservations);
+
+    // After all writers are finished one more poll of each reader must see the final state of all variables
+    for (x = 0; x < READERS; x++) {
+        int Index;
+        PollAll (&Readers[x], 1);
+        UNIT_TEST_CHECK_MSG (Readers[x].MissedChanges == 0, "reader %i missed %llu changes",
+                             x, (unsigned long long)Readers[x].MissedChanges);
+        for (Index = 0; Index < VARIABLES; Index++) {
+            if (Readers[x].LastWrSeqs[Index] != BB_WR_SEQ(Index)) {
+                UnitTestFailedChecks++;
+            }
+        }
+        PollAll (&Readers[x], 1);
+        UNIT_TEST_CHECK (Readers[x].MissedChanges == 0);
+    }
+
+    free ((void*)blackboard_wr_seqs);
+    free (blackboard_observation_flags);
+    return UNIT_TEST_RESULT();
+}
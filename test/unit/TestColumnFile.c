@@ -0,0 +1,207 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "Config.h"
+#include "MyMemory.h"
+#include "Files.h"
+#include "MainValues.h"
+#include "Scheduler.h"
+#include "EnvironmentVariables.h"
+#include "ReadFromBlackboardPipe.h"
+#include "TraceRecorder.h"
+#include "TraceWriteColumnFile.h"
+#include "StimulusReadFile.h"
+#include "StimulusReadColumnFile.h"
+#include "UnitTest.h"
+
+// Column recording files (*.xcol): a file with a double, a signed word and an unsigned byte signal
+// is written with TraceWriteColumnFile.c (more samples than fit into one chunk group) and read back
+// with StimulusReadColumnFile.c. The values and the min./max. of single signals must be the same as
+// the written ones, also for time ranges crossing the chunk group borders.
+
+#define COLUMN_FILE_NAME  "column_test.xcol"
+#define CHUNK_SAMPLES     65536   // COLUMN_MAX_CHUNK_SAMPLES because the records are small
+#define SAMPLES           (2 * CHUNK_SAMPLES + 1000)
+#define SIGNALS           3
+#define TIME_STEP_NS      1000000
+
+static const char *SignalNames[SIGNALS] = { "sig_double", "sig_word", "sig_ubyte" };
+static const enum BB_DATA_TYPES SignalTypes[SIGNALS] = { BB_DOUBLE, BB_WORD, BB_UBYTE };
+
+static double SignalValue (int par_Signal, int par_Sample)
+{
+    switch (par_Signal) {
+    case 0:
+        return sin (par_Sample * 0.001) * 1000.0 + par_Sample * 0.01;
+    case 1:
+        return (double)(int16_t)(uint16_t)(par_Sample * 7);
+    default:
+        return (double)(par_Sample % 251);
+    }
+}
+
+// Blackboard and scheduler functions used by the column file writer and reader
+
+MAIN_INI_VAL s_main_ini_val;
+
+int GetBlackboardVariableNameAndTypes (VID vid, char *txt, int maxc, enum BB_DATA_TYPES *ret_data_type, enum BB_CONV_TYPES *ret_conversion_type)
+{
+    strncpy (txt, SignalNames[vid - 1], (size_t)maxc);
+    *ret_data_type = SignalTypes[vid - 1];
+    *ret_conversion_type = BB_CONV_NONE;
+    return 0;
+}
+
+int get_bbvari_unit (VID vid, char *unit, int maxc)
+{
+    (void)vid;
+    strncpy (unit, "-", (size_t)maxc);
+    return 0;
+}
+
+uint64_t GetSimulatedStartTimeInNanoSecond (void) { return 0; }
+uint64_t GetSimulatedTimeInNanoSecond (void) { return 0; }
+
+VID add_bbvari (const char *name, enum BB_DATA_TYPES type, const char *unit)
+{
+    (void)name; (void)type; (void)unit;
+    return 1;
+}
+
+int get_bbvaritype (VID vid)
+{
+    return SignalTypes[vid - 1];
+}
+
+int GetCurrentPid (void)
+{
+    return 1;
+}
+
+int SearchAndReplaceEnvironmentStrings (const char *src, char *dest, int maxc)
+{
+    strncpy (dest, src, (size_t)maxc);
+    dest[maxc - 1] = 0;
+    return (int)strlen (dest) + 1;
+}
+
+static int WriteColumnFile (void)
+{
+    START_MESSAGE_DATA Start;
+    int32_t Vids[SIGNALS + 1] = { 1, 2, 3, 0 };
+    VARI_IN_PIPE Entries[SIGNALS + 2];
+    RING_BUFFER_COLOMN Stamp;
+    FILE *fh;
+    int Sample;
+
+    memset (&Start, 0, sizeof (Start));
+    strcpy (Start.Filename, COLUMN_FILE_NAME);
+    if (OpenWriteColumnHead (Start, Vids, NULL, &fh) != 0) return -1;
+    memset (Entries, 0, sizeof (Entries));
+    Stamp.EntryList = Entries;
+    for (Sample = 0; Sample < SAMPLES; Sample++) {
+        // first is the counter second is the timestamp
+        Entries[1].value.d = (double)Sample * TIME_STEP_NS / TIMERCLKFRQ;
+        Entries[2].value.d = SignalValue (0, Sample);
+        Entries[3].value.w = (int16_t)SignalValue (1, Sample);
+        Entries[4].value.ub = (uint8_t)SignalValue (2, Sample);
+        if (WriteRingbuffColumn (fh, &Stamp, SIGNALS + 2) != 0) return -1;
+    }
+    return TailColumnFile (fh, SAMPLES, 0);
+}
+
+// Read a time range of one signal and compare it with the written values
+static void CheckReadOneSignal (int par_Signal, int par_FromSample, int par_ToSample)
+{
+    uint64_t *Times;
+    double *Values;
+    int Count, x;
+
+    Count = ColumnReadOneSignal (COLUMN_FILE_NAME, SignalNames[par_Signal],
+                                 (uint64_t)par_FromSample * TIME_STEP_NS, (uint64_t)par_ToSample * TIME_STEP_NS,
+                                 &Times, &Values);
+    UNIT_TEST_CHECK_MSG (Count == par_ToSample - par_FromSample + 1, "%s samples %i...%i: %i values read",
+                         SignalNames[par_Signal], par_FromSample, par_ToSample, Count);
+    for (x = 0; x < Count; x++) {
+        int Sample = par_FromSample + x;
+        if ((Times[x] != (uint64_t)Sample * TIME_STEP_NS) || (Values[x] != SignalValue (par_Signal, Sample))) {
+            UNIT_TEST_CHECK_MSG (0, "%s sample %i: time %llu value %g (expected %g)", SignalNames[par_Signal], Sample,
+                                 (unsigned long long)Times[x], Values[x], SignalValue (par_Signal, Sample));
+            break;
+        }
+    }
+    if (Count > 0) {
+        my_free (Times);
+        my_free (Values);
+    }
+}
+
+static void CheckMinMax (int par_Signal, int par_FromSample, int par_ToSample)
+{
+    double Min = INFINITY, Max = -INFINITY, ReadMin, ReadMax;
+    int64_t Count;
+    int Sample;
+
+    for (Sample = par_FromSample; Sample <= par_ToSample; Sample++) {
+        double Value = SignalValue (par_Signal, Sample);
+        if (Value < Min) Min = Value;
+        if (Value > Max) Max = Value;
+    }
+    Count = ColumnGetSignalMinMax (COLUMN_FILE_NAME, SignalNames[par_Signal],
+                                   (uint64_t)par_FromSample * TIME_STEP_NS, (uint64_t)par_ToSample * TIME_STEP_NS,
+                                   &ReadMin, &ReadMax);
+    UNIT_TEST_CHECK_MSG ((Count == par_ToSample - par_FromSample + 1) && (ReadMin == Min) && (ReadMax == Max),
+                         "%s samples %i...%i: %lli samples min %g max %g (expected %g %g)", SignalNames[par_Signal],
+                         par_FromSample, par_ToSample, (long long)Count, ReadMin, ReadMax, Min, Max);
+}
+
+int main (void)
+{
+    uint64_t *Times;
+    double *Values, Min, Max;
+    int s;
+
+    UNIT_TEST_CHECK (WriteColumnFile () == 0);
+    UNIT_TEST_CHECK (IsColumnFormat (COLUMN_FILE_NAME));
+    for (s = 0; s < SIGNALS; s++) {
+        // whole file, inside one chunk group, crossing one and two chunk group borders
+        CheckReadOneSignal (s, 0, SAMPLES - 1);
+        CheckReadOneSignal (s, 10, 20);
+        CheckReadOneSignal (s, CHUNK_SAMPLES - 100, CHUNK_SAMPLES + 100);
+        CheckReadOneSignal (s, CHUNK_SAMPLES - 1, 2 * CHUNK_SAMPLES);
+        CheckMinMax (s, 0, SAMPLES - 1);
+        CheckMinMax (s, 10, 20);
+        CheckMinMax (s, CHUNK_SAMPLES - 100, CHUNK_SAMPLES + 100);
+        CheckMinMax (s, 5, 2 * CHUNK_SAMPLES + 5);
+        CheckMinMax (s, CHUNK_SAMPLES, 2 * CHUNK_SAMPLES - 1);   // exactly one chunk taken from the index
+    }
+    // unknown signal
+    UnitTestThrowErrorCounter = 0;
+    UNIT_TEST_CHECK (ColumnReadOneSignal (COLUMN_FILE_NAME, "sig_unknown", 0, UINT64_MAX, &Times, &Values) == -1);
+    UNIT_TEST_CHECK (ColumnGetSignalMinMax (COLUMN_FILE_NAME, "sig_unknown", 0, UINT64_MAX, &Min, &Max) == -1);
+    UNIT_TEST_CHECK (UnitTestThrowErrorCounter == 2);
+
+    remove (COLUMN_FILE_NAME);
+    printf ("%i samples, %i failed\n", SAMPLES, UnitTestFailedChecks);
+    return UNIT_TEST_RESULT ();
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "Fifos.h"
+#include "FifoSyncCoding.h"
+#include "UnitTest.h"
+
+// Encoding and decoding of the fifo sync blocks (EncodeFiFoSyncBlock() and DecodeFiFoSyncBlock())
+// with all combinations of codings. The coded block must never be larger than the raw block
+// (also if the compacted headers would be larger than the raw headers) and truncated or
+// corrupt blocks must be detected without reading or writing outside the buffers.
+
+#define MAX_RAW_LEN   (64 * 1024)
+#define GUARD_BYTES   64
+#define GUARD_VALUE   0xA5
+
+static int Blocks;
+static int CorruptAccepted;
+
+static uint32_t RandomState = 12345;
+
+static uint32_t Random (void)
+{
+    RandomState = RandomState * 1103515245U + 12345U;
+    return RandomState >> 8;
+}
+
+static int AddRecord (uint8_t *Raw, int Pos, int32_t FiFoId, int32_t Pid, uint32_t MessageId, uint64_t Timestamp,
+                      int Size, int RandomData)
+{
+    FIFO_ENTRY_HEADER Header;
+    int x;
+
+    memset (&Header, 0, sizeof (Header));
+    Header.FiFoId = FiFoId;
+    Header.TramsmiterPid = Pid;
+    Header.MessageId = MessageId;
+    Header.Timestamp = Timestamp;
+    Header.Size = Size;
+    memcpy (Raw + Pos, &Header, sizeof (Header));
+    Pos += (int)sizeof (Header);
+    for (x = 0; x < Size; x++) {
+        Raw[Pos + x] = (uint8_t)(RandomData ? Random () : (x & 0xF));
+    }
+    return Pos + Size;
+}
+
+// A typical block: few fifos, same transmitter, small timestamp steps and compressible data
+static int BuildTypicalBlock (uint8_t *Raw)
+{
+    uint64_t Timestamp = 1000000000ULL;
+    int Pos = 0;
+    int x;
+
+    for (x = 0; x < 200; x++) {
+        Timestamp += 1000 + (Random () % 3);
+        Pos = AddRecord (Raw, Pos, 1 + (x / 50), 7, 0x100 + (uint32_t)(x % 3), Timestamp, 8 + (x % 5) * 4, 0);
+    }
+    return Pos;
+}
+
+// All ids are changing with large values and large timestamp jumps. With records of 16KByte
+// data (3 bytes size) each compacted header is 29 bytes. This is larger than the raw header
+// if it has only 28 bytes (32 bit x86), otherwise (32 bytes) it is the largest possible header
+static int BuildWorstCaseBlock (uint8_t *Raw, int Records)
+{
+    int Pos = 0;
+    int x;
+
+    for (x = 0; x < Records; x++) {
+        Pos = AddRecord (Raw, Pos, -1 - x, (x & 1) ? INT32_MIN : INT32_MAX, 0xF0000000U | (uint32_t)x,
+                         (x & 1) ? 0 : 0x8000000000000000ULL, 16 * 1024, 1);
+    }
+    return Pos;
+}
+
+// Random (not compressible) data
+static int BuildRandomBlock (uint8_t *Raw)
+{
+    int Pos = 0;
+    int x;
+
+    for (x = 0; x < 20; x++) {
+        Pos = AddRecord (Raw, Pos, (int32_t)Random (), (int32_t)Random (), Random (), (uint64_t)Random () << 32,
+                         (int)(Random () % 200), 1);
+    }
+    return Pos;
+}
+
+static int GuardIntact (const uint8_t *Buffer, int Len)
+{
+    int x;
+    for (x = 0; x < GUARD_BYTES; x++) {
+        if (Buffer[Len + x] != GUARD_VALUE) return 0;
+    }
+    return 1;
+}
+
+// Encode into a buffer with exactly par_RawLen bytes followed by guard bytes and decode it again
+static void RoundTrip (const char *Name, const uint8_t *Raw, int RawLen, uint32_t Codings, uint8_t *Coded,
+                       int *ret_CodedLen, uint32_t *ret_Coding)
+{
+    FIFO_SYNC_CODER Encoder, Decoder;
+    uint8_t *Decoded;
+    int CodedLen;
+    uint32_t Coding;
+
+    memset (&Encoder, 0, sizeof (Encoder));
+    memset (&Decoder, 0, sizeof (Decoder));
+    memset (Coded, GUARD_VALUE, (size_t)(RawLen + GUARD_BYTES));
+    CodedLen = EncodeFiFoSyncBlock (&Encoder, Raw, RawLen, Codings, Coded, &Coding);
+    UNIT_TEST_CHECK_MSG ((CodedLen >= 0) && (CodedLen <= RawLen), "%s codings %u: coded length %i raw length %i",
+                         Name, Codings, CodedLen, RawLen);
+    UNIT_TEST_CHECK_MSG (GuardIntact (Coded, RawLen), "%s codings %u: written behind the raw length", Name, Codings);
+    UNIT_TEST_CHECK_MSG ((Coding & ~Codings) == 0, "%s codings %u: not allowed coding %u used", Name, Codings, Coding);
+
+    Decoded = (uint8_t*)DecodeFiFoSyncBlock (&Decoder, Coded, CodedLen, Coding, RawLen);
+    UNIT_TEST_CHECK_MSG ((Decoded != NULL) && !memcmp (Decoded, Raw, (size_t)RawLen),
+                         "%s codings %u (used %u): decoded block differs", Name, Codings, Coding);
+    // the decoder must not accept a wrong raw length
+    UNIT_TEST_CHECK_MSG (DecodeFiFoSyncBlock (&Decoder, Coded, CodedLen, Coding, RawLen + 1) == NULL,
+                         "%s codings %u: raw length + 1 accepted", Name, Codings);
+    if (RawLen > 0) {
+        UNIT_TEST_CHECK_MSG (DecodeFiFoSyncBlock (&Decoder, Coded, CodedLen, Coding, RawLen - 1) == NULL,
+                             "%s codings %u: raw length - 1 accepted", Name, Codings);
+    }
+    FreeFiFoSyncCoder (&Encoder);
+    FreeFiFoSyncCoder (&Decoder);
+    *ret_CodedLen = CodedLen;
+    *ret_Coding = Coding;
+}
+
+// All truncated blocks must be rejected. A corrupt block can be accepted (there is no checksum)
+// but the decoder must not read or write outside the buffers (visible with address sanitizer builds)
+static void TruncateAndCorrupt (const char *Name, const uint8_t *Coded, int CodedLen, uint32_t Coding, int RawLen)
+{
+    FIFO_SYNC_CODER Decoder;
+    uint8_t *Copy;
+    int Len, x;
+
+    memset (&Decoder, 0, sizeof (Decoder));
+    for (Len = 0; Len < CodedLen; Len += (Len < (CodedLen - 64)) ? (CodedLen / 1000 + 1) : 1) {
+        Copy = (uint8_t*)malloc ((size_t)Len + 1);   // exact size so that overreads are visible with sanitizers
+        memcpy (Copy, Coded, (size_t)Len);
+        UNIT_TEST_CHECK_MSG (DecodeFiFoSyncBlock (&Decoder, Copy, Len, Coding, RawLen) == NULL,
+                             "%s coding %u: block truncated to %i of %i bytes accepted", Name, Coding, Len, CodedLen);
+        free (Copy);
+    }
+    Copy = (uint8_t*)malloc ((size_t)CodedLen + 1);
+    for (x = 0; x < 2000; x++) {
+        int Pos = (CodedLen > 0) ? (int)(Random () % (uint32_t)CodedLen) : 0;
+        memcpy (Copy, Coded, (size_t)CodedLen);
+        if (CodedLen > 0) Copy[Pos] ^= (uint8_t)(1 + Random () % 255);
+        if (DecodeFiFoSyncBlock (&Decoder, Copy, CodedLen, Coding, RawLen) != NULL) CorruptAccepted++;
+    }
+    free (Copy);
+    FreeFiFoSyncCoder (&Decoder);
+}
+
+static void TestBlock (const char *Name, const uint8_t *Raw, int RawLen, uint8_t *Coded)
+{
+    uint32_t Codings;
+    int CodedLen;
+    uint32_t Coding;
+
+    Blocks++;
+    for (Codings = 0; Codings <= FIFO_SYNC_SUPPORTED_CODINGS; Codings++) {
+        RoundTrip (Name, Raw, RawLen, Codings, Coded, &CodedLen, &Coding);
+        TruncateAndCorrupt (Name, Coded, CodedLen, Coding, RawLen);
+    }
+}
+
+int main (int argc, char *argv[])
+{
+    uint8_t *Raw, *Coded;
+    int RawLen, CodedLen;
+    uint32_t Coding;
+    (void)argc; (void)argv;
+
+    Raw = (uint8_t*)malloc (MAX_RAW_LEN);
+    Coded = (uint8_t*)malloc (MAX_RAW_LEN + GUARD_BYTES);
+
+    // typical block must get smaller with each coding
+    RawLen = BuildTypicalBlock (Raw);
+    TestBlock ("typical", Raw, RawLen, Coded);
+    RoundTrip ("typical", Raw, RawLen, FIFO_SYNC_COMPACT_HEADERS, Coded, &CodedLen, &Coding);
+    UNIT_TEST_CHECK ((Coding == FIFO_SYNC_COMPACT_HEADERS) && (CodedLen < RawLen));
+    RoundTrip ("typical", Raw, RawLen, FIFO_SYNC_LZ_COMPRESSION, Coded, &CodedLen, &Coding);
+    UNIT_TEST_CHECK ((Coding == FIFO_SYNC_LZ_COMPRESSION) && (CodedLen < RawLen));
+
+    // compacted headers are larger than the raw headers, the block must be send without compacted headers
+    // and the data are not compressible
+    RawLen = BuildWorstCaseBlock (Raw, 3);
+    TestBlock ("worst case", Raw, RawLen, Coded);
+    RoundTrip ("worst case", Raw, RawLen, FIFO_SYNC_COMPACT_HEADERS, Coded, &CodedLen, &Coding);
+    if (sizeof (FIFO_ENTRY_HEADER) < 29) {
+        UNIT_TEST_CHECK ((Coding == 0) && (CodedLen == RawLen));
+    } else {
+        UNIT_TEST_CHECK ((Coding == FIFO_SYNC_COMPACT_HEADERS) && (CodedLen == RawLen - 3 * ((int)sizeof (FIFO_ENTRY_HEADER) - 29)));
+    }
+
+    RawLen = BuildRandomBlock (Raw);
+    TestBlock ("random", Raw, RawLen, Coded);
+
+    // a single header without data
+    RawLen = AddRecord (Raw, 0, 1, 1, 1, 1, 0, 0);
+    TestBlock ("single", Raw, RawLen, Coded);
+
+    free (Raw);
+    free (Coded);
+    printf ("%i blocks, %i corrupt blocks accepted, %i failed\n", Blocks, CorruptAccepted, UnitTestFailedChecks);
+    return UNIT_TEST_RESULT ();
+}
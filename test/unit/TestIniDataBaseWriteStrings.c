@@ -0,0 +1,129 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "IniDataBase.h"
+#include "UnitTest.h"
+
+// IniFileDataBaseWriteStrings() must give the same INI file as IniFileDataBaseWriteString() called
+// for each entry in the same order: duplicate lines inside the section, the same entry requested
+// more than once, new entrys and new sections.
+
+#define RANDOM_TESTS  500
+#define MAX_REQUESTS  64
+
+static const char *Names[] = {"Single.ini", "Batch.ini"};
+
+static char *ReadWholeFile (const char *par_Name)
+{
+    FILE *fh = fopen (par_Name, "rb");
+    char *Ret;
+    long Size;
+
+    if (fh == NULL) return NULL;
+    fseek (fh, 0, SEEK_END);
+    Size = ftell (fh);
+    fseek (fh, 0, SEEK_SET);
+    Ret = (char*)malloc ((size_t)Size + 1);
+    if (Ret != NULL) {
+        Size = (long)fread (Ret, 1, (size_t)Size, fh);
+        Ret[Size] = 0;
+    }
+    fclose (fh);
+    return Ret;
+}
+
+static void CheckRequests (const char *par_Content, const char *par_Section, const char **par_Entrys, const char **par_Texts, int par_Count)
+{
+    int Fd[2];
+    char *Saved[2];
+    int x, i;
+
+    for (i = 0; i < 2; i++) {
+        FILE *fh = fopen (Names[i], "wt");
+        fputs (par_Content, fh);
+        fclose (fh);
+        Fd[i] = IniFileDataBaseOpen (Names[i]);
+        UNIT_TEST_CHECK (Fd[i] > 0);
+    }
+    for (x = 0; x < par_Count; x++) {
+        IniFileDataBaseWriteString (par_Section, par_Entrys[x], par_Texts[x], Fd[0]);
+    }
+    UNIT_TEST_CHECK (IniFileDataBaseWriteStrings (par_Section, par_Entrys, par_Texts, par_Count, Fd[1]) == 0);
+    for (i = 0; i < 2; i++) {
+        IniFileDataBaseSave (Fd[i], NULL, INIFILE_DATABAE_OPERATION_WRITE_ONLY_WITHOUT_VERSION_INFO);
+        IniFileDataBaseClose (Fd[i]);
+        Saved[i] = ReadWholeFile (Names[i]);
+    }
+    UNIT_TEST_CHECK_MSG ((Saved[0] != NULL) && (Saved[1] != NULL) && !strcmp (Saved[0], Saved[1]),
+                         "section [%s] with %i requests:\n%s\n--- single writes ---\n%s\n--- IniFileDataBaseWriteStrings ---\n%s",
+                         par_Section, par_Count, par_Content, Saved[0], Saved[1]);
+    free (Saved[0]);
+    free (Saved[1]);
+}
+
+static void FixedTests (void)
+{
+    static const char *Content = "[S]\nA=1\nB=2\nA=3\nNoEntry\nb=4\n[T]\nA=5\n";
+    static const char *Entrys[] = {"A", "C", "b", "A", "D", "C", "B"};
+    static const char *Texts[] = {"a1", "c1", "b1", "a2", "d1", "c2", "B1"};
+    int Count;
+
+    for (Count = 1; Count <= (int)(sizeof (Entrys) / sizeof (Entrys[0])); Count++) {
+        CheckRequests (Content, "S", Entrys, Texts, Count);
+        CheckRequests (Content, "T", Entrys, Texts, Count);
+        CheckRequests (Content, "New", Entrys, Texts, Count);
+    }
+}
+
+static void RandomTests (void)
+{
+    static char Content[64 * 1024];
+    static char EntryBuffers[MAX_REQUESTS][16], TextBuffers[MAX_REQUESTS][16];
+    const char *Entrys[MAX_REQUESTS], *Texts[MAX_REQUESTS];
+    int t, x;
+
+    srand (5);
+    for (t = 0; t < RANDOM_TESTS; t++) {
+        int Lines = rand () % 40;
+        int Count = 1 + rand () % MAX_REQUESTS;
+        int Len = sprintf (Content, "[S]\n");
+        // also duplicate lines and names which differ only in the case
+        for (x = 0; x < Lines; x++) {
+            Len += sprintf (Content + Len, "%c%i=old%i\n", (rand () & 1) ? 'E' : 'e', rand () % 30, x);
+        }
+        for (x = 0; x < Count; x++) {
+            sprintf (EntryBuffers[x], "%c%i", (rand () & 1) ? 'E' : 'e', rand () % 40);
+            sprintf (TextBuffers[x], "new%i", x);
+            Entrys[x] = EntryBuffers[x];
+            Texts[x] = TextBuffers[x];
+        }
+        CheckRequests (Content, (rand () % 4) ? "S" : "T", Entrys, Texts, Count);
+    }
+}
+
+int main (void)
+{
+    IniFileDataBaseInit ();
+    FixedTests ();
+    RandomTests ();
+    remove (Names[0]);
+    remove (Names[1]);
+    return UNIT_TEST_RESULT();
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "LatencyHistogram.h"
+#include "UnitTest.h"
+
+// Test of the log-linear latency histogram and the overrun event ring: bucket bounds, relative
+// bucket width, percentiles against exact values, reset, record cost and a concurrent reader
+// while the scheduler thread (one writer) records values and overrun events.
+
+#define RANDOM_VALUES      10000000
+#define PERCENTILE_VALUES  1000000
+#define RECORD_LOOPS       100000000
+#define CONCURRENT_SECONDS 1.0
+
+static LATENCY_HISTOGRAM Histogram;
+static OVERRUN_EVENT_RING Ring;
+static volatile int StopWriter;
+
+static double Now (void)
+{
+    struct timespec t;
+    clock_gettime (CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static int CompareValues (const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x < y) ? -1 : (x > y);
+}
+
+static uint64_t RandomValue (void)
+{
+    return ((((uint64_t)rand () << 31) | (uint64_t)rand ()) >> (rand () % 62));
+}
+
+static void CheckBuckets (void)
+{
+    uint64_t LastLower = LatencyHistogramBucketLowerBound (LATENCY_HISTOGRAM_BUCKETS - 1);
+    int x;
+
+    for (x = 0; x < (LATENCY_HISTOGRAM_BUCKETS - 1); x++) {
+        uint64_t Lower = LatencyHistogramBucketLowerBound (x);
+        uint64_t Upper = LatencyHistogramBucketUpperBound (x);
+        UNIT_TEST_CHECK_MSG ((LatencyHistogramBucketIndex (Lower) == x) && (LatencyHistogramBucketIndex (Upper) == x) &&
+                             ((Upper + 1) == LatencyHistogramBucketLowerBound (x + 1)), "bucket %i: %llu...%llu", x,
+                             (unsigned long long)Lower, (unsigned long long)Upper);
+    }
+    // all values from 2^LATENCY_HISTOGRAM_MAX_VALUE_BITS are counted inside the last bucket
+    UNIT_TEST_CHECK (LastLower <= (1ULL << LATENCY_HISTOGRAM_MAX_VALUE_BITS));
+    UNIT_TEST_CHECK (LatencyHistogramBucketIndex (1ULL << LATENCY_HISTOGRAM_MAX_VALUE_BITS) == (LATENCY_HISTOGRAM_BUCKETS - 1));
+    UNIT_TEST_CHECK (LatencyHistogramBucketIndex (UINT64_MAX) == (LATENCY_HISTOGRAM_BUCKETS - 1));
+
+    srand (1);
+    for (x = 0; x < RANDOM_VALUES; x++) {
+        uint64_t Value = RandomValue ();
+        int Index = LatencyHistogramBucketIndex (Value);
+        if (Index < (LATENCY_HISTOGRAM_BUCKETS - 1)) {
+            uint64_t Lower = LatencyHistogramBucketLowerBound (Index);
+            uint64_t Upper = LatencyHistogramBucketUpperBound (Index);
+            if ((Value < Lower) || (Value > Upper) ||
+                ((Value >= (1 << LATENCY_HISTOGRAM_SUB_BUCKET_BITS)) &&
+                 ((double)(Upper - Lower) / (double)Lower > 1.0 / (1 << (LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1))))) {
+                UNIT_TEST_CHECK_MSG (0, "value %llu inside bucket %i: %llu...%llu", (unsigned long long)Value, Index,
+                                     (unsigned long long)Lower, (unsigned long long)Upper);
+                break;
+            }
+        } else if (Value < LastLower) {
+            UNIT_TEST_CHECK_MSG (0, "value %llu inside the last bucket", (unsigned long long)Value);
+            break;
+        }
+    }
+}
+
+// log-normal distributed values against the exact percentiles
+static void CheckPercentiles (void)
+{
+    static const double Percentiles[] = {0.0, 50.0, 90.0, 99.0, 99.9, 99.99, 100.0};
+    uint64_t *Values = (uint64_t*)malloc (PERCENTILE_VALUES * sizeof (uint64_t));
+    char Buffer[16 * 1024];
+    int x;
+
+    InitLatencyHistogram (&Histogram);
+    UNIT_TEST_CHECK (LatencyHistogramPercentile (&Histogram, 50.0) == 0);
+    for (x = 0; x < PERCENTILE_VALUES; x++) {
+        double u1 = (rand () + 1.0) / ((double)RAND_MAX + 1.0);
+        double u2 = rand () / (double)RAND_MAX;
+        double Gauss = sqrt (-2.0 * log (u1)) * cos (2.0 * 3.14159265358979323846 * u2);
+        Values[x] = (uint64_t)(20000.0 * exp (0.8 * Gauss));
+        LatencyHistogramRecord (&Histogram, Values[x]);
+    }
+    qsort (Values, PERCENTILE_VALUES, sizeof (uint64_t), CompareValues);
+    for (x = 0; x < (int)(sizeof (Percentiles) / sizeof (Percentiles[0])); x++) {
+        size_t Pos = (size_t)ceil (Percentiles[x] / 100.0 * PERCENTILE_VALUES);
+        uint64_t Exact = Values[(Pos > 0) ? Pos - 1 : 0];
+        uint64_t Value = LatencyHistogramPercentile (&Histogram, Percentiles[x]);
+        double Error = fabs ((double)Value - (double)Exact) / (double)Exact;
+        UNIT_TEST_CHECK_MSG ((Value >= Exact) && (Error <= 1.0 / (1 << (LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1))),
+                             "p%g: %llu (exact %llu)", Percentiles[x], (unsigned long long)Value, (unsigned long long)Exact);
+    }
+    UNIT_TEST_CHECK ((Histogram.Min == Values[0]) && (Histogram.Max == Values[PERCENTILE_VALUES - 1]) &&
+                     (Histogram.TotalCount == PERCENTILE_VALUES));
+    UNIT_TEST_CHECK (LatencyHistogramToString (&Histogram, "test", Buffer, sizeof (Buffer)) < (int)sizeof (Buffer));
+    UNIT_TEST_CHECK (strncmp (Buffer, "test: count=1000000 ", 20) == 0);
+
+    // the reset will be done with the next record
+    LatencyHistogramRequestReset (&Histogram);
+    UNIT_TEST_CHECK (Histogram.TotalCount == PERCENTILE_VALUES);
+    LatencyHistogramRecord (&Histogram, 5);
+    UNIT_TEST_CHECK ((Histogram.TotalCount == 1) && (Histogram.Min == 5) && (Histogram.Max == 5) && (Histogram.Sum == 5));
+    UNIT_TEST_CHECK (LatencyHistogramPercentile (&Histogram, 99.0) == 5);
+    free (Values);
+}
+
+static void MeasureRecordCost (void)
+{
+    double Start;
+    int x;
+
+    InitLatencyHistogram (&Histogram);
+    Start = Now ();
+    for (x = 0; x < RECORD_LOOPS; x++) {
+        LatencyHistogramRecord (&Histogram, ((uint64_t)x * 2654435761u) % 5000000);
+    }
+    printf ("record: %.2f ns\n", (Now () - Start) * 1e9 / RECORD_LOOPS);
+    UNIT_TEST_CHECK (Histogram.TotalCount == RECORD_LOOPS);
+}
+
+static void *WriterThread (void *par_Arg)
+{
+    uint64_t Cycle = 0;
+    (void)par_Arg;
+
+    while (!StopWriter) {
+        LatencyHistogramRecord (&Histogram, (Cycle * 7919) % 100000);
+        AddOverrunEvent (&Ring, Cycle, Cycle, Cycle, 1);
+        Cycle++;
+    }
+    return NULL;
+}
+
+static void CheckConcurrentReader (void)
+{
+    static OVERRUN_EVENT Events[OVERRUN_EVENT_RING_SIZE];
+    pthread_t Writer;
+    double Start;
+    long Reads = 0, Torn = 0, Gaps = 0, TooLarge = 0;
+
+    InitLatencyHistogram (&Histogram);
+    memset (&Ring, 0, sizeof (Ring));
+    StopWriter = 0;
+    pthread_create (&Writer, NULL, WriterThread, NULL);
+    Start = Now ();
+    while ((Now () - Start) < CONCURRENT_SECONDS) {
+        int Count, x;
+        // all values are below 100000, the largest bucket upper bound is 100351
+        if (LatencyHistogramPercentile (&Histogram, 99.0) > LatencyHistogramBucketUpperBound (LatencyHistogramBucketIndex (100000))) TooLarge++;
+        Count = GetOverrunEvents (&Ring, Events, OVERRUN_EVENT_RING_SIZE);
+        for (x = 0; x < Count; x++) {
+            if ((Events[x].Cycle != Events[x].TimeStamp) || (Events[x].Cycle != Events[x].Duration)) Torn++;
+            if ((x > 0) && (Events[x].Cycle != (Events[x - 1].Cycle + 1))) Gaps++;
+        }
+        if ((Reads++ & 1023) == 0) LatencyHistogramRequestReset (&Histogram);
+    }
+    StopWriter = 1;
+    pthread_join (Writer, NULL);
+    printf ("concurrent: %li reads, %u overrun events\n", Reads, GetOverrunEventCount (&Ring));
+    UNIT_TEST_CHECK_MSG ((Torn == 0) && (Gaps == 0) && (TooLarge == 0), "%li torn events, %li gaps, %li too large percentiles",
+                         Torn, Gaps, TooLarge);
+}
+
+static void CheckOverrunRing (void)
+{
+    static OVERRUN_EVENT Events[OVERRUN_EVENT_RING_SIZE];
+    int x, Count;
+
+    memset (&Ring, 0, sizeof (Ring));
+    UNIT_TEST_CHECK (GetOverrunEvents (&Ring, Events, OVERRUN_EVENT_RING_SIZE) == 0);
+    for (x = 0; x < 10; x++) AddOverrunEvent (&Ring, x, 100 + x, 200 + x, (x & 1) ? -1 : x);
+    Count = GetOverrunEvents (&Ring, Events, 4);
+    UNIT_TEST_CHECK ((Count == 4) && (Events[0].Cycle == 6) && (Events[3].Cycle == 9) && (Events[3].Pid == -1));
+    for (x = 10; x < 200; x++) AddOverrunEvent (&Ring, x, 100 + x, 200 + x, x);
+    Count = GetOverrunEvents (&Ring, Events, OVERRUN_EVENT_RING_SIZE);
+    // the slot behind the write position can be overwritten during the copy
+    UNIT_TEST_CHECK ((Count == OVERRUN_EVENT_RING_SIZE - 1) && (Events[0].Cycle == (uint64_t)(200 - Count)) &&
+                     (Events[Count - 1].Cycle == 199) && (Events[Count - 1].TimeStamp == 299));
+    UNIT_TEST_CHECK (GetOverrunEventCount (&Ring) == 200);
+}
+
+int main (void)
+{
+    CheckBuckets ();
+    CheckPercentiles ();
+    CheckOverrunRing ();
+    MeasureRecordCost ();
+    CheckConcurrentReader ();
+    return UNIT_TEST_RESULT();
+}
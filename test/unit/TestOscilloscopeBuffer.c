@@ -0,0 +1,215 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "OscilloscopeData.h"
+#include "OscilloscopeBuffer.h"
+#include "OscilloscopeLod.h"
+#include "UnitTest.h"
+
+// Test of the typed oscilloscope ring buffer: each widening step (8 -> 16 -> 32 bit -> float -> double),
+// NaN inside integer buffers, ring wrap around with buffers of 1024 and 4099 samples and the min./max.
+// pyramid (OscilloscopeLodMinMaxOfTimeRange()) on top of the typed buffers against a linear search.
+
+#define T_STEP        10000000ULL   // 10ms
+#define WRITE_LOOPS   5
+#define RANGE_CHECKS  20
+
+static long Checks;
+
+static int SameValue (double a, double b)
+{
+    return (isnan (a) && isnan (b)) || (a == b);
+}
+
+static void CompareBuffer (OSCILLOSCOPE_BUFFER *par_Buffer, const double *par_Reference, const char *par_What)
+{
+    int x;
+
+    for (x = 0; x < par_Buffer->depth; x++) {
+        double Value = OscilloscopeBufferRead (par_Buffer, x, (double)NAN);
+        if (!SameValue (Value, par_Reference[x])) {
+            UNIT_TEST_CHECK_MSG (0, "%s: sample %i is %g not %g (type %i)", par_What, x, Value, par_Reference[x], par_Buffer->type);
+            return;
+        }
+    }
+    Checks++;
+}
+
+// The buffer is widened only to a type which can store all values without loss
+static void CheckWidening (void)
+{
+    static const struct {
+        double Value;
+        int Type;
+    } Steps[][6] = {
+        {{1.0, OSCILLOSCOPE_BUFFER_UBYTE}, {255.0, OSCILLOSCOPE_BUFFER_UBYTE}, {-1.0, OSCILLOSCOPE_BUFFER_WORD},
+         {40000.0, OSCILLOSCOPE_BUFFER_DWORD}, {0.5, OSCILLOSCOPE_BUFFER_DOUBLE}, {1e300, OSCILLOSCOPE_BUFFER_DOUBLE}},
+        {{-128.0, OSCILLOSCOPE_BUFFER_WORD}, {127.0, OSCILLOSCOPE_BUFFER_WORD}, {-32768.0, OSCILLOSCOPE_BUFFER_WORD},
+         {0.25, OSCILLOSCOPE_BUFFER_FLOAT}, {-2147483647.0, OSCILLOSCOPE_BUFFER_DOUBLE}, {0.1, OSCILLOSCOPE_BUFFER_DOUBLE}},
+        {{256.0, OSCILLOSCOPE_BUFFER_UWORD}, {65535.0, OSCILLOSCOPE_BUFFER_UWORD}, {65536.0, OSCILLOSCOPE_BUFFER_UDWORD},
+         {4294967295.0, OSCILLOSCOPE_BUFFER_UDWORD}, {-1.0, OSCILLOSCOPE_BUFFER_DOUBLE}, {2.0, OSCILLOSCOPE_BUFFER_DOUBLE}},
+        {{1.5, OSCILLOSCOPE_BUFFER_FLOAT}, {-3.0, OSCILLOSCOPE_BUFFER_FLOAT}, {(double)INFINITY, OSCILLOSCOPE_BUFFER_FLOAT},
+         {16777217.0, OSCILLOSCOPE_BUFFER_DOUBLE}, {(double)NAN, OSCILLOSCOPE_BUFFER_DOUBLE}, {0.0, OSCILLOSCOPE_BUFFER_DOUBLE}},
+        {{(double)NAN, OSCILLOSCOPE_BUFFER_UBYTE}, {100.0, OSCILLOSCOPE_BUFFER_UBYTE}, {-100.0, OSCILLOSCOPE_BUFFER_WORD},
+         {(double)NAN, OSCILLOSCOPE_BUFFER_WORD}, {70000.0, OSCILLOSCOPE_BUFFER_DWORD}, {0.75, OSCILLOSCOPE_BUFFER_DOUBLE}},
+        {{2147483647.0, OSCILLOSCOPE_BUFFER_UDWORD}, {-2147483648.0, OSCILLOSCOPE_BUFFER_DOUBLE}, {1.0, OSCILLOSCOPE_BUFFER_DOUBLE},
+         {1.0, OSCILLOSCOPE_BUFFER_DOUBLE}, {1.0, OSCILLOSCOPE_BUFFER_DOUBLE}, {1.0, OSCILLOSCOPE_BUFFER_DOUBLE}}
+    };
+    int s, x;
+
+    for (s = 0; s < (int)(sizeof (Steps) / sizeof (Steps[0])); s++) {
+        OSCILLOSCOPE_BUFFER *Buffer = OscilloscopeBufferAlloc (16);
+        double Reference[16] = {0.0};
+        UNIT_TEST_CHECK ((Buffer != NULL) && (Buffer->type == OSCILLOSCOPE_BUFFER_UBYTE) && (Buffer->invalid == NULL));
+        if (Buffer == NULL) continue;
+        for (x = 0; x < 6; x++) {
+            OscilloscopeBufferWrite (Buffer, x, Steps[s][x].Value);
+            Reference[x] = Steps[s][x].Value;
+            UNIT_TEST_CHECK_MSG (Buffer->type == Steps[s][x].Type, "sequence %i step %i: type %i not %i", s, x, Buffer->type, Steps[s][x].Type);
+            if (isnan (Steps[s][x].Value)) UNIT_TEST_CHECK ((Buffer->invalid != NULL) == (Buffer->type < OSCILLOSCOPE_BUFFER_FLOAT));
+            CompareBuffer (Buffer, Reference, "widening");
+        }
+        // the bit field exists only while an integer buffer has NaN values
+        UNIT_TEST_CHECK ((Buffer->invalid == NULL) || (Buffer->type < OSCILLOSCOPE_BUFFER_FLOAT));
+        // a valid value clears the mark
+        OscilloscopeBufferWrite (Buffer, 0, 1.0);
+        Reference[0] = 1.0;
+        CompareBuffer (Buffer, Reference, "overwrite");
+        OscilloscopeBufferFree (Buffer);
+    }
+}
+
+typedef enum {BOOLEAN, BYTES, WORDS, WITH_NAN, FLOATS, DOUBLES} VALUE_CLASS;
+
+static double RandomValue (VALUE_CLASS par_Class)
+{
+    switch (par_Class) {
+    case BOOLEAN:
+        return (double)(rand () & 1);
+    case BYTES:
+        return (double)((rand () & 0xFF) - 100);
+    case WORDS:
+        return (double)((rand () & 0xFFFF) - 1000);
+    case WITH_NAN:
+        return ((rand () % 7) == 0) ? (double)NAN : (double)(rand () % 1000);
+    case FLOATS:
+        return (double)(float)((rand () % 10000) * 0.25);
+    default:
+        return (rand () % 100000) * 0.001 - 20.0;
+    }
+}
+
+// Min./max. of the time range with a linear search (same time mapping as OscilloscopeLodMinMaxOfTimeRange())
+static int ReferenceMinMax (OSCILLOSCOPE_DATA *par_Data, const double *par_Reference, uint64_t par_tFrom, uint64_t par_tTo,
+                            double *ret_Min, double *ret_Max)
+{
+    int Depth = par_Data->depth_left[0];
+    int BufferDepth = par_Data->buffer_left[0]->depth;
+    int Wr = par_Data->wr_poi_left[0];
+    int64_t nLo, nHi, n;
+    int Found = 0;
+
+    if (par_tFrom > par_Data->t_current_to_update_end) return 0;
+    nHi = (int64_t)((par_Data->t_current_to_update_end - par_tFrom) / par_Data->t_step);
+    if (par_tTo >= par_Data->t_current_to_update_end) nLo = 0;
+    else nLo = (int64_t)((par_Data->t_current_to_update_end - par_tTo) / par_Data->t_step);
+    if (nHi >= Depth) nHi = Depth - 1;
+    for (n = nLo; n <= nHi; n++) {
+        double Value = par_Reference[((Wr - 1 - (int)n) % BufferDepth + BufferDepth) % BufferDepth];
+        if (isnan (Value)) continue;
+        if (!Found || (Value < *ret_Min)) *ret_Min = Value;
+        if (!Found || (Value > *ret_Max)) *ret_Max = Value;
+        Found = 1;
+    }
+    return Found;
+}
+
+static void CheckTimeRanges (OSCILLOSCOPE_DATA *par_Data, const double *par_Reference)
+{
+    int x;
+
+    for (x = 0; x < RANGE_CHECKS; x++) {
+        uint64_t Span = T_STEP * (uint64_t)(1 + rand () % (2 * par_Data->buffer_depth));
+        uint64_t tTo = par_Data->t_current_to_update_end + T_STEP - (uint64_t)(rand () % (3 * par_Data->buffer_depth)) * (T_STEP / 2);
+        uint64_t tFrom = (tTo > Span) ? tTo - Span : 0;
+        double Min = 0.0, Max = 0.0, RefMin = 0.0, RefMax = 0.0;
+        int Ret = OscilloscopeLodMinMaxOfTimeRange (par_Data, 0, 0, tFrom, tTo, &Min, &Max);
+        int RefRet = ReferenceMinMax (par_Data, par_Reference, tFrom, tTo, &RefMin, &RefMax);
+        if ((Ret != RefRet) || (Ret && ((Min != RefMin) || (Max != RefMax)))) {
+            UNIT_TEST_CHECK_MSG (0, "depth %i type %i range %llu...%llu: %i %g...%g not %i %g...%g", par_Data->buffer_depth,
+                                 par_Data->buffer_left[0]->type, (unsigned long long)tFrom, (unsigned long long)tTo,
+                                 Ret, Min, Max, RefRet, RefMin, RefMax);
+            return;
+        }
+        Checks++;
+    }
+}
+
+// Write samples the same way as stamp2oszibuffers() with growing value classes, so the ring is widened during the wrap around
+static void CheckRingBuffer (int par_Depth)
+{
+    static OSCILLOSCOPE_DATA Data;
+    double *Reference = (double*)calloc ((size_t)par_Depth, sizeof (double));
+    OSCILLOSCOPE_BUFFER *Buffer = OscilloscopeBufferAlloc (par_Depth);
+    int Class, Loop, x;
+
+    memset (&Data, 0, sizeof (Data));
+    Data.buffer_depth = par_Depth;
+    Data.buffer_left[0] = Buffer;
+    Data.t_step = T_STEP;
+    Data.t_current_to_update_end = 1000 * T_STEP;
+    for (Class = BOOLEAN; Class <= DOUBLES; Class++) {
+        for (Loop = 0; Loop < WRITE_LOOPS; Loop++) {
+            // not a multiple of the depth, so each class starts at another position
+            int Count = par_Depth / 3 + rand () % par_Depth;
+            for (x = 0; x < Count; x++) {
+                int Wr = Data.wr_poi_left[0];
+                double Value = RandomValue ((VALUE_CLASS)Class);
+                OscilloscopeBufferWrite (Buffer, Wr, Value);
+                OscilloscopeLodAddSample (Buffer, Wr, Value);
+                Reference[Wr] = Value;
+                Data.wr_poi_left[0] = (Wr + 1 < par_Depth) ? Wr + 1 : 0;
+                if (Data.depth_left[0] < par_Depth) Data.depth_left[0]++;
+                Data.t_current_to_update_end += T_STEP;
+                if ((x % 97) == 0) CheckTimeRanges (&Data, Reference);
+            }
+            CompareBuffer (Buffer, Reference, "ring");
+            CheckTimeRanges (&Data, Reference);
+        }
+    }
+    UNIT_TEST_CHECK (Buffer->type == OSCILLOSCOPE_BUFFER_DOUBLE);
+
+    // resize keeps the element type, the pyramid will be rebuild with the next sample
+    UNIT_TEST_CHECK (OscilloscopeBufferResize (Buffer, par_Depth / 2) == 0);
+    UNIT_TEST_CHECK ((Buffer->type == OSCILLOSCOPE_BUFFER_DOUBLE) && (Buffer->depth == par_Depth / 2));
+    free (Reference);
+    OscilloscopeBufferFree (Buffer);
+}
+
+int main (void)
+{
+    srand (1);
+    CheckWidening ();
+    CheckRingBuffer (1024);
+    CheckRingBuffer (4099);
+    printf ("%li checks, %i failed\n", Checks, UnitTestFailedChecks);
+    return UNIT_TEST_RESULT();
+}
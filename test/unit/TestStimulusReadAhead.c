@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "Platform.h"
+#include "StimulusReadAhead.h"
+#include "UnitTest.h"
+
+// Test of the stimulus read ahead ring with a fake stimulus file: the reads of the file
+// will be delayed from time to time (like a page cache miss). The consumer must get all
+// time slots in the right order, an empty ring must be counted as underrun.
+
+#define VARIABLES      50
+#define TIME_SLOTS     20000
+#define STALL_EVERY    5000
+#define STALL_MS       30
+
+static uint32_t TimeSlotCounter;
+static int InjectDelay;
+
+int ReadOneStimuliTimeSlot (STIMULI_FILE *par_File, VARI_IN_PIPE *ret_Values, uint64_t *ret_Time)
+{
+    int x;
+    (void)par_File;
+
+    if (TimeSlotCounter >= TIME_SLOTS) return STIMULI_END_OF_FILE;
+    if (InjectDelay && (TimeSlotCounter > 0) && ((TimeSlotCounter % STALL_EVERY) == 0)) {
+        Sleep (STALL_MS);
+    }
+    for (x = 0; x < VARIABLES; x++) {
+        ret_Values[x].vid = x + 1;
+        ret_Values[x].type = BB_DOUBLE;
+        ret_Values[x].value.d = (double)TimeSlotCounter * VARIABLES + x;
+    }
+    *ret_Time = (uint64_t)TimeSlotCounter * 100000;
+    TimeSlotCounter++;
+    return VARIABLES;
+}
+
+static void PlayAll (int par_SlotCount, int par_InjectDelay, uint64_t *ret_Underruns)
+{
+    STIMULI_READ_AHEAD *ReadAhead;
+    uint32_t Expected = 0;
+    int Wrong = 0;
+
+    TimeSlotCounter = 0;
+    InjectDelay = par_InjectDelay;
+    ReadAhead = StartStimuliReadAhead ((STIMULI_FILE*)1, VARIABLES, par_SlotCount);
+    UNIT_TEST_CHECK (ReadAhead != NULL);
+    if (ReadAhead == NULL) return;
+    UNIT_TEST_CHECK (WaitForStimuliReadAhead (ReadAhead, (int)(ReadAhead->SlotCount >> 1), 1000) == 0);
+
+    for (;;) {
+        VARI_IN_PIPE *Values;
+        uint64_t Time;
+        int Ret = PeekStimuliReadAhead (ReadAhead, &Values, &Time);
+        if (Ret == STIMULI_READ_AHEAD_EMPTY) {
+            Sleep (1);
+            continue;
+        }
+        if (Ret == STIMULI_END_OF_FILE) break;
+        if ((Ret != VARIABLES) ||
+            (Time != (uint64_t)Expected * 100000) ||
+            (Values[0].value.d != (double)Expected * VARIABLES) ||
+            (Values[VARIABLES - 1].value.d != (double)Expected * VARIABLES + VARIABLES - 1)) {
+            Wrong++;
+        }
+        Expected++;
+        ReleaseStimuliReadAhead (ReadAhead);
+    }
+    UNIT_TEST_CHECK_MSG (Expected == TIME_SLOTS, "%u time slots instead of %u", Expected, TIME_SLOTS);
+    UNIT_TEST_CHECK_MSG (Wrong == 0, "%i wrong time slots", Wrong);
+    *ret_Underruns = ReadAhead->Underruns;
+    StopStimuliReadAhead (ReadAhead);
+}
+
+int main (void)
+{
+    STIMULI_READ_AHEAD *ReadAhead;
+    uint64_t Underruns;
+    uint32_t MaxSlots;
+
+    // Without delay the consumer can only be faster than the worker thread, but all slots must arrive
+    PlayAll (64, 0, &Underruns);
+
+    // A small ring cannot bridge the injected delays, the consumer must see underruns
+    PlayAll (16, 1, &Underruns);
+    UNIT_TEST_CHECK_MSG (Underruns >= (TIME_SLOTS / STALL_EVERY - 1), "only %llu underruns", (unsigned long long)Underruns);
+
+    // The slot count is 2^n
+    ReadAhead = StartStimuliReadAhead ((STIMULI_FILE*)1, VARIABLES, 1000);
+    UNIT_TEST_CHECK ((ReadAhead != NULL) && (ReadAhead->SlotCount == 512));
+    StopStimuliReadAhead (ReadAhead);
+
+    // The memory limit is also valid if less than 16 slots fit into it
+    MaxSlots = 5;
+    TimeSlotCounter = TIME_SLOTS;   // file end
+    ReadAhead = StartStimuliReadAhead ((STIMULI_FILE*)1, (int)(STIMULI_READ_AHEAD_MAX_MEMORY / sizeof (VARI_IN_PIPE) / MaxSlots), 0);
+    UNIT_TEST_CHECK (ReadAhead != NULL);
+    if (ReadAhead != NULL) {
+        UNIT_TEST_CHECK_MSG (ReadAhead->SlotCount == 4, "%u slots", ReadAhead->SlotCount);
+        UNIT_TEST_CHECK ((size_t)ReadAhead->SlotCount * (size_t)ReadAhead->VariCount * sizeof (VARI_IN_PIPE) <= STIMULI_READ_AHEAD_MAX_MEMORY);
+        StopStimuliReadAhead (ReadAhead);
+    }
+    // A single time slot is larger than the half of the limit
+    ReadAhead = StartStimuliReadAhead ((STIMULI_FILE*)1, (int)(STIMULI_READ_AHEAD_MAX_MEMORY / sizeof (VARI_IN_PIPE)), 0);
+    UNIT_TEST_CHECK (ReadAhead == NULL);
+
+    return UNIT_TEST_RESULT();
+}
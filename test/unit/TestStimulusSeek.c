@@ -0,0 +1,482 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <zlib.h>
+
+#include "Files.h"
+#include "MainValues.h"
+#include "Scheduler.h"
+#include "EnvironmentVariables.h"
+#include "ReadFromBlackboardPipe.h"
+#include "StimulusReadFile.h"
+#include "StimulusReadMdf4File.h"
+#include "StimulusReadMdfFile.h"
+#include "StimulusReadDatFile.h"
+#include "Mdf4Structs.h"
+#include "MdfStructs.h"
+#include "UnitTest.h"
+
+// Seeking inside MDF4, MDF3 and DAT stimulus files (Mdf4SeekStimuliFile(), MdfSeekStimuliFile() and
+// DatSeekStimuliFile()). The files are generated with a record index as value and some time slots
+// with the same time. After a seek to each time slot, one tick before and one tick behind, the next
+// time slots must be the same as reading the file from the beginning (the first one not before the seek time).
+
+#define RECORDS      3000
+#define READ_SLOTS   3
+#define MAX_VARIS    4
+
+// Blackboard and file functions used by the stimulus file readers
+
+MAIN_INI_VAL s_main_ini_val;
+
+static enum BB_DATA_TYPES VariableTypes[64];
+static int VariableCount;
+
+VID add_bbvari (const char *name, enum BB_DATA_TYPES type, const char *unit)
+{
+    (void)name; (void)unit;
+    if (VariableCount >= 63) return -1;
+    VariableCount++;
+    VariableTypes[VariableCount] = (type >= BB_UNKNOWN) ? BB_DOUBLE : type;
+    return VariableCount;
+}
+
+int get_bbvaritype (VID vid)
+{
+    return VariableTypes[vid];
+}
+
+int set_bbvari_unit (VID vid, const char *unit) { (void)vid; (void)unit; return 0; }
+int set_bbvari_conversion (VID vid, int convtype, const char *conversion) { (void)vid; (void)convtype; (void)conversion; return 0; }
+int set_bbvari_min (VID vid, double min) { (void)vid; (void)min; return 0; }
+int set_bbvari_max (VID vid, double max) { (void)vid; (void)max; return 0; }
+int set_bbvari_format (VID vid, int width, int prec) { (void)vid; (void)width; (void)prec; return 0; }
+
+int GetCurrentPid (void)
+{
+    return 1;
+}
+
+int SearchAndReplaceEnvironmentStrings (const char *src, char *dest, int maxc)
+{
+    strncpy (dest, src, (size_t)maxc);
+    dest[maxc - 1] = 0;
+    return (int)strlen (dest) + 1;
+}
+
+// Time of a record in seconds, every 13th has the same time as the one before
+static double RecordTime (int par_Record)
+{
+    return 10.0 + 0.001 * (par_Record - ((par_Record % 13) == 1));
+}
+
+// Generate stimulus files
+
+static FILE *fh;
+static uint64_t FilePos;
+
+static uint64_t Write (const void *par_Data, uint64_t par_Size)
+{
+    uint64_t Ret = FilePos;
+    fwrite (par_Data, 1, (size_t)par_Size, fh);
+    FilePos += par_Size;
+    return Ret;
+}
+
+static uint64_t WriteMdf4BlockHeader (const char *par_Id, uint64_t par_Size, uint64_t par_LinkCount)
+{
+    static const char Zeros[8];
+    MDF4_BLOCK_HEADER Header;
+
+    if (FilePos & 7) Write (Zeros, 8 - (FilePos & 7));
+    memset (&Header, 0, sizeof (Header));
+    memcpy (Header.BlockTypeIdentifier, par_Id, 4);
+    Header.BlockLength = par_Size;
+    Header.LinkCount = par_LinkCount;
+    return Write (&Header, sizeof (Header));
+}
+
+static uint64_t WriteMdf4Text (const char *par_Text)
+{
+    uint64_t Len = strlen (par_Text) + 1;
+    uint64_t Ret = WriteMdf4BlockHeader ("##TX", sizeof (MDF4_BLOCK_HEADER) + Len, 0);
+    Write (par_Text, Len);
+    return Ret;
+}
+
+// One data group with a time and a value channel (both double). The record stream is splitted into DT blocks
+// of par_BlockSize bytes (records are crossing the block borders) or into DZ blocks with par_BlockSize records
+static void GenerateMdf4File (const char *par_Name, int par_BlockSize, int par_Compressed)
+{
+    const int RecordSize = 2 * (int)sizeof (double);
+    uint64_t StreamSize = (uint64_t)RECORDS * RecordSize;
+    unsigned char *Stream = (unsigned char*)malloc (StreamSize);
+    uint64_t *Blocks = (uint64_t*)malloc (sizeof (uint64_t) * (RECORDS + 1));
+    uint64_t HeaderLinks[6] = {0};
+    uint64_t HeaderLinksPos, DataListPos, ChannelGroupPos, DataGroupPos, Next = 0;
+    MDF4_IDBLOCK IdBlock;
+    MDF4_HDBLOCK HdBlock;
+    MDF4_DLBLOCK DlBlock;
+    MDF4_CGBLOCK CgBlock;
+    MDF4_DGBLOCK DgBlock;
+    uint64_t Pos, Zero = 0;
+    int r, c, NoOfBlocks = 0;
+
+    for (r = 0; r < RECORDS; r++) {
+        double Values[2];
+        Values[0] = RecordTime (r);
+        Values[1] = r;
+        memcpy (Stream + (uint64_t)r * RecordSize, Values, sizeof (Values));
+    }
+    fh = fopen (par_Name, "wb");
+    FilePos = 0;
+    memset (&IdBlock, 0, sizeof (IdBlock));
+    memcpy (IdBlock.FileIdentifier, "MDF     ", 8);
+    memcpy (IdBlock.FormatTdentifier, "4.10    ", 8);
+    IdBlock.VersionNumber = 410;
+    Write (&IdBlock, sizeof (IdBlock));
+    WriteMdf4BlockHeader ("##HD", sizeof (MDF4_BLOCK_HEADER) + sizeof (HeaderLinks) + sizeof (HdBlock), 6);
+    HeaderLinksPos = Write (HeaderLinks, sizeof (HeaderLinks));
+    memset (&HdBlock, 0, sizeof (HdBlock));
+    Write (&HdBlock, sizeof (HdBlock));
+
+    for (Pos = 0; Pos < StreamSize; ) {
+        if (par_Compressed) {
+            // transposed and deflated
+            uint64_t Len = (uint64_t)par_BlockSize * RecordSize;
+            unsigned char *Transposed, *Deflated;
+            uLongf DeflatedLen;
+            MDF4_DZBLOCK DzBlock;
+            int Records;
+            if (Len > StreamSize - Pos) Len = StreamSize - Pos;
+            Records = (int)(Len / RecordSize);
+            Transposed = (unsigned char*)malloc (Len);
+            Deflated = (unsigned char*)malloc (compressBound (Len));
+            for (c = 0; c < RecordSize; c++) {
+                for (r = 0; r < Records; r++) {
+                    Transposed[c * Records + r] = Stream[Pos + (uint64_t)r * RecordSize + c];
+                }
+            }
+            DeflatedLen = compressBound (Len);
+            compress2 (Deflated, &DeflatedLen, Transposed, Len, 1);
+            memset (&DzBlock, 0, sizeof (DzBlock));
+            memcpy (DzBlock.OrigBlockTypeIdentifier, "DT", 2);
+            DzBlock.Type = 1;
+            DzBlock.Parameter = RecordSize;
+            DzBlock.OrigDataLength = Len;
+            DzBlock.DataLength = DeflatedLen;
+            Blocks[NoOfBlocks++] = WriteMdf4BlockHeader ("##DZ", sizeof (MDF4_BLOCK_HEADER) + sizeof (DzBlock) + DeflatedLen, 0);
+            Write (&DzBlock, sizeof (DzBlock));
+            Write (Deflated, DeflatedLen);
+            free (Transposed);
+            free (Deflated);
+            Pos += Len;
+        } else {
+            uint64_t Len = (uint64_t)par_BlockSize;
+            if (Len > StreamSize - Pos) Len = StreamSize - Pos;
+            Blocks[NoOfBlocks++] = WriteMdf4BlockHeader ("##DT", sizeof (MDF4_BLOCK_HEADER) + Len, 0);
+            Write (Stream + Pos, Len);
+            Pos += Len;
+        }
+    }
+    DataListPos = WriteMdf4BlockHeader ("##DL", sizeof (MDF4_BLOCK_HEADER) + sizeof (uint64_t) * (1 + (uint64_t)NoOfBlocks) + sizeof (DlBlock),
+                                        1 + (uint64_t)NoOfBlocks);
+    Write (&Zero, sizeof (Zero));
+    Write (Blocks, sizeof (uint64_t) * (uint64_t)NoOfBlocks);
+    memset (&DlBlock, 0, sizeof (DlBlock));
+    DlBlock.NoOfBlocks = (uint32_t)NoOfBlocks;
+    Write (&DlBlock, sizeof (DlBlock));
+
+    // channels are linked backwards
+    for (c = 1; c >= 0; c--) {
+        uint64_t NamePos = WriteMdf4Text (c ? "Val" : "time");
+        uint64_t Links[8] = {0};
+        uint64_t ChannelPos = WriteMdf4BlockHeader ("##CN", sizeof (MDF4_BLOCK_HEADER) + sizeof (Links) + sizeof (MDF4_CNBLOCK), 8);
+        MDF4_CNBLOCK CnBlock;
+        Links[0] = Next;
+        Links[2] = NamePos;
+        Write (Links, sizeof (Links));
+        memset (&CnBlock, 0, sizeof (CnBlock));
+        if (c == 0) {
+            CnBlock.Type = 2;      // master
+            CnBlock.SyncType = 1;  // time
+        }
+        CnBlock.DataType = 4;      // IEEE 754 little endian
+        CnBlock.ByteOffset = (uint32_t)(c * (int)sizeof (double));
+        CnBlock.BitCount = 64;
+        Write (&CnBlock, sizeof (CnBlock));
+        Next = ChannelPos;
+    }
+    {
+        uint64_t Links[6] = {0};
+        Links[1] = Next;
+        ChannelGroupPos = WriteMdf4BlockHeader ("##CG", sizeof (MDF4_BLOCK_HEADER) + sizeof (Links) + sizeof (CgBlock), 6);
+        Write (Links, sizeof (Links));
+        memset (&CgBlock, 0, sizeof (CgBlock));
+        CgBlock.NoOfSamples = RECORDS;
+        CgBlock.NoOfDataBytes = (uint32_t)RecordSize;
+        Write (&CgBlock, sizeof (CgBlock));
+    }
+    {
+        uint64_t Links[4] = {0};
+        Links[1] = ChannelGroupPos;
+        Links[2] = DataListPos;
+        DataGroupPos = WriteMdf4BlockHeader ("##DG", sizeof (MDF4_BLOCK_HEADER) + sizeof (Links) + sizeof (DgBlock), 4);
+        Write (Links, sizeof (Links));
+        memset (&DgBlock, 0, sizeof (DgBlock));
+        Write (&DgBlock, sizeof (DgBlock));
+    }
+    fseek (fh, (long)HeaderLinksPos, SEEK_SET);
+    HeaderLinks[0] = DataGroupPos;
+    fwrite (HeaderLinks, sizeof (uint64_t), 1, fh);
+    fclose (fh);
+    free (Stream);
+    free (Blocks);
+}
+
+// MDF3 file with one data group, with record IDs the records are alternating between two channel groups
+static void GenerateMdfFile (const char *par_Name, int par_RecordIds)
+{
+    int NoOfChannelGroups = par_RecordIds ? 2 : 1;
+    long HeaderPos, DataGroupPos, DataPos, ChannelGroupPos[2], ChannelPos[2][2];
+    MDF_IDBLOCK IdBlock;
+    MDF_HDBLOCK HdBlock;
+    MDF_DGBLOCK DgBlock;
+    MDF_CGBLOCK CgBlock;
+    MDF_CNBLOCK CnBlock;
+    int r, g, c;
+
+    fh = fopen (par_Name, "wb");
+    memset (&IdBlock, 0, sizeof (IdBlock));
+    memcpy (IdBlock.FileIdentifier, "MDF     ", 8);
+    memcpy (IdBlock.FormatTdentifier, "3.10    ", 8);
+    IdBlock.VersionNumber = 310;
+    fwrite (&IdBlock, sizeof (IdBlock), 1, fh);
+    memset (&HdBlock, 0, sizeof (HdBlock));
+    memcpy (HdBlock.BlockTypeIdentifier, "HD", 2);
+    HdBlock.BlockSize = sizeof (HdBlock);
+    memcpy (HdBlock.DateOfRecording, "01:01:2024", 10);
+    memcpy (HdBlock.TimeOfRecording, "00:00:00", 8);
+    HeaderPos = ftell (fh);
+    fwrite (&HdBlock, sizeof (HdBlock), 1, fh);
+    memset (&DgBlock, 0, sizeof (DgBlock));
+    memcpy (DgBlock.BlockTypeIdentifier, "DG", 2);
+    DgBlock.BlockSize = sizeof (DgBlock);
+    DgBlock.NumberOfChannelGroups = (uint16_t)NoOfChannelGroups;
+    DgBlock.NumberOfRecordIDs = (uint16_t)par_RecordIds;
+    DataGroupPos = ftell (fh);
+    fwrite (&DgBlock, sizeof (DgBlock), 1, fh);
+    // placeholders
+    memset (&CgBlock, 0, sizeof (CgBlock));
+    memset (&CnBlock, 0, sizeof (CnBlock));
+    for (g = 0; g < NoOfChannelGroups; g++) {
+        ChannelGroupPos[g] = ftell (fh);
+        fwrite (&CgBlock, sizeof (CgBlock), 1, fh);
+        for (c = 0; c < 2; c++) {
+            ChannelPos[g][c] = ftell (fh);
+            fwrite (&CnBlock, sizeof (CnBlock), 1, fh);
+        }
+    }
+    DataPos = ftell (fh);
+    for (r = 0; r < RECORDS; r++) {
+        unsigned char Id = (unsigned char)(1 + (par_RecordIds ? (r & 1) : 0));
+        double Values[2];
+        Values[0] = RecordTime (r);
+        Values[1] = r;
+        if (par_RecordIds) fwrite (&Id, 1, 1, fh);
+        fwrite (Values, sizeof (Values), 1, fh);
+    }
+
+    HdBlock.FirstDataGroupBlock = (uint32_t)DataGroupPos;
+    HdBlock.NumberOfDataGroups = 1;
+    fseek (fh, HeaderPos, SEEK_SET);
+    fwrite (&HdBlock, sizeof (HdBlock), 1, fh);
+    DgBlock.FirstChannelGroupBlock = (uint32_t)ChannelGroupPos[0];
+    DgBlock.DataBlock = (uint32_t)DataPos;
+    fseek (fh, DataGroupPos, SEEK_SET);
+    fwrite (&DgBlock, sizeof (DgBlock), 1, fh);
+    for (g = 0; g < NoOfChannelGroups; g++) {
+        memset (&CgBlock, 0, sizeof (CgBlock));
+        memcpy (CgBlock.BlockTypeIdentifier, "CG", 2);
+        CgBlock.BlockSize = sizeof (CgBlock);
+        CgBlock.NextChannelGroupBlock = ((g + 1) < NoOfChannelGroups) ? (uint32_t)ChannelGroupPos[g + 1] : 0;
+        CgBlock.FirstChannelBlock = (uint32_t)ChannelPos[g][0];
+        CgBlock.RecordID = (uint16_t)(g + 1);
+        CgBlock.NumberOfChannels = 2;
+        CgBlock.SizeOfDataRecord = 2 * sizeof (double);
+        CgBlock.NumberOfRecords = (uint32_t)(par_RecordIds ? (RECORDS + 1 - g) / 2 : RECORDS);
+        fseek (fh, ChannelGroupPos[g], SEEK_SET);
+        fwrite (&CgBlock, sizeof (CgBlock), 1, fh);
+        for (c = 0; c < 2; c++) {
+            memset (&CnBlock, 0, sizeof (CnBlock));
+            memcpy (CnBlock.BlockTypeIdentifier, "CN", 2);
+            CnBlock.BlockSize = sizeof (CnBlock);
+            CnBlock.NextChannelBlock = (c == 0) ? (uint32_t)ChannelPos[g][1] : 0;
+            CnBlock.ChannelType = (c == 0) ? 1 : 0;   // time channel
+            sprintf (CnBlock.ShortSignalName, (c == 0) ? "time" : "Val%i", g);
+            CnBlock.StartBitOffset = (uint16_t)(c * 64);
+            CnBlock.NumberOfBits = 64;
+            CnBlock.SignalDataType = 3;    // IEEE 754 double
+            fseek (fh, ChannelPos[g][c], SEEK_SET);
+            fwrite (&CnBlock, sizeof (CnBlock), 1, fh);
+        }
+    }
+    fclose (fh);
+}
+
+// DAT files have a fixed sample rate, empty lines will be ignored
+static void GenerateDatFile (const char *par_Name)
+{
+    int r;
+
+    fh = fopen (par_Name, "wt");
+    fprintf (fh, "comment\nFORMAT\ngraphic\n0.001\nsample time Val\n[] [s] []\nDATA\n");
+    for (r = 0; r < RECORDS; r++) {
+        fprintf (fh, "%i %.3f %i\n", r, r * 0.001, r);
+        if ((r % 17) == 3) fprintf (fh, "\n");
+        if ((r % 29) == 5) fprintf (fh, "   \n");
+    }
+    fclose (fh);
+}
+
+// Compare seeking against reading the file from the beginning
+
+typedef struct {
+    int (*Read) (STIMULI_FILE *par_File, VARI_IN_PIPE *pipevari_list, uint64_t *ret_t);
+    int (*Seek) (STIMULI_FILE *par_File, uint64_t par_Time);
+} STIMULI_FUNCTIONS;
+
+typedef struct {
+    int Count;
+    uint64_t Time;
+    VARI_IN_PIPE Varis[MAX_VARIS];
+} TIME_SLOT;
+
+static long Seeks;
+
+static int ReadSlot (STIMULI_FUNCTIONS *par_Functions, STIMULI_FILE *par_File, TIME_SLOT *ret_Slot)
+{
+    memset (ret_Slot, 0, sizeof (TIME_SLOT));
+    ret_Slot->Count = par_Functions->Read (par_File, ret_Slot->Varis, &ret_Slot->Time);
+    return ret_Slot->Count;
+}
+
+static void CheckSeek (const char *par_Name, STIMULI_FUNCTIONS *par_Functions, STIMULI_FILE *par_File,
+                       TIME_SLOT *par_Slots, int par_Count, uint64_t par_Time)
+{
+    TIME_SLOT Slot;
+    int l = 0, r = par_Count, x;
+
+    // first time slot which is not before par_Time
+    while (l < r) {
+        int m = (l + r) >> 1;
+        if (par_Slots[m].Time < par_Time) l = m + 1;
+        else r = m;
+    }
+    Seeks++;
+    if (par_Functions->Seek (par_File, par_Time)) {
+        UNIT_TEST_CHECK_MSG (0, "%s: seek to %llu failed", par_Name, (unsigned long long)par_Time);
+        return;
+    }
+    for (x = l; x < (l + READ_SLOTS); x++) {
+        ReadSlot (par_Functions, par_File, &Slot);
+        if (x >= par_Count) {
+            UNIT_TEST_CHECK_MSG (Slot.Count <= 0, "%s: seek to %llu, expect the file end", par_Name, (unsigned long long)par_Time);
+            return;
+        }
+        if ((Slot.Count != par_Slots[x].Count) || (Slot.Time != par_Slots[x].Time) ||
+            memcmp (Slot.Varis, par_Slots[x].Varis, sizeof (Slot.Varis))) {
+            UNIT_TEST_CHECK_MSG (0, "%s: seek to %llu, expect time slot %i (%llu) not %llu (%i values)", par_Name, (unsigned long long)par_Time,
+                                 x, (unsigned long long)par_Slots[x].Time, (unsigned long long)Slot.Time, Slot.Count);
+            return;
+        }
+    }
+}
+
+static void CheckFile (const char *par_Name, STIMULI_FUNCTIONS *par_Functions, STIMULI_FILE *par_File, int par_ExpectedCount)
+{
+    static TIME_SLOT Slots[RECORDS + 1];
+    int Count = 0, x;
+
+    UNIT_TEST_CHECK_MSG (par_File != NULL, "%s: cannot open", par_Name);
+    if (par_File == NULL) return;
+    while ((Count <= RECORDS) && (ReadSlot (par_Functions, par_File, &Slots[Count]) > 0)) {
+        Count++;
+    }
+    UNIT_TEST_CHECK_MSG (Count == par_ExpectedCount, "%s: %i time slots (expected %i)", par_Name, Count, par_ExpectedCount);
+    UNIT_TEST_CHECK_MSG ((Count > 0) && (Slots[0].Time == 0), "%s: the first time slot is not at 0", par_Name);
+    for (x = 0; x < Count; x++) {
+        CheckSeek (par_Name, par_Functions, par_File, Slots, Count, Slots[x].Time);
+        CheckSeek (par_Name, par_Functions, par_File, Slots, Count, Slots[x].Time + 1);
+        if (Slots[x].Time > 0) CheckSeek (par_Name, par_Functions, par_File, Slots, Count, Slots[x].Time - 1);
+    }
+    // backwards, behind the end and back to the start
+    for (x = Count - 1; x >= 0; x -= 97) {
+        CheckSeek (par_Name, par_Functions, par_File, Slots, Count, Slots[x].Time);
+    }
+    CheckSeek (par_Name, par_Functions, par_File, Slots, Count, Slots[Count - 1].Time + 1000000000ULL);
+    CheckSeek (par_Name, par_Functions, par_File, Slots, Count, 0);
+}
+
+static const char Variables[] = "Val\0Val0\0Val1\0";
+
+int main (void)
+{
+    STIMULI_FUNCTIONS Mdf4 = {Mdf4ReadOneStimuliTimeSlot, Mdf4SeekStimuliFile};
+    STIMULI_FUNCTIONS Mdf = {MdfReadOneStimuliTimeSlot, MdfSeekStimuliFile};
+    STIMULI_FUNCTIONS Dat = {DatReadOneStimuliTimeSlot, DatSeekStimuliFile};
+    STIMULI_FILE *File;
+
+    init_files ();
+    // the file names are lower case because my_open() handles names starting with an upper case letter as windows paths
+
+    // records are crossing the DT block borders
+    GenerateMdf4File ("seek_blocks.mf4", 997, 0);
+    File = Mdf4OpenAndReadStimuliHeader ("seek_blocks.mf4", Variables);
+    CheckFile ("seek_blocks.mf4", &Mdf4, File, RECORDS);
+    if (File != NULL) Mdf4CloseStimuliFile (File);
+    // transposed and deflated blocks
+    GenerateMdf4File ("seek_compressed.mf4", 64, 1);
+    File = Mdf4OpenAndReadStimuliHeader ("seek_compressed.mf4", Variables);
+    CheckFile ("seek_compressed.mf4", &Mdf4, File, RECORDS);
+    if (File != NULL) Mdf4CloseStimuliFile (File);
+
+    GenerateMdfFile ("seek.mdf", 0);
+    File = MdfOpenAndReadStimuliHeader ("seek.mdf", Variables);
+    CheckFile ("seek.mdf", &Mdf, File, RECORDS);
+    if (File != NULL) MdfCloseStimuliFile (File);
+    GenerateMdfFile ("seek_record_ids.mdf", 1);
+    File = MdfOpenAndReadStimuliHeader ("seek_record_ids.mdf", Variables);
+    CheckFile ("seek_record_ids.mdf", &Mdf, File, RECORDS);
+    if (File != NULL) MdfCloseStimuliFile (File);
+
+    GenerateDatFile ("seek.dat");
+    File = DatOpenAndReadStimuliHeader ("seek.dat", "sample\0time\0Val\0");
+    CheckFile ("seek.dat", &Dat, File, RECORDS);
+    if (File != NULL) DatCloseStimuliFile (File);
+
+    remove ("seek_blocks.mf4");
+    remove ("seek_compressed.mf4");
+    remove ("seek.mdf");
+    remove ("seek_record_ids.mdf");
+    remove ("seek.dat");
+    printf ("%li seeks, %i failed\n", Seeks, UnitTestFailedChecks);
+    return UNIT_TEST_RESULT();
+}
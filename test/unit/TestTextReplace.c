@@ -0,0 +1,158 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "TextReplace.h"
+#include "UnitTest.h"
+
+// Differential test of the compiled text replace tables (TextReplaceCompile()) against the
+// parsing functions convert_value2textreplace() and convert_textreplace2value(): both must give
+// the same return value, text, color and range for valid, overlapping, duplicate, RGB and wrong conversions.
+
+#define RANDOM_CONVERSIONS  20000
+
+static long Checks;
+
+static void CompareValue2Text (struct TEXT_REPLACE_TABLE *par_Table, const char *par_Conversion, int64_t par_Value, int par_Maxc)
+{
+    char Text[600], TextCompiled[600];
+    int Color = 12345, ColorCompiled = 12345;
+    int Ret, RetCompiled;
+
+    memset (Text, 'x', sizeof (Text) - 1);
+    memset (TextCompiled, 'x', sizeof (TextCompiled) - 1);
+    Text[sizeof (Text) - 1] = TextCompiled[sizeof (TextCompiled) - 1] = 0;
+    Ret = convert_value2textreplace (par_Value, par_Conversion, Text, par_Maxc, &Color);
+    RetCompiled = convert_value2textreplace_compiled (par_Table, par_Value, par_Conversion, TextCompiled, par_Maxc, &ColorCompiled);
+    UNIT_TEST_CHECK_MSG ((Ret == RetCompiled) && (Color == ColorCompiled) && (strcmp (Text, TextCompiled) == 0),
+                         "\"%s\" value %lli: return %i/%i color %i/%i text \"%s\"/\"%s\"", par_Conversion, (long long)par_Value,
+                         Ret, RetCompiled, Color, ColorCompiled, Text, TextCompiled);
+    Checks++;
+}
+
+static void CompareText2Value (struct TEXT_REPLACE_TABLE *par_Table, const char *par_Conversion, const char *par_Text)
+{
+    int64_t From = 7, To = 7, FromCompiled = 7, ToCompiled = 7;
+    int Ret, RetCompiled;
+
+    Ret = convert_textreplace2value (par_Conversion, (char*)par_Text, &From, &To);
+    RetCompiled = convert_textreplace2value_compiled (par_Table, par_Conversion, (char*)par_Text, &FromCompiled, &ToCompiled);
+    UNIT_TEST_CHECK_MSG ((Ret == RetCompiled) && (From == FromCompiled) && (To == ToCompiled),
+                         "\"%s\" text \"%s\": return %i/%i range %lli..%lli/%lli..%lli", par_Conversion, par_Text,
+                         Ret, RetCompiled, (long long)From, (long long)To, (long long)FromCompiled, (long long)ToCompiled);
+    Checks++;
+}
+
+static const char *Texts[] = {"Off", "On", "", " On", "RGB(1:2:3)On", "RGB(0x10:0:255) Red", "RGB(1:2)Bad", "RGB(a)x", "Error", "a b"};
+
+static void CheckConversion (const char *par_Conversion)
+{
+    struct TEXT_REPLACE_TABLE *Table = TextReplaceCompile (par_Conversion);
+    const char *p;
+    int64_t v;
+    int x;
+
+    for (v = -12; v <= 40; v++) {
+        CompareValue2Text (Table, par_Conversion, v, 512);
+    }
+    CompareValue2Text (Table, par_Conversion, INT64_MIN, 512);
+    CompareValue2Text (Table, par_Conversion, INT64_MAX, 512);
+    CompareValue2Text (Table, par_Conversion, INT64_MAX - 1, 512);
+    // maxc <= 0 is handled by the parser
+    CompareValue2Text (Table, par_Conversion, 1, 0);
+    // the compiled table truncates a text which don't fit into the buffer
+    if (Table != NULL) {
+        char Text[600], Short[8];
+        int64_t v2;
+        for (v2 = -1; v2 <= 34; v2++) {
+            if (convert_value2textreplace_compiled (Table, v2, par_Conversion, Text, sizeof (Text), NULL) == 0) {
+                memset (Short, 'x', sizeof (Short));
+                convert_value2textreplace_compiled (Table, v2, par_Conversion, Short, 4, NULL);
+                UNIT_TEST_CHECK ((Short[4] == 'x') && (strlen (Short) <= 3) && (strncmp (Short, Text, strlen (Short)) == 0));
+                Checks++;
+            }
+        }
+    }
+
+    for (x = 0; x < (int)(sizeof (Texts) / sizeof (Texts[0])); x++) {
+        CompareText2Value (Table, par_Conversion, Texts[x]);
+    }
+    // all texts of the conversion with and without color
+    p = par_Conversion;
+    while ((p = strchr (p, '\"')) != NULL) {
+        char Text[600];
+        char *Color;
+        const char *End = strchr (p + 1, '\"');
+        int Len;
+        if (End == NULL) break;
+        Len = (int)(End - p - 1);
+        if (Len >= (int)sizeof (Text)) Len = (int)sizeof (Text) - 1;
+        memcpy (Text, p + 1, (size_t)Len);
+        Text[Len] = 0;
+        CompareText2Value (Table, par_Conversion, Text);
+        Color = strchr (Text, ')');
+        if (Color != NULL) CompareText2Value (Table, par_Conversion, Color + 1);
+        p = End + 1;
+    }
+    TextReplaceFreeCompiled (Table);
+}
+
+// Pieces for random conversions: RGB colors, overlapping and open ranges, duplicate texts and syntax errors
+static const char *Pieces[] = {
+    "0 0 \"Off\"", "1 1 \"On\"", "1 5 \"Range\"", "5 5 \"Five\"", "5 10 \"FiveTen\"",
+    "* 0 \"Neg\"", "10 * \"Big\"", "3 3 \"RGB(255:0:0)Red\"", "4 4 \"RGB(1:2) bad\"", "6 6 \"RGB(0x1:0x2:0x3)   Blue\"",
+    "7 7 \"On\"", "8 8 \"RGB(x;y)z\"", "9 9 \"RGB(q\"", "2 1 \"Wrong\"", "x 1 \"A\"", "12 12 Missing", "13 13 \"A\"x",
+    "-5 -5 \"Minus\"", "0x20 0x20 \"Hex\"", "20 30 \"\"", "0 0 \"Dup\"", "31 31 \"RGB(1:2:3)\"", "32 32 \"RGB(1:2:3)Dup\"", "33 33 \"Dup\""};
+
+static const char *Fixed[] = {
+    "",
+    "0 0 \"Off\"; 1 1 \"On\"",
+    "0 0 \"Off\"; 0 5 \"Low\"; 5 10 \"High\"",
+    "0 5 \"A\"; 5 5 \"B\"",
+    "0 0 \"A\"; 0 0 \"B\"",
+    "* * \"All\"",
+    "0 0 \"RGB(255:0:0)Off\"; 1 1 \"RGB(0:255:0) On\"",
+    "0 0 \"Off\";1 1 \"On\"; 2 2 \"Off\"",
+    "   0   0   \"Off\"  ;  1 1 \"On\"  ",
+    "0 0 \"Off\"; 1 1 \"On;\"",
+    "0 0 \"RGB(1;2)x\"; 1 1 \"y\"",
+    "0 0 \"RGB(abc)x\"; 1 1 \"y\"",
+    NULL};
+
+int main (void)
+{
+    int t, x;
+
+    for (x = 0; Fixed[x] != NULL; x++) {
+        CheckConversion (Fixed[x]);
+    }
+    srand (3);
+    for (t = 0; t < RANDOM_CONVERSIONS; t++) {
+        char Conversion[4096] = "";
+        int Count = rand () % 7;
+        for (x = 0; x < Count; x++) {
+            if (x) strcat (Conversion, (rand () % 3) ? "; " : ";");
+            strcat (Conversion, Pieces[rand () % (int)(sizeof (Pieces) / sizeof (Pieces[0]))]);
+        }
+        CheckConversion (Conversion);
+    }
+    printf ("%li checks, %i failed\n", Checks, UnitTestFailedChecks);
+    return UNIT_TEST_RESULT();
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UNITTEST_H
+#define UNITTEST_H
+
+#include <stdio.h>
+
+// Minimal check macros for the C unit tests. Each test is an own executable,
+// main() returns UNIT_TEST_RESULT() so ctest see a failed check.
+
+extern int UnitTestFailedChecks;
+// Number of ThrowError calls (UnitTestStubs.c)
+extern int UnitTestThrowErrorCounter;
+
+#define UNIT_TEST_CHECK(cond) \
+if (1) { \
+    if (!(cond)) { \
+        printf ("%s(%d): check \"%s\" failed\n", __FILE__, __LINE__, #cond); \
+        UnitTestFailedChecks++; \
+    } \
+}
+
+#define UNIT_TEST_CHECK_MSG(cond, ...) \
+if (1) { \
+    if (!(cond)) { \
+        printf ("%s(%d): check \"%s\" failed: ", __FILE__, __LINE__, #cond); \
+        printf (__VA_ARGS__); \
+        printf ("\n"); \
+        UnitTestFailedChecks++; \
+    } \
+}
+
+#define UNIT_TEST_RESULT() ((UnitTestFailedChecks > 0) ? 1 : 0)
+
+#endif // UNITTEST_H
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "EquationParser.h"
+#include "ExecutionStack.h"
+#include "EquationList.h"
+
+// The blackboard conversion module references the equation parser for formula conversions.
+// The unit tests use only table, enum and text conversions, so a call of one of these is an error.
+
+static void EquationNotAvailable (const char *par_Function)
+{
+    printf ("%s() is not available inside the unit tests\n", par_Function);
+    abort ();
+}
+
+int RegisterEquation (int Pid, const char *Equation, struct EXEC_STACK_ELEM *ExecStack, const char *AdditionalInfos,
+                      uint32_t TypeFlags)
+{
+    (void)Pid; (void)Equation; (void)ExecStack; (void)AdditionalInfos; (void)TypeFlags;
+    EquationNotAvailable ("RegisterEquation");
+    return -1;
+}
+
+int calc_raw_value_for_phys_value (const char *equation, double phys_value, const char *variable_name, int type, double *ret_raw_value, double *ret_phys_value, char **errstring)
+{
+    (void)equation; (void)phys_value; (void)variable_name; (void)type; (void)ret_raw_value; (void)ret_phys_value; (void)errstring;
+    EquationNotAvailable ("calc_raw_value_for_phys_value");
+    return -1;
+}
+
+int direct_solve_equation_err_string_replace_var_value (const char *equation, const char *variable, double value, double *erg, char **errstring)
+{
+    (void)equation; (void)variable; (void)value; (void)erg; (void)errstring;
+    EquationNotAvailable ("direct_solve_equation_err_string_replace_var_value");
+    return -1;
+}
+
+double execute_stack_replace_variable_with_parameter (struct EXEC_STACK_ELEM *start_exec_stack, int vid, double parameter)
+{
+    (void)start_exec_stack; (void)vid; (void)parameter;
+    EquationNotAvailable ("execute_stack_replace_variable_with_parameter");
+    return 0.0;
+}
+
+double execute_stack_whith_parameter (struct EXEC_STACK_ELEM *start_exec_stack, double parameter)
+{
+    (void)start_exec_stack; (void)parameter;
+    EquationNotAvailable ("execute_stack_whith_parameter");
+    return 0.0;
+}
+
+struct EXEC_STACK_ELEM *solve_equation_replace_parameter (const char *equation)
+{
+    (void)equation;
+    EquationNotAvailable ("solve_equation_replace_parameter");
+    return NULL;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Files.h"
+#include "MainValues.h"
+#include "IniFileDontExist.h"
+#include "Wildcards.h"
+#include "MainWinowSyncWithOtherThreads.h"
+#include "IniDatabaseInOutputFilter.h"
+
+// The INI database references the file handling, the progress bar of the main window and the
+// in/output filter processes. The unit tests only load and save plain INI files.
+
+MAIN_INI_VAL s_main_ini_val;
+
+static void IniFunctionNotAvailable (const char *par_Function)
+{
+    printf ("%s() is not available inside the unit tests\n", par_Function);
+    abort ();
+}
+
+int expand_filename (const char *src_name, char *dst_name, int maxc)
+{
+    strncpy (dst_name, src_name, (size_t)maxc);
+    dst_name[maxc - 1] = 0;
+    return 0;
+}
+
+FILE *open_file (const char * const name, const char *flags)
+{
+    return fopen (name, flags);
+}
+
+void close_file (FILE *handle)
+{
+    fclose (handle);
+}
+
+int StringCommaSeparate (char *str, ...)
+{
+    (void)str;
+    IniFunctionNotAvailable ("StringCommaSeparate");
+    return 0;
+}
+
+int Compare2StringsWithWildcardsCaseSensitive (const char *string, const char *wildcard, int CaseSensetiv)
+{
+    (void)string; (void)wildcard; (void)CaseSensetiv;
+    IniFunctionNotAvailable ("Compare2StringsWithWildcardsCaseSensitive");
+    return 0;
+}
+
+FILE *CreateInOrOutputFilterProcessPipe (const char *par_ExecName, const char *par_FileName, int par_InOrOut)
+{
+    (void)par_ExecName; (void)par_FileName; (void)par_InOrOut;
+    IniFunctionNotAvailable ("CreateInOrOutputFilterProcessPipe");
+    return NULL;
+}
+
+int IsInOrOutputFilterProcessPipe (FILE *par_PipeFile)
+{
+    (void)par_PipeFile;
+    return 0;
+}
+
+int CloseInOrOutputFilterProcessPipe (FILE *par_PipeFile)
+{
+    (void)par_PipeFile;
+    IniFunctionNotAvailable ("CloseInOrOutputFilterProcessPipe");
+    return -1;
+}
+
+int OpenProgressBarFromOtherThread (const char *par_ProgressName)
+{
+    (void)par_ProgressName;
+    return -1;
+}
+
+void SetProgressBarFromOtherThread (int par_ProgressBarID, int par_Value)
+{
+    (void)par_ProgressBarID; (void)par_Value;
+}
+
+void CloseProgressBarFromOtherThread (int par_ProgressBarID)
+{
+    (void)par_ProgressBarID;
+}
+
+void AddIniFileToHistory (char *par_IniFile)
+{
+    (void)par_IniFile;
+}
+
+int WriteBasicConfigurationToIni (MAIN_INI_VAL *sp_main_ini)
+{
+    (void)sp_main_ini;
+    return 0;
+}
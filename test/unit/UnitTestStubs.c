@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 ZF Friedrichshafen AG
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdint.h>
+
+#include "UnitTest.h"
+
+// Replacements for the memory and error functions of XilEnv so single modules
+// can be linked into a unit test without the scheduler and the GUI
+
+int UnitTestFailedChecks;
+
+// Number of ThrowError calls, a test can check if an error was reported
+int UnitTestThrowErrorCounter;
+
+void *__my_malloc (const char * const file, int line, size_t size)
+{
+    (void)file; (void)line;
+    return malloc (size);
+}
+
+void *__my_calloc (const char * const file, int line, size_t nitems, size_t size)
+{
+    (void)file; (void)line;
+    return calloc (nitems, size);
+}
+
+void *__my_realloc (const char * const file, int line, void *block, size_t size)
+{
+    (void)file; (void)line;
+    return realloc (block, size);
+}
+
+void my_free (const void *block)
+{
+    free ((void*)block);
+}
+
+int ThrowError (int level, const char *format, ...)
+{
+    va_list args;
+    (void)level;
+    UnitTestThrowErrorCounter++;
+    if (getenv ("UNIT_TEST_VERBOSE") != NULL) {
+        va_start (args, format);
+        vprintf (format, args);
+        va_end (args);
+        printf ("\n");
+    }
+    return 0;
+}